@@ -103,6 +103,8 @@ else ()
     define_option(MILVUS_BUILD_TESTS "Build the MILVUS googletest unit tests" OFF)
 endif (BUILD_UNIT_TEST)
 
+define_option(MILVUS_BUILD_BENCHMARKS "Build the MILVUS google-benchmark microbenchmarks" OFF)
+
 #----------------------------------------------------------------------
 macro(config_summary)
     message(STATUS "---------------------------------------------------------------------")
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+# Compare two google-benchmark JSON result files and fail on regressions.
+#
+# Usage:
+#   ./milvus_bench --benchmark_format=json > baseline.json     # on the old build
+#   ./milvus_bench --benchmark_format=json > current.json      # on the new build
+#   python3 compare_bench.py baseline.json current.json --threshold 10
+#
+# Exits non-zero when any benchmark present in both files got slower than the
+# threshold percentage, so CI-adjacent runs can gate on it.
+
+import argparse
+import json
+import sys
+
+
+def load_benchmarks(path):
+    with open(path) as f:
+        report = json.load(f)
+    benchmarks = {}
+    for bench in report.get("benchmarks", []):
+        # aggregate rows (mean/median/stddev) would double-count repetitions
+        if bench.get("run_type") == "aggregate":
+            continue
+        benchmarks[bench["name"]] = bench
+    return benchmarks
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two google-benchmark JSON outputs")
+    parser.add_argument("baseline", help="benchmark JSON of the reference build")
+    parser.add_argument("current", help="benchmark JSON of the build under test")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed real_time slowdown in percent before failing (default: 10)")
+    args = parser.parse_args()
+
+    baseline = load_benchmarks(args.baseline)
+    current = load_benchmarks(args.current)
+
+    common = [name for name in baseline if name in current]
+    if not common:
+        print("no common benchmarks between %s and %s" % (args.baseline, args.current))
+        return 1
+
+    regressions = []
+    print("%-60s %15s %15s %10s" % ("benchmark", "baseline", "current", "delta"))
+    for name in common:
+        base_time = baseline[name]["real_time"]
+        cur_time = current[name]["real_time"]
+        unit = current[name].get("time_unit", "ns")
+        delta_pct = (cur_time - base_time) / base_time * 100.0 if base_time > 0 else 0.0
+        marker = ""
+        if delta_pct > args.threshold:
+            regressions.append((name, delta_pct))
+            marker = "  <-- REGRESSION"
+        print("%-60s %13.1f%s %13.1f%s %+9.1f%%%s" % (name, base_time, unit, cur_time, unit, delta_pct, marker))
+
+    missing = [name for name in baseline if name not in current]
+    for name in missing:
+        print("warning: %s missing from current run" % name)
+
+    if regressions:
+        print("\n%d benchmark(s) regressed more than %.1f%%:" % (len(regressions), args.threshold))
+        for name, delta_pct in regressions:
+            print("  %s (+%.1f%%)" % (name, delta_pct))
+        return 1
+
+    print("\nno regressions beyond %.1f%%" % args.threshold)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,91 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "cache/AccessTracker.h"
+
+#include <cmath>
+
+namespace milvus {
+namespace cache {
+
+namespace {
+constexpr std::chrono::seconds DECAY_HALF_LIFE(300);
+// a segment re-used within the decay window accumulates close to 2.0
+constexpr double HOT_FREQUENCY = 1.5;
+// bound on tracked keys; one entry is a few dozen bytes so this stays small
+constexpr size_t MAX_TRACKED_KEYS = 131072;
+// entries decayed below this carry no signal and are dropped when pruning
+constexpr double PRUNE_FREQUENCY = 0.5;
+}  // namespace
+
+void
+AccessTracker::Record(const std::string& key) {
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= MAX_TRACKED_KEYS) {
+        Prune();
+    }
+
+    auto& entry = entries_[key];
+    entry.count = DecayedCount(entry, now) + 1.0;
+    entry.last_access = now;
+}
+
+double
+AccessTracker::Frequency(const std::string& key) {
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(key);
+    if (iter == entries_.end()) {
+        return 0.0;
+    }
+
+    return DecayedCount(iter->second, now);
+}
+
+bool
+AccessTracker::IsCold(const std::string& key) {
+    double frequency = Frequency(key);
+    return frequency > 0.0 && frequency < HOT_FREQUENCY;
+}
+
+double
+AccessTracker::DecayedCount(const Entry& entry, std::chrono::steady_clock::time_point now) const {
+    if (entry.count == 0.0) {
+        return 0.0;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - entry.last_access);
+    return entry.count * std::exp2(-static_cast<double>(elapsed.count()) / DECAY_HALF_LIFE.count());
+}
+
+void
+AccessTracker::Prune() {
+    auto now = std::chrono::steady_clock::now();
+    for (auto iter = entries_.begin(); iter != entries_.end();) {
+        if (DecayedCount(iter->second, now) < PRUNE_FREQUENCY) {
+            iter = entries_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+
+    // pathological case: everything is genuinely hot; start over rather
+    // than letting the map grow without bound
+    if (entries_.size() >= MAX_TRACKED_KEYS) {
+        entries_.clear();
+    }
+}
+
+}  // namespace cache
+}  // namespace milvus
@@ -0,0 +1,60 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace milvus {
+namespace cache {
+
+// Exponentially decayed access-frequency counter per cache key, used to
+// classify segments hot or cold for cache admission. Every lookup records
+// one access; the count halves every DECAY_HALF_LIFE so a burst of
+// historical traffic fades instead of keeping stale segments "hot" forever.
+// A key with no recorded history is treated as unknown, not cold, so direct
+// insertions that never went through a lookup are always admitted.
+class AccessTracker {
+ public:
+    void
+    Record(const std::string& key);
+
+    // decayed access count; 0.0 when the key has never been recorded
+    double
+    Frequency(const std::string& key);
+
+    // a cold segment has demand history but no sign of re-use: one decayed
+    // access, typical of a scan or backfill touching each segment once
+    bool
+    IsCold(const std::string& key);
+
+ private:
+    struct Entry {
+        double count = 0.0;
+        std::chrono::steady_clock::time_point last_access;
+    };
+
+    double
+    DecayedCount(const Entry& entry, std::chrono::steady_clock::time_point now) const;
+
+    void
+    Prune();
+
+ private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace cache
+}  // namespace milvus
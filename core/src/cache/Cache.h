@@ -12,22 +12,56 @@
 #pragma once
 
 #include "LRU.h"
+#include "metrics/Metrics.h"
 #include "utils/Log.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace milvus {
 namespace cache {
 
+// eviction hint classes; lower classes are drained first when memory is freed
+enum class CachePriority {
+    LOW = -1,
+    NORMAL = 0,
+    HIGH = 1,
+};
+
+// per-item eviction attributes kept alongside the cached object; pinned items
+// are never evicted
+struct CacheItemAttr {
+    bool pinned = false;
+    CachePriority priority = CachePriority::NORMAL;
+    // stamped when the entry is (re-)inserted, for the contents inspection
+    // endpoint's age column
+    std::chrono::steady_clock::time_point insert_time = std::chrono::steady_clock::now();
+};
+
+// one resident entry, reported by snapshot_entries()
+struct CacheEntryInfo {
+    std::string key_;
+    int64_t size_ = 0;
+    int64_t age_seconds_ = 0;
+};
+
 template <typename ItemObj>
 class Cache {
  public:
     // mem_capacity, units:GB
     Cache(int64_t capacity_gb, uint64_t cache_max_count);
-    ~Cache() = default;
+    ~Cache();
 
     int64_t
     usage() const {
@@ -54,6 +88,58 @@ class Cache {
         freemem_percent_ = percent;
     }
 
+    // must be chosen before the cache is populated
+    void
+    set_eviction_policy(EvictionPolicy policy);
+
+    EvictionPolicy
+    eviction_policy() const {
+        return eviction_policy_;
+    }
+
+    // stable name used as the metrics label when A/B-ing policies
+    const char*
+    eviction_policy_name() const {
+        return eviction_policy_ == EvictionPolicy::LRU_2 ? "lru_2" : "lru";
+    }
+
+    // instance label used on the per-cache metric families ("cpu", "gpu_<id>",
+    // "disk"); set once by the owning CacheMgr before the cache is used
+    void
+    set_name(const std::string& name) {
+        name_ = name;
+    }
+
+    const std::string&
+    name() const {
+        return name_;
+    }
+
+    int64_t
+    hit_count() const {
+        return hit_count_;
+    }
+
+    int64_t
+    miss_count() const {
+        return miss_count_;
+    }
+
+    int64_t
+    evict_count() const {
+        return evict_count_;
+    }
+
+    int64_t
+    bytes_in() const {
+        return bytes_in_;
+    }
+
+    int64_t
+    bytes_out() const {
+        return bytes_out_;
+    }
+
     size_t
     size() const;
 
@@ -69,6 +155,21 @@ class Cache {
     void
     erase(const std::string& key);
 
+    // attributes apply to the currently cached entry and are dropped together
+    // with it; re-applying them after a re-insert is the caller's duty
+    void
+    set_item_attr(const std::string& key, bool pinned, CachePriority priority);
+
+    // keys ordered hottest first, for persisting the warm state across a
+    // restart; recency is exact within a shard and round-robin across shards
+    std::vector<std::string>
+    snapshot_keys() const;
+
+    // every resident entry with its size and age, for the cache contents
+    // inspection endpoint; ordering follows snapshot_keys()
+    std::vector<CacheEntryInfo>
+    snapshot_entries() const;
+
     void
     print();
 
@@ -76,16 +177,53 @@ class Cache {
     clear();
 
  private:
+    // keys are hashed across independently locked LRU shards so concurrent
+    // loads do not serialize on one cache-wide mutex; usage_ is the shared
+    // capacity accountant
+    struct Shard {
+        explicit Shard(uint64_t max_count) : lru_(max_count) {
+        }
+
+        LRU<std::string, ItemObj> lru_;
+        std::unordered_map<std::string, CacheItemAttr> item_attrs_;
+        mutable std::mutex mutex_;
+    };
+
+    Shard&
+    shard(const std::string& key);
+
     void
     free_memory();
 
+    void
+    reclaim_loop();
+
  private:
-    int64_t usage_;
+    static constexpr size_t kShardCount = 16;
+
+    std::atomic<int64_t> usage_;
+    // lifetime traffic counters; monotonic, mirrored into the per-cache
+    // Prometheus families at event time
+    std::atomic<int64_t> hit_count_{0};
+    std::atomic<int64_t> miss_count_{0};
+    std::atomic<int64_t> evict_count_{0};
+    std::atomic<int64_t> bytes_in_{0};
+    std::atomic<int64_t> bytes_out_{0};
+    std::string name_ = "cache";
     int64_t capacity_;
     double freemem_percent_;
-
-    LRU<std::string, ItemObj> lru_;
-    mutable std::mutex mutex_;
+    EvictionPolicy eviction_policy_ = EvictionPolicy::LRU;
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    // evicted objects are handed to a background reclaimer so their
+    // destruction (multi-GB for index objects) never runs on the inserting
+    // thread or under a shard lock
+    std::vector<ItemObj> reclaim_queue_;
+    std::mutex reclaim_mutex_;
+    std::condition_variable reclaim_cv_;
+    bool reclaimer_stop_ = false;
+    std::thread reclaimer_;
 };
 
 }  // namespace cache
@@ -14,10 +14,64 @@ namespace cache {
 
 constexpr double DEFAULT_THRESHHOLD_PERCENT = 0.85;
 
+template <typename ItemObj>
+constexpr size_t Cache<ItemObj>::kShardCount;
+
 template <typename ItemObj>
 Cache<ItemObj>::Cache(int64_t capacity, uint64_t cache_max_count)
-    : usage_(0), capacity_(capacity), freemem_percent_(DEFAULT_THRESHHOLD_PERCENT), lru_(cache_max_count) {
-    //    AGENT_LOG_DEBUG << "Construct Cache with capacity " << std::to_string(mem_capacity)
+    : usage_(0), capacity_(capacity), freemem_percent_(DEFAULT_THRESHHOLD_PERCENT) {
+    uint64_t count_per_shard = (cache_max_count + kShardCount - 1) / kShardCount;
+    shards_.reserve(kShardCount);
+    for (size_t i = 0; i < kShardCount; ++i) {
+        shards_.emplace_back(new Shard(count_per_shard));
+    }
+    reclaimer_ = std::thread(&Cache<ItemObj>::reclaim_loop, this);
+}
+
+template <typename ItemObj>
+Cache<ItemObj>::~Cache() {
+    {
+        std::lock_guard<std::mutex> lock(reclaim_mutex_);
+        reclaimer_stop_ = true;
+    }
+    reclaim_cv_.notify_one();
+    if (reclaimer_.joinable()) {
+        reclaimer_.join();
+    }
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::reclaim_loop() {
+    std::vector<ItemObj> graveyard;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(reclaim_mutex_);
+            reclaim_cv_.wait(lock, [this] { return reclaimer_stop_ || !reclaim_queue_.empty(); });
+            if (reclaimer_stop_ && reclaim_queue_.empty()) {
+                break;
+            }
+            graveyard.swap(reclaim_queue_);
+        }
+        // the last references are dropped here, outside every cache lock
+        graveyard.clear();
+    }
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::set_eviction_policy(EvictionPolicy policy) {
+    eviction_policy_ = policy;
+    for (auto& s : shards_) {
+        std::lock_guard<std::mutex> lock(s->mutex_);
+        s->lru_.set_policy(policy);
+    }
+}
+
+template <typename ItemObj>
+typename Cache<ItemObj>::Shard&
+Cache<ItemObj>::shard(const std::string& key) {
+    return *shards_[std::hash<std::string>()(key) % kShardCount];
 }
 
 template <typename ItemObj>
@@ -32,26 +86,34 @@ Cache<ItemObj>::set_capacity(int64_t capacity) {
 template <typename ItemObj>
 size_t
 Cache<ItemObj>::size() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return lru_.size();
+    size_t count = 0;
+    for (auto& s : shards_) {
+        std::lock_guard<std::mutex> lock(s->mutex_);
+        count += s->lru_.size();
+    }
+    return count;
 }
 
 template <typename ItemObj>
 bool
 Cache<ItemObj>::exists(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return lru_.exists(key);
+    auto& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex_);
+    return s.lru_.exists(key);
 }
 
 template <typename ItemObj>
 ItemObj
 Cache<ItemObj>::get(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!lru_.exists(key)) {
+    auto& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex_);
+    if (!s.lru_.exists(key)) {
+        miss_count_++;
         return nullptr;
     }
 
-    return lru_.get(key);
+    hit_count_++;
+    return s.lru_.get(key);
 }
 
 template <typename ItemObj>
@@ -61,69 +123,139 @@ Cache<ItemObj>::insert(const std::string& key, const ItemObj& item) {
         return;
     }
 
-    //    if(item->size() > capacity_) {
-    //        SERVER_LOG_ERROR << "Item size " << item->size()
-    //                        << " is too large to insert into cache, capacity " << capacity_;
-    //        return;
-    //    }
-
-    // calculate usage
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        auto& s = shard(key);
+        std::lock_guard<std::mutex> lock(s.mutex_);
 
         // if key already exist, subtract old item size
-        if (lru_.exists(key)) {
-            const ItemObj& old_item = lru_.get(key);
+        if (s.lru_.exists(key)) {
+            const ItemObj& old_item = s.lru_.get(key);
             usage_ -= old_item->Size();
+            bytes_out_ += old_item->Size();
         }
 
         // plus new item size
         usage_ += item->Size();
+        bytes_in_ += item->Size();
+
+        s.lru_.put(key, item);
+        s.item_attrs_[key].insert_time = std::chrono::steady_clock::now();
+        SERVER_LOG_DEBUG << "Insert " << key << " size: " << item->Size() << " bytes into cache, usage: " << usage_
+                         << " bytes," << " capacity: " << capacity_ << " bytes";
     }
 
-    // if usage exceed capacity, free some items
+    server::Metrics::GetInstance().CacheIOBytesTotalIncrement(name_, "in", item->Size());
+
+    // if usage exceed capacity, free some items; the new entry is the most
+    // recent one in its shard so it is the last pick in its priority class
     if (usage_ > capacity_) {
         SERVER_LOG_DEBUG << "Current usage " << usage_ << " exceeds cache capacity " << capacity_
                          << ", start free memory";
         free_memory();
     }
-
-    // insert new item
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        lru_.put(key, item);
-        SERVER_LOG_DEBUG << "Insert " << key << " size: " << item->Size() << " bytes into cache, usage: " << usage_
-                         << " bytes," << " capacity: " << capacity_ << " bytes";
-    }
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::erase(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!lru_.exists(key)) {
+    auto& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex_);
+    if (!s.lru_.exists(key)) {
         return;
     }
 
-    const ItemObj& old_item = lru_.get(key);
-    usage_ -= old_item->Size();
+    const ItemObj& old_item = s.lru_.get(key);
+    int64_t old_size = old_item->Size();
+    usage_ -= old_size;
+    bytes_out_ += old_size;
 
-    SERVER_LOG_DEBUG << "Erase " << key << " size: " << old_item->Size() << " bytes from cache, usage: " << usage_
+    SERVER_LOG_DEBUG << "Erase " << key << " size: " << old_size << " bytes from cache, usage: " << usage_
                      << " bytes," << " capacity: " << capacity_ << " bytes";
 
-    lru_.erase(key);
+    s.lru_.erase(key);
+    s.item_attrs_.erase(key);
+    server::Metrics::GetInstance().CacheIOBytesTotalIncrement(name_, "out", old_size);
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::set_item_attr(const std::string& key, bool pinned, CachePriority priority) {
+    auto& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex_);
+    if (!s.lru_.exists(key)) {
+        SERVER_LOG_DEBUG << "Cannot set attributes, " << key << " is not cached";
+        return;
+    }
+
+    // update in place so the insert-time stamp survives attribute changes
+    CacheItemAttr& attr = s.item_attrs_[key];
+    attr.pinned = pinned;
+    attr.priority = priority;
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    lru_.clear();
+    for (auto& s : shards_) {
+        std::lock_guard<std::mutex> lock(s->mutex_);
+        s->lru_.clear();
+        s->item_attrs_.clear();
+    }
     usage_ = 0;
     SERVER_LOG_DEBUG << "Clear cache !";
 }
 
+template <typename ItemObj>
+std::vector<CacheEntryInfo>
+Cache<ItemObj>::snapshot_entries() const {
+    auto now = std::chrono::steady_clock::now();
+    std::vector<CacheEntryInfo> entries;
+    for (auto& s : shards_) {
+        std::lock_guard<std::mutex> lock(s->mutex_);
+        for (auto& entry : s->lru_.eviction_candidates()) {
+            CacheEntryInfo info;
+            info.key_ = entry.first;
+            info.size_ = entry.second->Size();
+            auto attr_it = s->item_attrs_.find(entry.first);
+            if (attr_it != s->item_attrs_.end()) {
+                info.age_seconds_ =
+                    std::chrono::duration_cast<std::chrono::seconds>(now - attr_it->second.insert_time).count();
+            }
+            entries.push_back(info);
+        }
+    }
+    return entries;
+}
+
+template <typename ItemObj>
+std::vector<std::string>
+Cache<ItemObj>::snapshot_keys() const {
+    // per-shard key lists hottest first; eviction_candidates() is coldest
+    // first, so reverse each snapshot before merging
+    std::vector<std::vector<std::string>> shard_keys(kShardCount);
+    for (size_t i = 0; i < kShardCount; ++i) {
+        auto& s = *shards_[i];
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        for (auto& entry : s.lru_.eviction_candidates()) {
+            shard_keys[i].push_back(entry.first);
+        }
+        std::reverse(shard_keys[i].begin(), shard_keys[i].end());
+    }
+
+    std::vector<std::string> keys;
+    bool picked = true;
+    for (size_t pos = 0; picked; ++pos) {
+        picked = false;
+        for (size_t i = 0; i < kShardCount; ++i) {
+            if (pos < shard_keys[i].size()) {
+                keys.push_back(shard_keys[i][pos]);
+                picked = true;
+            }
+        }
+    }
+    return keys;
+}
+
 /* free memory space when CACHE occupation exceed its capacity */
 template <typename ItemObj>
 void
@@ -137,45 +269,115 @@ Cache<ItemObj>::free_memory() {
         delta_size = 1;  // ensure at least one item erased
     }
 
+    // snapshot each shard's unpinned entries in eviction order; shards are
+    // walked one lock at a time so a stalled shard never blocks the others.
+    // An entry whose use_count exceeds the two references held here (one in
+    // the shard list, one in the candidate snapshot) is checked out by a
+    // running search and must not be evicted from under it.
+    struct Victim {
+        std::string key;
+        int64_t size;
+        CachePriority priority;
+        double score;  // reload cost scaled by hotness; evict lowest first
+    };
+    std::vector<Victim> victims;
+    for (size_t i = 0; i < kShardCount; ++i) {
+        auto& s = *shards_[i];
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        auto candidates = s.lru_.eviction_candidates();
+        double pos = 0.0;
+        for (auto& entry : candidates) {
+            CacheItemAttr attr;
+            auto attr_it = s.item_attrs_.find(entry.first);
+            if (attr_it != s.item_attrs_.end()) {
+                attr = attr_it->second;
+            }
+            pos += 1.0;
+            if (attr.pinned || entry.second.use_count() > 2) {
+                continue;
+            }
+            // hotness grows from the cold end (0) towards the hot end (1),
+            // so a cold cheap-to-restore entry scores lowest and a hot entry
+            // with an expensive reload scores highest
+            double hotness = pos / candidates.size();
+            victims.push_back(Victim{entry.first, entry.second->Size(), attr.priority,
+                                     static_cast<double>(entry.second->ReloadCost()) * (1.0 + hotness)});
+        }
+    }
+
+    // pinned and in-use entries are never picked; lower priority classes are
+    // drained first, by ascending eviction score within a class
     std::set<std::string> key_array;
     int64_t released_size = 0;
 
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        auto it = lru_.rbegin();
-        while (it != lru_.rend() && released_size < delta_size) {
-            auto& key = it->first;
-            auto& obj_ptr = it->second;
-
-            key_array.emplace(key);
-            released_size += obj_ptr->Size();
-            ++it;
+    std::stable_sort(victims.begin(), victims.end(),
+                     [](const Victim& lhs, const Victim& rhs) { return lhs.score < rhs.score; });
+    const CachePriority classes[] = {CachePriority::LOW, CachePriority::NORMAL, CachePriority::HIGH};
+    for (auto priority : classes) {
+        for (auto& victim : victims) {
+            if (released_size >= delta_size) {
+                break;
+            }
+            if (victim.priority != priority) {
+                continue;
+            }
+            if (key_array.emplace(victim.key).second) {
+                released_size += victim.size;
+            }
+        }
+        if (released_size >= delta_size) {
+            break;
         }
     }
 
+    if (key_array.empty()) {
+        SERVER_LOG_WARNING << "Cache over capacity but all entries are pinned or in use, nothing to release";
+        return;
+    }
+
     SERVER_LOG_DEBUG << "to be released memory size: " << released_size;
 
+    // drop the entries from their shards but keep a reference to each object;
+    // destruction is deferred to the reclaimer thread so the thread that
+    // crossed the watermark does not pay it inline
+    std::vector<ItemObj> evicted;
+    evicted.reserve(key_array.size());
     for (auto& key : key_array) {
-        erase(key);
+        auto& s = shard(key);
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        if (!s.lru_.exists(key)) {
+            continue;
+        }
+        const ItemObj& old_item = s.lru_.get(key);
+        // a search may have taken a reference since the snapshot; leave such
+        // entries alone, they are re-evaluated on the next pass
+        if (old_item.use_count() > 1) {
+            continue;
+        }
+        usage_ -= old_item->Size();
+        bytes_out_ += old_item->Size();
+        evict_count_++;
+        server::Metrics::GetInstance().CacheEvictionTotalIncrement(name_);
+        server::Metrics::GetInstance().CacheIOBytesTotalIncrement(name_, "out", old_item->Size());
+        evicted.push_back(old_item);
+        s.lru_.erase(key);
+        s.item_attrs_.erase(key);
     }
 
+    {
+        std::lock_guard<std::mutex> lock(reclaim_mutex_);
+        reclaim_queue_.insert(reclaim_queue_.end(), std::make_move_iterator(evicted.begin()),
+                              std::make_move_iterator(evicted.end()));
+    }
+    reclaim_cv_.notify_one();
+
     print();
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::print() {
-    size_t cache_count = 0;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        cache_count = lru_.size();
-#if 0
-        for (auto it = lru_.begin(); it != lru_.end(); ++it) {
-            SERVER_LOG_DEBUG << it->first;
-        }
-#endif
-    }
+    size_t cache_count = size();
 
     SERVER_LOG_DEBUG << "[Cache item count]: " << cache_count;
     SERVER_LOG_DEBUG << "[Cache usage]: " << usage_ << " bytes";
@@ -0,0 +1,294 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "cache/CacheHandoff.h"
+#include "cache/CpuCacheMgr.h"
+#include "server/Config.h"
+#include "utils/Error.h"
+#include "utils/Json.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+#include "wrapper/VecIndex.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+
+namespace milvus {
+namespace cache {
+
+namespace {
+
+constexpr uint64_t HANDOFF_MAGIC = 0x4d4c565348414e44;  // "MLVSHAND"
+
+/*
+ * Segment layout: magic, binary count, then per binary its name length,
+ * name bytes, data length and data bytes. The faiss structures themselves
+ * are pointer-rich and cannot live in shared memory, so the segments carry
+ * the serialized form and restore rebuilds the objects at RAM bandwidth.
+ */
+Status
+write_segment(const std::string& name, const knowhere::BinarySet& binary_set, uint64_t& total_bytes) {
+    total_bytes = 2 * sizeof(uint64_t);
+    for (auto& pair : binary_set.binary_map_) {
+        if (pair.second == nullptr || pair.second->data == nullptr || pair.second->size <= 0) {
+            return Status(SERVER_UNEXPECTED_ERROR, "Index serialization contains an empty binary");
+        }
+        total_bytes += 2 * sizeof(uint64_t) + pair.first.size() + pair.second->size;
+    }
+
+    shm_unlink(name.c_str());  // drop a leftover of an older run
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        return Status(SERVER_UNEXPECTED_ERROR, "shm_open failed: " + std::string(strerror(errno)));
+    }
+    if (ftruncate(fd, static_cast<off_t>(total_bytes)) != 0) {
+        close(fd);
+        shm_unlink(name.c_str());
+        return Status(SERVER_UNEXPECTED_ERROR, "ftruncate failed: " + std::string(strerror(errno)));
+    }
+    void* mapped = mmap(nullptr, total_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        return Status(SERVER_UNEXPECTED_ERROR, "mmap failed: " + std::string(strerror(errno)));
+    }
+
+    auto* cursor = static_cast<uint8_t*>(mapped);
+    auto put_u64 = [&cursor](uint64_t value) {
+        std::memcpy(cursor, &value, sizeof(value));
+        cursor += sizeof(value);
+    };
+    put_u64(HANDOFF_MAGIC);
+    put_u64(binary_set.binary_map_.size());
+    for (auto& pair : binary_set.binary_map_) {
+        put_u64(pair.first.size());
+        std::memcpy(cursor, pair.first.data(), pair.first.size());
+        cursor += pair.first.size();
+        put_u64(static_cast<uint64_t>(pair.second->size));
+        std::memcpy(cursor, pair.second->data.get(), pair.second->size);
+        cursor += pair.second->size;
+    }
+
+    munmap(mapped, total_bytes);
+    return Status::OK();
+}
+
+Status
+read_segment(const std::string& name, uint64_t expected_bytes, knowhere::BinarySet& binary_set) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return Status(SERVER_UNEXPECTED_ERROR, "shm_open failed: " + std::string(strerror(errno)));
+    }
+    struct stat segment_stat;
+    if (fstat(fd, &segment_stat) != 0 || static_cast<uint64_t>(segment_stat.st_size) != expected_bytes) {
+        close(fd);
+        return Status(SERVER_UNEXPECTED_ERROR, "Handoff segment " + name + " has unexpected size");
+    }
+    void* mapped = mmap(nullptr, expected_bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        return Status(SERVER_UNEXPECTED_ERROR, "mmap failed: " + std::string(strerror(errno)));
+    }
+
+    Status status = Status::OK();
+    const auto* cursor = static_cast<const uint8_t*>(mapped);
+    const auto* end = cursor + expected_bytes;
+    auto get_u64 = [&cursor, end](uint64_t& value) {
+        if (cursor + sizeof(value) > end) {
+            return false;
+        }
+        std::memcpy(&value, cursor, sizeof(value));
+        cursor += sizeof(value);
+        return true;
+    };
+
+    uint64_t magic = 0, count = 0;
+    if (!get_u64(magic) || magic != HANDOFF_MAGIC || !get_u64(count)) {
+        status = Status(SERVER_UNEXPECTED_ERROR, "Handoff segment " + name + " is corrupt");
+    }
+    for (uint64_t i = 0; status.ok() && i < count; ++i) {
+        uint64_t name_len = 0, data_len = 0;
+        if (!get_u64(name_len) || cursor + name_len > end) {
+            status = Status(SERVER_UNEXPECTED_ERROR, "Handoff segment " + name + " is truncated");
+            break;
+        }
+        std::string binary_name(reinterpret_cast<const char*>(cursor), name_len);
+        cursor += name_len;
+        if (!get_u64(data_len) || cursor + data_len > end) {
+            status = Status(SERVER_UNEXPECTED_ERROR, "Handoff segment " + name + " is truncated");
+            break;
+        }
+        // copied out: the segment is unlinked right after restore, the
+        // rebuilt index must not reference the mapping
+        std::shared_ptr<uint8_t> data(new uint8_t[data_len], std::default_delete<uint8_t[]>());
+        std::memcpy(data.get(), cursor, data_len);
+        cursor += data_len;
+        binary_set.Append(binary_name, data, static_cast<int64_t>(data_len));
+    }
+
+    munmap(mapped, expected_bytes);
+    return status;
+}
+
+}  // namespace
+
+CacheHandoff&
+CacheHandoff::GetInstance() {
+    static CacheHandoff instance;
+    return instance;
+}
+
+Status
+CacheHandoff::SaveState(const std::string& manifest_path) {
+    bool enable = false;
+    server::Config::GetInstance().GetCacheConfigFastRestartHandoff(enable);
+    if (!enable) {
+        return Status::OK();
+    }
+
+    TimeRecorderAuto rc("Cache handoff save");
+    auto* cache = CpuCacheMgr::GetInstance();
+
+    json entries = json::array();
+    uint64_t sequence = 0;
+    for (auto& key : cache->SnapshotKeys()) {
+        auto index = std::dynamic_pointer_cast<engine::VecIndex>(cache->GetItem(key));
+        if (index == nullptr) {
+            continue;
+        }
+        struct stat file_stat;
+        if (::stat(key.c_str(), &file_stat) != 0) {
+            continue;  // source file gone, the entry cannot be revalidated
+        }
+
+        knowhere::BinarySet binary_set;
+        try {
+            binary_set = index->Serialize();
+        } catch (std::exception& ex) {
+            SERVER_LOG_WARNING << "Cache handoff cannot serialize " << key << ": " << ex.what();
+            continue;
+        }
+
+        std::string shm_name = "/milvus.handoff." + std::to_string(sequence);
+        uint64_t segment_bytes = 0;
+        auto status = write_segment(shm_name, binary_set, segment_bytes);
+        if (!status.ok()) {
+            SERVER_LOG_WARNING << "Cache handoff skips " << key << ": " << status.message();
+            continue;
+        }
+        ++sequence;
+
+        entries.push_back(json{
+            {"key", key},
+            {"shm", shm_name},
+            {"segment_bytes", segment_bytes},
+            {"index_type", static_cast<int>(index->GetType())},
+            {"index_size", index->Size()},
+            {"file_size", static_cast<int64_t>(file_stat.st_size)},
+            {"file_mtime", static_cast<int64_t>(file_stat.st_mtime)},
+        });
+    }
+
+    if (entries.empty()) {
+        return Status::OK();
+    }
+
+    // write-temp-then-rename, the same protocol as the warm-state snapshot
+    json manifest{{"version", 1}, {"entries", entries}};
+    std::string temp_path = manifest_path + ".tmp";
+    {
+        std::ofstream outfile(temp_path, std::ios::trunc);
+        if (!outfile.good()) {
+            return Status(SERVER_UNEXPECTED_ERROR, "Cannot write handoff manifest " + temp_path);
+        }
+        outfile << manifest.dump();
+    }
+    if (std::rename(temp_path.c_str(), manifest_path.c_str()) != 0) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Cannot publish handoff manifest " + manifest_path);
+    }
+
+    SERVER_LOG_INFO << "Cache handoff saved " << entries.size() << " entries";
+    return Status::OK();
+}
+
+Status
+CacheHandoff::RestoreState(const std::string& manifest_path) {
+    std::ifstream infile(manifest_path);
+    if (!infile.good()) {
+        return Status::OK();  // no handoff from the previous run
+    }
+
+    json manifest;
+    try {
+        infile >> manifest;
+    } catch (std::exception& ex) {
+        infile.close();
+        std::remove(manifest_path.c_str());
+        return Status(SERVER_UNEXPECTED_ERROR, "Handoff manifest is corrupt: " + std::string(ex.what()));
+    }
+    infile.close();
+    // the handoff is consumed exactly once, even if nothing below is accepted
+    std::remove(manifest_path.c_str());
+
+    bool enable = false;
+    server::Config::GetInstance().GetCacheConfigFastRestartHandoff(enable);
+
+    TimeRecorderAuto rc("Cache handoff restore");
+    uint64_t total = 0, restored = 0;
+    for (auto& entry : manifest.value("entries", json::array())) {
+        std::string shm_name = entry.value("shm", std::string());
+        if (shm_name.empty()) {
+            continue;
+        }
+        ++total;
+
+        // revalidate before re-attaching: the entry is only good while its
+        // source index file is byte-identical to what the old process cached
+        if (enable) {
+            std::string key = entry.value("key", std::string());
+            struct stat file_stat;
+            bool valid = !key.empty() && ::stat(key.c_str(), &file_stat) == 0 &&
+                         static_cast<int64_t>(file_stat.st_size) == entry.value("file_size", int64_t(-1)) &&
+                         static_cast<int64_t>(file_stat.st_mtime) == entry.value("file_mtime", int64_t(-1));
+            if (valid) {
+                knowhere::BinarySet binary_set;
+                auto status = read_segment(shm_name, entry.value("segment_bytes", uint64_t(0)), binary_set);
+                if (status.ok()) {
+                    auto index = engine::LoadVecIndex(static_cast<engine::IndexType>(entry.value("index_type", 0)),
+                                                      binary_set, entry.value("index_size", int64_t(0)));
+                    if (index != nullptr) {
+                        CpuCacheMgr::GetInstance()->InsertItem(key, index);
+                        ++restored;
+                    }
+                } else {
+                    SERVER_LOG_WARNING << "Cache handoff drops " << key << ": " << status.message();
+                }
+            }
+        }
+        shm_unlink(shm_name.c_str());
+    }
+
+    SERVER_LOG_INFO << "Cache handoff restored " << restored << " of " << total << " entries";
+    return Status::OK();
+}
+
+}  // namespace cache
+}  // namespace milvus
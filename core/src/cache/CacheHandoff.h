@@ -0,0 +1,52 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <string>
+
+#include "utils/Status.h"
+
+namespace milvus {
+namespace cache {
+
+// Cache-preserving restart: on graceful shutdown the serialized form of every
+// index resident in CpuCacheMgr is written into named posix shared-memory
+// segments, which outlive the process, plus a small handoff manifest next to
+// the db files. The next process re-attaches the segments, revalidates each
+// entry against its source index file (size and mtime unchanged) and rebuilds
+// the cache from memory at RAM bandwidth instead of re-reading every file
+// from disk. The handoff is one-shot: restore consumes the manifest and
+// unlinks every segment whether or not it was accepted, so a crashed or
+// skipped restore never leaks /dev/shm space into later runs.
+// Enabled by cache_config.fast_restart_handoff.
+class CacheHandoff {
+ public:
+    static CacheHandoff&
+    GetInstance();
+
+    // serialize the resident cpu-cache indexes into shared memory and write
+    // the manifest; called by the server shutdown path after the DB stopped
+    Status
+    SaveState(const std::string& manifest_path);
+
+    // re-attach and revalidate a previous run's handoff, then remove it;
+    // called by the server startup path before the DB starts, so warm-state
+    // replay finds the entries already resident
+    Status
+    RestoreState(const std::string& manifest_path);
+
+ private:
+    CacheHandoff() = default;
+};
+
+}  // namespace cache
+}  // namespace milvus
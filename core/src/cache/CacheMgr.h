@@ -12,11 +12,13 @@
 #pragma once
 
 #include "Cache.h"
+#include "cache/AccessTracker.h"
 #include "metrics/Metrics.h"
 #include "utils/Log.h"
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace milvus {
 namespace cache {
@@ -39,6 +41,28 @@ class CacheMgr {
     virtual void
     EraseItem(const std::string& key);
 
+    virtual void
+    SetItemAttr(const std::string& key, bool pinned, CachePriority priority);
+
+    // decayed access frequency of a key (see AccessTracker); lets callers
+    // outside the cache, like the engine handle cache, rank segments by the
+    // same hotness signal admission uses
+    virtual double
+    AccessFrequency(const std::string& key);
+
+    // record an access that bypassed GetItem, so fast paths that skip the
+    // cache lookup keep the frequency signal alive
+    virtual void
+    RecordAccess(const std::string& key);
+
+    // cached keys ordered hottest first, for warm-state persistence
+    virtual std::vector<std::string>
+    SnapshotKeys() const;
+
+    // resident entries with sizes and ages, for the cache inspection endpoint
+    virtual std::vector<CacheEntryInfo>
+    SnapshotEntries() const;
+
     virtual void
     PrintInfo();
 
@@ -51,6 +75,22 @@ class CacheMgr {
     int64_t
     CacheCapacity() const;
 
+    // lifetime traffic counters of the underlying cache
+    int64_t
+    HitCount() const;
+
+    int64_t
+    MissCount() const;
+
+    int64_t
+    EvictionCount() const;
+
+    int64_t
+    BytesIn() const;
+
+    int64_t
+    BytesOut() const;
+
     void
     SetCapacity(int64_t capacity);
 
@@ -62,6 +102,7 @@ class CacheMgr {
  protected:
     using CachePtr = std::shared_ptr<Cache<ItemObj>>;
     CachePtr cache_;
+    AccessTracker access_tracker_;
 };
 
 }  // namespace cache
@@ -50,7 +50,14 @@ CacheMgr<ItemObj>::GetItem(const std::string& key) {
         return nullptr;
     }
     server::Metrics::GetInstance().CacheAccessTotalIncrement();
-    return cache_->get(key);
+    access_tracker_.Record(key);
+    ItemObj obj = cache_->get(key);
+    if (obj != nullptr) {
+        server::Metrics::GetInstance().CacheHitTotalIncrement(cache_->eviction_policy_name(), cache_->name());
+    } else {
+        server::Metrics::GetInstance().CacheMissTotalIncrement(cache_->eviction_policy_name(), cache_->name());
+    }
+    return obj;
 }
 
 template <typename ItemObj>
@@ -61,6 +68,15 @@ CacheMgr<ItemObj>::InsertItem(const std::string& key, const ItemObj& data) {
         return;
     }
 
+    // admission control: once the cache is under pressure, a segment whose
+    // only demand is a single recent lookup (a scan or backfill touching it
+    // once) is not worth evicting re-used items for; it is searched from its
+    // loaded engine and dropped. A later lookup re-classifies it hot.
+    if (data != nullptr && cache_->usage() + data->Size() > cache_->capacity() && access_tracker_.IsCold(key)) {
+        SERVER_LOG_DEBUG << "Cold segment bypasses cache: " << key;
+        return;
+    }
+
     cache_->insert(key, data);
     server::Metrics::GetInstance().CacheAccessTotalIncrement();
 }
@@ -77,6 +93,51 @@ CacheMgr<ItemObj>::EraseItem(const std::string& key) {
     server::Metrics::GetInstance().CacheAccessTotalIncrement();
 }
 
+template <typename ItemObj>
+void
+CacheMgr<ItemObj>::SetItemAttr(const std::string& key, bool pinned, CachePriority priority) {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return;
+    }
+
+    cache_->set_item_attr(key, pinned, priority);
+}
+
+template <typename ItemObj>
+double
+CacheMgr<ItemObj>::AccessFrequency(const std::string& key) {
+    return access_tracker_.Frequency(key);
+}
+
+template <typename ItemObj>
+void
+CacheMgr<ItemObj>::RecordAccess(const std::string& key) {
+    access_tracker_.Record(key);
+}
+
+template <typename ItemObj>
+std::vector<std::string>
+CacheMgr<ItemObj>::SnapshotKeys() const {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return {};
+    }
+
+    return cache_->snapshot_keys();
+}
+
+template <typename ItemObj>
+std::vector<CacheEntryInfo>
+CacheMgr<ItemObj>::SnapshotEntries() const {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return {};
+    }
+
+    return cache_->snapshot_entries();
+}
+
 template <typename ItemObj>
 void
 CacheMgr<ItemObj>::PrintInfo() {
@@ -121,6 +182,36 @@ CacheMgr<ItemObj>::CacheCapacity() const {
     return cache_->capacity();
 }
 
+template <typename ItemObj>
+int64_t
+CacheMgr<ItemObj>::HitCount() const {
+    return cache_ == nullptr ? 0 : cache_->hit_count();
+}
+
+template <typename ItemObj>
+int64_t
+CacheMgr<ItemObj>::MissCount() const {
+    return cache_ == nullptr ? 0 : cache_->miss_count();
+}
+
+template <typename ItemObj>
+int64_t
+CacheMgr<ItemObj>::EvictionCount() const {
+    return cache_ == nullptr ? 0 : cache_->evict_count();
+}
+
+template <typename ItemObj>
+int64_t
+CacheMgr<ItemObj>::BytesIn() const {
+    return cache_ == nullptr ? 0 : cache_->bytes_in();
+}
+
+template <typename ItemObj>
+int64_t
+CacheMgr<ItemObj>::BytesOut() const {
+    return cache_ == nullptr ? 0 : cache_->bytes_out();
+}
+
 template <typename ItemObj>
 void
 CacheMgr<ItemObj>::SetCapacity(int64_t capacity) {
@@ -31,10 +31,30 @@ CpuCacheMgr::CpuCacheMgr() {
     config.GetCacheConfigCpuCacheCapacity(cpu_cache_cap);
     int64_t cap = cpu_cache_cap * unit;
     cache_ = std::make_shared<Cache<DataObjPtr>>(cap, 1UL << 32);
+    cache_->set_name("cpu");
 
     float cpu_cache_threshold;
     config.GetCacheConfigCpuCacheThreshold(cpu_cache_threshold);
     cache_->set_freemem_percent(cpu_cache_threshold);
+
+    std::string eviction_policy;
+    config.GetCacheConfigEvictionPolicy(eviction_policy);
+    if (eviction_policy == "lru_2") {
+        cache_->set_eviction_policy(EvictionPolicy::LRU_2);
+    }
+
+    // re-target capacity at runtime; set_capacity evicts incrementally until
+    // usage fits, so shrinking does not dump the whole cache
+    config.RegisterCallBack(server::CONFIG_CACHE, server::CONFIG_CACHE_CPU_CACHE_CAPACITY, "CpuCacheMgr",
+                            [this](const std::string& value) {
+                                cache_->set_capacity(std::stoll(value) * unit);
+                                return Status::OK();
+                            });
+    config.RegisterCallBack(server::CONFIG_CACHE, server::CONFIG_CACHE_CPU_CACHE_THRESHOLD, "CpuCacheMgr",
+                            [this](const std::string& value) {
+                                cache_->set_freemem_percent(std::stod(value));
+                                return Status::OK();
+                            });
 }
 
 CpuCacheMgr*
@@ -20,6 +20,14 @@ class DataObj {
  public:
     virtual int64_t
     Size() = 0;
+
+    // estimated cost of restoring this object after eviction; the evictor
+    // prefers dropping cheap-to-restore items. Defaults to the object size,
+    // i.e. a plain re-read from local disk.
+    virtual int64_t
+    ReloadCost() {
+        return Size();
+    }
 };
 
 using DataObjPtr = std::shared_ptr<DataObj>;
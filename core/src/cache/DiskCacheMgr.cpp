@@ -0,0 +1,188 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "cache/DiskCacheMgr.h"
+#include "server/Config.h"
+#include "storage/s3/S3ClientWrapper.h"
+#include "storage/transfer/IndexTransferService.h"
+#include "utils/CommonUtil.h"
+#include "utils/Error.h"
+#include "utils/Log.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <functional>
+#include <vector>
+
+namespace milvus {
+namespace cache {
+
+namespace {
+constexpr int64_t unit = 1024 * 1024 * 1024;
+}
+
+DiskCacheMgr::DiskCacheMgr() {
+    // All config values have been checked in Config::ValidateConfig()
+    server::Config& config = server::Config::GetInstance();
+
+    std::string path;
+    config.GetCacheConfigDiskCachePath(path);
+    if (path.empty()) {
+        return;
+    }
+
+    int64_t capacity_gb = 0;
+    config.GetCacheConfigDiskCacheCapacity(capacity_gb);
+    capacity_ = capacity_gb * unit;
+
+    auto status = server::CommonUtil::CreateDirectory(path);
+    if (!status.ok()) {
+        SERVER_LOG_ERROR << "Cannot create disk cache directory " << path << ", disk cache is disabled";
+        return;
+    }
+    path_ = path;
+}
+
+DiskCacheMgr*
+DiskCacheMgr::GetInstance() {
+    static DiskCacheMgr s_mgr;
+    return &s_mgr;
+}
+
+std::string
+DiskCacheMgr::CacheFilePath(const std::string& location) const {
+    // flatten the origin location into one file name; the hash disambiguates
+    // equal basenames coming from different tables
+    std::string base = server::CommonUtil::GetFileName(location);
+    return path_ + "/" + std::to_string(std::hash<std::string>()(location)) + "_" + base;
+}
+
+Status
+DiskCacheMgr::FetchOrDownload(const std::string& location, std::string& local_path) {
+    if (!Enabled()) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Disk cache is disabled");
+    }
+
+    std::string file_path = CacheFilePath(location);
+    if (Peek(location, local_path)) {
+        return Status::OK();
+    }
+
+    // fetch outside the lock; concurrent loaders of the same segment may
+    // both fetch, the rename below lets the last one win atomically
+    static std::atomic<uint64_t> download_seq(0);
+    std::string tmp_path = file_path + ".tmp" + std::to_string(download_seq.fetch_add(1));
+
+    // a peer holding the segment warm serves it at LAN bandwidth; S3 is the
+    // fallback, not the first choice
+    std::string source = "peer";
+    auto status = storage::IndexTransferService::GetInstance().FetchFromPeers(location, tmp_path);
+    if (!status.ok()) {
+        source = "s3";
+        status = storage::S3ClientWrapper::GetInstance().GetObjectFile(location, tmp_path);
+    }
+    if (!status.ok()) {
+        boost::system::error_code ec;
+        boost::filesystem::remove(tmp_path, ec);
+        return status;
+    }
+
+    int64_t size = server::CommonUtil::GetFileSize(tmp_path);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        EnsureCapacity(size);
+        boost::system::error_code ec;
+        boost::filesystem::rename(tmp_path, file_path, ec);
+        if (ec) {
+            boost::filesystem::remove(tmp_path, ec);
+            return Status(SERVER_UNEXPECTED_ERROR, "Cannot move downloaded file into disk cache: " + ec.message());
+        }
+    }
+
+    SERVER_LOG_DEBUG << "Disk cache filled from " << source << " for " << location << ", size: " << size << " bytes";
+    local_path = file_path;
+    return Status::OK();
+}
+
+bool
+DiskCacheMgr::Peek(const std::string& location, std::string& local_path) {
+    if (!Enabled()) {
+        return false;
+    }
+
+    std::string file_path = CacheFilePath(location);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!server::CommonUtil::IsFileExist(file_path)) {
+        return false;
+    }
+
+    // refresh the timestamp so eviction keeps hot files
+    boost::system::error_code ec;
+    boost::filesystem::last_write_time(file_path, std::time(nullptr), ec);
+    local_path = file_path;
+    return true;
+}
+
+void
+DiskCacheMgr::EnsureCapacity(int64_t incoming_size) {
+    if (capacity_ <= 0) {
+        return;
+    }
+
+    namespace fs = boost::filesystem;
+    struct Entry {
+        fs::path path;
+        std::time_t mtime;
+        int64_t size;
+    };
+
+    std::vector<Entry> entries;
+    int64_t total_size = 0;
+    boost::system::error_code ec;
+    for (fs::directory_iterator it(path_, ec), end; !ec && it != end; ++it) {
+        if (!fs::is_regular_file(it->path(), ec) || ec) {
+            continue;
+        }
+        int64_t size = fs::file_size(it->path(), ec);
+        if (ec) {
+            continue;
+        }
+        std::time_t mtime = fs::last_write_time(it->path(), ec);
+        if (ec) {
+            continue;
+        }
+        entries.push_back(Entry{it->path(), mtime, size});
+        total_size += size;
+    }
+
+    if (total_size + incoming_size <= capacity_) {
+        return;
+    }
+
+    // drop the files untouched the longest until the newcomer fits
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.mtime < b.mtime; });
+    for (auto& entry : entries) {
+        if (total_size + incoming_size <= capacity_) {
+            break;
+        }
+        fs::remove(entry.path, ec);
+        if (!ec) {
+            total_size -= entry.size;
+            SERVER_LOG_DEBUG << "Disk cache evicted " << entry.path.string() << ", size: " << entry.size << " bytes";
+        }
+    }
+}
+
+}  // namespace cache
+}  // namespace milvus
@@ -0,0 +1,68 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "utils/Status.h"
+
+#include <mutex>
+#include <string>
+
+namespace milvus {
+namespace cache {
+
+// Bounded local-disk (nvme) tier between the cpu cache and remote storage.
+// Serialized index files fetched from S3 are kept as local copies so a
+// cold-segment load that misses the memory cache becomes a local read
+// instead of an S3 round trip. The directory is trimmed oldest-access-first
+// once it exceeds its capacity. Disabled unless cache_config.disk_cache_path
+// is set; only consulted when S3 storage is enabled.
+class DiskCacheMgr {
+ public:
+    static DiskCacheMgr*
+    GetInstance();
+
+    bool
+    Enabled() const {
+        return !path_.empty();
+    }
+
+    // Return a local copy of the remote object at 'location', downloading it
+    // into the cache directory on a miss. Peers listed in
+    // server_config.router_peers are tried before S3: a LAN copy of a warm
+    // index beats an S3 round trip by the bandwidth ratio.
+    Status
+    FetchOrDownload(const std::string& location, std::string& local_path);
+
+    // Like FetchOrDownload but never downloads: reports whether a cached copy
+    // exists, refreshing its timestamp on a hit. Used by the transfer service
+    // to serve only what this node already holds.
+    bool
+    Peek(const std::string& location, std::string& local_path);
+
+ private:
+    DiskCacheMgr();
+
+    std::string
+    CacheFilePath(const std::string& location) const;
+
+    // caller must hold mutex_
+    void
+    EnsureCapacity(int64_t incoming_size);
+
+ private:
+    std::string path_;
+    int64_t capacity_ = 0;  // bytes; <= 0 means unbounded
+    std::mutex mutex_;
+};
+
+}  // namespace cache
+}  // namespace milvus
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "cache/GpuCacheMgr.h"
+#include "cache/GpuMemoryBroker.h"
 #include "server/Config.h"
 #include "utils/Log.h"
 
@@ -28,7 +29,7 @@ namespace {
 constexpr int64_t G_BYTE = 1024 * 1024 * 1024;
 }
 
-GpuCacheMgr::GpuCacheMgr() {
+GpuCacheMgr::GpuCacheMgr(uint64_t gpu_id) {
     // All config values have been checked in Config::ValidateConfig()
     server::Config& config = server::Config::GetInstance();
 
@@ -36,6 +37,13 @@ GpuCacheMgr::GpuCacheMgr() {
     config.GetGpuResourceConfigCacheCapacity(gpu_cache_cap);
     int64_t cap = gpu_cache_cap * G_BYTE;
     cache_ = std::make_shared<Cache<DataObjPtr>>(cap, 1UL << 32);
+    cache_->set_name("gpu_" + std::to_string(gpu_id));
+
+    // carve the cache capacity out of the device budget so scheduler tasks
+    // only compete for what is actually left
+    if (!GpuMemoryBroker::GetInstance(gpu_id)->Reserve(cap)) {
+        SERVER_LOG_WARNING << "Gpu cache capacity of gpu" << gpu_id << " exceeds the device memory budget";
+    }
 
     float gpu_mem_threshold;
     config.GetGpuResourceConfigCacheThreshold(gpu_mem_threshold);
@@ -47,7 +55,7 @@ GpuCacheMgr::GetInstance(uint64_t gpu_id) {
     if (instance_.find(gpu_id) == instance_.end()) {
         std::lock_guard<std::mutex> lock(mutex_);
         if (instance_.find(gpu_id) == instance_.end()) {
-            instance_.insert(std::pair<uint64_t, GpuCacheMgrPtr>(gpu_id, std::make_shared<GpuCacheMgr>()));
+            instance_.insert(std::pair<uint64_t, GpuCacheMgrPtr>(gpu_id, std::make_shared<GpuCacheMgr>(gpu_id)));
         }
         return instance_[gpu_id].get();
     } else {
@@ -56,6 +64,16 @@ GpuCacheMgr::GetInstance(uint64_t gpu_id) {
     }
 }
 
+std::vector<uint64_t>
+GpuCacheMgr::InstanceIds() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<uint64_t> ids;
+    for (auto& pair : instance_) {
+        ids.push_back(pair.first);
+    }
+    return ids;
+}
+
 DataObjPtr
 GpuCacheMgr::GetIndex(const std::string& key) {
     DataObjPtr obj = GetItem(key);
@@ -15,6 +15,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace milvus {
 namespace cache {
@@ -25,11 +26,15 @@ using GpuCacheMgrPtr = std::shared_ptr<GpuCacheMgr>;
 
 class GpuCacheMgr : public CacheMgr<DataObjPtr> {
  public:
-    GpuCacheMgr();
+    explicit GpuCacheMgr(uint64_t gpu_id);
 
     static GpuCacheMgr*
     GetInstance(uint64_t gpu_id);
 
+    // ids of the devices whose cache has been created so far
+    static std::vector<uint64_t>
+    InstanceIds();
+
     DataObjPtr
     GetIndex(const std::string& key);
 
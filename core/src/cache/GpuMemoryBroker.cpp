@@ -0,0 +1,94 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "cache/GpuMemoryBroker.h"
+#include "utils/Log.h"
+#include "utils/ValidationUtil.h"
+
+#include <utility>
+
+namespace milvus {
+namespace cache {
+
+#ifdef MILVUS_GPU_VERSION
+std::mutex GpuMemoryBroker::map_mutex_;
+std::unordered_map<uint64_t, GpuMemoryBrokerPtr> GpuMemoryBroker::instance_;
+
+namespace {
+constexpr int64_t G_BYTE = 1024 * 1024 * 1024;
+// left to the CUDA context, cublas workspaces and other allocations the
+// broker cannot see
+constexpr int64_t DEVICE_HEADROOM = G_BYTE;
+}  // namespace
+
+GpuMemoryBroker::GpuMemoryBroker(uint64_t gpu_id) {
+    size_t device_memory = 0;
+    auto status = server::ValidationUtil::GetGpuMemory(gpu_id, device_memory);
+    if (!status.ok()) {
+        SERVER_LOG_ERROR << "Cannot query memory size of gpu" << gpu_id << ", gpu memory accounting is disabled";
+        return;
+    }
+    budget_ = static_cast<int64_t>(device_memory) - DEVICE_HEADROOM;
+    if (budget_ < 0) {
+        budget_ = 0;
+    }
+}
+
+GpuMemoryBroker*
+GpuMemoryBroker::GetInstance(uint64_t gpu_id) {
+    std::lock_guard<std::mutex> lock(map_mutex_);
+    if (instance_.find(gpu_id) == instance_.end()) {
+        instance_.insert(std::make_pair(gpu_id, std::make_shared<GpuMemoryBroker>(gpu_id)));
+    }
+    return instance_[gpu_id].get();
+}
+
+bool
+GpuMemoryBroker::Reserve(int64_t bytes) {
+    if (budget_ <= 0 || bytes <= 0) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (reserved_ + bytes > budget_) {
+        return false;
+    }
+    reserved_ += bytes;
+    return true;
+}
+
+void
+GpuMemoryBroker::WaitReserve(int64_t bytes) {
+    if (budget_ <= 0 || bytes <= 0) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_.wait(lock, [this, bytes] { return reserved_ + bytes <= budget_ || reserved_ == 0; });
+    reserved_ += bytes;
+}
+
+void
+GpuMemoryBroker::Release(int64_t bytes) {
+    if (budget_ <= 0 || bytes <= 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        reserved_ -= bytes;
+        if (reserved_ < 0) {
+            reserved_ = 0;
+        }
+    }
+    cv_.notify_all();
+}
+#endif
+
+}  // namespace cache
+}  // namespace milvus
@@ -0,0 +1,68 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace milvus {
+namespace cache {
+
+#ifdef MILVUS_GPU_VERSION
+class GpuMemoryBroker;
+using GpuMemoryBrokerPtr = std::shared_ptr<GpuMemoryBroker>;
+
+// Single accounting point for device memory on one GPU. The gpu cache
+// reserves its capacity up front and scheduler tasks reserve their working
+// set before loading, so a build and a search racing for the same device
+// block on the broker instead of aborting inside cudaMalloc. The budget is
+// the physical device memory minus a fixed headroom for the CUDA context.
+class GpuMemoryBroker {
+ public:
+    explicit GpuMemoryBroker(uint64_t gpu_id);
+
+    static GpuMemoryBroker*
+    GetInstance(uint64_t gpu_id);
+
+    int64_t
+    Budget() const {
+        return budget_;
+    }
+
+    // Non-blocking; false if the reservation does not fit right now.
+    bool
+    Reserve(int64_t bytes);
+
+    // Block until the reservation fits. A request larger than the whole
+    // budget is granted once the device is otherwise idle, so an oversized
+    // task stalls rather than deadlocks.
+    void
+    WaitReserve(int64_t bytes);
+
+    void
+    Release(int64_t bytes);
+
+ private:
+    int64_t budget_ = 0;
+    int64_t reserved_ = 0;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+
+    static std::mutex map_mutex_;
+    static std::unordered_map<uint64_t, GpuMemoryBrokerPtr> instance_;
+};
+#endif
+
+}  // namespace cache
+}  // namespace milvus
@@ -16,35 +16,65 @@
 #include <stdexcept>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace milvus {
 namespace cache {
 
+// how cached entries are ordered for eviction
+enum class EvictionPolicy {
+    LRU = 0,    // pure recency
+    LRU_2 = 1,  // scan resistant: an entry must be hit twice to leave the probation segment
+};
+
+// Entries live in one of two segments. Under pure LRU only the recent
+// (probation) segment is used and behavior is the classic single-list LRU.
+// Under LRU_2 a new entry starts in the probation segment and is promoted to
+// the protected segment on its second access; eviction drains probation
+// first, so a one-pass scan cannot flush entries that were hit twice.
 template <typename key_t, typename value_t>
 class LRU {
  public:
     typedef typename std::pair<key_t, value_t> key_value_pair_t;
     typedef typename std::list<key_value_pair_t>::iterator list_iterator_t;
-    typedef typename std::list<key_value_pair_t>::reverse_iterator reverse_list_iterator_t;
 
     explicit LRU(size_t max_size) : max_size_(max_size) {
     }
 
+    // must be chosen before the cache is populated
+    void
+    set_policy(EvictionPolicy policy) {
+        policy_ = policy;
+    }
+
+    EvictionPolicy
+    policy() const {
+        return policy_;
+    }
+
     void
     put(const key_t& key, const value_t& value) {
         auto it = cache_items_map_.find(key);
-        cache_items_list_.push_front(key_value_pair_t(key, value));
         if (it != cache_items_map_.end()) {
-            cache_items_list_.erase(it->second);
-            cache_items_map_.erase(it);
+            // a re-insert counts as another access
+            bool frequent = (policy_ == EvictionPolicy::LRU_2);
+            auto& target = frequent ? frequent_list_ : recent_list_;
+            owner_list(it->second).erase(it->second.iter);
+            target.push_front(key_value_pair_t(key, value));
+            it->second.iter = target.begin();
+            it->second.frequent = frequent;
+        } else {
+            // new entries start in the recent (probation) segment
+            recent_list_.push_front(key_value_pair_t(key, value));
+            cache_items_map_[key] = map_entry_t{recent_list_.begin(), false};
         }
-        cache_items_map_[key] = cache_items_list_.begin();
 
         if (cache_items_map_.size() > max_size_) {
-            auto last = cache_items_list_.end();
+            auto& victims = recent_list_.empty() ? frequent_list_ : recent_list_;
+            auto last = victims.end();
             last--;
             cache_items_map_.erase(last->first);
-            cache_items_list_.pop_back();
+            victims.pop_back();
         }
     }
 
@@ -53,17 +83,24 @@ class LRU {
         auto it = cache_items_map_.find(key);
         if (it == cache_items_map_.end()) {
             throw std::range_error("There is no such key in cache");
+        }
+
+        if (policy_ == EvictionPolicy::LRU_2 && !it->second.frequent) {
+            // second access: promote out of the probation segment
+            frequent_list_.splice(frequent_list_.begin(), recent_list_, it->second.iter);
+            it->second.frequent = true;
         } else {
-            cache_items_list_.splice(cache_items_list_.begin(), cache_items_list_, it->second);
-            return it->second->second;
+            auto& owner = owner_list(it->second);
+            owner.splice(owner.begin(), owner, it->second.iter);
         }
+        return it->second.iter->second;
     }
 
     void
     erase(const key_t& key) {
         auto it = cache_items_map_.find(key);
         if (it != cache_items_map_.end()) {
-            cache_items_list_.erase(it->second);
+            owner_list(it->second).erase(it->second.iter);
             cache_items_map_.erase(it);
         }
     }
@@ -78,38 +115,45 @@ class LRU {
         return cache_items_map_.size();
     }
 
-    list_iterator_t
-    begin() {
-        iter_ = cache_items_list_.begin();
-        return iter_;
-    }
-
-    list_iterator_t
-    end() {
-        return cache_items_list_.end();
-    }
-
-    reverse_list_iterator_t
-    rbegin() {
-        return cache_items_list_.rbegin();
-    }
-
-    reverse_list_iterator_t
-    rend() {
-        return cache_items_list_.rend();
+    // entries in eviction order, best victim first: the probation segment
+    // oldest first, then the protected segment oldest first
+    std::vector<key_value_pair_t>
+    eviction_candidates() const {
+        std::vector<key_value_pair_t> candidates;
+        candidates.reserve(cache_items_map_.size());
+        for (auto it = recent_list_.rbegin(); it != recent_list_.rend(); ++it) {
+            candidates.push_back(*it);
+        }
+        for (auto it = frequent_list_.rbegin(); it != frequent_list_.rend(); ++it) {
+            candidates.push_back(*it);
+        }
+        return candidates;
     }
 
     void
     clear() {
-        cache_items_list_.clear();
+        recent_list_.clear();
+        frequent_list_.clear();
         cache_items_map_.clear();
     }
 
  private:
-    std::list<key_value_pair_t> cache_items_list_;
-    std::unordered_map<key_t, list_iterator_t> cache_items_map_;
+    struct map_entry_t {
+        list_iterator_t iter;
+        bool frequent;
+    };
+
+    std::list<key_value_pair_t>&
+    owner_list(const map_entry_t& entry) {
+        return entry.frequent ? frequent_list_ : recent_list_;
+    }
+
+ private:
+    std::list<key_value_pair_t> recent_list_;
+    std::list<key_value_pair_t> frequent_list_;
+    std::unordered_map<key_t, map_entry_t> cache_items_map_;
     size_t max_size_;
-    list_iterator_t iter_;
+    EvictionPolicy policy_ = EvictionPolicy::LRU;
 };
 
 }  // namespace cache
@@ -0,0 +1,225 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/AttrSidecar.h"
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+constexpr const char* ATTR_FILE_SUFFIX = ".attr";
+constexpr uint32_t ATTR_FILE_MAGIC = 0x52545441;  // "ATTR"
+constexpr uint8_t ATTR_FORMAT_VERSION = 1;
+
+std::string
+AttrPath(const std::string& location) {
+    return location + ATTR_FILE_SUFFIX;
+}
+
+// an immutable, shareable in-memory sidecar
+struct LoadedSidecar {
+    IDNumbers ids_;
+    AttributeColumns columns_;
+};
+
+using LoadedSidecarPtr = std::shared_ptr<LoadedSidecar>;
+
+std::mutex cache_mutex;
+std::unordered_map<std::string, LoadedSidecarPtr> sidecar_cache;
+
+template <typename T>
+bool
+ReadPod(std::ifstream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return in.good();
+}
+
+bool
+ReadString(std::ifstream& in, std::string& value) {
+    uint32_t len = 0;
+    if (!ReadPod(in, len)) {
+        return false;
+    }
+    value.resize(len);
+    if (len > 0) {
+        in.read(&value[0], len);
+    }
+    return in.good();
+}
+
+template <typename T>
+void
+WritePod(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void
+WriteString(std::ofstream& out, const std::string& value) {
+    auto len = static_cast<uint32_t>(value.size());
+    WritePod(out, len);
+    out.write(value.data(), value.size());
+}
+
+}  // namespace
+
+void
+AttrSidecar::AppendColumns(AttributeColumns& dest, size_t dest_rows, const AttributeColumns& src, size_t from,
+                           size_t count) {
+    for (auto& pair : src) {
+        auto& column = dest[pair.first];
+        column.resize(dest_rows);
+        for (size_t i = from; i < from + count; i++) {
+            column.push_back(i < pair.second.size() ? pair.second[i] : std::string());
+        }
+    }
+}
+
+Status
+AttrSidecar::Write(const std::string& location, const IDNumbers& ids, AttributeColumns& columns) {
+    if (columns.empty()) {
+        return Status::OK();
+    }
+
+    for (auto& pair : columns) {
+        pair.second.resize(ids.size());
+    }
+
+    std::ofstream out(AttrPath(location), std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return Status(DB_ERROR, "Failed to create attribute sidecar for " + location);
+    }
+
+    WritePod(out, ATTR_FILE_MAGIC);
+    WritePod(out, ATTR_FORMAT_VERSION);
+    WritePod(out, static_cast<uint64_t>(ids.size()));
+    WritePod(out, static_cast<uint32_t>(columns.size()));
+    out.write(reinterpret_cast<const char*>(ids.data()), ids.size() * sizeof(IDNumber));
+    for (auto& pair : columns) {
+        WriteString(out, pair.first);
+        for (auto& value : pair.second) {
+            WriteString(out, value);
+        }
+    }
+
+    out.close();
+    if (!out.good()) {
+        return Status(DB_ERROR, "Failed to write attribute sidecar for " + location);
+    }
+    return Status::OK();
+}
+
+bool
+AttrSidecar::Exists(const std::string& location) {
+    return std::ifstream(AttrPath(location)).good();
+}
+
+Status
+AttrSidecar::Read(const std::string& location, IDNumbers& ids, AttributeColumns& columns) {
+    std::ifstream in(AttrPath(location), std::ios::binary);
+    if (!in.is_open()) {
+        return Status(DB_NOT_FOUND, "No attribute sidecar for " + location);
+    }
+
+    uint32_t magic = 0;
+    uint8_t version = 0;
+    uint64_t row_count = 0;
+    uint32_t column_count = 0;
+    if (!ReadPod(in, magic) || magic != ATTR_FILE_MAGIC || !ReadPod(in, version) || version != ATTR_FORMAT_VERSION ||
+        !ReadPod(in, row_count) || !ReadPod(in, column_count)) {
+        return Status(DB_ERROR, "Corrupted attribute sidecar header for " + location);
+    }
+
+    ids.resize(row_count);
+    in.read(reinterpret_cast<char*>(ids.data()), row_count * sizeof(IDNumber));
+    if (!in.good()) {
+        return Status(DB_ERROR, "Corrupted attribute sidecar for " + location);
+    }
+
+    for (uint32_t c = 0; c < column_count; c++) {
+        std::string name;
+        if (!ReadString(in, name)) {
+            return Status(DB_ERROR, "Corrupted attribute sidecar for " + location);
+        }
+        auto& column = columns[name];
+        column.resize(row_count);
+        for (uint64_t r = 0; r < row_count; r++) {
+            if (!ReadString(in, column[r])) {
+                return Status(DB_ERROR, "Corrupted attribute sidecar for " + location);
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status
+AttrSidecar::Match(const std::string& location, const AttributeFilter& filter, std::vector<IDNumber>& matching_ids,
+                   bool& unfiltered) {
+    unfiltered = false;
+
+    LoadedSidecarPtr sidecar;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto iter = sidecar_cache.find(location);
+        if (iter != sidecar_cache.end()) {
+            sidecar = iter->second;
+        }
+    }
+
+    if (sidecar == nullptr) {
+        if (!Exists(location)) {
+            unfiltered = true;
+            return Status::OK();
+        }
+        auto loaded = std::make_shared<LoadedSidecar>();
+        auto status = Read(location, loaded->ids_, loaded->columns_);
+        if (!status.ok()) {
+            return status;
+        }
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto& slot = sidecar_cache[location];
+        if (slot == nullptr) {
+            slot = loaded;
+        }
+        sidecar = slot;
+    }
+
+    matching_ids.clear();
+    for (size_t row = 0; row < sidecar->ids_.size(); row++) {
+        bool match = true;
+        for (auto& condition : filter.conditions_) {
+            auto column = sidecar->columns_.find(condition.first);
+            if (column == sidecar->columns_.end() || condition.second.count(column->second[row]) == 0) {
+                match = false;
+                break;
+            }
+        }
+        if (match) {
+            matching_ids.push_back(sidecar->ids_[row]);
+        }
+    }
+    return Status::OK();
+}
+
+void
+AttrSidecar::Evict(const std::string& location) {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    sidecar_cache.erase(location);
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,59 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Types.h"
+
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// Columnar scalar-attribute sidecar stored next to a segment as
+// <location>.attr. The sidecar is self-describing: it carries its own id
+// array, so rows stay addressable after the segment is merged or re-indexed.
+// A segment without a sidecar has no attributes and is searched unfiltered.
+class AttrSidecar {
+ public:
+    // appends src rows [from, from + count) onto dest columns holding
+    // dest_rows rows so far; columns new to dest are back-filled with empty
+    // values, columns missing from src are padded by the next append or write
+    static void
+    AppendColumns(AttributeColumns& dest, size_t dest_rows, const AttributeColumns& src, size_t from, size_t count);
+
+    // pads every column to ids.size() rows and writes <location>.attr;
+    // a no-op with ok status when columns is empty
+    static Status
+    Write(const std::string& location, const IDNumbers& ids, AttributeColumns& columns);
+
+    static bool
+    Exists(const std::string& location);
+
+    static Status
+    Read(const std::string& location, IDNumbers& ids, AttributeColumns& columns);
+
+    // Ids of the segment's rows matching the filter, in sidecar order. Sets
+    // unfiltered when the segment carries no sidecar, in which case the caller
+    // must keep every row. Loaded sidecars are cached per location; segments
+    // are immutable, so entries only leave the cache through Evict.
+    static Status
+    Match(const std::string& location, const AttributeFilter& filter, std::vector<IDNumber>& matching_ids,
+          bool& unfiltered);
+
+    // drops the cached sidecar of a merged-away or deleted segment
+    static void
+    Evict(const std::string& location);
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,312 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/AutoTuner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <unordered_set>
+#include <utility>
+
+#include "db/engine/EngineFactory.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+#include "wrapper/TunedParamsMgr.h"
+
+namespace milvus {
+namespace engine {
+
+namespace {
+// query_record.bin header, kept in sync with server/delivery/QueryRecorder.h
+constexpr char MAGIC[4] = {'M', 'Q', 'R', 'L'};
+constexpr uint32_t VERSION = 1;
+
+constexpr int64_t MAX_SAMPLE_QUERIES = 64;  // per table, most recent kept
+constexpr int64_t MAX_TOPK = 100;
+constexpr float RECALL_TARGET = 0.95f;
+// re-check the knobs this often while the tuner is disabled, so a hot-reload
+// that turns it on takes effect without a restart
+constexpr int64_t IDLE_RECHECK_SECONDS = 60;
+
+template <typename T>
+bool
+ReadValue(std::ifstream& file, T& value) {
+    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return file.good();
+}
+
+bool
+TunableEngineType(int32_t engine_type) {
+    // only types whose search default comes from IVFConfAdapter::MatchSearch;
+    // PQ requires an explicit nprobe and graph indexes do not probe lists
+    return engine_type == static_cast<int32_t>(EngineType::FAISS_IVFFLAT) ||
+           engine_type == static_cast<int32_t>(EngineType::FAISS_IVFSQ8);
+}
+}  // namespace
+
+AutoTuner::AutoTuner(const meta::MetaPtr& meta_ptr) : meta_ptr_(meta_ptr) {
+    std::string primary_path;
+    server::Config::GetInstance().GetStorageConfigPrimaryPath(primary_path);
+    record_path_ = primary_path + "/query_record.bin";
+}
+
+void
+AutoTuner::Start() {
+    running_.store(true);
+    thread_ = std::thread(&AutoTuner::TuneLoop, this);
+}
+
+void
+AutoTuner::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_.store(false);
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void
+AutoTuner::TuneLoop() {
+    server::Config& config = server::Config::GetInstance();
+    while (running_.load()) {
+        int64_t interval = 0;
+        config.GetEngineConfigAutoTuneInterval(interval);
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            auto wait = std::chrono::seconds(interval > 0 ? interval : IDLE_RECHECK_SECONDS);
+            cv_.wait_for(lock, wait, [this] { return !running_.load(); });
+        }
+        if (!running_.load()) {
+            break;
+        }
+        if (interval <= 0) {
+            continue;  // disabled; knobs re-checked after the idle wait
+        }
+
+        bool apply = false;
+        config.GetEngineConfigAutoTuneApply(apply);
+
+        std::map<std::string, TableSample> samples;
+        auto status = CollectSamples(samples);
+        if (!status.ok()) {
+            ENGINE_LOG_WARNING << "Auto-tune skipped: " << status.message();
+            continue;
+        }
+
+        for (auto& pair : samples) {
+            if (!running_.load()) {
+                break;
+            }
+            status = TuneTable(pair.first, pair.second, apply);
+            if (!status.ok()) {
+                ENGINE_LOG_WARNING << "Auto-tune of table " << pair.first << " failed: " << status.message();
+            }
+        }
+    }
+}
+
+Status
+AutoTuner::CollectSamples(std::map<std::string, TableSample>& samples) {
+    std::ifstream file(record_path_, std::ios::binary);
+    if (!file.is_open()) {
+        return Status(DB_ERROR, "query record log not found: " + record_path_);
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    file.read(magic, sizeof(magic));
+    if (!file.good() || std::memcmp(magic, MAGIC, sizeof(magic)) != 0 || !ReadValue(file, version) ||
+        version != VERSION) {
+        return Status(DB_ERROR, "unrecognized query record log header");
+    }
+
+    // records are appended in time order; a deque per table keeps the most
+    // recent queries bounded. Any short read means the recorder is mid-write
+    // on the last record, so parsing simply stops there.
+    while (true) {
+        uint64_t timestamp_us;
+        uint16_t table_len;
+        int64_t topk, nprobe;
+        uint8_t is_binary;
+        uint32_t nq;
+        uint64_t payload_bytes;
+
+        if (!ReadValue(file, timestamp_us) || !ReadValue(file, table_len)) {
+            break;
+        }
+        std::string table_id(table_len, '\0');
+        file.read(&table_id[0], table_len);
+        if (!file.good() || !ReadValue(file, topk) || !ReadValue(file, nprobe) || !ReadValue(file, is_binary) ||
+            !ReadValue(file, nq) || !ReadValue(file, payload_bytes)) {
+            break;
+        }
+
+        if (is_binary != 0 || nq == 0 || payload_bytes % (nq * sizeof(float)) != 0) {
+            file.seekg(static_cast<std::streamoff>(payload_bytes), std::ios::cur);
+            if (!file.good()) {
+                break;
+            }
+            continue;
+        }
+
+        auto dim = static_cast<uint16_t>(payload_bytes / (nq * sizeof(float)));
+        std::vector<float> payload(static_cast<size_t>(nq) * dim);
+        file.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload_bytes));
+        if (!file.good()) {
+            break;
+        }
+
+        auto& sample = samples[table_id];
+        if (sample.dim != dim) {
+            sample.queries.clear();  // dimension changed: the table was recreated
+            sample.dim = dim;
+        }
+        sample.topk = topk;
+        for (uint32_t i = 0; i < nq; ++i) {
+            sample.queries.emplace_back(payload.begin() + static_cast<size_t>(i) * dim,
+                                        payload.begin() + static_cast<size_t>(i + 1) * dim);
+            if (static_cast<int64_t>(sample.queries.size()) > MAX_SAMPLE_QUERIES) {
+                sample.queries.pop_front();
+            }
+        }
+    }
+
+    for (auto iter = samples.begin(); iter != samples.end();) {
+        iter = iter->second.queries.empty() ? samples.erase(iter) : std::next(iter);
+    }
+    if (samples.empty()) {
+        return Status(DB_ERROR, "query record log contains no float queries");
+    }
+    return Status::OK();
+}
+
+Status
+AutoTuner::TuneTable(const std::string& table_id, const TableSample& sample, bool apply) {
+    meta::TableSchema schema;
+    schema.table_id_ = table_id;
+    auto status = meta_ptr_->DescribeTable(schema);
+    if (!status.ok()) {
+        return status;  // table dropped since it was recorded
+    }
+    if (!TunableEngineType(schema.engine_type_) || schema.dimension_ != sample.dim || schema.nlist_ <= 1) {
+        return Status::OK();
+    }
+
+    meta::TableFilesSchema files;
+    status = meta_ptr_->FilesByType(table_id, {meta::TableFileSchema::INDEX}, files);
+    if (!status.ok() || files.empty()) {
+        return status;  // nothing indexed yet, try again next cycle
+    }
+
+    // smallest index segment: cheapest to evaluate and recall transfers, since
+    // every segment of the table is trained on the same data distribution
+    auto file = *std::min_element(files.begin(), files.end(),
+                                  [](const meta::TableFileSchema& l, const meta::TableFileSchema& r) {
+                                      return l.file_size_ < r.file_size_;
+                                  });
+
+    auto engine = EngineFactory::Build(file.dimension_, file.location_, static_cast<EngineType>(file.engine_type_),
+                                       static_cast<MetricType>(schema.metric_type_), schema.nlist_);
+    if (engine == nullptr) {
+        return Status(DB_ERROR, "failed to build engine for " + file.location_);
+    }
+    status = engine->Load(false);  // keep the evaluation out of the search cache
+    if (!status.ok()) {
+        return status;
+    }
+
+    auto nq = static_cast<int64_t>(sample.queries.size());
+    std::vector<float> queries(static_cast<size_t>(nq) * sample.dim);
+    for (int64_t i = 0; i < nq; ++i) {
+        std::copy(sample.queries[i].begin(), sample.queries[i].end(), queries.begin() + i * sample.dim);
+    }
+    int64_t topk = std::min<int64_t>(std::max<int64_t>(sample.topk, 1), MAX_TOPK);
+    auto nlist = static_cast<int64_t>(schema.nlist_);
+
+    // ground truth: scan every inverted list of the same segment. That differs
+    // from the candidates in exactly the quantity nprobe controls, and works
+    // after the raw files backing the index have been reclaimed.
+    std::vector<int64_t> gt_ids(nq * topk);
+    std::vector<float> gt_distances(nq * topk);
+    status = engine->Search(nq, queries.data(), topk, nlist, gt_distances.data(), gt_ids.data(), false);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::vector<int64_t> candidates;
+    for (int64_t nprobe = 1; nprobe < nlist; nprobe *= 2) {
+        candidates.push_back(nprobe);
+    }
+
+    TunedSearchParams best;
+    std::vector<int64_t> ids(nq * topk);
+    std::vector<float> distances(nq * topk);
+    for (auto nprobe : candidates) {
+        auto start = std::chrono::steady_clock::now();
+        status = engine->Search(nq, queries.data(), topk, nprobe, distances.data(), ids.data(), false);
+        auto finish = std::chrono::steady_clock::now();
+        if (!status.ok()) {
+            return status;
+        }
+
+        int64_t hit = 0, total = 0;
+        for (int64_t i = 0; i < nq; ++i) {
+            std::unordered_set<int64_t> gt;
+            for (int64_t j = 0; j < topk; ++j) {
+                if (gt_ids[i * topk + j] >= 0) {
+                    gt.insert(gt_ids[i * topk + j]);
+                }
+            }
+            total += gt.size();
+            for (int64_t j = 0; j < topk; ++j) {
+                hit += gt.count(ids[i * topk + j]);
+            }
+        }
+
+        TunedSearchParams point;
+        point.nprobe = nprobe;
+        point.recall = total > 0 ? static_cast<float>(hit) / total : 0.0f;
+        point.latency_ms = std::chrono::duration<double, std::milli>(finish - start).count() / nq;
+        ENGINE_LOG_INFO << "Auto-tune table " << table_id << ": nprobe " << point.nprobe << " recall " << point.recall
+                        << " latency " << point.latency_ms << " ms (nq " << nq << " topk " << topk << ")";
+
+        // frontier point with the lowest latency that reaches the target; the
+        // sweep is ascending, so keep the last point while still short of it
+        if (best.nprobe == 0 || best.recall < RECALL_TARGET) {
+            best = point;
+        }
+        if (best.recall >= RECALL_TARGET) {
+            break;
+        }
+    }
+    if (best.nprobe == 0) {
+        return Status::OK();
+    }
+
+    if (apply) {
+        TunedParamsMgr::GetInstance().Set(table_id, best);
+        ENGINE_LOG_INFO << "Auto-tune table " << table_id << ": default nprobe set to " << best.nprobe;
+    } else {
+        ENGINE_LOG_INFO << "Auto-tune table " << table_id << ": recommend nprobe " << best.nprobe
+                        << " (engine_config.auto_tune_apply is off)";
+    }
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
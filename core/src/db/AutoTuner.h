@@ -0,0 +1,78 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "db/meta/Meta.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+// Background auto-tuner for per-table search defaults. Every
+// engine_config.auto_tune_interval seconds it replays recent production
+// queries from the query sampling log (see server/delivery/QueryRecorder.h)
+// against one small index segment per table: an exhaustive scan of all
+// inverted lists provides the ground truth, then candidate nprobe values are
+// swept and their recall/latency measured. The full frontier is logged; the
+// smallest candidate reaching the recall target becomes the table's
+// recommendation and, when engine_config.auto_tune_apply is on, is published
+// through TunedParamsMgr so IVFConfAdapter::MatchSearch uses it whenever a
+// request does not set nprobe explicitly. Both knobs are read every cycle,
+// so config hot-reload can enable, retarget or disable the tuner at runtime.
+class AutoTuner {
+ public:
+    explicit AutoTuner(const meta::MetaPtr& meta_ptr);
+
+    void
+    Start();
+
+    void
+    Stop();
+
+ private:
+    // recent float queries of one table, reconstructed from the query log
+    struct TableSample {
+        uint16_t dim = 0;
+        int64_t topk = 0;  // topk of the most recent sampled request
+        std::deque<std::vector<float>> queries;
+    };
+
+    void
+    TuneLoop();
+
+    // parse the query log and keep the most recent queries per table
+    Status
+    CollectSamples(std::map<std::string, TableSample>& samples);
+
+    Status
+    TuneTable(const std::string& table_id, const TableSample& sample, bool apply);
+
+    meta::MetaPtr meta_ptr_;
+    std::string record_path_;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+}  // namespace engine
+}  // namespace milvus
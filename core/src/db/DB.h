@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Options.h"
@@ -58,8 +59,29 @@ class DB {
     virtual Status
     GetTableRowCount(const std::string& table_id, uint64_t& row_count) = 0;
 
+    // aggregate statistics of the table and each of its partitions, served
+    // from the maintained per-table aggregates without scanning file rows.
+    // `total` sums the parent table and all partitions; partition_stats pairs
+    // each partition tag with its own aggregates.
     virtual Status
-    PreloadTable(const std::string& table_id) = 0;
+    DescribeTableStats(const std::string& table_id, meta::TableStats& total,
+                       std::vector<std::pair<std::string, meta::TableStats>>& partition_stats) = 0;
+
+    // `priority` is a cache eviction class: -1 evict first, 0 normal, 1 evict last.
+    // A pinned table is never evicted from cpu cache until it is dropped.
+    // `partition_tags` and `dates` scope the preload the same way they scope a
+    // query; files are loaded most-recent-first so the window of interest is
+    // resident before the cache budget runs out.
+    virtual Status
+    PreloadTable(const std::string& table_id, bool pin = false, int64_t priority = 0,
+                 const std::vector<std::string>& partition_tags = std::vector<std::string>(),
+                 const meta::DatesT& dates = meta::DatesT()) = 0;
+
+    // stable-sort the table ids hottest-first by how many of their bytes the
+    // persisted cache warm-state snapshot holds; startup preload uses this so
+    // the tables queries will hit first become ready first
+    virtual Status
+    OrderTablesByWarmth(std::vector<std::string>& table_ids) = 0;
 
     virtual Status
     UpdateTableFlag(const std::string& table_id, int64_t flag) = 0;
@@ -80,6 +102,24 @@ class DB {
     virtual Status
     InsertVectors(const std::string& table_id, const std::string& partition_tag, VectorsData& vectors) = 0;
 
+    // bulk-load path: writes the chunk straight into new segment files and
+    // registers them in meta, bypassing the insert memory buffer entirely
+    virtual Status
+    ImportVectors(const std::string& table_id, const std::string& partition_tag, VectorsData& vectors) = 0;
+
+    // inserts the vectors and lazily supersedes earlier versions of their
+    // ids; old versions are filtered at search time, not rewritten
+    virtual Status
+    UpsertVectors(const std::string& table_id, const std::string& partition_tag, VectorsData& vectors) = 0;
+
+    // Deletes the given ids from the table and its partitions by appending
+    // them to per-segment tombstone sidecars instead of rewriting segments;
+    // search masks the rows out immediately and merges reclaim them. Ids not
+    // stored are silently ignored; a later insert of the same id is a new,
+    // live row.
+    virtual Status
+    DeleteByID(const std::string& table_id, const IDNumbers& id_array) = 0;
+
     virtual Status
     Query(const std::shared_ptr<server::Context>& context, const std::string& table_id,
           const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
@@ -90,6 +130,43 @@ class DB {
           const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
           const meta::DatesT& dates, ResultIds& result_ids, ResultDistances& result_distances) = 0;
 
+    virtual Status
+    QueryStream(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe,
+                const VectorsData& vectors, const meta::DatesT& dates, const SearchStreamCallback& stream_callback,
+                ResultIds& result_ids, ResultDistances& result_distances) = 0;
+
+    // All neighbors within `radius` of each query vector; matches for query i are
+    // result_ids[result_lims[i]:result_lims[i+1]]. A non-zero max_k caps the number of
+    // matches kept per query.
+    virtual Status
+    QueryRange(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+               const std::vector<std::string>& partition_tags, float radius, uint64_t max_k, uint64_t nprobe,
+               const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances,
+               ResultLims& result_lims) = 0;
+
+    // Streams every stored vector of the table (and its partitions) to the
+    // callback, segment by segment, straight from the raw-layout files — no
+    // index is deserialized and no search is executed. Float tables only.
+    virtual Status
+    ExportTable(const std::string& table_id, const ExportChunkCallback& chunk_callback) = 0;
+
+    // Batched fetch of stored vectors by id from the table and its
+    // partitions, served from the raw-layout files (or their cached in-memory
+    // copy) without running a search. vectors[i] answers id_array[i] and
+    // stays empty (vector_count_ == 0) when the id is not stored. Float
+    // tables only.
+    virtual Status
+    GetVectorsByID(const std::string& table_id, const IDNumbers& id_array, std::vector<VectorsData>& vectors) = 0;
+
+    // Lists the files a search over `table_id` with the given partition scoping
+    // would touch, grouped by the (internal) table that owns them, so a shard
+    // router can fan segment subsets out to replicas via SearchInFiles. Empty
+    // tags mean the parent table plus every partition, like Query.
+    virtual Status
+    GetSearchFileIds(const std::string& table_id, const std::vector<std::string>& partition_tags,
+                     std::vector<std::pair<std::string, std::vector<std::string>>>& table_files) = 0;
+
     virtual Status
     QueryByFileID(const std::shared_ptr<server::Context>& context, const std::string& table_id,
                   const std::vector<std::string>& file_ids, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
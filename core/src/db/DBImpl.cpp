@@ -17,16 +17,30 @@
 #include <boost/filesystem.hpp>
 #include <chrono>
 #include <cstring>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <list>
 #include <set>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
+#include "AttrSidecar.h"
+#include "DeleteSidecar.h"
+#include "FileSchemaIntern.h"
 #include "Utils.h"
+#include "VectorLookup.h"
 #include "cache/CpuCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
 #include "engine/EngineFactory.h"
+#include "IDGenerator.h"
+#include "IdIndex.h"
+#include "MetaEventBus.h"
+#include "SegmentSizeTuner.h"
 #include "insert/MemMenagerFactory.h"
+#include "insert/VectorNormalizer.h"
 #include "meta/MetaConsts.h"
 #include "meta/MetaFactory.h"
 #include "meta/SqliteMetaImpl.h"
@@ -35,9 +49,15 @@
 #include "scheduler/job/BuildIndexJob.h"
 #include "scheduler/job/DeleteJob.h"
 #include "scheduler/job/SearchJob.h"
+#include "server/Config.h"
+#include "storage/file/FileIOUtil.h"
+#include "storage/s3/S3ClientWrapper.h"
 #include "utils/Log.h"
+#include "utils/MallocUtil.h"
 #include "utils/StringHelpFunctions.h"
 #include "utils/TimeRecorder.h"
+#include "wrapper/VecImpl.h"
+#include "wrapper/VecIndex.h"
 
 namespace milvus {
 namespace engine {
@@ -47,6 +67,27 @@ namespace {
 constexpr uint64_t METRIC_ACTION_INTERVAL = 1;
 constexpr uint64_t COMPACT_ACTION_INTERVAL = 1;
 constexpr uint64_t INDEX_ACTION_INTERVAL = 1;
+constexpr uint64_t ARCHIVE_ACTION_INTERVAL = 60;
+constexpr uint64_t RECONCILE_ACTION_INTERVAL = 60;
+constexpr uint64_t WARM_STATE_ACTION_INTERVAL = 60;
+constexpr int64_t WARM_REPLAY_THREAD_NUM = 2;
+
+// segment opens during startup preload are I/O bound; a few concurrent
+// loaders cut table recovery time without saturating the disks
+constexpr int64_t PRELOAD_THREAD_NUM = 4;
+constexpr uint64_t TIERING_ACTION_INTERVAL = 600;
+constexpr uint64_t TIERING_BATCH_SIZE = 64;  // files moved per pass, to bound the I/O burst
+constexpr uint64_t SCRUB_ACTION_INTERVAL = 3600;
+// files within this size ratio of each other count as merge peers; a large
+// file is never rewritten just to absorb a trickle of small ones
+constexpr uint64_t MERGE_TIER_RATIO = 4;
+
+// rolling index upgrades rebuild at most this many files per build pass, so
+// an index change on a large table never monopolizes the build resources
+constexpr uint64_t MAX_UPGRADE_FILES_PER_PASS = 1;
+
+// slab size for streaming raw files out during a table export
+constexpr size_t EXPORT_WINDOW_BYTES = 64 * 1024 * 1024;
 
 static const Status SHUTDOWN_ERROR = Status(DB_ERROR, "Milvus server is shutdown!");
 
@@ -59,10 +100,48 @@ TraverseFiles(const meta::DatePartionedTableFilesSchema& date_files, meta::Table
     }
 }
 
+// drops files that provably cannot contribute to a search: empty files
+// always, and in range mode over inner-product tables files whose max-norm
+// zone statistic caps every possible score below the radius. A zero
+// max_norm means the file predates the statistic, so it is kept.
+meta::TableFilesSchema
+PruneSearchFiles(const meta::TableFilesSchema& files, const VectorsData& vectors, bool range_search, float radius) {
+    double query_max_norm = 0.0;
+    if (range_search && !vectors.float_data_.empty() && vectors.vector_count_ > 0) {
+        int64_t dim = vectors.float_data_.size() / vectors.vector_count_;
+        query_max_norm = normalizer::MaxNorm(vectors.float_data_.data(), vectors.vector_count_, dim);
+    }
+
+    meta::TableFilesSchema pruned;
+    pruned.reserve(files.size());
+    for (auto& file : files) {
+        if (file.row_count_ == 0) {
+            continue;
+        }
+        if (range_search && file.metric_type_ == static_cast<int32_t>(MetricType::IP) && file.max_norm_ > 0.0 &&
+            query_max_norm * file.max_norm_ < radius) {
+            continue;  // Cauchy-Schwarz: no score in this file can reach the radius
+        }
+        pruned.push_back(file);
+    }
+
+    if (pruned.size() < files.size()) {
+        ENGINE_LOG_DEBUG_LAZY << "Zone statistics pruned " << (files.size() - pruned.size()) << " of " << files.size()
+                              << " search files";
+    }
+    return pruned;
+}
+
 }  // namespace
 
 DBImpl::DBImpl(const DBOptions& options)
-    : options_(options), initialized_(false), compact_thread_pool_(1, 1), index_thread_pool_(1, 1) {
+    : options_(options),
+      initialized_(false),
+      compact_thread_pool_(static_cast<size_t>(std::max(options.merge_concurrency_, static_cast<int64_t>(1))),
+                           static_cast<size_t>(std::max(options.merge_concurrency_, static_cast<int64_t>(1)))),
+      index_thread_pool_(1, 1),
+      tiering_thread_pool_(1, 1),
+      scrub_thread_pool_(1, 1) {
     meta_ptr_ = MetaFactory::Build(options.meta_, options.mode_);
     mem_mgr_ = MemManagerFactory::Build(meta_ptr_, options_);
     Start();
@@ -84,12 +163,50 @@ DBImpl::Start() {
     // ENGINE_LOG_TRACE << "DB service start";
     initialized_.store(true, std::memory_order_release);
 
+    // meta change notifications drive the merge/build loops; flush
+    // completions name a table, both kinds may create files to index
+    meta_event_subscription_ =
+        MetaEventBus::GetInstance().Subscribe([this](MetaEvent event, const std::string& table_id) {
+            if (event == MetaEvent::FLUSH_COMPLETED) {
+                std::lock_guard<std::mutex> lock(meta_event_mutex_);
+                event_table_ids_.insert(table_id);
+            }
+            index_pending_.store(true);
+        });
+
+    // when the last query pinning an already-retired file finishes, name the
+    // table so the next tick schedules housekeeping; reclaim then trails the
+    // last reader by a tick instead of the reconcile interval, no matter how
+    // steady the query stream is
+    ongoing_files_checker_.SetDrainCallback([this](const std::string& table_id) {
+        std::lock_guard<std::mutex> lock(meta_event_mutex_);
+        event_table_ids_.insert(table_id);
+    });
+
     // for distribute version, some nodes are read only
     if (options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
         // ENGINE_LOG_TRACE << "StartTimerTasks";
         bg_timer_thread_ = std::thread(&DBImpl::BackgroundTimerTask, this);
     }
 
+    // warm-state persistence: replay the cache key list persisted by the
+    // previous run so a planned restart does not start with a cold cache
+    int64_t replay_budget_gb = 0;
+    server::Config::GetInstance().GetCacheConfigWarmReplayBudget(replay_budget_gb);
+    warm_replay_budget_ = replay_budget_gb * ONE_GB;
+    warm_state_path_ = options_.meta_.path_ + "/cache_warm_state";
+    if (warm_replay_budget_ > 0) {
+        warm_replay_thread_ = std::thread(&DBImpl::ReplayCacheWarmState, this);
+    }
+
+    // search-parameter auto-tuning; the tuner idles until
+    // engine_config.auto_tune_interval is non-zero, so a later config
+    // hot-reload can switch it on without a restart
+    if (options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
+        auto_tuner_ = std::make_shared<AutoTuner>(meta_ptr_);
+        auto_tuner_->Start();
+    }
+
     return Status::OK();
 }
 
@@ -107,6 +224,15 @@ DBImpl::Stop() {
     // wait compaction/buildindex finish
     bg_timer_thread_.join();
 
+    MetaEventBus::GetInstance().Unsubscribe(meta_event_subscription_);
+    if (warm_replay_thread_.joinable()) {
+        warm_replay_thread_.join();
+    }
+
+    if (auto_tuner_ != nullptr) {
+        auto_tuner_->Stop();
+    }
+
     if (options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
         meta_ptr_->CleanUpShadowFiles();
     }
@@ -137,7 +263,16 @@ DBImpl::DropTable(const std::string& table_id, const meta::DatesT& dates) {
         return SHUTDOWN_ERROR;
     }
 
-    return DropTableRecursively(table_id, dates);
+    auto status = DropTableRecursively(table_id, dates);
+
+    // nudge the background loop so the dropped files get a cleanup pass
+    // without waiting for the slow reconcile tick
+    {
+        std::lock_guard<std::mutex> lock(meta_event_mutex_);
+        event_table_ids_.insert(table_id);
+    }
+
+    return status;
 }
 
 Status
@@ -181,65 +316,108 @@ DBImpl::AllTables(std::vector<meta::TableSchema>& table_schema_array) {
 }
 
 Status
-DBImpl::PreloadTable(const std::string& table_id) {
+DBImpl::PreloadTable(const std::string& table_id, bool pin, int64_t priority,
+                     const std::vector<std::string>& partition_tags, const meta::DatesT& dates) {
     if (!initialized_.load(std::memory_order_acquire)) {
         return SHUTDOWN_ERROR;
     }
 
-    // step 1: get all table files from parent table
-    meta::DatesT dates;
+    Status status;
     std::vector<size_t> ids;
     meta::TableFilesSchema files_array;
-    auto status = GetFilesToSearch(table_id, ids, dates, files_array);
-    if (!status.ok()) {
-        return status;
-    }
+    if (partition_tags.empty()) {
+        // step 1: get all table files from parent table
+        status = GetFilesToSearch(table_id, ids, dates, files_array);
+        if (!status.ok()) {
+            return status;
+        }
 
-    // step 2: get files from partition tables
-    std::vector<meta::TableSchema> partition_array;
-    status = meta_ptr_->ShowPartitions(table_id, partition_array);
-    for (auto& schema : partition_array) {
-        status = GetFilesToSearch(schema.table_id_, ids, dates, files_array);
+        // step 2: get files from partition tables
+        std::vector<meta::TableSchema> partition_array;
+        status = meta_ptr_->ShowPartitions(table_id, partition_array);
+        for (auto& schema : partition_array) {
+            status = GetFilesToSearch(schema.table_id_, ids, dates, files_array);
+        }
+    } else {
+        // scope the preload exactly like a query with the same tags
+        std::set<std::string> partition_name_array;
+        GetPartitionsByTags(table_id, partition_tags, partition_name_array);
+
+        for (auto& partition_name : partition_name_array) {
+            status = GetFilesToSearch(partition_name, ids, dates, files_array);
+        }
     }
 
+    // newest partitions first: when the table outsizes the cache budget, the
+    // window queries actually touch is resident instead of whichever files
+    // the meta happened to list first
+    std::stable_sort(files_array.begin(), files_array.end(),
+                     [](const meta::TableFileSchema& lhs, const meta::TableFileSchema& rhs) {
+                         return lhs.date_ > rhs.date_;
+                     });
+
     int64_t size = 0;
     int64_t cache_total = cache::CpuCacheMgr::GetInstance()->CacheCapacity();
     int64_t cache_usage = cache::CpuCacheMgr::GetInstance()->CacheUsage();
     int64_t available_size = cache_total - cache_usage;
 
-    // step 3: load file one by one
+    // step 3: fan the loads out across a small pool; the budget check stays
+    // serial so admission is deterministic, only the I/O overlaps
     ENGINE_LOG_DEBUG << "Begin pre-load table:" + table_id + ", totally " << files_array.size()
                      << " files need to be pre-loaded";
     TimeRecorderAuto rc("Pre-load table:" + table_id);
+    Status preload_status;
+    ThreadPool load_pool(PRELOAD_THREAD_NUM);
+    std::list<std::future<Status>> load_results;
     for (auto& file : files_array) {
         ExecutionEnginePtr engine = EngineFactory::Build(file.dimension_, file.location_, (EngineType)file.engine_type_,
                                                          (MetricType)file.metric_type_, file.nlist_);
         fiu_do_on("DBImpl.PreloadTable.null_engine", engine = nullptr);
         if (engine == nullptr) {
             ENGINE_LOG_ERROR << "Invalid engine type";
-            return Status(DB_ERROR, "Invalid engine type");
+            preload_status = Status(DB_ERROR, "Invalid engine type");
+            break;
         }
 
         size += engine->PhysicalSize();
         fiu_do_on("DBImpl.PreloadTable.exceed_cache", size = available_size + 1);
         if (size > available_size) {
             ENGINE_LOG_DEBUG << "Pre-load canceled since cache almost full";
-            return Status(SERVER_CACHE_FULL, "Cache is full");
-        } else {
+            preload_status = Status(SERVER_CACHE_FULL, "Cache is full");
+            break;
+        }
+
+        meta::TableFileSchema file_schema = file;
+        load_results.push_back(load_pool.enqueue([engine, file_schema, pin, priority]() -> Status {
             try {
                 fiu_do_on("DBImpl.PreloadTable.engine_throw_exception", throw std::exception());
-                std::string msg = "Pre-loaded file: " + file.file_id_ + " size: " + std::to_string(file.file_size_);
+                std::string msg =
+                    "Pre-loaded file: " + file_schema.file_id_ + " size: " + std::to_string(file_schema.file_size_);
                 TimeRecorderAuto rc_1(msg);
                 engine->Load(true);
+
+                if (pin || priority != 0) {
+                    cache::CpuCacheMgr::GetInstance()->SetItemAttr(file_schema.location_, pin,
+                                                                   static_cast<cache::CachePriority>(priority));
+                }
             } catch (std::exception& ex) {
                 std::string msg = "Pre-load table encounter exception: " + std::string(ex.what());
                 ENGINE_LOG_ERROR << msg;
                 return Status(DB_ERROR, msg);
             }
+            return Status::OK();
+        }));
+    }
+
+    // in-flight loads finish even when admission stopped early
+    for (auto& result : load_results) {
+        Status s = result.get();
+        if (!s.ok() && preload_status.ok()) {
+            preload_status = s;
         }
     }
 
-    return Status::OK();
+    return preload_status;
 }
 
 Status
@@ -260,6 +438,51 @@ DBImpl::GetTableRowCount(const std::string& table_id, uint64_t& row_count) {
     return GetTableRowCountRecursively(table_id, row_count);
 }
 
+Status
+DBImpl::DescribeTableStats(const std::string& table_id, meta::TableStats& total,
+                           std::vector<std::pair<std::string, meta::TableStats>>& partition_stats) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    bool has_table = false;
+    auto status = meta_ptr_->HasTable(table_id, has_table);
+    if (!status.ok()) {
+        return status;
+    }
+    if (!has_table) {
+        return Status(DB_NOT_FOUND, "Table " + table_id + " does not exist");
+    }
+
+    total = meta::TableStats();
+    partition_stats.clear();
+
+    status = meta_ptr_->GetTableStats(table_id, total);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::vector<meta::TableSchema> partition_array;
+    status = meta_ptr_->ShowPartitions(table_id, partition_array);
+    if (!status.ok()) {
+        return status;
+    }
+
+    for (auto& schema : partition_array) {
+        meta::TableStats stats;
+        status = meta_ptr_->GetTableStats(schema.table_id_, stats);
+        if (!status.ok()) {
+            return status;
+        }
+        total.row_count_ += stats.row_count_;
+        total.data_size_ += stats.data_size_;
+        total.file_count_ += stats.file_count_;
+        partition_stats.emplace_back(schema.partition_tag_, stats);
+    }
+
+    return Status::OK();
+}
+
 Status
 DBImpl::CreatePartition(const std::string& table_id, const std::string& partition_name,
                         const std::string& partition_tag) {
@@ -267,6 +490,8 @@ DBImpl::CreatePartition(const std::string& table_id, const std::string& partitio
         return SHUTDOWN_ERROR;
     }
 
+    // whole-table and tag-matched file lists must pick up the new partition
+    search_files_cache_.Invalidate(table_id);
     return meta_ptr_->CreatePartition(table_id, partition_name, partition_tag);
 }
 
@@ -278,12 +503,13 @@ DBImpl::DropPartition(const std::string& partition_name) {
 
     auto status = mem_mgr_->EraseMemVector(partition_name);  // not allow insert
     status = meta_ptr_->DropPartition(partition_name);       // soft delete table
+    search_files_cache_.Invalidate(partition_name);
 
-    // scheduler will determine when to delete table files
+    // scheduler will determine when to delete table files; the job finishes
+    // in the background, the foreground only leaves the meta tombstone
     auto nres = scheduler::ResMgrInst::GetInstance()->GetNumOfComputeResource();
     scheduler::DeleteJobPtr job = std::make_shared<scheduler::DeleteJob>(partition_name, meta_ptr_, nres);
     scheduler::JobMgrInst::GetInstance()->Put(job);
-    job->WaitAndDelete();
 
     return Status::OK();
 }
@@ -332,159 +558,660 @@ DBImpl::InsertVectors(const std::string& table_id, const std::string& partition_
         }
     }
 
+    bool dedup_check = false;
+    server::Config::GetInstance().GetEngineConfigInsertDedupCheck(dedup_check);
+    if (dedup_check) {
+        status = CheckDuplicateIds(target_table_name, vectors.id_array_);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
     // insert vectors into target table
-    milvus::server::CollectInsertMetrics metrics(vectors.vector_count_, status);
+    milvus::server::CollectInsertMetrics metrics(vectors.vector_count_, target_table_name, status);
+    SegmentSizeTuner::GetInstance().RecordInsert(target_table_name);
     status = mem_mgr_->InsertVectors(target_table_name, vectors);
+    if (dedup_check && status.ok()) {
+        // ids stay in the exact pending set until their segment filter exists
+        IdIndex::GetInstance().AddPending(target_table_name, vectors.id_array_);
+    }
 
     return status;
 }
 
 Status
-DBImpl::CreateIndex(const std::string& table_id, const TableIndex& index) {
-    if (!initialized_.load(std::memory_order_acquire)) {
-        return SHUTDOWN_ERROR;
+DBImpl::CheckDuplicateIds(const std::string& table_id, const IDNumbers& id_array) {
+    if (id_array.empty()) {
+        return Status::OK();
     }
 
-    // serialize memory data
-    std::set<std::string> sync_table_ids;
-    auto status = SyncMemData(sync_table_ids);
+    auto& id_index = IdIndex::GetInstance();
+    IDNumbers suspects;
+    for (auto id : id_array) {
+        if (id_index.PendingContains(table_id, id)) {
+            return Status(DB_ERROR, "Duplicate id " + std::to_string(id) + ": already inserted into table " +
+                                        table_id + ", not yet flushed");
+        }
+        if (id_index.TableMayContain(table_id, id)) {
+            suspects.push_back(id);
+        }
+    }
+    if (suspects.empty()) {
+        return Status::OK();
+    }
 
-    {
-        std::unique_lock<std::mutex> lock(build_index_mutex_);
+    // the segment filters admit rare false positives, so suspects are
+    // confirmed against the raw files before the batch is rejected
+    std::vector<VectorsData> found;
+    auto status = GetVectorsByID(table_id, suspects, found);
+    if (!status.ok()) {
+        // verification unavailable; admit the batch rather than reject on a
+        // probabilistic hit
+        return Status::OK();
+    }
+    for (size_t i = 0; i < found.size(); i++) {
+        if (found[i].vector_count_ > 0) {
+            return Status(DB_ERROR,
+                          "Duplicate id " + std::to_string(suspects[i]) + ": already exists in table " + table_id);
+        }
+    }
+    return Status::OK();
+}
 
-        // step 1: check index difference
-        TableIndex old_index;
-        status = DescribeIndex(table_id, old_index);
+Status
+DBImpl::ImportVectors(const std::string& table_id, const std::string& partition_tag, VectorsData& vectors) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    // if partition is specified, use partition as target table
+    Status status;
+    std::string target_table_name = table_id;
+    if (!partition_tag.empty()) {
+        std::string partition_name;
+        status = meta_ptr_->GetPartitionName(table_id, partition_tag, target_table_name);
         if (!status.ok()) {
-            ENGINE_LOG_ERROR << "Failed to get table index info for table: " << table_id;
+            ENGINE_LOG_ERROR << status.message();
             return status;
         }
+    }
 
-        // step 2: update index info
-        TableIndex new_index = index;
-        new_index.metric_type_ = old_index.metric_type_;  // dont change metric type, it was defined by CreateTable
-        if (!utils::IsSameIndex(old_index, new_index)) {
-            status = UpdateTableIndexRecursively(table_id, new_index);
+    uint64_t vector_count = vectors.vector_count_;
+    if (vector_count == 0) {
+        return Status(DB_ERROR, "Import chunk is empty");
+    }
+
+    size_t single_vector_size = 0;
+    if (!vectors.float_data_.empty()) {
+        single_vector_size = vectors.float_data_.size() * sizeof(float) / vector_count;
+    } else if (!vectors.binary_data_.empty()) {
+        single_vector_size = vectors.binary_data_.size() / vector_count;
+    }
+    if (single_vector_size == 0) {
+        return Status(DB_ERROR, "Import chunk carries no vector data");
+    }
+
+    if (vectors.id_array_.empty()) {
+        ShardedIDGenerator id_generator;
+        id_generator.GetNextIDNumbers(vector_count, vectors.id_array_);
+    } else if (vectors.id_array_.size() != vector_count) {
+        return Status(DB_ERROR, "Import id array size does not match vector count");
+    } else {
+        bool dedup_check = false;
+        server::Config::GetInstance().GetEngineConfigInsertDedupCheck(dedup_check);
+        if (dedup_check) {
+            status = CheckDuplicateIds(target_table_name, vectors.id_array_);
             if (!status.ok()) {
                 return status;
             }
         }
     }
 
-    // step 3: let merge file thread finish
-    // to avoid duplicate data bug
-    WaitMergeFileFinish();
+    // chop the chunk into file-granular segments and write each one straight
+    // to a new table file, skipping the insert memory buffer
+    milvus::server::CollectInsertMetrics metrics(vector_count, target_table_name, status);
+    uint64_t rows_per_file = MAX_TABLE_FILE_MEM / single_vector_size;
+    uint64_t offset = 0;
+    meta::TableFilesSchema imported_files;
+    std::vector<IDNumbers> imported_ids;
+    while (offset < vector_count) {
+        uint64_t rows = std::min(rows_per_file, vector_count - offset);
 
-    // step 4: wait and build index
-    status = index_failed_checker_.CleanFailedIndexFileOfTable(table_id);
-    status = BuildTableIndexRecursively(table_id, index);
+        meta::TableFileSchema table_file;
+        table_file.table_id_ = target_table_name;
+        status = meta_ptr_->CreateTableFile(table_file);
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << "Import failed to create table file: " << status.ToString();
+            return status;
+        }
 
-    return status;
-}
+        ExecutionEnginePtr engine =
+            EngineFactory::Build(table_file.dimension_, table_file.location_, (EngineType)table_file.engine_type_,
+                                 (MetricType)table_file.metric_type_, table_file.nlist_);
+        if (engine == nullptr) {
+            return Status(DB_ERROR, "Invalid engine type");
+        }
 
-Status
-DBImpl::DescribeIndex(const std::string& table_id, TableIndex& index) {
-    if (!initialized_.load(std::memory_order_acquire)) {
-        return SHUTDOWN_ERROR;
-    }
+        if (!vectors.float_data_.empty()) {
+            const float* slice = vectors.float_data_.data() + offset * table_file.dimension_;
+            if (engine->Dimension() > table_file.dimension_) {
+                // dim_padding widens the engine to an aligned stride
+                std::vector<float> padded_slice;
+                RestrideRows(rows, table_file.dimension_, engine->Dimension(), slice, padded_slice);
+                status = engine->AddWithIds(rows, padded_slice.data(), vectors.id_array_.data() + offset);
+            } else {
+                status = engine->AddWithIds(rows, slice, vectors.id_array_.data() + offset);
+            }
+        } else {
+            status = engine->AddWithIds(rows, vectors.binary_data_.data() + offset * single_vector_size,
+                                        vectors.id_array_.data() + offset);
+        }
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << "Import failed to add vectors: " << status.ToString();
+            return status;
+        }
 
-    return meta_ptr_->DescribeTableIndex(table_id, index);
-}
+        try {
+            engine->Serialize();
+        } catch (std::exception& ex) {
+            std::string msg = "Import serialize exception: " + std::string(ex.what());
+            ENGINE_LOG_ERROR << msg;
+            return Status(DB_ERROR, msg);
+        }
 
-Status
-DBImpl::DropIndex(const std::string& table_id) {
-    if (!initialized_.load(std::memory_order_acquire)) {
-        return SHUTDOWN_ERROR;
+        table_file.file_size_ = engine->PhysicalSize();
+        table_file.row_count_ = engine->Count();
+        if (!utils::IsRawIndexType(table_file.engine_type_)) {
+            table_file.file_type_ = (rows * single_vector_size >= table_file.index_file_size_)
+                                        ? meta::TableFileSchema::TO_INDEX
+                                        : meta::TableFileSchema::RAW;
+        } else {
+            table_file.file_type_ = meta::TableFileSchema::RAW;
+        }
+
+        if (!vectors.float_data_.empty()) {
+            table_file.max_norm_ = normalizer::MaxNorm(vectors.float_data_.data() + offset * table_file.dimension_,
+                                                       rows, table_file.dimension_);
+        }
+        auto minmax =
+            std::minmax_element(vectors.id_array_.begin() + offset, vectors.id_array_.begin() + offset + rows);
+        table_file.min_row_id_ = *minmax.first;
+        table_file.max_row_id_ = *minmax.second;
+
+        imported_files.push_back(table_file);
+        imported_ids.emplace_back(vectors.id_array_.begin() + offset, vectors.id_array_.begin() + offset + rows);
+
+        ENGINE_LOG_DEBUG << "Imported file " << table_file.file_id_ << " with " << rows << " rows";
+        offset += rows;
     }
 
-    ENGINE_LOG_DEBUG << "Drop index for table: " << table_id;
-    return DropTableIndexRecursively(table_id);
-}
+    // all files of the import become visible in one meta transaction
+    status = meta_ptr_->UpdateTableFiles(imported_files);
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Import failed to register files in meta: " << status.ToString();
+        return status;
+    }
 
-Status
-DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string& table_id,
-              const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
-              ResultIds& result_ids, ResultDistances& result_distances) {
-    if (!initialized_.load(std::memory_order_acquire)) {
-        return SHUTDOWN_ERROR;
+    for (size_t i = 0; i < imported_files.size(); i++) {
+        IdIndex::GetInstance().RegisterSegment(target_table_name, imported_files[i].location_, imported_ids[i]);
     }
 
-    meta::DatesT dates = {utils::GetDate()};
-    Status result = Query(context, table_id, partition_tags, k, nprobe, vectors, dates, result_ids, result_distances);
-    return result;
+    search_files_cache_.Invalidate(target_table_name);
+    return Status::OK();
 }
 
 Status
-DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string& table_id,
-              const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
-              const meta::DatesT& dates, ResultIds& result_ids, ResultDistances& result_distances) {
-    auto query_ctx = context->Child("Query");
-
+DBImpl::UpsertVectors(const std::string& table_id, const std::string& partition_tag, VectorsData& vectors) {
     if (!initialized_.load(std::memory_order_acquire)) {
         return SHUTDOWN_ERROR;
     }
 
-    ENGINE_LOG_DEBUG << "Query by dates for table: " << table_id << " date range count: " << dates.size();
+    if (vectors.id_array_.size() != vectors.vector_count_) {
+        return Status(DB_ERROR, "Upsert requires an explicit id for every vector");
+    }
 
+    // candidate tables whose segments may hold earlier versions of the ids
+    std::vector<std::string> candidate_tables;
     Status status;
-    std::vector<size_t> ids;
-    meta::TableFilesSchema files_array;
-
-    if (partition_tags.empty()) {
-        // no partition tag specified, means search in whole table
-        // get all table files from parent table
-        status = GetFilesToSearch(table_id, ids, dates, files_array);
+    std::string target_table_name = table_id;
+    if (!partition_tag.empty()) {
+        status = meta_ptr_->GetPartitionName(table_id, partition_tag, target_table_name);
         if (!status.ok()) {
+            ENGINE_LOG_ERROR << status.message();
             return status;
         }
-
+        candidate_tables.push_back(target_table_name);
+    } else {
+        candidate_tables.push_back(table_id);
         std::vector<meta::TableSchema> partition_array;
-        status = meta_ptr_->ShowPartitions(table_id, partition_array);
+        meta_ptr_->ShowPartitions(table_id, partition_array);
         for (auto& schema : partition_array) {
-            status = GetFilesToSearch(schema.table_id_, ids, dates, files_array);
+            candidate_tables.push_back(schema.table_id_);
         }
-    } else {
-        // get files from specified partitions
-        std::set<std::string> partition_name_array;
-        GetPartitionsByTags(table_id, partition_tags, partition_name_array);
+    }
 
-        for (auto& partition_name : partition_name_array) {
-            status = GetFilesToSearch(partition_name, ids, dates, files_array);
+    // tombstone only ids that may actually exist; fresh ids are plain inserts
+    auto& id_index = IdIndex::GetInstance();
+    int64_t mark_time = utils::GetMicroSecTimeStamp();
+    int64_t superseded = 0;
+    for (auto id : vectors.id_array_) {
+        for (auto& candidate : candidate_tables) {
+            if (id_index.TableMayContain(candidate, id)) {
+                id_index.MarkSuperseded(candidate, id, mark_time);
+                superseded++;
+            }
         }
     }
 
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
-    status = QueryAsync(query_ctx, table_id, files_array, k, nprobe, vectors, result_ids, result_distances);
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
-
-    query_ctx->GetTraceContext()->GetSpan()->Finish();
+    if (superseded > 0) {
+        ENGINE_LOG_DEBUG << "Upsert superseded " << superseded << " existing id(s) of table " << table_id;
+    }
 
-    return status;
+    return InsertVectors(table_id, partition_tag, vectors);
 }
 
 Status
-DBImpl::QueryByFileID(const std::shared_ptr<server::Context>& context, const std::string& table_id,
-                      const std::vector<std::string>& file_ids, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
-                      const meta::DatesT& dates, ResultIds& result_ids, ResultDistances& result_distances) {
-    auto query_ctx = context->Child("Query by file id");
-
+DBImpl::DeleteByID(const std::string& table_id, const IDNumbers& id_array) {
     if (!initialized_.load(std::memory_order_acquire)) {
         return SHUTDOWN_ERROR;
     }
-
-    ENGINE_LOG_DEBUG << "Query by file ids for table: " << table_id << " date range count: " << dates.size();
-
-    // get specified files
-    std::vector<size_t> ids;
-    for (auto& id : file_ids) {
-        meta::TableFileSchema table_file;
-        table_file.table_id_ = table_id;
-        std::string::size_type sz;
-        ids.push_back(std::stoul(id, &sz));
+    if (id_array.empty()) {
+        return Status::OK();
     }
 
-    meta::TableFilesSchema files_array;
-    auto status = GetFilesToSearch(table_id, ids, dates, files_array);
+    bool has_table = false;
+    auto status = meta_ptr_->HasTable(table_id, has_table);
+    if (!status.ok()) {
+        return status;
+    }
+    if (!has_table) {
+        return Status(DB_NOT_FOUND, "Table " + table_id + " does not exist");
+    }
+
+    // land buffered rows in segments first, so a copy sitting in the insert
+    // buffer cannot outlive the delete
+    std::set<std::string> sync_table_ids;
+    status = SyncMemData(sync_table_ids);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // every active file of the table and its partitions; index files carry
+    // their own sidecar copy, so deletes must reach them too
+    std::vector<int> file_types = {
+        meta::TableFileSchema::RAW,      meta::TableFileSchema::TO_INDEX,   meta::TableFileSchema::INDEX,
+        meta::TableFileSchema::BACKUP,   meta::TableFileSchema::TO_UPGRADE,
+    };
+    meta::TableFilesSchema files;
+    status = meta_ptr_->FilesByType(table_id, file_types, files);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::vector<meta::TableSchema> partition_array;
+    if (meta_ptr_->ShowPartitions(table_id, partition_array).ok()) {
+        for (auto& schema : partition_array) {
+            meta::TableFilesSchema partition_files;
+            if (meta_ptr_->FilesByType(schema.table_id_, file_types, partition_files).ok()) {
+                files.insert(files.end(), partition_files.begin(), partition_files.end());
+            }
+        }
+    }
+
+    // pin the snapshot so merge and cleanup cannot unlink a file mid-append
+    ongoing_files_checker_.MarkOngoingFiles(files);
+
+    auto& id_index = IdIndex::GetInstance();
+    for (auto& file : files) {
+        if (file.row_count_ == 0) {
+            continue;
+        }
+
+        // the bloom gate keeps unrelated segments sidecar-less; a false
+        // positive only tombstones an id the segment never held, which no
+        // search can ever surface
+        IDNumbers wanted;
+        for (auto id : id_array) {
+            if (id_index.SegmentMayContain(file.table_id_, file.location_, id)) {
+                wanted.push_back(id);
+            }
+        }
+        if (wanted.empty()) {
+            continue;
+        }
+
+        status = DeleteSidecar::Append(file.location_, wanted);
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << "DeleteByID failed to tombstone in " << file.location_ << ": " << status.message();
+            break;
+        }
+    }
+
+    ongoing_files_checker_.UnmarkOngoingFiles(files);
+    return status;
+}
+
+Status
+DBImpl::CreateIndex(const std::string& table_id, const TableIndex& index) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    // serialize memory data
+    std::set<std::string> sync_table_ids;
+    auto status = SyncMemData(sync_table_ids);
+
+    {
+        std::unique_lock<std::mutex> lock(build_index_mutex_);
+
+        // step 1: check index difference
+        TableIndex old_index;
+        status = DescribeIndex(table_id, old_index);
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << "Failed to get table index info for table: " << table_id;
+            return status;
+        }
+
+        // step 2: update index info
+        TableIndex new_index = index;
+        new_index.metric_type_ = old_index.metric_type_;  // dont change metric type, it was defined by CreateTable
+        if (!utils::IsSameIndex(old_index, new_index)) {
+            // rolling upgrade: when both the old and new type are real indexes
+            // and every live index file records its raw source, the backups
+            // are queued for rebuild while the old index files keep serving,
+            // and each segment cuts over as its replacement lands. No wait
+            // loop here - the background pass trickles through the files.
+            if (!utils::IsRawIndexType(old_index.engine_type_) && !utils::IsRawIndexType(new_index.engine_type_) &&
+                IndexFilesLinkedRecursively(table_id)) {
+                status = UpdateTableIndexRollingRecursively(table_id, new_index);
+                if (!status.ok()) {
+                    return status;
+                }
+
+                MetaEventBus::GetInstance().Publish(MetaEvent::INDEX_REQUESTED, table_id);
+                return index_failed_checker_.CleanFailedIndexFileOfTable(table_id);
+            }
+
+            // index change rewrites file types of the table and its partitions
+            search_files_cache_.InvalidateAll();
+            status = UpdateTableIndexRecursively(table_id, new_index);
+            if (!status.ok()) {
+                return status;
+            }
+
+            MetaEventBus::GetInstance().Publish(MetaEvent::INDEX_REQUESTED, table_id);
+        }
+    }
+
+    // step 3: let merge file thread finish
+    // to avoid duplicate data bug
+    WaitMergeFileFinish();
+
+    // step 4: wait and build index
+    status = index_failed_checker_.CleanFailedIndexFileOfTable(table_id);
+    status = BuildTableIndexRecursively(table_id, index);
+
+    return status;
+}
+
+Status
+DBImpl::DescribeIndex(const std::string& table_id, TableIndex& index) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    return meta_ptr_->DescribeTableIndex(table_id, index);
+}
+
+Status
+DBImpl::DropIndex(const std::string& table_id) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    ENGINE_LOG_DEBUG << "Drop index for table: " << table_id;
+    // index drop rewrites file types of the table and all its partitions
+    search_files_cache_.InvalidateAll();
+    auto status = DropTableIndexRecursively(table_id);
+
+    // the dropped index files need a cleanup pass; don't wait for reconcile
+    {
+        std::lock_guard<std::mutex> lock(meta_event_mutex_);
+        event_table_ids_.insert(table_id);
+    }
+
+    return status;
+}
+
+Status
+DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+              const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
+              ResultIds& result_ids, ResultDistances& result_distances) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    meta::DatesT dates = {utils::GetDate()};
+    Status result = Query(context, table_id, partition_tags, k, nprobe, vectors, dates, result_ids, result_distances);
+    return result;
+}
+
+Status
+DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+              const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
+              const meta::DatesT& dates, ResultIds& result_ids, ResultDistances& result_distances) {
+    return QueryStream(context, table_id, partition_tags, k, nprobe, vectors, dates, nullptr, result_ids,
+                       result_distances);
+}
+
+Status
+DBImpl::QueryStream(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                    const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe,
+                    const VectorsData& vectors, const meta::DatesT& dates,
+                    const SearchStreamCallback& stream_callback, ResultIds& result_ids,
+                    ResultDistances& result_distances) {
+    // attach the per-request memory budget before spawning children so every
+    // search task and merge of this request charges the same accountant
+    int64_t mem_budget_gb = 0;
+    server::Config::GetInstance().GetEngineConfigSearchMemBudget(mem_budget_gb);
+    if (mem_budget_gb > 0 && context->GetMemoryAccountant() == nullptr) {
+        context->SetMemoryAccountant(std::make_shared<server::MemoryAccountant>(mem_budget_gb * ONE_GB));
+    }
+    auto query_ctx = context->Child("Query");
+
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    ENGINE_LOG_DEBUG_LAZY << "Query req=" << context->GetRequestID() << " by dates for table: " << table_id
+                          << " date range count: " << dates.size();
+
+    SegmentSizeTuner::GetInstance().RecordQuery(table_id);
+
+    Status status;
+    std::vector<size_t> ids;
+    meta::TableFilesSchema files_array;
+
+    std::string cache_key = SearchFilesCache::MakeKey(table_id, partition_tags, dates);
+    if (!search_files_cache_.Get(cache_key, files_array)) {
+        std::set<std::string> depend_tables = {table_id};
+        if (partition_tags.empty()) {
+            // no partition tag specified, means search in whole table
+            // get all table files from parent table
+            status = GetFilesToSearch(table_id, ids, dates, files_array);
+            if (!status.ok()) {
+                return status;
+            }
+
+            std::vector<meta::TableSchema> partition_array;
+            status = meta_ptr_->ShowPartitions(table_id, partition_array);
+            for (auto& schema : partition_array) {
+                status = GetFilesToSearch(schema.table_id_, ids, dates, files_array);
+                depend_tables.insert(schema.table_id_);
+            }
+        } else {
+            // get files from specified partitions
+            std::set<std::string> partition_name_array;
+            GetPartitionsByTags(table_id, partition_tags, partition_name_array);
+
+            for (auto& partition_name : partition_name_array) {
+                status = GetFilesToSearch(partition_name, ids, dates, files_array);
+                depend_tables.insert(partition_name);
+            }
+        }
+        search_files_cache_.Put(cache_key, depend_tables, files_array);
+    }
+
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
+    status = QueryAsync(query_ctx, table_id, files_array, k, nprobe, vectors, result_ids, result_distances,
+                        stream_callback);
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+
+    query_ctx->GetTraceContext()->GetSpan()->Finish();
+
+    return status;
+}
+
+Status
+DBImpl::QueryRange(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                   const std::vector<std::string>& partition_tags, float radius, uint64_t max_k, uint64_t nprobe,
+                   const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances,
+                   ResultLims& result_lims) {
+    // attach the per-request memory budget before spawning children so every
+    // search task and merge of this request charges the same accountant
+    int64_t mem_budget_gb = 0;
+    server::Config::GetInstance().GetEngineConfigSearchMemBudget(mem_budget_gb);
+    if (mem_budget_gb > 0 && context->GetMemoryAccountant() == nullptr) {
+        context->SetMemoryAccountant(std::make_shared<server::MemoryAccountant>(mem_budget_gb * ONE_GB));
+    }
+    auto query_ctx = context->Child("Query Range");
+
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    ENGINE_LOG_DEBUG_LAZY << "Query req=" << context->GetRequestID() << " range for table: " << table_id
+                          << " radius: " << radius;
+
+    SegmentSizeTuner::GetInstance().RecordQuery(table_id);
+
+    Status status;
+    std::vector<size_t> ids;
+    meta::TableFilesSchema files_array;
+    meta::DatesT dates;
+
+    std::string cache_key = SearchFilesCache::MakeKey(table_id, partition_tags, dates);
+    if (!search_files_cache_.Get(cache_key, files_array)) {
+        std::set<std::string> depend_tables = {table_id};
+        if (partition_tags.empty()) {
+            // no partition tag specified, means search in whole table
+            // get all table files from parent table
+            status = GetFilesToSearch(table_id, ids, dates, files_array);
+            if (!status.ok()) {
+                return status;
+            }
+
+            std::vector<meta::TableSchema> partition_array;
+            status = meta_ptr_->ShowPartitions(table_id, partition_array);
+            for (auto& schema : partition_array) {
+                status = GetFilesToSearch(schema.table_id_, ids, dates, files_array);
+                depend_tables.insert(schema.table_id_);
+            }
+        } else {
+            // get files from specified partitions
+            std::set<std::string> partition_name_array;
+            GetPartitionsByTags(table_id, partition_tags, partition_name_array);
+
+            for (auto& partition_name : partition_name_array) {
+                status = GetFilesToSearch(partition_name, ids, dates, files_array);
+                depend_tables.insert(partition_name);
+            }
+        }
+        search_files_cache_.Put(cache_key, depend_tables, files_array);
+    }
+
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
+    status = QueryRangeAsync(query_ctx, table_id, files_array, radius, max_k, nprobe, vectors, result_ids,
+                             result_distances, result_lims);
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+
+    query_ctx->GetTraceContext()->GetSpan()->Finish();
+
+    return status;
+}
+
+Status
+DBImpl::GetSearchFileIds(const std::string& table_id, const std::vector<std::string>& partition_tags,
+                         std::vector<std::pair<std::string, std::vector<std::string>>>& table_files) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    Status status;
+    std::vector<size_t> ids;
+
+    // gather the owning tables exactly like Query does: empty tags mean the
+    // parent table plus every partition
+    std::vector<std::string> search_tables = {table_id};
+    if (partition_tags.empty()) {
+        std::vector<meta::TableSchema> partition_array;
+        status = meta_ptr_->ShowPartitions(table_id, partition_array);
+        for (auto& schema : partition_array) {
+            search_tables.push_back(schema.table_id_);
+        }
+    } else {
+        search_tables.clear();
+        std::set<std::string> partition_name_array;
+        GetPartitionsByTags(table_id, partition_tags, partition_name_array);
+        for (auto& partition_name : partition_name_array) {
+            search_tables.push_back(partition_name);
+        }
+    }
+
+    for (auto& search_table : search_tables) {
+        meta::TableFilesSchema files_array;
+        status = GetFilesToSearch(search_table, ids, meta::DatesT(), files_array);
+        if (!status.ok()) {
+            return status;
+        }
+        if (files_array.empty()) {
+            continue;
+        }
+
+        std::vector<std::string> file_ids;
+        for (auto& file : files_array) {
+            file_ids.push_back(std::to_string(file.id_));
+        }
+        table_files.emplace_back(search_table, std::move(file_ids));
+    }
+
+    return Status::OK();
+}
+
+Status
+DBImpl::QueryByFileID(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                      const std::vector<std::string>& file_ids, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
+                      const meta::DatesT& dates, ResultIds& result_ids, ResultDistances& result_distances) {
+    auto query_ctx = context->Child("Query by file id");
+
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    ENGINE_LOG_DEBUG_LAZY << "Query req=" << context->GetRequestID() << " by file ids for table: " << table_id
+                          << " date range count: " << dates.size();
+
+    // get specified files
+    std::vector<size_t> ids;
+    for (auto& id : file_ids) {
+        meta::TableFileSchema table_file;
+        table_file.table_id_ = table_id;
+        std::string::size_type sz;
+        ids.push_back(std::stoul(id, &sz));
+    }
+
+    meta::TableFilesSchema files_array;
+    auto status = GetFilesToSearch(table_id, ids, dates, files_array);
     if (!status.ok()) {
         return status;
     }
@@ -503,6 +1230,302 @@ DBImpl::QueryByFileID(const std::shared_ptr<server::Context>& context, const std
     return status;
 }
 
+Status
+DBImpl::ExportTable(const std::string& table_id, const ExportChunkCallback& chunk_callback) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    meta::TableSchema table_schema;
+    table_schema.table_id_ = table_id;
+    auto status = DescribeTable(table_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // snapshot the expected total before walking the files, so rows flushed
+    // while the export runs cannot be mistaken for missing ones afterwards
+    uint64_t expected_rows = 0;
+    status = GetTableRowCountRecursively(table_id, expected_rows);
+    if (!status.ok()) {
+        return status;
+    }
+
+    TimeRecorder rc("Export table " + table_id);
+
+    uint64_t exported_rows = 0;
+    bool cancelled = false;
+    status = ExportTableFiles(table_id, chunk_callback, exported_rows, cancelled);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::vector<meta::TableSchema> partition_array;
+    status = meta_ptr_->ShowPartitions(table_id, partition_array);
+    if (!status.ok()) {
+        return status;
+    }
+    for (auto& schema : partition_array) {
+        if (cancelled) {
+            break;
+        }
+        status = ExportTableFiles(schema.table_id_, chunk_callback, exported_rows, cancelled);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    if (cancelled) {
+        ENGINE_LOG_DEBUG << "Export of table " << table_id << " cancelled by consumer after " << exported_rows
+                         << " rows";
+        return Status::OK();
+    }
+
+    rc.ElapseFromBegin("streamed " + std::to_string(exported_rows) + " rows");
+
+    // segments whose index was encoded straight from the insert buffer have no
+    // raw copy on disk, and their vectors cannot be recovered without decoding
+    // the index; refuse to pretend such an export is complete
+    if (exported_rows < expected_rows) {
+        std::string msg = "Export incomplete: only " + std::to_string(exported_rows) + " of " +
+                          std::to_string(expected_rows) + " rows have a raw copy";
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_ERROR, msg);
+    }
+
+    return Status::OK();
+}
+
+Status
+DBImpl::ExportTableFiles(const std::string& table_id, const ExportChunkCallback& chunk_callback,
+                         uint64_t& exported_rows, bool& cancelled) {
+    // every segment keeps its rows in exactly one raw-layout file: RAW or
+    // TO_INDEX before an index is built, BACKUP or TO_UPGRADE afterwards.
+    // Skipping the index files both avoids deserializing faiss structures and
+    // guarantees each row is shipped exactly once.
+    std::vector<int> file_types = {
+        meta::TableFileSchema::RAW,
+        meta::TableFileSchema::TO_INDEX,
+        meta::TableFileSchema::BACKUP,
+        meta::TableFileSchema::TO_UPGRADE,
+    };
+    meta::TableFilesSchema files;
+    auto status = meta_ptr_->FilesByType(table_id, file_types, files);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // pin the snapshot so merge and cleanup cannot unlink a file mid-stream
+    ongoing_files_checker_.MarkOngoingFiles(files);
+
+    for (auto& file : files) {
+        if (file.row_count_ == 0) {
+            continue;
+        }
+
+        // padded files (dim_padding) store rows at an aligned stride wider
+        // than the table dimension; compact each window back to the logical
+        // stride so consumers never see the alignment zeros
+        int64_t file_dim = file.dimension_;
+        SegmentHeaderInfo header;
+        if (read_index_header(file.location_, header).ok() && header.dimension > file_dim) {
+            file_dim = header.dimension;
+        }
+
+        int64_t streamed_rows = 0;
+        std::vector<float> compact;
+        status = read_raw_windows(file.location_, EXPORT_WINDOW_BYTES,
+                                  [&](int64_t count, const float* vectors, const int64_t* ids) {
+                                      if (file_dim > file.dimension_) {
+                                          RestrideRows(count, file_dim, file.dimension_, vectors, compact);
+                                          vectors = compact.data();
+                                      }
+                                      if (!chunk_callback(count, vectors, ids)) {
+                                          cancelled = true;
+                                          return Status(DB_ERROR, "export cancelled by consumer");
+                                      }
+                                      streamed_rows += count;
+                                      return Status::OK();
+                                  });
+        if (cancelled) {
+            status = Status::OK();
+            break;
+        }
+        exported_rows += streamed_rows;
+        if (status.ok()) {
+            continue;
+        }
+        if (streamed_rows > 0) {
+            // part of the file already went out; a reload would duplicate rows
+            break;
+        }
+
+        // the file is not in the streamable layout (compressed, checksummed or
+        // remote): fall back to a full deserialization of this one file
+        VecIndexPtr raw_index = nullptr;
+        try {
+            raw_index = read_index(file.location_);
+        } catch (std::exception& e) {
+            status = Status(DB_ERROR, e.what());
+            break;
+        }
+        auto bf_index = std::dynamic_pointer_cast<BFIndex>(raw_index);
+        if (bf_index == nullptr) {
+            status = Status(DB_ERROR, "File " + file.file_id_ + " is not a raw vector file");
+            break;
+        }
+        const float* raw_vectors = bf_index->GetRawVectors();
+        if (bf_index->Dimension() > file.dimension_) {
+            RestrideRows(bf_index->Count(), bf_index->Dimension(), file.dimension_, raw_vectors, compact);
+            raw_vectors = compact.data();
+        }
+        if (!chunk_callback(bf_index->Count(), raw_vectors, bf_index->GetRawIds())) {
+            cancelled = true;
+            status = Status::OK();
+            break;
+        }
+        exported_rows += bf_index->Count();
+        status = Status::OK();
+    }
+
+    ongoing_files_checker_.UnmarkOngoingFiles(files);
+    return status;
+}
+
+Status
+DBImpl::GetVectorsByID(const std::string& table_id, const IDNumbers& id_array, std::vector<VectorsData>& vectors) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    vectors.clear();
+    vectors.resize(id_array.size());
+    if (id_array.empty()) {
+        return Status::OK();
+    }
+
+    bool has_table = false;
+    auto status = meta_ptr_->HasTable(table_id, has_table);
+    if (!status.ok()) {
+        return status;
+    }
+    if (!has_table) {
+        return Status(DB_NOT_FOUND, "Table " + table_id + " does not exist");
+    }
+
+    // every row lives in exactly one raw-layout file (see ExportTableFiles);
+    // index files are skipped, their origin raw copy serves the lookup
+    std::vector<int> file_types = {
+        meta::TableFileSchema::RAW,
+        meta::TableFileSchema::TO_INDEX,
+        meta::TableFileSchema::BACKUP,
+        meta::TableFileSchema::TO_UPGRADE,
+    };
+    meta::TableFilesSchema files;
+    status = meta_ptr_->FilesByType(table_id, file_types, files);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::vector<meta::TableSchema> partition_array;
+    if (meta_ptr_->ShowPartitions(table_id, partition_array).ok()) {
+        for (auto& schema : partition_array) {
+            meta::TableFilesSchema partition_files;
+            if (meta_ptr_->FilesByType(schema.table_id_, file_types, partition_files).ok()) {
+                files.insert(files.end(), partition_files.begin(), partition_files.end());
+            }
+        }
+    }
+
+    // newest file first, so a re-inserted id resolves to its latest version
+    std::sort(files.begin(), files.end(),
+              [](const meta::TableFileSchema& a, const meta::TableFileSchema& b) {
+                  return a.created_on_ > b.created_on_;
+              });
+
+    // pin the snapshot so merge and cleanup cannot unlink a file mid-fetch
+    ongoing_files_checker_.MarkOngoingFiles(files);
+
+    auto& id_index = IdIndex::GetInstance();
+    size_t remaining = id_array.size();
+    for (auto& file : files) {
+        if (remaining == 0) {
+            break;
+        }
+        if (file.row_count_ == 0) {
+            continue;
+        }
+
+        // bloom-gate the batch: only ids the segment may hold reach its
+        // id -> offset table
+        auto deleted = DeleteSidecar::Load(file.location_);
+        std::vector<size_t> candidates;
+        IDNumbers wanted;
+        for (size_t i = 0; i < id_array.size(); i++) {
+            if (vectors[i].vector_count_ != 0) {
+                continue;
+            }
+            if (deleted != nullptr && deleted->count(id_array[i]) != 0) {
+                continue;
+            }
+            if (!id_index.SegmentMayContain(file.table_id_, file.location_, id_array[i])) {
+                continue;
+            }
+            // an upserted id is stale in any segment older than its tombstone
+            int64_t mark_time = id_index.SupersededTime(file.table_id_, id_array[i]);
+            if (mark_time != 0 && file.created_on_ < mark_time) {
+                continue;
+            }
+            candidates.push_back(i);
+            wanted.push_back(id_array[i]);
+        }
+        if (wanted.empty()) {
+            continue;
+        }
+
+        std::vector<int64_t> offsets;
+        status = VectorLookup::GetInstance().LocateIds(file.location_, wanted, offsets);
+        if (!status.ok()) {
+            // e.g. a binary or compressed layout; nothing to serve from here
+            ENGINE_LOG_DEBUG << "GetVectorsByID skips " << file.location_ << ": " << status.message();
+            continue;
+        }
+
+        std::vector<int64_t> rows;
+        std::vector<size_t> hits;
+        for (size_t j = 0; j < offsets.size(); j++) {
+            if (offsets[j] >= 0) {
+                rows.push_back(offsets[j]);
+                hits.push_back(candidates[j]);
+            }
+        }
+        if (rows.empty()) {
+            continue;
+        }
+
+        int64_t dim = 0;
+        std::vector<float> data;
+        status = fetch_raw_rows(file.location_, rows, dim, data);
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << "GetVectorsByID failed to read " << file.location_ << ": " << status.message();
+            continue;
+        }
+
+        // padded files store rows at an aligned stride; hand back only the
+        // logical dimension the client inserted
+        int64_t out_dim = std::min(dim, static_cast<int64_t>(file.dimension_));
+        for (size_t j = 0; j < hits.size(); j++) {
+            auto& out = vectors[hits[j]];
+            out.vector_count_ = 1;
+            out.float_data_.assign(data.begin() + j * dim, data.begin() + j * dim + out_dim);
+            remaining--;
+        }
+    }
+
+    ongoing_files_checker_.UnmarkOngoingFiles(files);
+    return Status::OK();
+}
+
 Status
 DBImpl::Size(uint64_t& result) {
     if (!initialized_.load(std::memory_order_acquire)) {
@@ -518,28 +1541,50 @@ DBImpl::Size(uint64_t& result) {
 Status
 DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, const std::string& table_id,
                    const meta::TableFilesSchema& files, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
-                   ResultIds& result_ids, ResultDistances& result_distances) {
+                   ResultIds& result_ids, ResultDistances& result_distances,
+                   const SearchStreamCallback& stream_callback) {
     auto query_async_ctx = context->Child("Query Async");
 
-    server::CollectQueryMetrics metrics(vectors.vector_count_);
+    server::CollectQueryMetrics metrics(vectors.vector_count_, table_id);
 
     TimeRecorder rc("");
 
-    // step 1: construct search job
-    auto status = ongoing_files_checker_.MarkOngoingFiles(files);
+    // step 1: construct search job over the files the statistics cannot rule out
+    meta::TableFilesSchema search_files = PruneSearchFiles(files, vectors, false, 0.0f);
+
+    // reject early when the projected result footprint alone would blow the
+    // request's memory budget; cheaper than letting every task fail its charge
+    auto& accountant = query_async_ctx->GetMemoryAccountant();
+    if (accountant != nullptr) {
+        int64_t projected = static_cast<int64_t>(search_files.size()) * static_cast<int64_t>(k) *
+                            static_cast<int64_t>(vectors.vector_count_) * (sizeof(int64_t) + sizeof(float));
+        if (projected > accountant->Remaining()) {
+            std::string msg = "Search rejected: projected result memory " + std::to_string(projected) +
+                              " bytes exceeds request budget of " + std::to_string(accountant->Budget()) + " bytes";
+            ENGINE_LOG_ERROR << msg;
+            return Status(SERVER_OUT_OF_MEMORY, msg);
+        }
+    }
+
+    auto status = ongoing_files_checker_.MarkOngoingFiles(search_files);
 
-    ENGINE_LOG_DEBUG << "Engine query begin, index file count: " << files.size();
+    ENGINE_LOG_DEBUG_LAZY << "Engine query req=" << context->GetRequestID()
+                          << " begin, index file count: " << search_files.size();
     scheduler::SearchJobPtr job = std::make_shared<scheduler::SearchJob>(query_async_ctx, k, nprobe, vectors);
-    for (auto& file : files) {
-        scheduler::TableFileSchemaPtr file_ptr = std::make_shared<meta::TableFileSchema>(file);
+    for (auto& file : search_files) {
+        // interned: every query of an unchanged segment shares one descriptor
+        scheduler::TableFileSchemaPtr file_ptr = FileSchemaIntern::GetInstance().Intern(file);
         job->AddIndexFile(file_ptr);
     }
+    if (stream_callback != nullptr) {
+        job->SetStreamCallback(stream_callback);
+    }
 
     // step 2: put search job to scheduler and wait result
     scheduler::JobMgrInst::GetInstance()->Put(job);
     job->WaitResult();
 
-    status = ongoing_files_checker_.UnmarkOngoingFiles(files);
+    status = ongoing_files_checker_.UnmarkOngoingFiles(search_files);
     if (!job->GetStatus().ok()) {
         return job->GetStatus();
     }
@@ -554,6 +1599,49 @@ DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, const std::s
     return Status::OK();
 }
 
+Status
+DBImpl::QueryRangeAsync(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                        const meta::TableFilesSchema& files, float radius, uint64_t max_k, uint64_t nprobe,
+                        const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances,
+                        ResultLims& result_lims) {
+    auto query_async_ctx = context->Child("Query Range Async");
+
+    server::CollectQueryMetrics metrics(vectors.vector_count_, table_id);
+
+    TimeRecorder rc("");
+
+    // step 1: construct search job; topk acts as the per-query match cap in range mode
+    meta::TableFilesSchema search_files = PruneSearchFiles(files, vectors, true, radius);
+    auto status = ongoing_files_checker_.MarkOngoingFiles(search_files);
+
+    ENGINE_LOG_DEBUG_LAZY << "Engine range query req=" << context->GetRequestID()
+                          << " begin, index file count: " << search_files.size();
+    scheduler::SearchJobPtr job = std::make_shared<scheduler::SearchJob>(query_async_ctx, max_k, nprobe, vectors);
+    for (auto& file : search_files) {
+        // interned: every query of an unchanged segment shares one descriptor
+        scheduler::TableFileSchemaPtr file_ptr = FileSchemaIntern::GetInstance().Intern(file);
+        job->AddIndexFile(file_ptr);
+    }
+    job->SetRangeSearch(radius);
+
+    // step 2: put search job to scheduler and wait result
+    scheduler::JobMgrInst::GetInstance()->Put(job);
+    job->WaitResult();
+
+    status = ongoing_files_checker_.UnmarkOngoingFiles(search_files);
+    if (!job->GetStatus().ok()) {
+        return job->GetStatus();
+    }
+
+    // step 3: construct results
+    job->GetRangeResult(result_ids, result_distances, result_lims);
+    rc.ElapseFromBegin("Engine range query totally cost");
+
+    query_async_ctx->GetTraceContext()->GetSpan()->Finish();
+
+    return Status::OK();
+}
+
 void
 DBImpl::BackgroundTimerTask() {
     Status status;
@@ -562,6 +1650,8 @@ DBImpl::BackgroundTimerTask() {
         if (!initialized_.load(std::memory_order_acquire)) {
             WaitMergeFileFinish();
             WaitBuildIndexFinish();
+            WaitTieringFinish();
+            WaitScrubFinish();
 
             ENGINE_LOG_DEBUG << "DB background thread exit";
             break;
@@ -572,6 +1662,9 @@ DBImpl::BackgroundTimerTask() {
         StartMetricTask();
         StartCompactionTask();
         StartBuildIndexTask();
+        StartWarmStateTask();
+        StartTieringTask();
+        StartScrubTask();
     }
 }
 
@@ -581,50 +1674,233 @@ DBImpl::WaitMergeFileFinish() {
     for (auto& iter : compact_thread_results_) {
         iter.wait();
     }
-}
+}
+
+void
+DBImpl::WaitBuildIndexFinish() {
+    std::lock_guard<std::mutex> lck(index_result_mutex_);
+    for (auto& iter : index_thread_results_) {
+        iter.wait();
+    }
+}
+
+void
+DBImpl::WaitTieringFinish() {
+    std::lock_guard<std::mutex> lck(tiering_result_mutex_);
+    for (auto& iter : tiering_thread_results_) {
+        iter.wait();
+    }
+}
+
+void
+DBImpl::WaitScrubFinish() {
+    std::lock_guard<std::mutex> lck(scrub_result_mutex_);
+    for (auto& iter : scrub_thread_results_) {
+        iter.wait();
+    }
+}
+
+void
+DBImpl::StartMetricTask() {
+    static uint64_t metric_clock_tick = 0;
+    ++metric_clock_tick;
+    if (metric_clock_tick % METRIC_ACTION_INTERVAL != 0) {
+        return;
+    }
+
+    server::Metrics::GetInstance().KeepingAliveCounterIncrement(METRIC_ACTION_INTERVAL);
+    int64_t cache_usage = cache::CpuCacheMgr::GetInstance()->CacheUsage();
+    int64_t cache_total = cache::CpuCacheMgr::GetInstance()->CacheCapacity();
+    fiu_do_on("DBImpl.StartMetricTask.InvalidTotalCache", cache_total = 0);
+
+    if (cache_total > 0) {
+        double cache_usage_double = cache_usage;
+        server::Metrics::GetInstance().CpuCacheUsageGaugeSet(cache_usage_double * 100 / cache_total);
+    } else {
+        server::Metrics::GetInstance().CpuCacheUsageGaugeSet(0);
+    }
+
+    server::Metrics::GetInstance().GpuCacheUsageGaugeSet();
+    uint64_t size;
+    Size(size);
+    server::Metrics::GetInstance().DataFileSizeGaugeSet(size);
+    server::Metrics::GetInstance().CPUUsagePercentSet();
+    server::Metrics::GetInstance().RAMUsagePercentSet();
+    server::Metrics::GetInstance().GPUPercentGaugeSet();
+    server::Metrics::GetInstance().GPUMemoryUsageGaugeSet();
+    server::Metrics::GetInstance().GPUUtilizationGaugeSet();
+    server::Metrics::GetInstance().OctetsSet();
+
+    for (auto& resource : scheduler::ResMgrInst::GetInstance()->GetAllResources()) {
+        server::Metrics::GetInstance().ResourceExecutorCpuSecondsGaugeSet(resource->name(),
+                                                                          resource->ExecutorCpuSeconds());
+        server::Metrics::GetInstance().ResourceLoaderIOBytesGaugeSet(resource->name(), resource->LoaderIOBytes());
+    }
+
+    server::Metrics::GetInstance().CPUCoreUsagePercentSet();
+    server::Metrics::GetInstance().GPUTemperature();
+    server::Metrics::GetInstance().CPUTemperature();
+    server::Metrics::GetInstance().PushToGateway();
+}
+
+void
+DBImpl::StartWarmStateTask() {
+    static uint64_t warm_state_clock_tick = 0;
+    ++warm_state_clock_tick;
+    if (warm_replay_budget_ <= 0 || warm_state_clock_tick % WARM_STATE_ACTION_INTERVAL != 0) {
+        return;
+    }
+
+    SaveCacheWarmState();
+}
+
+void
+DBImpl::SaveCacheWarmState() {
+    std::vector<std::string> keys = cache::CpuCacheMgr::GetInstance()->SnapshotKeys();
+
+    // write-then-rename so a crash mid-write never truncates a usable snapshot
+    std::string temp_path = warm_state_path_ + ".tmp";
+    std::ofstream outfile(temp_path, std::ios::trunc);
+    if (!outfile.good()) {
+        ENGINE_LOG_ERROR << "Cannot write cache warm state to " << temp_path;
+        return;
+    }
+    for (auto& key : keys) {
+        outfile << key << "\n";
+    }
+    outfile.close();
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(temp_path, warm_state_path_, ec);
+    if (ec) {
+        ENGINE_LOG_ERROR << "Cannot move cache warm state into place: " << ec.message();
+    }
+}
+
+void
+DBImpl::ReadWarmStateKeys(std::vector<std::string>& keys) {
+    std::ifstream infile(warm_state_path_);
+    if (!infile.good()) {
+        return;
+    }
+
+    std::string line;
+    while (std::getline(infile, line)) {
+        if (!line.empty()) {
+            keys.push_back(line);
+        }
+    }
+}
+
+Status
+DBImpl::OrderTablesByWarmth(std::vector<std::string>& table_ids) {
+    std::vector<std::string> keys;
+    ReadWarmStateKeys(keys);
+    if (keys.empty() || table_ids.size() < 2) {
+        return Status::OK();
+    }
+    std::unordered_set<std::string> warm_keys(keys.begin(), keys.end());
+
+    // warmth of a table = bytes of its files (partitions included, the same
+    // scoping PreloadTable uses) that were cache-resident at the snapshot
+    std::unordered_map<std::string, int64_t> warmth;
+    meta::DatesT dates;
+    std::vector<size_t> ids;
+    for (auto& table_id : table_ids) {
+        meta::TableFilesSchema files_array;
+        auto status = GetFilesToSearch(table_id, ids, dates, files_array);
+        if (!status.ok()) {
+            continue;
+        }
+        std::vector<meta::TableSchema> partition_array;
+        meta_ptr_->ShowPartitions(table_id, partition_array);
+        for (auto& schema : partition_array) {
+            GetFilesToSearch(schema.table_id_, ids, dates, files_array);
+        }
+        int64_t warm_bytes = 0;
+        for (auto& file : files_array) {
+            if (warm_keys.count(file.location_) != 0) {
+                warm_bytes += file.file_size_;
+            }
+        }
+        warmth[table_id] = warm_bytes;
+    }
 
-void
-DBImpl::WaitBuildIndexFinish() {
-    std::lock_guard<std::mutex> lck(index_result_mutex_);
-    for (auto& iter : index_thread_results_) {
-        iter.wait();
-    }
+    auto warm_bytes_of = [&warmth](const std::string& table_id) -> int64_t {
+        auto iter = warmth.find(table_id);
+        return iter == warmth.end() ? 0 : iter->second;
+    };
+    std::stable_sort(table_ids.begin(), table_ids.end(),
+                     [&warm_bytes_of](const std::string& lhs, const std::string& rhs) {
+                         return warm_bytes_of(lhs) > warm_bytes_of(rhs);
+                     });
+    return Status::OK();
 }
 
 void
-DBImpl::StartMetricTask() {
-    static uint64_t metric_clock_tick = 0;
-    ++metric_clock_tick;
-    if (metric_clock_tick % METRIC_ACTION_INTERVAL != 0) {
+DBImpl::ReplayCacheWarmState() {
+    std::vector<std::string> keys;
+    ReadWarmStateKeys(keys);
+    if (keys.empty()) {
         return;
     }
 
-    server::Metrics::GetInstance().KeepingAliveCounterIncrement(METRIC_ACTION_INTERVAL);
-    int64_t cache_usage = cache::CpuCacheMgr::GetInstance()->CacheUsage();
-    int64_t cache_total = cache::CpuCacheMgr::GetInstance()->CacheCapacity();
-    fiu_do_on("DBImpl.StartMetricTask.InvalidTotalCache", cache_total = 0);
-
-    if (cache_total > 0) {
-        double cache_usage_double = cache_usage;
-        server::Metrics::GetInstance().CpuCacheUsageGaugeSet(cache_usage_double * 100 / cache_total);
-    } else {
-        server::Metrics::GetInstance().CpuCacheUsageGaugeSet(0);
+    // resolve the cached locations back to file schemas through meta; entries
+    // whose segment was merged or dropped since the snapshot are skipped
+    std::unordered_map<std::string, meta::TableFileSchema> location_map;
+    std::vector<meta::TableSchema> table_array;
+    meta_ptr_->AllTables(table_array);
+    meta::DatesT dates;
+    std::vector<size_t> ids;
+    for (auto& schema : table_array) {
+        meta::TableFilesSchema files_array;
+        auto status = GetFilesToSearch(schema.table_id_, ids, dates, files_array);
+        if (!status.ok()) {
+            continue;
+        }
+        for (auto& file : files_array) {
+            location_map.emplace(file.location_, file);
+        }
     }
 
-    server::Metrics::GetInstance().GpuCacheUsageGaugeSet();
-    uint64_t size;
-    Size(size);
-    server::Metrics::GetInstance().DataFileSizeGaugeSet(size);
-    server::Metrics::GetInstance().CPUUsagePercentSet();
-    server::Metrics::GetInstance().RAMUsagePercentSet();
-    server::Metrics::GetInstance().GPUPercentGaugeSet();
-    server::Metrics::GetInstance().GPUMemoryUsageGaugeSet();
-    server::Metrics::GetInstance().OctetsSet();
+    // hottest keys first until the replay budget is spent; a couple of loader
+    // threads hide the I/O latency without starving early queries
+    ENGINE_LOG_DEBUG << "Begin warm state replay, snapshot contains " << keys.size() << " keys";
+    TimeRecorderAuto rc("Replay cache warm state");
+    ThreadPool replay_pool(WARM_REPLAY_THREAD_NUM);
+    std::list<std::future<void>> replay_results;
+    int64_t budget = warm_replay_budget_;
+    for (auto& key : keys) {
+        if (!initialized_.load(std::memory_order_acquire)) {
+            break;
+        }
+        auto iter = location_map.find(key);
+        if (iter == location_map.end()) {
+            continue;
+        }
+        budget -= iter->second.file_size_;
+        if (budget < 0) {
+            break;
+        }
 
-    server::Metrics::GetInstance().CPUCoreUsagePercentSet();
-    server::Metrics::GetInstance().GPUTemperature();
-    server::Metrics::GetInstance().CPUTemperature();
-    server::Metrics::GetInstance().PushToGateway();
+        meta::TableFileSchema file = iter->second;
+        replay_results.push_back(replay_pool.enqueue([this, file] {
+            ExecutionEnginePtr engine = EngineFactory::Build(
+                file.dimension_, file.location_, (EngineType)file.engine_type_, (MetricType)file.metric_type_,
+                file.nlist_);
+            if (engine == nullptr) {
+                return;
+            }
+            try {
+                engine->Load(true);
+            } catch (std::exception& ex) {
+                ENGINE_LOG_ERROR << "Warm state replay encounter exception: " << ex.what();
+            }
+        }));
+    }
+    for (auto& result : replay_results) {
+        result.wait();
+    }
 }
 
 Status
@@ -634,6 +1910,7 @@ DBImpl::SyncMemData(std::set<std::string>& sync_table_ids) {
     mem_mgr_->Serialize(temp_table_ids);
     for (auto& id : temp_table_ids) {
         sync_table_ids.insert(id);
+        search_files_cache_.Invalidate(id);
     }
 
     if (!temp_table_ids.empty()) {
@@ -654,13 +1931,22 @@ DBImpl::StartCompactionTask() {
     // serialize memory data
     SyncMemData(compact_table_ids_);
 
+    // drain tables named by meta change events since the last tick
+    {
+        std::lock_guard<std::mutex> lock(meta_event_mutex_);
+        compact_table_ids_.insert(event_table_ids_.begin(), event_table_ids_.end());
+        event_table_ids_.clear();
+    }
+
     // compactiong has been finished?
     {
         std::lock_guard<std::mutex> lck(compact_result_mutex_);
-        if (!compact_thread_results_.empty()) {
-            std::chrono::milliseconds span(10);
-            if (compact_thread_results_.back().wait_for(span) == std::future_status::ready) {
-                compact_thread_results_.pop_back();
+        std::chrono::milliseconds span(0);  // poll; there may be one future per table
+        for (auto iter = compact_thread_results_.begin(); iter != compact_thread_results_.end();) {
+            if (iter->wait_for(span) == std::future_status::ready) {
+                iter = compact_thread_results_.erase(iter);
+            } else {
+                ++iter;
             }
         }
     }
@@ -669,10 +1955,13 @@ DBImpl::StartCompactionTask() {
     {
         std::lock_guard<std::mutex> lck(compact_result_mutex_);
         if (compact_thread_results_.empty()) {
-            // collect merge files for all tables(if compact_table_ids_ is empty) for two reasons:
+            // the slow reconcile pass collects all tables for two reasons:
             // 1. other tables may still has un-merged files
             // 2. server may be closed unexpected, these un-merge files need to be merged when server restart
-            if (compact_table_ids_.empty()) {
+            // outside the reconcile tick only event-named tables are visited, so an idle
+            // cluster produces no per-second merge queries against the meta
+            bool reconcile = (compact_clock_tick % RECONCILE_ACTION_INTERVAL == 0);
+            if (compact_table_ids_.empty() && reconcile) {
                 std::vector<meta::TableSchema> table_schema_array;
                 meta_ptr_->AllTables(table_schema_array);
                 for (auto& schema : table_schema_array) {
@@ -680,10 +1969,16 @@ DBImpl::StartCompactionTask() {
                 }
             }
 
-            // start merge file thread
-            compact_thread_results_.push_back(
-                compact_thread_pool_.enqueue(&DBImpl::BackgroundCompaction, this, compact_table_ids_));
-            compact_table_ids_.clear();
+            // one merge task per table so the pool can run tables in parallel,
+            // plus a single housekeeping task for archive and file GC
+            if (!compact_table_ids_.empty()) {
+                for (auto& table_id : compact_table_ids_) {
+                    compact_thread_results_.push_back(
+                        compact_thread_pool_.enqueue(&DBImpl::BackgroundMerge, this, table_id));
+                }
+                compact_thread_results_.push_back(compact_thread_pool_.enqueue(&DBImpl::BackgroundHousekeeping, this));
+                compact_table_ids_.clear();
+            }
         }
     }
 }
@@ -711,17 +2006,74 @@ DBImpl::MergeFiles(const std::string& table_id, const meta::DateT& date, const m
 
     meta::TableFilesSchema updated;
     int64_t index_size = 0;
+    DeleteSidecar::DeletedSet carried_deletes;
+
+    // adaptive target: read-mostly hot tables merge toward larger segments,
+    // write-hot tables stay fine-grained, bounded by observed build throughput
+    int64_t target_size = SegmentSizeTuner::GetInstance().TargetSize(table_id, table_file.index_file_size_);
+    if (target_size != table_file.index_file_size_) {
+        ENGINE_LOG_DEBUG << "Adaptive merge target for table " << table_id << ": " << target_size << " bytes"
+                         << " (configured " << table_file.index_file_size_ << ")";
+    }
 
     for (auto& file : files) {
         server::CollectMergeFilesMetrics metrics;
 
-        index->Merge(file.location_);
+        auto deleted = DeleteSidecar::Load(file.location_);
+        if (deleted != nullptr && !deleted->empty()) {
+            // stream the segment row by row and drop its tombstoned rows, so
+            // the merged segment is born compacted and the input's delete
+            // sidecar dies with it
+            std::vector<float> kept_vectors;
+            IDNumbers kept_ids;
+            bool added_any = false;
+            auto merge_status =
+                read_raw_windows(file.location_, EXPORT_WINDOW_BYTES,
+                                 [&](int64_t count, const float* vectors, const int64_t* ids) {
+                                     int64_t dim = index->Dimension();
+                                     kept_vectors.clear();
+                                     kept_ids.clear();
+                                     for (int64_t i = 0; i < count; i++) {
+                                         if (deleted->count(ids[i]) != 0) {
+                                             continue;
+                                         }
+                                         kept_ids.push_back(ids[i]);
+                                         kept_vectors.insert(kept_vectors.end(), vectors + i * dim,
+                                                             vectors + (i + 1) * dim);
+                                     }
+                                     if (kept_ids.empty()) {
+                                         return Status::OK();
+                                     }
+                                     added_any = true;
+                                     return index->AddWithIds(static_cast<int64_t>(kept_ids.size()),
+                                                              kept_vectors.data(), kept_ids.data());
+                                 });
+            if (!merge_status.ok()) {
+                if (added_any) {
+                    // rows were already appended; re-reading the file would
+                    // duplicate them, so abandon this merge target
+                    ENGINE_LOG_ERROR << "Compacting merge failed mid-stream for " << file.location_ << ": "
+                                     << merge_status.message();
+                    table_file.file_type_ = meta::TableFileSchema::TO_DELETE;
+                    meta_ptr_->UpdateTableFile(table_file);
+                    return merge_status;
+                }
+                // a non-streamable layout keeps its rows; the tombstones are
+                // carried forward on the merged segment instead
+                ENGINE_LOG_DEBUG << "Compacting merge fell back for " << file.location_ << ": "
+                                 << merge_status.message();
+                index->Merge(file.location_);
+                carried_deletes.insert(deleted->begin(), deleted->end());
+            }
+        } else {
+            index->Merge(file.location_);
+        }
         auto file_schema = file;
         file_schema.file_type_ = meta::TableFileSchema::TO_DELETE;
         updated.push_back(file_schema);
         index_size = index->Size();
 
-        if (index_size >= file_schema.index_file_size_) {
+        if (index_size >= target_size) {
             break;
         }
     }
@@ -753,12 +2105,65 @@ DBImpl::MergeFiles(const std::string& table_id, const meta::DateT& date, const m
         return status;
     }
 
+    // carry scalar attributes over: the merged engine appended the inputs'
+    // rows in file order and sidecars are self-describing, so concatenating
+    // them in the same order is enough. If any input lacks one, the merged
+    // segment stays sidecar-less and is searched unfiltered
+    bool all_have_attrs = !updated.empty();
+    for (auto& file : updated) {
+        if (!AttrSidecar::Exists(file.location_)) {
+            all_have_attrs = false;
+            break;
+        }
+    }
+    if (all_have_attrs) {
+        IDNumbers merged_ids;
+        AttributeColumns merged_columns;
+        Status attr_status = Status::OK();
+        for (auto& file : updated) {
+            IDNumbers part_ids;
+            AttributeColumns part_columns;
+            attr_status = AttrSidecar::Read(file.location_, part_ids, part_columns);
+            if (!attr_status.ok()) {
+                break;
+            }
+            size_t prior_rows = merged_ids.size();
+            merged_ids.insert(merged_ids.end(), part_ids.begin(), part_ids.end());
+            AttrSidecar::AppendColumns(merged_columns, prior_rows, part_columns, 0, part_ids.size());
+        }
+        if (attr_status.ok()) {
+            attr_status = AttrSidecar::Write(table_file.location_, merged_ids, merged_columns);
+        }
+        if (!attr_status.ok()) {
+            ENGINE_LOG_ERROR << "Failed to carry attribute sidecars into merged file " << table_file.file_id_ << ": "
+                             << attr_status.ToString();
+        }
+    }
+
+    if (!carried_deletes.empty()) {
+        IDNumbers carried(carried_deletes.begin(), carried_deletes.end());
+        auto del_status = DeleteSidecar::Append(table_file.location_, carried);
+        if (!del_status.ok()) {
+            ENGINE_LOG_ERROR << "Failed to carry delete sidecars into merged file " << table_file.file_id_ << ": "
+                             << del_status.ToString();
+        }
+    }
+
+    // the merged inputs are marked TO_DELETE but linger until file GC runs;
+    // drop their pages now instead of letting them squat in the cache
+    for (auto& file : updated) {
+        storage::DropFilePageCache(file.location_);
+        AttrSidecar::Evict(file.location_);
+        DeleteSidecar::Evict(file.location_);
+        VectorLookup::GetInstance().Evict(file.location_);
+    }
+
     // step 4: update table files state
     // if index type isn't IDMAP, set file type to TO_INDEX if file size execeed index_file_size
     // else set file type to RAW, no need to build index
-    if (table_file.engine_type_ != (int)EngineType::FAISS_IDMAP) {
-        table_file.file_type_ = (index->PhysicalSize() >= table_file.index_file_size_) ? meta::TableFileSchema::TO_INDEX
-                                                                                       : meta::TableFileSchema::RAW;
+    if (!utils::IsRawIndexType(table_file.engine_type_)) {
+        table_file.file_type_ =
+            (index->PhysicalSize() >= target_size) ? meta::TableFileSchema::TO_INDEX : meta::TableFileSchema::RAW;
     } else {
         table_file.file_type_ = meta::TableFileSchema::RAW;
     }
@@ -766,8 +2171,19 @@ DBImpl::MergeFiles(const std::string& table_id, const meta::DateT& date, const m
     table_file.row_count_ = index->Count();
     updated.push_back(table_file);
     status = meta_ptr_->UpdateTableFiles(updated);
+    search_files_cache_.Invalidate(table_id);
     ENGINE_LOG_DEBUG << "New merged file " << table_file.file_id_ << " of size " << index->PhysicalSize() << " bytes";
 
+    // the merged file may need an index, and the merged-away files need a
+    // later cleanup pass once their TTL expires
+    if (table_file.file_type_ == meta::TableFileSchema::TO_INDEX) {
+        index_pending_.store(true);
+    }
+    {
+        std::lock_guard<std::mutex> lock(meta_event_mutex_);
+        event_table_ids_.insert(table_id);
+    }
+
     if (options_.insert_cache_immediately_) {
         index->Cache();
     }
@@ -791,13 +2207,38 @@ DBImpl::BackgroundMergeFiles(const std::string& table_id) {
             continue;
         }
 
-        status = ongoing_files_checker_.MarkOngoingFiles(files);
-        MergeFiles(table_id, kv.first, kv.second);
-        status = ongoing_files_checker_.UnmarkOngoingFiles(files);
+        // size-tiered selection: sort by size and only merge runs of files
+        // within MERGE_TIER_RATIO of each other. Merging a large file with a
+        // trickle of small ones rewrites the same bytes once per trickle; with
+        // tiers each byte is rewritten O(log) times on its way to index_file_size
+        std::sort(files.begin(), files.end(), [](const meta::TableFileSchema& lhs, const meta::TableFileSchema& rhs) {
+            return lhs.file_size_ < rhs.file_size_;
+        });
+
+        size_t tier_begin = 0;
+        while (tier_begin < files.size()) {
+            // freshly flushed files may not have a size recorded yet; lump
+            // everything below one MB into the same bottom tier
+            uint64_t tier_base = std::max(static_cast<uint64_t>(files[tier_begin].file_size_), ONE_MB);
+            size_t tier_end = tier_begin + 1;
+            while (tier_end < files.size() && files[tier_end].file_size_ <= tier_base * MERGE_TIER_RATIO) {
+                ++tier_end;
+            }
 
-        if (!initialized_.load(std::memory_order_acquire)) {
-            ENGINE_LOG_DEBUG << "Server will shutdown, skip merge action for table: " << table_id;
-            break;
+            if (tier_end - tier_begin >= options_.merge_trigger_number_) {
+                meta::TableFilesSchema tier(files.begin() + tier_begin, files.begin() + tier_end);
+                status = ongoing_files_checker_.MarkOngoingFiles(tier);
+                MergeFiles(table_id, kv.first, tier);
+                status = ongoing_files_checker_.UnmarkOngoingFiles(tier);
+            } else {
+                ENGINE_LOG_TRACE << "No merge peers of similar size, skip merge action";
+            }
+            tier_begin = tier_end;
+
+            if (!initialized_.load(std::memory_order_acquire)) {
+                ENGINE_LOG_DEBUG << "Server will shutdown, skip merge action for table: " << table_id;
+                return Status::OK();
+            }
         }
     }
 
@@ -805,23 +2246,32 @@ DBImpl::BackgroundMergeFiles(const std::string& table_id) {
 }
 
 void
-DBImpl::BackgroundCompaction(std::set<std::string> table_ids) {
-    // ENGINE_LOG_TRACE << " Background compaction thread start";
-
-    Status status;
-    for (auto& table_id : table_ids) {
-        status = BackgroundMergeFiles(table_id);
-        if (!status.ok()) {
-            ENGINE_LOG_ERROR << "Merge files for table " << table_id << " failed: " << status.ToString();
-        }
+DBImpl::BackgroundMerge(std::string table_id) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        ENGINE_LOG_DEBUG << "Server will shutdown, skip merge action";
+        return;
+    }
 
-        if (!initialized_.load(std::memory_order_acquire)) {
-            ENGINE_LOG_DEBUG << "Server will shutdown, skip merge action";
-            break;
-        }
+    auto status = BackgroundMergeFiles(table_id);
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Merge files for table " << table_id << " failed: " << status.ToString();
     }
 
-    meta_ptr_->Archive();
+    // merge buffers are freed by now; return them instead of letting the
+    // compact thread's arena cache them indefinitely
+    server::MallocUtil::PurgeHeap();
+}
+
+void
+DBImpl::BackgroundHousekeeping() {
+    // the days criterion is incremental inside the meta, but the disk criterion
+    // still aggregates file sizes; once a minute is plenty for both and keeps
+    // archiving from starving the merge passes above
+    static uint64_t archive_clock_tick = 0;
+    ++archive_clock_tick;
+    if (archive_clock_tick % ARCHIVE_ACTION_INTERVAL == 0) {
+        meta_ptr_->Archive();
+    }
 
     {
         uint64_t ttl = 10 * meta::SECOND;  // default: file will be hard-deleted few seconds after soft-deleted
@@ -831,8 +2281,6 @@ DBImpl::BackgroundCompaction(std::set<std::string> table_ids) {
 
         meta_ptr_->CleanUpFilesWithTTL(ttl, &ongoing_files_checker_);
     }
-
-    // ENGINE_LOG_TRACE << " Background compaction thread exit";
 }
 
 void
@@ -843,6 +2291,13 @@ DBImpl::StartBuildIndexTask(bool force) {
         return;
     }
 
+    // only look for files to index when a flush or CreateIndex signalled new
+    // work; the slow reconcile tick covers files missed around a restart
+    bool reconcile = (index_clock_tick % RECONCILE_ACTION_INTERVAL == 0);
+    if (!force && !reconcile && !index_pending_.load()) {
+        return;
+    }
+
     // build index has been finished?
     {
         std::lock_guard<std::mutex> lck(index_result_mutex_);
@@ -858,6 +2313,7 @@ DBImpl::StartBuildIndexTask(bool force) {
     {
         std::lock_guard<std::mutex> lck(index_result_mutex_);
         if (index_thread_results_.empty()) {
+            index_pending_.store(false);
             index_thread_results_.push_back(index_thread_pool_.enqueue(&DBImpl::BackgroundBuildIndex, this));
         }
     }
@@ -865,11 +2321,30 @@ DBImpl::StartBuildIndexTask(bool force) {
 
 void
 DBImpl::BackgroundBuildIndex() {
-    std::unique_lock<std::mutex> lock(build_index_mutex_);
+    // the lock only covers the meta snapshot: it keeps an index change in
+    // CreateIndex from rewriting file types while the candidate list is
+    // taken. The long build-and-wait phase below runs unlocked - a build of
+    // the old type finishing after a type change just gets re-queued by the
+    // reconcile pass, and CreateIndex is never stalled behind a full pass.
     meta::TableFilesSchema to_index_files;
-    meta_ptr_->FilesToIndex(to_index_files);
+    {
+        std::unique_lock<std::mutex> lock(build_index_mutex_);
+        meta_ptr_->FilesToIndex(to_index_files);
+    }
     Status status = index_failed_checker_.IgnoreFailedIndexFiles(to_index_files);
 
+    // trickle rolling upgrades: keep the first MAX_UPGRADE_FILES_PER_PASS
+    // queued TO_UPGRADE files and leave the rest for the next pass
+    uint64_t upgrade_count = 0;
+    for (auto iter = to_index_files.begin(); iter != to_index_files.end();) {
+        if (iter->file_type_ == meta::TableFileSchema::TO_UPGRADE && ++upgrade_count > MAX_UPGRADE_FILES_PER_PASS) {
+            iter = to_index_files.erase(iter);
+            index_pending_.store(true);
+        } else {
+            ++iter;
+        }
+    }
+
     if (!to_index_files.empty()) {
         ENGINE_LOG_DEBUG << "Background build index thread begin";
         status = ongoing_files_checker_.MarkOngoingFiles(to_index_files);
@@ -898,12 +2373,224 @@ DBImpl::BackgroundBuildIndex() {
                 ENGINE_LOG_DEBUG << "Building index job " << job->id() << " succeed.";
 
                 index_failed_checker_.MarkSucceedIndexFile(file_schema);
+                // the raw file was replaced by an index file in meta
+                search_files_cache_.Invalidate(file_schema.table_id_);
             }
             status = ongoing_files_checker_.UnmarkOngoingFile(file_schema);
         }
 
         ENGINE_LOG_DEBUG << "Background build index thread finished";
     }
+
+    // wake any CreateIndex caller waiting for its table to finish
+    index_done_cv_.notify_all();
+}
+
+void
+DBImpl::StartTieringTask() {
+    static uint64_t tiering_clock_tick = 0;
+    ++tiering_clock_tick;
+    if (tiering_clock_tick % TIERING_ACTION_INTERVAL != 0) {
+        return;
+    }
+
+    if (options_.meta_.path_device_class_.empty()) {
+        return;  // no path carries a device-class tag, nothing to migrate
+    }
+
+    // tiering finished?
+    {
+        std::lock_guard<std::mutex> lck(tiering_result_mutex_);
+        if (!tiering_thread_results_.empty()) {
+            std::chrono::milliseconds span(10);
+            if (tiering_thread_results_.back().wait_for(span) == std::future_status::ready) {
+                tiering_thread_results_.pop_back();
+            }
+        }
+    }
+
+    // add new tiering task
+    {
+        std::lock_guard<std::mutex> lck(tiering_result_mutex_);
+        if (tiering_thread_results_.empty()) {
+            tiering_thread_results_.push_back(tiering_thread_pool_.enqueue(&DBImpl::BackgroundTiering, this));
+        }
+    }
+}
+
+void
+DBImpl::BackgroundTiering() {
+    server::Config& config = server::Config::GetInstance();
+
+    bool s3_enable = false;
+    config.GetStorageConfigS3Enable(s3_enable);
+    int64_t hot_days = 0;
+    config.GetStorageConfigHotTierDays(hot_days);
+    // with S3 the object key is fixed at write time, so local moves only desync it
+    if (s3_enable || hot_days <= 0) {
+        return;
+    }
+
+    std::vector<meta::TableSchema> table_schema_array;
+    auto status = meta_ptr_->AllTables(table_schema_array);
+    if (!status.ok()) {
+        return;
+    }
+
+    ENGINE_LOG_DEBUG << "Background tiering thread begin";
+
+    std::vector<int> file_types = {
+        meta::TableFileSchema::RAW,
+        meta::TableFileSchema::TO_INDEX,
+        meta::TableFileSchema::INDEX,
+        meta::TableFileSchema::BACKUP,
+    };
+
+    uint64_t migrated_count = 0;
+    for (auto& schema : table_schema_array) {
+        if (!initialized_.load(std::memory_order_acquire) || migrated_count >= TIERING_BATCH_SIZE) {
+            break;
+        }
+
+        meta::TableFilesSchema table_files;
+        status = meta_ptr_->FilesByType(schema.table_id_, file_types, table_files);
+        if (!status.ok()) {
+            continue;
+        }
+
+        for (auto& file : table_files) {
+            if (!initialized_.load(std::memory_order_acquire) || migrated_count >= TIERING_BATCH_SIZE) {
+                break;
+            }
+            if (utils::IsPartitionHot(file.date_, hot_days)) {
+                continue;
+            }
+            if (ongoing_files_checker_.IsIgnored(file)) {
+                continue;  // being searched/merged right now, catch it next pass
+            }
+
+            bool migrated = false;
+            status = utils::MigrateTableFileToCold(options_.meta_, file, migrated);
+            if (!status.ok()) {
+                ENGINE_LOG_ERROR << "Failed to migrate file " << file.file_id_ << ": " << status.message();
+            } else if (migrated) {
+                ++migrated_count;
+            }
+        }
+    }
+
+    ENGINE_LOG_DEBUG << "Background tiering thread finished, " << migrated_count << " files migrated";
+}
+
+void
+DBImpl::StartScrubTask() {
+    static uint64_t scrub_clock_tick = 0;
+    ++scrub_clock_tick;
+    if (scrub_clock_tick % SCRUB_ACTION_INTERVAL != 0) {
+        return;
+    }
+
+    // scrubbing finished?
+    {
+        std::lock_guard<std::mutex> lck(scrub_result_mutex_);
+        if (!scrub_thread_results_.empty()) {
+            std::chrono::milliseconds span(10);
+            if (scrub_thread_results_.back().wait_for(span) == std::future_status::ready) {
+                scrub_thread_results_.pop_back();
+            }
+        }
+    }
+
+    // add new scrub task
+    {
+        std::lock_guard<std::mutex> lck(scrub_result_mutex_);
+        if (scrub_thread_results_.empty()) {
+            scrub_thread_results_.push_back(scrub_thread_pool_.enqueue(&DBImpl::BackgroundScrub, this));
+        }
+    }
+}
+
+void
+DBImpl::BackgroundScrub() {
+    server::Config& config = server::Config::GetInstance();
+
+    int64_t scrub_mb_per_second = 0;
+    config.GetStorageConfigScrubMBPerSecond(scrub_mb_per_second);
+    if (scrub_mb_per_second <= 0) {
+        return;
+    }
+    bool s3_enable = false;
+    config.GetStorageConfigS3Enable(s3_enable);
+
+    std::vector<meta::TableSchema> table_schema_array;
+    auto status = meta_ptr_->AllTables(table_schema_array);
+    if (!status.ok()) {
+        return;
+    }
+
+    ENGINE_LOG_DEBUG << "Background scrub thread begin";
+
+    std::vector<int> file_types = {
+        meta::TableFileSchema::RAW,
+        meta::TableFileSchema::TO_INDEX,
+        meta::TableFileSchema::INDEX,
+        meta::TableFileSchema::BACKUP,
+    };
+
+    uint64_t scrubbed_count = 0;
+    uint64_t corrupt_count = 0;
+    uint64_t repaired_count = 0;
+    for (auto& schema : table_schema_array) {
+        if (!initialized_.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        meta::TableFilesSchema table_files;
+        status = meta_ptr_->FilesByType(schema.table_id_, file_types, table_files);
+        if (!status.ok()) {
+            continue;
+        }
+
+        for (auto& file : table_files) {
+            if (!initialized_.load(std::memory_order_acquire)) {
+                break;
+            }
+            if (!utils::GetTableFilePath(options_.meta_, file).ok()) {
+                continue;  // already garbage collected
+            }
+            if (!boost::filesystem::exists(file.location_)) {
+                continue;  // object lives on S3 only, no local replica to scrub
+            }
+
+            status = VerifySegmentFile(file.location_, scrub_mb_per_second);
+            ++scrubbed_count;
+            if (status.ok()) {
+                continue;
+            }
+
+            ++corrupt_count;
+            ENGINE_LOG_ERROR << "Scrub found corrupted segment " << file.location_ << ": " << status.message();
+            if (!s3_enable) {
+                continue;  // nowhere to repair from; leave the loud log entry
+            }
+
+            auto& storage_inst = storage::S3ClientWrapper::GetInstance();
+            Status fetch_status = storage_inst.GetObjectFile(file.location_, file.location_);
+            if (fetch_status.ok()) {
+                fetch_status = VerifySegmentFile(file.location_, scrub_mb_per_second);
+            }
+            if (fetch_status.ok()) {
+                ++repaired_count;
+                ENGINE_LOG_DEBUG << "Repaired segment " << file.location_ << " from S3";
+            } else {
+                ENGINE_LOG_ERROR << "Failed to repair segment " << file.location_ << " from S3: "
+                                 << fetch_status.message();
+            }
+        }
+    }
+
+    ENGINE_LOG_DEBUG << "Background scrub thread finished, " << scrubbed_count << " files verified, " << corrupt_count
+                     << " corrupt, " << repaired_count << " repaired";
 }
 
 Status
@@ -971,12 +2658,16 @@ DBImpl::DropTableRecursively(const std::string& table_id, const meta::DatesT& da
         status = mem_mgr_->EraseMemVector(table_id);  // not allow insert
         status = meta_ptr_->DropTable(table_id);      // soft delete table
         index_failed_checker_.CleanFailedIndexFileOfTable(table_id);
+        search_files_cache_.Invalidate(table_id);
+        IdIndex::GetInstance().UnregisterTable(table_id);
 
-        // scheduler will determine when to delete table files
+        // scheduler will determine when to delete table files; the job
+        // finishes in the background, so dropping a large table costs the
+        // foreground only the meta tombstone above, and the jobs of a
+        // partitioned table all reap concurrently
         auto nres = scheduler::ResMgrInst::GetInstance()->GetNumOfComputeResource();
         scheduler::DeleteJobPtr job = std::make_shared<scheduler::DeleteJob>(table_id, meta_ptr_, nres);
         scheduler::JobMgrInst::GetInstance()->Put(job);
-        job->WaitAndDelete();
     } else {
         status = meta_ptr_->DropDataByDate(table_id, dates);
     }
@@ -1018,12 +2709,67 @@ DBImpl::UpdateTableIndexRecursively(const std::string& table_id, const TableInde
     return Status::OK();
 }
 
+Status
+DBImpl::UpdateTableIndexRollingRecursively(const std::string& table_id, const TableIndex& index) {
+    // unlike UpdateTableIndexRecursively there is no DropIndex here: the old
+    // index files stay in place and keep serving until each one is replaced
+    auto status = meta_ptr_->UpdateTableIndexRolling(table_id, index);
+    fiu_do_on("DBImpl.UpdateTableIndexRollingRecursively.fail_update_table_index",
+              status = Status(DB_META_TRANSACTION_FAILED, ""));
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Failed to update table index info for table: " << table_id;
+        return status;
+    }
+
+    std::vector<meta::TableSchema> partition_array;
+    status = meta_ptr_->ShowPartitions(table_id, partition_array);
+    for (auto& schema : partition_array) {
+        status = UpdateTableIndexRollingRecursively(schema.table_id_, index);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    return Status::OK();
+}
+
+bool
+DBImpl::IndexFilesLinkedRecursively(const std::string& table_id) {
+    // a rolling upgrade retires each old index file through its source link;
+    // index files from before the source_file_id column carry none and can
+    // only be replaced by the legacy drop-and-rebuild
+    meta::TableFilesSchema index_files;
+    std::vector<int> file_types = {meta::TableFileSchema::INDEX};
+    auto status = meta_ptr_->FilesByType(table_id, file_types, index_files);
+    if (!status.ok()) {
+        return false;
+    }
+    for (auto& file : index_files) {
+        if (file.source_file_id_.empty()) {
+            return false;
+        }
+    }
+
+    std::vector<meta::TableSchema> partition_array;
+    status = meta_ptr_->ShowPartitions(table_id, partition_array);
+    if (!status.ok()) {
+        return false;
+    }
+    for (auto& schema : partition_array) {
+        if (!IndexFilesLinkedRecursively(schema.table_id_)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 Status
 DBImpl::BuildTableIndexRecursively(const std::string& table_id, const TableIndex& index) {
     // for IDMAP type, only wait all NEW file converted to RAW file
     // for other type, wait NEW/RAW/NEW_MERGE/NEW_INDEX/TO_INDEX files converted to INDEX files
     std::vector<int> file_types;
-    if (index.engine_type_ == static_cast<int32_t>(EngineType::FAISS_IDMAP)) {
+    if (utils::IsRawIndexType(index.engine_type_)) {
         file_types = {
             static_cast<int32_t>(meta::TableFileSchema::NEW),
             static_cast<int32_t>(meta::TableFileSchema::NEW_MERGE),
@@ -1045,11 +2791,16 @@ DBImpl::BuildTableIndexRecursively(const std::string& table_id, const TableIndex
 
     while (!table_files.empty()) {
         ENGINE_LOG_DEBUG << "Non index files detected! Will build index " << times;
-        if (index.engine_type_ != (int)EngineType::FAISS_IDMAP) {
+        if (!utils::IsRawIndexType(index.engine_type_)) {
             status = meta_ptr_->UpdateTableFilesToIndex(table_id);
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(std::min(10 * 1000, times * 100)));
+        // woken at the end of every build pass; the timeout only bounds the
+        // wait while no pass is running (e.g. files still NEW, pending flush)
+        {
+            std::unique_lock<std::mutex> lock(index_done_mutex_);
+            index_done_cv_.wait_for(lock, std::chrono::milliseconds(std::min(10 * 1000, times * 100)));
+        }
         GetFilesToBuildIndex(table_id, file_types, table_files);
         ++times;
 
@@ -20,11 +20,14 @@
 #include <set>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "DB.h"
+#include "db/AutoTuner.h"
 #include "db/IndexFailedChecker.h"
 #include "db/OngoingFileChecker.h"
+#include "db/SearchFilesCache.h"
 #include "db/Types.h"
 #include "db/insert/MemManager.h"
 #include "utils/ThreadPool.h"
@@ -64,7 +67,12 @@ class DBImpl : public DB {
     AllTables(std::vector<meta::TableSchema>& table_schema_array) override;
 
     Status
-    PreloadTable(const std::string& table_id) override;
+    PreloadTable(const std::string& table_id, bool pin = false, int64_t priority = 0,
+                 const std::vector<std::string>& partition_tags = std::vector<std::string>(),
+                 const meta::DatesT& dates = meta::DatesT()) override;
+
+    Status
+    OrderTablesByWarmth(std::vector<std::string>& table_ids) override;
 
     Status
     UpdateTableFlag(const std::string& table_id, int64_t flag);
@@ -72,6 +80,10 @@ class DBImpl : public DB {
     Status
     GetTableRowCount(const std::string& table_id, uint64_t& row_count) override;
 
+    Status
+    DescribeTableStats(const std::string& table_id, meta::TableStats& total,
+                       std::vector<std::pair<std::string, meta::TableStats>>& partition_stats) override;
+
     Status
     CreatePartition(const std::string& table_id, const std::string& partition_name,
                     const std::string& partition_tag) override;
@@ -88,6 +100,15 @@ class DBImpl : public DB {
     Status
     InsertVectors(const std::string& table_id, const std::string& partition_tag, VectorsData& vectors) override;
 
+    Status
+    ImportVectors(const std::string& table_id, const std::string& partition_tag, VectorsData& vectors) override;
+
+    Status
+    UpsertVectors(const std::string& table_id, const std::string& partition_tag, VectorsData& vectors) override;
+
+    Status
+    DeleteByID(const std::string& table_id, const IDNumbers& id_array) override;
+
     Status
     CreateIndex(const std::string& table_id, const TableIndex& index) override;
 
@@ -107,6 +128,28 @@ class DBImpl : public DB {
           const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
           const meta::DatesT& dates, ResultIds& result_ids, ResultDistances& result_distances) override;
 
+    Status
+    QueryStream(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                const std::vector<std::string>& partition_tags, uint64_t k, uint64_t nprobe,
+                const VectorsData& vectors, const meta::DatesT& dates, const SearchStreamCallback& stream_callback,
+                ResultIds& result_ids, ResultDistances& result_distances) override;
+
+    Status
+    QueryRange(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+               const std::vector<std::string>& partition_tags, float radius, uint64_t max_k, uint64_t nprobe,
+               const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances,
+               ResultLims& result_lims) override;
+
+    Status
+    ExportTable(const std::string& table_id, const ExportChunkCallback& chunk_callback) override;
+
+    Status
+    GetVectorsByID(const std::string& table_id, const IDNumbers& id_array, std::vector<VectorsData>& vectors) override;
+
+    Status
+    GetSearchFileIds(const std::string& table_id, const std::vector<std::string>& partition_tags,
+                     std::vector<std::pair<std::string, std::vector<std::string>>>& table_files) override;
+
     Status
     QueryByFileID(const std::shared_ptr<server::Context>& context, const std::string& table_id,
                   const std::vector<std::string>& file_ids, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
@@ -119,7 +162,14 @@ class DBImpl : public DB {
     Status
     QueryAsync(const std::shared_ptr<server::Context>& context, const std::string& table_id,
                const meta::TableFilesSchema& files, uint64_t k, uint64_t nprobe, const VectorsData& vectors,
-               ResultIds& result_ids, ResultDistances& result_distances);
+               ResultIds& result_ids, ResultDistances& result_distances,
+               const SearchStreamCallback& stream_callback = nullptr);
+
+    Status
+    QueryRangeAsync(const std::shared_ptr<server::Context>& context, const std::string& table_id,
+                    const meta::TableFilesSchema& files, float radius, uint64_t max_k, uint64_t nprobe,
+                    const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances,
+                    ResultLims& result_lims);
 
     void
     BackgroundTimerTask();
@@ -131,6 +181,22 @@ class DBImpl : public DB {
     void
     StartMetricTask();
 
+    void
+    StartWarmStateTask();
+    void
+    SaveCacheWarmState();
+    void
+    ReplayCacheWarmState();
+
+    // read the persisted snapshot keys, hottest first; empty when absent
+    void
+    ReadWarmStateKeys(std::vector<std::string>& keys);
+
+    // reject a batch whose ids already exist in the table; filter positives
+    // are confirmed against the segments before rejecting
+    Status
+    CheckDuplicateIds(const std::string& table_id, const IDNumbers& id_array);
+
     void
     StartCompactionTask();
     Status
@@ -138,13 +204,29 @@ class DBImpl : public DB {
     Status
     BackgroundMergeFiles(const std::string& table_id);
     void
-    BackgroundCompaction(std::set<std::string> table_ids);
+    BackgroundMerge(std::string table_id);
+    void
+    BackgroundHousekeeping();
 
     void
     StartBuildIndexTask(bool force = false);
     void
     BackgroundBuildIndex();
 
+    void
+    StartTieringTask();
+    void
+    BackgroundTiering();
+    void
+    WaitTieringFinish();
+
+    void
+    StartScrubTask();
+    void
+    BackgroundScrub();
+    void
+    WaitScrubFinish();
+
     Status
     SyncMemData(std::set<std::string>& sync_table_ids);
 
@@ -152,6 +234,10 @@ class DBImpl : public DB {
     GetFilesToBuildIndex(const std::string& table_id, const std::vector<int>& file_types,
                          meta::TableFilesSchema& files);
 
+    Status
+    ExportTableFiles(const std::string& table_id, const ExportChunkCallback& chunk_callback, uint64_t& exported_rows,
+                     bool& cancelled);
+
     Status
     GetFilesToSearch(const std::string& table_id, const std::vector<size_t>& file_ids, const meta::DatesT& dates,
                      meta::TableFilesSchema& files);
@@ -166,6 +252,12 @@ class DBImpl : public DB {
     Status
     UpdateTableIndexRecursively(const std::string& table_id, const TableIndex& index);
 
+    Status
+    UpdateTableIndexRollingRecursively(const std::string& table_id, const TableIndex& index);
+
+    bool
+    IndexFilesLinkedRecursively(const std::string& table_id);
+
     Status
     BuildTableIndexRecursively(const std::string& table_id, const TableIndex& index);
 
@@ -182,6 +274,14 @@ class DBImpl : public DB {
 
     std::thread bg_timer_thread_;
 
+    // restart warm-up; budget is 0 when warm-state persistence is disabled
+    std::thread warm_replay_thread_;
+    int64_t warm_replay_budget_ = 0;
+    std::string warm_state_path_;
+
+    // periodic per-table search-parameter tuning from the query sampling log
+    std::shared_ptr<AutoTuner> auto_tuner_;
+
     meta::MetaPtr meta_ptr_;
     MemManagerPtr mem_mgr_;
     std::mutex mem_serialize_mutex_;
@@ -191,14 +291,35 @@ class DBImpl : public DB {
     std::list<std::future<void>> compact_thread_results_;
     std::set<std::string> compact_table_ids_;
 
+    // meta change notifications gathered from the MetaEventBus; the timer
+    // loop drains them so idle clusters stop polling the meta every second
+    std::mutex meta_event_mutex_;
+    std::set<std::string> event_table_ids_;
+    std::atomic<bool> index_pending_{true};
+    int64_t meta_event_subscription_ = -1;
+
     ThreadPool index_thread_pool_;
     std::mutex index_result_mutex_;
     std::list<std::future<void>> index_thread_results_;
 
+    ThreadPool tiering_thread_pool_;
+    std::mutex tiering_result_mutex_;
+    std::list<std::future<void>> tiering_thread_results_;
+
+    ThreadPool scrub_thread_pool_;
+    std::mutex scrub_result_mutex_;
+    std::list<std::future<void>> scrub_thread_results_;
+
     std::mutex build_index_mutex_;
 
+    // signals the end of each background build pass, so index wait loops can
+    // re-check meta immediately instead of sleep-polling on a fixed interval
+    std::mutex index_done_mutex_;
+    std::condition_variable index_done_cv_;
+
     IndexFailedChecker index_failed_checker_;
     OngoingFileChecker ongoing_files_checker_;
+    SearchFilesCache search_files_cache_;
 };  // DBImpl
 
 }  // namespace engine
@@ -0,0 +1,166 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/DeleteSidecar.h"
+
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+constexpr const char* DEL_FILE_SUFFIX = ".del";
+constexpr uint32_t DEL_FILE_MAGIC = 0x544C4544;  // "DELT"
+constexpr uint8_t DEL_FORMAT_VERSION = 1;
+
+std::string
+DelPath(const std::string& location) {
+    return location + DEL_FILE_SUFFIX;
+}
+
+std::mutex cache_mutex;
+std::unordered_map<std::string, DeleteSidecar::DeletedSetPtr> del_cache;
+
+template <typename T>
+bool
+ReadPod(std::ifstream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return in.good();
+}
+
+template <typename T>
+void
+WritePod(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
+bool
+DeleteSidecar::Exists(const std::string& location) {
+    std::ifstream in(DelPath(location), std::ios::binary);
+    return in.good();
+}
+
+Status
+DeleteSidecar::Append(const std::string& location, const IDNumbers& ids) {
+    if (ids.empty()) {
+        return Status::OK();
+    }
+
+    DeletedSet merged(ids.begin(), ids.end());
+    IDNumbers existing;
+    if (Exists(location)) {
+        auto status = Read(location, existing);
+        if (!status.ok()) {
+            return status;
+        }
+        merged.insert(existing.begin(), existing.end());
+    }
+
+    auto path = DelPath(location);
+    auto tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out.good()) {
+            return Status(DB_ERROR, "Failed to create delete sidecar: " + tmp_path);
+        }
+        WritePod(out, DEL_FILE_MAGIC);
+        WritePod(out, DEL_FORMAT_VERSION);
+        WritePod(out, static_cast<uint64_t>(merged.size()));
+        for (auto id : merged) {
+            WritePod(out, static_cast<int64_t>(id));
+        }
+        if (!out.good()) {
+            return Status(DB_ERROR, "Failed to write delete sidecar: " + tmp_path);
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        return Status(DB_ERROR, "Failed to publish delete sidecar: " + path);
+    }
+
+    Evict(location);
+    return Status::OK();
+}
+
+Status
+DeleteSidecar::Read(const std::string& location, IDNumbers& ids) {
+    ids.clear();
+
+    std::ifstream in(DelPath(location), std::ios::binary);
+    if (!in.good()) {
+        return Status(DB_NOT_FOUND, "No delete sidecar for segment: " + location);
+    }
+
+    uint32_t magic = 0;
+    uint8_t version = 0;
+    uint64_t count = 0;
+    if (!ReadPod(in, magic) || magic != DEL_FILE_MAGIC) {
+        return Status(DB_ERROR, "Invalid delete sidecar header: " + location);
+    }
+    if (!ReadPod(in, version) || version != DEL_FORMAT_VERSION) {
+        return Status(DB_ERROR, "Unsupported delete sidecar version: " + location);
+    }
+    if (!ReadPod(in, count)) {
+        return Status(DB_ERROR, "Truncated delete sidecar: " + location);
+    }
+
+    ids.reserve(count);
+    for (uint64_t i = 0; i < count; i++) {
+        int64_t id = 0;
+        if (!ReadPod(in, id)) {
+            return Status(DB_ERROR, "Truncated delete sidecar: " + location);
+        }
+        ids.push_back(id);
+    }
+    return Status::OK();
+}
+
+DeleteSidecar::DeletedSetPtr
+DeleteSidecar::Load(const std::string& location) {
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto iter = del_cache.find(location);
+        if (iter != del_cache.end()) {
+            return iter->second;
+        }
+    }
+
+    DeletedSetPtr loaded;
+    IDNumbers ids;
+    if (Read(location, ids).ok() && !ids.empty()) {
+        loaded = std::make_shared<const DeletedSet>(ids.begin(), ids.end());
+    }
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto& slot = del_cache[location];
+    if (slot == nullptr) {
+        // a nullptr slot also caches "no deletions", sparing the hot search
+        // path a file probe per segment per query
+        slot = loaded;
+    }
+    return slot;
+}
+
+void
+DeleteSidecar::Evict(const std::string& location) {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    del_cache.erase(location);
+}
+
+}  // namespace engine
+}  // namespace milvus
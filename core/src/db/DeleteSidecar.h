@@ -0,0 +1,56 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Types.h"
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+namespace milvus {
+namespace engine {
+
+// Per-segment deletion tombstones stored next to a segment as
+// <location>.del: the set of ids deleted from that segment since it was
+// flushed. Search masks tombstoned hits out of its results, fetch treats
+// them as absent, and merge drops their rows, so the sidecar of a merged
+// input dies with it. A segment without a sidecar has no deletions.
+class DeleteSidecar {
+ public:
+    using DeletedSet = std::unordered_set<IDNumber>;
+    using DeletedSetPtr = std::shared_ptr<const DeletedSet>;
+
+    static bool
+    Exists(const std::string& location);
+
+    // unions `ids` into the segment's tombstone set and rewrites the sidecar
+    // atomically (write-temp-then-rename), so concurrent readers see either
+    // the old or the new set
+    static Status
+    Append(const std::string& location, const IDNumbers& ids);
+
+    static Status
+    Read(const std::string& location, IDNumbers& ids);
+
+    // cached tombstone set of the segment, nullptr when it has none; Append
+    // invalidates the entry, so a reloaded set reflects the latest delete
+    static DeletedSetPtr
+    Load(const std::string& location);
+
+    // drops the cached set of a merged-away or deleted segment
+    static void
+    Evict(const std::string& location);
+};
+
+}  // namespace engine
+}  // namespace milvus
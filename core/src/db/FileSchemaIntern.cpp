@@ -0,0 +1,56 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/FileSchemaIntern.h"
+
+#include <memory>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+// a cached descriptor is only reused while the meta row is byte-identical in
+// the fields state transitions touch; updated_time_ alone covers rows written
+// by this version, the others guard rows from metas that did not bump it
+bool
+SameRevision(const meta::TableFileSchema& lhs, const meta::TableFileSchema& rhs) {
+    return lhs.updated_time_ == rhs.updated_time_ && lhs.file_type_ == rhs.file_type_ &&
+           lhs.file_size_ == rhs.file_size_ && lhs.row_count_ == rhs.row_count_;
+}
+
+}  // namespace
+
+FileSchemaIntern&
+FileSchemaIntern::GetInstance() {
+    static FileSchemaIntern instance;
+    return instance;
+}
+
+meta::TableFileSchemaPtr
+FileSchemaIntern::Intern(const meta::TableFileSchema& file) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(file.id_);
+    if (iter != entries_.end() && SameRevision(*iter->second, file)) {
+        return iter->second;
+    }
+
+    if (entries_.size() >= CAPACITY) {
+        entries_.clear();
+    }
+
+    auto descriptor = std::make_shared<meta::TableFileSchema>(file);
+    entries_[file.id_] = descriptor;
+    return descriptor;
+}
+
+}  // namespace engine
+}  // namespace milvus
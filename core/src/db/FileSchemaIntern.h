@@ -0,0 +1,51 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+#include "db/meta/MetaTypes.h"
+
+namespace milvus {
+namespace engine {
+
+// Flyweight pool of file descriptors for the query path. TableFileSchema is
+// a struct of ~10 strings, and building a fresh shared_ptr copy per file per
+// query turns into millions of string constructions per second under load;
+// interning by file id lets every query of the same segment share one
+// immutable descriptor. A descriptor is reused only while the meta row is
+// unchanged (updated_time_ moves on every state transition), so a stale
+// entry self-heals on the next Intern call instead of needing invalidation
+// hooks; descriptors of dropped files age out through the capacity reset.
+class FileSchemaIntern {
+ public:
+    static FileSchemaIntern&
+    GetInstance();
+
+    // shared descriptor equal to `file`; callers must treat it as immutable
+    meta::TableFileSchemaPtr
+    Intern(const meta::TableFileSchema& file);
+
+ private:
+    FileSchemaIntern() = default;
+
+    // when the pool outgrows this it is dropped wholesale; reaching it takes
+    // that many live segments, so the reset is rare and refill is cheap
+    static constexpr size_t CAPACITY = 65536;
+
+    std::mutex mutex_;
+    std::unordered_map<size_t, meta::TableFileSchemaPtr> entries_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -56,5 +56,55 @@ SimpleIDGenerator::GetNextIDNumbers(size_t n, IDNumbers& ids) {
     NextIDNumbers(n, ids);
 }
 
+namespace {
+
+IDNumber
+ClockSeed() {
+    // same scale as SimpleIDGenerator, so the counter starts above every id
+    // a previous run could have issued from its timestamps
+    auto now = std::chrono::system_clock::now();
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+    return micros * 1000;
+}
+
+}  // namespace
+
+constexpr size_t ShardedIDGenerator::LEASE_SIZE;
+
+ShardedIDGenerator::PaddedCounter ShardedIDGenerator::next_id_{{ClockSeed()}};
+thread_local ShardedIDGenerator::Lease ShardedIDGenerator::lease_;
+
+IDNumber
+ShardedIDGenerator::LeaseRange(size_t n) {
+    return next_id_.value.fetch_add(static_cast<IDNumber>(n), std::memory_order_relaxed);
+}
+
+IDNumber
+ShardedIDGenerator::GetNextIDNumber() {
+    if (lease_.next >= lease_.limit) {
+        lease_.next = LeaseRange(LEASE_SIZE);
+        lease_.limit = lease_.next + static_cast<IDNumber>(LEASE_SIZE);
+    }
+    return lease_.next++;
+}
+
+void
+ShardedIDGenerator::GetNextIDNumbers(size_t n, IDNumbers& ids) {
+    ids.clear();
+    ids.reserve(n);
+    if (n >= LEASE_SIZE) {
+        // bulk loads take one contiguous range straight off the counter
+        // instead of draining lease after lease
+        IDNumber base = LeaseRange(n);
+        for (size_t pos = 0; pos < n; ++pos) {
+            ids.push_back(base + static_cast<IDNumber>(pos));
+        }
+        return;
+    }
+    for (size_t pos = 0; pos < n; ++pos) {
+        ids.push_back(GetNextIDNumber());
+    }
+}
+
 }  // namespace engine
 }  // namespace milvus
@@ -0,0 +1,181 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/IdIndex.h"
+
+namespace milvus {
+namespace engine {
+
+namespace {
+// ~10 bits per id keeps the false positive rate around 1% with three probes
+constexpr size_t BITS_PER_ID = 10;
+constexpr size_t HASH_PROBES = 3;
+}  // namespace
+
+IdIndex&
+IdIndex::GetInstance() {
+    static IdIndex instance;
+    return instance;
+}
+
+uint64_t
+IdIndex::HashId(IDNumber id, uint64_t seed) {
+    // splitmix64 finalizer, seeded per probe
+    uint64_t x = static_cast<uint64_t>(id) + seed * 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+void
+IdIndex::SegmentFilter::Build(const IDNumbers& ids) {
+    size_t bit_count = 64;
+    while (bit_count < ids.size() * BITS_PER_ID) {
+        bit_count <<= 1;
+    }
+
+    bits_.assign(bit_count / 64, 0);
+    for (auto id : ids) {
+        for (size_t probe = 0; probe < HASH_PROBES; probe++) {
+            uint64_t bit = HashId(id, probe + 1) & (bit_count - 1);
+            bits_[bit / 64] |= (1ULL << (bit % 64));
+        }
+    }
+}
+
+bool
+IdIndex::SegmentFilter::MayContain(IDNumber id) const {
+    if (bits_.empty()) {
+        return false;
+    }
+
+    uint64_t bit_count = bits_.size() * 64;
+    for (size_t probe = 0; probe < HASH_PROBES; probe++) {
+        uint64_t bit = HashId(id, probe + 1) & (bit_count - 1);
+        if ((bits_[bit / 64] & (1ULL << (bit % 64))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+IdIndex::RegisterSegment(const std::string& table_id, const std::string& location, const IDNumbers& ids) {
+    if (ids.empty()) {
+        return;
+    }
+
+    SegmentFilter filter;
+    filter.Build(ids);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    table_segments_[table_id][location] = std::move(filter);
+
+    // the flushed ids are now covered by the segment filter
+    auto pending = pending_.find(table_id);
+    if (pending != pending_.end()) {
+        for (auto id : ids) {
+            pending->second.erase(id);
+        }
+        if (pending->second.empty()) {
+            pending_.erase(pending);
+        }
+    }
+}
+
+void
+IdIndex::AddPending(const std::string& table_id, const IDNumbers& ids) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& pending = pending_[table_id];
+    pending.insert(ids.begin(), ids.end());
+}
+
+bool
+IdIndex::PendingContains(const std::string& table_id, IDNumber id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto pending = pending_.find(table_id);
+    return pending != pending_.end() && pending->second.count(id) != 0;
+}
+
+void
+IdIndex::UnregisterSegment(const std::string& table_id, const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = table_segments_.find(table_id);
+    if (iter != table_segments_.end()) {
+        iter->second.erase(location);
+    }
+}
+
+void
+IdIndex::UnregisterTable(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    table_segments_.erase(table_id);
+    tombstones_.erase(table_id);
+    pending_.erase(table_id);
+}
+
+bool
+IdIndex::TableMayContain(const std::string& table_id, IDNumber id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = table_segments_.find(table_id);
+    if (iter == table_segments_.end()) {
+        return false;
+    }
+
+    for (auto& segment : iter->second) {
+        if (segment.second.MayContain(id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+IdIndex::SegmentMayContain(const std::string& table_id, const std::string& location, IDNumber id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = table_segments_.find(table_id);
+    if (iter == table_segments_.end()) {
+        return true;
+    }
+    auto segment = iter->second.find(location);
+    if (segment == iter->second.end()) {
+        return true;
+    }
+    return segment->second.MayContain(id);
+}
+
+void
+IdIndex::MarkSuperseded(const std::string& table_id, IDNumber id, int64_t micros) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tombstones_[table_id][id] = micros;
+}
+
+bool
+IdIndex::HasTombstones(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = tombstones_.find(table_id);
+    return iter != tombstones_.end() && !iter->second.empty();
+}
+
+int64_t
+IdIndex::SupersededTime(const std::string& table_id, IDNumber id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = tombstones_.find(table_id);
+    if (iter == tombstones_.end()) {
+        return 0;
+    }
+
+    auto id_iter = iter->second.find(id);
+    return id_iter == iter->second.end() ? 0 : id_iter->second;
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,105 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Types.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// In-process index of which ids live where, backing the lazy upsert path.
+// Flush registers a compact Bloom filter per segment (~10 bits per id), so
+// upsert can cheaply tell whether an id exists in a table at all before
+// tombstoning it. Superseded ids are recorded with their mark time; search
+// filters hits whose segment predates the mark instead of rewriting the
+// segment, and compaction can reclaim them when segments are rewritten.
+class IdIndex {
+ public:
+    static IdIndex&
+    GetInstance();
+
+    void
+    RegisterSegment(const std::string& table_id, const std::string& location, const IDNumbers& ids);
+
+    void
+    UnregisterSegment(const std::string& table_id, const std::string& location);
+
+    // drops the table's segment filters and tombstones
+    void
+    UnregisterTable(const std::string& table_id);
+
+    // false means the id is definitely absent; true means it may exist
+    bool
+    TableMayContain(const std::string& table_id, IDNumber id);
+
+    /*
+     * Ids inserted but not yet flushed to a segment. Kept as an exact set so
+     * insert-time duplicate rejection never fires on a filter false positive;
+     * RegisterSegment drains the flushed ids, bounding the set by the insert
+     * buffer size. Only populated when insert_dedup_check is enabled.
+     */
+    void
+    AddPending(const std::string& table_id, const IDNumbers& ids);
+
+    bool
+    PendingContains(const std::string& table_id, IDNumber id);
+
+    // per-segment variant of TableMayContain; segments with no registered
+    // filter (e.g. flushed before this process started) may contain anything
+    bool
+    SegmentMayContain(const std::string& table_id, const std::string& location, IDNumber id);
+
+    void
+    MarkSuperseded(const std::string& table_id, IDNumber id, int64_t micros);
+
+    // cheap gate for the search hot path; most tables have no tombstones
+    bool
+    HasTombstones(const std::string& table_id);
+
+    // mark time in microseconds, 0 when the id was never superseded
+    int64_t
+    SupersededTime(const std::string& table_id, IDNumber id);
+
+ private:
+    IdIndex() = default;
+
+    // Bloom filter with three hash probes over a power-of-two bit array
+    struct SegmentFilter {
+        std::vector<uint64_t> bits_;
+
+        void
+        Build(const IDNumbers& ids);
+        bool
+        MayContain(IDNumber id) const;
+    };
+
+    static uint64_t
+    HashId(IDNumber id, uint64_t seed);
+
+ private:
+    std::mutex mutex_;
+    // table id -> segment location -> membership filter
+    std::unordered_map<std::string, std::unordered_map<std::string, SegmentFilter>> table_segments_;
+    // table id -> superseded id -> mark time in microseconds
+    std::unordered_map<std::string, std::unordered_map<IDNumber, int64_t>> tombstones_;
+    // table id -> ids inserted but not yet flushed
+    std::unordered_map<std::string, std::unordered_set<IDNumber>> pending_;
+};
+
+}  // namespace engine
+}  // namespace milvus
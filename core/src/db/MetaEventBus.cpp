@@ -0,0 +1,46 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/MetaEventBus.h"
+
+namespace milvus {
+namespace engine {
+
+MetaEventBus&
+MetaEventBus::GetInstance() {
+    static MetaEventBus instance;
+    return instance;
+}
+
+int64_t
+MetaEventBus::Subscribe(const Callback& callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t id = next_subscription_id_++;
+    subscribers_[id] = callback;
+    return id;
+}
+
+void
+MetaEventBus::Unsubscribe(int64_t subscription_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscribers_.erase(subscription_id);
+}
+
+void
+MetaEventBus::Publish(MetaEvent event, const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& kv : subscribers_) {
+        kv.second(event, table_id);
+    }
+}
+
+}  // namespace engine
+}  // namespace milvus
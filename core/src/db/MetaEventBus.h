@@ -0,0 +1,61 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace milvus {
+namespace engine {
+
+// What changed in the meta, published on the MetaEventBus.
+enum class MetaEvent {
+    FLUSH_COMPLETED,  // a table's in-memory data reached disk; merge/index work may exist
+    INDEX_REQUESTED,  // an explicit CreateIndex marked files TO_INDEX
+};
+
+// Tiny in-process publish/subscribe bus for meta change notifications.
+// Flush completions and index requests publish here so the background
+// merge/build loops only query the meta when something actually changed,
+// instead of polling it every second; a slow periodic reconcile in the
+// loops covers anything missed. Dispatch is synchronous in the publisher's
+// thread, so callbacks must be cheap and non-blocking. Subscribers must
+// unsubscribe before they are destroyed.
+class MetaEventBus {
+ public:
+    using Callback = std::function<void(MetaEvent, const std::string& table_id)>;
+
+    static MetaEventBus&
+    GetInstance();
+
+    int64_t
+    Subscribe(const Callback& callback);
+
+    void
+    Unsubscribe(int64_t subscription_id);
+
+    void
+    Publish(MetaEvent event, const std::string& table_id);
+
+ private:
+    MetaEventBus() = default;
+
+ private:
+    std::mutex mutex_;
+    std::map<int64_t, Callback> subscribers_;
+    int64_t next_subscription_id_ = 0;
+};
+
+}  // namespace engine
+}  // namespace milvus
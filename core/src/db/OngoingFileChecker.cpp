@@ -12,112 +12,111 @@
 #include "db/OngoingFileChecker.h"
 #include "utils/Log.h"
 
-#include <utility>
+#include <functional>
 
 namespace milvus {
 namespace engine {
 
-Status
-OngoingFileChecker::MarkOngoingFile(const meta::TableFileSchema& table_file) {
-    std::lock_guard<std::mutex> lck(mutex_);
-    return MarkOngoingFileNoLock(table_file);
+std::string
+OngoingFileChecker::FileKey(const meta::TableFileSchema& table_file) {
+    return table_file.table_id_ + "/" + table_file.file_id_;
 }
 
-Status
-OngoingFileChecker::MarkOngoingFiles(const meta::TableFilesSchema& table_files) {
-    std::lock_guard<std::mutex> lck(mutex_);
-
-    for (auto& table_file : table_files) {
-        MarkOngoingFileNoLock(table_file);
-    }
-
-    return Status::OK();
+OngoingFileChecker::Shard&
+OngoingFileChecker::ShardFor(const std::string& key) {
+    return shards_[std::hash<std::string>()(key) % SHARD_COUNT];
 }
 
-Status
-OngoingFileChecker::UnmarkOngoingFile(const meta::TableFileSchema& table_file) {
-    std::lock_guard<std::mutex> lck(mutex_);
-    return UnmarkOngoingFileNoLock(table_file);
+void
+OngoingFileChecker::SetDrainCallback(DrainCallback callback) {
+    // set once during startup, before any task marks files
+    drain_callback_ = std::move(callback);
 }
 
 Status
-OngoingFileChecker::UnmarkOngoingFiles(const meta::TableFilesSchema& table_files) {
-    std::lock_guard<std::mutex> lck(mutex_);
-
-    for (auto& table_file : table_files) {
-        UnmarkOngoingFileNoLock(table_file);
+OngoingFileChecker::MarkOngoingFile(const meta::TableFileSchema& table_file) {
+    if (table_file.table_id_.empty() || table_file.file_id_.empty()) {
+        return Status(DB_ERROR, "Invalid table files");
     }
 
+    std::string key = FileKey(table_file);
+    auto& shard = ShardFor(key);
+
+    std::lock_guard<std::mutex> lck(shard.mutex_);
+    int64_t refcount = ++shard.refs_[key].count_;
+
+    ENGINE_LOG_DEBUG << "Mark ongoing file:" << table_file.file_id_ << " refcount:" << refcount;
+
     return Status::OK();
 }
 
-bool
-OngoingFileChecker::IsIgnored(const meta::TableFileSchema& schema) {
-    std::lock_guard<std::mutex> lck(mutex_);
-
-    auto iter = ongoing_files_.find(schema.table_id_);
-    if (iter == ongoing_files_.end()) {
-        return false;
-    } else {
-        auto it_file = iter->second.find(schema.file_id_);
-        if (it_file == iter->second.end()) {
-            return false;
-        } else {
-            return (it_file->second > 0);
-        }
+Status
+OngoingFileChecker::MarkOngoingFiles(const meta::TableFilesSchema& table_files) {
+    for (auto& table_file : table_files) {
+        MarkOngoingFile(table_file);
     }
+
+    return Status::OK();
 }
 
 Status
-OngoingFileChecker::MarkOngoingFileNoLock(const meta::TableFileSchema& table_file) {
+OngoingFileChecker::UnmarkOngoingFile(const meta::TableFileSchema& table_file) {
     if (table_file.table_id_.empty() || table_file.file_id_.empty()) {
         return Status(DB_ERROR, "Invalid table files");
     }
 
-    auto iter = ongoing_files_.find(table_file.table_id_);
-    if (iter == ongoing_files_.end()) {
-        File2RefCount files_refcount;
-        files_refcount.insert(std::make_pair(table_file.file_id_, 1));
-        ongoing_files_.insert(std::make_pair(table_file.table_id_, files_refcount));
-    } else {
-        auto it_file = iter->second.find(table_file.file_id_);
-        if (it_file == iter->second.end()) {
-            iter->second[table_file.file_id_] = 1;
-        } else {
-            it_file->second++;
+    std::string key = FileKey(table_file);
+    auto& shard = ShardFor(key);
+
+    bool drained_retiree = false;
+    {
+        std::lock_guard<std::mutex> lck(shard.mutex_);
+        auto iter = shard.refs_.find(key);
+        if (iter != shard.refs_.end()) {
+            iter->second.count_--;
+
+            ENGINE_LOG_DEBUG << "Unmark ongoing file:" << table_file.file_id_ << " refcount:" << iter->second.count_;
+
+            if (iter->second.count_ <= 0) {
+                drained_retiree = iter->second.retire_deferred_;
+                shard.refs_.erase(iter);
+            }
         }
     }
 
-    ENGINE_LOG_DEBUG << "Mark ongoing file:" << table_file.file_id_
-                     << " refcount:" << ongoing_files_[table_file.table_id_][table_file.file_id_];
+    // fire outside the shard lock: the callback typically takes its own lock
+    if (drained_retiree && drain_callback_) {
+        drain_callback_(table_file.table_id_);
+    }
 
     return Status::OK();
 }
 
 Status
-OngoingFileChecker::UnmarkOngoingFileNoLock(const meta::TableFileSchema& table_file) {
-    if (table_file.table_id_.empty() || table_file.file_id_.empty()) {
-        return Status(DB_ERROR, "Invalid table files");
+OngoingFileChecker::UnmarkOngoingFiles(const meta::TableFilesSchema& table_files) {
+    for (auto& table_file : table_files) {
+        UnmarkOngoingFile(table_file);
     }
 
-    auto iter = ongoing_files_.find(table_file.table_id_);
-    if (iter != ongoing_files_.end()) {
-        auto it_file = iter->second.find(table_file.file_id_);
-        if (it_file != iter->second.end()) {
-            it_file->second--;
+    return Status::OK();
+}
 
-            ENGINE_LOG_DEBUG << "Unmark ongoing file:" << table_file.file_id_ << " refcount:" << it_file->second;
+bool
+OngoingFileChecker::IsIgnored(const meta::TableFileSchema& schema) {
+    std::string key = FileKey(schema);
+    auto& shard = ShardFor(key);
 
-            if (it_file->second <= 0) {
-                iter->second.erase(table_file.file_id_);
-                if (iter->second.empty()) {
-                    ongoing_files_.erase(table_file.table_id_);
-                }
-            }
-        }
+    std::lock_guard<std::mutex> lck(shard.mutex_);
+    auto iter = shard.refs_.find(key);
+    if (iter == shard.refs_.end() || iter->second.count_ <= 0) {
+        return false;
     }
 
-    return Status::OK();
+    // the cleanup pass wanted this file gone but a reference is pinning it;
+    // remember that so the drain of the last reference re-schedules cleanup
+    // instead of the file waiting for the next reconcile pass
+    iter->second.retire_deferred_ = true;
+    return true;
 }
 
 }  // namespace engine
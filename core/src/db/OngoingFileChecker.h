@@ -15,16 +15,29 @@
 #include "meta/Meta.h"
 #include "utils/Status.h"
 
+#include <functional>
 #include <map>
 #include <mutex>
-#include <set>
 #include <string>
 
 namespace milvus {
 namespace engine {
 
+// The checker sits on two hot paths at once: every task load marks/unmarks
+// its files, and the cleanup pass consults IsIgnored for every deletion
+// candidate. The ref-counts are sharded by file key so that concurrent tasks
+// and the cleanup pass only contend when they touch the same shard, instead
+// of serializing on one global mutex.
 class OngoingFileChecker : public meta::Meta::CleanUpFilter {
  public:
+    // invoked with the table id when the last reference to a file the cleanup
+    // pass already tried to delete drains away, so the owner can schedule the
+    // next cleanup promptly instead of waiting for the reconcile interval
+    using DrainCallback = std::function<void(const std::string& table_id)>;
+
+    void
+    SetDrainCallback(DrainCallback callback);
+
     Status
     MarkOngoingFile(const meta::TableFileSchema& table_file);
 
@@ -41,15 +54,28 @@ class OngoingFileChecker : public meta::Meta::CleanUpFilter {
     IsIgnored(const meta::TableFileSchema& schema) override;
 
  private:
-    Status
-    MarkOngoingFileNoLock(const meta::TableFileSchema& table_file);
+    static constexpr size_t SHARD_COUNT = 16;
 
-    Status
-    UnmarkOngoingFileNoLock(const meta::TableFileSchema& table_file);
+    struct Ref {
+        int64_t count_ = 0;
+        // set when IsIgnored deferred a deletion because of this reference, so
+        // the drain of the last holder can re-trigger the cleanup
+        bool retire_deferred_ = false;
+    };
 
- private:
-    std::mutex mutex_;
-    Table2FileRef ongoing_files_;  // table id mapping to (file id mapping to ongoing ref-count)
+    struct Shard {
+        std::mutex mutex_;
+        std::map<std::string, Ref> refs_;  // "table_id/file_id" mapping to ongoing ref-count
+    };
+
+    static std::string
+    FileKey(const meta::TableFileSchema& table_file);
+
+    Shard&
+    ShardFor(const std::string& key);
+
+    Shard shards_[SHARD_COUNT];
+    DrainCallback drain_callback_;
 };
 
 }  // namespace engine
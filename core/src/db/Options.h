@@ -57,7 +57,21 @@ struct ArchiveConf {
 struct DBMetaOptions {
     std::string path_;
     std::vector<std::string> slave_paths_;
+
+    // device class per data path, parsed from the optional ":hot"/":cold"
+    // suffix on storage_config.secondary_path entries. Untagged paths (the
+    // primary path is always untagged) form a default class that accepts
+    // files of any age.
+    std::map<std::string, std::string> path_device_class_;
+
     std::string backend_uri_;
+
+    // optional MySQL read replicas for the meta read path; mutations always
+    // go to backend_uri_. A replica is taken out of rotation while its
+    // replication lag exceeds replica_max_lag_seconds_.
+    std::vector<std::string> replica_uris_;
+    int64_t replica_max_lag_seconds_ = 60;
+
     ArchiveConf archive_conf_ = ArchiveConf("delete");
 };  // DBMetaOptions
 
@@ -65,11 +79,17 @@ struct DBOptions {
     typedef enum { SINGLE = 0, CLUSTER_READONLY, CLUSTER_WRITABLE } MODE;
 
     uint16_t merge_trigger_number_ = 2;
+    int64_t merge_concurrency_ = 1;  // concurrent merge workers; also the disk bandwidth knob
     DBMetaOptions meta_;
     int mode_ = MODE::SINGLE;
 
     size_t insert_buffer_size_ = 4 * ONE_GB;
     bool insert_cache_immediately_ = false;
+    bool wal_enable_ = false;
+
+    // encode large flushed segments straight into the table's index format
+    // when a trained quantizer is available, skipping the RAW intermediate
+    bool build_index_on_flush_ = false;
 };  // Options
 
 }  // namespace engine
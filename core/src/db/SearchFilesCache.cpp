@@ -0,0 +1,96 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/SearchFilesCache.h"
+#include "utils/Log.h"
+#include "utils/StringHelpFunctions.h"
+
+#include <algorithm>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+// generous bound; mainly guards against unbounded growth across date
+// rollovers, since old-date keys are never queried again
+constexpr size_t MAX_ENTRIES = 256;
+}  // namespace
+
+std::string
+SearchFilesCache::MakeKey(const std::string& table_id, const std::vector<std::string>& partition_tags,
+                          const meta::DatesT& dates) {
+    std::string key = table_id + "|";
+    std::vector<std::string> tags = partition_tags;
+    for (auto& tag : tags) {
+        server::StringHelpFunctions::TrimStringBlank(tag);
+    }
+    std::sort(tags.begin(), tags.end());
+    for (auto& tag : tags) {
+        key += tag + ",";
+    }
+    key += "|";
+    for (auto date : dates) {
+        key += std::to_string(date) + ",";
+    }
+    return key;
+}
+
+bool
+SearchFilesCache::Get(const std::string& key, meta::TableFilesSchema& files) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(key);
+    if (iter == entries_.end()) {
+        return false;
+    }
+
+    files = iter->second;
+    return true;
+}
+
+void
+SearchFilesCache::Put(const std::string& key, const std::set<std::string>& depend_tables,
+                      const meta::TableFilesSchema& files) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= MAX_ENTRIES) {
+        entries_.clear();
+        table_entries_.clear();
+    }
+
+    entries_[key] = files;
+    for (auto& table_id : depend_tables) {
+        table_entries_[table_id].insert(key);
+    }
+}
+
+void
+SearchFilesCache::Invalidate(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = table_entries_.find(table_id);
+    if (iter == table_entries_.end()) {
+        return;
+    }
+
+    ENGINE_LOG_DEBUG << "Invalidate " << iter->second.size() << " cached file list(s) of table " << table_id;
+    for (auto& key : iter->second) {
+        entries_.erase(key);
+    }
+    table_entries_.erase(iter);
+}
+
+void
+SearchFilesCache::InvalidateAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    table_entries_.clear();
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,55 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/meta/MetaTypes.h"
+
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// In-process cache of the assembled files-to-search list per
+// (table, partition tags, dates) query signature, so steady-state queries
+// skip the meta database entirely. Entries record every table they were
+// assembled from; DBImpl invalidates those tables on flush, merge, index
+// build, partition and drop events.
+class SearchFilesCache {
+ public:
+    static std::string
+    MakeKey(const std::string& table_id, const std::vector<std::string>& partition_tags, const meta::DatesT& dates);
+
+    bool
+    Get(const std::string& key, meta::TableFilesSchema& files);
+
+    void
+    Put(const std::string& key, const std::set<std::string>& depend_tables, const meta::TableFilesSchema& files);
+
+    void
+    Invalidate(const std::string& table_id);
+
+    void
+    InvalidateAll();
+
+ private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, meta::TableFilesSchema> entries_;
+    // table id -> keys of the entries assembled from that table's files
+    std::unordered_map<std::string, std::set<std::string>> table_entries_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,113 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/SegmentSizeTuner.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "db/Constants.h"
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+constexpr double DECAY_HALF_LIFE_SECONDS = 600.0;
+
+// below this much decayed traffic the table's read/write mix is noise; keep
+// the configured size until a workload shows itself
+constexpr double MIN_TRAFFIC = 100.0;
+
+// adjustment range around the configured index_file_size_: a pure write
+// workload merges at a quarter of it, a pure read workload at four times
+constexpr double MIN_SCALE = 0.25;
+constexpr double MAX_SCALE = 4.0;
+
+// never target a segment whose index build would exceed this, based on the
+// table's observed build throughput
+constexpr double MAX_BUILD_SECONDS = 600.0;
+
+}  // namespace
+
+SegmentSizeTuner&
+SegmentSizeTuner::GetInstance() {
+    static SegmentSizeTuner instance;
+    return instance;
+}
+
+SegmentSizeTuner::TableStats&
+SegmentSizeTuner::DecayedStats(const std::string& table_id) {
+    auto now = std::chrono::steady_clock::now();
+    auto& stats = stats_[table_id];
+    if (stats.last_decay.time_since_epoch().count() != 0) {
+        double elapsed = std::chrono::duration<double>(now - stats.last_decay).count();
+        double factor = std::pow(0.5, elapsed / DECAY_HALF_LIFE_SECONDS);
+        stats.query_count *= factor;
+        stats.insert_count *= factor;
+        stats.build_bytes *= factor;
+        stats.build_seconds *= factor;
+    }
+    stats.last_decay = now;
+    return stats;
+}
+
+void
+SegmentSizeTuner::RecordQuery(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DecayedStats(table_id).query_count += 1.0;
+}
+
+void
+SegmentSizeTuner::RecordInsert(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DecayedStats(table_id).insert_count += 1.0;
+}
+
+void
+SegmentSizeTuner::RecordBuild(const std::string& table_id, double bytes, double seconds) {
+    if (bytes <= 0.0 || seconds <= 0.0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& stats = DecayedStats(table_id);
+    stats.build_bytes += bytes;
+    stats.build_seconds += seconds;
+}
+
+int64_t
+SegmentSizeTuner::TargetSize(const std::string& table_id, int64_t configured_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& stats = DecayedStats(table_id);
+
+    double scale = 1.0;
+    double traffic = stats.query_count + stats.insert_count;
+    if (traffic >= MIN_TRAFFIC) {
+        // log-linear between the extremes: scale 1.0 sits at a balanced mix
+        double read_ratio = stats.query_count / traffic;
+        scale = MIN_SCALE * std::pow(MAX_SCALE / MIN_SCALE, read_ratio);
+    }
+
+    auto target = static_cast<int64_t>(configured_size * scale);
+
+    if (stats.build_seconds > 1.0 && stats.build_bytes > 0.0) {
+        auto build_cap = static_cast<int64_t>(stats.build_bytes / stats.build_seconds * MAX_BUILD_SECONDS);
+        target = std::min(target, build_cap);
+    }
+
+    auto lower = static_cast<int64_t>(configured_size * MIN_SCALE);
+    auto upper = static_cast<int64_t>(configured_size * MAX_SCALE);
+    target = std::min(std::max(target, lower), upper);
+    return std::max(target, static_cast<int64_t>(ONE_MB));
+}
+
+}  // namespace engine
+}  // namespace milvus
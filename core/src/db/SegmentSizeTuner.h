@@ -0,0 +1,69 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace milvus {
+namespace engine {
+
+// Per-table traffic statistics that turn the static index_file_size_ into an
+// adaptive merge target. Read-mostly hot tables are merged toward larger
+// segments (fewer search tasks per query), write-hot tables stay
+// fine-grained (cheap frequent merges, bounded build latency), and observed
+// index build throughput caps the target so one build never runs for hours.
+// Counters decay exponentially, like the cache access tracker, so the policy
+// follows traffic shifts instead of lifetime totals.
+class SegmentSizeTuner {
+ public:
+    static SegmentSizeTuner&
+    GetInstance();
+
+    void
+    RecordQuery(const std::string& table_id);
+
+    void
+    RecordInsert(const std::string& table_id);
+
+    // one finished index build: input bytes and wall seconds
+    void
+    RecordBuild(const std::string& table_id, double bytes, double seconds);
+
+    // adaptive merge target in bytes; `configured_size` is the table's
+    // index_file_size_ and also anchors the [1/4, 4x] adjustment range
+    int64_t
+    TargetSize(const std::string& table_id, int64_t configured_size);
+
+ private:
+    SegmentSizeTuner() = default;
+
+    struct TableStats {
+        double query_count = 0.0;
+        double insert_count = 0.0;
+        double build_bytes = 0.0;
+        double build_seconds = 0.0;
+        std::chrono::steady_clock::time_point last_decay;
+    };
+
+    TableStats&
+    DecayedStats(const std::string& table_id);  // caller holds mutex_
+
+ private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, TableStats> stats_;
+};
+
+}  // namespace engine
+}  // namespace milvus
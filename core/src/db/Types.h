@@ -15,7 +15,9 @@
 
 #include <faiss/Index.h>
 #include <stdint.h>
+#include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -30,6 +32,39 @@ typedef std::vector<IDNumber> IDNumbers;
 
 typedef std::vector<faiss::Index::idx_t> ResultIds;
 typedef std::vector<faiss::Index::distance_t> ResultDistances;
+// prefix-sum boundaries of a variable-length (range search) result set:
+// matches for query i are ids[lims[i]:lims[i+1]], lims has nq+1 entries
+typedef std::vector<size_t> ResultLims;
+
+// Invoked after each index file finishes during a streaming query, with the top-k
+// merged over the files searched so far. Called on a scheduler thread while the
+// query is still running; the buffers are only valid for the duration of the call.
+using SearchStreamCallback = std::function<void(uint64_t searched_files, uint64_t total_files, const ResultIds& ids,
+                                                const ResultDistances& distances)>;
+
+// Invoked with consecutive slabs of raw vectors (and their ids) during a table
+// export. The buffers are only valid for the duration of the call. Returning
+// false cancels the rest of the export.
+using ExportChunkCallback = std::function<bool(int64_t count, const float* vectors, const int64_t* ids)>;
+
+// per-vector scalar attributes, keyed by column name; each column holds one
+// value per row in insertion order, the empty string meaning "no value"
+using AttributeColumns = std::map<std::string, std::vector<std::string>>;
+
+// Conjunction of per-column predicates applied to search results: a row
+// matches when, for every column listed, its value is one of the accepted
+// values. Rows missing a listed column (or a whole segment written before the
+// column existed) do not match.
+struct AttributeFilter {
+    std::map<std::string, std::set<std::string>> conditions_;
+
+    bool
+    Empty() const {
+        return conditions_.empty();
+    }
+};
+
+using AttributeFilterPtr = std::shared_ptr<AttributeFilter>;
 
 struct TableIndex {
     int32_t engine_type_ = (int)EngineType::FAISS_IDMAP;
@@ -42,6 +77,38 @@ struct VectorsData {
     std::vector<float> float_data_;
     std::vector<uint8_t> binary_data_;
     IDNumbers id_array_;
+
+    // optional scalar payloads, one value per vector; flushed into the
+    // segment's attribute sidecar for filtered search
+    AttributeColumns attributes_;
+
+    // Non-owning view of caller-owned query memory (e.g. the protobuf request buffer).
+    // When set it takes precedence over the owning vectors; the owner of the view memory
+    // must keep it alive until the request finishes.
+    const float* float_view_ = nullptr;
+    uint64_t float_view_size_ = 0;
+    const uint8_t* binary_view_ = nullptr;
+    uint64_t binary_view_size_ = 0;
+
+    const float*
+    FloatData() const {
+        return float_view_ != nullptr ? float_view_ : float_data_.data();
+    }
+
+    uint64_t
+    FloatDataSize() const {
+        return float_view_ != nullptr ? float_view_size_ : float_data_.size();
+    }
+
+    const uint8_t*
+    BinaryData() const {
+        return binary_view_ != nullptr ? binary_view_ : binary_data_.data();
+    }
+
+    uint64_t
+    BinaryDataSize() const {
+        return binary_view_ != nullptr ? binary_view_size_ : binary_data_.size();
+    }
 };
 
 using File2ErrArray = std::map<std::string, std::vector<std::string>>;
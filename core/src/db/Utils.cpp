@@ -40,10 +40,52 @@ ConstructParentFolder(const std::string& db_path, const meta::TableFileSchema& t
     return partition_path;
 }
 
+static std::vector<std::string>
+AllDataPaths(const DBMetaOptions& options) {
+    std::vector<std::string> paths;
+    paths.push_back(options.path_);
+    for (auto& path : options.slave_paths_) {
+        paths.push_back(path);
+    }
+    return paths;
+}
+
+// data paths a file of this partition may be written to. With tiering enabled,
+// hot partitions land on hot-tagged or untagged paths, cold ones on
+// cold-tagged or untagged paths; without it every path is a candidate.
+static std::vector<std::string>
+TierCandidatePaths(const DBMetaOptions& options, meta::DateT date) {
+    std::vector<std::string> all_paths = AllDataPaths(options);
+    if (options.path_device_class_.empty()) {
+        return all_paths;
+    }
+
+    int64_t hot_days = 0;
+    server::Config& config = server::Config::GetInstance();
+    config.GetStorageConfigHotTierDays(hot_days);
+    if (hot_days <= 0) {
+        return all_paths;
+    }
+
+    const char* wanted = IsPartitionHot(date, hot_days) ? TIER_DEVICE_CLASS_HOT : TIER_DEVICE_CLASS_COLD;
+    std::vector<std::string> candidates;
+    for (auto& path : all_paths) {
+        auto iter = options.path_device_class_.find(path);
+        if (iter == options.path_device_class_.end() || iter->second == wanted) {
+            candidates.push_back(path);
+        }
+    }
+
+    if (candidates.empty()) {
+        return all_paths;
+    }
+    return candidates;
+}
+
 static std::string
 GetTableFileParentFolder(const DBMetaOptions& options, const meta::TableFileSchema& table_file) {
-    uint64_t path_count = options.slave_paths_.size() + 1;
-    std::string target_path = options.path_;
+    std::vector<std::string> candidate_paths = TierCandidatePaths(options, table_file.date_);
+    uint64_t path_count = candidate_paths.size();
     uint64_t index = 0;
 
     if (meta::TableFileSchema::NEW_INDEX == table_file.file_type_) {
@@ -59,11 +101,7 @@ GetTableFileParentFolder(const DBMetaOptions& options, const meta::TableFileSche
         index = table_file.id_ % path_count;
     }
 
-    if (index > 0) {
-        target_path = options.slave_paths_[index - 1];
-    }
-
-    return ConstructParentFolder(target_path, table_file);
+    return ConstructParentFolder(candidate_paths[index], table_file);
 }
 
 }  // namespace
@@ -189,6 +227,89 @@ Status
 DeleteTableFilePath(const DBMetaOptions& options, meta::TableFileSchema& table_file) {
     utils::GetTableFilePath(options, table_file);
     boost::filesystem::remove(table_file.location_);
+    // sidecar files live next to the segment and die with it
+    boost::filesystem::remove(table_file.location_ + ".attr");
+    boost::filesystem::remove(table_file.location_ + ".del");
+    return Status::OK();
+}
+
+bool
+IsPartitionHot(meta::DateT date, int64_t hot_days) {
+    if (hot_days <= 0) {
+        return true;
+    }
+    // DateT encodes year*10000 + month*100 + day, so the encoding is ordered
+    return date >= GetDateWithDelta(-static_cast<int>(hot_days));
+}
+
+Status
+MigrateTableFileToCold(const DBMetaOptions& options, meta::TableFileSchema& table_file, bool& migrated) {
+    migrated = false;
+
+    // locate the file and the data path it currently lives under
+    std::string src_root;
+    std::string src_path;
+    std::vector<std::string> paths = options.slave_paths_;
+    paths.insert(paths.begin(), options.path_);
+    for (auto& path : paths) {
+        std::string file_path = ConstructParentFolder(path, table_file) + "/" + table_file.file_id_;
+        if (boost::filesystem::exists(file_path)) {
+            src_root = path;
+            src_path = file_path;
+            break;
+        }
+    }
+    if (src_root.empty()) {
+        return Status(DB_ERROR, "Table file doesn't exist: " + table_file.file_id_);
+    }
+
+    auto src_class = options.path_device_class_.find(src_root);
+    if (src_class == options.path_device_class_.end() || src_class->second != TIER_DEVICE_CLASS_HOT) {
+        return Status::OK();  // already on a cold or default-class path
+    }
+
+    // prefer a cold-tagged target, fall back to an untagged one
+    std::string target_root;
+    for (auto& path : paths) {
+        auto iter = options.path_device_class_.find(path);
+        if (iter != options.path_device_class_.end() && iter->second == TIER_DEVICE_CLASS_COLD) {
+            target_root = path;
+            break;
+        }
+        if (iter == options.path_device_class_.end() && target_root.empty()) {
+            target_root = path;
+        }
+    }
+    if (target_root.empty() || target_root == src_root) {
+        return Status::OK();
+    }
+
+    std::string target_parent = ConstructParentFolder(target_root, table_file);
+    auto status = server::CommonUtil::CreateDirectory(target_parent);
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << status.message();
+        return status;
+    }
+
+    // copy to a temp name, then rename into place before the source goes away,
+    // so the path probe in GetTableFilePath always finds a complete copy
+    std::string target_path = target_parent + "/" + table_file.file_id_;
+    boost::system::error_code ec;
+    boost::filesystem::copy_file(src_path, target_path + ".tmp",
+                                 boost::filesystem::copy_option::overwrite_if_exists, ec);
+    if (!ec) {
+        boost::filesystem::rename(target_path + ".tmp", target_path, ec);
+    }
+    if (ec) {
+        boost::filesystem::remove(target_path + ".tmp");
+        return Status(DB_ERROR, "Failed to migrate table file " + src_path + ": " + ec.message());
+    }
+    boost::filesystem::remove(src_path);
+
+    table_file.location_ = target_path;
+    migrated = true;
+    ENGINE_LOG_DEBUG << "Migrated cold table file " << src_path << " to " << target_path;
+
     return Status::OK();
 }
 
@@ -198,6 +319,12 @@ IsSameIndex(const TableIndex& index1, const TableIndex& index2) {
            index1.metric_type_ == index2.metric_type_;
 }
 
+bool
+IsRawIndexType(int32_t type) {
+    return type == (int32_t)EngineType::FAISS_IDMAP || type == (int32_t)EngineType::FAISS_BIN_IDMAP ||
+           type == (int32_t)EngineType::FAISS_IDMAP_SQ8 || type == (int32_t)EngineType::FAISS_IDMAP_FP16;
+}
+
 meta::DateT
 GetDate(const std::time_t& t, int day_delta) {
     struct tm ltm;
@@ -22,6 +22,10 @@ namespace milvus {
 namespace engine {
 namespace utils {
 
+// device-class tags accepted on storage_config.secondary_path entries
+static const char* TIER_DEVICE_CLASS_HOT = "hot";
+static const char* TIER_DEVICE_CLASS_COLD = "cold";
+
 int64_t
 GetMicroSecTimeStamp();
 
@@ -37,9 +41,22 @@ GetTableFilePath(const DBMetaOptions& options, meta::TableFileSchema& table_file
 Status
 DeleteTableFilePath(const DBMetaOptions& options, meta::TableFileSchema& table_file);
 
+// a partition is hot while its date is within hot_days of today
+bool
+IsPartitionHot(meta::DateT date, int64_t hot_days);
+
+// move a cold file off a hot-tagged path onto a cold/untagged one; no-op (with
+// migrated=false) when the file already lives on an acceptable tier
+Status
+MigrateTableFileToCold(const DBMetaOptions& options, meta::TableFileSchema& table_file, bool& migrated);
+
 bool
 IsSameIndex(const TableIndex& index1, const TableIndex& index2);
 
+// brute-force engines whose files stay RAW and never go through index build
+bool
+IsRawIndexType(int32_t type);
+
 meta::DateT
 GetDate(const std::time_t& t, int day_delta = 0);
 meta::DateT
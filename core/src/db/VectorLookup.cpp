@@ -0,0 +1,74 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/VectorLookup.h"
+#include "wrapper/VecIndex.h"
+
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+VectorLookup&
+VectorLookup::GetInstance() {
+    static VectorLookup instance;
+    return instance;
+}
+
+Status
+VectorLookup::LocateIds(const std::string& location, const IDNumbers& ids, std::vector<int64_t>& offsets) {
+    OffsetMapPtr table;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = segments_.find(location);
+        if (iter != segments_.end()) {
+            table = iter->second;
+        }
+    }
+
+    if (table == nullptr) {
+        std::vector<int64_t> segment_ids;
+        auto status = read_raw_ids(location, segment_ids);
+        if (!status.ok()) {
+            return status;
+        }
+        auto built = std::make_shared<OffsetMap>();
+        built->reserve(segment_ids.size());
+        for (size_t row = 0; row < segment_ids.size(); row++) {
+            // a duplicated id keeps its last row, matching which copy the
+            // engine scan reports
+            (*built)[segment_ids[row]] = static_cast<int64_t>(row);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& slot = segments_[location];
+        if (slot == nullptr) {
+            slot = built;
+        }
+        table = slot;
+    }
+
+    offsets.clear();
+    offsets.reserve(ids.size());
+    for (auto id : ids) {
+        auto iter = table->find(id);
+        offsets.push_back(iter == table->end() ? -1 : iter->second);
+    }
+    return Status::OK();
+}
+
+void
+VectorLookup::Evict(const std::string& location) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    segments_.erase(location);
+}
+
+}  // namespace engine
+}  // namespace milvus
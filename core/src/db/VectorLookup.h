@@ -0,0 +1,54 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Types.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// Per-segment id -> row-offset tables backing GetVectorsByID. The id slab a
+// raw segment persists at flush already stores the ids in row order, so the
+// hash is built from it on first use and cached; segments are immutable, so
+// entries only leave the cache through Evict.
+class VectorLookup {
+ public:
+    static VectorLookup&
+    GetInstance();
+
+    // row offset of each id within the segment, -1 when the id is absent;
+    // fails for segments without a streamable raw layout
+    Status
+    LocateIds(const std::string& location, const IDNumbers& ids, std::vector<int64_t>& offsets);
+
+    // drops the cached table of a merged-away or deleted segment
+    void
+    Evict(const std::string& location);
+
+ private:
+    VectorLookup() = default;
+
+    using OffsetMap = std::unordered_map<IDNumber, int64_t>;
+    using OffsetMapPtr = std::shared_ptr<OffsetMap>;
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, OffsetMapPtr> segments_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,160 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/engine/EngineHandleCache.h"
+#include "cache/CpuCacheMgr.h"
+#include "db/engine/EngineFactory.h"
+#include "utils/Log.h"
+
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+constexpr size_t EngineHandleCache::PER_FILE_CAP;
+constexpr size_t EngineHandleCache::GLOBAL_CAP;
+constexpr size_t EngineHandleCache::WARM_SET_CAP;
+constexpr double EngineHandleCache::WARM_ADMIT_FREQUENCY;
+constexpr double EngineHandleCache::WARM_DEMOTE_FREQUENCY;
+
+EngineHandleCache&
+EngineHandleCache::GetInstance() {
+    static EngineHandleCache instance;
+    return instance;
+}
+
+ExecutionEnginePtr
+EngineHandleCache::Acquire(size_t file_id, uint16_t dimension, const std::string& location, EngineType engine_type,
+                           MetricType metric_type, int32_t nlist) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto warm_iter = warm_.find(file_id);
+        if (warm_iter != warm_.end() && warm_iter->second.engine != nullptr) {
+            auto engine = std::move(warm_iter->second.engine);
+            warm_iter->second.engine = nullptr;
+            // the warm path skips the cache lookup that normally records the
+            // access, so feed the frequency signal here or the segment would
+            // look cold and demote itself
+            cache::CpuCacheMgr::GetInstance()->RecordAccess(location);
+            return engine;
+        }
+
+        auto iter = idle_.find(file_id);
+        if (iter != idle_.end() && !iter->second.empty()) {
+            auto engine = iter->second.back();
+            iter->second.pop_back();
+            --total_idle_;
+            return engine;
+        }
+    }
+
+    // file ids are never reused, so a pooled handle always matches the
+    // parameters it was built with; only a miss pays the construction cost
+    return EngineFactory::Build(dimension, location, engine_type, metric_type, nlist);
+}
+
+std::pair<double, size_t>
+EngineHandleCache::SweepWarm() {
+    auto cache_mgr = cache::CpuCacheMgr::GetInstance();
+    double coldest_freq = 0.0;
+    size_t coldest_id = 0;
+    bool found = false;
+    for (auto iter = warm_.begin(); iter != warm_.end();) {
+        auto freq = cache_mgr->AccessFrequency(iter->second.location);
+        if (freq < WARM_DEMOTE_FREQUENCY) {
+            // cooled off or replaced by merge: unpin so the index follows the
+            // ordinary cache lifetime again. A checked-out handle is demoted
+            // on its way back through Release.
+            ENGINE_LOG_DEBUG << "Demote warm engine for segment " << iter->second.location;
+            if (iter->second.engine != nullptr) {
+                iter->second.engine->SetWarm(false);
+            }
+            iter = warm_.erase(iter);
+            continue;
+        }
+        if (!found || freq < coldest_freq) {
+            coldest_freq = freq;
+            coldest_id = iter->first;
+            found = true;
+        }
+        ++iter;
+    }
+    return {coldest_freq, coldest_id};
+}
+
+void
+EngineHandleCache::Release(size_t file_id, ExecutionEnginePtr engine) {
+    if (engine == nullptr) {
+        return;
+    }
+
+    auto frequency = cache::CpuCacheMgr::GetInstance()->AccessFrequency(engine->GetLocation());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto warm_iter = warm_.find(file_id);
+    if (warm_iter != warm_.end()) {
+        // still a member: park the handle back in its warm slot
+        warm_iter->second.engine = std::move(engine);
+        return;
+    }
+
+    if (frequency >= WARM_ADMIT_FREQUENCY) {
+        auto coldest = SweepWarm();
+        bool admit = warm_.size() < WARM_SET_CAP;
+        if (!admit && frequency > coldest.first) {
+            // hotter than the coldest member: take its slot. Its checked-out
+            // or parked handle is demoted above or on its next Release.
+            auto victim = warm_.find(coldest.second);
+            if (victim != warm_.end()) {
+                if (victim->second.engine != nullptr) {
+                    victim->second.engine->SetWarm(false);
+                }
+                warm_.erase(victim);
+            }
+            admit = true;
+        }
+        if (admit) {
+            ENGINE_LOG_DEBUG << "Promote warm engine for segment " << engine->GetLocation();
+            engine->SetWarm(true);
+            warm_[file_id] = WarmEntry{engine->GetLocation(), std::move(engine)};
+            return;
+        }
+    }
+
+    // not (or no longer) warm: make sure a demoted handle behaves like an
+    // ordinary pooled one before it re-enters the idle pool
+    engine->SetWarm(false);
+
+    auto& pool = idle_[file_id];
+    if (pool.size() >= PER_FILE_CAP) {
+        return;  // enough spares for this file; drop the handle
+    }
+
+    // bound the total footprint: evict the oldest pooled handle, skipping
+    // fifo entries whose pool has already been drained by Acquire
+    while (total_idle_ >= GLOBAL_CAP && !fifo_.empty()) {
+        auto victim_id = fifo_.front();
+        fifo_.pop_front();
+        auto victim = idle_.find(victim_id);
+        if (victim != idle_.end() && !victim->second.empty()) {
+            victim->second.erase(victim->second.begin());
+            --total_idle_;
+        }
+    }
+
+    pool.push_back(std::move(engine));
+    fifo_.push_back(file_id);
+    ++total_idle_;
+}
+
+}  // namespace engine
+}  // namespace milvus
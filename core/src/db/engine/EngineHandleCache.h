@@ -0,0 +1,92 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ExecutionEngine.h"
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Pool of initialized engine handles keyed by table file id. Building a
+ * fresh ExecutionEngine wrapper for every search task re-runs config
+ * adapter and index shell setup thousands of times per second even when
+ * the underlying index is cached; reusing the handle makes steady-state
+ * queries do zero engine setup work.
+ *
+ * The engine is stateful (Load and CopyToGpu mutate it), so Acquire hands
+ * out exclusive ownership and Release returns the handle for the next
+ * query. Handles of deleted segments age out through the FIFO cap, which
+ * mirrors how the data caches retain an index until eviction.
+ *
+ * On top of the idle pool sits a small warm-standby tier for the hottest
+ * segments, ranked by the same decayed access frequency the cpu cache uses
+ * for admission. A warm engine keeps its loaded index resident and its
+ * Load() is a no-op, so a hot-segment query binds to a search-ready engine
+ * with zero setup. Membership is re-evaluated on every Release: cooled-off
+ * or replaced segments decay out and the next-hottest takes the slot.
+ */
+class EngineHandleCache {
+ public:
+    static EngineHandleCache&
+    GetInstance();
+
+    // reuse an idle handle for the file or build a new one
+    ExecutionEnginePtr
+    Acquire(size_t file_id, uint16_t dimension, const std::string& location, EngineType engine_type,
+            MetricType metric_type, int32_t nlist);
+
+    // hand the handle back once the task is done with it
+    void
+    Release(size_t file_id, ExecutionEnginePtr engine);
+
+ private:
+    EngineHandleCache() = default;
+
+ private:
+    static constexpr size_t PER_FILE_CAP = 4;
+    static constexpr size_t GLOBAL_CAP = 512;
+
+    // warm tier: at most this many segments, admitted once their decayed
+    // access frequency shows sustained re-use and demoted once it decays
+    // away (which also covers segments replaced by merge/compaction)
+    static constexpr size_t WARM_SET_CAP = 20;
+    static constexpr double WARM_ADMIT_FREQUENCY = 2.0;
+    static constexpr double WARM_DEMOTE_FREQUENCY = 1.0;
+
+    struct WarmEntry {
+        std::string location;
+        ExecutionEnginePtr engine;  // parked handle; null while checked out
+    };
+
+    // caller holds mutex_; demote entries whose frequency decayed away and
+    // return the coldest remaining (frequency, file_id)
+    std::pair<double, size_t>
+    SweepWarm();
+
+    std::mutex mutex_;
+    std::unordered_map<size_t, std::vector<ExecutionEnginePtr>> idle_;
+    size_t total_idle_ = 0;
+    std::deque<size_t> fifo_;  // file ids in release order, scanned for eviction
+    std::unordered_map<size_t, WarmEntry> warm_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -17,9 +17,20 @@
 
 #include "utils/Status.h"
 
+namespace faiss {
+struct IDSelector;
+}
+
+namespace knowhere {
+class CoarseAssignCache;
+}
+
 namespace milvus {
 namespace engine {
 
+class GpuSearchReducer;
+using GpuSearchReducerPtr = std::shared_ptr<GpuSearchReducer>;
+
 // TODO(linxj): replace with VecIndex::IndexType
 enum class EngineType {
     INVALID = 0,
@@ -34,18 +45,41 @@ enum class EngineType {
     FAISS_BIN_IDMAP,
     FAISS_BIN_IVFFLAT,
     HNSW,
-    MAX_VALUE = HNSW,
+    FAISS_IDMAP_SQ8,
+    FAISS_IDMAP_FP16,
+    FAISS_PQ_FS,
+    MAX_VALUE = FAISS_PQ_FS,
 };
 
 enum class MetricType {
-    L2 = 1,        // Euclidean Distance
-    IP = 2,        // Cosine Similarity
-    HAMMING = 3,   // Hamming Distance
-    JACCARD = 4,   // Jaccard Distance
-    TANIMOTO = 5,  // Tanimoto Distance
-    MAX_VALUE = TANIMOTO,
+    L2 = 1,              // Euclidean Distance
+    IP = 2,              // Cosine Similarity
+    HAMMING = 3,         // Hamming Distance
+    JACCARD = 4,         // Jaccard Distance
+    TANIMOTO = 5,        // Tanimoto Distance
+    SUBSTRUCTURE = 6,    // Substructure Containment
+    SUPERSTRUCTURE = 7,  // Superstructure Containment
+    MAX_VALUE = SUPERSTRUCTURE,
 };
 
+/*
+ * Optional dimension padding (engine_config.dim_padding): float rows are
+ * stored at a stride rounded up to a multiple of 16 values, so every row
+ * starts SIMD-aligned and faiss stays on its fast kernels for odd dimensions.
+ * The tail is zero-filled, which changes neither L2 nor IP distances; the
+ * table schema keeps the logical dimension and clients never see the padding.
+ */
+
+// stride rows of a float table are stored at; equals `dimension` when padding
+// is disabled or the metric is binary
+int64_t
+PhysicalDimension(int64_t dimension, MetricType metric_type);
+
+// copy `n` rows from stride `src_dim` to stride `dst_dim` into `out`,
+// zero-filling grown tails and dropping shrunk ones
+void
+RestrideRows(int64_t n, int64_t src_dim, int64_t dst_dim, const float* src, std::vector<float>& out);
+
 class ExecutionEngine {
  public:
     virtual Status
@@ -72,6 +106,13 @@ class ExecutionEngine {
     virtual Status
     Load(bool to_cache = true) = 0;
 
+    // Fused cold-load for GPU-routed segments: deserialize the index and clone it
+    // straight to the target device. The transient host copy is never inserted
+    // into the cpu cache and is freed before returning, so a later CopyToGpu on
+    // the same location is a gpu-cache hit. Falls back to Load() on CPU builds.
+    virtual Status
+    LoadToGpu(uint64_t device_id, bool to_cache = true) = 0;
+
     virtual Status
     CopyToGpu(uint64_t device_id, bool hybrid) = 0;
 
@@ -87,16 +128,46 @@ class ExecutionEngine {
     virtual Status
     Merge(const std::string& location) = 0;
 
+    // deleted_sel is an optional id mask (deletion bitmap or attribute
+    // predicate match set) pushed down into the faiss scan; filtered ids
+    // never enter the topk heap, so no over-fetch is needed. The
+    // selector is not owned and must outlive the call. Supported by the IVF
+    // engine family; other engines ignore it.
+    // assign_cache optionally shares query→centroid rankings across the
+    // segments of one search job (see knowhere::CoarseAssignCache); also IVF
+    // only, not owned, may be null
     virtual Status
-    Search(int64_t n, const float* data, int64_t k, int64_t nprobe, float* distances, int64_t* labels, bool hybrid) = 0;
+    Search(int64_t n, const float* data, int64_t k, int64_t nprobe, float* distances, int64_t* labels, bool hybrid,
+           const faiss::IDSelector* deleted_sel = nullptr, knowhere::CoarseAssignCache* assign_cache = nullptr) = 0;
 
     virtual Status
     Search(int64_t n, const uint8_t* data, int64_t k, int64_t nprobe, float* distances, int64_t* labels,
            bool hybrid) = 0;
 
+    // GPU-resident search for multi-segment reduction: the topk is written
+    // into a device slot acquired from `reducer` and merged on the device
+    // later, so per-segment results never cross PCIe. Fails (and the caller
+    // falls back to the host Search) unless the index is resident on the
+    // reducer's GPU.
+    virtual Status
+    SearchOnGpu(int64_t n, const float* data, int64_t k, int64_t nprobe, const GpuSearchReducerPtr& reducer) = 0;
+
+    // All neighbors within `radius` of each query; matches for query i are
+    // labels[lims[i]:lims[i+1]]. Supported by IDMAP and IVF based engines only.
+    virtual Status
+    RangeSearch(int64_t n, const float* data, float radius, int64_t nprobe, std::vector<int64_t>& labels,
+                std::vector<float>& distances, std::vector<size_t>& lims) = 0;
+
     virtual std::shared_ptr<ExecutionEngine>
     BuildIndex(const std::string& location, EngineType engine_type) = 0;
 
+    // Build an index at `location` reusing a previously trained model of the
+    // owning table, never training one. Returns nullptr when no usable model
+    // is available, so the caller can keep the segment raw and leave the
+    // build to the regular background pass.
+    virtual std::shared_ptr<ExecutionEngine>
+    BuildIndexFromModel(const std::string& location, EngineType engine_type) = 0;
+
     virtual Status
     Cache() = 0;
 
@@ -114,6 +185,16 @@ class ExecutionEngine {
 
     virtual std::string
     GetLocation() const = 0;
+
+    // Warm-standby flag, managed by the engine handle cache: a warm engine
+    // keeps its loaded index resident and Load() becomes a no-op, so queries
+    // against the hottest segments skip even the cache lookup. Safe because
+    // index files are immutable once written.
+    virtual void
+    SetWarm(bool warm) = 0;
+
+    virtual bool
+    Warm() const = 0;
 };
 
 using ExecutionEnginePtr = std::shared_ptr<ExecutionEngine>;
@@ -12,24 +12,35 @@
 #include "db/engine/ExecutionEngineImpl.h"
 
 #include <fiu-local.h>
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "cache/CpuCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
 #include "knowhere/common/Config.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "metrics/Metrics.h"
 #include "scheduler/Utils.h"
 #include "server/Config.h"
 #include "utils/CommonUtil.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
+#include "utils/Profiler.h"
 #include "utils/ValidationUtil.h"
 
+#ifdef MILVUS_GPU_VERSION
+#include "wrapper/gpu/GpuSearchReducer.h"
+#endif
+
 #include "wrapper/BinVecImpl.h"
 #include "wrapper/ConfAdapter.h"
 #include "wrapper/ConfAdapterMgr.h"
+#include "wrapper/TrainedModelMgr.h"
+#include "wrapper/TunedParamsMgr.h"
 #include "wrapper/VecImpl.h"
 #include "wrapper/VecIndex.h"
 
@@ -57,6 +68,12 @@ MappingMetricType(MetricType metric_type, knowhere::METRICTYPE& kw_type) {
         case MetricType::TANIMOTO:
             kw_type = knowhere::METRICTYPE::TANIMOTO;
             break;
+        case MetricType::SUBSTRUCTURE:
+            kw_type = knowhere::METRICTYPE::SUBSTRUCTURE;
+            break;
+        case MetricType::SUPERSTRUCTURE:
+            kw_type = knowhere::METRICTYPE::SUPERSTRUCTURE;
+            break;
         default:
             return Status(DB_ERROR, "Unsupported metric type");
     }
@@ -69,8 +86,37 @@ IsBinaryIndexType(IndexType type) {
     return type == IndexType::FAISS_BIN_IDMAP || type == IndexType::FAISS_BIN_IVFLAT_CPU;
 }
 
+// merge reads a source raw file in windows of this many bytes, so its memory
+// footprint stays flat no matter how large index_file_size lets files grow
+constexpr size_t RAW_MERGE_WINDOW_BYTES = 64 * 1024 * 1024;
+
+// rows padded to this many floats start on a 64-byte boundary
+constexpr int64_t DIM_PAD_STRIDE = 16;
+
 }  // namespace
 
+int64_t
+PhysicalDimension(int64_t dimension, MetricType metric_type) {
+    if (server::ValidationUtil::IsBinaryMetricType(static_cast<int32_t>(metric_type))) {
+        return dimension;
+    }
+    bool dim_padding = false;
+    server::Config::GetInstance().GetEngineConfigDimPadding(dim_padding);
+    if (!dim_padding) {
+        return dimension;
+    }
+    return ((dimension + DIM_PAD_STRIDE - 1) / DIM_PAD_STRIDE) * DIM_PAD_STRIDE;
+}
+
+void
+RestrideRows(int64_t n, int64_t src_dim, int64_t dst_dim, const float* src, std::vector<float>& out) {
+    out.assign(n * dst_dim, 0.0f);
+    const int64_t copy_dim = std::min(src_dim, dst_dim);
+    for (int64_t i = 0; i < n; i++) {
+        memcpy(out.data() + i * dst_dim, src + i * src_dim, copy_dim * sizeof(float));
+    }
+}
+
 class CachedQuantizer : public cache::DataObj {
  public:
     explicit CachedQuantizer(knowhere::QuantizerPtr data) : data_(std::move(data)) {
@@ -96,6 +142,13 @@ ExecutionEngineImpl::ExecutionEngineImpl(uint16_t dimension, const std::string&
     EngineType tmp_index_type = server::ValidationUtil::IsBinaryMetricType((int32_t)metric_type)
                                     ? EngineType::FAISS_BIN_IDMAP
                                     : EngineType::FAISS_IDMAP;
+    if (index_type == EngineType::FAISS_IDMAP_SQ8) {
+        // tables created with the SQ8 brute-force engine keep their fresh
+        // segments quantized as well
+        tmp_index_type = EngineType::FAISS_IDMAP_SQ8;
+    } else if (index_type == EngineType::FAISS_IDMAP_FP16) {
+        tmp_index_type = EngineType::FAISS_IDMAP_FP16;
+    }
     index_ = CreatetVecIndex(tmp_index_type);
     if (!index_) {
         throw Exception(DB_ERROR, "Unsupported index type");
@@ -103,7 +156,7 @@ ExecutionEngineImpl::ExecutionEngineImpl(uint16_t dimension, const std::string&
 
     TempMetaConf temp_conf;
     temp_conf.gpu_id = gpu_num_;
-    temp_conf.dim = dimension;
+    temp_conf.dim = PhysicalDimension(dimension, metric_type);
     auto status = MappingMetricType(metric_type, temp_conf.metric_type);
     if (!status.ok()) {
         throw Exception(DB_ERROR, status.message());
@@ -144,6 +197,14 @@ ExecutionEngineImpl::CreatetVecIndex(EngineType type) {
             index = GetVecIndexFactory(IndexType::FAISS_IDMAP);
             break;
         }
+        case EngineType::FAISS_IDMAP_SQ8: {
+            index = GetVecIndexFactory(IndexType::FAISS_IDMAP_SQ8);
+            break;
+        }
+        case EngineType::FAISS_IDMAP_FP16: {
+            index = GetVecIndexFactory(IndexType::FAISS_IDMAP_FP16);
+            break;
+        }
         case EngineType::FAISS_IVFFLAT: {
 #ifdef MILVUS_GPU_VERSION
             if (gpu_resource_enable)
@@ -187,6 +248,11 @@ ExecutionEngineImpl::CreatetVecIndex(EngineType type) {
                 index = GetVecIndexFactory(IndexType::FAISS_IVFPQ_CPU);
             break;
         }
+        case EngineType::FAISS_PQ_FS: {
+            // cpu-only: the 4-bit in-register scan has no gpu counterpart here
+            index = GetVecIndexFactory(IndexType::FAISS_IVFPQ_FS_CPU);
+            break;
+        }
         case EngineType::SPTAG_KDT: {
             index = GetVecIndexFactory(IndexType::SPTAG_KDT_RNT_CPU);
             break;
@@ -295,6 +361,63 @@ ExecutionEngineImpl::HybridUnset() const {
     index_->UnsetQuantizer();
 }
 
+void
+ExecutionEngineImpl::WarmQuantizer() const {
+    if (index_type_ != EngineType::FAISS_IVFSQ8H) {
+        return;
+    }
+    if (index_ == nullptr || index_->GetType() == IndexType::FAISS_IDMAP) {
+        return;
+    }
+
+#ifdef MILVUS_GPU_VERSION
+    const std::string key = location_ + ".quantizer";
+
+    server::Config& config = server::Config::GetInstance();
+    std::vector<int64_t> gpus;
+    Status s = config.GetGpuResourceConfigSearchResources(gpus);
+    if (!s.ok() || gpus.empty()) {
+        return;
+    }
+
+    // already resident on a search gpu
+    for (auto& gpu : gpus) {
+        if (cache::GpuCacheMgr::GetInstance(gpu)->GetIndex(key) != nullptr) {
+            return;
+        }
+    }
+
+    // same placement policy as the HybridLoad cache-miss path
+    std::vector<int64_t> all_free_mem;
+    for (auto& gpu : gpus) {
+        auto cache = cache::GpuCacheMgr::GetInstance(gpu);
+        all_free_mem.push_back(cache->CacheCapacity() - cache->CacheUsage());
+    }
+    auto max_e = std::max_element(all_free_mem.begin(), all_free_mem.end());
+    auto best_device_id = gpus[std::distance(all_free_mem.begin(), max_e)];
+
+    // upload off the loading thread; the shared_ptr keeps the segment alive and
+    // a concurrent HybridLoad() upload is harmless, the later cache insert wins
+    VecIndexPtr index = index_;
+    std::thread([index, key, best_device_id] {
+        try {
+            auto quantizer_conf = std::make_shared<knowhere::QuantizerCfg>();
+            quantizer_conf->mode = 1;
+            quantizer_conf->gpu_id = best_device_id;
+            auto quantizer = index->LoadQuantizer(quantizer_conf);
+            if (quantizer == nullptr) {
+                ENGINE_LOG_ERROR << "Quantizer warm-up failed: quantizer is nullptr";
+                return;
+            }
+            auto cache_quantizer = std::make_shared<CachedQuantizer>(quantizer);
+            cache::GpuCacheMgr::GetInstance(best_device_id)->InsertItem(key, cache_quantizer);
+        } catch (std::exception& e) {
+            ENGINE_LOG_ERROR << "Quantizer warm-up failed: " << e.what();
+        }
+    }).detach();
+#endif
+}
+
 Status
 ExecutionEngineImpl::AddWithIds(int64_t n, const float* xdata, const int64_t* xids) {
     auto status = index_->Add(n, xdata, xids);
@@ -307,9 +430,24 @@ ExecutionEngineImpl::AddWithIds(int64_t n, const uint8_t* xdata, const int64_t*
     return status;
 }
 
+const SegmentHeaderInfo&
+ExecutionEngineImpl::FileHeader() const {
+    if (!file_header_checked_) {
+        read_index_header(location_, file_header_);
+        file_header_checked_ = true;
+    }
+    return file_header_;
+}
+
 size_t
 ExecutionEngineImpl::Count() const {
     if (index_ == nullptr) {
+        // planning may ask before any load; the segment header answers from
+        // one small section instead of deserializing the whole file
+        auto& header = FileHeader();
+        if (header.row_count >= 0) {
+            return static_cast<size_t>(header.row_count);
+        }
         ENGINE_LOG_ERROR << "ExecutionEngineImpl: index is null, return count 0";
         return 0;
     }
@@ -328,6 +466,10 @@ ExecutionEngineImpl::Size() const {
 size_t
 ExecutionEngineImpl::Dimension() const {
     if (index_ == nullptr) {
+        auto& header = FileHeader();
+        if (header.dimension > 0) {
+            return static_cast<size_t>(header.dimension);
+        }
         ENGINE_LOG_ERROR << "ExecutionEngineImpl: index is null, return dimension " << dim_;
         return dim_;
     }
@@ -358,13 +500,33 @@ ExecutionEngineImpl::Serialize() {
 
 Status
 ExecutionEngineImpl::Load(bool to_cache) {
+    // warm standby: the index this handle already holds cannot go stale since
+    // index files are immutable once written, so skip even the cache lookup.
+    // The handle cache keeps the access-frequency signal alive via
+    // RecordAccess and demotes the engine once the segment cools off.
+    if (warm_ && index_ != nullptr) {
+        return Status::OK();
+    }
+
     index_ = std::static_pointer_cast<VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(location_));
     bool already_in_cache = (index_ != nullptr);
     if (!already_in_cache) {
         try {
             double physical_size = PhysicalSize();
             server::CollectExecutionEngineMetrics metrics(physical_size);
-            index_ = read_index(location_);
+
+            server::ProfilerRegion region("engine_load");
+            bool index_mmap_enable = false;
+            server::Config& config = server::Config::GetInstance();
+            config.GetEngineConfigIndexMmapEnable(index_mmap_enable);
+            if (index_mmap_enable) {
+                // map the file so its pages are loaded on demand and shared with
+                // the page cache, instead of copying the whole index onto the heap
+                index_ = read_index_mmap(location_);
+            }
+            if (index_ == nullptr) {
+                index_ = read_index(location_);
+            }
             if (index_ == nullptr) {
                 std::string msg = "Failed to load index from " + location_;
                 ENGINE_LOG_ERROR << msg;
@@ -381,9 +543,53 @@ ExecutionEngineImpl::Load(bool to_cache) {
     if (!already_in_cache && to_cache) {
         Cache();
     }
+
+    // re-check hybrid quantizer residency on every load, so a quantizer evicted from
+    // gpu cache is re-uploaded in the background before the search reaches HybridLoad()
+    WarmQuantizer();
+
     return Status::OK();
 }
 
+Status
+ExecutionEngineImpl::LoadToGpu(uint64_t device_id, bool to_cache) {
+#ifdef MILVUS_GPU_VERSION
+    auto index = std::static_pointer_cast<VecIndex>(cache::GpuCacheMgr::GetInstance(device_id)->GetIndex(location_));
+    if (index != nullptr) {
+        index_ = index;
+        return Status::OK();
+    }
+
+    try {
+        double physical_size = PhysicalSize();
+        server::CollectExecutionEngineMetrics metrics(physical_size);
+
+        // the host copy is only a deserialization staging area: it is cloned to
+        // the device immediately, never inserted into the cpu cache, and freed
+        // when it goes out of scope here
+        auto host_index = read_index(location_);
+        if (host_index == nullptr) {
+            std::string msg = "Failed to load index from " + location_;
+            ENGINE_LOG_ERROR << msg;
+            return Status(DB_ERROR, msg);
+        }
+
+        index_ = host_index->CopyToGpu(device_id);
+        ENGINE_LOG_DEBUG << "Fused load from " << location_ << " to GPU" << device_id;
+    } catch (std::exception& e) {
+        ENGINE_LOG_ERROR << e.what();
+        return Status(DB_ERROR, e.what());
+    }
+
+    if (to_cache) {
+        GpuCache(device_id);
+    }
+    return Status::OK();
+#else
+    return Load(to_cache);
+#endif
+}
+
 Status
 ExecutionEngineImpl::CopyToGpu(uint64_t device_id, bool hybrid) {
 #if 0
@@ -528,6 +734,41 @@ ExecutionEngineImpl::Merge(const std::string& location) {
     ENGINE_LOG_DEBUG << "Merge index file: " << location << " to: " << location_;
 
     auto to_merge = cache::CpuCacheMgr::GetInstance()->GetIndex(location);
+    if (!to_merge && std::dynamic_pointer_cast<BFIndex>(index_)) {
+        // the source is not cached: stream its raw file window by window
+        // instead of deserializing it whole, so merging toward a large
+        // index_file_size does not hold a second file-sized copy in memory
+        // the source file may carry a different physical stride (padding was
+        // enabled or disabled after it was written); restride if it does
+        int64_t target_dim = index_->Dimension();
+        int64_t source_dim = target_dim;
+        SegmentHeaderInfo header;
+        if (read_index_header(location, header).ok() && header.dimension > 0) {
+            source_dim = header.dimension;
+        }
+        std::vector<float> restrided;
+        int64_t streamed_rows = 0;
+        auto status = read_raw_windows(location, RAW_MERGE_WINDOW_BYTES,
+                                       [&](int64_t count, const float* vectors, const int64_t* ids) {
+                                           streamed_rows += count;
+                                           if (source_dim != target_dim) {
+                                               RestrideRows(count, source_dim, target_dim, vectors, restrided);
+                                               return index_->Add(count, restrided.data(), ids);
+                                           }
+                                           return index_->Add(count, vectors, ids);
+                                       });
+        if (status.ok()) {
+            ENGINE_LOG_DEBUG << "Finish merge index file: " << location;
+            return status;
+        }
+        if (streamed_rows > 0) {
+            // rows were already appended; reloading the file would duplicate them
+            ENGINE_LOG_ERROR << "Failed to merge: " << location << " to: " << location_;
+            return status;
+        }
+        // the file is not in the streamable layout; fall back to the full load
+    }
+
     if (!to_merge) {
         try {
             double physical_size = server::CommonUtil::GetFileSize(location);
@@ -545,7 +786,13 @@ ExecutionEngineImpl::Merge(const std::string& location) {
     }
 
     if (auto file_index = std::dynamic_pointer_cast<BFIndex>(to_merge)) {
-        auto status = index_->Add(file_index->Count(), file_index->GetRawVectors(), file_index->GetRawIds());
+        const float* vectors = file_index->GetRawVectors();
+        std::vector<float> restrided;
+        if (file_index->Dimension() != index_->Dimension()) {
+            RestrideRows(file_index->Count(), file_index->Dimension(), index_->Dimension(), vectors, restrided);
+            vectors = restrided.data();
+        }
+        auto status = index_->Add(file_index->Count(), vectors, file_index->GetRawIds());
         if (!status.ok()) {
             ENGINE_LOG_ERROR << "Failed to merge: " << location << " to: " << location_;
         } else {
@@ -594,7 +841,25 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
     auto adapter = AdapterMgr::GetInstance().GetAdapter(to_index->GetType());
     auto conf = adapter->Match(temp_conf);
 
-    if (from_index) {
+    // per-table quantizer reuse: all segments of a table share one
+    // distribution, so the k-means phase of an earlier segment build carries
+    // over. Fetch validates the build parameters and checks for drift; a miss
+    // trains as usual and caches the fresh model
+    bool reuse_model = engine_type == EngineType::FAISS_IVFFLAT || engine_type == EngineType::FAISS_IVFSQ8 ||
+                       engine_type == EngineType::FAISS_IVFSQ8H || engine_type == EngineType::FAISS_PQ ||
+                       engine_type == EngineType::FAISS_PQ_FS;
+
+    if (from_index && reuse_model) {
+        auto& model_mgr = TrainedModelMgr::GetInstance();
+        knowhere::IndexModelPtr model = model_mgr.Fetch(location_, to_index->GetType(), Dimension(), nlist_,
+                                                        (int32_t)metric_type_, Count(), from_index->GetRawVectors());
+        bool trained_here = (model == nullptr);
+        status = to_index->BuildAll(Count(), from_index->GetRawVectors(), from_index->GetRawIds(), conf, model);
+        if (status.ok() && trained_here && model != nullptr) {
+            model_mgr.Store(location_, to_index->GetType(), Dimension(), nlist_, (int32_t)metric_type_, Count(),
+                            from_index->GetRawVectors(), model);
+        }
+    } else if (from_index) {
         status = to_index->BuildAll(Count(), from_index->GetRawVectors(), from_index->GetRawIds(), conf);
     } else if (bin_from_index) {
         status = to_index->BuildAll(Count(), bin_from_index->GetRawVectors(), bin_from_index->GetRawIds(), conf);
@@ -607,9 +872,62 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
     return std::make_shared<ExecutionEngineImpl>(to_index, location, engine_type, metric_type_, nlist_);
 }
 
+ExecutionEnginePtr
+ExecutionEngineImpl::BuildIndexFromModel(const std::string& location, EngineType engine_type) {
+    auto from_index = std::dynamic_pointer_cast<BFIndex>(index_);
+    if (from_index == nullptr) {
+        // only the float brute-force engine carries a reusable model
+        return nullptr;
+    }
+
+    bool reuse_model = engine_type == EngineType::FAISS_IVFFLAT || engine_type == EngineType::FAISS_IVFSQ8 ||
+                       engine_type == EngineType::FAISS_IVFSQ8H || engine_type == EngineType::FAISS_PQ ||
+                       engine_type == EngineType::FAISS_PQ_FS;
+    if (!reuse_model) {
+        return nullptr;
+    }
+
+    auto to_index = CreatetVecIndex(engine_type);
+    if (!to_index) {
+        return nullptr;
+    }
+
+    TempMetaConf temp_conf;
+    temp_conf.gpu_id = gpu_num_;
+    temp_conf.dim = Dimension();
+    temp_conf.nlist = nlist_;
+    temp_conf.size = Count();
+    auto status = MappingMetricType(metric_type_, temp_conf.metric_type);
+    if (!status.ok()) {
+        return nullptr;
+    }
+
+    auto adapter = AdapterMgr::GetInstance().GetAdapter(to_index->GetType());
+    auto conf = adapter->Match(temp_conf);
+
+    knowhere::IndexModelPtr model = TrainedModelMgr::GetInstance().Fetch(
+        location_, to_index->GetType(), Dimension(), nlist_, (int32_t)metric_type_, Count(),
+        from_index->GetRawVectors());
+    if (model == nullptr) {
+        // no trained quantizer for the table yet, or the segment has drifted
+        return nullptr;
+    }
+
+    ENGINE_LOG_DEBUG << "Build index file from model: " << location << " from: " << location_;
+    status = to_index->BuildAll(Count(), from_index->GetRawVectors(), from_index->GetRawIds(), conf, model);
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Failed to build index from model: " << status.message();
+        return nullptr;
+    }
+
+    ENGINE_LOG_DEBUG << "Finish build index file from model: " << location << " size: " << to_index->Size();
+    return std::make_shared<ExecutionEngineImpl>(to_index, location, engine_type, metric_type_, nlist_);
+}
+
 Status
 ExecutionEngineImpl::Search(int64_t n, const float* data, int64_t k, int64_t nprobe, float* distances, int64_t* labels,
-                            bool hybrid) {
+                            bool hybrid, const faiss::IDSelector* deleted_sel,
+                            knowhere::CoarseAssignCache* assign_cache) {
 #if 0
     if (index_type_ == EngineType::FAISS_IVFSQ8H) {
         if (!hybrid) {
@@ -670,16 +988,41 @@ ExecutionEngineImpl::Search(int64_t n, const float* data, int64_t k, int64_t npr
         return Status(DB_ERROR, "index is null");
     }
 
+    // queries arrive at the logical stride; restride them when this segment
+    // stores dimension-padded rows
+    std::vector<float> padded_queries;
+    if (dim_ > 0 && index_->Dimension() > dim_) {
+        RestrideRows(n, dim_, index_->Dimension(), data, padded_queries);
+        data = padded_queries.data();
+    }
+
     ENGINE_LOG_DEBUG << "Search Params: [k]  " << k << " [nprobe] " << nprobe;
 
     // TODO(linxj): remove here. Get conf from function
     TempMetaConf temp_conf;
     temp_conf.k = k;
     temp_conf.nprobe = nprobe;
+    temp_conf.table_id = TunedParamsMgr::TableIdFromLocation(location_);
+
+    int64_t probe_stop_window = 0;
+    server::Config& config = server::Config::GetInstance();
+    if (config.GetEngineConfigSearchProbeStopWindow(probe_stop_window).ok()) {
+        temp_conf.probe_stop_window = probe_stop_window;
+    }
 
     auto adapter = AdapterMgr::GetInstance().GetAdapter(index_->GetType());
     auto conf = adapter->MatchSearch(temp_conf, index_->GetType());
 
+    if (deleted_sel != nullptr || assign_cache != nullptr) {
+        if (auto ivf_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(conf)) {
+            ivf_conf->sel = deleted_sel;
+            ivf_conf->assign_cache = assign_cache;
+        } else if (deleted_sel != nullptr) {
+            // raw segments are filtered by the tombstone post-filter instead
+            ENGINE_LOG_DEBUG << "deletion mask not supported by engine type " << (int)index_type_ << ", ignored";
+        }
+    }
+
     if (hybrid) {
         HybridLoad();
     }
@@ -696,6 +1039,50 @@ ExecutionEngineImpl::Search(int64_t n, const float* data, int64_t k, int64_t npr
     return status;
 }
 
+Status
+ExecutionEngineImpl::SearchOnGpu(int64_t n, const float* data, int64_t k, int64_t nprobe,
+                                 const GpuSearchReducerPtr& reducer) {
+#ifdef MILVUS_GPU_VERSION
+    if (index_ == nullptr || reducer == nullptr) {
+        ENGINE_LOG_ERROR << "ExecutionEngineImpl: index is null, failed to search";
+        return Status(DB_ERROR, "index or reducer is null");
+    }
+
+    std::vector<float> padded_queries;
+    if (dim_ > 0 && index_->Dimension() > dim_) {
+        RestrideRows(n, dim_, index_->Dimension(), data, padded_queries);
+        data = padded_queries.data();
+    }
+
+    if (index_->GetDeviceId() != reducer->device_id()) {
+        return Status(DB_ERROR, "index is not resident on the reducer's device");
+    }
+
+    TempMetaConf temp_conf;
+    temp_conf.k = k;
+    temp_conf.nprobe = nprobe;
+
+    auto adapter = AdapterMgr::GetInstance().GetAdapter(index_->GetType());
+    auto conf = adapter->MatchSearch(temp_conf, index_->GetType());
+
+    float* d_distances = nullptr;
+    int64_t* d_labels = nullptr;
+    int64_t slot = reducer->AcquireSlot(&d_distances, &d_labels);
+    if (slot < 0) {
+        return Status(DB_ERROR, "no free reducer slot");
+    }
+
+    auto status = index_->SearchResident(n, data, d_distances, d_labels, conf);
+    if (!status.ok()) {
+        // neutralize the half-written slot, then let the caller run the host path
+        reducer->AbortSlot(slot);
+    }
+    return status;
+#else
+    return Status(DB_ERROR, "GPU-resident search requires the GPU build");
+#endif
+}
+
 Status
 ExecutionEngineImpl::Search(int64_t n, const uint8_t* data, int64_t k, int64_t nprobe, float* distances,
                             int64_t* labels, bool hybrid) {
@@ -730,6 +1117,38 @@ ExecutionEngineImpl::Search(int64_t n, const uint8_t* data, int64_t k, int64_t n
     return status;
 }
 
+Status
+ExecutionEngineImpl::RangeSearch(int64_t n, const float* data, float radius, int64_t nprobe,
+                                 std::vector<int64_t>& labels, std::vector<float>& distances,
+                                 std::vector<size_t>& lims) {
+    if (index_ == nullptr) {
+        ENGINE_LOG_ERROR << "ExecutionEngineImpl: index is null, failed to range search";
+        return Status(DB_ERROR, "index is null");
+    }
+
+    std::vector<float> padded_queries;
+    if (dim_ > 0 && index_->Dimension() > dim_) {
+        RestrideRows(n, dim_, index_->Dimension(), data, padded_queries);
+        data = padded_queries.data();
+    }
+
+    ENGINE_LOG_DEBUG << "RangeSearch Params: [radius] " << radius << " [nprobe] " << nprobe;
+
+    // TODO(linxj): remove here. Get conf from function
+    TempMetaConf temp_conf;
+    temp_conf.k = 1;  // unused by range search, but the adapter requires a valid topk
+    temp_conf.nprobe = nprobe;
+
+    auto adapter = AdapterMgr::GetInstance().GetAdapter(index_->GetType());
+    auto conf = adapter->MatchSearch(temp_conf, index_->GetType());
+
+    auto status = index_->RangeSearch(n, data, radius, labels, distances, lims, conf);
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "RangeSearch error:" << status.message();
+    }
+    return status;
+}
+
 Status
 ExecutionEngineImpl::Cache() {
     cache::DataObjPtr obj = std::static_pointer_cast<cache::DataObj>(index_);
@@ -52,6 +52,9 @@ class ExecutionEngineImpl : public ExecutionEngine {
     Status
     Load(bool to_cache) override;
 
+    Status
+    LoadToGpu(uint64_t device_id, bool to_cache) override;
+
     Status
     CopyToGpu(uint64_t device_id, bool hybrid = false) override;
 
@@ -69,15 +72,26 @@ class ExecutionEngineImpl : public ExecutionEngine {
 
     Status
     Search(int64_t n, const float* data, int64_t k, int64_t nprobe, float* distances, int64_t* labels,
-           bool hybrid = false) override;
+           bool hybrid = false, const faiss::IDSelector* deleted_sel = nullptr,
+           knowhere::CoarseAssignCache* assign_cache = nullptr) override;
 
     Status
     Search(int64_t n, const uint8_t* data, int64_t k, int64_t nprobe, float* distances, int64_t* labels,
            bool hybrid = false) override;
 
+    Status
+    SearchOnGpu(int64_t n, const float* data, int64_t k, int64_t nprobe, const GpuSearchReducerPtr& reducer) override;
+
+    Status
+    RangeSearch(int64_t n, const float* data, float radius, int64_t nprobe, std::vector<int64_t>& labels,
+                std::vector<float>& distances, std::vector<size_t>& lims) override;
+
     ExecutionEnginePtr
     BuildIndex(const std::string& location, EngineType engine_type) override;
 
+    ExecutionEnginePtr
+    BuildIndexFromModel(const std::string& location, EngineType engine_type) override;
+
     Status
     Cache() override;
 
@@ -102,6 +116,16 @@ class ExecutionEngineImpl : public ExecutionEngine {
         return location_;
     }
 
+    void
+    SetWarm(bool warm) override {
+        warm_ = warm;
+    }
+
+    bool
+    Warm() const override {
+        return warm_;
+    }
+
  private:
     VecIndexPtr
     CreatetVecIndex(EngineType type);
@@ -115,16 +139,33 @@ class ExecutionEngineImpl : public ExecutionEngine {
     void
     HybridUnset() const;
 
+    // Upload this segment's SQ8H quantizer to the gpu with the most free cache room
+    // in the background when it is not resident on any search gpu, so the first
+    // hybrid search after a load does not pay the quantizer transfer.
+    void
+    WarmQuantizer() const;
+
+    // header section of the segment file, read once on demand; answers
+    // Count/Dimension for an unloaded engine without pulling the payload
+    const SegmentHeaderInfo&
+    FileHeader() const;
+
  protected:
     VecIndexPtr index_ = nullptr;
     EngineType index_type_;
     MetricType metric_type_;
 
-    int64_t dim_;
+    // logical dimension from the table schema; 0 when the engine was built
+    // around an existing index and only the physical stride is known
+    int64_t dim_ = 0;
     std::string location_;
 
     int64_t nlist_ = 0;
     int64_t gpu_num_ = 0;
+    bool warm_ = false;
+
+    mutable SegmentHeaderInfo file_header_;
+    mutable bool file_header_checked_ = false;
 };
 
 }  // namespace engine
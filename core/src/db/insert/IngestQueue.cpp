@@ -0,0 +1,72 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/insert/IngestQueue.h"
+
+#include <algorithm>
+
+namespace milvus {
+namespace engine {
+
+IngestQueue::~IngestQueue() {
+    auto* chunk = head_.exchange(nullptr, std::memory_order_acquire);
+    while (chunk != nullptr) {
+        auto* next = chunk->next_;
+        delete chunk;
+        chunk = next;
+    }
+}
+
+void
+IngestQueue::Push(VectorsData&& vectors) {
+    size_t mem = ChunkMem(vectors);
+    auto* chunk = new Chunk(std::move(vectors));
+
+    chunk->next_ = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(chunk->next_, chunk, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+
+    staged_mem_.fetch_add(mem, std::memory_order_relaxed);
+}
+
+std::vector<VectorsData>
+IngestQueue::DrainAll() {
+    auto* chunk = head_.exchange(nullptr, std::memory_order_acquire);
+
+    // the stack pops newest-first; reverse to recover arrival order
+    std::vector<VectorsData> chunks;
+    size_t drained_mem = 0;
+    while (chunk != nullptr) {
+        drained_mem += ChunkMem(chunk->vectors_);
+        chunks.emplace_back(std::move(chunk->vectors_));
+        auto* next = chunk->next_;
+        delete chunk;
+        chunk = next;
+    }
+    std::reverse(chunks.begin(), chunks.end());
+
+    staged_mem_.fetch_sub(drained_mem, std::memory_order_relaxed);
+    return chunks;
+}
+
+size_t
+IngestQueue::StagedMem() const {
+    return staged_mem_.load(std::memory_order_relaxed);
+}
+
+size_t
+IngestQueue::ChunkMem(const VectorsData& vectors) {
+    return vectors.float_data_.size() * sizeof(float) + vectors.binary_data_.size() +
+           vectors.id_array_.size() * sizeof(IDNumber);
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,62 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Types.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// Lock-free multi-producer single-consumer staging queue for one table's
+// inserts. Client threads transfer ownership of a vector chunk with a single
+// compare-and-swap, so concurrent writers never serialize on a lock; the
+// flush thread later drains everything staged in one exchange and batches
+// the chunks into MemTableFiles.
+class IngestQueue {
+ public:
+    ~IngestQueue();
+
+    void
+    Push(VectorsData&& vectors);
+
+    // staged chunks in arrival order; only one thread may drain at a time
+    std::vector<VectorsData>
+    DrainAll();
+
+    size_t
+    StagedMem() const;
+
+ private:
+    struct Chunk {
+        explicit Chunk(VectorsData&& vectors) : vectors_(std::move(vectors)) {
+        }
+
+        VectorsData vectors_;
+        Chunk* next_ = nullptr;
+    };
+
+    static size_t
+    ChunkMem(const VectorsData& vectors);
+
+ private:
+    std::atomic<Chunk*> head_{nullptr};
+    std::atomic<size_t> staged_mem_{0};
+};
+
+using IngestQueuePtr = std::shared_ptr<IngestQueue>;
+
+}  // namespace engine
+}  // namespace milvus
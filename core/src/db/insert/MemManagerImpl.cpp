@@ -12,13 +12,62 @@
 #include "db/insert/MemManagerImpl.h"
 #include "VectorSource.h"
 #include "db/Constants.h"
+#include "db/IDGenerator.h"
+#include "db/MetaEventBus.h"
 #include "utils/Log.h"
+#include "utils/ThreadPool.h"
 
+#include <algorithm>
+#include <future>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace milvus {
 namespace engine {
 
+namespace {
+// above this fraction of the insert buffer, inserts are slowed gradually so
+// ingest converges on flush throughput instead of hitting the wall at once
+constexpr double INSERT_HIGH_WATERMARK = 0.8;
+// longest graduated delay applied per insert at the hard limit
+constexpr int64_t INSERT_MAX_DELAY_MS = 100;
+// a full buffer that flushing cannot drain within this bound is rejected
+constexpr int64_t INSERT_MAX_WAIT_MS = 10000;
+// hint returned to clients when an insert is rejected
+constexpr int64_t INSERT_RETRY_AFTER_SEC = 1;
+// tables flushed concurrently per cycle; each table additionally fans out
+// its own file writers, so this stays small to leave disk bandwidth for
+// index builds reading from the same device
+constexpr size_t FLUSH_TABLE_CONCURRENCY = 2;
+}  // namespace
+
+void
+MemManagerImpl::InitWal() {
+    if (!options_.wal_enable_) {
+        return;
+    }
+
+    wal_mgr_ = std::make_shared<WalManager>(options_.meta_.path_ + "/wal");
+    auto status = wal_mgr_->Open();
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Failed to open wal, inserts will not be durable until flush: " << status.ToString();
+        wal_mgr_ = nullptr;
+        return;
+    }
+
+    // inserts the previous run acknowledged but never flushed are staged
+    // again with their original ids; the records stay in the log until the
+    // first flush lands them in segment files
+    status = wal_mgr_->Replay([this](const std::string& table_id, VectorsData& vectors) {
+        StageChunk(table_id, vectors);
+        return Status::OK();
+    });
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Failed to replay wal: " << status.ToString();
+    }
+}
+
 MemTablePtr
 MemManagerImpl::GetMemByTable(const std::string& table_id) {
     auto memIt = mem_id_map_.find(table_id);
@@ -30,15 +79,87 @@ MemManagerImpl::GetMemByTable(const std::string& table_id) {
     return mem_id_map_[table_id];
 }
 
+IngestQueuePtr
+MemManagerImpl::GetQueueByTable(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    auto queue_it = queue_map_.find(table_id);
+    if (queue_it != queue_map_.end()) {
+        return queue_it->second;
+    }
+
+    queue_map_[table_id] = std::make_shared<IngestQueue>();
+    return queue_map_[table_id];
+}
+
 Status
 MemManagerImpl::InsertVectors(const std::string& table_id, VectorsData& vectors) {
-    while (GetCurrentMem() > options_.insert_buffer_size_) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    size_t buffer_limit = options_.insert_buffer_size_;
+    auto high_watermark = static_cast<size_t>(buffer_limit * INSERT_HIGH_WATERMARK);
+
+    // graduated backpressure: between the high watermark and the limit,
+    // delay completion proportionally to how full the buffer is
+    size_t current_mem = GetCurrentMem();
+    if (current_mem > high_watermark && current_mem <= buffer_limit) {
+        double fullness = static_cast<double>(current_mem - high_watermark) / (buffer_limit - high_watermark);
+        auto delay_ms = static_cast<int64_t>(fullness * INSERT_MAX_DELAY_MS);
+        if (delay_ms > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        }
     }
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    // hard limit: wait for flush progress with a bound instead of spinning
+    // forever; a rejected client gets a retry-after hint rather than a herd
+    // of immediate retries
+    if (GetCurrentMem() > buffer_limit) {
+        std::unique_lock<std::mutex> lock(flush_cv_mutex_);
+        bool drained = flush_cv_.wait_for(lock, std::chrono::milliseconds(INSERT_MAX_WAIT_MS),
+                                          [this, buffer_limit] { return GetCurrentMem() <= buffer_limit; });
+        if (!drained) {
+            std::string msg = "Insert buffer full and flush is not keeping up; retry after " +
+                              std::to_string(INSERT_RETRY_AFTER_SEC) + " second(s)";
+            ENGINE_LOG_WARNING << msg;
+            return Status(SERVER_OUT_OF_MEMORY, msg);
+        }
+    }
 
-    return InsertVectorsNoLock(table_id, vectors);
+    // assign ids up front so the caller gets them back without waiting for
+    // the staged chunk to be consumed, and so a wal replay after a crash
+    // reproduces them exactly
+    if (vectors.id_array_.empty()) {
+        ShardedIDGenerator id_generator;
+        id_generator.GetNextIDNumbers(vectors.vector_count_, vectors.id_array_);
+    }
+
+    if (wal_mgr_ != nullptr) {
+        // durability before visibility: Append returns only after the record
+        // is fsynced, then the chunk is staged with nothing blocking between,
+        // so Serialize's enter/exit barrier stays cheap
+        wal_enter_.fetch_add(1);
+        auto status = wal_mgr_->Append(table_id, vectors);
+        if (!status.ok()) {
+            wal_exit_.fetch_add(1);
+            return status;
+        }
+        StageChunk(table_id, vectors);
+        wal_exit_.fetch_add(1);
+        return Status::OK();
+    }
+
+    StageChunk(table_id, vectors);
+    return Status::OK();
+}
+
+void
+MemManagerImpl::StageChunk(const std::string& table_id, VectorsData& vectors) {
+    // ownership of the heavy payload moves into the staging queue; the id
+    // array is copied because the caller returns it to the client
+    VectorsData chunk;
+    chunk.vector_count_ = vectors.vector_count_;
+    chunk.float_data_ = std::move(vectors.float_data_);
+    chunk.binary_data_ = std::move(vectors.binary_data_);
+    chunk.id_array_ = vectors.id_array_;
+
+    GetQueueByTable(table_id)->Push(std::move(chunk));
 }
 
 Status
@@ -55,9 +176,36 @@ MemManagerImpl::InsertVectorsNoLock(const std::string& table_id, VectorsData& ve
     return status;
 }
 
+Status
+MemManagerImpl::ConsumeStagedNoLock() {
+    QueueIdMap queues;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        queues = queue_map_;
+    }
+
+    Status overall_status = Status::OK();
+    for (auto& kv : queues) {
+        auto chunks = kv.second->DrainAll();
+        for (auto& chunk : chunks) {
+            auto status = InsertVectorsNoLock(kv.first, chunk);
+            if (!status.ok()) {
+                // the client already got its ids back; all we can do is log
+                ENGINE_LOG_ERROR << "Failed to consume staged insert chunk of table " << kv.first << ": "
+                                 << status.ToString();
+                overall_status = status;
+            }
+        }
+    }
+
+    return overall_status;
+}
+
 Status
 MemManagerImpl::ToImmutable() {
     std::unique_lock<std::mutex> lock(mutex_);
+    ConsumeStagedNoLock();
+
     MemIdMap temp_map;
     for (auto& kv : mem_id_map_) {
         if (kv.second->Empty()) {
@@ -74,19 +222,94 @@ MemManagerImpl::ToImmutable() {
 
 Status
 MemManagerImpl::Serialize(std::set<std::string>& table_ids) {
+    // records appended after the mark are not covered by this flush; the
+    // barrier waits out inserts already past their durable append so every
+    // record up to the mark is staged before the drain below
+    uint64_t wal_mark = 0;
+    if (wal_mgr_ != nullptr) {
+        wal_mark = wal_mgr_->CurrentLsn();
+        uint64_t entered = wal_enter_.load();
+        while (wal_exit_.load() < entered) {
+            std::this_thread::yield();
+        }
+    }
+
     ToImmutable();
-    std::unique_lock<std::mutex> lock(serialization_mtx_);
+
+    // swap the sealed tables out under the lock and write without it, so
+    // concurrent inserts' memory accounting never waits on a disk write;
+    // a fresh MemTable is created lazily on the next insert of each table
+    MemList sealed_list;
+    {
+        std::unique_lock<std::mutex> lock(serialization_mtx_);
+        sealed_list.swap(immu_mem_list_);
+    }
+
+    size_t sealed_mem = 0;
+    for (auto& mem : sealed_list) {
+        sealed_mem += mem->GetCurrentMem();
+    }
+    serializing_mem_.fetch_add(sealed_mem);
+
+    // flush biggest buffers first so memory frees fastest, oldest first
+    // among equals so no table's buffer can age indefinitely
+    std::sort(sealed_list.begin(), sealed_list.end(), [](const MemTablePtr& lhs, const MemTablePtr& rhs) {
+        size_t lhs_mem = lhs->GetCurrentMem();
+        size_t rhs_mem = rhs->GetCurrentMem();
+        if (lhs_mem != rhs_mem) {
+            return lhs_mem > rhs_mem;
+        }
+        return lhs->GetCreatedOn() < rhs->GetCreatedOn();
+    });
+
     table_ids.clear();
-    for (auto& mem : immu_mem_list_) {
-        mem->Serialize();
+    for (auto& mem : sealed_list) {
         table_ids.insert(mem->GetTableId());
     }
-    immu_mem_list_.clear();
+
+    // with many active tables a one-at-a-time flush cycle takes minutes and
+    // the tail tables' buffers balloon; a small pool flushes tables
+    // concurrently, capped so flush writes leave disk bandwidth for index
+    // builds reading from the same device
+    bool all_serialized = true;
+    if (!sealed_list.empty()) {
+        ThreadPool flush_pool(std::min(sealed_list.size(), FLUSH_TABLE_CONCURRENCY));
+        std::vector<std::future<Status>> flush_results;
+        for (auto& mem : sealed_list) {
+            flush_results.push_back(flush_pool.enqueue([this, mem] {
+                size_t mem_size = mem->GetCurrentMem();
+                auto status = mem->Serialize();
+                serializing_mem_.fetch_sub(mem_size);
+                flush_cv_.notify_all();
+                return status;
+            }));
+        }
+        for (size_t i = 0; i < flush_results.size(); i++) {
+            if (flush_results[i].get().ok()) {
+                // tell the merge/build loops this table has new files,
+                // so they don't have to poll the meta to find out
+                MetaEventBus::GetInstance().Publish(MetaEvent::FLUSH_COMPLETED, sealed_list[i]->GetTableId());
+            } else {
+                all_serialized = false;
+            }
+        }
+    }
+
+    // once every record up to the mark is in segment files the covered log
+    // files are dropped; on any write failure the log is kept for replay
+    if (wal_mgr_ != nullptr && all_serialized) {
+        wal_mgr_->Truncate(wal_mark);
+    }
     return Status::OK();
 }
 
 Status
 MemManagerImpl::EraseMemVector(const std::string& table_id) {
+    {  // discard staged chunks not yet consumed
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        queue_map_.erase(table_id);
+    }
+
     {  // erase MemVector from rapid-insert cache
         std::unique_lock<std::mutex> lock(mutex_);
         mem_id_map_.erase(table_id);
@@ -107,8 +330,18 @@ MemManagerImpl::EraseMemVector(const std::string& table_id) {
 }
 
 size_t
-MemManagerImpl::GetCurrentMutableMem() {
+MemManagerImpl::GetStagedMem() {
     size_t total_mem = 0;
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    for (auto& kv : queue_map_) {
+        total_mem += kv.second->StagedMem();
+    }
+    return total_mem;
+}
+
+size_t
+MemManagerImpl::GetCurrentMutableMem() {
+    size_t total_mem = GetStagedMem();
     std::unique_lock<std::mutex> lock(mutex_);
     for (auto& kv : mem_id_map_) {
         auto memTable = kv.second;
@@ -119,7 +352,7 @@ MemManagerImpl::GetCurrentMutableMem() {
 
 size_t
 MemManagerImpl::GetCurrentImmutableMem() {
-    size_t total_mem = 0;
+    size_t total_mem = serializing_mem_.load();
     std::unique_lock<std::mutex> lock(serialization_mtx_);
     for (auto& mem_table : immu_mem_list_) {
         total_mem += mem_table->GetCurrentMem();
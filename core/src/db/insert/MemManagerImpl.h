@@ -13,9 +13,13 @@
 
 #include "MemManager.h"
 #include "MemTable.h"
+#include "db/insert/IngestQueue.h"
+#include "db/insert/WalManager.h"
 #include "db/meta/Meta.h"
 #include "utils/Status.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <ctime>
 #include <map>
 #include <memory>
@@ -32,6 +36,7 @@ class MemManagerImpl : public MemManager {
     using Ptr = std::shared_ptr<MemManagerImpl>;
 
     MemManagerImpl(const meta::MetaPtr& meta, const DBOptions& options) : meta_(meta), options_(options) {
+        InitWal();
     }
 
     Status
@@ -56,19 +61,49 @@ class MemManagerImpl : public MemManager {
     MemTablePtr
     GetMemByTable(const std::string& table_id);
 
+    IngestQueuePtr
+    GetQueueByTable(const std::string& table_id);
+
+    void
+    InitWal();
+
+    void
+    StageChunk(const std::string& table_id, VectorsData& vectors);
+
     Status
     InsertVectorsNoLock(const std::string& table_id, VectorsData& vectors);
     Status
+    ConsumeStagedNoLock();
+    Status
     ToImmutable();
 
+    size_t
+    GetStagedMem();
+
     using MemIdMap = std::map<std::string, MemTablePtr>;
     using MemList = std::vector<MemTablePtr>;
+    using QueueIdMap = std::map<std::string, IngestQueuePtr>;
     MemIdMap mem_id_map_;
     MemList immu_mem_list_;
+    QueueIdMap queue_map_;
     meta::MetaPtr meta_;
     DBOptions options_;
     std::mutex mutex_;
     std::mutex serialization_mtx_;
+    // guards queue_map_ lookups only; deposits into a queue are lock-free
+    std::mutex queue_mutex_;
+    // bytes of sealed tables currently being written, counted outside the
+    // serialization lock so back-pressure checks never wait on disk
+    std::atomic<size_t> serializing_mem_{0};
+    // signaled on flush progress so throttled inserts wake promptly
+    std::condition_variable flush_cv_;
+    std::mutex flush_cv_mutex_;
+    // null unless db_config.wal_enable is set; the enter/exit counters let
+    // Serialize wait out the lock-free window between a durable wal append
+    // and the chunk landing in the staging queue before it drains
+    WalManagerPtr wal_mgr_;
+    std::atomic<uint64_t> wal_enter_{0};
+    std::atomic<uint64_t> wal_exit_{0};
 };  // NewMemManager
 
 }  // namespace engine
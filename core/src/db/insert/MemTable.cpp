@@ -10,20 +10,56 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/insert/MemTable.h"
+#include "db/Constants.h"
+#include "db/Utils.h"
 #include "utils/Log.h"
+#include "utils/ThreadPool.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
+
+namespace {
+constexpr size_t SERIALIZE_THREAD_NUM = 4;
+}  // namespace
 
 namespace milvus {
 namespace engine {
 
 MemTable::MemTable(const std::string& table_id, const meta::MetaPtr& meta, const DBOptions& options)
-    : table_id_(table_id), meta_(meta), options_(options) {
+    : table_id_(table_id), meta_(meta), options_(options), created_on_(utils::GetMicroSecTimeStamp()) {
 }
 
 Status
 MemTable::Add(VectorSourcePtr& source) {
+    // zero-copy fast path: a whole chunk with pre-assigned ids moves into a
+    // file as one owned slab; the engine only sees it when the file is
+    // serialized. Oversized chunks fall back to the splitting copy path.
+    if (source->CanTakeAll() && source->SlabMem() > 0 && source->SlabMem() <= MAX_TABLE_FILE_MEM) {
+        MemTableFilePtr target;
+        bool new_file = false;
+        if (!mem_table_file_list_.empty() && mem_table_file_list_.back()->GetMemLeft() >= source->SlabMem()) {
+            target = mem_table_file_list_.back();
+        } else {
+            target = std::make_shared<MemTableFile>(table_id_, meta_, options_);
+            new_file = true;
+        }
+
+        auto status = target->AddSlab(source);
+        if (!status.ok()) {
+            std::string err_msg = "Insert failed: " + status.ToString();
+            ENGINE_LOG_ERROR << err_msg;
+            return Status(DB_ERROR, err_msg);
+        }
+
+        if (new_file) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            mem_table_file_list_.emplace_back(target);
+        }
+        return Status::OK();
+    }
+
     while (!source->AllAdded()) {
         MemTableFilePtr current_mem_table_file;
         if (!mem_table_file_list_.empty()) {
@@ -62,17 +98,63 @@ MemTable::GetTableFileCount() {
 
 Status
 MemTable::Serialize() {
-    for (auto mem_table_file = mem_table_file_list_.begin(); mem_table_file != mem_table_file_list_.end();) {
-        auto status = (*mem_table_file)->Serialize();
+    MemTableFileList files;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        files = mem_table_file_list_;
+    }
+
+    if (files.empty()) {
+        return Status::OK();
+    }
+
+    // a big flush accumulates several files; write them concurrently
+    ThreadPool write_pool(std::min(files.size(), SERIALIZE_THREAD_NUM));
+    std::vector<std::future<Status>> results;
+    for (auto& file : files) {
+        results.push_back(write_pool.enqueue([file] { return file->Serialize(); }));
+    }
+
+    Status overall_status = Status::OK();
+    MemTableFileList persisted;
+    for (size_t i = 0; i < files.size(); i++) {
+        auto status = results[i].get();
         if (!status.ok()) {
+            std::string err_msg = "Insert data serialize failed: " + status.ToString();
+            ENGINE_LOG_ERROR << err_msg;
+            overall_status = Status(DB_ERROR, err_msg);
+            continue;  // the failed file stays in the list for a retry
+        }
+        persisted.push_back(files[i]);
+    }
+
+    // the whole flush transitions in one meta transaction: a single fsync
+    // instead of one per file
+    if (!persisted.empty()) {
+        meta::TableFilesSchema updated;
+        for (auto& file : persisted) {
+            updated.push_back(file->GetTableFileSchema());
+        }
+
+        auto status = meta_->UpdateTableFiles(updated);
+        if (!status.ok()) {
+            // the data files are on disk but the transition did not commit;
+            // every file stays in the list and the next cycle retries
             std::string err_msg = "Insert data serialize failed: " + status.ToString();
             ENGINE_LOG_ERROR << err_msg;
             return Status(DB_ERROR, err_msg);
         }
-        std::lock_guard<std::mutex> lock(mutex_);
-        mem_table_file = mem_table_file_list_.erase(mem_table_file);
+
+        for (auto& file : persisted) {
+            file->RegisterIds();
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto iter = std::find(mem_table_file_list_.begin(), mem_table_file_list_.end(), file);
+            if (iter != mem_table_file_list_.end()) {
+                mem_table_file_list_.erase(iter);
+            }
+        }
     }
-    return Status::OK();
+    return overall_status;
 }
 
 bool
@@ -95,5 +177,10 @@ MemTable::GetCurrentMem() {
     return total_mem;
 }
 
+int64_t
+MemTable::GetCreatedOn() const {
+    return created_on_;
+}
+
 }  // namespace engine
 }  // namespace milvus
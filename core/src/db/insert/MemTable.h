@@ -50,6 +50,10 @@ class MemTable {
     size_t
     GetCurrentMem();
 
+    // micro-second timestamp of the first insert this buffer absorbed
+    int64_t
+    GetCreatedOn() const;
+
  private:
     const std::string table_id_;
 
@@ -59,6 +63,8 @@ class MemTable {
 
     DBOptions options_;
 
+    int64_t created_on_ = 0;
+
     std::mutex mutex_;
 };  // MemTable
 
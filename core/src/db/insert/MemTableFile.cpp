@@ -10,11 +10,17 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/insert/MemTableFile.h"
+#include "db/AttrSidecar.h"
 #include "db/Constants.h"
+#include "db/IdIndex.h"
+#include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
+#include "db/insert/VectorNormalizer.h"
 #include "metrics/Metrics.h"
 #include "utils/Log.h"
+#include "utils/Profiler.h"
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 
@@ -64,12 +70,81 @@ MemTableFile::Add(VectorSourcePtr& source) {
         auto status = source->Add(execution_engine_, table_file_schema_, num_vectors_to_add, num_vectors_added);
         if (status.ok()) {
             current_mem_ += (num_vectors_added * single_vector_mem_size);
+
+            auto source_ids = source->GetVectorIds();
+            ids_.insert(ids_.end(), source_ids.end() - num_vectors_added, source_ids.end());
+
+            // attribute rows ride along in engine add order; the slice just
+            // consumed starts where the source's earlier adds ended
+            size_t prior_rows = attr_ids_.size();
+            attr_ids_.insert(attr_ids_.end(), source_ids.end() - num_vectors_added, source_ids.end());
+            AttrSidecar::AppendColumns(attr_columns_, prior_rows, source->Attributes(),
+                                       source->GetNumVectorsAdded() - num_vectors_added, num_vectors_added);
+
+            // the source's max spans everything it has added so far, which may
+            // include an earlier file; still a sound upper bound for this one
+            table_file_schema_.max_norm_ = std::max(table_file_schema_.max_norm_, source->MaxNorm());
         }
         return status;
     }
     return Status::OK();
 }
 
+Status
+MemTableFile::AddSlab(VectorSourcePtr& source) {
+    if (table_file_schema_.dimension_ <= 0) {
+        std::string err_msg =
+            "MemTableFile::AddSlab: table_file_schema dimension = " + std::to_string(table_file_schema_.dimension_) +
+            ", table_id = " + table_file_schema_.table_id_;
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(DB_ERROR, "Not able to create table file");
+    }
+
+    size_t slab_mem = source->SlabMem();
+    slabs_.emplace_back(source->TakeAll());
+    current_mem_ += slab_mem;
+
+    auto& slab_ids = slabs_.back().id_array_;
+    ids_.insert(ids_.end(), slab_ids.begin(), slab_ids.end());
+    return Status::OK();
+}
+
+Status
+MemTableFile::MaterializeSlabs() {
+    // slabs deferred by the zero-copy insert path enter the engine in one
+    // bulk add per slab, right before the file is written
+    for (auto& slab : slabs_) {
+        server::CollectAddMetrics metrics(slab.vector_count_, table_file_schema_.dimension_);
+
+        Status status;
+        if (!slab.float_data_.empty()) {
+            // the slab path bypasses VectorSource::Add, so inner-product
+            // normalization happens here instead
+            if (table_file_schema_.metric_type_ == static_cast<int32_t>(MetricType::IP) && normalizer::Enabled()) {
+                normalizer::NormalizeVectors(slab.float_data_.data(), slab.vector_count_,
+                                             table_file_schema_.dimension_);
+            }
+            table_file_schema_.max_norm_ =
+                std::max(table_file_schema_.max_norm_,
+                         normalizer::MaxNorm(slab.float_data_.data(), slab.vector_count_, table_file_schema_.dimension_));
+            status = execution_engine_->AddWithIds(slab.vector_count_, slab.float_data_.data(), slab.id_array_.data());
+        } else if (!slab.binary_data_.empty()) {
+            status = execution_engine_->AddWithIds(slab.vector_count_, slab.binary_data_.data(), slab.id_array_.data());
+        }
+
+        if (!status.ok()) {
+            ENGINE_LOG_ERROR << "MemTableFile::MaterializeSlabs failed: " << status.ToString();
+            return status;
+        }
+
+        size_t prior_rows = attr_ids_.size();
+        attr_ids_.insert(attr_ids_.end(), slab.id_array_.begin(), slab.id_array_.end());
+        AttrSidecar::AppendColumns(attr_columns_, prior_rows, slab.attributes_, 0, slab.vector_count_);
+    }
+    slabs_.clear();
+    return Status::OK();
+}
+
 size_t
 MemTableFile::GetCurrentMem() {
     return current_mem_;
@@ -91,30 +166,89 @@ MemTableFile::Serialize() {
     size_t size = GetCurrentMem();
     server::CollectSerializeMetrics metrics(size);
 
-    execution_engine_->Serialize();
+    auto slab_status = MaterializeSlabs();
+    if (!slab_status.ok()) {
+        return slab_status;
+    }
+
+    // opt-in build-on-flush: a segment large enough to be indexed anyway is
+    // encoded into the table's index format right here when a trained
+    // quantizer from an earlier build is available, skipping the RAW
+    // intermediate and the background re-read it would take. The first
+    // segment of a table has no model yet and still goes through the regular
+    // RAW -> TO_INDEX pass, which seeds the model
+    bool built_inline = false;
+    if (options_.build_index_on_flush_ && !utils::IsRawIndexType(table_file_schema_.engine_type_) &&
+        size >= table_file_schema_.index_file_size_) {
+        try {
+            auto indexed_engine = execution_engine_->BuildIndexFromModel(
+                table_file_schema_.location_, (EngineType)table_file_schema_.engine_type_);
+            if (indexed_engine != nullptr) {
+                execution_engine_ = indexed_engine;
+                built_inline = true;
+            }
+        } catch (std::exception& e) {
+            // fall back to flushing raw; the background pass will index it
+            ENGINE_LOG_ERROR << "MemTableFile::Serialize build on flush failed: " << e.what();
+        }
+    }
+
+    {
+        server::ProfilerRegion region("flush_serialize");
+        execution_engine_->Serialize();
+    }
+
+    // scalar payloads land in a sidecar next to the segment; a write failure
+    // only loses filterability (the segment is searched unfiltered), so the
+    // flush itself is not failed over it
+    if (!attr_columns_.empty()) {
+        auto attr_status = AttrSidecar::Write(table_file_schema_.location_, attr_ids_, attr_columns_);
+        if (!attr_status.ok()) {
+            ENGINE_LOG_ERROR << "MemTableFile::Serialize attribute sidecar: " << attr_status.ToString();
+        }
+    }
+
     table_file_schema_.file_size_ = execution_engine_->PhysicalSize();
     table_file_schema_.row_count_ = execution_engine_->Count();
 
+    if (!ids_.empty()) {
+        auto minmax = std::minmax_element(ids_.begin(), ids_.end());
+        table_file_schema_.min_row_id_ = *minmax.first;
+        table_file_schema_.max_row_id_ = *minmax.second;
+    }
+
     // if index type isn't IDMAP, set file type to TO_INDEX if file size execeed index_file_size
     // else set file type to RAW, no need to build index
-    if (table_file_schema_.engine_type_ != (int)EngineType::FAISS_IDMAP &&
-        table_file_schema_.engine_type_ != (int)EngineType::FAISS_BIN_IDMAP) {
+    if (built_inline) {
+        table_file_schema_.file_type_ = meta::TableFileSchema::INDEX;
+    } else if (!utils::IsRawIndexType(table_file_schema_.engine_type_)) {
         table_file_schema_.file_type_ = (size >= table_file_schema_.index_file_size_) ? meta::TableFileSchema::TO_INDEX
                                                                                       : meta::TableFileSchema::RAW;
     } else {
         table_file_schema_.file_type_ = meta::TableFileSchema::RAW;
     }
 
-    auto status = meta_->UpdateTableFile(table_file_schema_);
-
-    ENGINE_LOG_DEBUG << "New " << ((table_file_schema_.file_type_ == meta::TableFileSchema::RAW) ? "raw" : "to_index")
-                     << " file " << table_file_schema_.file_id_ << " of size " << size << " bytes";
+    std::string file_kind = (table_file_schema_.file_type_ == meta::TableFileSchema::RAW)
+                                ? "raw"
+                                : (built_inline ? "index" : "to_index");
+    ENGINE_LOG_DEBUG << "New " << file_kind << " file " << table_file_schema_.file_id_ << " of size " << size
+                     << " bytes";
 
     if (options_.insert_cache_immediately_) {
         execution_engine_->Cache();
     }
 
-    return status;
+    return Status::OK();
+}
+
+const meta::TableFileSchema&
+MemTableFile::GetTableFileSchema() const {
+    return table_file_schema_;
+}
+
+void
+MemTableFile::RegisterIds() {
+    IdIndex::GetInstance().RegisterSegment(table_file_schema_.table_id_, table_file_schema_.location_, ids_);
 }
 
 }  // namespace engine
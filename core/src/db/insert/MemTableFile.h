@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace milvus {
 namespace engine {
@@ -29,6 +30,12 @@ class MemTableFile {
     Status
     Add(VectorSourcePtr& source);
 
+    // appends the source's whole payload as an owned slab without copying it
+    // into the engine; slabs are materialized in bulk when the file is
+    // serialized. The caller must ensure the slab fits GetMemLeft().
+    Status
+    AddSlab(VectorSourcePtr& source);
+
     size_t
     GetCurrentMem();
 
@@ -38,13 +45,27 @@ class MemTableFile {
     bool
     IsFull();
 
+    // writes the file's data to disk and fills in the final schema; the meta
+    // transition is NOT applied here, so the owning MemTable can commit a
+    // whole flush as one batched meta transaction
     Status
     Serialize();
 
+    // the schema to commit to meta once Serialize succeeded
+    const meta::TableFileSchema&
+    GetTableFileSchema() const;
+
+    // registers the file's ids with IdIndex; called after the meta commit
+    void
+    RegisterIds();
+
  private:
     Status
     CreateTableFile();
 
+    Status
+    MaterializeSlabs();
+
  private:
     const std::string table_id_;
     meta::TableFileSchema table_file_schema_;
@@ -52,6 +73,16 @@ class MemTableFile {
     DBOptions options_;
     size_t current_mem_;
 
+    std::vector<VectorsData> slabs_;
+
+    // every id in the file, registered with IdIndex when the file lands
+    IDNumbers ids_;
+
+    // scalar payloads destined for the segment's attribute sidecar, kept in
+    // engine add order (immediate adds first, then slabs in materialize order)
+    IDNumbers attr_ids_;
+    AttributeColumns attr_columns_;
+
     ExecutionEnginePtr execution_engine_;
 };  // MemTableFile
 
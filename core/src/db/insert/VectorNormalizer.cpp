@@ -0,0 +1,132 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/insert/VectorNormalizer.h"
+#include "server/Config.h"
+
+#include <cmath>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace milvus {
+namespace engine {
+namespace normalizer {
+
+namespace {
+
+void
+NormalizeScalar(float* data, int64_t count, int64_t dim) {
+    for (int64_t i = 0; i < count; i++) {
+        float* vec = data + i * dim;
+        float sum = 0.0f;
+        for (int64_t j = 0; j < dim; j++) {
+            sum += vec[j] * vec[j];
+        }
+        if (sum <= 0.0f) {
+            continue;
+        }
+        float inv_norm = 1.0f / std::sqrt(sum);
+        for (int64_t j = 0; j < dim; j++) {
+            vec[j] *= inv_norm;
+        }
+    }
+}
+
+#if defined(__GNUC__) && defined(__x86_64__)
+// fused norm+scale: the squared norm is accumulated with fma while the
+// vector streams through, then the same pass order is reused to scale, so
+// each vector is touched exactly twice while it is still cache-resident
+__attribute__((target("avx2,fma"))) void
+NormalizeAvx2(float* data, int64_t count, int64_t dim) {
+    const int64_t simd_dim = dim - (dim % 8);
+    for (int64_t i = 0; i < count; i++) {
+        float* vec = data + i * dim;
+
+        __m256 sum_vec = _mm256_setzero_ps();
+        for (int64_t j = 0; j < simd_dim; j += 8) {
+            __m256 v = _mm256_loadu_ps(vec + j);
+            sum_vec = _mm256_fmadd_ps(v, v, sum_vec);
+        }
+        __m128 lo = _mm256_castps256_ps128(sum_vec);
+        __m128 hi = _mm256_extractf128_ps(sum_vec, 1);
+        __m128 sum4 = _mm_add_ps(lo, hi);
+        sum4 = _mm_hadd_ps(sum4, sum4);
+        sum4 = _mm_hadd_ps(sum4, sum4);
+        float sum = _mm_cvtss_f32(sum4);
+        for (int64_t j = simd_dim; j < dim; j++) {
+            sum += vec[j] * vec[j];
+        }
+
+        if (sum <= 0.0f) {
+            continue;
+        }
+        float inv_norm = 1.0f / std::sqrt(sum);
+        __m256 scale = _mm256_set1_ps(inv_norm);
+        for (int64_t j = 0; j < simd_dim; j += 8) {
+            _mm256_storeu_ps(vec + j, _mm256_mul_ps(_mm256_loadu_ps(vec + j), scale));
+        }
+        for (int64_t j = simd_dim; j < dim; j++) {
+            vec[j] *= inv_norm;
+        }
+    }
+}
+
+bool
+Avx2Available() {
+    static bool available = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return available;
+}
+#endif
+
+}  // namespace
+
+bool
+Enabled() {
+    static bool enabled = [] {
+        bool value = false;
+        server::Config::GetInstance().GetEngineConfigAutoNormalize(value);
+        return value;
+    }();
+    return enabled;
+}
+
+void
+NormalizeVectors(float* data, int64_t count, int64_t dim) {
+#if defined(__GNUC__) && defined(__x86_64__)
+    if (Avx2Available()) {
+        NormalizeAvx2(data, count, dim);
+        return;
+    }
+#endif
+    NormalizeScalar(data, count, dim);
+}
+
+double
+MaxNorm(const float* data, int64_t count, int64_t dim) {
+    double max_sum = 0.0;
+    for (int64_t i = 0; i < count; i++) {
+        const float* vec = data + i * dim;
+        double sum = 0.0;
+        for (int64_t j = 0; j < dim; j++) {
+            sum += static_cast<double>(vec[j]) * vec[j];
+        }
+        if (sum > max_sum) {
+            max_sum = sum;
+        }
+    }
+    return std::sqrt(max_sum);
+}
+
+}  // namespace normalizer
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,42 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace milvus {
+namespace engine {
+
+// Server-side normalization for inner-product tables, so clients do not
+// have to pre-normalize vectors in their own pipelines. Applied in place
+// while vectors are copied into the mem engine, behind the opt-in
+// engine_config.auto_normalize knob.
+namespace normalizer {
+
+// reads engine_config.auto_normalize once and caches it
+bool
+Enabled();
+
+// scales each of the count vectors to unit L2 norm in place; zero vectors
+// are left untouched
+void
+NormalizeVectors(float* data, int64_t count, int64_t dim);
+
+// largest L2 norm among the count vectors; used as a per-file zone
+// statistic for pruning range queries
+double
+MaxNorm(const float* data, int64_t count, int64_t dim);
+
+}  // namespace normalizer
+
+}  // namespace engine
+}  // namespace milvus
@@ -12,14 +12,17 @@
 #include "db/insert/VectorSource.h"
 #include "db/engine/EngineFactory.h"
 #include "db/engine/ExecutionEngine.h"
+#include "db/insert/VectorNormalizer.h"
 #include "metrics/Metrics.h"
 #include "utils/Log.h"
 
+#include <algorithm>
+
 namespace milvus {
 namespace engine {
 
 VectorSource::VectorSource(VectorsData& vectors)
-    : vectors_(vectors), id_generator_(std::make_shared<SimpleIDGenerator>()) {
+    : vectors_(vectors), id_generator_(std::make_shared<ShardedIDGenerator>()) {
     current_num_vectors_added = 0;
 }
 
@@ -43,9 +46,26 @@ VectorSource::Add(const ExecutionEnginePtr& execution_engine, const meta::TableF
 
     Status status;
     if (!vectors_.float_data_.empty()) {
-        status = execution_engine->AddWithIds(
-            num_vectors_added, vectors_.float_data_.data() + current_num_vectors_added * table_file_schema.dimension_,
-            vector_ids_to_add.data());
+        float* slice = vectors_.float_data_.data() + current_num_vectors_added * table_file_schema.dimension_;
+
+        // inner-product tables need unit vectors; doing it here folds the
+        // math into the copy the engine pays for anyway
+        if (table_file_schema.metric_type_ == static_cast<int32_t>(MetricType::IP) && normalizer::Enabled()) {
+            normalizer::NormalizeVectors(slice, num_vectors_added, table_file_schema.dimension_);
+        }
+
+        max_norm_ = std::max(max_norm_, normalizer::MaxNorm(slice, num_vectors_added, table_file_schema.dimension_));
+
+        // dim_padding widens the engine to an aligned stride; restride the
+        // slice so each logical row lands at its padded offset
+        if (execution_engine->Dimension() > table_file_schema.dimension_) {
+            std::vector<float> padded_slice;
+            RestrideRows(num_vectors_added, table_file_schema.dimension_, execution_engine->Dimension(), slice,
+                         padded_slice);
+            status = execution_engine->AddWithIds(num_vectors_added, padded_slice.data(), vector_ids_to_add.data());
+        } else {
+            status = execution_engine->AddWithIds(num_vectors_added, slice, vector_ids_to_add.data());
+        }
     } else if (!vectors_.binary_data_.empty()) {
         status = execution_engine->AddWithIds(
             num_vectors_added,
@@ -69,6 +89,30 @@ VectorSource::GetNumVectorsAdded() {
     return current_num_vectors_added;
 }
 
+bool
+VectorSource::CanTakeAll() const {
+    return current_num_vectors_added == 0 && !vectors_.id_array_.empty() &&
+           vectors_.id_array_.size() == vectors_.vector_count_;
+}
+
+size_t
+VectorSource::SlabMem() const {
+    return vectors_.float_data_.size() * sizeof(float) + vectors_.binary_data_.size();
+}
+
+VectorsData
+VectorSource::TakeAll() {
+    VectorsData slab;
+    slab.vector_count_ = vectors_.vector_count_;
+    slab.float_data_ = std::move(vectors_.float_data_);
+    slab.binary_data_ = std::move(vectors_.binary_data_);
+    slab.id_array_ = vectors_.id_array_;
+
+    vector_ids_ = vectors_.id_array_;
+    current_num_vectors_added = vectors_.vector_count_;
+    return slab;
+}
+
 size_t
 VectorSource::SingleVectorSize(uint16_t dimension) {
     if (!vectors_.float_data_.empty()) {
@@ -90,5 +134,15 @@ VectorSource::GetVectorIds() {
     return vector_ids_;
 }
 
+const AttributeColumns&
+VectorSource::Attributes() const {
+    return vectors_.attributes_;
+}
+
+double
+VectorSource::MaxNorm() const {
+    return max_norm_;
+}
+
 }  // namespace engine
 }  // namespace milvus
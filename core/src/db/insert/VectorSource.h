@@ -12,6 +12,7 @@
 #pragma once
 
 #include "db/IDGenerator.h"
+#include "db/Types.h"
 #include "db/engine/ExecutionEngine.h"
 #include "db/meta/Meta.h"
 #include "utils/Status.h"
@@ -35,17 +36,40 @@ class VectorSource {
     size_t
     SingleVectorSize(uint16_t dimension);
 
+    // the zero-copy slab path is only valid for an untouched source whose
+    // ids were assigned up front, so nothing remains to generate or split
+    bool
+    CanTakeAll() const;
+
+    // payload bytes of the whole source
+    size_t
+    SlabMem() const;
+
+    // transfers ownership of the entire payload and marks the source added
+    VectorsData
+    TakeAll();
+
     bool
     AllAdded();
 
     IDNumbers
     GetVectorIds();
 
+    // per-row scalar payloads of the source, aligned with its row order
+    const AttributeColumns&
+    Attributes() const;
+
+    // largest L2 norm seen across all Add calls on this source, measured on
+    // the data as stored (i.e. after normalization, if enabled)
+    double
+    MaxNorm() const;
+
  private:
     VectorsData& vectors_;
     IDNumbers vector_ids_;
 
     size_t current_num_vectors_added;
+    double max_norm_ = 0.0;
 
     std::shared_ptr<IDGenerator> id_generator_;
 };  // VectorSource
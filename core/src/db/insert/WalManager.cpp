@@ -0,0 +1,346 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/insert/WalManager.h"
+#include "db/Constants.h"
+#include "utils/CommonUtil.h"
+#include "utils/Error.h"
+#include "utils/Log.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+
+namespace milvus {
+namespace engine {
+
+namespace {
+// marks the start of every record; a mismatch during replay means the tail
+// of the file was torn by a crash and replay stops there
+constexpr uint32_t WAL_RECORD_MAGIC = 0x6C61776D;  // "mwal"
+// a log file is closed and a new one started once it grows past this size,
+// so truncation can reclaim space in file-sized steps
+constexpr uint64_t WAL_FILE_SIZE_LIMIT = 256 * ONE_MB;
+
+#pragma pack(push, 1)
+struct RecordHeader {
+    uint32_t magic_;
+    uint64_t lsn_;
+    uint32_t table_id_size_;
+    uint64_t vector_count_;
+    uint64_t float_count_;
+    uint64_t binary_count_;
+    uint64_t id_count_;
+};
+#pragma pack(pop)
+
+std::string
+FilePath(const std::string& wal_path, uint64_t index) {
+    return wal_path + "/wal_" + std::to_string(index) + ".log";
+}
+
+bool
+WriteAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+}  // namespace
+
+WalManager::WalManager(const std::string& wal_path) : wal_path_(wal_path) {
+}
+
+WalManager::~WalManager() {
+    {
+        std::lock_guard<std::mutex> lock(commit_mutex_);
+        stop_ = true;
+    }
+    commit_cv_.notify_all();
+    if (commit_thread_.joinable()) {
+        commit_thread_.join();
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+Status
+WalManager::Open() {
+    auto status = server::CommonUtil::CreateDirectory(wal_path_);
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Failed to create wal directory: " << wal_path_;
+        return status;
+    }
+
+    // surviving files are replayed later; appending continues in a fresh
+    // file after the highest existing index
+    uint64_t max_index = 0;
+    boost::filesystem::directory_iterator end_it;
+    for (boost::filesystem::directory_iterator it(wal_path_); it != end_it; ++it) {
+        std::string name = it->path().filename().string();
+        if (name.compare(0, 4, "wal_") != 0) {
+            continue;
+        }
+        uint64_t index = std::stoull(name.substr(4));
+        max_index = std::max(max_index, index);
+    }
+
+    file_index_ = max_index;
+    auto roll_status = RollFile();
+    if (!roll_status.ok()) {
+        return roll_status;
+    }
+
+    commit_thread_ = std::thread(&WalManager::CommitLoop, this);
+    return Status::OK();
+}
+
+Status
+WalManager::RollFile() {
+    if (fd_ >= 0) {
+        ::fsync(fd_);
+        ::close(fd_);
+        closed_files_[FilePath(wal_path_, file_index_)] = next_lsn_;
+    }
+
+    file_index_++;
+    std::string path = FilePath(wal_path_, file_index_);
+    fd_ = ::open(path.c_str(), O_CREAT | O_WRONLY | O_APPEND, 0644);
+    if (fd_ < 0) {
+        std::string msg = "Failed to create wal file: " + path;
+        ENGINE_LOG_ERROR << msg;
+        return Status(SERVER_CANNOT_CREATE_FILE, msg);
+    }
+    file_size_ = 0;
+    return Status::OK();
+}
+
+Status
+WalManager::Append(const std::string& table_id, const VectorsData& vectors) {
+    RecordHeader header;
+    header.magic_ = WAL_RECORD_MAGIC;
+    header.table_id_size_ = static_cast<uint32_t>(table_id.size());
+    header.vector_count_ = vectors.vector_count_;
+    header.float_count_ = vectors.float_data_.size();
+    header.binary_count_ = vectors.binary_data_.size();
+    header.id_count_ = vectors.id_array_.size();
+
+    uint64_t my_lsn = 0;
+    {
+        // appends are serialized under a short lock; the expensive part,
+        // the disk sync, happens in the commit thread for a whole group
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (fd_ < 0) {
+            return Status(SERVER_WRITE_ERROR, "wal is not open");
+        }
+        if (file_size_ >= WAL_FILE_SIZE_LIMIT) {
+            auto status = RollFile();
+            if (!status.ok()) {
+                return status;
+            }
+        }
+
+        my_lsn = ++next_lsn_;
+        header.lsn_ = my_lsn;
+
+        bool ok = WriteAll(fd_, reinterpret_cast<const char*>(&header), sizeof(header)) &&
+                  WriteAll(fd_, table_id.data(), table_id.size()) &&
+                  WriteAll(fd_, reinterpret_cast<const char*>(vectors.float_data_.data()),
+                           vectors.float_data_.size() * sizeof(float)) &&
+                  WriteAll(fd_, reinterpret_cast<const char*>(vectors.binary_data_.data()),
+                           vectors.binary_data_.size()) &&
+                  WriteAll(fd_, reinterpret_cast<const char*>(vectors.id_array_.data()),
+                           vectors.id_array_.size() * sizeof(IDNumber));
+        if (!ok) {
+            std::string msg = "Failed to write wal record of table " + table_id;
+            ENGINE_LOG_ERROR << msg;
+            return Status(SERVER_WRITE_ERROR, msg);
+        }
+
+        file_size_ += sizeof(header) + table_id.size() + vectors.float_data_.size() * sizeof(float) +
+                      vectors.binary_data_.size() + vectors.id_array_.size() * sizeof(IDNumber);
+    }
+
+    // group commit: wake the commit thread and wait until a sync covers us;
+    // writers arriving while a sync is in flight share the next one
+    std::unique_lock<std::mutex> lock(commit_mutex_);
+    appended_lsn_ = std::max(appended_lsn_, my_lsn);
+    commit_cv_.notify_one();
+    durable_cv_.wait(lock, [this, my_lsn] { return durable_lsn_ >= my_lsn || stop_; });
+    if (durable_lsn_ < my_lsn) {
+        return Status(SERVER_WRITE_ERROR, "wal is shutting down");
+    }
+    return Status::OK();
+}
+
+void
+WalManager::CommitLoop() {
+    while (true) {
+        uint64_t sync_to = 0;
+        {
+            std::unique_lock<std::mutex> lock(commit_mutex_);
+            commit_cv_.wait(lock, [this] { return appended_lsn_ > durable_lsn_ || stop_; });
+            if (stop_ && appended_lsn_ <= durable_lsn_) {
+                durable_cv_.notify_all();
+                return;
+            }
+            sync_to = appended_lsn_;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (fd_ >= 0) {
+                ::fsync(fd_);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(commit_mutex_);
+            durable_lsn_ = std::max(durable_lsn_, sync_to);
+        }
+        durable_cv_.notify_all();
+    }
+}
+
+uint64_t
+WalManager::CurrentLsn() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return next_lsn_;
+}
+
+Status
+WalManager::Truncate(uint64_t lsn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto it = closed_files_.begin(); it != closed_files_.end();) {
+        if (it->second <= lsn) {
+            boost::filesystem::remove(it->first);
+            it = closed_files_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // if every record ever appended is covered, the active file can be
+    // recycled in place instead of waiting to fill up and roll
+    if (lsn >= next_lsn_ && fd_ >= 0 && file_size_ > 0) {
+        if (::ftruncate(fd_, 0) == 0) {
+            file_size_ = 0;
+        }
+    }
+
+    return Status::OK();
+}
+
+Status
+WalManager::Replay(const ReplayHandler& handler) {
+    std::map<uint64_t, std::string> files;
+    boost::filesystem::directory_iterator end_it;
+    for (boost::filesystem::directory_iterator it(wal_path_); it != end_it; ++it) {
+        std::string name = it->path().filename().string();
+        if (name.compare(0, 4, "wal_") != 0) {
+            continue;
+        }
+        files[std::stoull(name.substr(4))] = it->path().string();
+    }
+
+    uint64_t max_lsn = 0;
+    uint64_t replayed = 0;
+    std::map<std::string, uint64_t> replayed_files;
+    for (auto& kv : files) {
+        uint64_t file_lsn = 0;
+        auto status = ReplayFile(kv.second, handler, file_lsn);
+        if (!status.ok()) {
+            return status;
+        }
+        max_lsn = std::max(max_lsn, file_lsn);
+        if (kv.first != file_index_) {
+            // survivors from the previous run become truncatable once a
+            // flush covers their highest lsn
+            replayed_files[kv.second] = file_lsn;
+        }
+        replayed++;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_files_.insert(replayed_files.begin(), replayed_files.end());
+    next_lsn_ = std::max(next_lsn_, max_lsn);
+    if (replayed > 0) {
+        ENGINE_LOG_DEBUG << "Replayed " << replayed << " wal file(s), last lsn " << max_lsn;
+    }
+    return Status::OK();
+}
+
+Status
+WalManager::ReplayFile(const std::string& path, const ReplayHandler& handler, uint64_t& max_lsn) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return Status(SERVER_FILE_NOT_FOUND, "Failed to open wal file: " + path);
+    }
+
+    while (true) {
+        RecordHeader header;
+        ssize_t nread = ::read(fd, &header, sizeof(header));
+        if (nread == 0) {
+            break;  // clean end of file
+        }
+        if (nread != static_cast<ssize_t>(sizeof(header)) || header.magic_ != WAL_RECORD_MAGIC) {
+            ENGINE_LOG_WARNING << "Torn record at tail of wal file " << path << ", replay stops there";
+            break;
+        }
+
+        std::string table_id(header.table_id_size_, '\0');
+        VectorsData vectors;
+        vectors.vector_count_ = header.vector_count_;
+        vectors.float_data_.resize(header.float_count_);
+        vectors.binary_data_.resize(header.binary_count_);
+        vectors.id_array_.resize(header.id_count_);
+
+        size_t payload_size = header.table_id_size_ + header.float_count_ * sizeof(float) + header.binary_count_ +
+                              header.id_count_ * sizeof(IDNumber);
+        bool ok = ::read(fd, &table_id[0], header.table_id_size_) == static_cast<ssize_t>(header.table_id_size_);
+        ok = ok && ::read(fd, vectors.float_data_.data(), header.float_count_ * sizeof(float)) ==
+                       static_cast<ssize_t>(header.float_count_ * sizeof(float));
+        ok = ok && ::read(fd, vectors.binary_data_.data(), header.binary_count_) ==
+                       static_cast<ssize_t>(header.binary_count_);
+        ok = ok && ::read(fd, vectors.id_array_.data(), header.id_count_ * sizeof(IDNumber)) ==
+                       static_cast<ssize_t>(header.id_count_ * sizeof(IDNumber));
+        if (!ok) {
+            ENGINE_LOG_WARNING << "Incomplete record (" << payload_size << " byte payload) at tail of wal file "
+                               << path << ", replay stops there";
+            break;
+        }
+
+        max_lsn = std::max(max_lsn, header.lsn_);
+        auto status = handler(table_id, vectors);
+        if (!status.ok()) {
+            ::close(fd);
+            return status;
+        }
+    }
+
+    ::close(fd);
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,97 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Types.h"
+#include "utils/Status.h"
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// Append-only write-ahead log for inserts. An insert is durable once
+// Append returns: records from concurrent writers are appended under a
+// short lock and a dedicated commit thread fsyncs them in groups, so many
+// writers share one disk sync. The log rolls to a new file at a fixed
+// size; after a full flush lands every record up to the pre-flush LSN in
+// segment files, Truncate drops the covered log files. On restart, Replay
+// feeds the surviving records back into the insert path.
+class WalManager {
+ public:
+    explicit WalManager(const std::string& wal_path);
+    ~WalManager();
+
+    Status
+    Open();
+
+    // blocks until the record is on stable storage
+    Status
+    Append(const std::string& table_id, const VectorsData& vectors);
+
+    // LSN of the most recently appended record
+    uint64_t
+    CurrentLsn();
+
+    // drops log files whose records are all covered by lsn
+    Status
+    Truncate(uint64_t lsn);
+
+    using ReplayHandler = std::function<Status(const std::string& table_id, VectorsData& vectors)>;
+
+    // replays surviving records in append order; a torn tail record from a
+    // crash mid-write ends the replay cleanly
+    Status
+    Replay(const ReplayHandler& handler);
+
+ private:
+    void
+    CommitLoop();
+
+    Status
+    RollFile();
+
+    Status
+    ReplayFile(const std::string& path, const ReplayHandler& handler, uint64_t& max_lsn);
+
+ private:
+    const std::string wal_path_;
+
+    std::mutex mutex_;
+    int fd_ = -1;
+    uint64_t file_index_ = 0;
+    uint64_t file_size_ = 0;
+    uint64_t next_lsn_ = 0;
+    // closed files pending truncation: file path -> last lsn it contains
+    std::map<std::string, uint64_t> closed_files_;
+
+    // group commit state
+    std::mutex commit_mutex_;
+    std::condition_variable commit_cv_;
+    std::condition_variable durable_cv_;
+    uint64_t appended_lsn_ = 0;
+    uint64_t durable_lsn_ = 0;
+    bool stop_ = false;
+    std::thread commit_thread_;
+};
+
+using WalManagerPtr = std::shared_ptr<WalManager>;
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,407 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/meta/CachedMetaImpl.h"
+#include "utils/Log.h"
+#include "utils/StringHelpFunctions.h"
+
+#include <utility>
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+CachedMetaImpl::CachedMetaImpl(const MetaPtr& backend) : backend_(backend) {
+    Reload();
+}
+
+void
+CachedMetaImpl::Reload() {
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+
+    auto snapshot = std::make_shared<Snapshot>();
+    auto status = backend_->AllTables(snapshot->tables_);
+    if (!status.ok()) {
+        ENGINE_LOG_WARNING << "Failed to build meta snapshot, reads fall through: " << status.ToString();
+        std::atomic_store(&snapshot_, SnapshotPtr());
+        return;
+    }
+
+    for (size_t i = 0; i < snapshot->tables_.size(); i++) {
+        auto& schema = snapshot->tables_[i];
+        snapshot->table_index_[schema.table_id_] = i;
+        if (!schema.owner_table_.empty()) {
+            snapshot->owners_[schema.owner_table_].push_back(i);
+        }
+    }
+
+    std::atomic_store(&snapshot_, SnapshotPtr(std::move(snapshot)));
+}
+
+CachedMetaImpl::SnapshotPtr
+CachedMetaImpl::Current() const {
+    return std::atomic_load(&snapshot_);
+}
+
+Status
+CachedMetaImpl::CreateTable(TableSchema& table_schema) {
+    auto status = backend_->CreateTable(table_schema);
+    if (status.ok()) {
+        Reload();
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::DescribeTable(TableSchema& table_schema) {
+    auto snapshot = Current();
+    if (snapshot == nullptr) {
+        return backend_->DescribeTable(table_schema);
+    }
+
+    auto iter = snapshot->table_index_.find(table_schema.table_id_);
+    if (iter == snapshot->table_index_.end()) {
+        return Status(DB_NOT_FOUND, "Table " + table_schema.table_id_ + " not found");
+    }
+    table_schema = snapshot->tables_[iter->second];
+    return Status::OK();
+}
+
+Status
+CachedMetaImpl::HasTable(const std::string& table_id, bool& has_or_not) {
+    auto snapshot = Current();
+    if (snapshot == nullptr) {
+        return backend_->HasTable(table_id, has_or_not);
+    }
+
+    has_or_not = snapshot->table_index_.find(table_id) != snapshot->table_index_.end();
+    return Status::OK();
+}
+
+Status
+CachedMetaImpl::AllTables(std::vector<TableSchema>& table_schema_array) {
+    auto snapshot = Current();
+    if (snapshot == nullptr) {
+        return backend_->AllTables(table_schema_array);
+    }
+
+    table_schema_array.insert(table_schema_array.end(), snapshot->tables_.begin(), snapshot->tables_.end());
+    return Status::OK();
+}
+
+Status
+CachedMetaImpl::UpdateTableFlag(const std::string& table_id, int64_t flag) {
+    auto status = backend_->UpdateTableFlag(table_id, flag);
+    if (status.ok()) {
+        Reload();
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::DropTable(const std::string& table_id) {
+    auto status = backend_->DropTable(table_id);
+    if (status.ok()) {
+        InvalidateStats(table_id);
+        Reload();
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::DeleteTableFiles(const std::string& table_id) {
+    auto status = backend_->DeleteTableFiles(table_id);
+    if (status.ok()) {
+        InvalidateStats(table_id);
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::CreateTableFile(TableFileSchema& file_schema) {
+    // a new file starts in NEW state, which the aggregates do not count; it
+    // enters them through the UpdateTableFile(s) that lands it
+    return backend_->CreateTableFile(file_schema);
+}
+
+Status
+CachedMetaImpl::DropDataByDate(const std::string& table_id, const DatesT& dates) {
+    auto status = backend_->DropDataByDate(table_id, dates);
+    if (status.ok()) {
+        InvalidateStats(table_id);
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::GetTableFiles(const std::string& table_id, const std::vector<size_t>& ids,
+                              TableFilesSchema& table_files) {
+    return backend_->GetTableFiles(table_id, ids, table_files);
+}
+
+Status
+CachedMetaImpl::UpdateTableFile(TableFileSchema& file_schema) {
+    auto status = backend_->UpdateTableFile(file_schema);
+    if (status.ok()) {
+        InvalidateStats(file_schema.table_id_);
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::UpdateTableFiles(TableFilesSchema& files) {
+    auto status = backend_->UpdateTableFiles(files);
+    if (status.ok()) {
+        for (auto& file : files) {
+            InvalidateStats(file.table_id_);
+        }
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::UpdateTableIndex(const std::string& table_id, const TableIndex& index) {
+    auto status = backend_->UpdateTableIndex(table_id, index);
+    if (status.ok()) {
+        Reload();
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::UpdateTableIndexRolling(const std::string& table_id, const TableIndex& index) {
+    auto status = backend_->UpdateTableIndexRolling(table_id, index);
+    if (status.ok()) {
+        Reload();
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::RetireSupersededIndexFile(const TableFileSchema& index_file) {
+    auto status = backend_->RetireSupersededIndexFile(index_file);
+    if (status.ok()) {
+        InvalidateStats(index_file.table_id_);
+        Reload();
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::UpdateTableFilesToIndex(const std::string& table_id) {
+    auto status = backend_->UpdateTableFilesToIndex(table_id);
+    if (status.ok()) {
+        InvalidateStats(table_id);
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::DescribeTableIndex(const std::string& table_id, TableIndex& index) {
+    auto snapshot = Current();
+    if (snapshot == nullptr) {
+        return backend_->DescribeTableIndex(table_id, index);
+    }
+
+    auto iter = snapshot->table_index_.find(table_id);
+    if (iter == snapshot->table_index_.end()) {
+        return Status(DB_NOT_FOUND, "Table " + table_id + " not found");
+    }
+
+    auto& schema = snapshot->tables_[iter->second];
+    index.engine_type_ = schema.engine_type_;
+    index.nlist_ = schema.nlist_;
+    index.metric_type_ = schema.metric_type_;
+    return Status::OK();
+}
+
+Status
+CachedMetaImpl::DropTableIndex(const std::string& table_id) {
+    auto status = backend_->DropTableIndex(table_id);
+    if (status.ok()) {
+        InvalidateStats(table_id);
+        Reload();
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::CreatePartition(const std::string& table_name, const std::string& partition_name,
+                                const std::string& tag) {
+    auto status = backend_->CreatePartition(table_name, partition_name, tag);
+    if (status.ok()) {
+        Reload();
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::DropPartition(const std::string& partition_name) {
+    auto status = backend_->DropPartition(partition_name);
+    if (status.ok()) {
+        InvalidateStats(partition_name);
+        Reload();
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::ShowPartitions(const std::string& table_name, std::vector<meta::TableSchema>& partition_schema_array) {
+    auto snapshot = Current();
+    if (snapshot == nullptr) {
+        return backend_->ShowPartitions(table_name, partition_schema_array);
+    }
+
+    auto iter = snapshot->owners_.find(table_name);
+    if (iter != snapshot->owners_.end()) {
+        for (auto index : iter->second) {
+            partition_schema_array.emplace_back(snapshot->tables_[index]);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+CachedMetaImpl::GetPartitionName(const std::string& table_name, const std::string& tag, std::string& partition_name) {
+    auto snapshot = Current();
+    if (snapshot == nullptr) {
+        return backend_->GetPartitionName(table_name, tag, partition_name);
+    }
+
+    // trim side-blank of tag, only compare valid characters
+    std::string valid_tag = tag;
+    server::StringHelpFunctions::TrimStringBlank(valid_tag);
+
+    auto iter = snapshot->owners_.find(table_name);
+    if (iter != snapshot->owners_.end()) {
+        for (auto index : iter->second) {
+            if (snapshot->tables_[index].partition_tag_ == valid_tag) {
+                partition_name = snapshot->tables_[index].table_id_;
+                return Status::OK();
+            }
+        }
+    }
+    return Status(DB_NOT_FOUND, "Table " + table_name + "'s partition " + valid_tag + " not found");
+}
+
+Status
+CachedMetaImpl::FilesToSearch(const std::string& table_id, const std::vector<size_t>& ids, const DatesT& dates,
+                              DatePartionedTableFilesSchema& files) {
+    return backend_->FilesToSearch(table_id, ids, dates, files);
+}
+
+Status
+CachedMetaImpl::FilesToMerge(const std::string& table_id, DatePartionedTableFilesSchema& files) {
+    return backend_->FilesToMerge(table_id, files);
+}
+
+Status
+CachedMetaImpl::FilesToIndex(TableFilesSchema& files) {
+    return backend_->FilesToIndex(files);
+}
+
+Status
+CachedMetaImpl::FilesByType(const std::string& table_id, const std::vector<int>& file_types,
+                            TableFilesSchema& table_files) {
+    return backend_->FilesByType(table_id, file_types, table_files);
+}
+
+Status
+CachedMetaImpl::Size(uint64_t& result) {
+    return backend_->Size(result);
+}
+
+Status
+CachedMetaImpl::Archive() {
+    auto status = backend_->Archive();
+    if (status.ok()) {
+        // archiving may retire files of any table
+        InvalidateStats("");
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::CleanUpShadowFiles() {
+    return backend_->CleanUpShadowFiles();
+}
+
+Status
+CachedMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
+    return backend_->CleanUpFilesWithTTL(seconds, filter);
+}
+
+Status
+CachedMetaImpl::DropAll() {
+    auto status = backend_->DropAll();
+    if (status.ok()) {
+        InvalidateStats("");
+        Reload();
+    }
+    return status;
+}
+
+Status
+CachedMetaImpl::Count(const std::string& table_id, uint64_t& result) {
+    bool has_table = false;
+    auto status = HasTable(table_id, has_table);
+    if (!status.ok()) {
+        return status;
+    }
+    if (!has_table) {
+        return Status(DB_NOT_FOUND, "Table " + table_id + " not found");
+    }
+
+    TableStats stats;
+    status = GetTableStats(table_id, stats);
+    if (!status.ok()) {
+        return status;
+    }
+    result = stats.row_count_;
+    return Status::OK();
+}
+
+Status
+CachedMetaImpl::GetTableStats(const std::string& table_id, TableStats& stats) {
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        auto iter = stats_.find(table_id);
+        if (iter != stats_.end()) {
+            stats = iter->second;
+            return Status::OK();
+        }
+    }
+
+    TableStats fetched;
+    auto status = backend_->GetTableStats(table_id, fetched);
+    if (!status.ok()) {
+        return status;
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_[table_id] = fetched;
+    stats = fetched;
+    return Status::OK();
+}
+
+void
+CachedMetaImpl::InvalidateStats(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    if (table_id.empty()) {
+        stats_.clear();
+    } else {
+        stats_.erase(table_id);
+    }
+}
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,181 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "Meta.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+// Decorator that keeps an in-memory snapshot of all table/partition rows in
+// front of a backend Meta. Table-level reads (DescribeTable, HasTable,
+// GetPartitionName, ...) are served from the snapshot without touching SQL;
+// readers grab the current snapshot through an atomic shared_ptr load, so
+// they never take a lock. Table-level mutations are written through to the
+// backend first and the snapshot is rebuilt afterwards, so durability is
+// exactly what the backend provides. File-level calls pass straight through:
+// file state churns with every flush/merge and the backends own the
+// filtering logic for it; on success they invalidate the per-table
+// aggregates kept for Count/GetTableStats.
+//
+// Only safe when this process is the sole writer of the backend, i.e. the
+// embedded sqlite meta. A shared MySQL meta is mutated by other nodes and
+// cannot be snapshotted coherently here.
+class CachedMetaImpl : public Meta {
+ public:
+    explicit CachedMetaImpl(const MetaPtr& backend);
+
+    Status
+    CreateTable(TableSchema& table_schema) override;
+
+    Status
+    DescribeTable(TableSchema& table_schema) override;
+
+    Status
+    HasTable(const std::string& table_id, bool& has_or_not) override;
+
+    Status
+    AllTables(std::vector<TableSchema>& table_schema_array) override;
+
+    Status
+    UpdateTableFlag(const std::string& table_id, int64_t flag) override;
+
+    Status
+    DropTable(const std::string& table_id) override;
+
+    Status
+    DeleteTableFiles(const std::string& table_id) override;
+
+    Status
+    CreateTableFile(TableFileSchema& file_schema) override;
+
+    Status
+    DropDataByDate(const std::string& table_id, const DatesT& dates) override;
+
+    Status
+    GetTableFiles(const std::string& table_id, const std::vector<size_t>& ids, TableFilesSchema& table_files) override;
+
+    Status
+    UpdateTableFile(TableFileSchema& file_schema) override;
+
+    Status
+    UpdateTableFiles(TableFilesSchema& files) override;
+
+    Status
+    UpdateTableIndex(const std::string& table_id, const TableIndex& index) override;
+
+    Status
+    UpdateTableIndexRolling(const std::string& table_id, const TableIndex& index) override;
+
+    Status
+    RetireSupersededIndexFile(const TableFileSchema& index_file) override;
+
+    Status
+    UpdateTableFilesToIndex(const std::string& table_id) override;
+
+    Status
+    DescribeTableIndex(const std::string& table_id, TableIndex& index) override;
+
+    Status
+    DropTableIndex(const std::string& table_id) override;
+
+    Status
+    CreatePartition(const std::string& table_name, const std::string& partition_name, const std::string& tag) override;
+
+    Status
+    DropPartition(const std::string& partition_name) override;
+
+    Status
+    ShowPartitions(const std::string& table_name, std::vector<meta::TableSchema>& partition_schema_array) override;
+
+    Status
+    GetPartitionName(const std::string& table_name, const std::string& tag, std::string& partition_name) override;
+
+    Status
+    FilesToSearch(const std::string& table_id, const std::vector<size_t>& ids, const DatesT& dates,
+                  DatePartionedTableFilesSchema& files) override;
+
+    Status
+    FilesToMerge(const std::string& table_id, DatePartionedTableFilesSchema& files) override;
+
+    Status
+    FilesToIndex(TableFilesSchema&) override;
+
+    Status
+    FilesByType(const std::string& table_id, const std::vector<int>& file_types, TableFilesSchema& table_files) override;
+
+    Status
+    Size(uint64_t& result) override;
+
+    Status
+    Archive() override;
+
+    Status
+    CleanUpShadowFiles() override;
+
+    Status
+    CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter = nullptr) override;
+
+    Status
+    DropAll() override;
+
+    Status
+    Count(const std::string& table_id, uint64_t& result) override;
+
+    Status
+    GetTableStats(const std::string& table_id, TableStats& stats) override;
+
+ private:
+    // immutable once published; replaced wholesale on every table mutation
+    struct Snapshot {
+        std::vector<TableSchema> tables_;
+        std::unordered_map<std::string, size_t> table_index_;          // table_id -> index in tables_
+        std::unordered_map<std::string, std::vector<size_t>> owners_;  // owner table -> partition indices
+    };
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
+    // rebuilds the snapshot from the backend; on failure publishes an empty
+    // pointer so reads fall through to the backend until the next rebuild
+    void
+    Reload();
+
+    SnapshotPtr
+    Current() const;
+
+    // drops the cached aggregates of one table (or of all tables when the
+    // id is empty), forcing the next stats read to re-query the backend
+    void
+    InvalidateStats(const std::string& table_id);
+
+ private:
+    MetaPtr backend_;
+    SnapshotPtr snapshot_;
+    std::mutex reload_mutex_;
+
+    // per-table aggregates (row count, byte size, file count) filled lazily
+    // from the backend and invalidated by the file-level write-throughs, so
+    // polling Count/GetTableStats touches SQL only after a flush/merge/drop
+    // actually changed the table
+    std::mutex stats_mutex_;
+    std::unordered_map<std::string, TableStats> stats_;
+};  // CachedMetaImpl
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
@@ -78,6 +78,17 @@ class Meta {
     virtual Status
     UpdateTableIndex(const std::string& table_id, const TableIndex& index) = 0;
 
+    // Rolling variant of UpdateTableIndex: existing index files are left in
+    // place so queries keep using them, and the raw backups are queued as
+    // TO_UPGRADE for the background build pass to replace one by one.
+    virtual Status
+    UpdateTableIndexRolling(const std::string& table_id, const TableIndex& index) = 0;
+
+    // After a rolling rebuild produced `index_file`, mark the older index
+    // file(s) built from the same raw source as TO_DELETE.
+    virtual Status
+    RetireSupersededIndexFile(const TableFileSchema& index_file) = 0;
+
     virtual Status
     UpdateTableFilesToIndex(const std::string& table_id) = 0;
 
@@ -129,6 +140,11 @@ class Meta {
 
     virtual Status
     Count(const std::string& table_id, uint64_t& result) = 0;
+
+    // aggregate row count, byte size and file count over the stored files of
+    // the given table row; partitions are separate rows and not included
+    virtual Status
+    GetTableStats(const std::string& table_id, TableStats& stats) = 0;
 };  // MetaData
 
 using MetaPtr = std::shared_ptr<Meta>;
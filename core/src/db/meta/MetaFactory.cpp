@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/meta/MetaFactory.h"
+#include "CachedMetaImpl.h"
 #include "MySQLMetaImpl.h"
 #include "SqliteMetaImpl.h"
 #include "db/Utils.h"
@@ -55,11 +56,15 @@ MetaFactory::Build(const DBMetaOptions& metaOptions, const int& mode) {
     }
 
     if (strcasecmp(uri_info.dialect_.c_str(), "mysql") == 0) {
+        // a MySQL meta may be shared by several milvus nodes, so a local
+        // snapshot cannot stay coherent; serve it uncached
         ENGINE_LOG_INFO << "Using MySQL";
         return std::make_shared<meta::MySQLMetaImpl>(metaOptions, mode);
     } else if (strcasecmp(uri_info.dialect_.c_str(), "sqlite") == 0) {
+        // this process is the only writer of an embedded sqlite meta, so
+        // table-level reads are served from an in-memory snapshot
         ENGINE_LOG_INFO << "Using SQLite";
-        return std::make_shared<meta::SqliteMetaImpl>(metaOptions);
+        return std::make_shared<meta::CachedMetaImpl>(std::make_shared<meta::SqliteMetaImpl>(metaOptions));
     } else {
         ENGINE_LOG_ERROR << "Invalid dialect in URI: dialect = " << uri_info.dialect_;
         throw InvalidArgumentException("URI dialect is not mysql / sqlite");
@@ -68,6 +68,10 @@ struct TableFileSchema {
         NEW_MERGE,
         NEW_INDEX,
         BACKUP,
+        // a raw backup queued for an index rebuild during a rolling index
+        // upgrade; never searched, because the index file built from it is
+        // still serving its rows
+        TO_UPGRADE,
     } FILE_TYPE;
 
     size_t id_ = 0;
@@ -85,7 +89,28 @@ struct TableFileSchema {
     int32_t engine_type_ = DEFAULT_ENGINE_TYPE;
     int32_t nlist_ = DEFAULT_NLIST;              // not persist to meta
     int32_t metric_type_ = DEFAULT_METRIC_TYPE;  // not persist to meta
-};                                               // TableFileSchema
+
+    // zone statistics computed while the file is written, for pruning files
+    // that cannot contribute to a query. min/max are 0/0 and the norm 0.0
+    // for files flushed before these columns existed.
+    int64_t min_row_id_ = 0;
+    int64_t max_row_id_ = 0;
+    double max_norm_ = 0.0;
+
+    // for index files: file_id of the raw file the index was built from, so a
+    // rolling index upgrade can retire the superseded index of the same
+    // segment. Empty for raw files and for index files built before this
+    // column existed.
+    std::string source_file_id_;
+};  // TableFileSchema
+
+// aggregate over the stored (RAW/TO_INDEX/INDEX) files of one table row,
+// i.e. one parent table or one partition
+struct TableStats {
+    uint64_t row_count_ = 0;
+    uint64_t data_size_ = 0;
+    uint64_t file_count_ = 0;
+};  // TableStats
 
 using TableFileSchemaPtr = std::shared_ptr<meta::TableFileSchema>;
 using TableFilesSchema = std::vector<TableFileSchema>;
@@ -16,18 +16,45 @@ namespace milvus {
 namespace engine {
 namespace meta {
 
+MySQLConnectionPool::~MySQLConnectionPool() {
+    {
+        std::lock_guard<std::mutex> lock(worker_mutex_);
+        worker_stop_ = true;
+    }
+    worker_cv_.notify_all();
+    if (worker_thread_.joinable()) {
+        worker_thread_.join();
+    }
+
+    clear();
+}
+
 // Do a simple form of in-use connection limiting: wait to return
 // a connection until there are a reasonably low number in use
 // already.  Can't do this in create() because we're interested in
 // connections actually in use, not those created.  Also note that
 // we keep our own count; ConnectionPool::size() isn't the same!
+// The pool grows on demand up to hard_max_pool_size_; surge
+// connections above max_pool_size_ are retired by max_idle_time().
 mysqlpp::Connection*
 MySQLConnectionPool::grab() {
-    while (conns_in_use_ > max_pool_size_) {
-        sleep(1);
+    {
+        std::unique_lock<std::mutex> lock(pool_mutex_);
+        pool_cv_.wait(lock, [this] { return conns_in_use_ < hard_max_pool_size_; });
+        ++conns_in_use_;
     }
+    return mysqlpp::ConnectionPool::grab();
+}
 
-    ++conns_in_use_;
+mysqlpp::Connection*
+MySQLConnectionPool::TryGrab(std::chrono::milliseconds deadline) {
+    {
+        std::unique_lock<std::mutex> lock(pool_mutex_);
+        if (!pool_cv_.wait_for(lock, deadline, [this] { return conns_in_use_ < hard_max_pool_size_; })) {
+            return nullptr;
+        }
+        ++conns_in_use_;
+    }
     return mysqlpp::ConnectionPool::grab();
 }
 
@@ -35,11 +62,62 @@ MySQLConnectionPool::grab() {
 void
 MySQLConnectionPool::release(const mysqlpp::Connection* pc) {
     mysqlpp::ConnectionPool::release(pc);
-    if (conns_in_use_ <= 0) {
-        ENGINE_LOG_WARNING << "MySQLConnetionPool::release: conns_in_use_ is less than zero.  conns_in_use_ = "
-                           << conns_in_use_;
-    } else {
-        --conns_in_use_;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        if (conns_in_use_ <= 0) {
+            ENGINE_LOG_WARNING << "MySQLConnetionPool::release: conns_in_use_ is less than zero.  conns_in_use_ = "
+                               << conns_in_use_;
+        } else {
+            --conns_in_use_;
+        }
+    }
+    pool_cv_.notify_one();
+}
+
+std::future<void>
+MySQLConnectionPool::SubmitAsync(std::function<void(mysqlpp::Connection*)> work) {
+    std::packaged_task<void(mysqlpp::Connection*)> task(std::move(work));
+    auto result = task.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(worker_mutex_);
+        if (!worker_started_) {
+            worker_thread_ = std::thread(&MySQLConnectionPool::BackgroundWorker, this);
+            worker_started_ = true;
+        }
+        worker_queue_.emplace_back(std::move(task));
+    }
+    worker_cv_.notify_one();
+    return result;
+}
+
+void
+MySQLConnectionPool::BackgroundWorker() {
+    // the worker's connection lives outside the pool cap, so background
+    // bookkeeping never starves a foreground grab
+    mysqlpp::Connection* conn = create();
+
+    while (true) {
+        std::packaged_task<void(mysqlpp::Connection*)> task;
+        {
+            std::unique_lock<std::mutex> lock(worker_mutex_);
+            worker_cv_.wait(lock, [this] { return worker_stop_ || !worker_queue_.empty(); });
+            if (worker_queue_.empty()) {
+                break;
+            }
+            task = std::move(worker_queue_.front());
+            worker_queue_.pop_front();
+        }
+
+        if (conn != nullptr && !conn->connected()) {
+            destroy(conn);
+            conn = create();
+        }
+        task(conn);
+    }
+
+    if (conn != nullptr) {
+        destroy(conn);
     }
 }
 
@@ -56,6 +134,20 @@ MySQLConnectionPool::getDB() {
     return db_;
 }
 
+mysqlpp::Query&
+MySQLConnectionPool::GetPreparedQuery(mysqlpp::Connection* conn, const std::string& name,
+                                      const std::string& statement_template) {
+    std::lock_guard<std::mutex> lock(stmt_mutex_);
+    auto& conn_cache = stmt_cache_[conn];
+    auto it = conn_cache.find(name);
+    if (it == conn_cache.end()) {
+        mysqlpp::Query query = conn->query(statement_template);
+        query.parse();
+        it = conn_cache.emplace(name, query).first;
+    }
+    return it->second;
+}
+
 // Superclass overrides
 mysqlpp::Connection*
 MySQLConnectionPool::create() {
@@ -66,6 +158,9 @@ MySQLConnectionPool::create() {
         // creation.
         auto conn = new mysqlpp::Connection();
         conn->set_option(new mysqlpp::ReconnectOption(true));
+        // multi-statement execution lets update paths batch many mutations
+        // into one round trip
+        conn->set_option(new mysqlpp::MultiStatementsOption(true));
         conn->connect(db_.empty() ? 0 : db_.c_str(), server_.empty() ? 0 : server_.c_str(),
                       user_.empty() ? 0 : user_.c_str(), password_.empty() ? 0 : password_.c_str(), port_);
         return conn;
@@ -80,12 +175,18 @@ void
 MySQLConnectionPool::destroy(mysqlpp::Connection* cp) {
     // Our superclass can't know how we created the Connection, so
     // it delegates destruction to us, to be safe.
+    {
+        std::lock_guard<std::mutex> lock(stmt_mutex_);
+        stmt_cache_.erase(cp);
+    }
     delete cp;
 }
 
 unsigned int
 MySQLConnectionPool::max_idle_time() {
-    return max_idle_time_;
+    // surge connections above the configured pool size are retired quickly
+    // once a flush storm passes; the base pool keeps the normal idle time
+    return (size() > static_cast<size_t>(max_pool_size_)) ? 1 : max_idle_time_;
 }
 
 }  // namespace meta
@@ -12,8 +12,15 @@
 #include <mysql++/mysql++.h>
 
 #include <unistd.h>
-#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "utils/Log.h"
 
@@ -31,24 +38,35 @@ class MySQLConnectionPool : public mysqlpp::ConnectionPool {
           password_(passWord),
           server_(serverIp),
           port_(port),
-          max_pool_size_(maxPoolSize) {
+          max_pool_size_(maxPoolSize),
+          hard_max_pool_size_(maxPoolSize * HARD_CAP_FACTOR) {
         conns_in_use_ = 0;
         max_idle_time_ = 10;  // 10 seconds
     }
 
     // The destructor.  We _must_ call ConnectionPool::clear() here,
     // because our superclass can't do it for us.
-    ~MySQLConnectionPool() override {
-        clear();
-    }
+    ~MySQLConnectionPool() override;
 
     mysqlpp::Connection*
     grab() override;
 
+    // Like grab(), but gives up after the deadline instead of waiting for a
+    // connection indefinitely; returns nullptr on timeout.
+    mysqlpp::Connection*
+    TryGrab(std::chrono::milliseconds deadline);
+
     // Other half of in-use conn count limit
     void
     release(const mysqlpp::Connection* pc) override;
 
+    // Runs the work on a dedicated background connection owned by a single
+    // worker thread, outside the pool cap. Background bookkeeping funnels
+    // through here so it never competes with foreground queries for pooled
+    // connections. The connection is nullptr if it could not be established.
+    std::future<void>
+    SubmitAsync(std::function<void(mysqlpp::Connection*)> work);
+
     //    int getConnectionsInUse();
     //
     //    void set_max_idle_time(int max_idle);
@@ -56,6 +74,14 @@ class MySQLConnectionPool : public mysqlpp::ConnectionPool {
     std::string
     getDB();
 
+    // Returns a parsed template query cached for this connection, creating
+    // it on first use. Hot meta calls reuse the parsed statement instead of
+    // re-building and re-parsing the SQL text on every invocation. The
+    // returned reference is only valid while the caller holds the
+    // connection; entries are dropped when the connection is destroyed.
+    mysqlpp::Query&
+    GetPreparedQuery(mysqlpp::Connection* conn, const std::string& name, const std::string& statement_template);
+
  protected:
     // Superclass overrides
     mysqlpp::Connection*
@@ -68,16 +94,40 @@ class MySQLConnectionPool : public mysqlpp::ConnectionPool {
     max_idle_time() override;
 
  private:
-    // Number of connections currently in use
-    std::atomic<int> conns_in_use_;
+    void
+    BackgroundWorker();
+
+ private:
+    // connections beyond the configured pool size are surge capacity,
+    // allowed up to this multiple of it and retired quickly when idle
+    static constexpr int HARD_CAP_FACTOR = 4;
+
+    // Number of connections currently in use, guarded by pool_mutex_
+    int conns_in_use_;
+    std::mutex pool_mutex_;
+    std::condition_variable pool_cv_;
 
     // Our connection parameters
     std::string db_, user_, password_, server_;
     int port_;
 
     int max_pool_size_;
+    int hard_max_pool_size_;
 
     unsigned int max_idle_time_;
+
+    // Single worker draining background work onto its own connection
+    std::mutex worker_mutex_;
+    std::condition_variable worker_cv_;
+    std::deque<std::packaged_task<void(mysqlpp::Connection*)>> worker_queue_;
+    std::thread worker_thread_;
+    bool worker_started_ = false;
+    bool worker_stop_ = false;
+
+    // Per-connection cache of parsed template queries; a connection is used
+    // by one grabber at a time, so only the map structure needs the lock.
+    std::mutex stmt_mutex_;
+    std::map<const mysqlpp::Connection*, std::map<std::string, mysqlpp::Query>> stmt_cache_;
 };
 
 }  // namespace meta
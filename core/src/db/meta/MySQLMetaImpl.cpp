@@ -41,6 +41,14 @@ namespace meta {
 
 namespace {
 
+// how often a replica's replication lag is re-probed while it is in rotation
+constexpr int64_t REPLICA_LAG_CHECK_INTERVAL_US = 10 * 1000000LL;
+
+// time budget for one CleanUpFilesWithTTL pass over deletable files; files
+// not reached within the budget stay TO_DELETE and are picked up by the next
+// pass, so a large deletion backlog cannot stall the meta thread for long
+constexpr int64_t CLEANUP_BUDGET_US = 2 * 1000 * 1000;
+
 Status
 HandleException(const std::string& desc, const char* what = nullptr) {
     if (what == nullptr) {
@@ -160,6 +168,11 @@ static const MetaSchema TABLEFILES_SCHEMA(META_TABLEFILES, {
                                                                MetaField("updated_time", "BIGINT", "NOT NULL"),
                                                                MetaField("created_on", "BIGINT", "NOT NULL"),
                                                                MetaField("date", "INT", "DEFAULT -1 NOT NULL"),
+                                                               MetaField("min_row_id", "BIGINT", "DEFAULT 0 NOT NULL"),
+                                                               MetaField("max_row_id", "BIGINT", "DEFAULT 0 NOT NULL"),
+                                                               MetaField("max_norm", "DOUBLE", "DEFAULT 0 NOT NULL"),
+                                                               MetaField("source_file_id", "VARCHAR(255)",
+                                                                         "DEFAULT '' NOT NULL"),
                                                            });
 
 }  // namespace
@@ -284,6 +297,72 @@ MySQLMetaImpl::Initialize() {
         uri_info.db_name_, uri_info.username_, uri_info.password_, uri_info.host_, port, max_pool_size);
     ENGINE_LOG_DEBUG << "MySQL connection pool: maximum pool size = " << std::to_string(max_pool_size);
 
+    // optional read replicas: reads that tolerate bounded staleness are
+    // served from these pools, every mutation stays on the primary
+    for (auto& replica_uri : options_.replica_uris_) {
+        utils::MetaUriInfo replica_info;
+        auto replica_status = utils::ParseMetaUri(replica_uri, replica_info);
+        if (!replica_status.ok() || strcasecmp(replica_info.dialect_.c_str(), "mysql") != 0) {
+            ENGINE_LOG_WARNING << "Skip malformed meta replica URI: " << replica_uri;
+            continue;
+        }
+
+        unsigned int replica_port = 0;
+        if (!replica_info.port_.empty()) {
+            replica_port = std::stoi(replica_info.port_);
+        }
+
+        auto replica = std::make_shared<ReplicaPool>();
+        replica->pool_ =
+            std::make_shared<MySQLConnectionPool>(replica_info.db_name_, replica_info.username_,
+                                                  replica_info.password_, replica_info.host_, replica_port,
+                                                  max_pool_size);
+        replica_pools_.push_back(replica);
+    }
+    if (!replica_pools_.empty()) {
+        ENGINE_LOG_DEBUG << "MySQL meta read replicas: " << replica_pools_.size();
+    }
+
+    // step 3.5: add the zone-statistics columns to a pre-existing TableFiles
+    // before validation, so upgrading an older meta needs no manual step
+    {
+        mysqlpp::ScopedConnection migrateConnectionPtr(*mysql_connection_pool_, safe_grab_);
+        if (migrateConnectionPtr != nullptr) {
+            mysqlpp::Query migrateQuery = migrateConnectionPtr->query();
+            auto ensure_column = [&](const std::string& column_name, const std::string& definition) {
+                migrateQuery << "SELECT COUNT(1) FROM information_schema.tables"
+                             << " WHERE table_schema = DATABASE() AND table_name = " << mysqlpp::quote
+                             << META_TABLEFILES << ";";
+                mysqlpp::StoreQueryResult res = migrateQuery.store();
+                if (res.empty() || std::stol(res[0][0].c_str()) == 0) {
+                    return;  // fresh deployment; CREATE TABLE below carries the column
+                }
+
+                migrateQuery << "SELECT COUNT(1) FROM information_schema.columns"
+                             << " WHERE table_schema = DATABASE() AND table_name = " << mysqlpp::quote
+                             << META_TABLEFILES << " AND column_name = " << mysqlpp::quote << column_name << ";";
+                res = migrateQuery.store();
+                if (!res.empty() && std::stol(res[0][0].c_str()) > 0) {
+                    return;
+                }
+
+                migrateQuery << "ALTER TABLE " << META_TABLEFILES << " ADD COLUMN " << column_name << " " << definition
+                             << ";";
+
+                ENGINE_LOG_DEBUG << "MySQLMetaImpl::Initialize: " << migrateQuery.str();
+
+                if (!migrateQuery.exec()) {
+                    ENGINE_LOG_WARNING << "Failed to add column " << column_name << " to meta table 'TableFiles'";
+                }
+            };
+
+            ensure_column("min_row_id", "BIGINT DEFAULT 0 NOT NULL");
+            ensure_column("max_row_id", "BIGINT DEFAULT 0 NOT NULL");
+            ensure_column("max_norm", "DOUBLE DEFAULT 0 NOT NULL");
+            ensure_column("source_file_id", "VARCHAR(255) DEFAULT '' NOT NULL");
+        }
+    }
+
     // step 4: validate to avoid open old version schema
     ValidateMetaSchema();
 
@@ -339,9 +418,87 @@ MySQLMetaImpl::Initialize() {
         throw Exception(DB_META_TRANSACTION_FAILED, msg);
     }
 
+    // step 9: create secondary indexes so file selection is O(result) instead of a table scan.
+    // MySQL has no CREATE INDEX IF NOT EXISTS, so probe information_schema first; a failure here
+    // only costs query speed, so it is logged instead of aborting startup
+    auto ensure_index = [&](const std::string& index_name, const std::string& columns) {
+        InitializeQuery << "SELECT COUNT(1) FROM information_schema.statistics"
+                        << " WHERE table_schema = DATABASE() AND table_name = " << mysqlpp::quote << META_TABLEFILES
+                        << " AND index_name = " << mysqlpp::quote << index_name << ";";
+
+        mysqlpp::StoreQueryResult res = InitializeQuery.store();
+        if (!res.empty() && std::stol(res[0][0].c_str()) > 0) {
+            return;
+        }
+
+        InitializeQuery << "CREATE INDEX " << index_name << " ON " << META_TABLEFILES << " (" << columns << ");";
+
+        ENGINE_LOG_DEBUG << "MySQLMetaImpl::Initialize: " << InitializeQuery.str();
+
+        if (!InitializeQuery.exec()) {
+            ENGINE_LOG_WARNING << "Failed to create index " << index_name << " on meta table 'TableFiles'";
+        }
+    };
+
+    // composite index for FilesToSearch/FilesToMerge/FilesByType; file_type index for the
+    // table-agnostic FilesToIndex/cleanup scans
+    ensure_index("idx_tablefiles_selection", "table_id, file_type, date");
+    ensure_index("idx_tablefiles_file_type", "file_type");
+    ensure_index("idx_tablefiles_created_on", "created_on");
+
     return Status::OK();
 }
 
+std::shared_ptr<MySQLConnectionPool>
+MySQLMetaImpl::ReadPool() {
+    if (replica_pools_.empty()) {
+        return mysql_connection_pool_;
+    }
+
+    int64_t now = utils::GetMicroSecTimeStamp();
+    uint64_t start = next_replica_.fetch_add(1);
+    for (size_t i = 0; i < replica_pools_.size(); i++) {
+        auto& replica = *replica_pools_[(start + i) % replica_pools_.size()];
+        if (now >= replica.next_lag_check_.load()) {
+            replica.next_lag_check_.store(now + REPLICA_LAG_CHECK_INTERVAL_US);
+            replica.healthy_.store(CheckReplicaLag(replica));
+        }
+        if (replica.healthy_.load()) {
+            return replica.pool_;
+        }
+    }
+
+    // no replica within the staleness bound; the primary is always current
+    return mysql_connection_pool_;
+}
+
+bool
+MySQLMetaImpl::CheckReplicaLag(ReplicaPool& replica) {
+    try {
+        mysqlpp::ScopedConnection connectionPtr(*replica.pool_, safe_grab_);
+        if (connectionPtr == nullptr) {
+            return false;
+        }
+
+        mysqlpp::Query lagQuery = connectionPtr->query("SHOW SLAVE STATUS");
+        mysqlpp::StoreQueryResult res = lagQuery.store();
+        if (res.empty()) {
+            // not replicating (e.g. the primary itself listed as a replica);
+            // by definition it serves current data
+            return true;
+        }
+
+        const mysqlpp::String& lag = res[0]["Seconds_Behind_Master"];
+        if (lag.is_null()) {
+            return false;  // replication thread stopped
+        }
+        return std::stol(lag.c_str()) <= options_.replica_max_lag_seconds_;
+    } catch (std::exception& e) {
+        ENGINE_LOG_WARNING << "Meta replica lag check failed: " << e.what();
+        return false;
+    }
+}
+
 Status
 MySQLMetaImpl::CreateTable(TableSchema& table_schema) {
     try {
@@ -426,7 +583,7 @@ MySQLMetaImpl::DescribeTable(TableSchema& table_schema) {
         server::MetricCollector metric;
         mysqlpp::StoreQueryResult res;
         {
-            mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
+            mysqlpp::ScopedConnection connectionPtr(*ReadPool(), safe_grab_);
 
             bool is_null_connection = (connectionPtr == nullptr);
             fiu_do_on("MySQLMetaImpl.DescribeTable.null_connection", is_null_connection = true);
@@ -673,6 +830,10 @@ MySQLMetaImpl::CreateTableFile(TableFileSchema& file_schema) {
         std::string updated_time = std::to_string(file_schema.updated_time_);
         std::string created_on = std::to_string(file_schema.created_on_);
         std::string date = std::to_string(file_schema.date_);
+        std::string min_row_id = std::to_string(file_schema.min_row_id_);
+        std::string max_row_id = std::to_string(file_schema.max_row_id_);
+        std::string max_norm = std::to_string(file_schema.max_norm_);
+        std::string source_file_id = file_schema.source_file_id_;
 
         {
             mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
@@ -689,7 +850,8 @@ MySQLMetaImpl::CreateTableFile(TableFileSchema& file_schema) {
             createTableFileQuery << "INSERT INTO " << META_TABLEFILES << " VALUES(" << id << ", " << mysqlpp::quote
                                  << table_id << ", " << engine_type << ", " << mysqlpp::quote << file_id << ", "
                                  << file_type << ", " << file_size << ", " << row_count << ", " << updated_time << ", "
-                                 << created_on << ", " << date << ");";
+                                 << created_on << ", " << date << ", " << min_row_id << ", " << max_row_id << ", "
+                                 << max_norm << ", " << mysqlpp::quote << source_file_id << ");";
 
             ENGINE_LOG_DEBUG << "MySQLMetaImpl::CreateTableFile: " << createTableFileQuery.str();
 
@@ -890,6 +1052,109 @@ MySQLMetaImpl::UpdateTableIndex(const std::string& table_id, const TableIndex& i
     return Status::OK();
 }
 
+Status
+MySQLMetaImpl::UpdateTableIndexRolling(const std::string& table_id, const TableIndex& index) {
+    try {
+        server::MetricCollector metric;
+
+        {
+            mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
+
+            bool is_null_connection = (connectionPtr == nullptr);
+            fiu_do_on("MySQLMetaImpl.UpdateTableIndexRolling.null_connection", is_null_connection = true);
+            fiu_do_on("MySQLMetaImpl.UpdateTableIndexRolling.throw_exception", throw std::exception(););
+            if (is_null_connection) {
+                return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
+            }
+
+            mysqlpp::Query updateTableIndexQuery = connectionPtr->query();
+            updateTableIndexQuery << "SELECT id FROM " << META_TABLES << " WHERE table_id = " << mysqlpp::quote
+                                  << table_id << " AND state <> " << std::to_string(TableSchema::TO_DELETE) << ";";
+
+            ENGINE_LOG_DEBUG << "MySQLMetaImpl::UpdateTableIndexRolling: " << updateTableIndexQuery.str();
+
+            mysqlpp::StoreQueryResult res = updateTableIndexQuery.store();
+            if (res.num_rows() != 1) {
+                return Status(DB_NOT_FOUND, "Table " + table_id + " not found");
+            }
+
+            updateTableIndexQuery << "UPDATE " << META_TABLES << " SET engine_type = " << index.engine_type_
+                                  << " ,nlist = " << index.nlist_ << " ,metric_type = " << index.metric_type_
+                                  << " WHERE table_id = " << mysqlpp::quote << table_id << ";";
+
+            ENGINE_LOG_DEBUG << "MySQLMetaImpl::UpdateTableIndexRolling: " << updateTableIndexQuery.str();
+
+            if (!updateTableIndexQuery.exec()) {
+                return HandleException("QUERY ERROR WHEN UPDATING TABLE INDEX PARAM", updateTableIndexQuery.error());
+            }
+
+            // the old index files keep serving; queue their raw backups for
+            // the background rebuild instead of exposing them to search
+            updateTableIndexQuery << "UPDATE " << META_TABLEFILES
+                                  << " SET file_type = " << std::to_string(TableFileSchema::TO_UPGRADE)
+                                  << " ,updated_time = " << utils::GetMicroSecTimeStamp()
+                                  << " WHERE table_id = " << mysqlpp::quote << table_id
+                                  << " AND file_type = " << std::to_string(TableFileSchema::BACKUP) << ";";
+
+            ENGINE_LOG_DEBUG << "MySQLMetaImpl::UpdateTableIndexRolling: " << updateTableIndexQuery.str();
+
+            if (!updateTableIndexQuery.exec()) {
+                return HandleException("QUERY ERROR WHEN UPDATING TABLE INDEX PARAM", updateTableIndexQuery.error());
+            }
+        }  // Scoped Connection
+
+        ENGINE_LOG_DEBUG << "Successfully update table index (rolling), table id = " << table_id;
+    } catch (std::exception& e) {
+        return HandleException("GENERAL ERROR WHEN UPDATING TABLE INDEX PARAM", e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+MySQLMetaImpl::RetireSupersededIndexFile(const TableFileSchema& index_file) {
+    if (index_file.source_file_id_.empty()) {
+        return Status(DB_ERROR, "Index file " + index_file.file_id_ + " carries no source file id");
+    }
+
+    try {
+        server::MetricCollector metric;
+
+        {
+            mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
+
+            bool is_null_connection = (connectionPtr == nullptr);
+            fiu_do_on("MySQLMetaImpl.RetireSupersededIndexFile.null_connection", is_null_connection = true);
+            fiu_do_on("MySQLMetaImpl.RetireSupersededIndexFile.throw_exception", throw std::exception(););
+            if (is_null_connection) {
+                return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
+            }
+
+            mysqlpp::Query retireQuery = connectionPtr->query();
+            retireQuery << "UPDATE " << META_TABLEFILES
+                        << " SET file_type = " << std::to_string(TableFileSchema::TO_DELETE)
+                        << " ,updated_time = " << utils::GetMicroSecTimeStamp()
+                        << " WHERE table_id = " << mysqlpp::quote << index_file.table_id_
+                        << " AND file_type = " << std::to_string(TableFileSchema::INDEX)
+                        << " AND source_file_id = " << mysqlpp::quote << index_file.source_file_id_
+                        << " AND id <> " << std::to_string(index_file.id_) << ";";
+
+            ENGINE_LOG_DEBUG << "MySQLMetaImpl::RetireSupersededIndexFile: " << retireQuery.str();
+
+            if (!retireQuery.exec()) {
+                return HandleException("QUERY ERROR WHEN RETIRING SUPERSEDED INDEX FILE", retireQuery.error());
+            }
+        }  // Scoped Connection
+
+        ENGINE_LOG_DEBUG << "Retired superseded index file(s) of source " << index_file.source_file_id_
+                         << ", table id = " << index_file.table_id_;
+    } catch (std::exception& e) {
+        return HandleException("GENERAL ERROR WHEN RETIRING SUPERSEDED INDEX FILE", e.what());
+    }
+
+    return Status::OK();
+}
+
 Status
 MySQLMetaImpl::UpdateTableFlag(const std::string& table_id, int64_t flag) {
     try {
@@ -971,13 +1236,19 @@ MySQLMetaImpl::UpdateTableFile(TableFileSchema& file_schema) {
             std::string updated_time = std::to_string(file_schema.updated_time_);
             std::string created_on = std::to_string(file_schema.created_on_);
             std::string date = std::to_string(file_schema.date_);
+            std::string min_row_id = std::to_string(file_schema.min_row_id_);
+            std::string max_row_id = std::to_string(file_schema.max_row_id_);
+            std::string max_norm = std::to_string(file_schema.max_norm_);
 
             updateTableFileQuery << "UPDATE " << META_TABLEFILES << " SET table_id = " << mysqlpp::quote << table_id
                                  << " ,engine_type = " << engine_type << " ,file_id = " << mysqlpp::quote << file_id
                                  << " ,file_type = " << file_type << " ,file_size = " << file_size
                                  << " ,row_count = " << row_count << " ,updated_time = " << updated_time
-                                 << " ,created_on = " << created_on << " ,date = " << date << " WHERE id = " << id
-                                 << ";";
+                                 << " ,created_on = " << created_on << " ,date = " << date
+                                 << " ,min_row_id = " << min_row_id << " ,max_row_id = " << max_row_id
+                                 << " ,max_norm = " << max_norm
+                                 << " ,source_file_id = " << mysqlpp::quote << file_schema.source_file_id_
+                                 << " WHERE id = " << id << ";";
 
             ENGINE_LOG_DEBUG << "MySQLMetaImpl::UpdateTableFile: " << updateTableFileQuery.str();
 
@@ -998,28 +1269,41 @@ MySQLMetaImpl::UpdateTableFile(TableFileSchema& file_schema) {
 Status
 MySQLMetaImpl::UpdateTableFilesToIndex(const std::string& table_id) {
     try {
-        mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
-
-        bool is_null_connection = (connectionPtr == nullptr);
-        fiu_do_on("MySQLMetaImpl.UpdateTableFilesToIndex.null_connection", is_null_connection = true);
         fiu_do_on("MySQLMetaImpl.UpdateTableFilesToIndex.throw_exception", throw std::exception(););
-        if (is_null_connection) {
-            return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
-        }
 
-        mysqlpp::Query updateTableFilesToIndexQuery = connectionPtr->query();
+        // build-index bookkeeping runs on the pool's dedicated background
+        // connection so it never steals a pooled connection from the query
+        // path during a flush storm
+        Status status = Status::OK();
+        auto done = mysql_connection_pool_->SubmitAsync([&](mysqlpp::Connection* conn) {
+            bool is_null_connection = (conn == nullptr);
+            fiu_do_on("MySQLMetaImpl.UpdateTableFilesToIndex.null_connection", is_null_connection = true);
+            if (is_null_connection) {
+                status = Status(DB_ERROR, "Failed to connect to meta server(mysql)");
+                return;
+            }
 
-        updateTableFilesToIndexQuery << "UPDATE " << META_TABLEFILES
-                                     << " SET file_type = " << std::to_string(TableFileSchema::TO_INDEX)
-                                     << " WHERE table_id = " << mysqlpp::quote << table_id
-                                     << " AND row_count >= " << std::to_string(meta::BUILD_INDEX_THRESHOLD)
-                                     << " AND file_type = " << std::to_string(TableFileSchema::RAW) << ";";
+            // hot during flush storms; the parsed statement is cached per
+            // connection so only the table id is substituted each call
+            std::string statement = std::string("UPDATE ") + META_TABLEFILES +
+                                    " SET file_type = " + std::to_string(TableFileSchema::TO_INDEX) +
+                                    " WHERE table_id = %0q AND row_count >= " +
+                                    std::to_string(meta::BUILD_INDEX_THRESHOLD) +
+                                    " AND file_type = " + std::to_string(TableFileSchema::RAW);
+            mysqlpp::Query& updateTableFilesToIndexQuery =
+                mysql_connection_pool_->GetPreparedQuery(conn, "update_files_to_index", statement);
 
-        ENGINE_LOG_DEBUG << "MySQLMetaImpl::UpdateTableFilesToIndex: " << updateTableFilesToIndexQuery.str();
+            ENGINE_LOG_DEBUG << "MySQLMetaImpl::UpdateTableFilesToIndex: "
+                             << updateTableFilesToIndexQuery.str(table_id);
 
-        if (!updateTableFilesToIndexQuery.exec()) {
-            return HandleException("QUERY ERROR WHEN UPDATING TABLE FILE TO INDEX",
-                                   updateTableFilesToIndexQuery.error());
+            if (!updateTableFilesToIndexQuery.execute(table_id)) {
+                status = HandleException("QUERY ERROR WHEN UPDATING TABLE FILE TO INDEX",
+                                         updateTableFilesToIndexQuery.error());
+            }
+        });
+        done.get();
+        if (!status.ok()) {
+            return status;
         }
 
         ENGINE_LOG_DEBUG << "Update files to to_index, table id = " << table_id;
@@ -1046,27 +1330,41 @@ MySQLMetaImpl::UpdateTableFiles(TableFilesSchema& files) {
 
             mysqlpp::Query updateTableFilesQuery = connectionPtr->query();
 
+            // one round trip resolves the existence of every distinct table
+            // instead of one EXISTS query per table
             std::map<std::string, bool> has_tables;
             for (auto& file_schema : files) {
-                if (has_tables.find(file_schema.table_id_) != has_tables.end()) {
-                    continue;
-                }
+                has_tables[file_schema.table_id_] = false;
+            }
 
-                updateTableFilesQuery << "SELECT EXISTS"
-                                      << " (SELECT 1 FROM " << META_TABLES << " WHERE table_id = " << mysqlpp::quote
-                                      << file_schema.table_id_ << " AND state <> "
-                                      << std::to_string(TableSchema::TO_DELETE) << ")"
-                                      << " AS " << mysqlpp::quote << "check"
-                                      << ";";
+            if (!has_tables.empty()) {
+                updateTableFilesQuery << "SELECT table_id FROM " << META_TABLES << " WHERE state <> "
+                                      << std::to_string(TableSchema::TO_DELETE) << " AND table_id IN (";
+                bool first = true;
+                for (auto& kv : has_tables) {
+                    if (!first) {
+                        updateTableFilesQuery << ", ";
+                    }
+                    updateTableFilesQuery << mysqlpp::quote << kv.first;
+                    first = false;
+                }
+                updateTableFilesQuery << ");";
 
                 ENGINE_LOG_DEBUG << "MySQLMetaImpl::UpdateTableFiles: " << updateTableFilesQuery.str();
 
                 mysqlpp::StoreQueryResult res = updateTableFilesQuery.store();
-
-                int check = res[0]["check"];
-                has_tables[file_schema.table_id_] = (check == 1);
+                for (auto& resRow : res) {
+                    std::string table_id;
+                    resRow["table_id"].to_string(table_id);
+                    has_tables[table_id] = true;
+                }
             }
 
+            // the per-file updates are pipelined: statements are concatenated
+            // and executed as multi-statement batches, so a flush touching
+            // hundreds of files costs a handful of round trips
+            constexpr size_t UPDATE_BATCH_SIZE = 100;
+            size_t batched = 0;
             for (auto& file_schema : files) {
                 if (!has_tables[file_schema.table_id_]) {
                     file_schema.file_type_ = TableFileSchema::TO_DELETE;
@@ -1083,18 +1381,32 @@ MySQLMetaImpl::UpdateTableFiles(TableFilesSchema& files) {
                 std::string updated_time = std::to_string(file_schema.updated_time_);
                 std::string created_on = std::to_string(file_schema.created_on_);
                 std::string date = std::to_string(file_schema.date_);
+                std::string min_row_id = std::to_string(file_schema.min_row_id_);
+                std::string max_row_id = std::to_string(file_schema.max_row_id_);
+                std::string max_norm = std::to_string(file_schema.max_norm_);
 
                 updateTableFilesQuery << "UPDATE " << META_TABLEFILES << " SET table_id = " << mysqlpp::quote
                                       << table_id << " ,engine_type = " << engine_type
                                       << " ,file_id = " << mysqlpp::quote << file_id << " ,file_type = " << file_type
                                       << " ,file_size = " << file_size << " ,row_count = " << row_count
                                       << " ,updated_time = " << updated_time << " ,created_on = " << created_on
-                                      << " ,date = " << date << " WHERE id = " << id << ";";
+                                      << " ,date = " << date << " ,min_row_id = " << min_row_id
+                                      << " ,max_row_id = " << max_row_id << " ,max_norm = " << max_norm
+                                      << " ,source_file_id = " << mysqlpp::quote << file_schema.source_file_id_
+                                      << " WHERE id = " << id << ";";
+                batched++;
 
-                ENGINE_LOG_DEBUG << "MySQLMetaImpl::UpdateTableFiles: " << updateTableFilesQuery.str();
+                if (batched >= UPDATE_BATCH_SIZE || &file_schema == &files.back()) {
+                    ENGINE_LOG_DEBUG << "MySQLMetaImpl::UpdateTableFiles: " << batched << " batched statements";
 
-                if (!updateTableFilesQuery.exec()) {
-                    return HandleException("QUERY ERROR WHEN UPDATING TABLE FILES", updateTableFilesQuery.error());
+                    if (!updateTableFilesQuery.exec()) {
+                        return HandleException("QUERY ERROR WHEN UPDATING TABLE FILES", updateTableFilesQuery.error());
+                    }
+                    // drain the per-statement results of the batch
+                    while (updateTableFilesQuery.more_results()) {
+                        updateTableFilesQuery.store_next();
+                    }
+                    batched = 0;
                 }
             }
         }  // Scoped Connection
@@ -1357,7 +1669,8 @@ MySQLMetaImpl::FilesToSearch(const std::string& table_id, const std::vector<size
         server::MetricCollector metric;
         mysqlpp::StoreQueryResult res;
         {
-            mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
+            auto read_pool = ReadPool();
+            mysqlpp::ScopedConnection connectionPtr(*read_pool, safe_grab_);
 
             bool is_null_connection = (connectionPtr == nullptr);
             fiu_do_on("MySQLMetaImpl.FilesToSearch.null_connection", is_null_connection = true);
@@ -1366,40 +1679,61 @@ MySQLMetaImpl::FilesToSearch(const std::string& table_id, const std::vector<size
                 return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
             }
 
-            mysqlpp::Query filesToSearchQuery = connectionPtr->query();
-            filesToSearchQuery << "SELECT id, table_id, engine_type, file_id, file_type, file_size, row_count, date"
-                               << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote << table_id;
+            if (dates.empty() && ids.empty()) {
+                // the common search path has no date or id filter; serve it
+                // from a per-connection cached template query
+                std::string statement =
+                    std::string("SELECT id, table_id, engine_type, file_id, file_type, file_size, row_count, date,") +
+                    " min_row_id, max_row_id, max_norm" +
+                    " FROM " + META_TABLEFILES + " WHERE table_id = %0q AND (file_type = " +
+                    std::to_string(TableFileSchema::RAW) + " OR file_type = " +
+                    std::to_string(TableFileSchema::TO_INDEX) + " OR file_type = " +
+                    std::to_string(TableFileSchema::INDEX) + ")";
+                mysqlpp::Query& cachedFilesToSearchQuery =
+                    read_pool->GetPreparedQuery(&(*connectionPtr), "files_to_search", statement);
 
-            if (!dates.empty()) {
-                std::stringstream partitionListSS;
-                for (auto& date : dates) {
-                    partitionListSS << std::to_string(date) << ", ";
-                }
-                std::string partitionListStr = partitionListSS.str();
+                ENGINE_LOG_DEBUG << "MySQLMetaImpl::FilesToSearch: " << cachedFilesToSearchQuery.str(table_id);
 
-                partitionListStr = partitionListStr.substr(0, partitionListStr.size() - 2);  // remove the last ", "
-                filesToSearchQuery << " AND date IN (" << partitionListStr << ")";
-            }
+                res = cachedFilesToSearchQuery.store(table_id);
+            } else {
+                mysqlpp::Query filesToSearchQuery = connectionPtr->query();
+                filesToSearchQuery << "SELECT id, table_id, engine_type, file_id, file_type, file_size, row_count,"
+                                   << " date, min_row_id, max_row_id, max_norm"
+                                   << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote
+                                   << table_id;
+
+                if (!dates.empty()) {
+                    std::stringstream partitionListSS;
+                    for (auto& date : dates) {
+                        partitionListSS << std::to_string(date) << ", ";
+                    }
+                    std::string partitionListStr = partitionListSS.str();
 
-            if (!ids.empty()) {
-                std::stringstream idSS;
-                for (auto& id : ids) {
-                    idSS << "id = " << std::to_string(id) << " OR ";
+                    partitionListStr =
+                        partitionListStr.substr(0, partitionListStr.size() - 2);  // remove the last ", "
+                    filesToSearchQuery << " AND date IN (" << partitionListStr << ")";
                 }
-                std::string idStr = idSS.str();
-                idStr = idStr.substr(0, idStr.size() - 4);  // remove the last " OR "
 
-                filesToSearchQuery << " AND (" << idStr << ")";
-            }
-            // End
-            filesToSearchQuery << " AND"
-                               << " (file_type = " << std::to_string(TableFileSchema::RAW)
-                               << " OR file_type = " << std::to_string(TableFileSchema::TO_INDEX)
-                               << " OR file_type = " << std::to_string(TableFileSchema::INDEX) << ");";
+                if (!ids.empty()) {
+                    std::stringstream idSS;
+                    for (auto& id : ids) {
+                        idSS << "id = " << std::to_string(id) << " OR ";
+                    }
+                    std::string idStr = idSS.str();
+                    idStr = idStr.substr(0, idStr.size() - 4);  // remove the last " OR "
 
-            ENGINE_LOG_DEBUG << "MySQLMetaImpl::FilesToSearch: " << filesToSearchQuery.str();
+                    filesToSearchQuery << " AND (" << idStr << ")";
+                }
+                // End
+                filesToSearchQuery << " AND"
+                                   << " (file_type = " << std::to_string(TableFileSchema::RAW)
+                                   << " OR file_type = " << std::to_string(TableFileSchema::TO_INDEX)
+                                   << " OR file_type = " << std::to_string(TableFileSchema::INDEX) << ");";
+
+                ENGINE_LOG_DEBUG << "MySQLMetaImpl::FilesToSearch: " << filesToSearchQuery.str();
 
-            res = filesToSearchQuery.store();
+                res = filesToSearchQuery.store();
+            }
         }  // Scoped Connection
 
         TableSchema table_schema;
@@ -1424,6 +1758,9 @@ MySQLMetaImpl::FilesToSearch(const std::string& table_id, const std::vector<size
             table_file.row_count_ = resRow["row_count"];
             table_file.date_ = resRow["date"];
             table_file.dimension_ = table_schema.dimension_;
+            table_file.min_row_id_ = resRow["min_row_id"];
+            table_file.max_row_id_ = resRow["max_row_id"];
+            table_file.max_norm_ = resRow["max_norm"];
 
             auto status = utils::GetTableFilePath(options_, table_file);
             if (!status.ok()) {
@@ -1474,10 +1811,12 @@ MySQLMetaImpl::FilesToMerge(const std::string& table_id, DatePartionedTableFiles
             }
 
             mysqlpp::Query filesToMergeQuery = connectionPtr->query();
+            // smallest first, so merge rounds combine many small files instead
+            // of re-writing one large accumulator file every round
             filesToMergeQuery
                 << "SELECT id, table_id, file_id, file_type, file_size, row_count, date, engine_type, created_on"
                 << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote << table_id
-                << " AND file_type = " << std::to_string(TableFileSchema::RAW) << " ORDER BY row_count DESC;";
+                << " AND file_type = " << std::to_string(TableFileSchema::RAW) << " ORDER BY file_size ASC;";
 
             ENGINE_LOG_DEBUG << "MySQLMetaImpl::FilesToMerge: " << filesToMergeQuery.str();
 
@@ -1549,8 +1888,9 @@ MySQLMetaImpl::FilesToIndex(TableFilesSchema& files) {
             mysqlpp::Query filesToIndexQuery = connectionPtr->query();
             filesToIndexQuery
                 << "SELECT id, table_id, engine_type, file_id, file_type, file_size, row_count, date, created_on"
-                << " FROM " << META_TABLEFILES << " WHERE file_type = " << std::to_string(TableFileSchema::TO_INDEX)
-                << ";";
+                << " FROM " << META_TABLEFILES << " WHERE file_type in ("
+                << std::to_string(TableFileSchema::TO_INDEX) << "," << std::to_string(TableFileSchema::TO_UPGRADE)
+                << ");";
 
             ENGINE_LOG_DEBUG << "MySQLMetaImpl::FilesToIndex: " << filesToIndexQuery.str();
 
@@ -1635,7 +1975,8 @@ MySQLMetaImpl::FilesByType(const std::string& table_id, const std::vector<int>&
             mysqlpp::Query hasNonIndexFilesQuery = connectionPtr->query();
             // since table_id is a unique column we just need to check whether it exists or not
             hasNonIndexFilesQuery
-                << "SELECT id, engine_type, file_id, file_type, file_size, row_count, date, created_on"
+                << "SELECT id, engine_type, file_id, file_type, file_size, row_count, date, created_on,"
+                << " source_file_id"
                 << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote << table_id
                 << " AND file_type in (" << types << ");";
 
@@ -1658,6 +1999,7 @@ MySQLMetaImpl::FilesByType(const std::string& table_id, const std::vector<int>&
                 file_schema.row_count_ = resRow["row_count"];
                 file_schema.date_ = resRow["date"];
                 file_schema.created_on_ = resRow["created_on"];
+                resRow["source_file_id"].to_string(file_schema.source_file_id_);
 
                 table_files.emplace_back(file_schema);
 
@@ -1739,7 +2081,7 @@ MySQLMetaImpl::Archive() {
         auto& limit = kv.second;
         if (criteria == engine::ARCHIVE_CONF_DAYS) {
             size_t usecs = limit * DAY * US_PS;
-            int64_t now = utils::GetMicroSecTimeStamp();
+            int64_t cutoff = utils::GetMicroSecTimeStamp() - usecs;
 
             try {
                 mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
@@ -1751,10 +2093,14 @@ MySQLMetaImpl::Archive() {
                     return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
                 }
 
+                // only the window [archive_checkpoint_, cutoff) is examined this tick: files below
+                // the previous cutoff were already expired, and the created_on index makes the
+                // range cost proportional to the files actually crossing the threshold
                 mysqlpp::Query archiveQuery = connectionPtr->query();
                 archiveQuery << "UPDATE " << META_TABLEFILES
                              << " SET file_type = " << std::to_string(TableFileSchema::TO_DELETE)
-                             << " WHERE created_on < " << std::to_string(now - usecs) << " AND file_type <> "
+                             << " WHERE created_on < " << std::to_string(cutoff)
+                             << " AND created_on >= " << std::to_string(archive_checkpoint_) << " AND file_type <> "
                              << std::to_string(TableFileSchema::TO_DELETE) << ";";
 
                 ENGINE_LOG_DEBUG << "MySQLMetaImpl::Archive: " << archiveQuery.str();
@@ -1763,6 +2109,8 @@ MySQLMetaImpl::Archive() {
                     return HandleException("QUERY ERROR DURING ARCHIVE", archiveQuery.error());
                 }
 
+                archive_checkpoint_ = cutoff;
+
                 ENGINE_LOG_DEBUG << "Archive old files";
             } catch (std::exception& e) {
                 return HandleException("GENERAL ERROR WHEN DURING ARCHIVE", e.what());
@@ -1843,6 +2191,8 @@ MySQLMetaImpl::CleanUpShadowFiles() {
         mysqlpp::StoreQueryResult res = cleanUpQuery.store();
 
         if (!res.empty()) {
+            // single delete over the file_type index: the index is the
+            // dirty-list, so recovery cost tracks the in-flight rows only
             ENGINE_LOG_DEBUG << "Remove table file type as NEW";
             cleanUpQuery << "DELETE FROM " << META_TABLEFILES << " WHERE file_type IN ("
                          << std::to_string(TableFileSchema::NEW) << "," << std::to_string(TableFileSchema::NEW_MERGE)
@@ -1899,7 +2249,14 @@ MySQLMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
             std::vector<std::string> idsToDelete;
 
             int64_t clean_files = 0;
+            int64_t processed_files = 0;
+            int64_t deadline = utils::GetMicroSecTimeStamp() + CLEANUP_BUDGET_US;
             for (auto& resRow : res) {
+                if (utils::GetMicroSecTimeStamp() > deadline) {
+                    break;  // budget exhausted, leave the rest for the next pass
+                }
+                ++processed_files;
+
                 table_file.id_ = resRow["id"];  // implicit conversion
                 resRow["table_id"].to_string(table_file.table_id_);
                 resRow["file_id"].to_string(table_file.file_id_);
@@ -1951,6 +2308,10 @@ MySQLMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
             if (clean_files > 0) {
                 ENGINE_LOG_DEBUG << "Clean " << clean_files << " files expired in " << seconds << " seconds";
             }
+            if (processed_files < (int64_t)res.num_rows()) {
+                ENGINE_LOG_DEBUG << "Cleanup budget exhausted, " << (res.num_rows() - processed_files)
+                                 << " files deferred to next pass";
+            }
         }  // Scoped Connection
     } catch (std::exception& e) {
         return HandleException("GENERAL ERROR WHEN CLEANING UP FILES WITH TTL", e.what());
@@ -2067,7 +2428,7 @@ MySQLMetaImpl::Count(const std::string& table_id, uint64_t& result) {
 
         mysqlpp::StoreQueryResult res;
         {
-            mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
+            mysqlpp::ScopedConnection connectionPtr(*ReadPool(), safe_grab_);
 
             bool is_null_connection = (connectionPtr == nullptr);
             fiu_do_on("MySQLMetaImpl.Count.null_connection", is_null_connection = true);
@@ -2100,6 +2461,49 @@ MySQLMetaImpl::Count(const std::string& table_id, uint64_t& result) {
     return Status::OK();
 }
 
+Status
+MySQLMetaImpl::GetTableStats(const std::string& table_id, TableStats& stats) {
+    try {
+        server::MetricCollector metric;
+
+        mysqlpp::StoreQueryResult res;
+        {
+            mysqlpp::ScopedConnection connectionPtr(*ReadPool(), safe_grab_);
+
+            bool is_null_connection = (connectionPtr == nullptr);
+            fiu_do_on("MySQLMetaImpl.GetTableStats.null_connection", is_null_connection = true);
+            fiu_do_on("MySQLMetaImpl.GetTableStats.throw_exception", throw std::exception(););
+            if (is_null_connection) {
+                return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
+            }
+
+            mysqlpp::Query statsQuery = connectionPtr->query();
+            statsQuery << "SELECT row_count, file_size"
+                       << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote << table_id
+                       << " AND (file_type = " << std::to_string(TableFileSchema::RAW)
+                       << " OR file_type = " << std::to_string(TableFileSchema::TO_INDEX)
+                       << " OR file_type = " << std::to_string(TableFileSchema::INDEX) << ");";
+
+            ENGINE_LOG_DEBUG << "MySQLMetaImpl::GetTableStats: " << statsQuery.str();
+
+            res = statsQuery.store();
+        }  // Scoped Connection
+
+        stats = TableStats();
+        for (auto& resRow : res) {
+            size_t row_count = resRow["row_count"];
+            size_t file_size = resRow["file_size"];
+            stats.row_count_ += row_count;
+            stats.data_size_ += file_size;
+            stats.file_count_++;
+        }
+    } catch (std::exception& e) {
+        return HandleException("GENERAL ERROR WHEN RETRIEVING TABLE STATS", e.what());
+    }
+
+    return Status::OK();
+}
+
 Status
 MySQLMetaImpl::DropAll() {
     try {
@@ -16,6 +16,7 @@
 #include "db/Options.h"
 
 #include <mysql++/mysql++.h>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -60,6 +61,12 @@ class MySQLMetaImpl : public Meta {
     Status
     UpdateTableIndex(const std::string& table_id, const TableIndex& index) override;
 
+    Status
+    UpdateTableIndexRolling(const std::string& table_id, const TableIndex& index) override;
+
+    Status
+    RetireSupersededIndexFile(const TableFileSchema& index_file) override;
+
     Status
     UpdateTableFlag(const std::string& table_id, int64_t flag) override;
 
@@ -122,6 +129,9 @@ class MySQLMetaImpl : public Meta {
     Status
     Count(const std::string& table_id, uint64_t& result) override;
 
+    Status
+    GetTableStats(const std::string& table_id, TableStats& stats) override;
+
  private:
     Status
     NextFileId(std::string& file_id);
@@ -135,6 +145,21 @@ class MySQLMetaImpl : public Meta {
     Status
     Initialize();
 
+    // read-replica routing: reads that tolerate bounded staleness grab their
+    // connection from ReadPool(), which round-robins over replicas whose
+    // replication lag is within the configured bound and falls back to the
+    // primary when none qualifies
+    struct ReplicaPool {
+        std::shared_ptr<MySQLConnectionPool> pool_;
+        std::atomic<bool> healthy_{true};
+        std::atomic<int64_t> next_lag_check_{0};
+    };
+
+    std::shared_ptr<MySQLConnectionPool>
+    ReadPool();
+    bool
+    CheckReplicaLag(ReplicaPool& replica);
+
  private:
     const DBMetaOptions options_;
     const int mode_;
@@ -142,8 +167,15 @@ class MySQLMetaImpl : public Meta {
     std::shared_ptr<MySQLConnectionPool> mysql_connection_pool_;
     bool safe_grab_ = false;
 
+    std::vector<std::shared_ptr<ReplicaPool>> replica_pools_;
+    std::atomic<uint64_t> next_replica_{0};
+
     std::mutex genid_mutex_;
     //        std::mutex connectionMutex_;
+
+    // created_on lower bound of the next Archive days pass; files below it
+    // were expired by an earlier pass. Only touched by the compaction thread.
+    int64_t archive_checkpoint_ = 0;
 };  // DBMetaImpl
 
 }  // namespace meta
@@ -39,6 +39,11 @@ using namespace sqlite_orm;
 
 namespace {
 
+// time budget for one CleanUpFilesWithTTL pass over deletable files; files
+// not reached within the budget stay TO_DELETE and are picked up by the next
+// pass, so a large deletion backlog cannot stall the meta thread for long
+constexpr int64_t CLEANUP_BUDGET_US = 2 * 1000 * 1000;
+
 Status
 HandleException(const std::string& desc, const char* what = nullptr) {
     if (what == nullptr) {
@@ -55,7 +60,16 @@ HandleException(const std::string& desc, const char* what = nullptr) {
 
 inline auto
 StoragePrototype(const std::string& path) {
+    // secondary indexes keep file selection O(result): the composite index
+    // serves FilesToSearch/FilesToMerge/FilesByType lookups and the
+    // file_type index serves the table-agnostic FilesToIndex/cleanup scans.
+    // sync_schema() creates missing indexes on an existing meta, so upgrade
+    // from an un-indexed deployment needs no extra migration step.
     return make_storage(path,
+                        make_index("idx_tablefiles_selection", &TableFileSchema::table_id_,
+                                   &TableFileSchema::file_type_, &TableFileSchema::date_),
+                        make_index("idx_tablefiles_file_type", &TableFileSchema::file_type_),
+                        make_index("idx_tablefiles_created_on", &TableFileSchema::created_on_),
                         make_table(META_TABLES,
                                    make_column("id", &TableSchema::id_, primary_key()),
                                    make_column("table_id", &TableSchema::table_id_, unique()),
@@ -80,7 +94,12 @@ StoragePrototype(const std::string& path) {
                                    make_column("row_count", &TableFileSchema::row_count_, default_value(0)),
                                    make_column("updated_time", &TableFileSchema::updated_time_),
                                    make_column("created_on", &TableFileSchema::created_on_),
-                                   make_column("date", &TableFileSchema::date_)));
+                                   make_column("date", &TableFileSchema::date_),
+                                   make_column("min_row_id", &TableFileSchema::min_row_id_, default_value(0)),
+                                   make_column("max_row_id", &TableFileSchema::max_row_id_, default_value(0)),
+                                   make_column("max_norm", &TableFileSchema::max_norm_, default_value(0.0)),
+                                   make_column("source_file_id", &TableFileSchema::source_file_id_,
+                                               default_value(""))));
 }
 
 using ConnectorT = decltype(StoragePrototype(""));
@@ -671,6 +690,100 @@ SqliteMetaImpl::UpdateTableIndex(const std::string& table_id, const TableIndex&
     return Status::OK();
 }
 
+Status
+SqliteMetaImpl::UpdateTableIndexRolling(const std::string& table_id, const TableIndex& index) {
+    try {
+        server::MetricCollector metric;
+        fiu_do_on("SqliteMetaImpl.UpdateTableIndexRolling.throw_exception", throw std::exception());
+
+        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        auto tables = ConnectorPtr->select(columns(&TableSchema::id_,
+                                                   &TableSchema::state_,
+                                                   &TableSchema::dimension_,
+                                                   &TableSchema::created_on_,
+                                                   &TableSchema::flag_,
+                                                   &TableSchema::index_file_size_,
+                                                   &TableSchema::owner_table_,
+                                                   &TableSchema::partition_tag_,
+                                                   &TableSchema::version_),
+                                           where(c(&TableSchema::table_id_) == table_id
+                                                 and c(&TableSchema::state_) != (int)TableSchema::TO_DELETE));
+
+        if (tables.size() > 0) {
+            meta::TableSchema table_schema;
+            table_schema.id_ = std::get<0>(tables[0]);
+            table_schema.table_id_ = table_id;
+            table_schema.state_ = std::get<1>(tables[0]);
+            table_schema.dimension_ = std::get<2>(tables[0]);
+            table_schema.created_on_ = std::get<3>(tables[0]);
+            table_schema.flag_ = std::get<4>(tables[0]);
+            table_schema.index_file_size_ = std::get<5>(tables[0]);
+            table_schema.owner_table_ = std::get<6>(tables[0]);
+            table_schema.partition_tag_ = std::get<7>(tables[0]);
+            table_schema.version_ = std::get<8>(tables[0]);
+            table_schema.engine_type_ = index.engine_type_;
+            table_schema.nlist_ = index.nlist_;
+            table_schema.metric_type_ = index.metric_type_;
+
+            ConnectorPtr->update(table_schema);
+        } else {
+            return Status(DB_NOT_FOUND, "Table " + table_id + " not found");
+        }
+
+        // the old index files keep serving; queue their raw backups for the
+        // background rebuild instead of exposing them to search
+        ConnectorPtr->update_all(
+            set(
+                c(&TableFileSchema::file_type_) = (int)TableFileSchema::TO_UPGRADE,
+                c(&TableFileSchema::updated_time_) = utils::GetMicroSecTimeStamp()),
+            where(
+                c(&TableFileSchema::table_id_) == table_id and
+                c(&TableFileSchema::file_type_) == (int)TableFileSchema::BACKUP));
+
+        ENGINE_LOG_DEBUG << "Successfully update table index (rolling), table id = " << table_id;
+    } catch (std::exception& e) {
+        std::string msg = "Encounter exception when update table index: table_id = " + table_id;
+        return HandleException(msg, e.what());
+    }
+
+    return Status::OK();
+}
+
+Status
+SqliteMetaImpl::RetireSupersededIndexFile(const TableFileSchema& index_file) {
+    if (index_file.source_file_id_.empty()) {
+        return Status(DB_ERROR, "Index file " + index_file.file_id_ + " carries no source file id");
+    }
+
+    try {
+        server::MetricCollector metric;
+        fiu_do_on("SqliteMetaImpl.RetireSupersededIndexFile.throw_exception", throw std::exception());
+
+        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        ConnectorPtr->update_all(
+            set(
+                c(&TableFileSchema::file_type_) = (int)TableFileSchema::TO_DELETE,
+                c(&TableFileSchema::updated_time_) = utils::GetMicroSecTimeStamp()),
+            where(
+                c(&TableFileSchema::table_id_) == index_file.table_id_ and
+                c(&TableFileSchema::file_type_) == (int)TableFileSchema::INDEX and
+                c(&TableFileSchema::source_file_id_) == index_file.source_file_id_ and
+                c(&TableFileSchema::id_) != index_file.id_));
+
+        ENGINE_LOG_DEBUG << "Retired superseded index file(s) of source " << index_file.source_file_id_
+                         << ", table id = " << index_file.table_id_;
+    } catch (std::exception& e) {
+        std::string msg = "Encounter exception when retire superseded index file: table_id = " + index_file.table_id_;
+        return HandleException(msg, e.what());
+    }
+
+    return Status::OK();
+}
+
 Status
 SqliteMetaImpl::UpdateTableFilesToIndex(const std::string& table_id) {
     try {
@@ -885,7 +998,8 @@ SqliteMetaImpl::FilesToSearch(const std::string& table_id,
         auto select_columns =
             columns(&TableFileSchema::id_, &TableFileSchema::table_id_, &TableFileSchema::file_id_,
                     &TableFileSchema::file_type_, &TableFileSchema::file_size_, &TableFileSchema::row_count_,
-                    &TableFileSchema::date_, &TableFileSchema::engine_type_);
+                    &TableFileSchema::date_, &TableFileSchema::engine_type_, &TableFileSchema::min_row_id_,
+                    &TableFileSchema::max_row_id_, &TableFileSchema::max_norm_);
 
         auto match_tableid = c(&TableFileSchema::table_id_) == table_id;
 
@@ -961,6 +1075,9 @@ SqliteMetaImpl::FilesToSearch(const std::string& table_id,
             table_file.row_count_ = std::get<5>(file);
             table_file.date_ = std::get<6>(file);
             table_file.engine_type_ = std::get<7>(file);
+            table_file.min_row_id_ = std::get<8>(file);
+            table_file.max_row_id_ = std::get<9>(file);
+            table_file.max_norm_ = std::get<10>(file);
             table_file.dimension_ = table_schema.dimension_;
             table_file.index_file_size_ = table_schema.index_file_size_;
             table_file.nlist_ = table_schema.nlist_;
@@ -1014,7 +1131,10 @@ SqliteMetaImpl::FilesToMerge(const std::string& table_id, DatePartionedTableFile
                     &TableFileSchema::date_, &TableFileSchema::created_on_),
             where(c(&TableFileSchema::file_type_) == (int)TableFileSchema::RAW and
                   c(&TableFileSchema::table_id_) == table_id),
-            order_by(&TableFileSchema::file_size_).desc());
+            // smallest first: merging small files into each other keeps the
+            // per-byte rewrite count logarithmic, instead of re-writing one
+            // large accumulator file on every merge round
+            order_by(&TableFileSchema::file_size_).asc());
 
         Status result;
         int64_t to_merge_files = 0;
@@ -1078,8 +1198,9 @@ SqliteMetaImpl::FilesToIndex(TableFilesSchema& files) {
                                                      &TableFileSchema::date_,
                                                      &TableFileSchema::engine_type_,
                                                      &TableFileSchema::created_on_),
-                                             where(c(&TableFileSchema::file_type_)
-                                                   == (int)TableFileSchema::TO_INDEX));
+                                             where(in(&TableFileSchema::file_type_,
+                                                      std::vector<int>{(int)TableFileSchema::TO_INDEX,
+                                                                       (int)TableFileSchema::TO_UPGRADE})));
 
         std::map<std::string, TableSchema> groups;
         TableFileSchema table_file;
@@ -1147,7 +1268,8 @@ SqliteMetaImpl::FilesByType(const std::string& table_id,
                                                      &TableFileSchema::row_count_,
                                                      &TableFileSchema::date_,
                                                      &TableFileSchema::engine_type_,
-                                                     &TableFileSchema::created_on_),
+                                                     &TableFileSchema::created_on_,
+                                                     &TableFileSchema::source_file_id_),
                                              where(in(&TableFileSchema::file_type_, file_types)
                                                    and c(&TableFileSchema::table_id_) == table_id));
 
@@ -1165,6 +1287,7 @@ SqliteMetaImpl::FilesByType(const std::string& table_id,
                 file_schema.date_ = std::get<5>(file);
                 file_schema.engine_type_ = std::get<6>(file);
                 file_schema.created_on_ = std::get<7>(file);
+                file_schema.source_file_id_ = std::get<8>(file);
 
                 switch (file_schema.file_type_) {
                     case (int)TableFileSchema::RAW:
@@ -1239,19 +1362,25 @@ SqliteMetaImpl::Archive() {
         auto& limit = kv.second;
         if (criteria == engine::ARCHIVE_CONF_DAYS) {
             int64_t usecs = limit * DAY * US_PS;
-            int64_t now = utils::GetMicroSecTimeStamp();
+            int64_t cutoff = utils::GetMicroSecTimeStamp() - usecs;
             try {
                 fiu_do_on("SqliteMetaImpl.Archive.throw_exception", throw std::exception());
 
                 // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
                 std::lock_guard<std::mutex> meta_lock(meta_mutex_);
 
+                // files older than the previous pass's cutoff were already expired, so only the
+                // window [archive_checkpoint_, cutoff) is examined this tick; together with the
+                // created_on index the cost is proportional to the files actually crossing the
+                // threshold, not the table size
                 ConnectorPtr->update_all(
                     set(
                         c(&TableFileSchema::file_type_) = (int)TableFileSchema::TO_DELETE),
                     where(
-                        c(&TableFileSchema::created_on_) < (int64_t)(now - usecs) and
+                        c(&TableFileSchema::created_on_) < cutoff and
+                        c(&TableFileSchema::created_on_) >= archive_checkpoint_ and
                         c(&TableFileSchema::file_type_) != (int)TableFileSchema::TO_DELETE));
+                archive_checkpoint_ = cutoff;
             } catch (std::exception& e) {
                 return HandleException("Encounter exception when update table files", e.what());
             }
@@ -1306,13 +1435,16 @@ SqliteMetaImpl::CleanUpShadowFiles() {
             (int)TableFileSchema::NEW_INDEX,
             (int)TableFileSchema::NEW_MERGE
         };
-        auto files =
-            ConnectorPtr->select(columns(&TableFileSchema::id_), where(in(&TableFileSchema::file_type_, file_types)));
+
+        // the file_type index doubles as the dirty-list here: the lookup and
+        // the delete touch only rows still in a transient state, so restart
+        // recovery does not grow with the total file count
+        auto count = ConnectorPtr->count<TableFileSchema>(where(in(&TableFileSchema::file_type_, file_types)));
 
         auto commited = ConnectorPtr->transaction([&]() mutable {
-            for (auto& file : files) {
+            if (count > 0) {
                 ENGINE_LOG_DEBUG << "Remove table file type as NEW";
-                ConnectorPtr->remove<TableFileSchema>(std::get<0>(file));
+                ConnectorPtr->remove_all<TableFileSchema>(where(in(&TableFileSchema::file_type_, file_types)));
             }
             return true;
         });
@@ -1323,8 +1455,8 @@ SqliteMetaImpl::CleanUpShadowFiles() {
             return HandleException("CleanUp error: sqlite transaction failed");
         }
 
-        if (files.size() > 0) {
-            ENGINE_LOG_DEBUG << "Clean " << files.size() << " files";
+        if (count > 0) {
+            ENGINE_LOG_DEBUG << "Clean " << count << " files";
         }
     } catch (std::exception& e) {
         return HandleException("Encounter exception when clean table file", e.what());
@@ -1365,9 +1497,16 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
                                               < now - seconds * US_PS));
 
         int64_t clean_files = 0;
+        int64_t processed_files = 0;
+        int64_t deadline = utils::GetMicroSecTimeStamp() + CLEANUP_BUDGET_US;
         auto commited = ConnectorPtr->transaction([&]() mutable {
             TableFileSchema table_file;
             for (auto& file : files) {
+                if (utils::GetMicroSecTimeStamp() > deadline) {
+                    break;  // budget exhausted, leave the rest for the next pass
+                }
+                ++processed_files;
+
                 table_file.id_ = std::get<0>(file);
                 table_file.table_id_ = std::get<1>(file);
                 table_file.file_id_ = std::get<2>(file);
@@ -1411,6 +1550,10 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds, CleanUpFilter* filter) {
         if (clean_files > 0) {
             ENGINE_LOG_DEBUG << "Clean " << clean_files << " files expired in " << seconds << " seconds";
         }
+        if (processed_files < (int64_t)files.size()) {
+            ENGINE_LOG_DEBUG << "Cleanup budget exhausted, " << (files.size() - processed_files)
+                             << " files deferred to next pass";
+        }
     } catch (std::exception& e) {
         return HandleException("Encounter exception when clean table files", e.what());
     }
@@ -1504,6 +1647,31 @@ SqliteMetaImpl::Count(const std::string& table_id, uint64_t& result) {
     return Status::OK();
 }
 
+Status
+SqliteMetaImpl::GetTableStats(const std::string& table_id, TableStats& stats) {
+    try {
+        fiu_do_on("SqliteMetaImpl.GetTableStats.throw_exception", throw std::exception());
+
+        server::MetricCollector metric;
+
+        std::vector<int> file_types = {(int)TableFileSchema::RAW, (int)TableFileSchema::TO_INDEX,
+                                       (int)TableFileSchema::INDEX};
+        auto selected = ConnectorPtr->select(
+            columns(&TableFileSchema::row_count_, &TableFileSchema::file_size_),
+            where(in(&TableFileSchema::file_type_, file_types) and c(&TableFileSchema::table_id_) == table_id));
+
+        stats = TableStats();
+        for (auto& file : selected) {
+            stats.row_count_ += std::get<0>(file);
+            stats.data_size_ += std::get<1>(file);
+            stats.file_count_++;
+        }
+    } catch (std::exception& e) {
+        return HandleException("Encounter exception when collect table stats", e.what());
+    }
+    return Status::OK();
+}
+
 Status
 SqliteMetaImpl::DropAll() {
     ENGINE_LOG_DEBUG << "Drop all sqlite meta";
@@ -60,6 +60,12 @@ class SqliteMetaImpl : public Meta {
     Status
     UpdateTableIndex(const std::string& table_id, const TableIndex& index) override;
 
+    Status
+    UpdateTableIndexRolling(const std::string& table_id, const TableIndex& index) override;
+
+    Status
+    RetireSupersededIndexFile(const TableFileSchema& index_file) override;
+
     Status
     UpdateTableFlag(const std::string& table_id, int64_t flag) override;
 
@@ -122,6 +128,9 @@ class SqliteMetaImpl : public Meta {
     Status
     Count(const std::string& table_id, uint64_t& result) override;
 
+    Status
+    GetTableStats(const std::string& table_id, TableStats& stats) override;
+
  private:
     Status
     NextFileId(std::string& file_id);
@@ -139,6 +148,10 @@ class SqliteMetaImpl : public Meta {
     const DBMetaOptions options_;
     std::mutex meta_mutex_;
     std::mutex genid_mutex_;
+
+    // created_on lower bound of the next Archive days pass; files below it
+    // were expired by an earlier pass. Only touched by the compaction thread.
+    int64_t archive_checkpoint_ = 0;
 };  // DBMetaImpl
 
 }  // namespace meta
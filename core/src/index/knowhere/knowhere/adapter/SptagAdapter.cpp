@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "knowhere/adapter/SptagAdapter.h"
+#include "knowhere/common/SearchScratch.h"
 #include "VectorAdapter.h"
 
 namespace knowhere {
@@ -56,10 +57,8 @@ ConvertToDataset(std::vector<SPTAG::QueryResult> query_results) {
     auto k = query_results[0].GetResultNum();
     auto elems = query_results.size() * k;
 
-    size_t p_id_size = sizeof(int64_t) * elems;
-    size_t p_dist_size = sizeof(float) * elems;
-    auto p_id = (int64_t*)malloc(p_id_size);
-    auto p_dist = (float*)malloc(p_dist_size);
+    auto p_id = scratch::SearchIds(elems);
+    auto p_dist = scratch::SearchDistances(elems);
 
 #pragma omp parallel for
     for (auto i = 0; i < query_results.size(); ++i) {
@@ -72,7 +71,7 @@ ConvertToDataset(std::vector<SPTAG::QueryResult> query_results) {
         }
     }
 
-    auto ret_ds = std::make_shared<Dataset>();
+    auto ret_ds = scratch::MakeDataset();
     ret_ds->Set(meta::IDS, p_id);
     ret_ds->Set(meta::DISTANCE, p_dist);
     return ret_ds;
@@ -25,6 +25,8 @@ enum class METRICTYPE {
     HAMMING = 20,
     JACCARD = 21,
     TANIMOTO = 22,
+    SUBSTRUCTURE = 23,
+    SUPERSTRUCTURE = 24,
 };
 
 // General Config
@@ -19,6 +19,7 @@
 #include <string>
 #include <typeindex>
 #include <utility>
+#include <vector>
 
 namespace knowhere {
 
@@ -106,10 +107,59 @@ class Dataset {
         return data_;
     }
 
+    void
+    Clear() {
+        std::lock_guard<std::mutex> lk(mutex_);
+        data_.clear();
+    }
+
  private:
     std::mutex mutex_;
     std::map<std::string, ValuePtr> data_;
 };
 using DatasetPtr = std::shared_ptr<Dataset>;
 
+namespace scratch {
+namespace internal {
+
+inline std::vector<std::unique_ptr<Dataset>>&
+DatasetFreeList() {
+    static thread_local std::vector<std::unique_ptr<Dataset>> free_list;
+    return free_list;
+}
+
+constexpr size_t DATASET_FREE_LIST_LIMIT = 64;
+
+}  // namespace internal
+
+// Hands out an empty Dataset recycled from a per-thread free list instead of
+// allocating a fresh one per request. When the last DatasetPtr is dropped the
+// shell is cleared and returned to the free list of whichever thread dropped
+// it, so the query/result descriptors built for every search stop churning
+// the allocator. Field values are still allocated per Set(); only the Dataset
+// object itself (mutex + field map) is reused.
+inline DatasetPtr
+MakeDataset() {
+    auto& free_list = internal::DatasetFreeList();
+    Dataset* dataset = nullptr;
+    if (!free_list.empty()) {
+        dataset = free_list.back().release();
+        free_list.pop_back();
+    } else {
+        dataset = new Dataset();
+    }
+
+    return DatasetPtr(dataset, [](Dataset* ptr) {
+        ptr->Clear();
+        auto& list = internal::DatasetFreeList();
+        if (list.size() < internal::DATASET_FREE_LIST_LIMIT) {
+            list.emplace_back(ptr);
+        } else {
+            delete ptr;
+        }
+    });
+}
+
+}  // namespace scratch
+
 }  // namespace knowhere
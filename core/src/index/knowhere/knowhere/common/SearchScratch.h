@@ -0,0 +1,45 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace knowhere {
+namespace scratch {
+
+// Per-thread result buffers reused across searches so the hot search path
+// stops hitting the allocator. The pointers stay owned by the calling thread:
+// consumers must copy the results out before the next Search on the same
+// thread and must never free them. Buffers grow to the largest (nq * k) seen
+// and are released at thread exit.
+
+inline int64_t*
+SearchIds(size_t elems) {
+    static thread_local std::vector<int64_t> buf;
+    if (buf.size() < elems) {
+        buf.resize(elems);
+    }
+    return buf.data();
+}
+
+inline float*
+SearchDistances(size_t elems) {
+    static thread_local std::vector<float> buf;
+    if (buf.size() < elems) {
+        buf.resize(elems);
+    }
+    return buf.data();
+}
+
+}  // namespace scratch
+}  // namespace knowhere
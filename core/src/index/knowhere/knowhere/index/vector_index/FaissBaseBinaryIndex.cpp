@@ -30,9 +30,13 @@ FaissBaseBinaryIndex::SerializeImpl() {
         // SealImpl();
 
         MemoryIOWriter writer;
+        // binary vectors pack d bits per code; reserving from that estimate
+        // skips the realloc-and-copy chain while serializing
+        if (index->ntotal > 0 && index->d > 0) {
+            writer.reserve(static_cast<size_t>(index->ntotal) * (index->d / 8 + sizeof(int64_t)) + 1024 * 1024);
+        }
         faiss::write_index_binary(index, &writer);
-        auto data = std::make_shared<uint8_t>();
-        data.reset(writer.data_);
+        auto data = writer.detach();
 
         BinarySet res_set;
         // TODO(linxj): use virtual func Name() instead of raw string.
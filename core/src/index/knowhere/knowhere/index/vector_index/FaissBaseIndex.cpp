@@ -32,9 +32,14 @@ FaissBaseIndex::SerializeImpl() {
         // SealImpl();
 
         MemoryIOWriter writer;
+        // a serialized index is dominated by the vectors and their ids;
+        // size the buffer from those so write_index lands in one allocation
+        if (index->ntotal > 0 && index->d > 0) {
+            writer.reserve(static_cast<size_t>(index->ntotal) * (index->d * sizeof(float) + sizeof(int64_t)) +
+                           1024 * 1024);
+        }
         faiss::write_index(index, &writer);
-        auto data = std::make_shared<uint8_t>();
-        data.reset(writer.data_);
+        auto data = writer.detach();
 
         BinarySet res_set;
         // TODO(linxj): use virtual func Name() instead of raw string.
@@ -16,6 +16,7 @@
 
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
+#include "knowhere/common/SearchScratch.h"
 #include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
 
 namespace knowhere {
@@ -44,27 +45,21 @@ BinaryIDMAP::Search(const DatasetPtr& dataset, const Config& config) {
     GETBINARYTENSOR(dataset)
 
     auto elems = rows * config->k;
-    size_t p_id_size = sizeof(int64_t) * elems;
-    size_t p_dist_size = sizeof(float) * elems;
-    auto p_id = (int64_t*)malloc(p_id_size);
-    auto p_dist = (float*)malloc(p_dist_size);
+    auto p_id = scratch::SearchIds(elems);
+    auto p_dist = scratch::SearchDistances(elems);
 
     search_impl(rows, (uint8_t*)p_data, config->k, p_dist, p_id, Config());
 
-    auto ret_ds = std::make_shared<Dataset>();
+    auto ret_ds = scratch::MakeDataset();
     if (index_->metric_type == faiss::METRIC_Hamming) {
-        auto pf_dist = (float*)malloc(p_dist_size);
+        // hamming distances come back as int32, convert in place
         int32_t* pi_dist = (int32_t*)p_dist;
         for (int i = 0; i < elems; i++) {
-            *(pf_dist + i) = (float)(*(pi_dist + i));
+            *(p_dist + i) = (float)(*(pi_dist + i));
         }
-        ret_ds->Set(meta::IDS, p_id);
-        ret_ds->Set(meta::DISTANCE, pf_dist);
-        free(p_dist);
-    } else {
-        ret_ds->Set(meta::IDS, p_id);
-        ret_ds->Set(meta::DISTANCE, p_dist);
     }
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
     return ret_ds;
 }
 
@@ -65,8 +65,7 @@ GPUIDMAP::SerializeImpl() {
             faiss::write_index(host_index, &writer);
             delete host_index;
         }
-        auto data = std::make_shared<uint8_t>();
-        data.reset(writer.data_);
+        auto data = writer.detach();
 
         BinarySet res_set;
         res_set.Append("IVF", data, writer.rp);
@@ -85,8 +85,7 @@ GPUIVF::SerializeImpl() {
             faiss::write_index(host_index, &writer);
             delete host_index;
         }
-        auto data = std::make_shared<uint8_t>();
-        data.reset(writer.data_);
+        auto data = writer.detach();
 
         BinarySet res_set;
         res_set.Append("IVF", data, writer.rp);
@@ -137,6 +136,22 @@ GPUIVF::search_impl(int64_t n, const float* data, int64_t k, float* distances, i
     }
 }
 
+void
+GPUIVF::SearchResident(const int64_t& n, const float* data, const int64_t& k, float* d_distances, int64_t* d_labels,
+                       const Config& cfg) {
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    auto device_index = std::dynamic_pointer_cast<faiss::gpu::GpuIndexIVF>(index_);
+    if (device_index) {
+        auto search_cfg = std::dynamic_pointer_cast<IVFCfg>(cfg);
+        device_index->nprobe = search_cfg->nprobe;
+        ResScope rs(res_, gpu_id_);
+        device_index->search(n, (float*)data, k, d_distances, d_labels);
+    } else {
+        KNOWHERE_THROW_MSG("Not a GpuIndexIVF type.");
+    }
+}
+
 VectorIndexPtr
 GPUIVF::CopyGpuToCpu(const Config& config) {
     std::lock_guard<std::mutex> lk(mutex_);
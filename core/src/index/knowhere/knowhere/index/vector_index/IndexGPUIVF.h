@@ -66,6 +66,13 @@ class GPUIVF : public IVF, public GPUIndex {
     VectorIndexPtr
     CopyGpuToCpu(const Config& config) override;
 
+    // Search writing the topk straight into caller-provided device buffers;
+    // faiss detects the memory space of the output pointers, so the results
+    // never cross PCIe here. Queries stay on the host as usual.
+    void
+    SearchResident(const int64_t& n, const float* data, const int64_t& k, float* d_distances, int64_t* d_labels,
+                   const Config& cfg);
+
     VectorIndexPtr
     CopyGpuToGpu(const int64_t& device_id, const Config& config) override;
 
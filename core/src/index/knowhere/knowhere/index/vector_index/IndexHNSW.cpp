@@ -23,6 +23,7 @@
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/common/Log.h"
+#include "knowhere/common/SearchScratch.h"
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
 
 namespace knowhere {
@@ -36,8 +37,7 @@ IndexHNSW::Serialize() {
     try {
         MemoryIOWriter writer;
         index_->saveIndex(writer);
-        auto data = std::make_shared<uint8_t>();
-        data.reset(writer.data_);
+        auto data = writer.detach();
 
         BinarySet res_set;
         res_set.Append("HNSW", data, writer.total);
@@ -56,8 +56,9 @@ IndexHNSW::Load(const BinarySet& index_binary) {
         reader.total = binary->size;
         reader.data_ = binary->data.get();
 
-        hnswlib::SpaceInterface<float>* space;
+        hnswlib::SpaceInterface<float>* space = nullptr;
         index_ = std::make_shared<hnswlib::HierarchicalNSW<float>>(space);
+        // loadIndex reconstructs the space from the persisted metric type
         index_->loadIndex(reader);
     } catch (std::exception& e) {
         KNOWHERE_THROW_MSG(e.what());
@@ -73,8 +74,8 @@ IndexHNSW::Search(const DatasetPtr& dataset, const Config& config) {
 
     size_t id_size = sizeof(int64_t) * config->k;
     size_t dist_size = sizeof(float) * config->k;
-    auto p_id = (int64_t*)malloc(id_size * rows);
-    auto p_dist = (float*)malloc(dist_size * rows);
+    auto p_id = scratch::SearchIds(rows * config->k);
+    auto p_dist = scratch::SearchDistances(rows * config->k);
 
     using P = std::pair<float, int64_t>;
     auto compare = [](P& v1, P& v2) { return v1.first < v2.first; };
@@ -96,7 +97,7 @@ IndexHNSW::Search(const DatasetPtr& dataset, const Config& config) {
         memcpy(p_id + i * config->k, ids.data(), id_size);
     }
 
-    auto ret_ds = std::make_shared<Dataset>();
+    auto ret_ds = scratch::MakeDataset();
     ret_ds->Set(meta::IDS, p_id);
     ret_ds->Set(meta::DISTANCE, p_dist);
     return ret_ds;
@@ -133,6 +134,18 @@ IndexHNSW::Add(const DatasetPtr& dataset, const Config& config) {
     GETTENSOR(dataset)
     auto p_ids = dataset->Get<const int64_t*>(meta::IDS);
 
+    // grow the graph when appending beyond its build-time capacity, so a
+    // loaded index keeps accepting inserts instead of requiring a full
+    // rebuild; doubling amortizes the O(n) reallocation in resizeIndex
+    size_t required = index_->cur_element_count + rows;
+    if (required > index_->max_elements_) {
+        size_t new_size = std::max(index_->max_elements_, size_t(1));
+        while (new_size < required) {
+            new_size *= 2;
+        }
+        index_->resizeIndex(new_size);
+    }
+
     for (int i = 0; i < 1; i++) {
         index_->addPoint((void*)(p_data + dim * i), p_ids[i]);
     }
@@ -14,6 +14,7 @@
 
 #include <faiss/AutoTune.h>
 #include <faiss/clone_index.h>
+#include <faiss/impl/AuxIndexStructures.h>
 #include <faiss/index_factory.h>
 #include <faiss/index_io.h>
 
@@ -27,6 +28,7 @@
 
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
+#include "knowhere/common/SearchScratch.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
 
@@ -63,19 +65,37 @@ IDMAP::Search(const DatasetPtr& dataset, const Config& config) {
     GETTENSOR(dataset)
 
     auto elems = rows * config->k;
-    size_t p_id_size = sizeof(int64_t) * elems;
-    size_t p_dist_size = sizeof(float) * elems;
-    auto p_id = (int64_t*)malloc(p_id_size);
-    auto p_dist = (float*)malloc(p_dist_size);
+    auto p_id = scratch::SearchIds(elems);
+    auto p_dist = scratch::SearchDistances(elems);
 
     search_impl(rows, (float*)p_data, config->k, p_dist, p_id, Config());
 
-    auto ret_ds = std::make_shared<Dataset>();
+    auto ret_ds = scratch::MakeDataset();
     ret_ds->Set(meta::IDS, p_id);
     ret_ds->Set(meta::DISTANCE, p_dist);
     return ret_ds;
 }
 
+void
+IDMAP::RangeSearch(const DatasetPtr& dataset, float radius, const Config& config, std::vector<int64_t>& ids,
+                   std::vector<float>& distances, std::vector<size_t>& lims) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    GETTENSOR(dataset)
+
+    try {
+        faiss::RangeSearchResult res(rows);
+        index_->range_search(rows, (float*)p_data, radius, &res);
+
+        lims.assign(res.lims, res.lims + rows + 1);
+        ids.assign(res.labels, res.labels + lims[rows]);
+        distances.assign(res.distances, res.distances + lims[rows]);
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
 void
 IDMAP::search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& cfg) {
     index_->search(n, (float*)data, k, distances, labels);
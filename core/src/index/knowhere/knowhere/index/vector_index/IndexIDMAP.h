@@ -32,12 +32,18 @@ class IDMAP : public VectorIndex, public FaissBaseIndex {
     void
     Load(const BinarySet& index_binary) override;
 
-    void
+    virtual void
     Train(const Config& config);
 
     DatasetPtr
     Search(const DatasetPtr& dataset, const Config& config) override;
 
+    // all neighbors within `radius` of each query; matches for query i are
+    // ids[lims[i]:lims[i+1]], distances follow the index metric and are not sorted
+    virtual void
+    RangeSearch(const DatasetPtr& dataset, float radius, const Config& config, std::vector<int64_t>& ids,
+                std::vector<float>& distances, std::vector<size_t>& lims);
+
     int64_t
     Count() override;
 
@@ -0,0 +1,75 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <faiss/IndexScalarQuantizer.h>
+#include <faiss/MetaIndexes.h>
+#include <faiss/index_factory.h>
+
+#include "knowhere/adapter/VectorAdapter.h"
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexIDMAPSQ.h"
+
+namespace knowhere {
+
+void
+IDMAPSQ::Train(const Config& config) {
+    config->CheckValid();
+
+    const char* type = "IDMap,SQ8";
+    auto index = faiss::index_factory(config->d, type, GetMetricType(config->metric_type));
+    index_.reset(index);
+}
+
+void
+IDMAPSQ::Add(const DatasetPtr& dataset, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    GETTENSOR(dataset)
+
+    auto p_ids = dataset->Get<const int64_t*>(meta::IDS);
+    if (!index_->is_trained) {
+        // the scalar quantizer only needs per-dimension value ranges, so the
+        // first inserted batch is representative enough for a fresh segment
+        index_->train(rows, (float*)p_data);
+    }
+    index_->add_with_ids(rows, (float*)p_data, p_ids);
+    raw_cache_.clear();
+}
+
+void
+IDMAPFP16::Train(const Config& config) {
+    config->CheckValid();
+
+    const char* type = "IDMap,SQfp16";
+    auto index = faiss::index_factory(config->d, type, GetMetricType(config->metric_type));
+    index_.reset(index);
+}
+
+const float*
+IDMAPSQ::GetRawVectors() {
+    try {
+        auto file_index = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+        auto sq_index = dynamic_cast<faiss::IndexScalarQuantizer*>(file_index->index);
+        size_t total = sq_index->ntotal * sq_index->d;
+        if (raw_cache_.size() != total) {
+            raw_cache_.resize(total);
+            sq_index->reconstruct_n(0, sq_index->ntotal, raw_cache_.data());
+        }
+        return raw_cache_.data();
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+}  // namespace knowhere
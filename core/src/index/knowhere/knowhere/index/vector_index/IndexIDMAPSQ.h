@@ -0,0 +1,66 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "IndexIDMAP.h"
+
+namespace knowhere {
+
+// brute-force index storing vectors SQ8-encoded, 1 byte per dimension instead
+// of 4; the scalar quantizer is trained on the first batch of added vectors
+class IDMAPSQ : public IDMAP {
+ public:
+    IDMAPSQ() : IDMAP() {
+    }
+
+    explicit IDMAPSQ(std::shared_ptr<faiss::Index> index) : IDMAP(std::move(index)) {
+    }
+
+    void
+    Train(const Config& config) override;
+
+    void
+    Add(const DatasetPtr& dataset, const Config& config) override;
+
+    const float*
+    GetRawVectors() override;
+
+ private:
+    // decoded vectors, built lazily for merge/build-index consumers
+    std::vector<float> raw_cache_;
+};
+
+using IDMAPSQPtr = std::shared_ptr<IDMAPSQ>;
+
+// fp16 variant: 2 bytes per dimension; the fp16 codec needs no training and
+// keeps near-fp32 recall for embedding-style data, halving memory bandwidth
+// during flat scans. Consumers that require fp32 (merge, index build) get the
+// upconverted vectors through the inherited GetRawVectors
+class IDMAPFP16 : public IDMAPSQ {
+ public:
+    IDMAPFP16() : IDMAPSQ() {
+    }
+
+    explicit IDMAPFP16(std::shared_ptr<faiss::Index> index) : IDMAPSQ(std::move(index)) {
+    }
+
+    void
+    Train(const Config& config) override;
+};
+
+using IDMAPFP16Ptr = std::shared_ptr<IDMAPFP16>;
+
+}  // namespace knowhere
@@ -16,6 +16,7 @@
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFPQ.h>
 #include <faiss/clone_index.h>
+#include <faiss/impl/AuxIndexStructures.h>
 #include <faiss/index_factory.h>
 #include <faiss/index_io.h>
 #ifdef MILVUS_GPU_VERSION
@@ -24,7 +25,9 @@
 #endif
 
 #include <fiu-local.h>
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -32,6 +35,7 @@
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/common/Log.h"
+#include "knowhere/common/SearchScratch.h"
 #ifdef MILVUS_GPU_VERSION
 #include "knowhere/index/vector_index/IndexGPUIVF.h"
 #endif
@@ -118,10 +122,8 @@ IVF::Search(const DatasetPtr& dataset, const Config& config) {
         fiu_do_on("IVF.Search.throw_faiss_exception", throw faiss::FaissException(""));
         auto elems = rows * search_cfg->k;
 
-        size_t p_id_size = sizeof(int64_t) * elems;
-        size_t p_dist_size = sizeof(float) * elems;
-        auto p_id = (int64_t*)malloc(p_id_size);
-        auto p_dist = (float*)malloc(p_dist_size);
+        auto p_id = scratch::SearchIds(elems);
+        auto p_dist = scratch::SearchDistances(elems);
 
         search_impl(rows, (float*)p_data, search_cfg->k, p_dist, p_id, config);
 
@@ -138,7 +140,7 @@ IVF::Search(const DatasetPtr& dataset, const Config& config) {
         //    std::cout << ss_res_id.str() << std::endl;
         //    std::cout << ss_res_dist.str() << std::endl << std::endl;
 
-        auto ret_ds = std::make_shared<Dataset>();
+        auto ret_ds = scratch::MakeDataset();
         ret_ds->Set(meta::IDS, p_id);
         ret_ds->Set(meta::DISTANCE, p_dist);
         return ret_ds;
@@ -149,6 +151,33 @@ IVF::Search(const DatasetPtr& dataset, const Config& config) {
     }
 }
 
+void
+IVF::RangeSearch(const DatasetPtr& dataset, float radius, const Config& config, std::vector<int64_t>& ids,
+                 std::vector<float>& distances, std::vector<size_t>& lims) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    GETTENSOR(dataset)
+
+    try {
+        auto params = GenParams(config);
+        auto ivf_index = std::dynamic_pointer_cast<faiss::IndexIVF>(index_);
+        ivf_index->nprobe = params->nprobe;
+
+        faiss::RangeSearchResult res(rows);
+        ivf_index->range_search(rows, (float*)p_data, radius, &res);
+
+        lims.assign(res.lims, res.lims + rows + 1);
+        ids.assign(res.labels, res.labels + lims[rows]);
+        distances.assign(res.distances, res.distances + lims[rows]);
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
 void
 IVF::set_index_model(IndexModelPtr model) {
     std::lock_guard<std::mutex> lk(mutex_);
@@ -165,6 +194,7 @@ IVF::GenParams(const Config& config) {
 
     auto search_cfg = std::dynamic_pointer_cast<IVFCfg>(config);
     params->nprobe = search_cfg->nprobe;
+    params->sel = search_cfg->sel;
     // params->max_codes = config.get_with_default("max_codes", size_t(0));
 
     return params;
@@ -214,11 +244,70 @@ IVF::GenGraph(const float* data, const int64_t& k, Graph& graph, const Config& c
     }
 }
 
+CoarseAssignCache::AssignmentPtr
+IVF::ResolveCoarseAssignment(faiss::IndexIVF* ivf_index, int64_t n, const float* data, int64_t nprobe,
+                             const Config& cfg) {
+    auto search_cfg = std::dynamic_pointer_cast<IVFCfg>(cfg);
+    if (search_cfg == nullptr || search_cfg->assign_cache == nullptr) {
+        return nullptr;
+    }
+
+    // hashing walks every centroid once, so keep the result for the life of
+    // the index; 0 doubles as "not yet computed" since HashQuantizer never
+    // returns it for a hashable quantizer
+    uint64_t hash = quantizer_hash_.load(std::memory_order_relaxed);
+    if (hash == 0) {
+        hash = CoarseAssignCache::HashQuantizer(ivf_index->quantizer);
+        if (hash != 0) {
+            quantizer_hash_.store(hash, std::memory_order_relaxed);
+        }
+    }
+    if (hash == 0) {
+        return nullptr;
+    }
+
+    nprobe = std::min<int64_t>(nprobe, ivf_index->nlist);
+    auto assignment = search_cfg->assign_cache->Fetch(hash, n, nprobe);
+    if (assignment == nullptr) {
+        auto fresh = std::make_shared<CoarseAssignCache::Assignment>();
+        fresh->n = n;
+        fresh->nprobe = nprobe;
+        fresh->labels.resize(n * nprobe);
+        fresh->distances.resize(n * nprobe);
+        ivf_index->quantizer->search(n, data, nprobe, fresh->distances.data(), fresh->labels.data());
+        assignment = fresh;
+        search_cfg->assign_cache->Store(hash, assignment);
+    }
+    return assignment;
+}
+
 void
 IVF::search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& cfg) {
     auto params = GenParams(cfg);
+    auto search_cfg = std::dynamic_pointer_cast<IVFCfg>(cfg);
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
     stdclock::time_point before = stdclock::now();
-    faiss::ivflib::search_with_parameters(index_.get(), n, (float*)data, k, distances, labels, params.get());
+
+    // per-job assignment reuse: segments sharing a trained quantizer rank the
+    // same centroids for the same queries, so the ranking is computed once
+    // per job and replayed here
+    CoarseAssignCache::AssignmentPtr assignment = nullptr;
+    if (ivf_index != nullptr) {
+        assignment = ResolveCoarseAssignment(ivf_index, n, data, params->nprobe, cfg);
+    }
+
+    if (search_cfg != nullptr && search_cfg->probe_stop_window > 0 && search_cfg->probe_stop_window < params->nprobe &&
+        ivf_index != nullptr) {
+        adaptive_search_impl(ivf_index, n, data, k, distances, labels, params->nprobe,
+                             search_cfg->probe_stop_window, params->sel, assignment);
+    } else if (assignment != nullptr) {
+        faiss::IVFSearchParameters preassigned_params = *params;
+        preassigned_params.nprobe = assignment->nprobe;
+        ivf_index->search_preassigned(n, data, k, assignment->labels.data(), assignment->distances.data(), distances,
+                                      labels, false, &preassigned_params);
+    } else {
+        faiss::ivflib::search_with_parameters(index_.get(), n, (float*)data, k, distances, labels, params.get());
+    }
     stdclock::time_point after = stdclock::now();
     double search_cost = (std::chrono::duration<double, std::micro>(after - before)).count();
     KNOWHERE_LOG_DEBUG << "IVF search cost: " << search_cost
@@ -228,6 +317,94 @@ IVF::search_impl(int64_t n, const float* data, int64_t k, float* distances, int6
     faiss::indexIVF_stats.search_time = 0;
 }
 
+void
+IVF::adaptive_search_impl(faiss::IndexIVF* ivf_index, int64_t n, const float* data, int64_t k, float* distances,
+                          int64_t* labels, int64_t nprobe, int64_t stop_window, const faiss::IDSelector* sel,
+                          const CoarseAssignCache::AssignmentPtr& assignment) {
+    nprobe = std::min<int64_t>(nprobe, ivf_index->nlist);
+
+    // quantize once; the probed lists come back ordered nearest-first, so scanning them
+    // in windows visits the most promising lists before the convergence check can fire
+    std::vector<faiss::Index::idx_t> assign;
+    std::vector<float> centroid_dis;
+    const faiss::Index::idx_t* assign_data = nullptr;
+    const float* centroid_dis_data = nullptr;
+    if (assignment != nullptr && assignment->n == n && assignment->nprobe == nprobe) {
+        assign_data = assignment->labels.data();
+        centroid_dis_data = assignment->distances.data();
+    } else {
+        assign.resize(n * nprobe);
+        centroid_dis.resize(n * nprobe);
+        ivf_index->quantizer->search(n, data, nprobe, centroid_dis.data(), assign.data());
+        assign_data = assign.data();
+        centroid_dis_data = centroid_dis.data();
+    }
+
+    bool greater_better = (ivf_index->metric_type == faiss::METRIC_INNER_PRODUCT);
+    auto better = [greater_better](float a, float b) { return greater_better ? (a > b) : (a < b); };
+
+    std::vector<float> chunk_dis(k), merged_dis(k), buf_dis(k);
+    std::vector<faiss::Index::idx_t> chunk_ids(k), merged_ids(k), buf_ids(k);
+
+    faiss::IVFSearchParameters chunk_params;
+    chunk_params.max_codes = 0;
+    chunk_params.sel = sel;
+
+    for (int64_t i = 0; i < n; i++) {
+        int64_t valid = 0;
+        int64_t probed = 0;
+        while (probed < nprobe) {
+            int64_t chunk = std::min(stop_window, nprobe - probed);
+            chunk_params.nprobe = chunk;
+
+            bool full_before = (valid == k);
+            float prev_worst = full_before ? merged_dis[k - 1] : 0.0f;
+
+            ivf_index->search_preassigned(1, data + i * ivf_index->d, k, assign_data + i * nprobe + probed,
+                                          centroid_dis_data + i * nprobe + probed, chunk_dis.data(),
+                                          chunk_ids.data(), false, &chunk_params);
+
+            // merge the chunk result into the running top-k, both sorted best-first
+            int64_t a = 0, b = 0, out = 0;
+            while (out < k) {
+                bool have_a = (a < valid);
+                bool have_b = (b < k && chunk_ids[b] != -1);
+                if (!have_a && !have_b) {
+                    break;
+                }
+                if (have_a && (!have_b || !better(chunk_dis[b], merged_dis[a]))) {
+                    buf_dis[out] = merged_dis[a];
+                    buf_ids[out] = merged_ids[a];
+                    a++;
+                } else {
+                    buf_dis[out] = chunk_dis[b];
+                    buf_ids[out] = chunk_ids[b];
+                    b++;
+                }
+                out++;
+            }
+            merged_dis.swap(buf_dis);
+            merged_ids.swap(buf_ids);
+            valid = out;
+            probed += chunk;
+
+            if (full_before && valid == k && !better(merged_dis[k - 1], prev_worst)) {
+                break;  // the worst kept distance did not improve over the last window
+            }
+        }
+
+        for (int64_t j = 0; j < k; j++) {
+            if (j < valid) {
+                distances[i * k + j] = merged_dis[j];
+                labels[i * k + j] = merged_ids[j];
+            } else {
+                distances[i * k + j] = greater_better ? -HUGE_VALF : HUGE_VALF;
+                labels[i * k + j] = -1;
+            }
+        }
+    }
+}
+
 VectorIndexPtr
 IVF::CopyCpuToGpu(const int64_t& device_id, const Config& config) {
 #ifdef MILVUS_GPU_VERSION
@@ -271,6 +448,22 @@ IVF::Seal() {
     SealImpl();
 }
 
+void
+IVF::Merge(const VectorIndexPtr& other) {
+    auto source = std::dynamic_pointer_cast<IVF>(other);
+    if (source == nullptr) {
+        KNOWHERE_THROW_MSG("merge source is not an ivf index");
+    }
+    auto target_ivf = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    auto source_ivf = dynamic_cast<faiss::IndexIVF*>(source->index_.get());
+    if (target_ivf == nullptr || source_ivf == nullptr) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    target_ivf->merge_from(*source_ivf, 0);
+}
+
 IVFIndexModel::IVFIndexModel(std::shared_ptr<faiss::Index> index) : FaissBaseIndex(std::move(index)) {
 }
 
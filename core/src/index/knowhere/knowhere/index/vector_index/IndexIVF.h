@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -19,6 +20,7 @@
 #include "FaissBaseIndex.h"
 #include "VectorIndex.h"
 #include "faiss/IndexIVF.h"
+#include "knowhere/index/vector_index/helpers/CoarseAssignCache.h"
 
 namespace knowhere {
 
@@ -50,6 +52,12 @@ class IVF : public VectorIndex, public FaissBaseIndex {
     DatasetPtr
     Search(const DatasetPtr& dataset, const Config& config) override;
 
+    // all neighbors within `radius` of each query; matches for query i are
+    // ids[lims[i]:lims[i+1]], distances follow the index metric and are not sorted
+    virtual void
+    RangeSearch(const DatasetPtr& dataset, float radius, const Config& config, std::vector<int64_t>& ids,
+                std::vector<float>& distances, std::vector<size_t>& lims);
+
     void
     GenGraph(const float* data, const int64_t& k, Graph& graph, const Config& config);
 
@@ -68,6 +76,12 @@ class IVF : public VectorIndex, public FaissBaseIndex {
     void
     Seal() override;
 
+    // move the entries of `other` into this index; both sides must descend
+    // from the same trained quantizer. Used to reassemble per-device encode
+    // shards of one segment build into a single host index.
+    void
+    Merge(const VectorIndexPtr& other);
+
     virtual VectorIndexPtr
     CopyCpuToGpu(const int64_t& device_id, const Config& config);
 
@@ -81,8 +95,27 @@ class IVF : public VectorIndex, public FaissBaseIndex {
     virtual void
     search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& cfg);
 
+    // chunked scan over the probed lists that stops early once the top-k worst
+    // distance stops improving; used when IVFCfg::probe_stop_window > 0.
+    // `assignment` optionally supplies a precomputed centroid ranking
+    void
+    adaptive_search_impl(faiss::IndexIVF* ivf_index, int64_t n, const float* data, int64_t k, float* distances,
+                         int64_t* labels, int64_t nprobe, int64_t stop_window, const faiss::IDSelector* sel = nullptr,
+                         const CoarseAssignCache::AssignmentPtr& assignment = nullptr);
+
+    // resolves IVFCfg::assign_cache: replays a cached centroid ranking for
+    // this index's quantizer or computes and stores one. Returns nullptr when
+    // no cache is set or the quantizer cannot be hashed
+    CoarseAssignCache::AssignmentPtr
+    ResolveCoarseAssignment(faiss::IndexIVF* ivf_index, int64_t n, const float* data, int64_t nprobe,
+                            const Config& cfg);
+
  protected:
     std::mutex mutex_;
+
+    // lazily computed centroid hash of this index's quantizer, keying the
+    // per-job assignment cache; 0 means not yet computed (or unhashable)
+    std::atomic<uint64_t> quantizer_hash_{0};
 };
 
 using IVFIndexPtr = std::shared_ptr<IVF>;
@@ -50,6 +50,7 @@ IVFPQ::GenParams(const Config& config) {
     auto params = std::make_shared<faiss::IVFPQSearchParameters>();
     auto search_cfg = std::dynamic_pointer_cast<IVFPQCfg>(config);
     params->nprobe = search_cfg->nprobe;
+    params->sel = search_cfg->sel;
     //    params->scan_table_threshold = conf->scan_table_threhold;
     //    params->polysemous_ht = conf->polysemous_ht;
     //    params->max_codes = conf->max_codes;
@@ -0,0 +1,242 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFPQ.h>
+#include <faiss/utils/Heap.h>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "knowhere/adapter/VectorAdapter.h"
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
+
+namespace knowhere {
+
+// block granularity of the packed layout: one vpshufb covers 32 codes
+static constexpr size_t FASTSCAN_BLOCK = 32;
+
+IndexModelPtr
+IVFPQFastScan::Train(const DatasetPtr& dataset, const Config& config) {
+    auto build_cfg = std::dynamic_pointer_cast<IVFPQCfg>(config);
+    if (build_cfg != nullptr) {
+        build_cfg->CheckValid();  // throw exception
+    }
+    if (build_cfg->m % 2 != 0) {
+        KNOWHERE_THROW_MSG("fastscan PQ requires an even m: two 4-bit codes share a byte");
+    }
+
+    GETTENSOR(dataset)
+
+    faiss::Index* coarse_quantizer = new faiss::IndexFlat(dim, GetMetricType(build_cfg->metric_type));
+    // nbits is pinned to 4 regardless of the config: the in-register table
+    // lookup only exists for 16-centroid sub-quantizers
+    auto index = std::make_shared<faiss::IndexIVFPQ>(coarse_quantizer, dim, build_cfg->nlist, build_cfg->m, 4);
+    // encode raw vectors, not residuals: one lookup table per query then
+    // serves every probed list, which is what keeps the scan register-bound
+    index->by_residual = false;
+    index->train(rows, (float*)p_data);
+
+    return std::make_shared<IVFIndexModel>(index);
+}
+
+void
+IVFPQFastScan::Add(const DatasetPtr& dataset, const Config& config) {
+    IVFPQ::Add(dataset, config);
+    std::lock_guard<std::mutex> lk(mutex_);
+    packed_ = false;
+}
+
+void
+IVFPQFastScan::Load(const BinarySet& index_binary) {
+    IVFPQ::Load(index_binary);
+    std::lock_guard<std::mutex> lk(mutex_);
+    packed_ = false;
+}
+
+void
+IVFPQFastScan::EnsurePacked() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (packed_) {
+        return;
+    }
+
+    auto ivfpq_index = static_cast<faiss::IndexIVFPQ*>(index_.get());
+    auto invlists = ivfpq_index->invlists;
+    size_t code_size = ivfpq_index->pq.code_size;
+
+    packed_lists_.assign(ivfpq_index->nlist, {});
+    for (size_t list_no = 0; list_no < ivfpq_index->nlist; ++list_no) {
+        size_t list_size = invlists->list_size(list_no);
+        if (list_size == 0) {
+            continue;
+        }
+        size_t blocks = (list_size + FASTSCAN_BLOCK - 1) / FASTSCAN_BLOCK;
+        auto& packed = packed_lists_[list_no];
+        packed.assign(blocks * code_size * FASTSCAN_BLOCK, 0);
+
+        faiss::InvertedLists::ScopedCodes codes(invlists, list_no);
+        for (size_t v = 0; v < list_size; ++v) {
+            uint8_t* block = packed.data() + (v / FASTSCAN_BLOCK) * code_size * FASTSCAN_BLOCK;
+            for (size_t p = 0; p < code_size; ++p) {
+                block[p * FASTSCAN_BLOCK + (v % FASTSCAN_BLOCK)] = codes.get()[v * code_size + p];
+            }
+        }
+    }
+    packed_ = true;
+}
+
+void
+IVFPQFastScan::ScanPackedList(size_t list_no, const uint8_t* qlut, float bias, float delta, int64_t k, float* simi,
+                              int64_t* idxi) const {
+    auto ivfpq_index = static_cast<faiss::IndexIVFPQ*>(index_.get());
+    size_t list_size = ivfpq_index->invlists->list_size(list_no);
+    if (list_size == 0) {
+        return;
+    }
+    size_t code_size = ivfpq_index->pq.code_size;
+    const auto& packed = packed_lists_[list_no];
+    faiss::InvertedLists::ScopedIds ids(ivfpq_index->invlists, list_no);
+
+    size_t blocks = (list_size + FASTSCAN_BLOCK - 1) / FASTSCAN_BLOCK;
+    uint16_t acc[FASTSCAN_BLOCK];
+
+    for (size_t b = 0; b < blocks; ++b) {
+        const uint8_t* block = packed.data() + b * code_size * FASTSCAN_BLOCK;
+
+#ifdef __AVX2__
+        const __m256i lo_mask = _mm256_set1_epi8(0x0f);
+        __m256i acc_lo = _mm256_setzero_si256();
+        __m256i acc_hi = _mm256_setzero_si256();
+        for (size_t p = 0; p < code_size; ++p) {
+            // one 16-byte table per sub-quantizer, broadcast to both lanes so
+            // the lane-local vpshufb sees the full table
+            __m128i lut128_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(qlut + 2 * p * 16));
+            __m128i lut128_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(qlut + (2 * p + 1) * 16));
+            __m256i lut_lo = _mm256_broadcastsi128_si256(lut128_lo);
+            __m256i lut_hi = _mm256_broadcastsi128_si256(lut128_hi);
+
+            __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + p * FASTSCAN_BLOCK));
+            __m256i nib_lo = _mm256_and_si256(c, lo_mask);
+            __m256i nib_hi = _mm256_and_si256(_mm256_srli_epi16(c, 4), lo_mask);
+            __m256i d_lo = _mm256_shuffle_epi8(lut_lo, nib_lo);
+            __m256i d_hi = _mm256_shuffle_epi8(lut_hi, nib_hi);
+
+            // widen to uint16 before summing over m: totals reach m * 255
+            __m256i d = _mm256_add_epi16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(d_lo)),
+                                         _mm256_cvtepu8_epi16(_mm256_castsi256_si128(d_hi)));
+            acc_lo = _mm256_add_epi16(acc_lo, d);
+            d = _mm256_add_epi16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(d_lo, 1)),
+                                 _mm256_cvtepu8_epi16(_mm256_extracti128_si256(d_hi, 1)));
+            acc_hi = _mm256_add_epi16(acc_hi, d);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), acc_lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 16), acc_hi);
+#else
+        // scalar fallback over the identical layout
+        std::memset(acc, 0, sizeof(acc));
+        for (size_t p = 0; p < code_size; ++p) {
+            const uint8_t* line = block + p * FASTSCAN_BLOCK;
+            for (size_t j = 0; j < FASTSCAN_BLOCK; ++j) {
+                acc[j] += qlut[2 * p * 16 + (line[j] & 0x0f)];
+                acc[j] += qlut[(2 * p + 1) * 16 + (line[j] >> 4)];
+            }
+        }
+#endif
+
+        size_t jmax = std::min(list_size - b * FASTSCAN_BLOCK, FASTSCAN_BLOCK);
+        for (size_t j = 0; j < jmax; ++j) {
+            float dis = bias + delta * static_cast<float>(acc[j]);
+            if (dis < simi[0]) {
+                faiss::maxheap_pop(k, simi, idxi);
+                faiss::maxheap_push(k, simi, idxi, dis, ids.get()[b * FASTSCAN_BLOCK + j]);
+            }
+        }
+    }
+}
+
+void
+IVFPQFastScan::search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                           const Config& cfg) {
+    EnsurePacked();
+
+    auto params = GenParams(cfg);
+    auto ivfpq_index = static_cast<faiss::IndexIVFPQ*>(index_.get());
+    auto& pq = ivfpq_index->pq;
+    size_t nprobe = std::min<size_t>(params->nprobe, ivfpq_index->nlist);
+    bool is_ip = ivfpq_index->metric_type == faiss::METRIC_INNER_PRODUCT;
+
+    std::vector<faiss::Index::idx_t> coarse_ids(n * nprobe);
+    std::vector<float> coarse_dis(n * nprobe);
+    ivfpq_index->quantizer->search(n, data, nprobe, coarse_dis.data(), coarse_ids.data());
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < n; ++i) {
+        // float lookup table on the raw query (codes are non-residual), then
+        // quantized to uint8 with a per-query affine: dis = bias + delta * acc
+        std::vector<float> lut(pq.M * 16);
+        if (is_ip) {
+            pq.compute_inner_prod_table(data + i * pq.d, lut.data());
+            // negate so smaller-is-better holds for both metrics internally
+            for (auto& v : lut) {
+                v = -v;
+            }
+        } else {
+            pq.compute_distance_table(data + i * pq.d, lut.data());
+        }
+
+        float bias = 0.0f;
+        float range = 0.0f;
+        for (size_t m = 0; m < pq.M; ++m) {
+            float mn = *std::min_element(lut.begin() + m * 16, lut.begin() + (m + 1) * 16);
+            bias += mn;
+            for (size_t c = 0; c < 16; ++c) {
+                float& v = lut[m * 16 + c];
+                v -= mn;
+                range = std::max(range, v);
+            }
+        }
+        float scale = range > 0.0f ? 255.0f / range : 0.0f;
+        float delta = range > 0.0f ? range / 255.0f : 0.0f;
+        std::vector<uint8_t> qlut(pq.M * 16);
+        for (size_t e = 0; e < qlut.size(); ++e) {
+            qlut[e] = static_cast<uint8_t>(std::lround(std::min(lut[e] * scale, 255.0f)));
+        }
+
+        float* simi = distances + i * k;
+        int64_t* idxi = labels + i * k;
+        faiss::maxheap_heapify(k, simi, idxi);
+        for (size_t probe = 0; probe < nprobe; ++probe) {
+            auto list_no = coarse_ids[i * nprobe + probe];
+            if (list_no < 0) {
+                continue;
+            }
+            ScanPackedList(list_no, qlut.data(), bias, delta, k, simi, idxi);
+        }
+        faiss::maxheap_reorder(k, simi, idxi);
+
+        if (is_ip) {
+            for (int64_t j = 0; j < k; ++j) {
+                simi[j] = -simi[j];
+            }
+        }
+    }
+}
+
+}  // namespace knowhere
@@ -0,0 +1,72 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "IndexIVFPQ.h"
+
+namespace knowhere {
+
+/*
+ * 4-bit register-resident PQ scan over an IVFPQ index. The classic byte-code
+ * scan gathers one lookup-table entry per sub-quantizer per vector and is
+ * bound by those gathers; with 4-bit codes every sub-quantizer's 16-entry
+ * table fits one SIMD register, so a vpshufb looks up 32 vectors' partial
+ * distances at once. Training forces nbits = 4 (an even m pairs two codes
+ * per byte) and encodes raw vectors rather than residuals, so one quantized
+ * uint8 table per query serves every probed list. Codes are repacked once
+ * after train/load into 32-vector transposed blocks; the serialized form
+ * stays a standard faiss IVFPQ, only the in-memory scan layout differs.
+ * Distances are accumulated in uint16 from the quantized tables, a ~0.4%
+ * scale error on top of the PQ approximation itself. Without AVX2 a scalar
+ * loop scans the same layout. CPU-only: GPU placement copies the classic
+ * index like plain IVFPQ.
+ */
+class IVFPQFastScan : public IVFPQ {
+ public:
+    IVFPQFastScan() = default;
+
+    explicit IVFPQFastScan(std::shared_ptr<faiss::Index> index) : IVFPQ(std::move(index)) {
+    }
+
+    IndexModelPtr
+    Train(const DatasetPtr& dataset, const Config& config) override;
+
+    void
+    Add(const DatasetPtr& dataset, const Config& config) override;
+
+    void
+    Load(const BinarySet& index_binary) override;
+
+ protected:
+    void
+    search_impl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& cfg) override;
+
+ private:
+    // transpose each inverted list into 32-vector blocks: block b of list l
+    // holds byte p of codes b*32 .. b*32+31 contiguously, zero-padded
+    void
+    EnsurePacked();
+
+    void
+    ScanPackedList(size_t list_no, const uint8_t* qlut, float bias, float delta, int64_t k, float* simi,
+                   int64_t* idxi) const;
+
+ private:
+    std::vector<std::vector<uint8_t>> packed_lists_;
+    bool packed_ = false;
+};
+
+}  // namespace knowhere
@@ -299,8 +299,7 @@ IVFSQHybrid::SerializeImpl() {
         MemoryIOWriter writer;
         faiss::write_index(index_.get(), &writer);
 
-        auto data = std::make_shared<uint8_t>();
-        data.reset(writer.data_);
+        auto data = writer.detach();
 
         BinarySet res_set;
         res_set.Append("IVF", data, writer.rp);
@@ -12,6 +12,7 @@
 #include "knowhere/index/vector_index/IndexNSG.h"
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
+#include "knowhere/common/SearchScratch.h"
 #include "knowhere/common/Timer.h"
 
 #ifdef MILVUS_GPU_VERSION
@@ -42,8 +43,7 @@ NSG::Serialize() {
 
         MemoryIOWriter writer;
         algo::write_index(index, writer);
-        auto data = std::make_shared<uint8_t>();
-        data.reset(writer.data_);
+        auto data = writer.detach();
 
         BinarySet res_set;
         res_set.Append("NSG", data, writer.total);
@@ -84,16 +84,14 @@ NSG::Search(const DatasetPtr& dataset, const Config& config) {
     GETTENSOR(dataset)
 
     auto elems = rows * build_cfg->k;
-    size_t p_id_size = sizeof(int64_t) * elems;
-    size_t p_dist_size = sizeof(float) * elems;
-    auto p_id = (int64_t*)malloc(p_id_size);
-    auto p_dist = (float*)malloc(p_dist_size);
+    auto p_id = scratch::SearchIds(elems);
+    auto p_dist = scratch::SearchDistances(elems);
 
     algo::SearchParams s_params;
     s_params.search_length = build_cfg->search_length;
     index_->Search((float*)p_data, rows, dim, build_cfg->k, p_dist, p_id, s_params);
 
-    auto ret_ds = std::make_shared<Dataset>();
+    auto ret_ds = scratch::MakeDataset();
     ret_ds->Set(meta::IDS, p_id);
     ret_ds->Set(meta::DISTANCE, p_dist);
     return ret_ds;
@@ -137,6 +135,7 @@ NSG::Train(const DatasetPtr& dataset, const Config& config) {
     b_params.candidate_pool_size = build_cfg->candidate_pool_size;
     b_params.out_degree = build_cfg->out_degree;
     b_params.search_length = build_cfg->search_length;
+    b_params.build_thread_num = build_cfg->build_thread_num > 0 ? build_cfg->build_thread_num : 0;
 
     auto p_ids = dataset->Get<const int64_t*>(meta::IDS);
 
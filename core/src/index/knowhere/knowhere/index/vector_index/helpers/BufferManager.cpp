@@ -0,0 +1,95 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "knowhere/index/vector_index/helpers/BufferManager.h"
+
+namespace knowhere {
+
+namespace {
+
+// slabs below this round up to one class, so tiny test indexes do not
+// fragment the pool into dozens of lists
+constexpr size_t MIN_SLAB_BYTES = 1 << 20;  // 1 MB
+
+// free lists stop growing past this; the pool bounds idle memory, it is not
+// allowed to pin every slab ever serialized
+constexpr size_t MAX_CACHED_BYTES = size_t(1) << 30;  // 1 GB
+
+}  // namespace
+
+size_t
+BufferManager::RoundUpToClass(size_t bytes) {
+    size_t capacity = MIN_SLAB_BYTES;
+    while (capacity < bytes) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+uint8_t*
+BufferManager::Allocate(size_t bytes, size_t& capacity) {
+    capacity = RoundUpToClass(bytes);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = free_lists_.find(capacity);
+        if (it != free_lists_.end() && !it->second.empty()) {
+            auto slab = it->second.back();
+            it->second.pop_back();
+            cached_bytes_ -= capacity;
+            return slab;
+        }
+    }
+
+    // allocate outside the lock; multi-GB zeroing must not serialize the pool
+    auto slab = new uint8_t[capacity];
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slab_capacity_[slab] = capacity;
+    }
+    return slab;
+}
+
+void
+BufferManager::Release(uint8_t* slab) {
+    if (slab == nullptr) {
+        return;
+    }
+
+    bool cached = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto capacity = slab_capacity_.at(slab);
+        if (cached_bytes_ + capacity <= MAX_CACHED_BYTES) {
+            free_lists_[capacity].push_back(slab);
+            cached_bytes_ += capacity;
+            cached = true;
+        } else {
+            slab_capacity_.erase(slab);
+        }
+    }
+    if (!cached) {
+        delete[] slab;
+    }
+}
+
+std::shared_ptr<uint8_t>
+BufferManager::MakeShared(uint8_t* slab) {
+    return std::shared_ptr<uint8_t>(slab, [](uint8_t* p) { BufferManager::GetInstance().Release(p); });
+}
+
+size_t
+BufferManager::CachedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cached_bytes_;
+}
+
+}  // namespace knowhere
@@ -0,0 +1,76 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace knowhere {
+
+// Global pool for the large flat buffers serialization churns through.
+// Requests are rounded up to a power-of-two size class and satisfied from a
+// per-class free list, so segment build/load cycles reuse the same slabs
+// instead of asking the system allocator for multi-GB blocks every time.
+// MakeShared() wraps a slab with a deleter that returns it to the pool, which
+// is what SerializeImpl hands to BinarySet: downstream consumers (cache
+// insertion, storage writers) keep the slab alive by reference count and can
+// take zero-copy slices via the shared_ptr aliasing constructor.
+class BufferManager {
+ public:
+    static BufferManager&
+    GetInstance() {
+        static BufferManager instance;
+        return instance;
+    }
+
+    BufferManager(const BufferManager&) = delete;
+
+    BufferManager&
+    operator=(const BufferManager&) = delete;
+
+    // returns a slab of at least `bytes`; `capacity` receives the slab's real
+    // size-class capacity so the caller can fill it before growing again
+    uint8_t*
+    Allocate(size_t bytes, size_t& capacity);
+
+    // hand a slab back; it is cached on its size-class free list, or freed
+    // outright once the cache cap is reached
+    void
+    Release(uint8_t* slab);
+
+    // wrap a slab so the last owner returns it to the pool
+    std::shared_ptr<uint8_t>
+    MakeShared(uint8_t* slab);
+
+    // bytes currently sitting on the free lists (for logging/tests)
+    size_t
+    CachedBytes() const;
+
+ private:
+    BufferManager() = default;
+
+    static size_t
+    RoundUpToClass(size_t bytes);
+
+ private:
+    mutable std::mutex mutex_;
+    std::unordered_map<uint8_t*, size_t> slab_capacity_;  // every live or cached slab
+    std::map<size_t, std::vector<uint8_t*>> free_lists_;
+    size_t cached_bytes_ = 0;
+};
+
+}  // namespace knowhere
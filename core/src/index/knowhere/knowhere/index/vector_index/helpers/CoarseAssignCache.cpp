@@ -0,0 +1,60 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "knowhere/index/vector_index/helpers/CoarseAssignCache.h"
+
+#include <faiss/IndexFlat.h>
+
+namespace knowhere {
+
+CoarseAssignCache::AssignmentPtr
+CoarseAssignCache::Fetch(uint64_t quantizer_hash, int64_t n, int64_t nprobe) {
+    if (quantizer_hash == 0) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(std::make_pair(quantizer_hash, nprobe));
+    if (it == cache_.end() || it->second->n != n) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void
+CoarseAssignCache::Store(uint64_t quantizer_hash, const AssignmentPtr& assignment) {
+    if (quantizer_hash == 0 || assignment == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.emplace(std::make_pair(quantizer_hash, assignment->nprobe), assignment);
+}
+
+uint64_t
+CoarseAssignCache::HashQuantizer(const faiss::Index* quantizer) {
+    auto flat = dynamic_cast<const faiss::IndexFlat*>(quantizer);
+    if (flat == nullptr || flat->xb.empty()) {
+        return 0;
+    }
+
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const uint8_t* bytes, size_t len) {
+        for (size_t i = 0; i < len; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    int64_t shape[2] = {quantizer->d, quantizer->ntotal};
+    mix(reinterpret_cast<const uint8_t*>(shape), sizeof(shape));
+    mix(reinterpret_cast<const uint8_t*>(flat->xb.data()), flat->xb.size() * sizeof(float));
+    return hash == 0 ? 1 : hash;
+}
+
+}  // namespace knowhere
@@ -0,0 +1,63 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <faiss/Index.h>
+
+namespace knowhere {
+
+// Per-search-job cache of query→coarse-centroid rankings. With per-table
+// quantizer reuse the segments of a table carry identical centroids, yet a
+// multi-segment search used to rank them against the same queries once per
+// segment. The first task through an IVF index computes the nq×nprobe ranking
+// and stores it under the quantizer's centroid hash; every later task whose
+// quantizer hashes the same replays it and skips its quantization phase.
+//
+// Entries are immutable once stored and the cache lives only as long as one
+// search job, so there is no eviction.
+class CoarseAssignCache {
+ public:
+    struct Assignment {
+        std::vector<faiss::Index::idx_t> labels;
+        std::vector<float> distances;
+        int64_t n = 0;
+        int64_t nprobe = 0;
+    };
+    using AssignmentPtr = std::shared_ptr<const Assignment>;
+
+    AssignmentPtr
+    Fetch(uint64_t quantizer_hash, int64_t n, int64_t nprobe);
+
+    void
+    Store(uint64_t quantizer_hash, const AssignmentPtr& assignment);
+
+    // FNV-1a over a flat quantizer's centroid bytes plus d and ntotal, so the
+    // deep copies a shared trained model leaves in each segment hash alike.
+    // Returns 0 for quantizers the hash cannot identify; 0 is never cached.
+    static uint64_t
+    HashQuantizer(const faiss::Index* quantizer);
+
+ private:
+    std::mutex mutex_;
+    std::map<std::pair<uint64_t, int64_t>, AssignmentPtr> cache_;  // (hash, nprobe) -> ranking
+};
+
+using CoarseAssignCachePtr = std::shared_ptr<CoarseAssignCache>;
+
+}  // namespace knowhere
@@ -66,7 +66,12 @@ FaissGpuResourceMgr::InitResource() {
             // std::cout << "Resource Id: " << i << std::endl;
             auto raw_resource = std::make_shared<faiss::gpu::StandardGpuResources>();
 
-            // TODO(linxj): enable set pinned memory
+            // pinned staging buffers let faiss page host data through true
+            // asynchronous copies, so an upload on one resource overlaps with
+            // a search running on another resource's stream
+            if (device_param.pinned_mem_size) {
+                raw_resource->setPinnedMemory(device_param.pinned_mem_size);
+            }
             auto res_wrapper = std::make_shared<Resource>(raw_resource);
             AllocateTempMem(res_wrapper, device_id, 0);
 
@@ -11,6 +11,7 @@
 
 #include <cstring>
 
+#include "knowhere/index/vector_index/helpers/BufferManager.h"
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
 
 namespace knowhere {
@@ -18,22 +19,28 @@ namespace knowhere {
 // TODO(linxj): Get From Config File
 static size_t magic_num = 2;
 
+MemoryIOWriter::~MemoryIOWriter() {
+    // only reached when the buffer was never detached, e.g. when
+    // serialization threw halfway through
+    if (data_) {
+        BufferManager::GetInstance().Release(data_);
+    }
+}
+
 size_t
 MemoryIOWriter::operator()(const void* ptr, size_t size, size_t nitems) {
     auto total_need = size * nitems + rp;
 
     if (!data_) {  // data == nullptr
-        total = total_need * magic_num;
+        data_ = BufferManager::GetInstance().Allocate(total_need * magic_num, total);
         rp = size * nitems;
-        data_ = new uint8_t[total];
         memcpy((void*)(data_), ptr, rp);
     }
 
     if (total_need > total) {
-        total = total_need * magic_num;
-        auto new_data = new uint8_t[total];
+        auto new_data = BufferManager::GetInstance().Allocate(total_need * magic_num, total);
         memcpy((void*)new_data, (void*)data_, rp);
-        delete data_;
+        BufferManager::GetInstance().Release(data_);
         data_ = new_data;
 
         memcpy((void*)(data_ + rp), ptr, size * nitems);
@@ -46,6 +53,28 @@ MemoryIOWriter::operator()(const void* ptr, size_t size, size_t nitems) {
     return nitems;
 }
 
+void
+MemoryIOWriter::reserve(size_t bytes) {
+    if (bytes <= total) {
+        return;
+    }
+    auto new_data = BufferManager::GetInstance().Allocate(bytes, total);
+    if (data_) {
+        memcpy((void*)new_data, (void*)data_, rp);
+        BufferManager::GetInstance().Release(data_);
+    }
+    data_ = new_data;
+}
+
+std::shared_ptr<uint8_t>
+MemoryIOWriter::detach() {
+    // rp and total keep their values: callers still read the written size
+    // after the handoff
+    auto data = BufferManager::GetInstance().MakeShared(data_);
+    data_ = nullptr;
+    return data;
+}
+
 size_t
 MemoryIOReader::operator()(void* ptr, size_t size, size_t nitems) {
     if (rp >= total)
@@ -11,18 +11,35 @@
 
 #pragma once
 
+#include <memory>
+
 #include <faiss/impl/io.h>
 
 namespace knowhere {
 
+// the backing buffer comes from the BufferManager slab pool, so repeated
+// serialize cycles reuse slabs instead of thrashing the system allocator
 struct MemoryIOWriter : public faiss::IOWriter {
     uint8_t* data_ = nullptr;
     size_t total = 0;
     size_t rp = 0;
 
+    ~MemoryIOWriter();
+
     size_t
     operator()(const void* ptr, size_t size, size_t nitems) override;
 
+    // pre-size the buffer so serializing a fully built index does not walk
+    // the doubling realloc-and-copy chain; a low estimate is harmless, the
+    // buffer still grows on demand
+    void
+    reserve(size_t bytes);
+
+    // hand the buffer off reference-counted; the last owner returns the slab
+    // to the pool. rp/total stay readable for the size bookkeeping callers do.
+    std::shared_ptr<uint8_t>
+    detach();
+
     template <typename T>
     size_t
     write(T* ptr, size_t size, size_t nitems = 1) {
@@ -34,6 +34,12 @@ GetMetricType(METRICTYPE& type) {
     if (type == METRICTYPE::HAMMING) {
         return faiss::METRIC_Hamming;
     }
+    if (type == METRICTYPE::SUBSTRUCTURE) {
+        return faiss::METRIC_Substructure;
+    }
+    if (type == METRICTYPE::SUPERSTRUCTURE) {
+        return faiss::METRIC_Superstructure;
+    }
 
     KNOWHERE_THROW_MSG("Metric type is invalid");
 }
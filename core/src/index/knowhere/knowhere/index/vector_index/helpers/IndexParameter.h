@@ -16,8 +16,14 @@
 
 #include "knowhere/common/Config.h"
 
+namespace faiss {
+struct IDSelector;
+}
+
 namespace knowhere {
 
+class CoarseAssignCache;
+
 extern faiss::MetricType
 GetMetricType(METRICTYPE& type);
 
@@ -69,6 +75,19 @@ constexpr int64_t DEFAULT_EF = INVALID_VALUE;
 struct IVFCfg : public Cfg {
     int64_t nlist = DEFAULT_NLIST;
     int64_t nprobe = DEFAULT_NPROBE;
+    // adaptive probing: stop scanning once the top-k worst distance has not improved
+    // over this many consecutive lists; 0 scans exactly nprobe lists
+    int64_t probe_stop_window = 0;
+
+    // optional deletion mask applied inside the faiss scan; filtered ids never
+    // enter the result heap so topk semantics hold without over-fetching.
+    // not owned, must stay alive for the duration of the search call
+    const faiss::IDSelector* sel = nullptr;
+
+    // optional per-job cache of query→centroid rankings, replayed instead of
+    // re-quantizing when the index's quantizer hash matches a stored entry.
+    // not owned, must stay alive for the duration of the search call
+    CoarseAssignCache* assign_cache = nullptr;
 
     IVFCfg(const int64_t& dim, const int64_t& k, const int64_t& gpu_id, const int64_t& nlist, const int64_t& nprobe,
            METRICTYPE type)
@@ -150,6 +169,7 @@ struct NSGCfg : public IVFCfg {
     int64_t search_length = DEFAULT_SEARCH_LENGTH;
     int64_t out_degree = DEFAULT_OUT_DEGREE;
     int64_t candidate_pool_size = DEFAULT_CANDIDATE_SISE;
+    int64_t build_thread_num = 0;  // 0: use all available cores
 
     NSGCfg(const int64_t& dim, const int64_t& k, const int64_t& gpu_id, const int64_t& nlist, const int64_t& nprobe,
            const int64_t& knng, const int64_t& search_length, const int64_t& out_degree, const int64_t& candidate_size,
@@ -230,7 +250,8 @@ struct BinIDMAPCfg : public Cfg {
     bool
     CheckValid() override {
         if (metric_type == METRICTYPE::HAMMING || metric_type == METRICTYPE::TANIMOTO ||
-            metric_type == METRICTYPE::JACCARD) {
+            metric_type == METRICTYPE::JACCARD || metric_type == METRICTYPE::SUBSTRUCTURE ||
+            metric_type == METRICTYPE::SUPERSTRUCTURE) {
             return true;
         }
         std::stringstream ss;
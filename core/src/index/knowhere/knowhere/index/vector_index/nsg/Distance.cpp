@@ -18,10 +18,125 @@
 namespace knowhere {
 namespace algo {
 
+#if defined(__x86_64__) && defined(__GNUC__)
+
+/* AVX-512 kernels, selected at runtime via CPUID so binaries built with the
+ * default -mavx flags still light up the full vector width on capable hosts.
+ * Tails are handled with masked loads instead of reading past the end. */
+
+template <unsigned DIM>
+__attribute__((target("avx512f"))) static float
+L2SqrAVX512Dim(const float* a, const float* b) {
+    __m512 sum = _mm512_setzero_ps();
+    for (unsigned i = 0; i < DIM; i += 16) {  // DIM is a multiple of 16, loop fully unrolls
+        __m512 l = _mm512_loadu_ps(a + i);
+        __m512 r = _mm512_loadu_ps(b + i);
+        __m512 d = _mm512_sub_ps(l, r);
+        sum = _mm512_fmadd_ps(d, d, sum);
+    }
+    return _mm512_reduce_add_ps(sum);
+}
+
+__attribute__((target("avx512f"))) static float
+L2SqrAVX512(const float* a, const float* b, unsigned size) {
+    // unrolled kernels for common embedding dimensions
+    switch (size) {
+        case 128:
+            return L2SqrAVX512Dim<128>(a, b);
+        case 256:
+            return L2SqrAVX512Dim<256>(a, b);
+        case 512:
+            return L2SqrAVX512Dim<512>(a, b);
+        case 768:
+            return L2SqrAVX512Dim<768>(a, b);
+        case 1536:
+            return L2SqrAVX512Dim<1536>(a, b);
+        default:
+            break;
+    }
+
+    __m512 sum = _mm512_setzero_ps();
+    unsigned i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m512 l = _mm512_loadu_ps(a + i);
+        __m512 r = _mm512_loadu_ps(b + i);
+        __m512 d = _mm512_sub_ps(l, r);
+        sum = _mm512_fmadd_ps(d, d, sum);
+    }
+    if (i < size) {
+        __mmask16 mask = (__mmask16)((1U << (size - i)) - 1);
+        __m512 l = _mm512_maskz_loadu_ps(mask, a + i);
+        __m512 r = _mm512_maskz_loadu_ps(mask, b + i);
+        __m512 d = _mm512_sub_ps(l, r);
+        sum = _mm512_fmadd_ps(d, d, sum);
+    }
+    return _mm512_reduce_add_ps(sum);
+}
+
+template <unsigned DIM>
+__attribute__((target("avx512f"))) static float
+IPAVX512Dim(const float* a, const float* b) {
+    __m512 sum = _mm512_setzero_ps();
+    for (unsigned i = 0; i < DIM; i += 16) {  // DIM is a multiple of 16, loop fully unrolls
+        __m512 l = _mm512_loadu_ps(a + i);
+        __m512 r = _mm512_loadu_ps(b + i);
+        sum = _mm512_fmadd_ps(l, r, sum);
+    }
+    return _mm512_reduce_add_ps(sum);
+}
+
+__attribute__((target("avx512f"))) static float
+IPAVX512(const float* a, const float* b, unsigned size) {
+    // unrolled kernels for common embedding dimensions
+    switch (size) {
+        case 128:
+            return IPAVX512Dim<128>(a, b);
+        case 256:
+            return IPAVX512Dim<256>(a, b);
+        case 512:
+            return IPAVX512Dim<512>(a, b);
+        case 768:
+            return IPAVX512Dim<768>(a, b);
+        case 1536:
+            return IPAVX512Dim<1536>(a, b);
+        default:
+            break;
+    }
+
+    __m512 sum = _mm512_setzero_ps();
+    unsigned i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m512 l = _mm512_loadu_ps(a + i);
+        __m512 r = _mm512_loadu_ps(b + i);
+        sum = _mm512_fmadd_ps(l, r, sum);
+    }
+    if (i < size) {
+        __mmask16 mask = (__mmask16)((1U << (size - i)) - 1);
+        __m512 l = _mm512_maskz_loadu_ps(mask, a + i);
+        __m512 r = _mm512_maskz_loadu_ps(mask, b + i);
+        sum = _mm512_fmadd_ps(l, r, sum);
+    }
+    return _mm512_reduce_add_ps(sum);
+}
+
+static bool
+UseAVX512() {
+    static const bool use = __builtin_cpu_supports("avx512f");
+    return use;
+}
+
+#endif
+
 float
 DistanceL2::Compare(const float* a, const float* b, unsigned size) const {
     float result = 0;
 
+#if defined(__x86_64__) && defined(__GNUC__)
+    if (UseAVX512()) {
+        return L2SqrAVX512(a, b, size);
+    }
+#endif
+
 #ifdef __GNUC__
 #ifdef __AVX__
 
@@ -130,6 +245,12 @@ float
 DistanceIP::Compare(const float* a, const float* b, unsigned size) const {
     float result = 0;
 
+#if defined(__x86_64__) && defined(__GNUC__)
+    if (UseAVX512()) {
+        return IPAVX512(a, b, size);
+    }
+#endif
+
 #ifdef __GNUC__
 #ifdef __AVX__
 #define AVX_DOT(addr1, addr2, dest, tmp1, tmp2) \
@@ -9,11 +9,15 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <omp.h>
+
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <stack>
+#include <thread>
 #include <utility>
 
 #include "knowhere/common/Exception.h"
@@ -58,6 +62,7 @@ NsgIndex::Build_with_ids(size_t nb, const float* data, const int64_t* ids, const
     search_length = parameters.search_length;
     out_degree = parameters.out_degree;
     candidate_pool_size = parameters.candidate_pool_size;
+    build_thread_num = parameters.build_thread_num;
 
     TimeRecorder rc("NSG", 1);
 
@@ -427,12 +432,132 @@ NsgIndex::GetNeighbors(const float* query, std::vector<Neighbor>& resset, Graph&
     }
 }
 
+// Parallel variant of the search walk above: several workers pull unexplored
+// candidates from a shared pool and expand them concurrently. The visited
+// table is an array of bit words claimed with atomic fetch_or, so workers
+// never block on it; only pool updates take the pool lock. A worker may
+// expand a candidate the serial walk would have pruned first, which costs a
+// few extra distance computations but never loses recall.
+void
+NsgIndex::GetNeighborsParallel(const float* query, std::vector<Neighbor>& resset, Graph& graph, SearchParams* params) {
+    size_t buffer_size = params ? params->search_length : search_length;
+
+    if (buffer_size > ntotal) {
+        // TODO: throw exception here.
+    }
+
+    std::vector<node_t> init_ids(buffer_size);
+    resset.resize(buffer_size);
+
+    std::vector<std::atomic<uint64_t>> visited((ntotal + 63) / 64);
+    for (auto& word : visited) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    auto try_visit = [&visited](node_t id) -> bool {
+        uint64_t mask = uint64_t(1) << (id & 63);
+        return (visited[id >> 6].fetch_or(mask, std::memory_order_relaxed) & mask) == 0;
+    };
+
+    {
+        /*
+         * copy navigation-point neighbor,  pick random node if less than buffer size
+         */
+        size_t count = 0;
+        for (size_t i = 0; i < init_ids.size() && i < graph[navigation_point].size(); ++i) {
+            init_ids[i] = graph[navigation_point][i];
+            try_visit(init_ids[i]);
+            ++count;
+        }
+        while (count < buffer_size) {
+            node_t id = rand_r(&seed) % ntotal;
+            if (!try_visit(id))
+                continue;  // duplicate id
+            init_ids[count] = id;
+            ++count;
+        }
+    }
+
+    // init resset and sort by distance
+    for (size_t i = 0; i < init_ids.size(); ++i) {
+        node_t id = init_ids[i];
+
+        if (id >= static_cast<node_t>(ntotal)) {
+            KNOWHERE_THROW_MSG("Build Index Error, id > ntotal");
+        }
+
+        float dist = distance_->Compare(ori_data_ + id * dimension, query, dimension);
+        resset[i] = Neighbor(id, dist, false);
+    }
+    std::sort(resset.begin(), resset.end());  // sort by distance
+
+    std::mutex pool_mutex;
+    std::atomic<int> in_flight(0);
+
+    // more workers than frontier slots just fight over the pool lock
+    int thread_num = std::min(omp_get_max_threads(), static_cast<int>(buffer_size / 8) + 1);
+
+#pragma omp parallel num_threads(thread_num)
+    {
+        std::vector<Neighbor> local;
+        while (true) {
+            node_t expand_id = -1;
+            float bound = 0.0f;
+            {
+                std::lock_guard<std::mutex> lock(pool_mutex);
+                for (size_t i = 0; i < buffer_size; ++i) {
+                    if (!resset[i].has_explored) {
+                        resset[i].has_explored = true;
+                        expand_id = resset[i].id;
+                        break;
+                    }
+                }
+                if (expand_id >= 0) {
+                    bound = resset[buffer_size - 1].distance;
+                    in_flight.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            if (expand_id < 0) {
+                // the pool is only final once no worker can still insert
+                if (in_flight.load(std::memory_order_acquire) == 0)
+                    break;
+                std::this_thread::yield();
+                continue;
+            }
+
+            local.clear();
+            auto& wait_for_search_node_vec = graph[expand_id];
+            for (size_t i = 0; i < wait_for_search_node_vec.size(); ++i) {
+                node_t id = wait_for_search_node_vec[i];
+                if (!try_visit(id))
+                    continue;
+
+                float dist = distance_->Compare(query, ori_data_ + dimension * id, dimension);
+                if (dist >= bound)
+                    continue;
+                local.push_back(Neighbor(id, dist, false));
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(pool_mutex);
+                for (auto& nn : local) {
+                    if (nn.distance >= resset[buffer_size - 1].distance)
+                        continue;
+                    InsertIntoPool(resset.data(), buffer_size, nn);  // replace with a closer node
+                }
+                in_flight.fetch_sub(1, std::memory_order_release);
+            }
+        }
+    }
+}
+
 void
 NsgIndex::Link() {
     float* cut_graph_dist = new float[ntotal * out_degree];
     nsg.resize(ntotal);
 
-#pragma omp parallel
+    int thread_num = build_thread_num > 0 ? static_cast<int>(build_thread_num) : omp_get_max_threads();
+
+#pragma omp parallel num_threads(thread_num)
     {
         std::vector<Neighbor> fullset;
         std::vector<Neighbor> temp;
@@ -467,7 +592,9 @@ NsgIndex::Link() {
     knng.clear();
 
     std::vector<std::mutex> mutex_vec(ntotal);
-#pragma omp for schedule(dynamic, 100)
+    // the "omp for" here used to be orphaned outside any parallel region, so
+    // the whole edge-insertion phase ran on a single thread
+#pragma omp parallel for schedule(dynamic, 100) num_threads(thread_num)
     for (unsigned n = 0; n < ntotal; ++n) {
         InterInsert(n, mutex_vec, cut_graph_dist);
     }
@@ -712,7 +839,17 @@ NsgIndex::Search(const float* query, const unsigned& nq, const unsigned& dim, co
     TimeRecorder rc("NsgIndex::search", 1);
     // TODO(linxj): when to use openmp
     if (nq <= 4) {
-        GetNeighbors(query, resset[0], nsg, &params);
+        // too few queries to fill the cores one query per thread; spend the
+        // idle cores inside each walk instead when the walk is long enough
+        bool parallel_walk = (k >= 45 && omp_get_max_threads() > 1);
+        for (unsigned int i = 0; i < nq; ++i) {
+            const float* single_query = query + i * dim;
+            if (parallel_walk) {
+                GetNeighborsParallel(single_query, resset[i], nsg, &params);
+            } else {
+                GetNeighbors(single_query, resset[i], nsg, &params);
+            }
+        }
     } else {
 #pragma omp parallel for
         for (unsigned int i = 0; i < nq; ++i) {
@@ -30,6 +30,7 @@ struct BuildParams {
     size_t search_length;
     size_t out_degree;
     size_t candidate_pool_size;
+    size_t build_thread_num = 0;  // 0: use all available cores
 };
 
 struct SearchParams {
@@ -60,6 +61,7 @@ class NsgIndex {
     size_t search_length;
     size_t candidate_pool_size;  // search deepth in fullset
     size_t out_degree;
+    size_t build_thread_num = 0;  // 0: use all available cores
 
  public:
     explicit NsgIndex(const size_t& dimension, const size_t& n, METRICTYPE metric = METRICTYPE::L2);
@@ -108,6 +110,12 @@ class NsgIndex {
     void
     GetNeighbors(const float* query, std::vector<Neighbor>& resset, Graph& graph, SearchParams* param = nullptr);
 
+    // multi-worker variant of the search walk, used when nq is too small to
+    // keep the cores busy with one query per thread
+    void
+    GetNeighborsParallel(const float* query, std::vector<Neighbor>& resset, Graph& graph,
+                         SearchParams* param = nullptr);
+
     void
     Link();
 
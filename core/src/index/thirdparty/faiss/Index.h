@@ -50,6 +50,8 @@ enum MetricType {
     METRIC_Jaccard,
     METRIC_Tanimoto,
     METRIC_Hamming,
+    METRIC_Substructure,   ///< distance 0 iff the query is contained in the code
+    METRIC_Superstructure, ///< distance 0 iff the code is contained in the query
 
     /// some additional metrics defined in scipy.spatial.distance
     METRIC_Canberra = 20,
@@ -15,6 +15,7 @@
 #include <cstring>
 #include <faiss/utils/hamming.h>
 #include <faiss/utils/jaccard.h>
+#include <faiss/utils/structure.h>
 #include <faiss/utils/utils.h>
 #include <faiss/utils/Heap.h>
 #include <faiss/impl/FaissAssert.h>
@@ -70,6 +71,32 @@ void IndexBinaryFlat::search(idx_t n, const uint8_t *x, idx_t k,
       }
       memcpy(distances, D, sizeof(float) * n * k);
       delete [] D;
+  } else if (metric_type == METRIC_Substructure ||
+             metric_type == METRIC_Superstructure) {
+      // containment screening: distances are 0/1 floats, matches first
+      float *D = new float[k * n];
+      for (idx_t s = 0; s < n; s += block_size) {
+          idx_t nn = block_size;
+          if (s + block_size > n) {
+              nn = n - s;
+          }
+
+          FAISS_THROW_IF_NOT_MSG(use_heap, "structure_knn_mc not implemented");
+
+          float_maxheap_array_t res = {
+                  size_t(nn), size_t(k), labels + s * k, D + s * k
+          };
+
+          if (metric_type == METRIC_Substructure) {
+              substructure_knn_hc(&res, x + s * code_size, xb.data(), ntotal,
+                        code_size, /* ordered = */ true);
+          } else {
+              superstructure_knn_hc(&res, x + s * code_size, xb.data(), ntotal,
+                        code_size, /* ordered = */ true);
+          }
+      }
+      memcpy(distances, D, sizeof(float) * n * k);
+      delete [] D;
   } else {
       for (idx_t s = 0; s < n; s += block_size) {
           idx_t nn = block_size;
@@ -345,6 +345,9 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
     {
         InvertedListScanner *scanner = get_InvertedListScanner(store_pairs);
         ScopeDeleter1<InvertedListScanner> del(scanner);
+        if (params && !store_pairs) {
+            scanner->sel = params->sel;
+        }
 
         /*****************************************************
          * Depending on parallel_mode, there are two possible ways
@@ -65,9 +65,14 @@ struct Level1Quantizer {
 
 
 
+struct IDSelector;
+
 struct IVFSearchParameters {
     size_t nprobe;            ///< number of probes at query time
     size_t max_codes;         ///< max nb of codes to visit to do a query
+    /// if non-NULL, only vectors whose id passes the selector are
+    /// considered during the scan (deleted-id filtering); not owned
+    const IDSelector *sel = nullptr;
     virtual ~IVFSearchParameters () {}
 };
 
@@ -300,6 +305,12 @@ struct InvertedListScanner {
 
     using idx_t = Index::idx_t;
 
+    /// optional id filter applied while scanning; ids that are not
+    /// members never enter the result heap, so top-k semantics are
+    /// preserved without over-fetching. Ignored when store_pairs is set
+    /// (ids are not available then). Not owned.
+    const IDSelector *sel = nullptr;
+
     /// from now on we handle this query.
     virtual void set_query (const float *query_vector) = 0;
 
@@ -791,6 +791,7 @@ template<class C>
 struct KnnSearchResults {
     idx_t key;
     const idx_t *ids;
+    const IDSelector *sel;
 
     // heap params
     size_t k;
@@ -800,6 +801,9 @@ struct KnnSearchResults {
     size_t nup;
 
     inline void add (idx_t j, float dis) {
+        if (sel && ids && !sel->is_member (ids[j])) {
+            return;
+        }
         if (C::cmp (heap_sim[0], dis)) {
             heap_pop<C> (k, heap_sim, heap_ids);
             idx_t id = ids ? ids[j] : (key << 32 | j);
@@ -814,12 +818,16 @@ template<class C>
 struct RangeSearchResults {
     idx_t key;
     const idx_t *ids;
+    const IDSelector *sel;
 
     // wrapped result structure
     float radius;
     RangeQueryResult & rres;
 
     inline void add (idx_t j, float dis) {
+        if (sel && ids && !sel->is_member (ids[j])) {
+            return;
+        }
         if (C::cmp (radius, dis)) {
             idx_t id = ids ? ids[j] : (key << 32 | j);
             rres.add (dis, id);
@@ -1065,6 +1073,7 @@ struct IVFPQScanner:
         KnnSearchResults<C> res = {
             /* key */      this->key,
             /* ids */      this->store_pairs ? nullptr : ids,
+            /* sel */      this->sel,
             /* k */        k,
             /* heap_sim */ heap_sim,
             /* heap_ids */ heap_ids,
@@ -1095,6 +1104,7 @@ struct IVFPQScanner:
         RangeSearchResults<C> res = {
             /* key */      this->key,
             /* ids */      this->store_pairs ? nullptr : ids,
+            /* sel */      this->sel,
             /* radius */   radius,
             /* rres */     rres
         };
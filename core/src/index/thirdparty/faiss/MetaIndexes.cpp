@@ -12,6 +12,10 @@
 #include <cstdio>
 #include <stdint.h>
 
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/utils/Heap.h>
 #include <faiss/impl/AuxIndexStructures.h>
@@ -24,6 +28,44 @@ namespace {
 
 typedef Index::idx_t idx_t;
 
+void translate_labels_ref (idx_t n, idx_t *li, const int64_t *map)
+{
+    for (idx_t i = 0; i < n; i++) {
+        li[i] = li[i] < 0 ? li[i] : map[li[i]];
+    }
+}
+
+#ifdef __x86_64__
+// bulk label -> user id translation; id_map is a flat contiguous array so
+// the whole lookup becomes a masked gather, negative labels pass through
+__attribute__((target("avx2")))
+void translate_labels_avx2 (idx_t n, idx_t *li, const int64_t *map)
+{
+    const __m256i minus_one = _mm256_set1_epi64x (-1);
+    idx_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256 ((const __m256i *)(li + i));
+        __m256i valid = _mm256_cmpgt_epi64 (v, minus_one);
+        __m256i t = _mm256_mask_i64gather_epi64
+            (v, (const long long *)map, v, valid, 8);
+        _mm256_storeu_si256 ((__m256i *)(li + i), t);
+    }
+    translate_labels_ref (n - i, li + i, map);
+}
+#endif
+
+void translate_labels (idx_t n, idx_t *li, const int64_t *map)
+{
+#ifdef __x86_64__
+    static const bool has_avx2 = __builtin_cpu_supports ("avx2");
+    if (has_avx2) {
+        translate_labels_avx2 (n, li, map);
+        return;
+    }
+#endif
+    translate_labels_ref (n, li, map);
+}
+
 } // namespace
 
 /*****************************************************
@@ -86,10 +128,10 @@ void IndexIDMapTemplate<IndexT>::search
      typename IndexT::distance_t *distances, typename IndexT::idx_t *labels) const
 {
     index->search (n, x, k, distances, labels);
-    idx_t *li = labels;
+    const int64_t *map = id_map.data ();
 #pragma omp parallel for
-    for (idx_t i = 0; i < n * k; i++) {
-        li[i] = li[i] < 0 ? li[i] : id_map[li[i]];
+    for (idx_t i = 0; i < n; i++) {
+        translate_labels (k, labels + i * k, map);
     }
 }
 
@@ -100,11 +142,7 @@ void IndexIDMapTemplate<IndexT>::range_search
      typename IndexT::distance_t radius, RangeSearchResult *result) const
 {
   index->range_search(n, x, radius, result);
-#pragma omp parallel for
-  for (idx_t i = 0; i < result->lims[result->nq]; i++) {
-      result->labels[i] = result->labels[i] < 0 ?
-        result->labels[i] : id_map[result->labels[i]];
-  }
+  translate_labels (result->lims[result->nq], result->labels, id_map.data ());
 }
 
 namespace {
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+
+#include <faiss/gpu/MergeTopK.h>
+#include <faiss/impl/FaissAssert.h>
+#include <faiss/gpu/utils/BlockSelectKernel.cuh>
+#include <faiss/gpu/utils/DeviceDefs.cuh>
+#include <faiss/gpu/utils/DeviceUtils.h>
+#include <faiss/gpu/utils/Tensor.cuh>
+
+#include <algorithm>
+
+namespace faiss { namespace gpu {
+
+namespace {
+
+// Gathers the segment-major candidate distances [numSegments][numQueries][k]
+// into one contiguous row of numSegments * k candidates per query, the layout
+// block-select expects
+__global__ void gatherCandidateRows(const float* segDistances,
+                                    int numSegments,
+                                    int numQueries,
+                                    int k,
+                                    float* rowDistances) {
+  int query = blockIdx.x;
+  int rowLen = numSegments * k;
+
+  for (int i = threadIdx.x; i < rowLen; i += blockDim.x) {
+    int seg = i / k;
+    int j = i - seg * k;
+    rowDistances[(size_t) query * rowLen + i] =
+      segDistances[((size_t) seg * numQueries + query) * k + j];
+  }
+}
+
+// Translates the row positions selected by block-select back to the original
+// 64-bit labels; -1 (unfilled) passes through
+__global__ void gatherSelectedLabels(const int* selectedPos,
+                                     const int64_t* segLabels,
+                                     int numQueries,
+                                     int k,
+                                     int64_t* outLabels) {
+  int query = blockIdx.x;
+
+  for (int i = threadIdx.x; i < k; i += blockDim.x) {
+    int pos = selectedPos[(size_t) query * k + i];
+    int64_t label = -1;
+
+    if (pos >= 0) {
+      int seg = pos / k;
+      int j = pos - seg * k;
+      label = segLabels[((size_t) seg * numQueries + query) * k + j];
+    }
+
+    outLabels[(size_t) query * k + i] = label;
+  }
+}
+
+} // anonymous namespace
+
+void runMergeTopK(const float* segDistances,
+                  const int64_t* segLabels,
+                  int numSegments,
+                  int numQueries,
+                  int k,
+                  bool dir,
+                  float* outDistances,
+                  int64_t* outLabels,
+                  cudaStream_t stream) {
+  FAISS_THROW_IF_NOT(numSegments > 0);
+  FAISS_THROW_IF_NOT(numQueries > 0);
+  FAISS_THROW_IF_NOT_FMT(k > 0 && k <= GPU_MAX_SELECTION_K,
+                         "merge top-k k (%d) must be in [1, %d]",
+                         k, GPU_MAX_SELECTION_K);
+
+  int rowLen = numSegments * k;
+
+  float* rowDistances = nullptr;
+  int* selectedPos = nullptr;
+  CUDA_VERIFY(cudaMalloc(&rowDistances,
+                         (size_t) numQueries * rowLen * sizeof(float)));
+  CUDA_VERIFY(cudaMalloc(&selectedPos,
+                         (size_t) numQueries * k * sizeof(int)));
+
+  int numThreads = std::min(rowLen, getMaxThreadsCurrentDevice());
+  gatherCandidateRows<<<numQueries, numThreads, 0, stream>>>(
+    segDistances, numSegments, numQueries, k, rowDistances);
+
+  Tensor<float, 2, true> candidates(rowDistances, {numQueries, rowLen});
+  Tensor<float, 2, true> outDistanceView(outDistances, {numQueries, k});
+  Tensor<int, 2, true> selectedPosView(selectedPos, {numQueries, k});
+
+  runBlockSelect(candidates, outDistanceView, selectedPosView,
+                 dir, k, stream);
+
+  gatherSelectedLabels<<<numQueries, std::min(k, 128), 0, stream>>>(
+    selectedPos, segLabels, numQueries, k, outLabels);
+
+  CUDA_TEST_ERROR();
+
+  // cudaFree synchronizes on outstanding work touching these allocations
+  CUDA_VERIFY(cudaFree(rowDistances));
+  CUDA_VERIFY(cudaFree(selectedPos));
+}
+
+} } // namespace
@@ -0,0 +1,39 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+
+#pragma once
+
+#include <cuda_runtime.h>
+#include <cstdint>
+
+namespace faiss { namespace gpu {
+
+/// Fused k-selection over several device-resident top-k lists.
+///
+/// `segDistances` and `segLabels` hold `numSegments` stacked result blocks of
+/// shape numQueries x k each (the layout produced by running one search per
+/// segment into consecutive slices of a single allocation). For every query
+/// the numSegments * k candidates are reduced to the k best in one
+/// block-select pass; only the caller decides when the final k values cross
+/// PCIe. All pointers must be resident on the current device.
+///
+/// If `dir` is true the largest distances win (inner product), otherwise the
+/// smallest (L2). Unfilled output entries carry label -1 and the worst
+/// representable distance, matching the padding of the per-segment searches.
+/// k must not exceed GPU_MAX_SELECTION_K.
+void runMergeTopK(const float* segDistances,
+                  const int64_t* segLabels,
+                  int numSegments,
+                  int numQueries,
+                  int k,
+                  bool dir,
+                  float* outDistances,
+                  int64_t* outLabels,
+                  cudaStream_t stream);
+
+} } // namespace
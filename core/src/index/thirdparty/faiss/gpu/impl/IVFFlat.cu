@@ -61,7 +61,10 @@ IVFFlat::copyCodeVectorsFromCpu(const float* vecs,
         return;
     }
 
-    auto stream = resources_->getDefaultStreamCurrentDevice();
+    // the source lives in page-locked memory (ReadOnlyArrayInvertedLists), so
+    // issue the bulk transfer on the dedicated copy stream; compute queued on
+    // the default stream keeps running while the upload is in flight
+    auto stream = resources_->getAsyncCopyStreamCurrentDevice();
 
     deviceListLengths_ = list_length;
 
@@ -101,11 +104,8 @@ IVFFlat::copyCodeVectorsFromCpu(const float* vecs,
 
     deviceListDataPointers_ = hostPointers;
 
-    // device_vector add is potentially happening on a different stream
-    // than our default stream
-    if (stream != 0) {
-        streamWait({stream}, {0});
-    }
+    // order the default stream after the upload instead of blocking the host
+    streamWait({resources_->getDefaultStreamCurrentDevice()}, {stream});
     std::chrono::high_resolution_clock::time_point time5 = std::chrono::high_resolution_clock::now();
 
     double span1 = (std::chrono::duration<double, std::micro>(time2 - time1)).count();
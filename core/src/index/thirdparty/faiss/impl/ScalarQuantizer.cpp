@@ -1388,6 +1388,11 @@ struct IVFSQScannerIP: InvertedListScanner {
 
         for (size_t j = 0; j < list_size; j++) {
 
+            if (sel && !store_pairs && !sel->is_member (ids[j])) {
+                codes += code_size;
+                continue;
+            }
+
             float accu = accu0 + dc.query_to_code (codes);
 
             if (accu > simi [0]) {
@@ -1476,6 +1481,11 @@ struct IVFSQScannerL2: InvertedListScanner {
         size_t nup = 0;
         for (size_t j = 0; j < list_size; j++) {
 
+            if (sel && !store_pairs && !sel->is_member (ids[j])) {
+                codes += code_size;
+                continue;
+            }
+
             float dis = dc.query_to_code (codes);
 
             if (dis < simi [0]) {
@@ -0,0 +1,245 @@
+#include <faiss/utils/binary_simd.h>
+
+#include <faiss/utils/hamming.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace faiss {
+
+static int xor_popcnt_ref (const uint8_t *a, const uint8_t *b, size_t n)
+{
+    int accu = 0;
+    for (size_t i = 0; i < n; i++)
+        accu += popcount64 (a[i] ^ b[i]);
+    return accu;
+}
+
+static void and_or_popcnt_ref (const uint8_t *a, const uint8_t *b, size_t n,
+                               int &accu_num, int &accu_den)
+{
+    for (size_t i = 0; i < n; i++) {
+        accu_num += popcount64 (a[i] & b[i]);
+        accu_den += popcount64 (a[i] | b[i]);
+    }
+}
+
+static bool andn_none_ref (const uint8_t *a, const uint8_t *b, size_t n)
+{
+    /* 64-byte blocks so the early exit fires at the same granularity as
+     * the vector versions */
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        uint64_t stray = 0;
+        const uint64_t *a64 = (const uint64_t *)(a + i);
+        const uint64_t *b64 = (const uint64_t *)(b + i);
+        for (int j = 0; j < 8; j++)
+            stray |= a64[j] & ~b64[j];
+        if (stray != 0)
+            return false;
+    }
+    for (; i < n; i++)
+        if (a[i] & ~b[i])
+            return false;
+    return true;
+}
+
+#if defined(__x86_64__)
+
+/* byte-wise popcount of a 256-bit lane via a nibble lookup table,
+ * accumulated into the 4 64-bit sub-sums of the lane */
+__attribute__((target("avx2"))) static inline __m256i
+popcnt_epi64_avx2 (__m256i v)
+{
+    const __m256i lut = _mm256_setr_epi8 (
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8 (0x0f);
+    __m256i lo = _mm256_and_si256 (v, low_mask);
+    __m256i hi = _mm256_and_si256 (_mm256_srli_epi16 (v, 4), low_mask);
+    __m256i cnt = _mm256_add_epi8 (_mm256_shuffle_epi8 (lut, lo),
+                                   _mm256_shuffle_epi8 (lut, hi));
+    return _mm256_sad_epu8 (cnt, _mm256_setzero_si256 ());
+}
+
+__attribute__((target("avx2"))) static inline int
+reduce_add_epi64_avx2 (__m256i v)
+{
+    __m128i s = _mm_add_epi64 (_mm256_castsi256_si128 (v),
+                               _mm256_extracti128_si256 (v, 1));
+    return (int)(_mm_cvtsi128_si64 (s) + _mm_extract_epi64 (s, 1));
+}
+
+__attribute__((target("avx2"))) static int
+xor_popcnt_avx2 (const uint8_t *a, const uint8_t *b, size_t n)
+{
+    __m256i acc = _mm256_setzero_si256 ();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i va = _mm256_loadu_si256 ((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256 ((const __m256i *)(b + i));
+        acc = _mm256_add_epi64 (acc,
+                popcnt_epi64_avx2 (_mm256_xor_si256 (va, vb)));
+    }
+    int accu = reduce_add_epi64_avx2 (acc);
+    for (; i < n; i++)
+        accu += popcount64 (a[i] ^ b[i]);
+    return accu;
+}
+
+__attribute__((target("avx2"))) static void
+and_or_popcnt_avx2 (const uint8_t *a, const uint8_t *b, size_t n,
+                    int &accu_num, int &accu_den)
+{
+    __m256i acc_num = _mm256_setzero_si256 ();
+    __m256i acc_den = _mm256_setzero_si256 ();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i va = _mm256_loadu_si256 ((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256 ((const __m256i *)(b + i));
+        acc_num = _mm256_add_epi64 (acc_num,
+                popcnt_epi64_avx2 (_mm256_and_si256 (va, vb)));
+        acc_den = _mm256_add_epi64 (acc_den,
+                popcnt_epi64_avx2 (_mm256_or_si256 (va, vb)));
+    }
+    accu_num += reduce_add_epi64_avx2 (acc_num);
+    accu_den += reduce_add_epi64_avx2 (acc_den);
+    for (; i < n; i++) {
+        accu_num += popcount64 (a[i] & b[i]);
+        accu_den += popcount64 (a[i] | b[i]);
+    }
+}
+
+__attribute__((target("avx2"))) static bool
+andn_none_avx2 (const uint8_t *a, const uint8_t *b, size_t n)
+{
+    size_t i = 0;
+    /* vptest with carry: testc(b, a) == 1 iff (~b & a) == 0 */
+    for (; i + 64 <= n; i += 64) {
+        __m256i a0 = _mm256_loadu_si256 ((const __m256i *)(a + i));
+        __m256i b0 = _mm256_loadu_si256 ((const __m256i *)(b + i));
+        __m256i a1 = _mm256_loadu_si256 ((const __m256i *)(a + i + 32));
+        __m256i b1 = _mm256_loadu_si256 ((const __m256i *)(b + i + 32));
+        if (!(_mm256_testc_si256 (b0, a0) & _mm256_testc_si256 (b1, a1)))
+            return false;
+    }
+    for (; i < n; i++)
+        if (a[i] & ~b[i])
+            return false;
+    return true;
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) static int
+xor_popcnt_avx512 (const uint8_t *a, const uint8_t *b, size_t n)
+{
+    __m512i acc = _mm512_setzero_si512 ();
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512i va = _mm512_loadu_si512 (a + i);
+        __m512i vb = _mm512_loadu_si512 (b + i);
+        acc = _mm512_add_epi64 (acc,
+                _mm512_popcnt_epi64 (_mm512_xor_si512 (va, vb)));
+    }
+    int accu = (int)_mm512_reduce_add_epi64 (acc);
+    for (; i < n; i++)
+        accu += popcount64 (a[i] ^ b[i]);
+    return accu;
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) static void
+and_or_popcnt_avx512 (const uint8_t *a, const uint8_t *b, size_t n,
+                      int &accu_num, int &accu_den)
+{
+    __m512i acc_num = _mm512_setzero_si512 ();
+    __m512i acc_den = _mm512_setzero_si512 ();
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512i va = _mm512_loadu_si512 (a + i);
+        __m512i vb = _mm512_loadu_si512 (b + i);
+        acc_num = _mm512_add_epi64 (acc_num,
+                _mm512_popcnt_epi64 (_mm512_and_si512 (va, vb)));
+        acc_den = _mm512_add_epi64 (acc_den,
+                _mm512_popcnt_epi64 (_mm512_or_si512 (va, vb)));
+    }
+    accu_num += (int)_mm512_reduce_add_epi64 (acc_num);
+    accu_den += (int)_mm512_reduce_add_epi64 (acc_den);
+    for (; i < n; i++) {
+        accu_num += popcount64 (a[i] & b[i]);
+        accu_den += popcount64 (a[i] | b[i]);
+    }
+}
+
+__attribute__((target("avx512f"))) static bool
+andn_none_avx512 (const uint8_t *a, const uint8_t *b, size_t n)
+{
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512i va = _mm512_loadu_si512 (a + i);
+        __m512i vb = _mm512_loadu_si512 (b + i);
+        /* andnot(x, y) = ~x & y */
+        __m512i stray = _mm512_andnot_si512 (vb, va);
+        if (_mm512_test_epi64_mask (stray, stray) != 0)
+            return false;
+    }
+    for (; i < n; i++)
+        if (a[i] & ~b[i])
+            return false;
+    return true;
+}
+
+#endif // __x86_64__
+
+static int (*select_xor_popcnt ()) (const uint8_t *, const uint8_t *, size_t)
+{
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports ("avx512f") &&
+        __builtin_cpu_supports ("avx512vpopcntdq")) {
+        return &xor_popcnt_avx512;
+    }
+    if (__builtin_cpu_supports ("avx2")) {
+        return &xor_popcnt_avx2;
+    }
+#endif
+    return &xor_popcnt_ref;
+}
+
+static void (*select_and_or_popcnt ()) (const uint8_t *, const uint8_t *,
+                                        size_t, int &, int &)
+{
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports ("avx512f") &&
+        __builtin_cpu_supports ("avx512vpopcntdq")) {
+        return &and_or_popcnt_avx512;
+    }
+    if (__builtin_cpu_supports ("avx2")) {
+        return &and_or_popcnt_avx2;
+    }
+#endif
+    return &and_or_popcnt_ref;
+}
+
+static bool (*select_andn_none ()) (const uint8_t *, const uint8_t *, size_t)
+{
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports ("avx512f")) {
+        return &andn_none_avx512;
+    }
+    if (__builtin_cpu_supports ("avx2")) {
+        return &andn_none_avx2;
+    }
+#endif
+    return &andn_none_ref;
+}
+
+int (*xor_popcnt) (const uint8_t *, const uint8_t *, size_t) =
+        select_xor_popcnt ();
+
+void (*and_or_popcnt) (const uint8_t *, const uint8_t *, size_t,
+                       int &, int &) =
+        select_and_or_popcnt ();
+
+bool (*andn_none) (const uint8_t *, const uint8_t *, size_t) =
+        select_andn_none ();
+
+} // namespace faiss
@@ -0,0 +1,30 @@
+#ifndef FAISS_BINARY_SIMD_H
+#define FAISS_BINARY_SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+/* Popcount kernels behind the binary distance computers. The pointers are
+ * bound once at load time to the widest implementation the CPU supports
+ * (scalar, AVX2 or AVX-512 VPOPCNTDQ). They process a whole code per call,
+ * so they are only worth the indirection for code sizes beyond the
+ * unrolled specializations (>= 64 bytes). */
+
+/* popcount(a ^ b) over n bytes (hamming) */
+extern int (*xor_popcnt) (const uint8_t *a, const uint8_t *b, size_t n);
+
+/* popcount(a & b) and popcount(a | b) over n bytes (jaccard/tanimoto) */
+extern void (*and_or_popcnt) (const uint8_t *a, const uint8_t *b, size_t n,
+                              int &accu_num, int &accu_den);
+
+/* true iff (a & ~b) == 0 over n bytes, i.e. every bit set in a is also set
+ * in b (substructure/superstructure). Works in 512-bit blocks and returns
+ * on the first block with a stray bit, so the common non-matching
+ * candidate costs a few blocks instead of a full scan. */
+extern bool (*andn_none) (const uint8_t *a, const uint8_t *b, size_t n);
+
+} // namespace faiss
+
+#endif // FAISS_BINARY_SIMD_H
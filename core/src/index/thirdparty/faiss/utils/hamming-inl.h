@@ -5,7 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
-
+#include <faiss/utils/binary_simd.h>
 
 namespace faiss {
 
@@ -233,6 +233,9 @@ struct HammingComputerDefault {
     }
 
     int hamming (const uint8_t *b8) const {
+        if (n >= 64) {
+            return xor_popcnt (a, b8, n);
+        }
         int accu = 0;
         for (int i = 0; i < n; i++)
             accu += popcount64 (a[i] ^ b8[i]);
@@ -258,6 +261,9 @@ struct HammingComputerM8 {
     }
 
     int hamming (const uint8_t *b8) const {
+        if (n >= 8) {
+            return xor_popcnt ((const uint8_t *)a, b8, n * 8);
+        }
         const uint64_t *b = (uint64_t *)b8;
         int accu = 0;
         for (int i = 0; i < n; i++)
@@ -2,6 +2,8 @@
 // Created by czr on 2019/12/19.
 //
 
+#include <faiss/utils/binary_simd.h>
+
 namespace faiss {
 
     struct JaccardComputer16 {
@@ -161,9 +163,13 @@ namespace faiss {
         float jaccard (const uint8_t *b8) const {
             int accu_num = 0;
             int accu_den = 0;
-            for (int i = 0; i < n; i++) {
-                accu_num += popcount64(a[i] & b8[i]);
-                accu_den += popcount64(a[i] | b8[i]);
+            if (n >= 64) {
+                and_or_popcnt (a, b8, n, accu_num, accu_den);
+            } else {
+                for (int i = 0; i < n; i++) {
+                    accu_num += popcount64(a[i] & b8[i]);
+                    accu_den += popcount64(a[i] | b8[i]);
+                }
             }
             if (accu_num == 0)
                 return 1.0;
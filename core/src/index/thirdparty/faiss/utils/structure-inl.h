@@ -0,0 +1,51 @@
+#include <faiss/utils/binary_simd.h>
+
+namespace faiss {
+
+    /* No unrolled specializations per code size here: andn_none already
+     * runs block-wise and leaves on the first mismatching 512-bit chunk,
+     * so almost every candidate is decided within the first block. */
+
+    struct SubstructureComputerDefault {
+        const uint8_t *a;
+        int n;
+
+        SubstructureComputerDefault () {}
+
+        SubstructureComputerDefault (const uint8_t *a8, int code_size) {
+            set (a8, code_size);
+        }
+
+        void set (const uint8_t *a8, int code_size) {
+            a = a8;
+            n = code_size;
+        }
+
+        inline float compute (const uint8_t *b8) const {
+            return andn_none (a, b8, n) ? 0.0 : 1.0;
+        }
+
+    };
+
+    struct SuperstructureComputerDefault {
+        const uint8_t *a;
+        int n;
+
+        SuperstructureComputerDefault () {}
+
+        SuperstructureComputerDefault (const uint8_t *a8, int code_size) {
+            set (a8, code_size);
+        }
+
+        void set (const uint8_t *a8, int code_size) {
+            a = a8;
+            n = code_size;
+        }
+
+        inline float compute (const uint8_t *b8) const {
+            return andn_none (b8, a, n) ? 0.0 : 1.0;
+        }
+
+    };
+
+}
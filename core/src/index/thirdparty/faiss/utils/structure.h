@@ -0,0 +1,46 @@
+#ifndef FAISS_STRUCTURE_H
+#define FAISS_STRUCTURE_H
+
+#include <stdint.h>
+
+#include <faiss/utils/Heap.h>
+#include <faiss/utils/jaccard.h>
+
+namespace faiss {
+
+    extern size_t structure_batch_size;
+
+/** Set-containment search over binary codes, used to screen chemical
+ * fingerprints. The distance is 0 when the containment holds and 1
+ * otherwise, so the heap surfaces the matches first and the per-code
+ * test can bail out on the first 512-bit block that breaks containment.
+ *
+ * @param a       queries, size ha->nh * ncodes
+ * @param b       database, size nb * ncodes
+ * @param nb      number of database vectors
+ * @param ncodes  size of the binary codes (bytes)
+ * @param ordered if != 0: order the results by decreasing distance */
+
+/* matches iff the query is a substructure of the code: a & ~b == 0 */
+    void substructure_knn_hc (
+            float_maxheap_array_t * ha,
+            const uint8_t * a,
+            const uint8_t * b,
+            size_t nb,
+            size_t ncodes,
+            int ordered);
+
+/* matches iff the code is a substructure of the query: b & ~a == 0 */
+    void superstructure_knn_hc (
+            float_maxheap_array_t * ha,
+            const uint8_t * a,
+            const uint8_t * b,
+            size_t nb,
+            size_t ncodes,
+            int ordered);
+
+} //namespace faiss
+
+#include <faiss/utils/structure-inl.h>
+
+#endif //FAISS_STRUCTURE_H
@@ -14,6 +14,7 @@
 
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/IndexIVFPQ.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
 #include "knowhere/index/vector_index/IndexIVFSQ.h"
 
 #ifdef MILVUS_GPU_VERSION
@@ -38,6 +39,8 @@ IndexFactory(const std::string& type) {
         return std::make_shared<knowhere::IVF>();
     } else if (type == "IVFPQ") {
         return std::make_shared<knowhere::IVFPQ>();
+    } else if (type == "IVFPQFS") {
+        return std::make_shared<knowhere::IVFPQFastScan>();
     } else if (type == "IVFSQ") {
         return std::make_shared<knowhere::IVFSQ>();
 #ifdef MILVUS_GPU_VERSION
@@ -58,6 +61,7 @@ IndexFactory(const std::string& type) {
 enum class ParameterType {
     ivf,
     ivfpq,
+    ivfpqfs,
     ivfsq,
 };
 
@@ -91,6 +95,19 @@ class ParamGenerator {
             tempconf->nbits = 8;
             tempconf->metric_type = knowhere::METRICTYPE::L2;
             return tempconf;
+        } else if (type == ParameterType::ivfpqfs) {
+            auto tempconf = std::make_shared<knowhere::IVFPQCfg>();
+            tempconf->d = DIM;
+            tempconf->gpu_id = DEVICEID;
+            tempconf->nlist = 100;
+            tempconf->nprobe = 4;
+            tempconf->k = K;
+            // 4-bit codes halve the per-sub-quantizer resolution, so the
+            // fastscan variant doubles m to keep the code space comparable
+            tempconf->m = 8;
+            tempconf->nbits = 4;
+            tempconf->metric_type = knowhere::METRICTYPE::L2;
+            return tempconf;
         } else if (type == ParameterType::ivfsq) {
             auto tempconf = std::make_shared<knowhere::IVFSQCfg>();
             tempconf->d = DIM;
@@ -11,6 +11,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
+#include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
 
@@ -67,6 +70,67 @@ TEST_P(BinaryIDMAPTest, binaryidmap_basic) {
     // PrintResult(re_result, nq, k);
 }
 
+TEST(BinaryIDMAPStructureTest, binaryidmap_structure) {
+    // containment metrics report distance 0 for a match and 1 otherwise,
+    // so matches sort to the front of the topk
+    const int64_t dim = 128;
+    const int64_t code_size = dim / 8;
+    const int64_t nb = 4;
+    std::vector<uint8_t> codes(nb * code_size, 0x00);
+    std::vector<uint8_t> query(code_size, 0x00);
+    std::vector<int64_t> ids = {0, 1, 2, 3};
+
+    query[0] = 0x0f;
+    query[10] = 0x80;
+    codes[0 * code_size + 0] = 0xff;  // strict superset of the query
+    codes[0 * code_size + 10] = 0x80;
+    codes[1 * code_size + 0] = 0x0f;  // misses the bit in byte 10
+    codes[2 * code_size + 0] = 0x0f;  // equal to the query
+    codes[2 * code_size + 10] = 0x80;
+    codes[3 * code_size + 5] = 0xf0;  // disjoint
+
+    auto base = generate_binary_dataset(nb, dim, codes.data(), ids.data());
+    auto query_ds = generate_binary_query_dataset(1, dim, query.data());
+
+    auto conf = std::make_shared<knowhere::BinIDMAPCfg>();
+    conf->d = dim;
+    conf->k = nb;
+    conf->metric_type = knowhere::METRICTYPE::SUBSTRUCTURE;
+
+    auto index = std::make_shared<knowhere::BinaryIDMAP>();
+    index->Train(conf);
+    index->Add(base, conf);
+    auto result = index->Search(query_ds, conf);
+    auto result_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    auto result_dist = result->Get<float*>(knowhere::meta::DISTANCE);
+
+    // query is contained in codes 0 and 2 only
+    std::vector<int64_t> matches = {result_ids[0], result_ids[1]};
+    std::sort(matches.begin(), matches.end());
+    EXPECT_EQ(0, matches[0]);
+    EXPECT_EQ(2, matches[1]);
+    EXPECT_FLOAT_EQ(0.0, result_dist[0]);
+    EXPECT_FLOAT_EQ(0.0, result_dist[1]);
+    EXPECT_FLOAT_EQ(1.0, result_dist[2]);
+    EXPECT_FLOAT_EQ(1.0, result_dist[3]);
+
+    // flipped direction: codes 1 and 2 are contained in the query
+    conf->metric_type = knowhere::METRICTYPE::SUPERSTRUCTURE;
+    auto super_index = std::make_shared<knowhere::BinaryIDMAP>();
+    super_index->Train(conf);
+    super_index->Add(base, conf);
+    auto super_result = super_index->Search(query_ds, conf);
+    auto super_ids = super_result->Get<int64_t*>(knowhere::meta::IDS);
+    auto super_dist = super_result->Get<float*>(knowhere::meta::DISTANCE);
+    std::vector<int64_t> super_matches = {super_ids[0], super_ids[1]};
+    std::sort(super_matches.begin(), super_matches.end());
+    EXPECT_EQ(1, super_matches[0]);
+    EXPECT_EQ(2, super_matches[1]);
+    EXPECT_FLOAT_EQ(0.0, super_dist[0]);
+    EXPECT_FLOAT_EQ(0.0, super_dist[1]);
+    EXPECT_FLOAT_EQ(1.0, super_dist[2]);
+}
+
 TEST_P(BinaryIDMAPTest, binaryidmap_serialize) {
     auto serialize = [](const std::string& filename, knowhere::BinaryPtr& bin, uint8_t* ret) {
         FileIOWriter writer(filename);
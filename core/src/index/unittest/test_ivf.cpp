@@ -29,6 +29,8 @@
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/IndexIVFPQ.h"
 #include "knowhere/index/vector_index/IndexIVFSQ.h"
+#include "knowhere/index/vector_index/helpers/BufferManager.h"
+#include "knowhere/index/vector_index/helpers/FaissIO.h"
 
 #ifdef MILVUS_GPU_VERSION
 
@@ -90,6 +92,7 @@ INSTANTIATE_TEST_CASE_P(IVFParameters, IVFTest,
 #endif
 #endif
                             std::make_tuple("IVF", ParameterType::ivf), std::make_tuple("IVFPQ", ParameterType::ivfpq),
+                            std::make_tuple("IVFPQFS", ParameterType::ivfpqfs),
                             std::make_tuple("IVFSQ", ParameterType::ivfsq)));
 
 TEST_P(IVFTest, ivf_basic) {
@@ -117,6 +120,98 @@ TEST_P(IVFTest, ivf_basic) {
 #endif
 }
 
+TEST_P(IVFTest, ivf_adaptive_probe) {
+    if (index_type != "IVF") {
+        return;  // adaptive probing only applies to the CPU IVF search path
+    }
+
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+
+    // a one-list stop window still scans the nearest list first, so the self-hit survives
+    auto ivf_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(conf);
+    ivf_conf->probe_stop_window = 1;
+    auto result = index_->Search(query_dataset, conf);
+    AssertAnns(result, nq, conf->k);
+    ivf_conf->probe_stop_window = 0;
+}
+
+TEST_P(IVFTest, ivf_coarse_assign_cache) {
+    if (index_type != "IVF") {
+        return;  // the assignment cache only applies to the CPU IVF search path
+    }
+
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+
+    // the second search replays the ranking the first one stored, so both
+    // must match the uncached result
+    knowhere::CoarseAssignCache cache;
+    auto ivf_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(conf);
+    ivf_conf->assign_cache = &cache;
+    auto first = index_->Search(query_dataset, conf);
+    AssertAnns(first, nq, conf->k);
+    auto replayed = index_->Search(query_dataset, conf);
+    AssertAnns(replayed, nq, conf->k);
+    ivf_conf->assign_cache = nullptr;
+
+    auto uncached = index_->Search(query_dataset, conf);
+    auto replayed_ids = replayed->Get<int64_t*>(knowhere::meta::IDS);
+    auto uncached_ids = uncached->Get<int64_t*>(knowhere::meta::IDS);
+    for (int i = 0; i < nq * conf->k; i++) {
+        EXPECT_EQ(uncached_ids[i], replayed_ids[i]);
+    }
+}
+
+TEST(BufferManagerTest, slab_reuse) {
+    auto& mgr = knowhere::BufferManager::GetInstance();
+
+    size_t capacity = 0;
+    auto slab = mgr.Allocate(100, capacity);
+    ASSERT_GE(capacity, size_t(100));
+    memset(slab, 0xab, capacity);
+
+    // released slabs park on the free list and come back on the next request
+    // of the same class instead of hitting the system allocator again
+    auto cached_before = mgr.CachedBytes();
+    mgr.Release(slab);
+    ASSERT_EQ(mgr.CachedBytes(), cached_before + capacity);
+    size_t capacity2 = 0;
+    auto slab2 = mgr.Allocate(capacity, capacity2);
+    ASSERT_EQ(slab2, slab);
+    ASSERT_EQ(capacity2, capacity);
+
+    // the shared handoff returns the slab to the pool when the last owner
+    // drops, which is how BinarySet consumers recycle serialization buffers
+    cached_before = mgr.CachedBytes();
+    { auto shared = mgr.MakeShared(slab2); }
+    ASSERT_EQ(mgr.CachedBytes(), cached_before + capacity);
+
+    // a writer that is never detached releases its buffer on destruction
+    {
+        knowhere::MemoryIOWriter writer;
+        int64_t value = 42;
+        writer.write(&value, sizeof(value));
+    }
+
+    // detach survives the writer and keeps the written bytes readable
+    std::shared_ptr<uint8_t> data;
+    size_t written = 0;
+    {
+        knowhere::MemoryIOWriter writer;
+        int64_t value = 42;
+        writer.write(&value, sizeof(value));
+        written = writer.rp;
+        data = writer.detach();
+    }
+    ASSERT_EQ(written, sizeof(int64_t));
+    int64_t readback = 0;
+    memcpy(&readback, data.get(), sizeof(readback));
+    ASSERT_EQ(readback, 42);
+}
+
 TEST_P(IVFTest, ivf_serialize) {
     fiu_init(0);
     auto serialize = [](const std::string& filename, knowhere::BinaryPtr& bin, uint8_t* ret) {
@@ -83,6 +83,39 @@ class MetricsBase {
     CacheAccessTotalIncrement(double value = 1) {
     }
 
+    virtual void
+    CacheHitTotalIncrement(const std::string& policy, const std::string& cache_name, double value = 1) {
+    }
+
+    virtual void
+    CacheMissTotalIncrement(const std::string& policy, const std::string& cache_name, double value = 1) {
+    }
+
+    virtual void
+    CacheEvictionTotalIncrement(const std::string& cache_name, double value = 1) {
+    }
+
+    // direction is "in" (inserted) or "out" (evicted, erased or replaced)
+    virtual void
+    CacheIOBytesTotalIncrement(const std::string& cache_name, const std::string& direction, double value) {
+    }
+
+    virtual void
+    RequestShedTotalIncrement(const std::string& reason, double value = 1) {
+    }
+
+    virtual void
+    ActiveComputeTasksGaugeSet(double value) {
+    }
+
+    virtual void
+    ComputeTokensInUseGaugeSet(double value) {
+    }
+
+    virtual void
+    HugePageCoverageGaugeSet(double value) {
+    }
+
     virtual void
     MemTableMergeDurationSecondsHistogramObserve(double value) {
     }
@@ -119,6 +152,34 @@ class MetricsBase {
     QueryResponseSummaryObserve(double value) {
     }
 
+    // stage is one of queue_wait/load/search/reduce/serialize; value is the
+    // time a sampled query spent in that stage, in seconds
+    virtual void
+    QueryStageLatencySecondsObserve(const std::string& stage, double value) {
+    }
+
+    // per-table request metrics; implementations bound the table label
+    // cardinality (metric_config.label_cardinality_limit), folding the
+    // overflow into a single "_other" series
+    virtual void
+    QueryPerTableTotalIncrement(const std::string& table_id, double value = 1) {
+    }
+
+    virtual void
+    QueryPerTableDurationObserve(const std::string& table_id, double value) {
+    }
+
+    virtual void
+    InsertPerTableTotalIncrement(const std::string& table_id, double value = 1) {
+    }
+
+    // one increment per segment searched, labeled by index type and the
+    // scheduler resource the task ran on; both label sets are naturally
+    // bounded so no cardinality cap applies
+    virtual void
+    SearchComputeTotalIncrement(const std::string& index_type, const std::string& resource, double value = 1) {
+    }
+
     virtual void
     DiskStoreIOSpeedGaugeSet(double value) {
     }
@@ -159,6 +220,19 @@ class MetricsBase {
     GPUPercentGaugeSet() {
     }
 
+    virtual void
+    GPUUtilizationGaugeSet() {
+    }
+
+    // per-scheduler-resource attribution, labelled by resource name
+    virtual void
+    ResourceExecutorCpuSecondsGaugeSet(const std::string& resource_name, double value) {
+    }
+
+    virtual void
+    ResourceLoaderIOBytesGaugeSet(const std::string& resource_name, double value) {
+    }
+
     virtual void
     GPUMemoryUsageGaugeSet() {
     }
@@ -54,7 +54,8 @@ class CollectMetricsBase {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class CollectInsertMetrics : CollectMetricsBase {
  public:
-    CollectInsertMetrics(size_t n, Status& status) : n_(n), status_(status) {
+    CollectInsertMetrics(size_t n, const std::string& table_id, Status& status)
+        : n_(n), table_id_(table_id), status_(status) {
     }
 
     ~CollectInsertMetrics() {
@@ -69,6 +70,7 @@ class CollectInsertMetrics : CollectMetricsBase {
             if (status_.ok()) {
                 server::Metrics::GetInstance().AddVectorsSuccessTotalIncrement(n_);
                 server::Metrics::GetInstance().AddVectorsSuccessGaugeSet(n_);
+                server::Metrics::GetInstance().InsertPerTableTotalIncrement(table_id_, n_);
             } else {
                 server::Metrics::GetInstance().AddVectorsFailTotalIncrement(n_);
                 server::Metrics::GetInstance().AddVectorsFailGaugeSet(n_);
@@ -78,13 +80,14 @@ class CollectInsertMetrics : CollectMetricsBase {
 
  private:
     size_t n_;
+    std::string table_id_;
     Status& status_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class CollectQueryMetrics : CollectMetricsBase {
  public:
-    explicit CollectQueryMetrics(size_t nq) : nq_(nq) {
+    CollectQueryMetrics(size_t nq, const std::string& table_id) : nq_(nq), table_id_(table_id) {
     }
 
     ~CollectQueryMetrics() {
@@ -96,11 +99,14 @@ class CollectQueryMetrics : CollectMetricsBase {
             auto average_time = total_time / nq_;
             server::Metrics::GetInstance().QueryVectorResponseSummaryObserve(average_time, nq_);
             server::Metrics::GetInstance().QueryVectorResponsePerSecondGaugeSet(double(nq_) / total_time);
+            server::Metrics::GetInstance().QueryPerTableTotalIncrement(table_id_);
+            server::Metrics::GetInstance().QueryPerTableDurationObserve(table_id_, total_time);
         }
     }
 
  private:
     size_t nq_;
+    std::string table_id_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -12,6 +12,7 @@
 #include "metrics/SystemInfo.h"
 #include "thirdparty/nlohmann/json.hpp"
 #include "utils/Log.h"
+#include "utils/MallocUtil.h"
 
 #include <dirent.h>
 #include <fiu-local.h>
@@ -29,6 +30,14 @@
 namespace milvus {
 namespace server {
 
+#ifdef MILVUS_GPU_VERSION
+namespace {
+// device handles resolved once at Init(); nvmlDeviceGetHandleByIndex on every
+// metric tick is a measurable syscall cost with many devices
+std::vector<nvmlDevice_t> gpu_device_handles;
+}  // namespace
+#endif
+
 void
 SystemInfo::Init() {
     if (initialized_) {
@@ -72,6 +81,12 @@ SystemInfo::Init() {
         SERVER_LOG_ERROR << "Unable to get devidce number";
         return;
     }
+    gpu_device_handles.clear();
+    for (uint32_t i = 0; i < num_device_; ++i) {
+        nvmlDevice_t device;
+        nvmlDeviceGetHandleByIndex(i, &device);
+        gpu_device_handles.push_back(device);
+    }
 #endif
 
     // initialize network traffic information
@@ -137,18 +152,23 @@ SystemInfo::MemoryPercent() {
 
 std::vector<double>
 SystemInfo::CPUCorePercent() {
-    std::vector<uint64_t> prev_work_time_array;
-    std::vector<uint64_t> prev_total_time_array = getTotalCpuTime(prev_work_time_array);
-    usleep(100000);
+    // the first call has no previous snapshot to diff against; seed one with
+    // a short sample. Every later call diffs against the last tick for free.
+    if (prev_core_total_time_.empty()) {
+        prev_core_total_time_ = getTotalCpuTime(prev_core_work_time_);
+        usleep(100000);
+    }
     std::vector<uint64_t> cur_work_time_array;
     std::vector<uint64_t> cur_total_time_array = getTotalCpuTime(cur_work_time_array);
 
     std::vector<double> cpu_core_percent;
-    for (int i = 0; i < cur_total_time_array.size(); i++) {
-        double total_cpu_time = cur_total_time_array[i] - prev_total_time_array[i];
-        double cpu_work_time = cur_work_time_array[i] - prev_work_time_array[i];
+    for (int i = 0; i < cur_total_time_array.size() && i < prev_core_total_time_.size(); i++) {
+        double total_cpu_time = cur_total_time_array[i] - prev_core_total_time_[i];
+        double cpu_work_time = cur_work_time_array[i] - prev_core_work_time_[i];
         cpu_core_percent.push_back((cpu_work_time / total_cpu_time) * 100);
     }
+    prev_core_work_time_ = cur_work_time_array;
+    prev_core_total_time_ = cur_total_time_array;
     return cpu_core_percent;
 }
 
@@ -223,9 +243,7 @@ SystemInfo::GPUMemoryTotal() {
 #ifdef MILVUS_GPU_VERSION
 
     nvmlMemory_t nvmlMemory;
-    for (int i = 0; i < num_device_; ++i) {
-        nvmlDevice_t device;
-        nvmlDeviceGetHandleByIndex(i, &device);
+    for (auto& device : gpu_device_handles) {
         nvmlDeviceGetMemoryInfo(device, &nvmlMemory);
         result.push_back(nvmlMemory.total);
     }
@@ -243,9 +261,7 @@ SystemInfo::GPUTemperature() {
 
 #ifdef MILVUS_GPU_VERSION
 
-    for (int i = 0; i < num_device_; i++) {
-        nvmlDevice_t device;
-        nvmlDeviceGetHandleByIndex(i, &device);
+    for (auto& device : gpu_device_handles) {
         unsigned int temp;
         nvmlDeviceGetTemperature(device, NVML_TEMPERATURE_GPU, &temp);
         result.push_back(temp);
@@ -308,9 +324,7 @@ SystemInfo::GPUMemoryUsed() {
 #ifdef MILVUS_GPU_VERSION
 
     nvmlMemory_t nvmlMemory;
-    for (int i = 0; i < num_device_; ++i) {
-        nvmlDevice_t device;
-        nvmlDeviceGetHandleByIndex(i, &device);
+    for (auto& device : gpu_device_handles) {
         nvmlDeviceGetMemoryInfo(device, &nvmlMemory);
         result.push_back(nvmlMemory.used);
     }
@@ -320,6 +334,27 @@ SystemInfo::GPUMemoryUsed() {
     return result;
 }
 
+std::vector<uint64_t>
+SystemInfo::GPUUtilization() {
+    fiu_do_on("SystemInfo.GPUUtilization.mock", initialized_ = false);
+    if (!initialized_)
+        Init();
+
+    std::vector<uint64_t> result;
+
+#ifdef MILVUS_GPU_VERSION
+
+    for (auto& device : gpu_device_handles) {
+        nvmlUtilization_t utilization;
+        nvmlDeviceGetUtilizationRates(device, &utilization);
+        result.push_back(utilization.gpu);
+    }
+
+#endif
+
+    return result;
+}
+
 std::pair<uint64_t, uint64_t>
 SystemInfo::Octets() {
     pid_t pid = getpid();
@@ -362,6 +397,15 @@ SystemInfo::GetSysInfoJsonStr(std::string& result) {
     sys_info_map["memory_total"] = std::to_string(GetPhysicalMemory());
     sys_info_map["memory_used"] = std::to_string(GetProcessUsedMemory());
 
+    // allocator-level view: how much of the footprint is live data versus
+    // freed chunks the heap still holds (build/merge churn shows up here)
+    HeapStats heap_stats = MallocUtil::GetHeapStats();
+    sys_info_map["heap_allocated_bytes"] = std::to_string(heap_stats.allocated_bytes);
+    sys_info_map["heap_free_bytes"] = std::to_string(heap_stats.free_bytes);
+    sys_info_map["heap_releasable_bytes"] = std::to_string(heap_stats.releasable_bytes);
+    sys_info_map["heap_mmapped_bytes"] = std::to_string(heap_stats.mmapped_bytes);
+    sys_info_map["heap_fragmentation_ratio"] = std::to_string(heap_stats.fragmentation_ratio);
+
     std::vector<uint64_t> gpu_mem_total = GPUMemoryTotal();
     std::vector<uint64_t> gpu_mem_used = GPUMemoryUsed();
     for (size_t i = 0; i < gpu_mem_total.size(); i++) {
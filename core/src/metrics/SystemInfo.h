@@ -33,6 +33,10 @@ class SystemInfo {
     uint64_t in_octets_ = 0;
     uint64_t out_octets_ = 0;
     bool initialized_ = false;
+    // previous per-core /proc/stat snapshot, so each CPUCorePercent() call
+    // reports utilization since the last tick instead of sleeping to resample
+    std::vector<uint64_t> prev_core_work_time_;
+    std::vector<uint64_t> prev_core_total_time_;
 
  public:
     static SystemInfo&
@@ -110,6 +114,10 @@ class SystemInfo {
     CPUCorePercent();
     std::vector<uint64_t>
     getTotalCpuTime(std::vector<uint64_t>& workTime);
+    // GPU compute utilization percent per device, from the persistent NVML
+    // handles cached at Init()
+    std::vector<uint64_t>
+    GPUUtilization();
     std::vector<uint64_t>
     GPUTemperature();
     std::vector<float>
@@ -34,6 +34,7 @@ PrometheusMetrics::Init() {
         std::string push_port, push_address;
         CONFIG_CHECK(config.GetMetricConfigPort(push_port));
         CONFIG_CHECK(config.GetMetricConfigAddress(push_address));
+        CONFIG_CHECK(config.GetMetricConfigLabelCardinalityLimit(table_label_limit_));
 
         const std::string uri = std::string("/metrics");
         // const std::size_t num_threads = 2;
@@ -56,6 +57,19 @@ PrometheusMetrics::Init() {
     return Status::OK();
 }
 
+std::string
+PrometheusMetrics::BoundTableLabel(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(table_label_mutex_);
+    if (table_labels_.find(table_id) != table_labels_.end()) {
+        return table_id;
+    }
+    if (static_cast<int64_t>(table_labels_.size()) >= table_label_limit_) {
+        return "_other";
+    }
+    table_labels_.insert(table_id);
+    return table_id;
+}
+
 void
 PrometheusMetrics::CPUUsagePercentSet() {
     if (!startup_) {
@@ -93,6 +107,35 @@ PrometheusMetrics::GPUPercentGaugeSet() {
     }
 }
 
+void
+PrometheusMetrics::GPUUtilizationGaugeSet() {
+    if (!startup_) {
+        return;
+    }
+
+    std::vector<uint64_t> gpu_utilization = server::SystemInfo::GetInstance().GPUUtilization();
+    for (size_t i = 0; i < gpu_utilization.size(); ++i) {
+        prometheus::Gauge& utilization_gauge = GPU_utilization_.Add({{"DeviceNum", std::to_string(i)}});
+        utilization_gauge.Set(gpu_utilization[i]);
+    }
+}
+
+void
+PrometheusMetrics::ResourceExecutorCpuSecondsGaugeSet(const std::string& resource_name, double value) {
+    if (!startup_) {
+        return;
+    }
+    resource_executor_cpu_seconds_.Add({{"resource", resource_name}}).Set(value);
+}
+
+void
+PrometheusMetrics::ResourceLoaderIOBytesGaugeSet(const std::string& resource_name, double value) {
+    if (!startup_) {
+        return;
+    }
+    resource_loader_io_bytes_.Add({{"resource", resource_name}}).Set(value);
+}
+
 void
 PrometheusMetrics::GPUMemoryUsageGaugeSet() {
     if (!startup_) {
@@ -16,7 +16,9 @@
 #include <prometheus/registry.h>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "metrics/MetricBase.h"
@@ -146,6 +148,62 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    CacheHitTotalIncrement(const std::string& policy, const std::string& cache_name, double value = 1) override {
+        if (startup_) {
+            cache_hit_.Add({{"policy", policy}, {"cache", cache_name}}).Increment(value);
+        }
+    }
+
+    void
+    CacheMissTotalIncrement(const std::string& policy, const std::string& cache_name, double value = 1) override {
+        if (startup_) {
+            cache_miss_.Add({{"policy", policy}, {"cache", cache_name}}).Increment(value);
+        }
+    }
+
+    void
+    CacheEvictionTotalIncrement(const std::string& cache_name, double value = 1) override {
+        if (startup_) {
+            cache_eviction_.Add({{"cache", cache_name}}).Increment(value);
+        }
+    }
+
+    void
+    CacheIOBytesTotalIncrement(const std::string& cache_name, const std::string& direction, double value) override {
+        if (startup_) {
+            cache_io_bytes_.Add({{"cache", cache_name}, {"direction", direction}}).Increment(value);
+        }
+    }
+
+    void
+    RequestShedTotalIncrement(const std::string& reason, double value = 1) override {
+        if (startup_) {
+            request_shed_.Add({{"reason", reason}}).Increment(value);
+        }
+    }
+
+    void
+    ActiveComputeTasksGaugeSet(double value) override {
+        if (startup_) {
+            active_compute_tasks_gauge_.Set(value);
+        }
+    }
+
+    void
+    ComputeTokensInUseGaugeSet(double value) override {
+        if (startup_) {
+            compute_tokens_in_use_gauge_.Set(value);
+        }
+    }
+
+    void
+    HugePageCoverageGaugeSet(double value) override {
+        if (startup_) {
+            hugepage_coverage_gauge_.Set(value);
+        }
+    }
+
     void
     MemTableMergeDurationSecondsHistogramObserve(double value) override {
         if (startup_) {
@@ -202,6 +260,56 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    QueryStageLatencySecondsObserve(const std::string& stage, double value) override {
+        if (!startup_) {
+            return;
+        }
+        if (stage == "queue_wait") {
+            query_stage_queue_wait_histogram_.Observe(value);
+        } else if (stage == "load") {
+            query_stage_load_histogram_.Observe(value);
+        } else if (stage == "search") {
+            query_stage_search_histogram_.Observe(value);
+        } else if (stage == "reduce") {
+            query_stage_reduce_histogram_.Observe(value);
+        } else if (stage == "serialize") {
+            query_stage_serialize_histogram_.Observe(value);
+        }
+    }
+
+    void
+    QueryPerTableTotalIncrement(const std::string& table_id, double value = 1) override {
+        if (startup_) {
+            query_per_table_.Add({{"table", BoundTableLabel(table_id)}}).Increment(value);
+        }
+    }
+
+    void
+    QueryPerTableDurationObserve(const std::string& table_id, double value) override {
+        if (startup_) {
+            query_per_table_duration_
+                .Add({{"table", BoundTableLabel(table_id)}},
+                     BucketBoundaries{1e3, 1e4, 1e5, 2e5, 4e5, 6e5, 8e5, 1e6, 1e7})
+                .Observe(value);
+        }
+    }
+
+    void
+    InsertPerTableTotalIncrement(const std::string& table_id, double value = 1) override {
+        if (startup_) {
+            insert_per_table_.Add({{"table", BoundTableLabel(table_id)}}).Increment(value);
+        }
+    }
+
+    void
+    SearchComputeTotalIncrement(const std::string& index_type, const std::string& resource,
+                                double value = 1) override {
+        if (startup_) {
+            search_compute_.Add({{"index_type", index_type}, {"resource", resource}}).Increment(value);
+        }
+    }
+
     void
     DiskStoreIOSpeedGaugeSet(double value) override {
         if (startup_) {
@@ -264,6 +372,12 @@ class PrometheusMetrics : public MetricsBase {
     void
     GPUPercentGaugeSet() override;
     void
+    GPUUtilizationGaugeSet() override;
+    void
+    ResourceExecutorCpuSecondsGaugeSet(const std::string& resource_name, double value) override;
+    void
+    ResourceLoaderIOBytesGaugeSet(const std::string& resource_name, double value) override;
+    void
     GPUMemoryUsageGaugeSet() override;
     void
     AddVectorsPerSecondGaugeSet(int num_vector, int dim, double time) override;
@@ -311,6 +425,16 @@ class PrometheusMetrics : public MetricsBase {
 
     // .....
  private:
+    // map a table id onto a bounded label set: the first
+    // metric_config.label_cardinality_limit distinct tables keep their own
+    // series, later ones are folded into a shared "_other" series
+    std::string
+    BoundTableLabel(const std::string& table_id);
+
+    std::mutex table_label_mutex_;
+    std::unordered_set<std::string> table_labels_;
+    int64_t table_label_limit_ = 100;
+
     ////all from db_connection.cpp
     //    prometheus::Family<prometheus::Counter> &connect_request_ = prometheus::BuildCounter()
     //        .Name("connection_total")
@@ -460,6 +584,48 @@ class PrometheusMetrics : public MetricsBase {
     prometheus::Histogram& search_raw_data_duration_seconds_histogram_ =
         search_data_duration_seconds_.Add({{"type", "raw"}}, BucketBoundaries{1e5, 2e5, 4e5, 6e5, 8e5});
 
+    // per-stage latency breakdown of sampled queries, in seconds
+    prometheus::Family<prometheus::Histogram>& query_stage_latency_seconds_ =
+        prometheus::BuildHistogram()
+            .Name("query_stage_latency_seconds")
+            .Help("histogram of per-stage processing time for sampled queries")
+            .Register(*registry_);
+    prometheus::Histogram& query_stage_queue_wait_histogram_ = query_stage_latency_seconds_.Add(
+        {{"stage", "queue_wait"}}, BucketBoundaries{0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1.0, 5.0, 10.0});
+    prometheus::Histogram& query_stage_load_histogram_ = query_stage_latency_seconds_.Add(
+        {{"stage", "load"}}, BucketBoundaries{0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1.0, 5.0, 10.0});
+    prometheus::Histogram& query_stage_search_histogram_ = query_stage_latency_seconds_.Add(
+        {{"stage", "search"}}, BucketBoundaries{0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1.0, 5.0, 10.0});
+    prometheus::Histogram& query_stage_reduce_histogram_ = query_stage_latency_seconds_.Add(
+        {{"stage", "reduce"}}, BucketBoundaries{0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1.0, 5.0, 10.0});
+    prometheus::Histogram& query_stage_serialize_histogram_ = query_stage_latency_seconds_.Add(
+        {{"stage", "serialize"}}, BucketBoundaries{0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1.0, 5.0, 10.0});
+
+    // per-table request families; the table label is bounded by BoundTableLabel
+    prometheus::Family<prometheus::Counter>& query_per_table_ = prometheus::BuildCounter()
+                                                                    .Name("query_per_table_total")
+                                                                    .Help("the number of queries per table")
+                                                                    .Register(*registry_);
+
+    prometheus::Family<prometheus::Histogram>& query_per_table_duration_ =
+        prometheus::BuildHistogram()
+            .Name("query_per_table_duration_microseconds")
+            .Help("histogram of query processing time per table")
+            .Register(*registry_);
+
+    prometheus::Family<prometheus::Counter>& insert_per_table_ =
+        prometheus::BuildCounter()
+            .Name("insert_vectors_per_table_total")
+            .Help("the number of vectors inserted per table")
+            .Register(*registry_);
+
+    // per-segment search work, labeled by index type and scheduler resource
+    prometheus::Family<prometheus::Counter>& search_compute_ =
+        prometheus::BuildCounter()
+            .Name("search_compute_total")
+            .Help("the number of segment searches by index type and resource")
+            .Register(*registry_);
+
     ////all form Cache.cpp
     // record cache usage, when insert/erase/clear/free
 
@@ -543,6 +709,57 @@ class PrometheusMetrics : public MetricsBase {
                                                                  .Register(*registry_);
     prometheus::Counter& cache_access_total_ = cache_access_.Add({});
 
+    // record cache hit/miss count, labeled by eviction policy so the
+    // policies can be A/B compared across deployments, and by cache instance
+    prometheus::Family<prometheus::Counter>& cache_hit_ = prometheus::BuildCounter()
+                                                              .Name("cache_hit_total")
+                                                              .Help("the count of cache hits ")
+                                                              .Register(*registry_);
+    prometheus::Family<prometheus::Counter>& cache_miss_ = prometheus::BuildCounter()
+                                                               .Name("cache_miss_total")
+                                                               .Help("the count of cache misses ")
+                                                               .Register(*registry_);
+
+    // eviction churn and byte traffic per cache instance
+    prometheus::Family<prometheus::Counter>& cache_eviction_ = prometheus::BuildCounter()
+                                                                   .Name("cache_eviction_total")
+                                                                   .Help("the count of cache evictions ")
+                                                                   .Register(*registry_);
+    prometheus::Family<prometheus::Counter>& cache_io_bytes_ =
+        prometheus::BuildCounter()
+            .Name("cache_io_bytes_total")
+            .Help("bytes moved in and out of each cache instance ")
+            .Register(*registry_);
+
+    // requests refused by the delivery-layer rate limiter, labeled by the
+    // limit that tripped (client_rate / table_rate)
+    prometheus::Family<prometheus::Counter>& request_shed_ = prometheus::BuildCounter()
+                                                                .Name("request_shed_total")
+                                                                .Help("the count of rate-limited requests ")
+                                                                .Register(*registry_);
+
+    // thread governor: compute regions running and the openmp width they hold
+    prometheus::Family<prometheus::Gauge>& active_compute_tasks_ = prometheus::BuildGauge()
+                                                                       .Name("active_compute_tasks")
+                                                                       .Help("compute tasks currently executing")
+                                                                       .Register(*registry_);
+    prometheus::Gauge& active_compute_tasks_gauge_ = active_compute_tasks_.Add({});
+
+    prometheus::Family<prometheus::Gauge>& compute_tokens_in_use_ =
+        prometheus::BuildGauge()
+            .Name("compute_tokens_in_use")
+            .Help("openmp threads granted to running compute tasks")
+            .Register(*registry_);
+    prometheus::Gauge& compute_tokens_in_use_gauge_ = compute_tokens_in_use_.Add({});
+
+    // fraction of live index buffer bytes backed by 2 MB pages
+    prometheus::Family<prometheus::Gauge>& hugepage_coverage_ =
+        prometheus::BuildGauge()
+            .Name("index_buffer_hugepage_coverage")
+            .Help("fraction of index buffer bytes backed by hugepages")
+            .Register(*registry_);
+    prometheus::Gauge& hugepage_coverage_gauge_ = hugepage_coverage_.Add({});
+
     // record CPU cache usage and %
     prometheus::Family<prometheus::Gauge>& cpu_cache_usage_ =
         prometheus::BuildGauge().Name("cache_usage_bytes").Help("current cache usage by bytes").Register(*registry_);
@@ -624,6 +841,22 @@ class PrometheusMetrics : public MetricsBase {
     prometheus::Family<prometheus::Gauge>& GPU_memory_usage_ =
         prometheus::BuildGauge().Name("GPU_memory_usage_total").Help("GPU memory usage total ").Register(*registry_);
 
+    // GPU compute utilization
+    prometheus::Family<prometheus::Gauge>& GPU_utilization_ =
+        prometheus::BuildGauge().Name("GPU_utilization_percent").Help("GPU compute utilization percent").Register(*registry_);
+
+    // per-scheduler-resource attribution
+    prometheus::Family<prometheus::Gauge>& resource_executor_cpu_seconds_ =
+        prometheus::BuildGauge()
+            .Name("resource_executor_cpu_seconds")
+            .Help("cumulative CPU seconds of each scheduler resource's executor threads")
+            .Register(*registry_);
+    prometheus::Family<prometheus::Gauge>& resource_loader_io_bytes_ =
+        prometheus::BuildGauge()
+            .Name("resource_loader_io_bytes")
+            .Help("cumulative bytes loaded onto each scheduler resource")
+            .Register(*registry_);
+
     prometheus::Family<prometheus::Gauge>& query_index_type_per_second_ =
         prometheus::BuildGauge()
             .Name("query_index_throughtout_per_microsecond")
@@ -0,0 +1,104 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "scheduler/CostModel.h"
+
+#include <algorithm>
+
+namespace milvus {
+namespace scheduler {
+
+namespace {
+
+// power-of-two bucketing keeps the table small while still separating the
+// regimes (nq = 1 vs nq = 1000) that a single static threshold conflates
+uint64_t
+Bucket(uint64_t value) {
+    uint64_t bucket = 0;
+    while (value > 1) {
+        value >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+}  // namespace
+
+constexpr double CostModel::EWMA_ALPHA;
+constexpr uint64_t CostModel::MIN_SAMPLES;
+
+CostModel&
+CostModel::GetInstance() {
+    static CostModel instance;
+    return instance;
+}
+
+std::string
+CostModel::MakeKey(int32_t engine_type, uint64_t nq, uint64_t topk, uint64_t file_size, const std::string& resource) {
+    // file sizes are bucketed in MB so neighbouring segments share an entry
+    return std::to_string(engine_type) + "/" + std::to_string(Bucket(nq)) + "/" + std::to_string(Bucket(topk)) + "/" +
+           std::to_string(Bucket(file_size >> 20U)) + "/" + resource;
+}
+
+std::string
+CostModel::MakeThroughputKey(int32_t engine_type, const std::string& resource) {
+    return "tp/" + std::to_string(engine_type) + "/" + resource;
+}
+
+void
+CostModel::Observe(int32_t engine_type, uint64_t nq, uint64_t topk, uint64_t file_size, const std::string& resource,
+                   uint64_t cost_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = entries_[MakeKey(engine_type, nq, topk, file_size, resource)];
+    if (entry.samples == 0) {
+        entry.ewma_ms = static_cast<double>(cost_ms);
+    } else {
+        entry.ewma_ms = EWMA_ALPHA * static_cast<double>(cost_ms) + (1.0 - EWMA_ALPHA) * entry.ewma_ms;
+    }
+    ++entry.samples;
+
+    // shape-independent throughput for the same observation; the ewma field
+    // holds bytes per millisecond here rather than a latency
+    double bytes_per_ms = static_cast<double>(file_size) / static_cast<double>(std::max<uint64_t>(cost_ms, 1));
+    auto& tp_entry = entries_[MakeThroughputKey(engine_type, resource)];
+    if (tp_entry.samples == 0) {
+        tp_entry.ewma_ms = bytes_per_ms;
+    } else {
+        tp_entry.ewma_ms = EWMA_ALPHA * bytes_per_ms + (1.0 - EWMA_ALPHA) * tp_entry.ewma_ms;
+    }
+    ++tp_entry.samples;
+}
+
+bool
+CostModel::EstimateThroughput(int32_t engine_type, const std::string& resource, double& bytes_per_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(MakeThroughputKey(engine_type, resource));
+    if (iter == entries_.end() || iter->second.samples < MIN_SAMPLES || iter->second.ewma_ms <= 0.0) {
+        return false;
+    }
+    bytes_per_ms = iter->second.ewma_ms;
+    return true;
+}
+
+bool
+CostModel::Estimate(int32_t engine_type, uint64_t nq, uint64_t topk, uint64_t file_size, const std::string& resource,
+                    uint64_t& cost_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(MakeKey(engine_type, nq, topk, file_size, resource));
+    if (iter == entries_.end() || iter->second.samples < MIN_SAMPLES) {
+        return false;
+    }
+    cost_ms = static_cast<uint64_t>(iter->second.ewma_ms);
+    return true;
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,80 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Measured latency model for search-task placement. Task shape
+ * -- (engine type, nq, topk, segment size) -- is bucketed by power of two
+ * and tracked per resource as an exponentially weighted moving average of
+ * observed execution times. The executor feeds it after every search task;
+ * CostModelPass consults it to place new tasks on the cheapest resource
+ * once a shape has seen enough samples to be trusted.
+ */
+class CostModel {
+ public:
+    static CostModel&
+    GetInstance();
+
+    void
+    Observe(int32_t engine_type, uint64_t nq, uint64_t topk, uint64_t file_size, const std::string& resource,
+            uint64_t cost_ms);
+
+    /*
+     * Fill cost_ms with the expected execution time of the given task shape
+     * on the given resource; false until the shape accumulated MIN_SAMPLES
+     * observations there.
+     */
+    bool
+    Estimate(int32_t engine_type, uint64_t nq, uint64_t topk, uint64_t file_size, const std::string& resource,
+             uint64_t& cost_ms);
+
+    /*
+     * Per-(engine type, resource) throughput in bytes per millisecond,
+     * aggregated over every task shape. Coarser than Estimate but available
+     * as soon as a device class has run a few tasks of that index type;
+     * HybridSearchPass uses it to split one job across device classes.
+     */
+    bool
+    EstimateThroughput(int32_t engine_type, const std::string& resource, double& bytes_per_ms);
+
+ private:
+    CostModel() = default;
+
+    static std::string
+    MakeKey(int32_t engine_type, uint64_t nq, uint64_t topk, uint64_t file_size, const std::string& resource);
+
+    static std::string
+    MakeThroughputKey(int32_t engine_type, const std::string& resource);
+
+ private:
+    static constexpr double EWMA_ALPHA = 0.2;
+    static constexpr uint64_t MIN_SAMPLES = 8;
+
+    struct Entry {
+        double ewma_ms = 0.0;
+        uint64_t samples = 0;
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace scheduler
+}  // namespace milvus
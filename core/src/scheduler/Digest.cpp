@@ -0,0 +1,120 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "scheduler/Digest.h"
+#include "scheduler/SchedInst.h"
+#include "scheduler/TaskTable.h"
+
+#include <array>
+
+namespace milvus {
+namespace scheduler {
+
+std::atomic<uint64_t> SchedCounters::steals{0};
+std::atomic<uint64_t> SchedCounters::migrations{0};
+std::atomic<uint64_t> SchedCounters::speculations{0};
+
+namespace {
+
+constexpr size_t HISTOGRAM_BUCKETS = 16;  // power-of-two ms buckets, the last one open-ended
+
+using Histogram = std::array<uint64_t, HISTOGRAM_BUCKETS>;
+
+size_t
+bucket_of(uint64_t ms) {
+    size_t bucket = 0;
+    while (ms > 1 && bucket + 1 < HISTOGRAM_BUCKETS) {
+        ms >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+json
+to_json(const Histogram& histogram) {
+    json ret = json::array();
+    for (auto count : histogram) {
+        ret.push_back(count);
+    }
+    return ret;
+}
+
+}  // namespace
+
+json
+Digest() {
+    json resources = json::array();
+
+    for (auto& resource : ResMgrInst::GetInstance()->GetAllResources()) {
+        auto& table = resource->task_table();
+
+        Histogram queued{};
+        Histogram loading{};
+        Histogram loaded{};
+        Histogram executing{};
+        uint64_t sampled = 0;
+
+        uint64_t begin = table.front() + 1;
+        for (uint64_t i = 0; i < table.size(); ++i) {
+            uint64_t index = begin + i;
+            auto& item = table[index];
+            if (not item) {
+                break;
+            }
+            if (index % table.capacity() == table.rear()) {
+                break;
+            }
+
+            auto& ts = item->timestamp;
+            if (ts.load > ts.start && ts.start > 0) {
+                queued[bucket_of(ts.load - ts.start)]++;
+            }
+            if (ts.loaded > ts.load && ts.load > 0) {
+                loading[bucket_of(ts.loaded - ts.load)]++;
+            }
+            if (ts.execute > ts.loaded && ts.loaded > 0) {
+                loaded[bucket_of(ts.execute - ts.loaded)]++;
+            }
+            if (ts.executed > ts.execute && ts.execute > 0) {
+                executing[bucket_of(ts.executed - ts.execute)]++;
+            }
+            ++sampled;
+        }
+
+        json histograms{
+            {"queued_ms", to_json(queued)},
+            {"loading_ms", to_json(loading)},
+            {"wait_executor_ms", to_json(loaded)},
+            {"executing_ms", to_json(executing)},
+        };
+
+        json resource_json{
+            {"name", resource->name()},
+            {"queue_depth", table.size()},
+            {"task_to_execute", resource->NumOfTaskToExec()},
+            {"task_avg_cost_ms", resource->TaskAvgCost()},
+            {"tasks_sampled", sampled},
+            {"dwell_histograms_pow2", histograms},
+        };
+        resources.push_back(resource_json);
+    }
+
+    json ret{
+        {"resources", resources},
+        {"steal_count", SchedCounters::steals.load()},
+        {"migration_count", SchedCounters::migrations.load()},
+        {"speculation_count", SchedCounters::speculations.load()},
+    };
+    return ret;
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,42 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+
+#include "scheduler/interface/interfaces.h"
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Lock-free counters fed by the scheduler actions and reported by Digest().
+ */
+struct SchedCounters {
+    static std::atomic<uint64_t> steals;
+    static std::atomic<uint64_t> migrations;
+    static std::atomic<uint64_t> speculations;
+};
+
+/*
+ * Cheap runtime snapshot of the scheduler for the introspection endpoint:
+ * per-resource queue depths, dwell-time histograms over the task-state
+ * transitions (queued->loading->loaded->executing->executed, power-of-two
+ * millisecond buckets) and steal/migration totals. Sampling takes no locks:
+ * table items are shared pointers and their timestamps are written once per
+ * transition, so a racing read at worst misplaces one sample by a bucket.
+ */
+json
+Digest();
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,166 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+namespace scheduler {
+
+// Bounded multi-producer single-consumer ring for the Resource->Scheduler
+// event path. Every resource thread posts events; the former mutex+condvar
+// std::queue made each post a lock handoff with the consumer, which dominates
+// contention profiles at high task rates. Slots carry their own sequence
+// number (Vyukov's bounded queue), so producers claim positions with one CAS
+// and never touch a lock. The consumer drains the ring in batches and only
+// sleeps when it is empty; producers signal the condition variable solely on
+// the empty->non-empty transition while the consumer is flagged as sleeping,
+// one wakeup per batch like an eventfd, not one per event.
+template <typename T>
+class EventRing {
+    struct Slot {
+        std::atomic<uint64_t> seq;
+        T value;
+    };
+
+ public:
+    explicit EventRing(uint64_t capacity) {
+        // power-of-two capacity so masking replaces modulo
+        uint64_t cap = 1;
+        while (cap < capacity) {
+            cap <<= 1;
+        }
+        mask_ = cap - 1;
+        slots_.reset(new Slot[cap]);
+        for (uint64_t i = 0; i < cap; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    EventRing() = delete;
+    EventRing(const EventRing&) = delete;
+    EventRing(EventRing&&) = delete;
+
+    // producer side, lock-free; spins (yielding) while the ring is full,
+    // which a consumer that drains whole batches makes a transient state
+    void
+    put(T x) {
+        while (!try_put(std::move(x))) {
+            std::this_thread::yield();
+        }
+        if (sleeping_.exchange(false, std::memory_order_acq_rel)) {
+            // the exchange totally orders with the consumer's fence in
+            // WaitNonEmpty: either we observe sleeping_ and notify, or the
+            // consumer's predicate observes the slot publish above
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv_.notify_one();
+        }
+    }
+
+    // consumer side: move everything available into `out`, return the count
+    uint64_t
+    TakeBatch(std::vector<T>& out) {
+        uint64_t count = 0;
+        T x;
+        while (try_take(x)) {
+            out.emplace_back(std::move(x));
+            ++count;
+        }
+        return count;
+    }
+
+    // consumer side: block until a producer posts; spurious returns are fine,
+    // the caller simply retries TakeBatch
+    void
+    WaitNonEmpty() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleeping_.store(true, std::memory_order_release);
+        // StoreLoad barrier: without it the empty() check may read a stale
+        // seq while the sleeping_ store is still in the store buffer, and a
+        // producer publishing at that instant sees sleeping_ == false and
+        // skips the notify, stranding the event until the next put()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        cv_.wait(lock, [this] { return !empty(); });
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+
+    // racy by nature, used for dump/diagnostics only
+    uint64_t
+    size() const {
+        auto enqueue = enqueue_pos_.load(std::memory_order_relaxed);
+        auto dequeue = dequeue_pos_;
+        return enqueue > dequeue ? enqueue - dequeue : 0;
+    }
+
+ private:
+    bool
+    try_put(T&& x) {
+        uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots_[pos & mask_];
+            uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(x);
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // lost the claim race, pos was reloaded by the CAS
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool
+    try_take(T& x) {
+        Slot& slot = slots_[dequeue_pos_ & mask_];
+        uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (static_cast<int64_t>(seq) - static_cast<int64_t>(dequeue_pos_ + 1) < 0) {
+            return false;  // empty, or the claiming producer has not published yet
+        }
+        x = std::move(slot.value);
+        slot.value = T();
+        slot.seq.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_pos_;
+        return true;
+    }
+
+    bool
+    empty() {
+        Slot& slot = slots_[dequeue_pos_ & mask_];
+        return static_cast<int64_t>(slot.seq.load(std::memory_order_acquire)) -
+                   static_cast<int64_t>(dequeue_pos_ + 1) <
+               0;
+    }
+
+ private:
+    std::unique_ptr<Slot[]> slots_;
+    uint64_t mask_ = 0;
+    std::atomic<uint64_t> enqueue_pos_{0};
+    uint64_t dequeue_pos_ = 0;  // single consumer, no atomicity needed
+
+    std::atomic<bool> sleeping_{false};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -14,15 +14,39 @@
 #include "TaskCreator.h"
 #include "optimizer/Optimizer.h"
 #include "scheduler/Algorithm.h"
+#include "scheduler/Digest.h"
+#include "scheduler/job/SearchJob.h"
 #include "scheduler/optimizer/Optimizer.h"
+#include "scheduler/task/SearchTask.h"
 #include "scheduler/tasklabel/SpecResLabel.h"
+#include "task/FusedSearchTask.h"
 #include "task/Task.h"
+#include "utils/Log.h"
 
+#include <chrono>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace milvus {
 namespace scheduler {
 
+namespace {
+// how many of a job's queued tasks get a readahead hint at dispatch time
+constexpr uint64_t PREFETCH_DEPTH = 4;
+
+// QoS: backlog (loaded-but-unexecuted tasks summed over compute resources)
+// at which search quality starts degrading, and the hardest degradation
+// applied -- nprobe is divided by backlog/threshold, capped at this factor
+constexpr uint64_t QOS_DEGRADE_BACKLOG = 64;
+constexpr uint64_t QOS_MAX_DEGRADE_FACTOR = 8;
+
+// straggler-monitor poll period; detection latency adds to the tail a clone
+// can save, so it stays well below a straggler's excess run time
+constexpr uint64_t SPECULATE_POLL_INTERVAL_MS = 100;
+}  // namespace
+
 JobMgr::JobMgr(ResourceMgrPtr res_mgr) : res_mgr_(std::move(res_mgr)) {
 }
 
@@ -31,6 +55,8 @@ JobMgr::Start() {
     if (not running_) {
         running_ = true;
         worker_thread_ = std::thread(&JobMgr::worker_function, this);
+        monitor_running_ = true;
+        monitor_thread_ = std::thread(&JobMgr::monitor_function, this);
     }
 }
 
@@ -39,6 +65,8 @@ JobMgr::Stop() {
     if (running_) {
         this->Put(nullptr);
         worker_thread_.join();
+        monitor_running_ = false;
+        monitor_thread_.join();
         running_ = false;
     }
 }
@@ -63,17 +91,39 @@ JobMgr::Put(const JobPtr& job) {
 
 void
 JobMgr::worker_function() {
+    std::vector<JobPtr> job_batch;
     while (running_) {
-        std::unique_lock<std::mutex> lock(mutex_);
-        cv_.wait(lock, [this] { return !queue_.empty(); });
-        auto job = queue_.front();
-        queue_.pop();
-        lock.unlock();
-        if (job == nullptr) {
-            break;
+        job_batch.clear();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return !queue_.empty(); });
+            // drain all queued jobs: fusion can only combine tasks that are
+            // dispatched in the same batch
+            while (!queue_.empty()) {
+                job_batch.emplace_back(queue_.front());
+                queue_.pop();
+            }
         }
 
-        auto tasks = build_task(job);
+        std::vector<TaskPtr> tasks;
+        for (auto& job : job_batch) {
+            if (job == nullptr) {
+                return;
+            }
+
+            apply_qos_policy(job);
+
+            if (job->type() == JobType::SEARCH) {
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                active_search_jobs_.push_back(std::static_pointer_cast<SearchJob>(job));
+            }
+
+            auto job_tasks = build_task(job);
+            tasks.insert(tasks.end(), job_tasks.begin(), job_tasks.end());
+        }
+
+        tasks = fuse_search_tasks(tasks);
+
         for (auto& task : tasks) {
             OptimizerInst::GetInstance()->Run(task);
         }
@@ -82,6 +132,17 @@ JobMgr::worker_function() {
             calculate_path(res_mgr_, task);
         }
 
+        // prefetch stage: hint the first few index files so the kernel reads them
+        // while the earliest tasks of the job load and execute
+        uint64_t prefetch_count = 0;
+        for (auto& task : tasks) {
+            if (prefetch_count >= PREFETCH_DEPTH) {
+                break;
+            }
+            task->Prefetch();
+            ++prefetch_count;
+        }
+
         // disk resources NEVER be empty.
         if (auto disk = res_mgr_->GetDiskResources()[0].lock()) {
             for (auto& task : tasks) {
@@ -96,6 +157,145 @@ JobMgr::build_task(const JobPtr& job) {
     return TaskCreator::Create(job);
 }
 
+void
+JobMgr::monitor_function() {
+    while (monitor_running_) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(SPECULATE_POLL_INTERVAL_MS));
+
+        std::vector<std::shared_ptr<SearchJob>> jobs;
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            for (auto iter = active_search_jobs_.begin(); iter != active_search_jobs_.end();) {
+                if (auto job = iter->lock()) {
+                    jobs.push_back(job);
+                    ++iter;
+                } else {
+                    iter = active_search_jobs_.erase(iter);
+                }
+            }
+        }
+
+        for (auto& job : jobs) {
+            speculate(job);
+        }
+    }
+}
+
+void
+JobMgr::speculate(const std::shared_ptr<SearchJob>& job) {
+    std::vector<TableFileSchemaPtr> stragglers;
+    job->PickStragglers(stragglers);
+    if (stragglers.empty()) {
+        return;
+    }
+
+    for (auto& file : stragglers) {
+        // the clone only helps on a resource with free cycles; with none
+        // idle it would just queue behind the work it is meant to outrun
+        ResourcePtr dest = nullptr;
+        for (auto& resource : res_mgr_->GetComputeResources()) {
+            if (resource->HasExecutor() && resource->NumOfTaskToExec() == 0) {
+                dest = resource;
+                break;
+            }
+        }
+        if (dest == nullptr) {
+            return;
+        }
+
+        auto task = std::make_shared<XSearchTask>(job->GetContext(), file, std::make_shared<SpecResLabel>(dest));
+        task->job_ = job;
+        calculate_path(res_mgr_, task);
+
+        SERVER_LOG_DEBUG << "JobMgr: job " << job->id() << " file " << file->id_
+                         << " exceeded p95 task time, speculating on " << dest->name();
+        SchedCounters::speculations.fetch_add(1);
+
+        if (auto disk = res_mgr_->GetDiskResources()[0].lock()) {
+            disk->task_table().Put(task, nullptr);
+        }
+    }
+}
+
+std::vector<TaskPtr>
+JobMgr::fuse_search_tasks(const std::vector<TaskPtr>& tasks) {
+    std::vector<TaskPtr> result;
+    std::unordered_map<std::string, std::vector<TaskPtr>> groups;
+
+    for (auto& task : tasks) {
+        if (task->Type() != TaskType::SearchTask) {
+            result.push_back(task);
+            continue;
+        }
+        auto search_task = std::static_pointer_cast<XSearchTask>(task);
+        auto job = std::static_pointer_cast<SearchJob>(search_task->job_.lock());
+        if (job == nullptr || job->IsRangeSearch() || job->vectors().FloatDataSize() == 0) {
+            result.push_back(task);
+            continue;
+        }
+        // attribute-filtered jobs keep their own tasks: co-batched jobs may
+        // carry different predicates, and the fused engine call takes one
+        // selector for the whole batch
+        if (search_task->context_ != nullptr && search_task->context_->GetAttrFilter() != nullptr) {
+            result.push_back(task);
+            continue;
+        }
+
+        // tasks fuse only when the single engine call is identical for all
+        // of them: same segment, same topk, same (possibly degraded) nprobe
+        std::string key = std::to_string(search_task->file_->id_) + "/" + std::to_string(job->topk()) + "/" +
+                          std::to_string(job->nprobe());
+        groups[key].push_back(task);
+    }
+
+    for (auto& pair : groups) {
+        auto& group = pair.second;
+        if (group.size() == 1) {
+            result.push_back(group.front());
+            continue;
+        }
+
+        auto first = std::static_pointer_cast<XSearchTask>(group.front());
+        auto fused = std::make_shared<XFusedSearchTask>(first->context_, first->file_, first->label());
+        fused->job_ = first->job_;
+        for (auto& task : group) {
+            fused->fused_jobs_.push_back(std::static_pointer_cast<XSearchTask>(task)->job_);
+        }
+        SERVER_LOG_DEBUG << "JobMgr: fused " << group.size() << " search tasks on file " << first->file_->id_;
+        result.push_back(fused);
+    }
+
+    return result;
+}
+
+void
+JobMgr::apply_qos_policy(const JobPtr& job) {
+    if (job->type() != JobType::SEARCH) {
+        return;
+    }
+
+    uint64_t backlog = 0;
+    for (auto& resource : res_mgr_->GetComputeResources()) {
+        backlog += resource->NumOfTaskToExec();
+    }
+    if (backlog < QOS_DEGRADE_BACKLOG) {
+        return;
+    }
+
+    auto factor = backlog / QOS_DEGRADE_BACKLOG + 1;
+    if (factor > QOS_MAX_DEGRADE_FACTOR) {
+        factor = QOS_MAX_DEGRADE_FACTOR;
+    }
+
+    auto search_job = std::static_pointer_cast<SearchJob>(job);
+    auto origin_nprobe = search_job->nprobe();
+    search_job->DegradeNprobe(factor);
+    if (search_job->IsDegraded()) {
+        SERVER_LOG_WARNING << "JobMgr: compute backlog " << backlog << ", degrade job " << job->id() << " nprobe "
+                           << origin_nprobe << " -> " << search_job->nprobe();
+    }
+}
+
 void
 JobMgr::calculate_path(const ResourceMgrPtr& res_mgr, const TaskPtr& task) {
     if (task->type_ != TaskType::SearchTask && task->type_ != TaskType::BuildIndexTask) {
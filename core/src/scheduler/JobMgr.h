@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <list>
@@ -29,6 +30,8 @@
 namespace milvus {
 namespace scheduler {
 
+class SearchJob;
+
 class JobMgr : public interface::dumpable {
  public:
     explicit JobMgr(ResourceMgrPtr res_mgr);
@@ -53,6 +56,36 @@ class JobMgr : public interface::dumpable {
     static std::vector<TaskPtr>
     build_task(const JobPtr& job);
 
+    /*
+     * Segment-level task fusion: search tasks from different jobs of one
+     * dispatch batch that target the same file with the same topk and
+     * nprobe are replaced by a single task executing the concatenated nq
+     * batch, whose results are scattered back to the parent jobs;
+     */
+    static std::vector<TaskPtr>
+    fuse_search_tasks(const std::vector<TaskPtr>& tasks);
+
+    /*
+     * QoS policy hook, applied before a job is disassembled into tasks:
+     * once the compute backlog crosses a threshold, search jobs get their
+     * effective nprobe scaled down instead of being rejected;
+     */
+    void
+    apply_qos_policy(const JobPtr& job);
+
+    /*
+     * Straggler mitigation, MapReduce-style speculative execution: a monitor
+     * polls the dispatched search jobs and, once a job is over 90% complete,
+     * clones any task that has exceeded the job's P95 task time onto an idle
+     * compute resource. Whichever copy finishes first merges its result; the
+     * claim protocol in SearchJob deduplicates by file id;
+     */
+    void
+    monitor_function();
+
+    void
+    speculate(const std::shared_ptr<SearchJob>& job);
+
  public:
     static void
     calculate_path(const ResourceMgrPtr& res_mgr, const TaskPtr& task);
@@ -63,6 +96,11 @@ class JobMgr : public interface::dumpable {
 
     std::thread worker_thread_;
 
+    std::atomic<bool> monitor_running_{false};
+    std::thread monitor_thread_;
+    std::list<std::weak_ptr<SearchJob>> active_search_jobs_;
+    std::mutex jobs_mutex_;
+
     std::mutex mutex_;
     std::condition_variable cv_;
 
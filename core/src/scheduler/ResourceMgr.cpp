@@ -34,12 +34,8 @@ ResourceMgr::Start() {
 
 void
 ResourceMgr::Stop() {
-    {
-        std::lock_guard<std::mutex> lock(event_mutex_);
-        running_ = false;
-        queue_.push(nullptr);
-        event_cv_.notify_one();
-    }
+    running_ = false;
+    event_ring_.put(nullptr);  // sentinel, the worker returns when it sees it
     worker_thread_.join();
 
     std::lock_guard<std::mutex> lck(resources_mutex_);
@@ -195,11 +191,11 @@ ResourceMgr::DumpTaskTables() {
 bool
 ResourceMgr::check_resource_valid() {
     {
-        // TODO: check one disk-resource, one cpu-resource, zero or more gpu-resource;
+        // TODO: check one disk-resource, one or more cpu-resource, zero or more gpu-resource;
         if (GetDiskResources().size() != 1) {
             return false;
         }
-        if (GetCpuResources().size() != 1) {
+        if (GetCpuResources().empty()) {
             return false;
         }
     }
@@ -228,28 +224,29 @@ ResourceMgr::check_resource_valid() {
 
 void
 ResourceMgr::post_event(const EventPtr& event) {
-    {
-        std::lock_guard<std::mutex> lock(event_mutex_);
-        queue_.emplace(event);
-    }
-    event_cv_.notify_one();
+    event_ring_.put(event);
 }
 
 void
 ResourceMgr::event_process() {
+    std::vector<EventPtr> batch;
     while (running_) {
-        std::unique_lock<std::mutex> lock(event_mutex_);
-        event_cv_.wait(lock, [this] { return !queue_.empty(); });
-
-        auto event = queue_.front();
-        queue_.pop();
-        lock.unlock();
-        if (event == nullptr) {
-            break;
+        batch.clear();
+        // drain the ring in one chunk and sleep only when it runs dry: one
+        // wakeup per batch instead of a lock handoff per event
+        if (event_ring_.TakeBatch(batch) == 0) {
+            event_ring_.WaitNonEmpty();
+            continue;
         }
 
-        if (subscriber_) {
-            subscriber_(event);
+        for (auto& event : batch) {
+            if (event == nullptr) {
+                return;
+            }
+
+            if (subscriber_) {
+                subscriber_(event);
+            }
         }
     }
 }
@@ -11,14 +11,14 @@
 
 #pragma once
 
-#include <condition_variable>
+#include <atomic>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "EventRing.h"
 #include "interface/interfaces.h"
 #include "resource/Resource.h"
 #include "utils/Log.h"
@@ -26,6 +26,11 @@
 namespace milvus {
 namespace scheduler {
 
+// event ring slots per consumer; sized far above the worst observed event
+// burst (one per task state transition), since a full ring makes producers
+// spin until the consumer drains a batch
+constexpr uint64_t EVENT_RING_CAPACITY = 4096;
+
 class ResourceMgr : public interface::dumpable {
  public:
     ResourceMgr() = default;
@@ -114,7 +119,7 @@ class ResourceMgr : public interface::dumpable {
     event_process();
 
  private:
-    bool running_ = false;
+    std::atomic<bool> running_{false};
 
     std::vector<ResourceWPtr> disk_resources_;
     std::vector<ResourceWPtr> cpu_resources_;
@@ -122,10 +127,8 @@ class ResourceMgr : public interface::dumpable {
     std::vector<ResourcePtr> resources_;
     mutable std::mutex resources_mutex_;
 
-    std::queue<EventPtr> queue_;
+    EventRing<EventPtr> event_ring_{EVENT_RING_CAPACITY};
     std::function<void(EventPtr)> subscriber_ = nullptr;
-    std::mutex event_mutex_;
-    std::condition_variable event_cv_;
 
     std::thread worker_thread_;
 };
@@ -43,9 +43,19 @@ load_simple_config() {
     // create and connect
     ResMgrInst::GetInstance()->Add(ResourceFactory::Create("disk", "DISK", 0, false));
 
+    // one CPU resource per NUMA node keeps index memory on the socket that searches
+    // it; single-node hosts keep the original lone "cpu" resource
     auto io = Connection("io", 500);
-    ResMgrInst::GetInstance()->Add(ResourceFactory::Create("cpu", "CPU", 0));
-    ResMgrInst::GetInstance()->Connect("disk", "cpu", io);
+    auto numa_nodes = numa_node_count();
+    for (uint64_t node = 0; node < numa_nodes; ++node) {
+        std::string name = (node == 0) ? "cpu" : "cpu" + std::to_string(node);
+        auto cpu = ResourceFactory::Create(name, "CPU", node);
+        if (numa_nodes > 1) {
+            std::static_pointer_cast<CpuResource>(cpu)->SetNumaNode(node);
+        }
+        ResMgrInst::GetInstance()->Add(std::move(cpu));
+        ResMgrInst::GetInstance()->Connect("disk", name, io);
+    }
 
 // get resources
 #ifdef MILVUS_GPU_VERSION
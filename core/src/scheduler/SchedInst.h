@@ -17,13 +17,17 @@
 #include "Scheduler.h"
 #include "Utils.h"
 #include "optimizer/BuildIndexPass.h"
+#include "optimizer/CostModelPass.h"
 #include "optimizer/FaissFlatPass.h"
 #include "optimizer/FaissIVFFlatPass.h"
 #include "optimizer/FaissIVFPQPass.h"
 #include "optimizer/FaissIVFSQ8HPass.h"
 #include "optimizer/FaissIVFSQ8Pass.h"
 #include "optimizer/FallbackPass.h"
+#include "optimizer/HybridSearchPass.h"
+#include "optimizer/NumaHomePass.h"
 #include "optimizer/Optimizer.h"
+#include "optimizer/ResidencyPass.h"
 #include "server/Config.h"
 
 #include <memory>
@@ -121,6 +125,17 @@ class OptimizerInst {
                     SERVER_LOG_DEBUG << search_msg;
 
                     pass_list.push_back(std::make_shared<BuildIndexPass>());
+                    // a device already holding the index wins outright: no
+                    // placement beats not copying over PCIe at all
+                    pass_list.push_back(std::make_shared<ResidencyPass>());
+                    // many-segment jobs are split across cpu and gpu in
+                    // proportion to measured per-class throughput, so a
+                    // mixed box finishes at the sum of device speeds
+                    pass_list.push_back(std::make_shared<HybridSearchPass>());
+                    // measured-cost placement takes precedence once warmed
+                    // up; it declines cold shapes, falling through to the
+                    // per-index threshold passes below
+                    pass_list.push_back(std::make_shared<CostModelPass>());
                     pass_list.push_back(std::make_shared<FaissFlatPass>());
                     pass_list.push_back(std::make_shared<FaissIVFFlatPass>());
                     pass_list.push_back(std::make_shared<FaissIVFSQ8Pass>());
@@ -130,6 +145,7 @@ class OptimizerInst {
                     pass_list.push_back(std::make_shared<FaissIVFPQPass>());
                 }
 #endif
+                pass_list.push_back(std::make_shared<NumaHomePass>());
                 pass_list.push_back(std::make_shared<FallbackPass>());
                 instance = std::make_shared<Optimizer>(pass_list);
             }
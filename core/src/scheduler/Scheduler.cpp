@@ -16,10 +16,33 @@
 #include "event/LoadCompletedEvent.h"
 
 #include <utility>
+#include <vector>
 
 namespace milvus {
 namespace scheduler {
 
+namespace {
+
+// wakeup-style events are level-triggered: their handlers look only at the
+// resource, so within one drained batch only the last event per
+// (type, resource) pair needs to run. Load-completed events carry a task
+// item each and are never coalesced.
+bool
+coalesced_away(const std::vector<EventPtr>& batch, uint64_t i) {
+    auto& event = batch[i];
+    if (event->Type() == EventType::LOAD_COMPLETED) {
+        return false;
+    }
+    for (uint64_t j = i + 1; j < batch.size(); ++j) {
+        if (batch[j] != nullptr && batch[j]->Type() == event->Type() && batch[j]->resource_ == event->resource_) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
 Scheduler::Scheduler(ResourceMgrPtr res_mgr) : running_(false), res_mgr_(std::move(res_mgr)) {
     res_mgr_->RegisterSubscriber(std::bind(&Scheduler::PostEvent, this, std::placeholders::_1));
     event_register_.insert(std::make_pair(static_cast<uint64_t>(EventType::START_UP),
@@ -44,29 +67,21 @@ Scheduler::Start() {
 
 void
 Scheduler::Stop() {
-    {
-        std::lock_guard<std::mutex> lock(event_mutex_);
-        running_ = false;
-        event_queue_.push(nullptr);
-        event_cv_.notify_one();
-    }
+    running_ = false;
+    event_ring_.put(nullptr);  // sentinel, the worker returns when it sees it
     worker_thread_.join();
 }
 
 void
 Scheduler::PostEvent(const EventPtr& event) {
-    {
-        std::lock_guard<std::mutex> lock(event_mutex_);
-        event_queue_.push(event);
-    }
-    event_cv_.notify_one();
+    event_ring_.put(event);
 }
 
 json
 Scheduler::Dump() const {
     json ret{
-        {"running", running_},
-        {"event_queue_length", event_queue_.size()},
+        {"running", running_.load()},
+        {"event_queue_length", event_ring_.size()},
     };
     return ret;
 }
@@ -79,16 +94,26 @@ Scheduler::process(const EventPtr& event) {
 
 void
 Scheduler::worker_function() {
+    std::vector<EventPtr> batch;
     while (running_) {
-        std::unique_lock<std::mutex> lock(event_mutex_);
-        event_cv_.wait(lock, [this] { return !event_queue_.empty(); });
-        auto event = event_queue_.front();
-        event_queue_.pop();
-        if (event == nullptr) {
-            break;
+        batch.clear();
+        // drain the whole ring per wakeup instead of one event per
+        // condition-variable round trip
+        if (event_ring_.TakeBatch(batch) == 0) {
+            event_ring_.WaitNonEmpty();
+            continue;
         }
 
-        process(event);
+        for (uint64_t i = 0; i < batch.size(); ++i) {
+            if (batch[i] == nullptr) {
+                return;
+            }
+            if (coalesced_away(batch, i)) {
+                continue;
+            }
+
+            process(batch[i]);
+        }
     }
 }
 
@@ -126,6 +151,10 @@ Scheduler::OnStartUp(const EventPtr& event) {
 void
 Scheduler::OnFinishTask(const EventPtr& event) {
     event->resource_->WakeupLoader();
+
+    // the resource freed an executor slot; if its queue ran dry, pull a
+    // queued task from a backlogged neighbour instead of going idle
+    Action::StealTaskFromNeighbour(event->resource_);
 }
 
 void
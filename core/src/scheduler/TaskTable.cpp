@@ -13,9 +13,11 @@
 #include "Utils.h"
 #include "event/TaskTableUpdatedEvent.h"
 #include "scheduler/SchedInst.h"
+#include "server/Config.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 
+#include <algorithm>
 #include <ctime>
 #include <sstream>
 #include <vector>
@@ -23,6 +25,20 @@
 namespace milvus {
 namespace scheduler {
 
+namespace {
+
+bool
+gang_schedule_enabled() {
+    static bool enabled = [] {
+        bool gang = true;
+        server::Config::GetInstance().GetEngineConfigGangSchedule(gang);
+        return gang;
+    }();
+    return enabled;
+}
+
+}  // namespace
+
 std::string
 ToString(TaskTableItemState state) {
     switch (state) {
@@ -122,6 +138,19 @@ TaskTableItem::Move() {
     return false;
 }
 
+bool
+TaskTableItem::Drop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (state == TaskTableItemState::START || state == TaskTableItemState::LOADED) {
+        state = TaskTableItemState::EXECUTED;
+        lock.unlock();
+        timestamp.executed = get_current_timestamp();
+        timestamp.finish = get_current_timestamp();
+        return true;
+    }
+    return false;
+}
+
 bool
 TaskTableItem::Moved() {
     std::unique_lock<std::mutex> lock(mutex);
@@ -140,6 +169,7 @@ TaskTableItem::Dump() const {
     json ret{
         {"id", id},
         {"task", (int64_t)task.get()},
+        {"task_type", task ? static_cast<int>(task->Type()) : -1},
         {"state", ToString(state)},
         {"timestamp", timestamp.Dump()},
     };
@@ -147,7 +177,7 @@ TaskTableItem::Dump() const {
 }
 
 std::vector<uint64_t>
-TaskTable::PickToLoad(uint64_t limit) {
+TaskTable::PickToLoad(uint64_t limit, uint64_t max_loaded) {
 #if 1
     TimeRecorder rc("");
     std::vector<uint64_t> indexes;
@@ -165,11 +195,19 @@ TaskTable::PickToLoad(uint64_t limit) {
         } else if (table_[index]->state == TaskTableItemState::LOADED) {
             cross = true;
             ++loaded_count;
-            if (loaded_count > 2)
+            if (loaded_count > max_loaded)
                 return std::vector<uint64_t>();
         } else if (table_[index]->state == TaskTableItemState::START) {
             auto task = table_[index]->task;
 
+            // the client gave up: spend neither I/O nor compute on it
+            if (task->Abandoned()) {
+                if (table_[index]->Drop()) {
+                    task->OnAbandoned();
+                }
+                continue;
+            }
+
             // if task is a build index task, limit it
             if (task->Type() == TaskType::BuildIndexTask && task->path().Current() == "cpu") {
                 if (BuildMgrInst::GetInstance()->NumOfAvailable() < 1) {
@@ -234,10 +272,13 @@ TaskTable::PickToLoad(uint64_t limit) {
 std::vector<uint64_t>
 TaskTable::PickToExecute(uint64_t limit) {
     TimeRecorder rc("");
-    std::vector<uint64_t> indexes;
+    // multi-level pick: a loaded interactive search is chosen ahead of any
+    // queued delete or build, regardless of arrival order, so a burst of
+    // index builds cannot delay searches on a shared resource
+    std::vector<std::vector<uint64_t>> classes(3);
     bool cross = false;
     uint64_t available_begin = table_.front() + 1;
-    for (uint64_t i = 0, pick_count = 0; i < table_.size() && pick_count < limit; ++i) {
+    for (uint64_t i = 0; i < table_.size(); ++i) {
         uint64_t index = available_begin + i;
         if (not table_[index]) {
             break;
@@ -250,8 +291,43 @@ TaskTable::PickToExecute(uint64_t limit) {
             table_.set_front(index);
         } else if (table_[index]->state == TaskTableItemState::LOADED) {
             cross = true;
+
+            // expired between load and execute: drop instead of running
+            auto task = table_[index]->task;
+            if (task->Abandoned()) {
+                if (table_[index]->Drop()) {
+                    task->OnAbandoned();
+                }
+                continue;
+            }
+
+            classes[static_cast<size_t>(task->Priority())].push_back(index);
+        }
+    }
+
+    // gang scheduling: drain earlier-admitted jobs before starting tasks of
+    // newer ones, so one query's segments finish close together instead of
+    // interleaving with other jobs -- its completion time is set by its
+    // slowest task, and interleaving inflates exactly that
+    if (gang_schedule_enabled()) {
+        auto& searches = classes[static_cast<size_t>(TaskPriority::INTERACTIVE)];
+        std::stable_sort(searches.begin(), searches.end(), [this](uint64_t a, uint64_t b) {
+            auto job_a = table_[a]->task->job_.lock();
+            auto job_b = table_[b]->task->job_.lock();
+            if (job_a == nullptr || job_b == nullptr) {
+                return false;
+            }
+            return job_a->id() < job_b->id();
+        });
+    }
+
+    std::vector<uint64_t> indexes;
+    for (auto& one_class : classes) {
+        for (auto index : one_class) {
+            if (indexes.size() >= limit) {
+                break;
+            }
             indexes.push_back(index);
-            ++pick_count;
         }
     }
     rc.ElapseFromBegin("PickToExecute ");
@@ -284,9 +360,44 @@ TaskTable::TaskToExecute() {
     return count;
 }
 
+size_t
+TaskTable::TaskToExecute(TaskPriority priority) {
+    size_t count = 0;
+    auto begin = table_.front() + 1;
+    for (size_t i = 0; i < table_.size(); ++i) {
+        auto index = begin + i;
+        if (table_[index] && table_[index]->state == TaskTableItemState::LOADED &&
+            table_[index]->task->Priority() == priority) {
+            ++count;
+        }
+    }
+    return count;
+}
+
 json
 TaskTable::Dump() const {
-    json ret{{"error.message", "not support yet."}};
+    // same lock-free walk as Digest(): items are shared pointers and their
+    // timestamps are written once per transition, so a racing read at worst
+    // reports one item with a stale state
+    json items = json::array();
+    auto& table = const_cast<CircleQueue<TaskTableItemPtr>&>(table_);
+    uint64_t begin = table.front() + 1;
+    for (uint64_t i = 0; i < table.size(); ++i) {
+        uint64_t index = begin + i;
+        auto& item = table[index];
+        if (not item) {
+            break;
+        }
+        if (index % table.capacity() == table.rear()) {
+            break;
+        }
+        items.push_back(item->Dump());
+    }
+
+    json ret{
+        {"count", items.size()},
+        {"items", items},
+    };
     return ret;
 }
 
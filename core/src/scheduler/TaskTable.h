@@ -91,6 +91,14 @@ struct TaskTableItem : public interface::dumpable {
     bool
     Moved();
 
+    /*
+     * Drop an abandoned task straight to the executed terminal state,
+     * valid from START or LOADED; called by the pick functions when the
+     * client no longer waits for the result;
+     */
+    bool
+    Drop();
+
     json
     Dump() const override;
 };
@@ -119,8 +127,16 @@ class TaskTable : public interface::dumpable {
     size_t
     TaskToExecute();
 
+    // loaded tasks of one scheduling class only, e.g. to let a running
+    // build check for waiting interactive searches
+    size_t
+    TaskToExecute(TaskPriority priority);
+
+    // max_loaded caps how many tasks may sit loaded ahead of execution; the
+    // resource's pipeline-depth controller widens it when loads run longer
+    // than executions
     std::vector<uint64_t>
-    PickToLoad(uint64_t limit);
+    PickToLoad(uint64_t limit, uint64_t max_loaded = 2);
 
     std::vector<uint64_t>
     PickToExecute(uint64_t limit);
@@ -145,6 +161,17 @@ class TaskTable : public interface::dumpable {
         return table_.size();
     }
 
+    // window of live items, for scanners outside the pick functions
+    inline uint64_t
+    front() {
+        return table_.front();
+    }
+
+    inline uint64_t
+    rear() {
+        return table_.rear();
+    }
+
  public:
     /******** Action ********/
 
@@ -0,0 +1,97 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "scheduler/ThreadGovernor.h"
+
+#include <omp.h>
+#include <algorithm>
+#include <utility>
+
+#include "metrics/Metrics.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace scheduler {
+
+ThreadGovernor::ThreadGovernor() : policy_name_("fair_share") {
+    // default policy: split the pool evenly over the active regions
+    policy_ = [](int64_t total_tokens, int64_t active_tasks) { return total_tokens / active_tasks; };
+}
+
+ThreadGovernor&
+ThreadGovernor::GetInstance() {
+    static ThreadGovernor governor;
+    return governor;
+}
+
+void
+ThreadGovernor::SetTotalTokens(int64_t total_tokens) {
+    if (total_tokens <= 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    total_tokens_ = total_tokens;
+    SERVER_LOG_DEBUG << "ThreadGovernor compute-token pool size: " << total_tokens_;
+}
+
+void
+ThreadGovernor::SetPolicy(const std::string& name, PolicyF policy) {
+    if (policy == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    policy_name_ = name;
+    policy_ = std::move(policy);
+    SERVER_LOG_DEBUG << "ThreadGovernor policy: " << policy_name_;
+}
+
+int64_t
+ThreadGovernor::Acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (total_tokens_ <= 0) {
+        // before explicit sizing, fall back to the openmp default
+        total_tokens_ = omp_get_max_threads();
+    }
+    ++active_tasks_;
+    int64_t width = policy_(total_tokens_, active_tasks_);
+    // a region never blocks waiting for tokens: it is clamped to what is
+    // left unclaimed and always granted at least one thread, so transient
+    // overshoot when the active count drops is bounded and short-lived
+    width = std::min(width, total_tokens_ - tokens_in_use_);
+    width = std::max(width, int64_t(1));
+    tokens_in_use_ += width;
+    server::Metrics::GetInstance().ActiveComputeTasksGaugeSet(static_cast<double>(active_tasks_));
+    server::Metrics::GetInstance().ComputeTokensInUseGaugeSet(static_cast<double>(tokens_in_use_));
+    return width;
+}
+
+void
+ThreadGovernor::Release(int64_t width) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tokens_in_use_ -= width;
+    --active_tasks_;
+    server::Metrics::GetInstance().ActiveComputeTasksGaugeSet(static_cast<double>(active_tasks_));
+    server::Metrics::GetInstance().ComputeTokensInUseGaugeSet(static_cast<double>(tokens_in_use_));
+}
+
+ComputeWidthGuard::ComputeWidthGuard() {
+    width_ = ThreadGovernor::GetInstance().Acquire();
+    saved_width_ = omp_get_max_threads();
+    omp_set_num_threads(width_);
+}
+
+ComputeWidthGuard::~ComputeWidthGuard() {
+    omp_set_num_threads(saved_width_);
+    ThreadGovernor::GetInstance().Release(width_);
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,97 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Central compute-token pool coordinating OpenMP width with scheduler
+ * concurrency. Faiss parallelizes each search with the process-global
+ * thread count, so when several executor threads run compute tasks at
+ * once the parallel regions oversubscribe the cores and lose throughput
+ * to context switching. Each task draws its width from this pool right
+ * before its compute region and returns it afterwards: a lone task gets
+ * the full width, concurrent tasks split it.
+ */
+class ThreadGovernor {
+ public:
+    /*
+     * Decide the OMP width of a starting compute region from the pool
+     * size and the number of active regions (the new one included);
+     * the returned width is clamped to the tokens still unclaimed;
+     */
+    using PolicyF = std::function<int64_t(int64_t total_tokens, int64_t active_tasks)>;
+
+    static ThreadGovernor&
+    GetInstance();
+
+    /*
+     * Size the pool; called at startup with the resolved omp thread count
+     * and again when engine_config.omp_thread_num is hot-reloaded;
+     */
+    void
+    SetTotalTokens(int64_t total_tokens);
+
+    void
+    SetPolicy(const std::string& name, PolicyF policy);
+
+    /*
+     * Draw a width from the pool; each Acquire must be paired with a
+     * Release of the same width, prefer ComputeWidthGuard;
+     */
+    int64_t
+    Acquire();
+
+    void
+    Release(int64_t width);
+
+ private:
+    ThreadGovernor();
+
+ private:
+    std::mutex mutex_;
+    std::string policy_name_;
+    PolicyF policy_;
+    int64_t total_tokens_ = 0;
+    int64_t tokens_in_use_ = 0;
+    int64_t active_tasks_ = 0;
+};
+
+/*
+ * Applies the granted width with omp_set_num_threads for the scope of one
+ * task's compute region and restores the executor thread's previous width
+ * on exit; omp_set_num_threads only affects the calling thread, so
+ * concurrent guards on different executor threads do not interfere;
+ */
+class ComputeWidthGuard {
+ public:
+    ComputeWidthGuard();
+    ~ComputeWidthGuard();
+
+    int64_t
+    width() const {
+        return width_;
+    }
+
+ private:
+    int64_t width_ = 0;
+    int64_t saved_width_ = 0;
+};
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -14,7 +14,11 @@
 #ifdef MILVUS_GPU_VERSION
 #include <cuda_runtime.h>
 #endif
+#ifdef __linux__
+#include <sched.h>
+#endif
 #include <chrono>
+#include <fstream>
 #include <set>
 #include <string>
 
@@ -29,5 +33,68 @@ get_current_timestamp() {
     return millis;
 }
 
+uint64_t
+numa_node_count() {
+#ifdef __linux__
+    uint64_t count = 0;
+    while (true) {
+        std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(count) + "/cpulist");
+        if (!cpulist.good()) {
+            break;
+        }
+        ++count;
+    }
+    if (count > 0) {
+        return count;
+    }
+#endif
+    return 1;
+}
+
+std::vector<uint64_t>
+numa_node_cpus(uint64_t node) {
+    std::vector<uint64_t> cpus;
+#ifdef __linux__
+    std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string range;
+    while (std::getline(cpulist, range, ',')) {
+        // ranges look like "0-15" or "32"
+        try {
+            uint64_t first = std::stoull(range);
+            uint64_t last = first;
+            auto dash = range.find('-');
+            if (dash != std::string::npos) {
+                last = std::stoull(range.substr(dash + 1));
+            }
+            for (uint64_t cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (std::exception&) {
+            cpus.clear();
+            break;
+        }
+    }
+#endif
+    return cpus;
+}
+
+bool
+bind_thread_to_numa_node(uint64_t node) {
+#ifdef __linux__
+    auto cpus = numa_node_cpus(node);
+    if (cpus.empty()) {
+        return false;
+    }
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (auto cpu : cpus) {
+        CPU_SET(cpu, &mask);
+    }
+    return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+    return false;
+#endif
+}
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -18,5 +18,16 @@ namespace scheduler {
 uint64_t
 get_current_timestamp();
 
+/* Topology helpers backed by /sys/devices/system/node. On platforms without
+ * NUMA information they degrade to a single node spanning all cores. */
+uint64_t
+numa_node_count();
+
+std::vector<uint64_t>
+numa_node_cpus(uint64_t node);
+
+bool
+bind_thread_to_numa_node(uint64_t node);
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -33,6 +33,15 @@ class Action {
     static void
     SpecifiedResourceLabelTaskScheduler(const ResourceMgrPtr& res_mgr, ResourcePtr resource,
                                         std::shared_ptr<LoadCompletedEvent> event);
+
+    /*
+     * Pull one queued search task from the busiest reachable neighbour when
+     * self's executor ran out of work, preferring the fastest connection so
+     * the migration costs the least data movement;
+     * Called on the scheduler thread when a task finishes;
+     */
+    static void
+    StealTaskFromNeighbour(const ResourcePtr& self);
 };
 
 }  // namespace scheduler
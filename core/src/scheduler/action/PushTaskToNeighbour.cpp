@@ -9,10 +9,15 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <algorithm>
 #include <list>
 #include <random>
+#include <string>
+#include <utility>
+#include <vector>
 #include "../Algorithm.h"
 #include "Action.h"
+#include "scheduler/Digest.h"
 #include "scheduler/tasklabel/SpecResLabel.h"
 #include "src/cache/GpuCacheMgr.h"
 #include "src/server/Config.h"
@@ -100,6 +105,74 @@ Action::PushTaskToResource(TaskTableItemPtr task_item, const ResourcePtr& dest)
 }
 #endif
 
+void
+Action::StealTaskFromNeighbour(const ResourcePtr& self) {
+    if (not self->HasExecutor() || self->NumOfTaskToExec() > 0) {
+        return;
+    }
+
+    // rank victims by connection speed so the cheapest migration is tried
+    // first; disk is a pure loader and never holds executable work
+    std::vector<std::pair<ResourcePtr, uint64_t>> victims;
+    for (auto& neighbour_node : self->GetNeighbours()) {
+        auto node = neighbour_node.neighbour_node;
+        if (not node)
+            continue;
+
+        auto resource = std::static_pointer_cast<Resource>(node);
+        if (resource->type() == ResourceType::DISK)
+            continue;
+
+        victims.emplace_back(resource, neighbour_node.connection.speed());
+    }
+    std::sort(victims.begin(), victims.end(),
+              [](const std::pair<ResourcePtr, uint64_t>& a, const std::pair<ResourcePtr, uint64_t>& b) {
+                  return a.second > b.second;
+              });
+
+    for (auto& victim_pair : victims) {
+        auto& victim = victim_pair.first;
+
+        // stealing the victim's only queued task would merely replace its
+        // execution with a transfer; only relieve a real backlog
+        if (victim->NumOfTaskToExec() <= 1) {
+            continue;
+        }
+
+        auto& table = victim->task_table();
+        uint64_t available_begin = table.front() + 1;
+        for (uint64_t i = 0; i < table.size(); ++i) {
+            uint64_t index = available_begin + i;
+            auto& item = table[index];
+            if (not item)
+                break;
+            if (index % table.capacity() == table.rear())
+                break;
+
+            if (item->state != TaskTableItemState::LOADED)
+                continue;
+
+            // build tasks are pinned by BuildMgr slots; only search tasks
+            // are safe to run anywhere
+            if (item->task->Type() != TaskType::SearchTask)
+                continue;
+
+            // Move() only succeeds while the item is still LOADED, so a
+            // victim executor grabbing the task concurrently wins cleanly
+            if (not item->Move())
+                continue;
+
+            // re-route: the task now terminates at self, and the usual
+            // moved-task protocol finishes the victim-side bookkeeping
+            std::vector<std::string> path{self->name()};
+            item->task->path() = Path(path, 0);
+            self->task_table().Put(item->task, item);
+            SchedCounters::steals.fetch_add(1);
+            return;  // one task per finish event; steal again if still idle
+        }
+    }
+}
+
 void
 Action::SpecifiedResourceLabelTaskScheduler(const ResourceMgrPtr& res_mgr, ResourcePtr resource,
                                             std::shared_ptr<LoadCompletedEvent> event) {
@@ -116,6 +189,7 @@ Action::SpecifiedResourceLabelTaskScheduler(const ResourceMgrPtr& res_mgr, Resou
         //        }
         event->task_table_item_->Move();
         next_res->task_table().Put(task, task_item);
+        SchedCounters::migrations.fetch_add(1);
     }
 }
 
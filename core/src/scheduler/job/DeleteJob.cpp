@@ -24,18 +24,28 @@ DeleteJob::DeleteJob(std::string table_id, engine::meta::MetaPtr meta_ptr, uint6
 }
 
 void
-DeleteJob::WaitAndDelete() {
+DeleteJob::Wait() {
     std::unique_lock<std::mutex> lock(mutex_);
     cv_.wait(lock, [&] { return done_resource == num_resource_; });
-    meta_ptr_->DeleteTableFiles(table_id_);
 }
 
 void
 DeleteJob::ResourceDone() {
+    bool all_done = false;
     {
         std::lock_guard<std::mutex> lock(mutex_);
         ++done_resource;
+        all_done = (done_resource == num_resource_);
     }
+
+    if (all_done && meta_ptr_ != nullptr) {
+        // every compute resource has passed the barrier, so no task can still
+        // reference the dropped table's files; tombstone them here on the
+        // reaper side instead of making the foreground wait for the queues to
+        // drain. The cleanup pass unlinks them later under its time budget.
+        meta_ptr_->DeleteTableFiles(table_id_);
+    }
+
     cv_.notify_one();
 }
 
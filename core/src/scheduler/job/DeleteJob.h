@@ -32,8 +32,11 @@ class DeleteJob : public Job {
     DeleteJob(std::string table_id, engine::meta::MetaPtr meta_ptr, uint64_t num_resource);
 
  public:
+    // block until every compute resource has passed the delete barrier and
+    // the table's files are tombstoned; drops no longer need this - the last
+    // ResourceDone finishes the job on its own
     void
-    WaitAndDelete();
+    Wait();
 
     void
     ResourceDone();
@@ -11,14 +11,32 @@
 
 #include "scheduler/job/SearchJob.h"
 
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include "knowhere/index/vector_index/helpers/CoarseAssignCache.h"
+#include "scheduler/task/SearchTask.h"
 #include "utils/Log.h"
 
+#ifdef MILVUS_GPU_VERSION
+#include "wrapper/gpu/GpuSearchReducer.h"
+#endif
+
 namespace milvus {
 namespace scheduler {
 
+// cap on the lock-free slot array; deposits beyond it fall back to the locked merge
+static constexpr uint64_t TREE_REDUCE_MAX_SLOTS = 64;
+
 SearchJob::SearchJob(const std::shared_ptr<server::Context>& context, uint64_t topk, uint64_t nprobe,
                      const engine::VectorsData& vectors)
-    : Job(JobType::SEARCH), context_(context), topk_(topk), nprobe_(nprobe), vectors_(vectors) {
+    : Job(JobType::SEARCH),
+      context_(context),
+      topk_(topk),
+      nprobe_(nprobe),
+      vectors_(vectors),
+      coarse_assign_cache_(std::make_shared<knowhere::CoarseAssignCache>()) {
 }
 
 bool
@@ -28,28 +46,291 @@ SearchJob::AddIndexFile(const TableFileSchemaPtr& index_file) {
         return false;
     }
 
-    SERVER_LOG_DEBUG << "SearchJob " << id() << " add index file: " << index_file->id_;
+    SERVER_LOG_DEBUG_LAZY << "SearchJob " << id() << " req=" << GetRequestID()
+                          << " add index file: " << index_file->id_;
 
     index_files_[index_file->id_] = index_file;
+    ++file_count_;
+    if (index_files_.size() > 1 && stream_callback_ == nullptr && !range_search_) {
+        // all files are added before the job is dispatched, so resizing here never
+        // races against DepositResult
+        result_slots_.resize(std::min<uint64_t>(index_files_.size(), TREE_REDUCE_MAX_SLOTS));
+    }
     return true;
 }
 
+void
+SearchJob::SetStreamCallback(const engine::SearchStreamCallback& stream_callback) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stream_callback_ = stream_callback;
+    // streaming snapshots are read from result_ids_/result_distances_, so route every
+    // task through the locked merge by dropping the slot array
+    std::vector<SearchResultSlot>().swap(result_slots_);
+}
+
+void
+SearchJob::SetRangeSearch(float radius) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    range_search_ = true;
+    radius_ = radius;
+    range_ids_.resize(nq());
+    range_distances_.resize(nq());
+    // range results are appended per query, tree reduction does not apply
+    std::vector<SearchResultSlot>().swap(result_slots_);
+}
+
+void
+SearchJob::DepositRangeResult(const std::vector<int64_t>& ids, const std::vector<float>& distances,
+                              const std::vector<size_t>& lims) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (size_t i = 0; i + 1 < lims.size() && i < range_ids_.size(); ++i) {
+        auto& query_ids = range_ids_[i];
+        auto& query_distances = range_distances_[i];
+        for (size_t j = lims[i]; j < lims[i + 1]; ++j) {
+            if (topk_ > 0 && query_ids.size() >= topk_) {
+                // topk acts as a per-query guardrail in range mode
+                break;
+            }
+            query_ids.push_back(ids[j]);
+            query_distances.push_back(distances[j]);
+        }
+    }
+}
+
+void
+SearchJob::GetRangeResult(ResultIds& ids, ResultDistances& distances, engine::ResultLims& lims) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ids.clear();
+    distances.clear();
+    lims.assign(1, 0);
+    for (size_t i = 0; i < range_ids_.size(); ++i) {
+        ids.insert(ids.end(), range_ids_[i].begin(), range_ids_[i].end());
+        distances.insert(distances.end(), range_distances_[i].begin(), range_distances_[i].end());
+        lims.push_back(ids.size());
+    }
+}
+
 void
 SearchJob::WaitResult() {
     std::unique_lock<std::mutex> lock(mutex_);
     cv_.wait(lock, [this] { return index_files_.empty(); });
-    SERVER_LOG_DEBUG << "SearchJob " << id() << " all done";
+    CombineResultSlots();
+#ifdef MILVUS_GPU_VERSION
+    ReduceGpuResults();
+#endif
+    SERVER_LOG_DEBUG_LAZY << "SearchJob " << id() << " req=" << GetRequestID() << " all done";
+}
+
+#ifdef MILVUS_GPU_VERSION
+std::shared_ptr<engine::GpuSearchReducer>
+SearchJob::GetGpuReducer(uint64_t device_id, bool ascending) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // streaming snapshots and range matches are assembled on the host per
+    // task, and a single-file job has nothing to reduce
+    if (stream_callback_ != nullptr || range_search_ || file_count_ < 2) {
+        return nullptr;
+    }
+
+    auto& reducer = gpu_reducers_[device_id];
+    if (reducer == nullptr) {
+        reducer = std::make_shared<engine::GpuSearchReducer>(device_id, nq(), topk_, ascending);
+    }
+    reduce_ascending_ = ascending;
+    return reducer;
+}
+
+void
+SearchJob::ReduceGpuResults() {
+    for (auto& kv : gpu_reducers_) {
+        auto& reducer = kv.second;
+        if (reducer == nullptr || !reducer->HasResults()) {
+            continue;
+        }
+
+        ResultIds ids;
+        ResultDistances distances;
+        auto status = reducer->Reduce(ids, distances);
+        if (!status.ok()) {
+            // the deposited segments are lost; surface the failure instead of
+            // silently returning a partial topk
+            status_ = status;
+            continue;
+        }
+
+        XSearchTask::MergeResultSet(ids, distances, topk_, topk_, vectors_.vector_count_, topk_, reduce_ascending_,
+                                    result_ids_, result_distances_);
+    }
+    gpu_reducers_.clear();
+}
+#endif
+
+bool
+SearchJob::DepositResult(ResultIds&& ids, ResultDistances&& distances, uint64_t k, bool ascending) {
+    if (result_slots_.empty()) {
+        return false;
+    }
+
+    uint64_t slot = slot_cursor_.fetch_add(1, std::memory_order_acq_rel);
+    if (slot >= result_slots_.size()) {
+        return false;
+    }
+
+    SearchResultSlot& s = result_slots_[slot];
+    s.ids_ = std::move(ids);
+    s.distances_ = std::move(distances);
+    s.stride_ = topk_;
+    s.k_ = k;
+    reduce_ascending_ = ascending;  // benign race: identical for every task of one job
+    return true;
+}
+
+void
+SearchJob::CombineResultSlots() {
+    uint64_t slot_count = std::min<uint64_t>(slot_cursor_.load(), result_slots_.size());
+    if (slot_count == 0) {
+        return;
+    }
+
+    uint64_t nq = vectors_.vector_count_;
+    bool ascending = reduce_ascending_;
+
+    std::vector<SearchResultSlot*> pending;
+    for (uint64_t i = 0; i < slot_count; i++) {
+        if (!result_slots_[i].ids_.empty()) {
+            pending.push_back(&result_slots_[i]);
+        }
+    }
+
+    // pairwise tree reduction: each level merges slot pairs in parallel, the merges of one
+    // level touch disjoint slots
+    auto merge_pair = [&](SearchResultSlot* a, SearchResultSlot* b) {
+        ResultIds ids;
+        ResultDistances distances;
+        XSearchTask::MergeResultSet(a->ids_, a->distances_, a->stride_, a->k_, nq, topk_, ascending, ids, distances);
+        XSearchTask::MergeResultSet(b->ids_, b->distances_, b->stride_, b->k_, nq, topk_, ascending, ids, distances);
+        a->ids_.swap(ids);
+        a->distances_.swap(distances);
+        a->stride_ = a->k_ = a->ids_.size() / nq;
+        ResultIds().swap(b->ids_);
+        ResultDistances().swap(b->distances_);
+    };
+
+    while (pending.size() > 1) {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i + 1 < pending.size(); i += 2) {
+            threads.emplace_back(merge_pair, pending[i], pending[i + 1]);
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        std::vector<SearchResultSlot*> next_level;
+        for (size_t i = 0; i < pending.size(); i += 2) {
+            next_level.push_back(pending[i]);
+        }
+        pending.swap(next_level);
+    }
+
+    // fold the tree root into the job result, which may already hold merges from tasks
+    // that overflowed the slot array
+    SearchResultSlot* root = pending.front();
+    XSearchTask::MergeResultSet(root->ids_, root->distances_, root->stride_, root->k_, nq, topk_, ascending,
+                                result_ids_, result_distances_);
+
+    std::vector<SearchResultSlot>().swap(result_slots_);
+}
+
+void
+SearchJob::TaskStarted(size_t index_id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // when a speculative twin starts, keep the original's start so the
+    // monitor still sees the straggler's true elapsed time
+    running_tasks_.emplace(index_id, std::chrono::steady_clock::now());
+}
+
+bool
+SearchJob::ClaimResult(size_t index_id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return index_files_.find(index_id) != index_files_.end() && claimed_files_.insert(index_id).second;
+}
+
+void
+SearchJob::PickStragglers(std::vector<TableFileSchemaPtr>& stragglers) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // only the job's tail qualifies: with fewer than 90% of files done a slow
+    // task is backlog, not a straggler
+    if (index_files_.empty() || index_files_.size() * 10 > file_count_) {
+        return;
+    }
+
+    // range matches are appended rather than claimed-and-merged, so a twin
+    // would double-count its segment
+    if (range_search_) {
+        return;
+    }
+#ifdef MILVUS_GPU_VERSION
+    // a segment reduced into a device reducer cannot be withdrawn when its
+    // twin wins the claim, so reducer jobs are never cloned
+    if (!gpu_reducers_.empty()) {
+        return;
+    }
+#endif
+
+    std::vector<double> sorted = task_durations_ms_;
+    if (sorted.empty()) {
+        return;
+    }
+    std::sort(sorted.begin(), sorted.end());
+    double p95 = sorted[(sorted.size() - 1) * 95 / 100];
+
+    auto now = std::chrono::steady_clock::now();
+    for (auto& running : running_tasks_) {
+        auto file = index_files_.find(running.first);
+        if (file == index_files_.end() || speculated_files_.find(running.first) != speculated_files_.end()) {
+            continue;
+        }
+        double elapsed_ms = std::chrono::duration<double, std::milli>(now - running.second).count();
+        if (elapsed_ms > p95) {
+            speculated_files_.insert(running.first);
+            stragglers.push_back(file->second);
+        }
+    }
+}
+
+bool
+SearchJob::IsSpeculated(size_t index_id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return speculated_files_.find(index_id) != speculated_files_.end();
 }
 
 void
 SearchJob::SearchDone(size_t index_id) {
     std::unique_lock<std::mutex> lock(mutex_);
-    index_files_.erase(index_id);
+    auto iter = index_files_.find(index_id);
+    if (iter == index_files_.end()) {
+        // a speculative twin already finished this file; nothing left to do
+        return;
+    }
+    index_files_.erase(iter);
+
+    auto running = running_tasks_.find(index_id);
+    if (running != running_tasks_.end()) {
+        task_durations_ms_.push_back(
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - running->second).count());
+        running_tasks_.erase(running);
+    }
+
+    if (stream_callback_ != nullptr && status_.ok()) {
+        // the finishing task merged its top-k into the job result before calling here,
+        // both under mutex_, so this snapshot is consistent
+        stream_callback_(file_count_ - index_files_.size(), file_count_, result_ids_, result_distances_);
+    }
+
     if (index_files_.empty()) {
         cv_.notify_all();
     }
 
-    SERVER_LOG_DEBUG << "SearchJob " << id() << " finish index file: " << index_id;
+    SERVER_LOG_DEBUG_LAZY << "SearchJob " << id() << " req=" << GetRequestID() << " finish index file: " << index_id;
 }
 
 ResultIds&
@@ -84,5 +365,11 @@ SearchJob::GetContext() const {
     return context_;
 }
 
+const std::string&
+SearchJob::GetRequestID() const {
+    static const std::string empty;
+    return context_ != nullptr ? context_->GetRequestID() : empty;
+}
+
 }  // namespace scheduler
 }  // namespace milvus
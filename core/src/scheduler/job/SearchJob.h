@@ -10,12 +10,15 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <set>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -28,6 +31,18 @@
 
 #include "server/context/Context.h"
 
+#ifdef MILVUS_GPU_VERSION
+namespace milvus {
+namespace engine {
+class GpuSearchReducer;
+}  // namespace engine
+}  // namespace milvus
+#endif
+
+namespace knowhere {
+class CoarseAssignCache;
+}
+
 namespace milvus {
 namespace scheduler {
 
@@ -38,6 +53,14 @@ using Id2IndexMap = std::unordered_map<size_t, TableFileSchemaPtr>;
 using ResultIds = engine::ResultIds;
 using ResultDistances = engine::ResultDistances;
 
+// one segment's raw top-k buffer, deposited by a search task when tree reduction is on
+struct SearchResultSlot {
+    ResultIds ids_;
+    ResultDistances distances_;
+    uint64_t stride_ = 0;
+    uint64_t k_ = 0;
+};
+
 class SearchJob : public Job {
  public:
     SearchJob(const std::shared_ptr<server::Context>& context, uint64_t topk, uint64_t nprobe,
@@ -53,6 +76,83 @@ class SearchJob : public Job {
     void
     SearchDone(size_t index_id);
 
+    // Mark the segment's compute as started; SearchDone() turns the pair into a completed
+    // task duration. Feeds the straggler detection in PickStragglers().
+    void
+    TaskStarted(size_t index_id);
+
+    // First-finisher election between a task and its speculative twin: true exactly once
+    // per still-pending file. A task merges its result and calls SearchDone() only after
+    // winning the claim; the loser discards silently.
+    bool
+    ClaimResult(size_t index_id);
+
+    // Straggler probe for the JobMgr monitor. Once over 90% of the job's files are done,
+    // returns the files whose running task has exceeded the P95 of the completed task
+    // times, each at most once, so the monitor can clone them onto an idle resource.
+    void
+    PickStragglers(std::vector<TableFileSchemaPtr>& stragglers);
+
+    // True once PickStragglers() cloned this file. Twins must merge through the
+    // claimed host path, never through a device reducer the claim cannot reach.
+    bool
+    IsSpeculated(size_t index_id);
+
+    // Deposit one segment's top-k buffer into the lock-free slot array. Returns false when
+    // tree reduction is off or all slots are taken; the caller then falls back to merging
+    // under mutex(). The deposited buffers are combined pairwise in parallel in WaitResult().
+    bool
+    DepositResult(ResultIds&& ids, ResultDistances&& distances, uint64_t k, bool ascending);
+
+    // Request a partial-result snapshot after each index file finishes. Streaming disables
+    // tree reduction: every task merges into the job result under mutex() so SearchDone()
+    // always sees the top-k over the files searched so far. Only call before dispatch.
+    void
+    SetStreamCallback(const engine::SearchStreamCallback& stream_callback);
+
+    // Switch the job to range mode before dispatch: tasks call the engine's RangeSearch
+    // with `radius` and append every match per query instead of merging top-k. A non-zero
+    // topk acts as a per-query cap on the number of matches kept.
+    void
+    SetRangeSearch(float radius);
+
+    bool
+    IsRangeSearch() const {
+        return range_search_;
+    }
+
+    float
+    radius() const {
+        return radius_;
+    }
+
+    // append one segment's range matches; lims has nq+1 entries
+    void
+    DepositRangeResult(const std::vector<int64_t>& ids, const std::vector<float>& distances,
+                       const std::vector<size_t>& lims);
+
+    // flat per-query concatenation of all segment matches, valid after WaitResult()
+    void
+    GetRangeResult(ResultIds& ids, ResultDistances& distances, engine::ResultLims& lims);
+
+#ifdef MILVUS_GPU_VERSION
+    // One reducer per GPU the job's tasks land on, created lazily. Tasks that
+    // share a device search straight into the reducer's device slots and
+    // WaitResult() folds the device-side topk into the job result; the host
+    // merge never sees those segments. Returns nullptr when the job cannot
+    // use device reduction (streaming, range mode, single file).
+    std::shared_ptr<engine::GpuSearchReducer>
+    GetGpuReducer(uint64_t device_id, bool ascending);
+#endif
+
+    // shared query→centroid rankings for the job's IVF segments: with
+    // per-table quantizer reuse the segments carry identical centroids, so
+    // the first task computes the nq×nprobe ranking and the rest replay it
+    knowhere::CoarseAssignCache*
+    GetCoarseAssignCache() {
+        return coarse_assign_cache_.get();
+    }
+
     ResultIds&
     GetResultIds();
 
@@ -69,6 +169,11 @@ class SearchJob : public Job {
     const std::shared_ptr<server::Context>&
     GetContext() const;
 
+    // request id of the originating client call; empty when the job was built
+    // without a server context (some unit tests do this)
+    const std::string&
+    GetRequestID() const;
+
     uint64_t
     topk() const {
         return topk_;
@@ -84,6 +189,23 @@ class SearchJob : public Job {
         return nprobe_;
     }
 
+    // QoS hook: lower the effective nprobe under overload instead of
+    // rejecting the request; recall degrades gracefully while the engine
+    // scans proportionally fewer inverted lists. Only call before dispatch.
+    void
+    DegradeNprobe(uint64_t divisor) {
+        if (divisor > 1 && nprobe_ > 1) {
+            auto degraded = nprobe_ / divisor;
+            nprobe_ = degraded > 0 ? degraded : 1;
+            degraded_ = true;
+        }
+    }
+
+    bool
+    IsDegraded() const {
+        return degraded_;
+    }
+
     const engine::VectorsData&
     vectors() const {
         return vectors_;
@@ -99,20 +221,66 @@ class SearchJob : public Job {
         return mutex_;
     }
 
+    // moment the job was constructed, used to attribute scheduler queue wait
+    // to the request's latency profile
+    std::chrono::steady_clock::time_point
+    EnqueueTime() const {
+        return enqueue_time_;
+    }
+
+ private:
+    void
+    CombineResultSlots();
+
+#ifdef MILVUS_GPU_VERSION
+    void
+    ReduceGpuResults();
+#endif
+
  private:
     const std::shared_ptr<server::Context> context_;
 
+    const std::chrono::steady_clock::time_point enqueue_time_ = std::chrono::steady_clock::now();
+
     uint64_t topk_ = 0;
     uint64_t nprobe_ = 0;
+    bool degraded_ = false;
     // TODO: smart pointer
     const engine::VectorsData& vectors_;
 
     Id2IndexMap index_files_;
+    uint64_t file_count_ = 0;
+    std::shared_ptr<knowhere::CoarseAssignCache> coarse_assign_cache_;
     // TODO: column-base better ?
     ResultIds result_ids_;
     ResultDistances result_distances_;
     Status status_;
 
+    engine::SearchStreamCallback stream_callback_;
+
+    // range-mode state, set in SetRangeSearch before the job is dispatched
+    bool range_search_ = false;
+    float radius_ = 0.0f;
+    std::vector<std::vector<int64_t>> range_ids_;
+    std::vector<std::vector<float>> range_distances_;
+
+    // tree-reduction state, sized in AddIndexFile before the job is dispatched
+    std::vector<SearchResultSlot> result_slots_;
+    std::atomic<uint64_t> slot_cursor_{0};
+    bool reduce_ascending_ = true;
+
+#ifdef MILVUS_GPU_VERSION
+    // device-side reduction state, keyed by gpu id; drained in WaitResult()
+    std::unordered_map<uint64_t, std::shared_ptr<engine::GpuSearchReducer>> gpu_reducers_;
+#endif
+
+    // speculative-execution state: per-file compute start times, completed task
+    // durations feeding the P95, merge claims, and files already cloned once
+    std::unordered_map<size_t, std::chrono::steady_clock::time_point> running_tasks_;
+    std::vector<double> task_durations_ms_;
+    std::set<size_t> claimed_files_;
+    std::set<size_t> speculated_files_;
+
     std::mutex mutex_;
     std::condition_variable cv_;
 };
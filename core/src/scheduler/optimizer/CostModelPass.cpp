@@ -0,0 +1,90 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#include "scheduler/optimizer/CostModelPass.h"
+#include "scheduler/CostModel.h"
+#include "scheduler/SchedInst.h"
+#include "scheduler/task/SearchTask.h"
+#include "scheduler/tasklabel/SpecResLabel.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace scheduler {
+
+void
+CostModelPass::Init() {
+#ifdef MILVUS_GPU_VERSION
+    server::Config& config = server::Config::GetInstance();
+    Status s = config.GetGpuResourceConfigSearchResources(gpus);
+    if (!s.ok()) {
+        throw std::exception();
+    }
+#endif
+}
+
+bool
+CostModelPass::Run(const TaskPtr& task) {
+    if (task->Type() != TaskType::SearchTask) {
+        return false;
+    }
+
+    auto search_task = std::static_pointer_cast<XSearchTask>(task);
+    auto search_job = std::static_pointer_cast<SearchJob>(search_task->job_.lock());
+    if (search_job == nullptr || search_task->file_ == nullptr) {
+        return false;
+    }
+
+    std::vector<ResourcePtr> candidates;
+    candidates.push_back(ResMgrInst::GetInstance()->GetResource("cpu"));
+    for (auto gpu_id : gpus) {
+        candidates.push_back(ResMgrInst::GetInstance()->GetResource(ResourceType::GPU, gpu_id));
+    }
+
+    auto& model = CostModel::GetInstance();
+    ResourcePtr best_res = nullptr;
+    uint64_t best_cost = 0;
+    for (auto& res : candidates) {
+        if (res == nullptr || !res->HasExecutor()) {
+            continue;
+        }
+
+        uint64_t cost_ms = 0;
+        if (!model.Estimate(search_task->file_->engine_type_, search_job->nq(), search_job->topk(),
+                            search_task->file_->file_size_, res->name(), cost_ms)) {
+            // an unmeasured candidate: decline, so the static threshold
+            // passes decide and their placements produce the missing samples
+            return false;
+        }
+
+        // the task waits behind everything already queued on the resource
+        uint64_t queue_ms = res->NumOfTaskToExec() * res->TaskAvgCost();
+        uint64_t total_ms = cost_ms + queue_ms;
+        if (best_res == nullptr || total_ms < best_cost) {
+            best_res = res;
+            best_cost = total_ms;
+        }
+    }
+
+    if (best_res == nullptr) {
+        return false;
+    }
+
+    SERVER_LOG_DEBUG << "CostModelPass: specify " << best_res->name() << " to search, predicted cost " << best_cost
+                     << "ms";
+    auto label = std::make_shared<SpecResLabel>(best_res);
+    task->label() = label;
+    return true;
+}
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
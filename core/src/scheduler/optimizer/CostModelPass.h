@@ -0,0 +1,50 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Pass.h"
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Places search tasks on the resource with the lowest predicted completion
+ * time, combining the CostModel's measured latency with the current queue
+ * depth of each candidate. Runs before the per-index-type threshold passes
+ * and declines (falls through to them) whenever any candidate lacks enough
+ * measurements for the task's shape, so placements made by the static rules
+ * warm the model up.
+ */
+class CostModelPass : public Pass {
+ public:
+    CostModelPass() = default;
+
+ public:
+    void
+    Init() override;
+
+    bool
+    Run(const TaskPtr& task) override;
+
+ private:
+    std::vector<int64_t> gpus;
+};
+
+using CostModelPassPtr = std::shared_ptr<CostModelPass>;
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
@@ -33,6 +33,13 @@ FaissFlatPass::Init() {
     if (!s.ok()) {
         throw std::exception();
     }
+
+    // keep the cached threshold in sync with runtime config changes
+    config.RegisterCallBack(server::CONFIG_ENGINE, server::CONFIG_ENGINE_GPU_SEARCH_THRESHOLD, "FaissFlatPass",
+                            [this](const std::string& value) {
+                                threshold_ = std::stoll(value);
+                                return Status::OK();
+                            });
 }
 
 bool
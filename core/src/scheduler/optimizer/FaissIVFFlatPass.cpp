@@ -33,6 +33,13 @@ FaissIVFFlatPass::Init() {
     if (!s.ok()) {
         throw std::exception();
     }
+
+    // keep the cached threshold in sync with runtime config changes
+    config.RegisterCallBack(server::CONFIG_ENGINE, server::CONFIG_ENGINE_GPU_SEARCH_THRESHOLD, "FaissIVFFlatPass",
+                            [this](const std::string& value) {
+                                threshold_ = std::stoll(value);
+                                return Status::OK();
+                            });
 #endif
 }
 
@@ -35,6 +35,13 @@ FaissIVFPQPass::Init() {
     if (!s.ok()) {
         throw std::exception();
     }
+
+    // keep the cached threshold in sync with runtime config changes
+    config.RegisterCallBack(server::CONFIG_ENGINE, server::CONFIG_ENGINE_GPU_SEARCH_THRESHOLD, "FaissIVFPQPass",
+                            [this](const std::string& value) {
+                                threshold_ = std::stoll(value);
+                                return Status::OK();
+                            });
 #endif
 }
 
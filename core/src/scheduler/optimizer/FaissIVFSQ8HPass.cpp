@@ -30,6 +30,13 @@ FaissIVFSQ8HPass::Init() {
         threshold_ = std::numeric_limits<int64_t>::max();
     }
     s = config.GetGpuResourceConfigSearchResources(gpus);
+
+    // keep the cached threshold in sync with runtime config changes
+    config.RegisterCallBack(server::CONFIG_ENGINE, server::CONFIG_ENGINE_GPU_SEARCH_THRESHOLD, "FaissIVFSQ8HPass",
+                            [this](const std::string& value) {
+                                threshold_ = std::stoll(value);
+                                return Status::OK();
+                            });
 #endif
 }
 
@@ -0,0 +1,119 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#include "scheduler/optimizer/HybridSearchPass.h"
+
+#include <utility>
+
+#include "scheduler/CostModel.h"
+#include "scheduler/SchedInst.h"
+#include "scheduler/task/SearchTask.h"
+#include "scheduler/tasklabel/SpecResLabel.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace scheduler {
+
+constexpr uint64_t HybridSearchPass::MIN_JOB_TASKS;
+
+void
+HybridSearchPass::Init() {
+#ifdef MILVUS_GPU_VERSION
+    server::Config& config = server::Config::GetInstance();
+    Status s = config.GetGpuResourceConfigSearchResources(gpus);
+    if (!s.ok()) {
+        throw std::exception();
+    }
+#endif
+}
+
+bool
+HybridSearchPass::Run(const TaskPtr& task) {
+    if (task->Type() != TaskType::SearchTask) {
+        return false;
+    }
+
+    auto search_task = std::static_pointer_cast<XSearchTask>(task);
+    auto search_job = std::static_pointer_cast<SearchJob>(search_task->job_.lock());
+    if (search_job == nullptr || search_task->file_ == nullptr) {
+        return false;
+    }
+
+    // small jobs cannot keep two device classes busy; let the cost model or
+    // the threshold passes place them whole
+    if (search_job->index_files().size() < MIN_JOB_TASKS) {
+        return false;
+    }
+
+    // candidate set: cpu plus every search gpu with measured throughput for
+    // this index type. Splitting needs both classes represented, otherwise
+    // there is nothing to cooperate between.
+    auto& model = CostModel::GetInstance();
+    int32_t engine_type = search_task->file_->engine_type_;
+    std::vector<std::pair<ResourcePtr, double>> candidates;
+    bool has_gpu = false;
+
+    auto add_candidate = [&](const ResourcePtr& res) {
+        double bytes_per_ms = 0.0;
+        if (res != nullptr && res->HasExecutor() && model.EstimateThroughput(engine_type, res->name(), bytes_per_ms)) {
+            candidates.emplace_back(res, bytes_per_ms);
+            return true;
+        }
+        return false;
+    };
+
+    bool has_cpu = add_candidate(ResMgrInst::GetInstance()->GetResource("cpu"));
+    for (auto gpu_id : gpus) {
+        has_gpu |= add_candidate(ResMgrInst::GetInstance()->GetResource(ResourceType::GPU, gpu_id));
+    }
+    if (!has_cpu || !has_gpu) {
+        return false;
+    }
+
+    double total_weight = 0.0;
+    for (auto& candidate : candidates) {
+        total_weight += candidate.second;
+    }
+
+    // weighted round-robin: every task grants each resource its share of
+    // credit, the richest resource takes the task and pays one full task
+    ResourcePtr dest;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // finished jobs leave their credit entry behind; job ids increase
+        // monotonically, so everything far below the current id is stale
+        auto stale_end = jobs_.lower_bound(search_job->id() > 64 ? search_job->id() - 64 : 0);
+        jobs_.erase(jobs_.begin(), stale_end);
+
+        auto& split = jobs_[search_job->id()];
+        double best_credit = 0.0;
+        for (auto& candidate : candidates) {
+            double& credit = split.credit[candidate.first->name()];
+            credit += candidate.second / total_weight;
+            if (dest == nullptr || credit > best_credit) {
+                dest = candidate.first;
+                best_credit = credit;
+            }
+        }
+        split.credit[dest->name()] -= 1.0;
+    }
+
+    SERVER_LOG_DEBUG << "HybridSearchPass: job " << search_job->id() << " task -> " << dest->name();
+    auto label = std::make_shared<SpecResLabel>(dest);
+    task->label() = label;
+    return true;
+}
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
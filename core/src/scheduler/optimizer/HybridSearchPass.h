@@ -0,0 +1,70 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Pass.h"
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Cooperative CPU+GPU splitting for large search jobs. The threshold passes
+ * route a whole job to one device class, so during a many-segment query the
+ * faster class finishes its share and idles while the other grinds on. This
+ * pass partitions a job's tasks across cpu and the search gpus proportional
+ * to the CostModel's measured per-device throughput for the job's index
+ * type (weighted round-robin over the job), so a mixed box finishes at the
+ * sum of device speeds. Engages only for jobs with at least MIN_JOB_TASKS
+ * segments and once cpu plus at least one gpu have measured throughput;
+ * otherwise it declines and the passes below decide. Estimate error is
+ * corrected mid-job by the idle-resource work stealing in
+ * Action::StealTaskFromNeighbour.
+ */
+class HybridSearchPass : public Pass {
+ public:
+    HybridSearchPass() = default;
+
+ public:
+    void
+    Init() override;
+
+    bool
+    Run(const TaskPtr& task) override;
+
+ private:
+    static constexpr uint64_t MIN_JOB_TASKS = 8;
+
+    std::vector<int64_t> gpus;
+
+    // weighted-round-robin credit per resource, kept per job so the split
+    // ratio holds over the job's whole task set
+    struct JobSplit {
+        std::unordered_map<std::string, double> credit;
+    };
+
+    std::mutex mutex_;
+    std::map<uint64_t, JobSplit> jobs_;
+};
+
+using HybridSearchPassPtr = std::shared_ptr<HybridSearchPass>;
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
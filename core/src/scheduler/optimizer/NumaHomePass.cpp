@@ -0,0 +1,67 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "scheduler/optimizer/NumaHomePass.h"
+#include "scheduler/SchedInst.h"
+#include "scheduler/task/SearchTask.h"
+#include "scheduler/tasklabel/SpecResLabel.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace scheduler {
+
+std::mutex NumaHomePass::home_mutex_;
+std::unordered_map<uint64_t, uint64_t> NumaHomePass::home_nodes_;
+
+void
+NumaHomePass::Init() {
+}
+
+void
+NumaHomePass::RecordHome(uint64_t file_id, uint64_t node) {
+    if (ResMgrInst::GetInstance()->GetCpuResources().size() <= 1) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(home_mutex_);
+    home_nodes_[file_id] = node;
+}
+
+bool
+NumaHomePass::Run(const TaskPtr& task) {
+    if (task->Type() != TaskType::SearchTask) {
+        return false;
+    }
+
+    auto& cpus = ResMgrInst::GetInstance()->GetCpuResources();
+    if (cpus.size() <= 1) {
+        return false;
+    }
+
+    auto search_task = std::static_pointer_cast<XSearchTask>(task);
+    auto file_id = static_cast<uint64_t>(search_task->file_->id_);
+
+    uint64_t node = file_id % cpus.size();
+    {
+        std::lock_guard<std::mutex> lock(home_mutex_);
+        auto iter = home_nodes_.find(file_id);
+        if (iter != home_nodes_.end()) {
+            node = iter->second;
+        }
+    }
+
+    SERVER_LOG_DEBUG << "NumaHomePass: file " << file_id << " assigned to numa node " << node;
+    auto label = std::make_shared<SpecResLabel>(cpus[node]);
+    task->label() = label;
+    return true;
+}
+
+}  // namespace scheduler
+}  // namespace milvus
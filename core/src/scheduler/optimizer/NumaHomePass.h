@@ -0,0 +1,51 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "Pass.h"
+
+namespace milvus {
+namespace scheduler {
+
+// Routes every search task to the NUMA node that holds its segment. Segments
+// already loaded follow their recorded home node; unseen segments are spread
+// across the nodes by a stable hash of the file id, so every later load of the
+// same segment lands on the same node. No-op on single-node hosts.
+class NumaHomePass : public Pass {
+ public:
+    NumaHomePass() = default;
+
+ public:
+    void
+    Init() override;
+
+    bool
+    Run(const TaskPtr& task) override;
+
+    // remember which NUMA node actually loaded a segment, so later searches of a
+    // still-cached segment follow its memory
+    static void
+    RecordHome(uint64_t file_id, uint64_t node);
+
+ private:
+    static std::mutex home_mutex_;
+    static std::unordered_map<uint64_t, uint64_t> home_nodes_;
+};
+
+using NumaHomePassPtr = std::shared_ptr<NumaHomePass>;
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,69 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#include "scheduler/optimizer/ResidencyPass.h"
+#include "cache/GpuCacheMgr.h"
+#include "scheduler/SchedInst.h"
+#include "scheduler/task/SearchTask.h"
+#include "scheduler/tasklabel/SpecResLabel.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace scheduler {
+
+void
+ResidencyPass::Init() {
+#ifdef MILVUS_GPU_VERSION
+    server::Config& config = server::Config::GetInstance();
+    Status s = config.GetGpuResourceConfigSearchResources(gpus);
+    if (!s.ok()) {
+        throw std::exception();
+    }
+#endif
+}
+
+bool
+ResidencyPass::Run(const TaskPtr& task) {
+    if (task->Type() != TaskType::SearchTask) {
+        return false;
+    }
+
+    auto search_task = std::static_pointer_cast<XSearchTask>(task);
+    if (search_task->file_ == nullptr) {
+        return false;
+    }
+
+    // the engine caches a device copy under the file location, so cache
+    // membership is exactly the residency registry
+    for (auto gpu_id : gpus) {
+        if (not cache::GpuCacheMgr::GetInstance(gpu_id)->ItemExists(search_task->file_->location_)) {
+            continue;
+        }
+
+        auto res_ptr = ResMgrInst::GetInstance()->GetResource(ResourceType::GPU, gpu_id);
+        if (res_ptr == nullptr) {
+            continue;
+        }
+
+        SERVER_LOG_DEBUG << "ResidencyPass: index of file " << search_task->file_->id_ << " resident on gpu" << gpu_id
+                         << ", keep it there";
+        auto label = std::make_shared<SpecResLabel>(res_ptr);
+        task->label() = label;
+        return true;
+    }
+
+    return false;
+}
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
@@ -0,0 +1,48 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+#ifdef MILVUS_GPU_VERSION
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Pass.h"
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Affinity-aware placement: a search task whose index is already resident
+ * in one of the search gpus' caches is pinned to that device, so repeated
+ * queries against the same segment stop ping-ponging index copies over
+ * PCIe. Runs ahead of the cost-model and threshold passes; declines when
+ * no gpu holds the index.
+ */
+class ResidencyPass : public Pass {
+ public:
+    ResidencyPass() = default;
+
+ public:
+    void
+    Init() override;
+
+    bool
+    Run(const TaskPtr& task) override;
+
+ private:
+    std::vector<int64_t> gpus;
+};
+
+using ResidencyPassPtr = std::shared_ptr<ResidencyPass>;
+
+}  // namespace scheduler
+}  // namespace milvus
+#endif
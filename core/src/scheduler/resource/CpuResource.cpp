@@ -10,7 +10,13 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/resource/CpuResource.h"
+#include "scheduler/ThreadGovernor.h"
+#include "scheduler/Utils.h"
+#include "server/Config.h"
+#include "utils/Log.h"
 
+#include <algorithm>
+#include <thread>
 #include <utility>
 
 namespace milvus {
@@ -24,15 +30,62 @@ operator<<(std::ostream& out, const CpuResource& resource) {
 
 CpuResource::CpuResource(std::string name, uint64_t device_id, bool enable_executor)
     : Resource(std::move(name), ResourceType::CPU, device_id, enable_executor) {
+    server::Config& config = server::Config::GetInstance();
+    int64_t pool_size = 0;
+    if (config.GetEngineConfigSearchTaskPoolSize(pool_size).ok() && pool_size > 1) {
+        // cap the pool so that pool_size * omp threads does not exceed physical cores,
+        // otherwise executor threads fight with openmp threads inside faiss
+        int64_t omp_thread = 0;
+        config.GetEngineConfigOmpThreadNum(omp_thread);
+        int64_t cores = std::thread::hardware_concurrency();
+        if (omp_thread > 0 && cores > 0) {
+            pool_size = std::min(pool_size, std::max(int64_t(1), cores / omp_thread));
+        }
+        SERVER_LOG_DEBUG << "CpuResource " << name_ << " executor pool size: " << pool_size;
+        SetExecutorNum(pool_size);
+    }
+
+    // loaders are I/O bound, so their width is not capped against cores; the
+    // pipeline-depth controller bounds how far they run ahead of execution
+    int64_t load_pool_size = 0;
+    if (config.GetEngineConfigLoadTaskPoolSize(load_pool_size).ok() && load_pool_size > 1) {
+        SERVER_LOG_DEBUG << "CpuResource " << name_ << " loader pool size: " << load_pool_size;
+        SetLoaderNum(load_pool_size);
+    }
+}
+
+void
+CpuResource::SetNumaNode(int64_t numa_node) {
+    numa_node_ = numa_node;
+}
+
+void
+CpuResource::BindCurrentThread() {
+    // loader and executor threads belong to exactly one resource, so binding once
+    // per thread is enough
+    static thread_local bool bound = false;
+    if (bound || numa_node_ < 0) {
+        return;
+    }
+    if (bind_thread_to_numa_node(static_cast<uint64_t>(numa_node_))) {
+        SERVER_LOG_DEBUG << "CpuResource " << name_ << " thread bound to numa node " << numa_node_;
+    }
+    bound = true;
 }
 
 void
 CpuResource::LoadFile(TaskPtr task) {
-    task->Load(LoadType::DISK2CPU, 0);
+    BindCurrentThread();
+    task->Load(LoadType::DISK2CPU, static_cast<uint8_t>(device_id_));
+    AddLoaderIOBytes(task->FileSize());
 }
 
 void
 CpuResource::Process(TaskPtr task) {
+    BindCurrentThread();
+    // draw the openmp width for this task from the shared compute-token
+    // pool so concurrent tasks do not oversubscribe the cores
+    ComputeWidthGuard width_guard;
     task->Execute();
 }
 
@@ -25,12 +25,24 @@ class CpuResource : public Resource {
     friend std::ostream&
     operator<<(std::ostream& out, const CpuResource& resource);
 
+    // restrict the loader and executor threads of this resource to one NUMA node, so
+    // index memory is first-touched on the node that later searches it
+    void
+    SetNumaNode(int64_t numa_node);
+
  protected:
     void
     LoadFile(TaskPtr task) override;
 
     void
     Process(TaskPtr task) override;
+
+ private:
+    void
+    BindCurrentThread();
+
+ private:
+    int64_t numa_node_ = -1;
 };
 
 }  // namespace scheduler
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/resource/GpuResource.h"
+#include "cache/GpuMemoryBroker.h"
 
 namespace milvus {
 namespace scheduler {
@@ -26,12 +27,21 @@ GpuResource::GpuResource(std::string name, uint64_t device_id, bool enable_execu
 
 void
 GpuResource::LoadFile(TaskPtr task) {
+#ifdef MILVUS_GPU_VERSION
+    // hold the load until the device can take the task's working set, so a
+    // concurrent build and search defer instead of failing inside cudaMalloc
+    cache::GpuMemoryBroker::GetInstance(device_id_)->WaitReserve(task->GpuMemoryEstimate());
+#endif
     task->Load(LoadType::CPU2GPU, device_id_);
+    AddLoaderIOBytes(task->FileSize());
 }
 
 void
 GpuResource::Process(TaskPtr task) {
     task->Execute();
+#ifdef MILVUS_GPU_VERSION
+    cache::GpuMemoryBroker::GetInstance(device_id_)->Release(task->GpuMemoryEstimate());
+#endif
 }
 
 }  // namespace scheduler
@@ -10,9 +10,13 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/resource/Resource.h"
+#include "scheduler/CostModel.h"
 #include "scheduler/SchedInst.h"
 #include "scheduler/Utils.h"
 
+#include <algorithm>
+#include <cmath>
+#include <ctime>
 #include <iostream>
 #include <limits>
 #include <utility>
@@ -47,29 +51,50 @@ Resource::Resource(std::string name, ResourceType type, uint64_t device_id, bool
     // register subscriber in tasktable
     task_table_.RegisterSubscriber([&] {
         if (subscriber_) {
-            auto event = std::make_shared<TaskTableUpdatedEvent>(shared_from_this());
-            subscriber_(std::static_pointer_cast<Event>(event));
+            if (table_updated_event_) {
+                subscriber_(table_updated_event_);
+            } else {
+                // before Start() the cached instance does not exist yet
+                auto event = std::make_shared<TaskTableUpdatedEvent>(shared_from_this());
+                subscriber_(std::static_pointer_cast<Event>(event));
+            }
         }
     });
 }
 
 void
 Resource::Start() {
+    // shared_from_this() is unusable in the constructor, so the cached
+    // event is created here, before any scheduling thread runs
+    table_updated_event_ = std::make_shared<TaskTableUpdatedEvent>(shared_from_this());
     running_ = true;
-    loader_thread_ = std::thread(&Resource::loader_function, this);
+    for (uint64_t i = 0; i < loader_num_; ++i) {
+        loader_threads_.emplace_back(&Resource::loader_function, this);
+    }
     if (enable_executor_) {
-        executor_thread_ = std::thread(&Resource::executor_function, this);
+        for (uint64_t i = 0; i < executor_num_; ++i) {
+            executor_threads_.emplace_back(&Resource::executor_function, this);
+        }
     }
 }
 
 void
 Resource::Stop() {
-    running_ = false;
-    WakeupLoader();
-    loader_thread_.join();
+    {
+        std::lock_guard<std::mutex> lock(exec_mutex_);
+        running_ = false;
+    }
+    load_cv_.notify_all();
+    for (auto& loader_thread : loader_threads_) {
+        loader_thread.join();
+    }
+    loader_threads_.clear();
     if (enable_executor_) {
-        WakeupExecutor();
-        executor_thread_.join();
+        exec_cv_.notify_all();
+        for (auto& executor_thread : executor_threads_) {
+            executor_thread.join();
+        }
+        executor_threads_.clear();
     }
 }
 
@@ -98,10 +123,16 @@ Resource::Dump() const {
         {"name", name_},
         {"type", ToString(type_)},
         {"task_average_cost", TaskAvgCost()},
-        {"task_total_cost", total_cost_},
-        {"total_tasks", total_task_},
+        {"task_total_cost", total_cost_.load()},
+        {"total_tasks", total_task_.load()},
         {"running", running_},
         {"enable_executor", enable_executor_},
+        {"executor_num", executor_num_},
+        {"loader_num", loader_num_},
+        {"pipeline_depth", PipelineDepth()},
+        {"load_average_cost", LoadAvgCost()},
+        {"executor_cpu_seconds", ExecutorCpuSeconds()},
+        {"loader_io_bytes", LoaderIOBytes()},
     };
     return ret;
 }
@@ -111,13 +142,37 @@ Resource::NumOfTaskToExec() {
     return task_table_.TaskToExecute();
 }
 
+uint64_t
+Resource::PipelineDepth() const {
+    constexpr uint64_t MIN_DEPTH = 2;  // the former hardcoded look-ahead
+    constexpr uint64_t MAX_DEPTH = 16;
+    auto load_tasks = total_load_task_.load();
+    auto exec_tasks = total_task_.load();
+    auto exec_cost = total_cost_.load();
+    if (load_tasks == 0 || exec_tasks == 0 || exec_cost == 0) {
+        return MIN_DEPTH;
+    }
+    // enough in flight to cover one load per executor plus the load/execute
+    // imbalance; compute-bound resources stay at the minimum
+    double avg_load = static_cast<double>(total_load_cost_.load()) / load_tasks;
+    double avg_exec = static_cast<double>(exec_cost) / exec_tasks;
+    auto depth = static_cast<uint64_t>(std::ceil(avg_load / avg_exec)) + executor_num_;
+    return std::min(std::max(depth, MIN_DEPTH), MAX_DEPTH);
+}
+
 TaskTableItemPtr
 Resource::pick_task_load() {
-    auto indexes = task_table_.PickToLoad(10);
-    for (auto index : indexes) {
+    auto indexes = task_table_.PickToLoad(10, PipelineDepth());
+    for (size_t i = 0; i < indexes.size(); ++i) {
         // try to set one task loading, then return
-        if (task_table_.Load(index))
-            return task_table_.at(index);
+        if (task_table_.Load(indexes[i])) {
+            // hint the next queued candidates so their files are read from disk
+            // while this task is loaded and executed
+            for (size_t next = i + 1; next < indexes.size() && next < i + 3; ++next) {
+                task_table_[indexes[next]]->task->Prefetch();
+            }
+            return task_table_.at(indexes[i]);
+        }
         // else try next
     }
     return nullptr;
@@ -155,7 +210,7 @@ void
 Resource::loader_function() {
     while (running_) {
         std::unique_lock<std::mutex> lock(load_mutex_);
-        load_cv_.wait(lock, [&] { return load_flag_; });
+        load_cv_.wait(lock, [&] { return load_flag_ || !running_; });
         load_flag_ = false;
         lock.unlock();
         while (true) {
@@ -167,7 +222,11 @@ Resource::loader_function() {
                 BuildMgrInst::GetInstance()->Take();
                 SERVER_LOG_DEBUG << name() << " load BuildIndexTask";
             }
+            auto start = get_current_timestamp();
             LoadFile(task_item->task);
+            auto finish = get_current_timestamp();
+            ++total_load_task_;
+            total_load_cost_ += finish - start;
             task_item->Loaded();
             if (task_item->from) {
                 task_item->from->Moved();
@@ -183,13 +242,15 @@ Resource::loader_function() {
 
 void
 Resource::executor_function() {
-    if (subscriber_) {
-        auto event = std::make_shared<StartUpEvent>(shared_from_this());
-        subscriber_(std::static_pointer_cast<Event>(event));
-    }
+    std::call_once(startup_once_, [&] {
+        if (subscriber_) {
+            auto event = std::make_shared<StartUpEvent>(shared_from_this());
+            subscriber_(std::static_pointer_cast<Event>(event));
+        }
+    });
     while (running_) {
         std::unique_lock<std::mutex> lock(exec_mutex_);
-        exec_cv_.wait(lock, [&] { return exec_flag_; });
+        exec_cv_.wait(lock, [&] { return exec_flag_ || !running_; });
         exec_flag_ = false;
         lock.unlock();
         while (true) {
@@ -198,10 +259,25 @@ Resource::executor_function() {
                 break;
             }
             auto start = get_current_timestamp();
+            timespec cpu_begin, cpu_end;
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_begin);
             Process(task_item->task);
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_end);
             auto finish = get_current_timestamp();
             ++total_task_;
             total_cost_ += finish - start;
+            executor_cpu_ns_ += static_cast<uint64_t>(cpu_end.tv_sec - cpu_begin.tv_sec) * 1000000000ULL +
+                                cpu_end.tv_nsec - cpu_begin.tv_nsec;
+
+            if (task_item->task->Type() == TaskType::SearchTask) {
+                auto search_task = std::static_pointer_cast<XSearchTask>(task_item->task);
+                auto search_job = std::static_pointer_cast<SearchJob>(search_task->job_.lock());
+                if (search_job != nullptr && search_task->file_ != nullptr) {
+                    CostModel::GetInstance().Observe(search_task->file_->engine_type_, search_job->nq(),
+                                                     search_job->topk(), search_task->file_->file_size_, name(),
+                                                     finish - start);
+                }
+            }
 
             task_item->Executed();
 
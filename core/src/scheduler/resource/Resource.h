@@ -11,9 +11,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <utility>
@@ -108,23 +110,83 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
     // TODO(wxyu): need double ?
     inline uint64_t
     TaskAvgCost() const {
-        if (total_task_ == 0) {
+        if (total_task_.load() == 0) {
             return 0;
         }
-        return total_cost_ / total_task_;
+        return total_cost_.load() / total_task_.load();
     }
 
     inline uint64_t
     TotalTasks() const {
-        return total_task_;
+        return total_task_.load();
     }
 
+    /*
+     * Cumulative CPU seconds burned by this resource's executor threads while
+     * processing tasks; node-wide CPU percent blurs all resources together,
+     * the cost model and autoscaling need the per-resource share;
+     */
+    inline double
+    ExecutorCpuSeconds() const {
+        return static_cast<double>(executor_cpu_ns_.load()) / 1e9;
+    }
+
+    /*
+     * Cumulative bytes this resource's loader moved onto it (disk reads for a
+     * cpu resource, PCIe copies for a gpu resource);
+     */
+    inline uint64_t
+    LoaderIOBytes() const {
+        return loader_io_bytes_.load();
+    }
+
+    inline uint64_t
+    LoadAvgCost() const {
+        if (total_load_task_.load() == 0) {
+            return 0;
+        }
+        return total_load_cost_.load() / total_load_task_.load();
+    }
+
+    /*
+     * Number of tasks the loaders keep loaded ahead of execution, derived from
+     * the observed load/execute time ratio: I/O-bound workloads (loads longer
+     * than executions) get a deeper pipeline so executors never starve, while
+     * compute-bound ones stay at the minimum to bound memory held by loaded
+     * but unexecuted tasks;
+     */
+    uint64_t
+    PipelineDepth() const;
+
     friend std::ostream&
     operator<<(std::ostream& out, const Resource& resource);
 
  protected:
     Resource(std::string name, ResourceType type, uint64_t device_id, bool enable_executor);
 
+    /*
+     * Set number of executor threads, only valid before Start();
+     * Default is 1, keeping tasks on this resource sequential;
+     */
+    void
+    SetExecutorNum(uint64_t executor_num) {
+        if (executor_num > 0) {
+            executor_num_ = executor_num;
+        }
+    }
+
+    /*
+     * Set number of loader threads, only valid before Start();
+     * Default is 1; more loaders overlap I/O requests of independent tasks,
+     * which hides per-request latency on disks that serve reads concurrently;
+     */
+    void
+    SetLoaderNum(uint64_t loader_num) {
+        if (loader_num > 0) {
+            loader_num_ = loader_num;
+        }
+    }
+
     /*
      * Implementation by inherit class;
      * Blocking function;
@@ -139,6 +201,14 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
     virtual void
     Process(TaskPtr task) = 0;
 
+    /*
+     * Called by LoadFile implementations that actually copy data;
+     */
+    inline void
+    AddLoaderIOBytes(uint64_t bytes) {
+        loader_io_bytes_ += bytes;
+    }
+
  private:
     /*
      * Pick one task to load;
@@ -156,13 +226,17 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
 
  private:
     /*
-     * Only called by load thread;
+     * Called by each loader thread;
+     * Task state transition inside TaskTableItem guarantees each task is
+     * loaded only once when several loaders pick concurrently;
      */
     void
     loader_function();
 
     /*
-     * Only called by worker thread;
+     * Called by each executor thread;
+     * Multiple threads pick tasks concurrently, task state transition
+     * inside TaskTableItem guarantees each task executed only once;
      */
     void
     executor_function();
@@ -176,15 +250,26 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
 
     TaskTable task_table_;
 
-    uint64_t total_cost_ = 0;
-    uint64_t total_task_ = 0;
+    std::atomic<uint64_t> total_cost_{0};
+    std::atomic<uint64_t> total_task_{0};
+    std::atomic<uint64_t> total_load_cost_{0};
+    std::atomic<uint64_t> total_load_task_{0};
+    std::atomic<uint64_t> executor_cpu_ns_{0};
+    std::atomic<uint64_t> loader_io_bytes_{0};
 
     std::function<void(EventPtr)> subscriber_ = nullptr;
 
+    // reusable table-updated event: its payload is just this resource, so
+    // one cached instance avoids an allocation per task transition
+    EventPtr table_updated_event_ = nullptr;
+
     bool running_ = false;
     bool enable_executor_ = true;
-    std::thread loader_thread_;
-    std::thread executor_thread_;
+    uint64_t executor_num_ = 1;
+    uint64_t loader_num_ = 1;
+    std::vector<std::thread> loader_threads_;
+    std::vector<std::thread> executor_threads_;
+    std::once_flag startup_once_;
 
     bool load_flag_ = false;
     bool exec_flag_ = false;
@@ -10,14 +10,21 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "scheduler/task/BuildIndexTask.h"
+#include "db/AttrSidecar.h"
+#include "db/DeleteSidecar.h"
+#include "db/SegmentSizeTuner.h"
 #include "db/engine/EngineFactory.h"
 #include "metrics/Metrics.h"
+#include "scheduler/SchedInst.h"
 #include "scheduler/job/BuildIndexJob.h"
+#include "storage/file/FileIOUtil.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
+#include "utils/MallocUtil.h"
 #include "utils/TimeRecorder.h"
 
 #include <fiu-local.h>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <thread>
@@ -26,6 +33,11 @@
 namespace milvus {
 namespace scheduler {
 
+namespace {
+constexpr int64_t PREEMPTION_POLL_MS = 100;
+constexpr int64_t PREEMPTION_MAX_WAIT_MS = 10 * 1000;
+}  // namespace
+
 XBuildIndexTask::XBuildIndexTask(TableFileSchemaPtr file, TaskLabelPtr label)
     : Task(TaskType::BuildIndexTask, std::move(label)), file_(file) {
     if (file_) {
@@ -92,6 +104,31 @@ XBuildIndexTask::Load(milvus::scheduler::LoadType type, uint8_t device_id) {
     }
 }
 
+int64_t
+XBuildIndexTask::GpuMemoryEstimate() const {
+    // raw vectors plus the index under construction live on the device at
+    // the same time during a build
+    return file_ ? static_cast<int64_t>(file_->file_size_) * 2 : 0;
+}
+
+void
+XBuildIndexTask::YieldToPendingSearch() {
+    auto resource = ResMgrInst::GetInstance()->GetResource(path().Last());
+    if (resource == nullptr) {
+        return;
+    }
+
+    int64_t waited_ms = 0;
+    while (resource->task_table().TaskToExecute(TaskPriority::INTERACTIVE) > 0 &&
+           waited_ms < PREEMPTION_MAX_WAIT_MS) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(PREEMPTION_POLL_MS));
+        waited_ms += PREEMPTION_POLL_MS;
+    }
+    if (waited_ms > 0) {
+        ENGINE_LOG_DEBUG << "Build index task yielded " << waited_ms << "ms to pending search tasks";
+    }
+}
+
 void
 XBuildIndexTask::Execute() {
     if (to_index_engine_ == nullptr) {
@@ -111,6 +148,9 @@ XBuildIndexTask::Execute() {
         table_file.table_id_ = file_->table_id_;
         table_file.date_ = file_->date_;
         table_file.file_type_ = engine::meta::TableFileSchema::NEW_INDEX;
+        // link the index row to its raw source, so a later rolling index
+        // upgrade can retire exactly the index file this build supersedes
+        table_file.source_file_id_ = file_->file_id_;
 
         engine::meta::MetaPtr meta_ptr = build_index_job->meta();
         Status status = meta_ptr->CreateTableFile(table_file);
@@ -124,13 +164,22 @@ XBuildIndexTask::Execute() {
         }
 
         // step 3: build index
+        // preemption checkpoint: the build itself may run for many minutes,
+        // so drain any waiting searches before occupying the cores
+        YieldToPendingSearch();
         try {
             ENGINE_LOG_DEBUG << "Begin build index for file:" + table_file.location_;
+            auto build_start = std::chrono::steady_clock::now();
             index = to_index_engine_->BuildIndex(table_file.location_, (EngineType)table_file.engine_type_);
             fiu_do_on("XBuildIndexTask.Execute.build_index_fail", index = nullptr);
             if (index == nullptr) {
                 throw Exception(DB_ERROR, "index NULL");
             }
+            // feed the adaptive merge policy: observed build throughput caps
+            // how large it lets this table's segments grow
+            double build_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - build_start).count();
+            engine::SegmentSizeTuner::GetInstance().RecordBuild(file_->table_id_, static_cast<double>(file_->file_size_),
+                                                                build_seconds);
         } catch (std::exception& ex) {
             std::string msg = "Build index exception: " + std::string(ex.what());
             ENGINE_LOG_ERROR << msg;
@@ -160,6 +209,8 @@ XBuildIndexTask::Execute() {
         }
 
         // step 5: save index file
+        // preemption checkpoint between the build and serialize phases
+        YieldToPendingSearch();
         try {
             fiu_do_on("XBuildIndexTask.Execute.throw_std_exception", throw std::exception());
             status = index->Serialize();
@@ -189,6 +240,36 @@ XBuildIndexTask::Execute() {
             return;
         }
 
+        // an indexed segment holds the same rows as its origin, so the
+        // attribute sidecar (if any) is duplicated to the new location; the
+        // origin keeps its own copy until file GC reclaims it
+        if (engine::AttrSidecar::Exists(file_->location_)) {
+            engine::IDNumbers attr_ids;
+            engine::AttributeColumns attr_columns;
+            auto attr_status = engine::AttrSidecar::Read(file_->location_, attr_ids, attr_columns);
+            if (attr_status.ok()) {
+                attr_status = engine::AttrSidecar::Write(table_file.location_, attr_ids, attr_columns);
+            }
+            if (!attr_status.ok()) {
+                ENGINE_LOG_ERROR << "Failed to copy attribute sidecar to index file " << table_file.file_id_ << ": "
+                                 << attr_status.ToString();
+            }
+        }
+
+        // the delete sidecar travels the same way, so tombstones laid down
+        // while the index was building still mask the indexed copy
+        if (engine::DeleteSidecar::Exists(file_->location_)) {
+            engine::IDNumbers deleted_ids;
+            auto del_status = engine::DeleteSidecar::Read(file_->location_, deleted_ids);
+            if (del_status.ok()) {
+                del_status = engine::DeleteSidecar::Append(table_file.location_, deleted_ids);
+            }
+            if (!del_status.ok()) {
+                ENGINE_LOG_ERROR << "Failed to copy delete sidecar to index file " << table_file.file_id_ << ": "
+                                 << del_status.ToString();
+            }
+        }
+
         // step 6: update meta
         table_file.file_type_ = engine::meta::TableFileSchema::INDEX;
         table_file.file_size_ = index->PhysicalSize();
@@ -211,11 +292,27 @@ XBuildIndexTask::Execute() {
             if (build_index_job->options().insert_cache_immediately_) {
                 index->Cache();
             }
+
+            // neither file's pages earn their keep: the raw input is
+            // superseded by the index just built, and the serialized output
+            // was write-only here. Hand the page cache back to the CpuCacheMgr.
+            storage::DropFilePageCache(file_->location_);
+            storage::DropFilePageCache(table_file.location_);
+
+            if (file_->file_type_ == engine::meta::TableFileSchema::TO_UPGRADE) {
+                // rolling upgrade cutover: the replacement is live, retire the
+                // index file that served this segment under the old type
+                status = meta_ptr->RetireSupersededIndexFile(table_file);
+                if (!status.ok()) {
+                    ENGINE_LOG_ERROR << "Failed to retire superseded index file of source " << file_->file_id_ << ": "
+                                     << status.ToString();
+                }
+            }
         } else {
-            // failed to update meta, mark the new file as to_delete, don't delete old file
-            origin_file.file_type_ = engine::meta::TableFileSchema::TO_INDEX;
+            // failed to update meta, revert the origin file, don't delete old file
+            origin_file.file_type_ = file_->file_type_;
             status = meta_ptr->UpdateTableFile(origin_file);
-            ENGINE_LOG_DEBUG << "Failed to update file to index, mark file: " << origin_file.file_id_ << " to to_index";
+            ENGINE_LOG_DEBUG << "Failed to update file to index, revert file: " << origin_file.file_id_;
 
             table_file.file_type_ = engine::meta::TableFileSchema::TO_DELETE;
             status = meta_ptr->UpdateTableFile(table_file);
@@ -229,6 +326,11 @@ XBuildIndexTask::Execute() {
     rc.ElapseFromBegin("totally cost");
 
     to_index_engine_ = nullptr;
+
+    // the freed training buffers stay cached in this thread's arena and
+    // inflate RSS for the rest of the process lifetime; hand them back now
+    // so query-path arenas are unaffected by gigabyte-scale build churn
+    server::MallocUtil::PurgeHeap();
 }
 
 }  // namespace scheduler
@@ -28,6 +28,24 @@ class XBuildIndexTask : public Task {
     void
     Execute() override;
 
+    int64_t
+    GpuMemoryEstimate() const override;
+
+    int64_t
+    FileSize() const override {
+        return file_ == nullptr ? 0 : file_->file_size_;
+    }
+
+ private:
+    /*
+     * Cooperative preemption checkpoint, called between the expensive
+     * phases of Execute: while interactive searches are queued on this
+     * task's resource, pause (bounded) so they are not starved of cpu
+     * by a long-running build;
+     */
+    void
+    YieldToPendingSearch();
+
  public:
     TableFileSchemaPtr file_;
     TableFileSchema table_file_;
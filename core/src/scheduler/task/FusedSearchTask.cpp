@@ -0,0 +1,180 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "scheduler/task/FusedSearchTask.h"
+#include "db/IdIndex.h"
+#include "metrics/Metrics.h"
+#include "scheduler/SchedInst.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace scheduler {
+
+bool
+XFusedSearchTask::Abandoned() const {
+    bool any_live = false;
+    for (auto& weak_job : fused_jobs_) {
+        auto job = weak_job.lock();
+        if (job == nullptr) {
+            continue;
+        }
+        any_live = true;
+        auto& context = std::static_pointer_cast<SearchJob>(job)->GetContext();
+        if (context == nullptr || (!context->IsCancelled() && !context->IsTimeExceeded())) {
+            return false;
+        }
+    }
+    return any_live;
+}
+
+void
+XFusedSearchTask::OnAbandoned() {
+    for (auto& weak_job : fused_jobs_) {
+        if (auto job = weak_job.lock()) {
+            auto search_job = std::static_pointer_cast<SearchJob>(job);
+            search_job->GetStatus() = Status(SERVER_UNEXPECTED_ERROR, "search dropped: client deadline exceeded");
+            search_job->SearchDone(file_->id_);
+        }
+    }
+}
+
+void
+XFusedSearchTask::Execute() {
+    if (index_engine_ == nullptr) {
+        return;
+    }
+
+    TimeRecorder rc("DoFusedSearch file id:" + std::to_string(index_id_));
+
+    server::CollectDurationMetrics metrics(index_type_);
+
+    // step 1: collect the still-live parent jobs; all share topk and nprobe
+    // by construction of the fusion key
+    std::vector<SearchJobPtr> jobs;
+    uint64_t total_nq = 0;
+    uint64_t topk = 0;
+    uint64_t nprobe = 0;
+    for (auto& weak_job : fused_jobs_) {
+        auto job = weak_job.lock();
+        if (job == nullptr) {
+            continue;
+        }
+        auto search_job = std::static_pointer_cast<SearchJob>(job);
+        search_job->TaskStarted(index_id_);
+        jobs.push_back(search_job);
+        total_nq += search_job->nq();
+        topk = search_job->topk();
+        nprobe = search_job->nprobe();
+    }
+    if (jobs.empty()) {
+        ReleaseEngine();
+        return;
+    }
+
+    // step 2: concatenate the queries; fusion only groups float queries
+    uint64_t dim = file_->dimension_;
+    std::vector<float> batch(total_nq * dim);
+    uint64_t offset = 0;
+    for (auto& job : jobs) {
+        memcpy(batch.data() + offset * dim, job->vectors().FloatData(), job->nq() * dim * sizeof(float));
+        offset += job->nq();
+    }
+
+    std::vector<int64_t> output_ids(total_nq * topk);
+    std::vector<float> output_distance(total_nq * topk);
+
+    try {
+        // step 3: one engine call for the whole batch
+        bool hybrid = false;
+        if (index_engine_->IndexEngineType() == engine::EngineType::FAISS_IVFSQ8H &&
+            ResMgrInst::GetInstance()->GetResource(path().Last())->type() == ResourceType::CPU) {
+            hybrid = true;
+        }
+        Status s = index_engine_->Search(total_nq, batch.data(), topk, nprobe, output_distance.data(),
+                                         output_ids.data(), hybrid);
+        if (!s.ok()) {
+            for (auto& job : jobs) {
+                job->GetStatus() = s;
+                job->SearchDone(index_id_);
+            }
+            ReleaseEngine();
+            return;
+        }
+
+        rc.RecordSection("fused " + std::to_string(jobs.size()) + " jobs, nq " + std::to_string(total_nq) +
+                         ", do search");
+
+        // lazily drop upsert-superseded hits, same as the single-job path
+        auto& id_index = engine::IdIndex::GetInstance();
+        if (id_index.HasTombstones(file_->table_id_)) {
+            const float worst_distance =
+                ascending_reduce ? std::numeric_limits<float>::max() : -std::numeric_limits<float>::max();
+            for (size_t i = 0; i < output_ids.size(); i++) {
+                if (output_ids[i] < 0) {
+                    continue;
+                }
+                int64_t mark_time = id_index.SupersededTime(file_->table_id_, output_ids[i]);
+                if (mark_time != 0 && file_->created_on_ < mark_time) {
+                    output_ids[i] = -1;
+                    output_distance[i] = worst_distance;
+                }
+            }
+        }
+
+        // step 4: scatter result rows back to their parent jobs
+        auto spec_k = index_engine_->Count() < topk ? index_engine_->Count() : topk;
+        offset = 0;
+        for (auto& job : jobs) {
+            uint64_t nq = job->nq();
+            // a speculative twin may have finished this file for one of the
+            // parent jobs while the batch ran; that job's slice is dropped
+            if (!job->ClaimResult(index_id_)) {
+                offset += nq;
+                continue;
+            }
+            scheduler::ResultIds slice_ids(output_ids.begin() + offset * topk,
+                                           output_ids.begin() + (offset + nq) * topk);
+            scheduler::ResultDistances slice_distances(output_distance.begin() + offset * topk,
+                                                       output_distance.begin() + (offset + nq) * topk);
+            {
+                std::unique_lock<std::mutex> lock(job->mutex());
+                XSearchTask::MergeTopkToResultSet(slice_ids, slice_distances, spec_k, nq, topk, ascending_reduce,
+                                                  job->GetResultIds(), job->GetResultDistances(),
+                                                  job->GetContext()->GetMemoryAccountant().get());
+            }
+            job->SearchDone(index_id_);
+            offset += nq;
+        }
+
+        rc.RecordSection("scatter results to " + std::to_string(jobs.size()) + " jobs");
+    } catch (std::exception& ex) {
+        ENGINE_LOG_ERROR << "FusedSearchTask encounter exception: " << ex.what();
+        for (auto& job : jobs) {
+            job->GetStatus() = Status(SERVER_UNEXPECTED_ERROR, ex.what());
+            job->SearchDone(index_id_);
+        }
+    }
+
+    rc.ElapseFromBegin("totally cost");
+
+    // release index in resource
+    ReleaseEngine();
+}
+
+}  // namespace scheduler
+}  // namespace milvus
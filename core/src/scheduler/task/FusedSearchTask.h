@@ -0,0 +1,56 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "SearchTask.h"
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * One search task serving several jobs that target the same segment.
+ * JobMgr fuses compatible per-job tasks (same file, topk, nprobe, float
+ * queries) dispatched in the same batch: the index is loaded once and all
+ * queries go through a single engine call as one concatenated nq batch,
+ * whose result rows are scattered back to their parent jobs afterwards.
+ * Everything but Execute is inherited from the single-job task.
+ */
+class XFusedSearchTask : public XSearchTask {
+ public:
+    XFusedSearchTask(const std::shared_ptr<server::Context>& context, TableFileSchemaPtr file, TaskLabelPtr label)
+        : XSearchTask(context, std::move(file), std::move(label)) {
+    }
+
+    void
+    Execute() override;
+
+    // a fused task serves several clients: it only counts as abandoned
+    // when every live parent has given up
+    bool
+    Abandoned() const override;
+
+    void
+    OnAbandoned() override;
+
+ public:
+    // parent jobs in concatenation order; the first one is also job_
+    std::vector<JobWPtr> fused_jobs_;
+};
+
+using XFusedSearchTaskPtr = std::shared_ptr<XFusedSearchTask>;
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -11,17 +11,36 @@
 
 #include <fiu-local.h>
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <string>
 #include <thread>
+#include <unordered_set>
 #include <utility>
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <faiss/impl/AuxIndexStructures.h>
+
+#include "cache/CpuCacheMgr.h"
+#include "db/AttrSidecar.h"
+#include "db/DeleteSidecar.h"
+#include "db/IdIndex.h"
 #include "db/engine/EngineFactory.h"
+#include "db/engine/EngineHandleCache.h"
 #include "metrics/Metrics.h"
 #include "scheduler/SchedInst.h"
 #include "scheduler/job/SearchJob.h"
+#include "scheduler/optimizer/NumaHomePass.h"
 #include "scheduler/task/SearchTask.h"
+#include "utils/CommonUtil.h"
 #include "utils/Log.h"
+#include "utils/Profiler.h"
 #include "utils/TimeRecorder.h"
 
 namespace milvus {
@@ -30,48 +49,212 @@ namespace scheduler {
 static constexpr size_t PARALLEL_REDUCE_THRESHOLD = 10000;
 static constexpr size_t PARALLEL_REDUCE_BATCH = 1000;
 
-// TODO(wxyu): remove unused code
-// bool
-// NeedParallelReduce(uint64_t nq, uint64_t topk) {
-//    server::ServerConfig &config = server::ServerConfig::GetInstance();
-//    server::ConfigNode &db_config = config.GetConfig(server::CONFIG_DB);
-//    bool need_parallel = db_config.GetBoolValue(server::CONFIG_DB_PARALLEL_REDUCE, false);
-//    if (!need_parallel) {
-//        return false;
-//    }
-//
-//    return nq * topk >= PARALLEL_REDUCE_THRESHOLD;
-//}
-//
-// void
-// ParallelReduce(std::function<void(size_t, size_t)> &reduce_function, size_t max_index) {
-//    size_t reduce_batch = PARALLEL_REDUCE_BATCH;
-//
-//    auto thread_count = std::thread::hardware_concurrency() - 1; //not all core do this work
-//    if (thread_count > 0) {
-//        reduce_batch = max_index / thread_count + 1;
-//    }
-//    ENGINE_LOG_DEBUG << "use " << thread_count <<
-//                     " thread parallelly do reduce, each thread process " << reduce_batch << " vectors";
-//
-//    std::vector<std::shared_ptr<std::thread> > thread_array;
-//    size_t from_index = 0;
-//    while (from_index < max_index) {
-//        size_t to_index = from_index + reduce_batch;
-//        if (to_index > max_index) {
-//            to_index = max_index;
-//        }
-//
-//        auto reduce_thread = std::make_shared<std::thread>(reduce_function, from_index, to_index);
-//        thread_array.push_back(reduce_thread);
-//
-//        from_index = to_index;
-//    }
-//
-//    for (auto &thread_ptr : thread_array) {
-//        thread_ptr->join();
-//    }
-//}
+// metric label for the engine type of the searched segment
+static const char*
+EngineTypeLabel(engine::EngineType type) {
+    switch (type) {
+        case engine::EngineType::FAISS_IDMAP:
+            return "IDMAP";
+        case engine::EngineType::FAISS_IVFFLAT:
+            return "IVFFLAT";
+        case engine::EngineType::FAISS_IVFSQ8:
+            return "IVFSQ8";
+        case engine::EngineType::NSG_MIX:
+            return "NSG";
+        case engine::EngineType::FAISS_IVFSQ8H:
+            return "IVFSQ8H";
+        case engine::EngineType::FAISS_PQ:
+            return "PQ";
+        case engine::EngineType::FAISS_PQ_FS:
+            return "PQ_FS";
+        case engine::EngineType::SPTAG_KDT:
+            return "SPTAG_KDT";
+        case engine::EngineType::SPTAG_BKT:
+            return "SPTAG_BKT";
+        case engine::EngineType::FAISS_BIN_IDMAP:
+            return "BIN_IDMAP";
+        case engine::EngineType::FAISS_BIN_IVFFLAT:
+            return "BIN_IVFFLAT";
+        case engine::EngineType::HNSW:
+            return "HNSW";
+        case engine::EngineType::FAISS_IDMAP_SQ8:
+            return "IDMAP_SQ8";
+        case engine::EngineType::FAISS_IDMAP_FP16:
+            return "IDMAP_FP16";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+bool
+NeedParallelReduce(uint64_t nq, uint64_t topk) {
+    return nq * topk >= PARALLEL_REDUCE_THRESHOLD;
+}
+
+void
+ParallelReduce(const std::function<void(size_t, size_t)>& reduce_function, size_t max_index) {
+    size_t reduce_batch = PARALLEL_REDUCE_BATCH;
+
+    auto thread_count = std::thread::hardware_concurrency() - 1;  // not all core do this work
+    if (thread_count > 0) {
+        reduce_batch = max_index / thread_count + 1;
+    }
+    ENGINE_LOG_DEBUG_LAZY << "use " << thread_count << " thread parallelly do reduce, each thread process "
+                          << reduce_batch << " vectors";
+
+    std::vector<std::shared_ptr<std::thread>> thread_array;
+    size_t from_index = 0;
+    while (from_index < max_index) {
+        size_t to_index = std::min(from_index + reduce_batch, max_index);
+        thread_array.push_back(std::make_shared<std::thread>(reduce_function, from_index, to_index));
+        from_index = to_index;
+    }
+
+    for (auto& thread_ptr : thread_array) {
+        thread_ptr->join();
+    }
+}
+
+/* Count how many leading elements of distances[0, n) win against bound, so the merge can copy
+ * whole runs instead of branching element by element. `strict` selects < / > versus <= / >= ,
+ * which keeps the tie-breaking rule of the scalar merge (ties go to the target list). */
+static size_t
+CountLeadingRunRef(const float* distances, size_t n, float bound, bool ascending, bool strict) {
+    size_t i = 0;
+    if (ascending) {
+        if (strict) {
+            while (i < n && distances[i] < bound) i++;
+        } else {
+            while (i < n && distances[i] <= bound) i++;
+        }
+    } else {
+        if (strict) {
+            while (i < n && distances[i] > bound) i++;
+        } else {
+            while (i < n && distances[i] >= bound) i++;
+        }
+    }
+    return i;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) static size_t
+CountLeadingRunAVX2(const float* distances, size_t n, float bound, bool ascending, bool strict) {
+    size_t i = 0;
+    __m256 vb = _mm256_set1_ps(bound);
+    for (; i + 8 <= n; i += 8) {
+        __m256 vd = _mm256_loadu_ps(distances + i);
+        __m256 cmp;
+        if (ascending) {
+            cmp = strict ? _mm256_cmp_ps(vd, vb, _CMP_LT_OQ) : _mm256_cmp_ps(vd, vb, _CMP_LE_OQ);
+        } else {
+            cmp = strict ? _mm256_cmp_ps(vd, vb, _CMP_GT_OQ) : _mm256_cmp_ps(vd, vb, _CMP_GE_OQ);
+        }
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(cmp));
+        if (mask != 0xFF) {
+            return i + __builtin_ctz(~mask);
+        }
+    }
+    return i + CountLeadingRunRef(distances + i, n - i, bound, ascending, strict);
+}
+
+__attribute__((target("avx512f"))) static size_t
+CountLeadingRunAVX512(const float* distances, size_t n, float bound, bool ascending, bool strict) {
+    size_t i = 0;
+    __m512 vb = _mm512_set1_ps(bound);
+    for (; i + 16 <= n; i += 16) {
+        __m512 vd = _mm512_loadu_ps(distances + i);
+        __mmask16 mask;
+        if (ascending) {
+            mask = strict ? _mm512_cmp_ps_mask(vd, vb, _CMP_LT_OQ) : _mm512_cmp_ps_mask(vd, vb, _CMP_LE_OQ);
+        } else {
+            mask = strict ? _mm512_cmp_ps_mask(vd, vb, _CMP_GT_OQ) : _mm512_cmp_ps_mask(vd, vb, _CMP_GE_OQ);
+        }
+        if (mask != 0xFFFF) {
+            return i + __builtin_ctz(~static_cast<uint32_t>(mask));
+        }
+    }
+    return i + CountLeadingRunRef(distances + i, n - i, bound, ascending, strict);
+}
+#endif
+
+using RunCounter = size_t (*)(const float*, size_t, float, bool, bool);
+
+static RunCounter
+GetRunCounter() {
+    static RunCounter counter = []() -> RunCounter {
+#if defined(__x86_64__)
+        if (__builtin_cpu_supports("avx512f")) {
+            return &CountLeadingRunAVX512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return &CountLeadingRunAVX2;
+        }
+#endif
+        return &CountLeadingRunRef;
+    }();
+    return counter;
+}
+
+/* Compile-time specialized merge of one query's rows: the sort direction and the
+ * k size-class are template parameters, so the per-element comparison carries no
+ * runtime direction branch (the ternaries compile to conditional moves) and the
+ * staging buffers live on the stack. Both rows get a sentinel appended, which
+ * removes the exhaustion branches from the merge loop. Requires src_k, tar_k and
+ * buf_k all <= KClass; MergeResultSet dispatches once per merge and falls back
+ * to the run-based path for larger k. */
+template <bool Ascending, size_t KClass>
+static void
+MergeSmallKRows(const int64_t* src_ids, const float* src_distances, size_t src_k, const int64_t* tar_ids,
+                const float* tar_distances, size_t tar_k, int64_t* buf_ids, float* buf_distances, size_t buf_k) {
+    constexpr float sentinel = Ascending ? std::numeric_limits<float>::max() : std::numeric_limits<float>::lowest();
+
+    int64_t staged_src_ids[KClass + 1];
+    float staged_src_distances[KClass + 1];
+    int64_t staged_tar_ids[KClass + 1];
+    float staged_tar_distances[KClass + 1];
+
+    memcpy(staged_src_ids, src_ids, src_k * sizeof(int64_t));
+    memcpy(staged_src_distances, src_distances, src_k * sizeof(float));
+    staged_src_ids[src_k] = -1;
+    staged_src_distances[src_k] = sentinel;
+
+    memcpy(staged_tar_ids, tar_ids, tar_k * sizeof(int64_t));
+    memcpy(staged_tar_distances, tar_distances, tar_k * sizeof(float));
+    staged_tar_ids[tar_k] = -1;
+    staged_tar_distances[tar_k] = sentinel;
+
+    size_t src_j = 0, tar_j = 0;
+    for (size_t buf_j = 0; buf_j < buf_k; buf_j++) {
+        float src_d = staged_src_distances[src_j];
+        float tar_d = staged_tar_distances[tar_j];
+        // strict comparison keeps the tie-breaking rule of the run-based merge: ties go to tar
+        bool take_src = Ascending ? (src_d < tar_d) : (src_d > tar_d);
+        buf_ids[buf_j] = take_src ? staged_src_ids[src_j] : staged_tar_ids[tar_j];
+        buf_distances[buf_j] = take_src ? src_d : tar_d;
+        src_j += take_src;
+        tar_j += !take_src;
+    }
+}
+
+using RowMerger = void (*)(const int64_t*, const float*, size_t, const int64_t*, const float*, size_t, int64_t*,
+                           float*, size_t);
+
+/* Pick the (direction, k-class) specialization covering every row involved in the
+ * merge, or nullptr when k exceeds the largest class. */
+static RowMerger
+GetRowMerger(size_t kmax, bool ascending) {
+    if (kmax <= 16) {
+        return ascending ? &MergeSmallKRows<true, 16> : &MergeSmallKRows<false, 16>;
+    }
+    if (kmax <= 64) {
+        return ascending ? &MergeSmallKRows<true, 64> : &MergeSmallKRows<false, 64>;
+    }
+    if (kmax <= 1024) {
+        return ascending ? &MergeSmallKRows<true, 1024> : &MergeSmallKRows<false, 1024>;
+    }
+    return nullptr;
+}
 
 void
 CollectFileMetrics(int file_type, size_t file_size) {
@@ -101,9 +284,18 @@ XSearchTask::XSearchTask(const std::shared_ptr<server::Context>& context, TableF
         if (file_->metric_type_ == static_cast<int>(MetricType::IP)) {
             ascending_reduce = false;
         }
-        index_engine_ = EngineFactory::Build(file_->dimension_, file_->location_, (EngineType)file_->engine_type_,
-                                             (MetricType)file_->metric_type_, file_->nlist_);
+        index_engine_ = engine::EngineHandleCache::GetInstance().Acquire(
+            file_->id_, file_->dimension_, file_->location_, (EngineType)file_->engine_type_,
+            (MetricType)file_->metric_type_, file_->nlist_);
+    }
+}
+
+void
+XSearchTask::ReleaseEngine() {
+    if (index_engine_ != nullptr && file_ != nullptr) {
+        engine::EngineHandleCache::GetInstance().Release(file_->id_, index_engine_);
     }
+    index_engine_ = nullptr;
 }
 
 void
@@ -111,6 +303,19 @@ XSearchTask::Load(LoadType type, uint8_t device_id) {
     auto load_ctx = context_->Follower("XSearchTask::Load " + std::to_string(file_->id_));
 
     TimeRecorder rc("");
+
+    // charge the wait between job enqueue and this first stage to the
+    // request's latency profile; unsampled requests carry no profile
+    auto& profile = context_->GetProfile();
+    if (profile != nullptr && !queue_wait_recorded_) {
+        queue_wait_recorded_ = true;
+        if (auto job = job_.lock()) {
+            auto search_job = std::static_pointer_cast<scheduler::SearchJob>(job);
+            profile->queue_wait_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                           std::chrono::steady_clock::now() - search_job->EnqueueTime())
+                                           .count();
+        }
+    }
     Status stat = Status::OK();
     std::string error_msg;
     std::string type_str;
@@ -118,8 +323,32 @@ XSearchTask::Load(LoadType type, uint8_t device_id) {
     try {
         fiu_do_on("XSearchTask.Load.throw_std_exception", throw std::exception());
         if (type == LoadType::DISK2CPU) {
-            stat = index_engine_->Load();
-            type_str = "DISK2CPU";
+            bool fused_to_gpu = false;
+#ifdef MILVUS_GPU_VERSION
+            // cold GPU-routed segments skip the host-resident detour: the index is
+            // deserialized once and cloned straight to its target device, so the
+            // later CPU2GPU step becomes a gpu-cache hit. Hybrid engines keep the
+            // host copy for their cpu-side coarse search and opt out
+            auto dest = ResMgrInst::GetInstance()->GetResource(path().Last());
+            if (dest != nullptr && dest->type() == ResourceType::GPU &&
+                index_engine_->IndexEngineType() != engine::EngineType::FAISS_IVFSQ8H &&
+                !cache::CpuCacheMgr::GetInstance()->ItemExists(file_->location_)) {
+                stat = index_engine_->LoadToGpu(dest->device_id());
+                fused_to_gpu = stat.ok();
+                if (fused_to_gpu) {
+                    type_str = "DISK2GPU:" + std::to_string(dest->device_id());
+                }
+            }
+#endif
+            if (!fused_to_gpu) {
+                stat = index_engine_->Load();
+                type_str = "DISK2CPU";
+                if (stat.ok()) {
+                    // the loading thread is bound to the cpu resource's numa node, so the
+                    // index memory now lives there; route later searches to the same node
+                    NumaHomePass::RecordHome(file_->id_, device_id);
+                }
+            }
         } else if (type == LoadType::CPU2GPU) {
             bool hybrid = false;
             if (index_engine_->IndexEngineType() == engine::EngineType::FAISS_IVFSQ8H) {
@@ -166,9 +395,9 @@ XSearchTask::Load(LoadType type, uint8_t device_id) {
                        " file type:" + std::to_string(file_->file_type_) + " size:" + std::to_string(file_size) +
                        " bytes from location: " + file_->location_ + " totally cost";
     double span = rc.ElapseFromBegin(info);
-    //    for (auto &context : search_contexts_) {
-    //        context->AccumLoadCost(span);
-    //    }
+    if (profile != nullptr) {
+        profile->load_ns_ += static_cast<int64_t>(span * 1000);  // span is in microseconds
+    }
 
     CollectFileMetrics(file_->file_type_, file_size);
 
@@ -180,6 +409,40 @@ XSearchTask::Load(LoadType type, uint8_t device_id) {
     load_ctx->GetTraceContext()->GetSpan()->Finish();
 }
 
+void
+XSearchTask::Prefetch() {
+    if (prefetched_.exchange(true)) {
+        return;
+    }
+
+    // already resident indexes need no readahead
+    if (cache::CpuCacheMgr::GetInstance()->ItemExists(file_->location_)) {
+        return;
+    }
+
+    server::CommonUtil::ReadAheadFile(file_->location_);
+}
+
+int64_t
+XSearchTask::GpuMemoryEstimate() const {
+    // the index is copied to the device roughly at its on-disk size
+    return file_ ? static_cast<int64_t>(file_->file_size_) : 0;
+}
+
+bool
+XSearchTask::Abandoned() const {
+    return context_ != nullptr && (context_->IsCancelled() || context_->IsTimeExceeded());
+}
+
+void
+XSearchTask::OnAbandoned() {
+    if (auto job = job_.lock()) {
+        auto search_job = std::static_pointer_cast<scheduler::SearchJob>(job);
+        search_job->GetStatus() = Status(SERVER_UNEXPECTED_ERROR, "search dropped: client deadline exceeded");
+        search_job->SearchDone(file_->id_);
+    }
+}
+
 void
 XSearchTask::Execute() {
     auto execute_ctx = context_->Follower("XSearchTask::Execute " + std::to_string(index_id_));
@@ -188,28 +451,139 @@ XSearchTask::Execute() {
         return;
     }
 
-    //    ENGINE_LOG_DEBUG << "Searching in file id:" << index_id_ << " with "
-    //                     << search_contexts_.size() << " tasks";
+    ENGINE_LOG_DEBUG_LAZY << "SearchTask req=" << context_->GetRequestID() << " begin file id:" << index_id_;
 
     TimeRecorder rc("DoSearch file id:" + std::to_string(index_id_));
 
     server::CollectDurationMetrics metrics(index_type_);
+    server::Metrics::GetInstance().SearchComputeTotalIncrement(EngineTypeLabel(index_engine_->IndexEngineType()),
+                                                               path().Last());
 
     std::vector<int64_t> output_ids;
     std::vector<float> output_distance;
 
     if (auto job = job_.lock()) {
         auto search_job = std::static_pointer_cast<scheduler::SearchJob>(job);
+        search_job->TaskStarted(index_id_);
+
+        // last-chance cancellation check before the engine call; the engine
+        // itself runs a single uninterruptible library call
+        if (Abandoned()) {
+            search_job->GetStatus() = Status(SERVER_UNEXPECTED_ERROR, "search dropped: client deadline exceeded");
+            search_job->SearchDone(index_id_);
+            ReleaseEngine();
+            execute_ctx->GetTraceContext()->GetSpan()->Finish();
+            return;
+        }
+
         // step 1: allocate memory
         uint64_t nq = search_job->nq();
         uint64_t topk = search_job->topk();
         uint64_t nprobe = search_job->nprobe();
         const engine::VectorsData& vectors = search_job->vectors();
 
+        // attribute predicates resolve against this segment's sidecar into
+        // the id set the scan is allowed to return; a segment written before
+        // the attributes existed has no sidecar and stays unfiltered
+        engine::AttributeFilterPtr attr_filter = context_->GetAttrFilter();
+        bool attr_active = attr_filter != nullptr && !attr_filter->Empty();
+        std::vector<int64_t> attr_ids;
+        if (attr_active) {
+            bool unfiltered = false;
+            auto attr_status = engine::AttrSidecar::Match(file_->location_, *attr_filter, attr_ids, unfiltered);
+            if (!attr_status.ok()) {
+                ENGINE_LOG_WARNING << "Attribute sidecar of " << file_->location_
+                                   << " unreadable, searching unfiltered: " << attr_status.ToString();
+            }
+            if (!attr_status.ok() || unfiltered) {
+                attr_active = false;
+            }
+        }
+
+        // ids deleted from this segment since it was flushed; their hits are
+        // masked out of every result this task produces
+        auto deleted = engine::DeleteSidecar::Load(file_->location_);
+        bool has_deletes = deleted != nullptr && !deleted->empty();
+
+        if (search_job->IsRangeSearch()) {
+            try {
+                std::vector<int64_t> range_ids;
+                std::vector<float> range_distances;
+                std::vector<size_t> range_lims;
+                Status s;
+                if (vectors.FloatDataSize() > 0) {
+                    s = index_engine_->RangeSearch(nq, vectors.FloatData(), search_job->radius(), nprobe, range_ids,
+                                                   range_distances, range_lims);
+                } else {
+                    s = Status(SERVER_UNEXPECTED_ERROR, "range search supports float vectors only");
+                }
+                if (s.ok() && (attr_active || has_deletes)) {
+                    // the selector is not pushed into range scans; compact
+                    // out the hits the predicates reject or the tombstones
+                    // deleted, per query
+                    std::unordered_set<int64_t> allowed(attr_ids.begin(), attr_ids.end());
+                    std::vector<int64_t> kept_ids;
+                    std::vector<float> kept_distances;
+                    std::vector<size_t> kept_lims(1, 0);
+                    for (size_t q = 0; q + 1 < range_lims.size(); q++) {
+                        for (size_t off = range_lims[q]; off < range_lims[q + 1]; off++) {
+                            if (attr_active && allowed.count(range_ids[off]) == 0) {
+                                continue;
+                            }
+                            if (has_deletes && deleted->count(range_ids[off]) != 0) {
+                                continue;
+                            }
+                            kept_ids.push_back(range_ids[off]);
+                            kept_distances.push_back(range_distances[off]);
+                        }
+                        kept_lims.push_back(kept_ids.size());
+                    }
+                    range_ids.swap(kept_ids);
+                    range_distances.swap(kept_distances);
+                    range_lims.swap(kept_lims);
+                }
+                if (s.ok()) {
+                    search_job->DepositRangeResult(range_ids, range_distances, range_lims);
+                } else {
+                    search_job->GetStatus() = s;
+                }
+                double span = rc.RecordSection("job " + std::to_string(search_job->id()) + " req=" +
+                                               search_job->GetRequestID() + " nq " + std::to_string(nq) +
+                                               ", do range search");
+                if (auto& profile = context_->GetProfile()) {
+                    profile->search_ns_ += static_cast<int64_t>(span * 1000);
+                }
+            } catch (std::exception& ex) {
+                ENGINE_LOG_ERROR << "SearchTask encounter exception: " << ex.what();
+                search_job->GetStatus() = Status(SERVER_UNEXPECTED_ERROR, ex.what());
+            }
+
+            search_job->SearchDone(index_id_);
+            rc.ElapseFromBegin("totally cost");
+            ReleaseEngine();
+            execute_ctx->GetTraceContext()->GetSpan()->Finish();
+            return;
+        }
+
+        // charge the task result buffers against the request's memory budget up
+        // front, turning a would-be node OOM into a per-request error
+        auto& accountant = context_->GetMemoryAccountant();
+        const int64_t result_bytes = static_cast<int64_t>(topk * nq) * (sizeof(int64_t) + sizeof(float));
+        if (accountant != nullptr && !accountant->Charge(result_bytes)) {
+            std::string msg =
+                "Search rejected: request memory budget of " + std::to_string(accountant->Budget()) + " bytes exhausted";
+            ENGINE_LOG_ERROR << msg;
+            search_job->GetStatus() = Status(SERVER_OUT_OF_MEMORY, msg);
+            search_job->SearchDone(index_id_);
+            ReleaseEngine();
+            execute_ctx->GetTraceContext()->GetSpan()->Finish();
+            return;
+        }
+
         output_ids.resize(topk * nq);
         output_distance.resize(topk * nq);
-        std::string hdr =
-            "job " + std::to_string(search_job->id()) + " nq " + std::to_string(nq) + " topk " + std::to_string(topk);
+        std::string hdr = "job " + std::to_string(search_job->id()) + " req=" + search_job->GetRequestID() + " nq " +
+                          std::to_string(nq) + " topk " + std::to_string(topk);
 
         try {
             fiu_do_on("XSearchTask.Execute.throw_std_exception", throw std::exception());
@@ -220,39 +594,154 @@ XSearchTask::Execute() {
                 hybrid = true;
             }
             Status s;
-            if (!vectors.float_data_.empty()) {
-                s = index_engine_->Search(nq, vectors.float_data_.data(), topk, nprobe, output_distance.data(),
-                                          output_ids.data(), hybrid);
-            } else if (!vectors.binary_data_.empty()) {
-                s = index_engine_->Search(nq, vectors.binary_data_.data(), topk, nprobe, output_distance.data(),
-                                          output_ids.data(), hybrid);
+            bool reduced_on_gpu = false;
+#ifdef MILVUS_GPU_VERSION
+            // when several segments of one job land on the same GPU, search
+            // straight into the job's device reducer; WaitResult() runs the
+            // fused k-selection there and only the final topk crosses PCIe.
+            // Tombstoned tables need the host-side post-filter, so they opt out,
+            // as do deep-topk (paged) queries beyond the GPU k-selection limit
+            if (vectors.FloatDataSize() > 0 && !hybrid && topk <= 2048 && !attr_active && !has_deletes &&
+                !engine::IdIndex::GetInstance().HasTombstones(file_->table_id_) &&
+                !search_job->IsSpeculated(index_id_)) {
+                auto resource = ResMgrInst::GetInstance()->GetResource(path().Last());
+                if (resource != nullptr && resource->type() == ResourceType::GPU) {
+                    auto reducer = search_job->GetGpuReducer(resource->device_id(), ascending_reduce);
+                    if (reducer != nullptr) {
+                        server::ProfilerRegion region("search_task_search");
+                        s = index_engine_->SearchOnGpu(nq, vectors.FloatData(), topk, nprobe, reducer);
+                        reduced_on_gpu = s.ok();
+                    }
+                }
+            }
+#endif
+            if (!reduced_on_gpu) {
+                server::ProfilerRegion region("search_task_search");
+                std::unique_ptr<faiss::IDSelectorBatch> attr_sel;
+                if (attr_active && !attr_ids.empty()) {
+                    attr_sel.reset(new faiss::IDSelectorBatch(attr_ids.size(), attr_ids.data()));
+                }
+                if (attr_active && attr_ids.empty()) {
+                    // no row of this segment satisfies the predicates, so the
+                    // scan is skipped and padding is merged instead
+                    const float worst_distance = ascending_reduce ? std::numeric_limits<float>::max()
+                                                                  : -std::numeric_limits<float>::max();
+                    std::fill(output_ids.begin(), output_ids.end(), -1);
+                    std::fill(output_distance.begin(), output_distance.end(), worst_distance);
+                    s = Status::OK();
+                } else if (vectors.FloatDataSize() > 0) {
+                    s = index_engine_->Search(nq, vectors.FloatData(), topk, nprobe, output_distance.data(),
+                                              output_ids.data(), hybrid, attr_sel.get(),
+                                              search_job->GetCoarseAssignCache());
+                } else if (vectors.BinaryDataSize() > 0) {
+                    s = index_engine_->Search(nq, vectors.BinaryData(), topk, nprobe, output_distance.data(),
+                                              output_ids.data(), hybrid);
+                }
             }
             fiu_do_on("XSearchTask.Execute.search_fail", s = Status(SERVER_UNEXPECTED_ERROR, ""));
 
             if (!s.ok()) {
+                if (accountant != nullptr) {
+                    accountant->Refund(result_bytes);
+                }
                 search_job->GetStatus() = s;
                 search_job->SearchDone(index_id_);
                 return;
             }
 
             double span = rc.RecordSection(hdr + ", do search");
-            //            search_job->AccumSearchCost(span);
-
-            // step 3: pick up topk result
-            auto spec_k = index_engine_->Count() < topk ? index_engine_->Count() : topk;
-            {
-                std::unique_lock<std::mutex> lock(search_job->mutex());
-                XSearchTask::MergeTopkToResultSet(output_ids, output_distance, spec_k, nq, topk, ascending_reduce,
-                                                  search_job->GetResultIds(), search_job->GetResultDistances());
+            if (auto& profile = context_->GetProfile()) {
+                profile->search_ns_ += static_cast<int64_t>(span * 1000);  // span is in microseconds
+            }
+
+            // deleted ids are masked the same way stale upsert hits are:
+            // replaced by the padding id so they sink to the end of the reduce
+            if (has_deletes) {
+                const float worst_distance = ascending_reduce ? std::numeric_limits<float>::max()
+                                                              : -std::numeric_limits<float>::max();
+                for (size_t i = 0; i < output_ids.size(); i++) {
+                    if (output_ids[i] >= 0 && deleted->count(output_ids[i]) != 0) {
+                        output_ids[i] = -1;
+                        output_distance[i] = worst_distance;
+                    }
+                }
+            }
+
+            // lazily drop upsert-superseded hits: a segment older than an
+            // id's tombstone holds a stale version, so its hit is replaced
+            // by the padding id and sinks to the end of the reduce
+            auto& id_index = engine::IdIndex::GetInstance();
+            if (id_index.HasTombstones(file_->table_id_)) {
+                const float worst_distance = ascending_reduce ? std::numeric_limits<float>::max()
+                                                              : -std::numeric_limits<float>::max();
+                for (size_t i = 0; i < output_ids.size(); i++) {
+                    if (output_ids[i] < 0) {
+                        continue;
+                    }
+                    int64_t mark_time = id_index.SupersededTime(file_->table_id_, output_ids[i]);
+                    if (mark_time != 0 && file_->created_on_ < mark_time) {
+                        output_ids[i] = -1;
+                        output_distance[i] = worst_distance;
+                    }
+                }
+            }
+
+            // flat/raw engines ignore the pushed-down selector, so hits are
+            // checked against the sidecar match set on the way out; for IVF
+            // engines that honored it this pass finds nothing to drop
+            if (attr_active && !attr_ids.empty()) {
+                std::unordered_set<int64_t> allowed(attr_ids.begin(), attr_ids.end());
+                const float attr_worst = ascending_reduce ? std::numeric_limits<float>::max()
+                                                          : -std::numeric_limits<float>::max();
+                for (size_t i = 0; i < output_ids.size(); i++) {
+                    if (output_ids[i] >= 0 && allowed.count(output_ids[i]) == 0) {
+                        output_ids[i] = -1;
+                        output_distance[i] = attr_worst;
+                    }
+                }
+            }
+
+            // step 3: pick up topk result; a device-reduced segment already
+            // lives in the job's reducer, so there is nothing to merge here
+            if (!reduced_on_gpu) {
+                // first-finisher election against a speculative twin: the
+                // loser discards its copy without touching the job result
+                if (!search_job->ClaimResult(index_id_)) {
+                    if (accountant != nullptr) {
+                        accountant->Refund(result_bytes);
+                    }
+                    rc.ElapseFromBegin("totally cost");
+                    ReleaseEngine();
+                    execute_ctx->GetTraceContext()->GetSpan()->Finish();
+                    return;
+                }
+                server::ProfilerRegion region("search_task_reduce");
+                auto spec_k = index_engine_->Count() < topk ? index_engine_->Count() : topk;
+                if (!search_job->DepositResult(std::move(output_ids), std::move(output_distance), spec_k,
+                                               ascending_reduce)) {
+                    std::unique_lock<std::mutex> lock(search_job->mutex());
+                    XSearchTask::MergeTopkToResultSet(output_ids, output_distance, spec_k, nq, topk, ascending_reduce,
+                                                      search_job->GetResultIds(), search_job->GetResultDistances(),
+                                                      accountant.get());
+                }
             }
 
             span = rc.RecordSection(hdr + ", reduce topk");
-            //            search_job->AccumReduceCost(span);
+            if (auto& profile = context_->GetProfile()) {
+                profile->reduce_ns_ += static_cast<int64_t>(span * 1000);
+            }
         } catch (std::exception& ex) {
             ENGINE_LOG_ERROR << "SearchTask encounter exception: " << ex.what();
             //            search_job->IndexSearchDone(index_id_);//mark as done avoid dead lock, even search failed
         }
 
+        // buffers still held here were merged locally (or the search threw);
+        // after a successful deposit they moved into the job and stay charged
+        // for the rest of the request
+        if (accountant != nullptr && !output_ids.empty()) {
+            accountant->Refund(result_bytes);
+        }
+
         // step 4: notify to send result to client
         search_job->SearchDone(index_id_);
     }
@@ -260,7 +749,7 @@ XSearchTask::Execute() {
     rc.ElapseFromBegin("totally cost");
 
     // release index in resource
-    index_engine_ = nullptr;
+    ReleaseEngine();
 
     execute_ctx->GetTraceContext()->GetSpan()->Finish();
 }
@@ -268,7 +757,15 @@ XSearchTask::Execute() {
 void
 XSearchTask::MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const scheduler::ResultDistances& src_distances,
                                   size_t src_k, size_t nq, size_t topk, bool ascending, scheduler::ResultIds& tar_ids,
-                                  scheduler::ResultDistances& tar_distances) {
+                                  scheduler::ResultDistances& tar_distances, server::MemoryAccountant* accountant) {
+    MergeResultSet(src_ids, src_distances, topk, src_k, nq, topk, ascending, tar_ids, tar_distances, accountant);
+}
+
+void
+XSearchTask::MergeResultSet(const scheduler::ResultIds& src_ids, const scheduler::ResultDistances& src_distances,
+                            size_t src_stride, size_t src_k, size_t nq, size_t topk, bool ascending,
+                            scheduler::ResultIds& tar_ids, scheduler::ResultDistances& tar_distances,
+                            server::MemoryAccountant* accountant) {
     if (src_ids.empty()) {
         return;
     }
@@ -276,59 +773,108 @@ XSearchTask::MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const sch
     size_t tar_k = tar_ids.size() / nq;
     size_t buf_k = std::min(topk, src_k + tar_k);
 
+    // the staging arrays are the transient cost of the reduce; charge them
+    // before allocation so a budget-blowing merge fails cleanly
+    const int64_t staging_bytes = static_cast<int64_t>(nq * buf_k) * (sizeof(int64_t) + sizeof(float));
+    if (accountant != nullptr && !accountant->Charge(staging_bytes)) {
+        throw std::runtime_error("Merge rejected: request memory budget of " + std::to_string(accountant->Budget()) +
+                                 " bytes exhausted");
+    }
+
     scheduler::ResultIds buf_ids(nq * buf_k, -1);
     scheduler::ResultDistances buf_distances(nq * buf_k, 0.0);
 
-    for (uint64_t i = 0; i < nq; i++) {
-        size_t buf_k_j = 0, src_k_j = 0, tar_k_j = 0;
-        size_t buf_idx, src_idx, tar_idx;
-
-        size_t buf_k_multi_i = buf_k * i;
-        size_t src_k_multi_i = topk * i;
-        size_t tar_k_multi_i = tar_k * i;
-
-        while (buf_k_j < buf_k && src_k_j < src_k && tar_k_j < tar_k) {
-            src_idx = src_k_multi_i + src_k_j;
-            tar_idx = tar_k_multi_i + tar_k_j;
-            buf_idx = buf_k_multi_i + buf_k_j;
-
-            if ((ascending && src_distances[src_idx] < tar_distances[tar_idx]) ||
-                (!ascending && src_distances[src_idx] > tar_distances[tar_idx])) {
-                buf_ids[buf_idx] = src_ids[src_idx];
-                buf_distances[buf_idx] = src_distances[src_idx];
-                src_k_j++;
-            } else {
-                buf_ids[buf_idx] = tar_ids[tar_idx];
-                buf_distances[buf_idx] = tar_distances[tar_idx];
-                tar_k_j++;
+    // small-k merges (>80% of traffic) go through a kernel specialized at compile
+    // time on (direction, k-class); the dispatch happens once per merge here
+    RowMerger row_merger = GetRowMerger(std::max(std::max(src_k, tar_k), buf_k), ascending);
+    if (row_merger != nullptr) {
+        auto small_k_function = [&, row_merger](size_t from_index, size_t to_index) {
+            for (size_t i = from_index; i < to_index; i++) {
+                row_merger(src_ids.data() + src_stride * i, src_distances.data() + src_stride * i, src_k,
+                           tar_ids.data() + tar_k * i, tar_distances.data() + tar_k * i, tar_k,
+                           buf_ids.data() + buf_k * i, buf_distances.data() + buf_k * i, buf_k);
             }
-            buf_k_j++;
+        };
+
+        if (NeedParallelReduce(nq, topk)) {
+            ParallelReduce(small_k_function, nq);
+        } else {
+            small_k_function(0, nq);
+        }
+
+        tar_ids.swap(buf_ids);
+        tar_distances.swap(buf_distances);
+        if (accountant != nullptr) {
+            accountant->Refund(staging_bytes);
         }
+        return;
+    }
 
-        if (buf_k_j < buf_k) {
-            if (src_k_j < src_k) {
-                while (buf_k_j < buf_k && src_k_j < src_k) {
-                    buf_idx = buf_k_multi_i + buf_k_j;
-                    src_idx = src_k_multi_i + src_k_j;
-                    buf_ids[buf_idx] = src_ids[src_idx];
-                    buf_distances[buf_idx] = src_distances[src_idx];
-                    src_k_j++;
-                    buf_k_j++;
+    RunCounter count_run = GetRunCounter();
+
+    auto reduce_function = [&](size_t from_index, size_t to_index) {
+        for (size_t i = from_index; i < to_index; i++) {
+            size_t buf_k_j = 0, src_k_j = 0, tar_k_j = 0;
+
+            size_t buf_k_multi_i = buf_k * i;
+            size_t src_k_multi_i = src_stride * i;
+            size_t tar_k_multi_i = tar_k * i;
+
+            while (buf_k_j < buf_k) {
+                size_t buf_idx = buf_k_multi_i + buf_k_j;
+                size_t src_idx = src_k_multi_i + src_k_j;
+                size_t tar_idx = tar_k_multi_i + tar_k_j;
+
+                size_t src_left = src_k - src_k_j;
+                size_t tar_left = tar_k - tar_k_j;
+                size_t buf_left = buf_k - buf_k_j;
+
+                bool take_src;
+                size_t run;
+                if (tar_left == 0) {
+                    take_src = true;
+                    run = std::min(src_left, buf_left);
+                } else if (src_left == 0) {
+                    take_src = false;
+                    run = std::min(tar_left, buf_left);
+                } else if ((ascending && src_distances[src_idx] < tar_distances[tar_idx]) ||
+                           (!ascending && src_distances[src_idx] > tar_distances[tar_idx])) {
+                    // a run of src elements strictly wins against the tar head
+                    take_src = true;
+                    run = count_run(src_distances.data() + src_idx, std::min(src_left, buf_left),
+                                    tar_distances[tar_idx], ascending, true);
+                } else {
+                    // ties go to tar, same as the scalar merge did
+                    take_src = false;
+                    run = count_run(tar_distances.data() + tar_idx, std::min(tar_left, buf_left),
+                                    src_distances[src_idx], ascending, false);
                 }
-            } else {
-                while (buf_k_j < buf_k && tar_k_j < tar_k) {
-                    buf_idx = buf_k_multi_i + buf_k_j;
-                    tar_idx = tar_k_multi_i + tar_k_j;
-                    buf_ids[buf_idx] = tar_ids[tar_idx];
-                    buf_distances[buf_idx] = tar_distances[tar_idx];
-                    tar_k_j++;
-                    buf_k_j++;
+
+                if (take_src) {
+                    memcpy(buf_ids.data() + buf_idx, src_ids.data() + src_idx, run * sizeof(int64_t));
+                    memcpy(buf_distances.data() + buf_idx, src_distances.data() + src_idx, run * sizeof(float));
+                    src_k_j += run;
+                } else {
+                    memcpy(buf_ids.data() + buf_idx, tar_ids.data() + tar_idx, run * sizeof(int64_t));
+                    memcpy(buf_distances.data() + buf_idx, tar_distances.data() + tar_idx, run * sizeof(float));
+                    tar_k_j += run;
                 }
+                buf_k_j += run;
             }
         }
+    };
+
+    if (NeedParallelReduce(nq, topk)) {
+        ParallelReduce(reduce_function, nq);
+    } else {
+        reduce_function(0, nq);
     }
+
     tar_ids.swap(buf_ids);
     tar_distances.swap(buf_distances);
+    if (accountant != nullptr) {
+        accountant->Refund(staging_bytes);
+    }
 }
 
 // void
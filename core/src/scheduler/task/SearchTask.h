@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -32,11 +33,44 @@ class XSearchTask : public Task {
     void
     Execute() override;
 
+    void
+    Prefetch() override;
+
+    int64_t
+    GpuMemoryEstimate() const override;
+
+    int64_t
+    FileSize() const override {
+        return file_ == nullptr ? 0 : file_->file_size_;
+    }
+
+    bool
+    Abandoned() const override;
+
+    void
+    OnAbandoned() override;
+
+    // hand the engine handle back to the pool (or drop it) and clear the
+    // member; called wherever the task is done with the engine
+    void
+    ReleaseEngine();
+
  public:
+    // `accountant`, when set, is charged for the staging buffers of the merge
+    // and throws the merge out (std::bad_alloc-style, via the caller's catch)
+    // when the request's memory budget cannot cover them
     static void
     MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const scheduler::ResultDistances& src_distances,
                          size_t src_k, size_t nq, size_t topk, bool ascending, scheduler::ResultIds& tar_ids,
-                         scheduler::ResultDistances& tar_distances);
+                         scheduler::ResultDistances& tar_distances, server::MemoryAccountant* accountant = nullptr);
+
+    // same merge with the src row stride decoupled from topk, for combining already
+    // compacted result sets whose stride may be smaller than topk
+    static void
+    MergeResultSet(const scheduler::ResultIds& src_ids, const scheduler::ResultDistances& src_distances,
+                   size_t src_stride, size_t src_k, size_t nq, size_t topk, bool ascending,
+                   scheduler::ResultIds& tar_ids, scheduler::ResultDistances& tar_distances,
+                   server::MemoryAccountant* accountant = nullptr);
 
     //    static void
     //    MergeTopkArray(std::vector<int64_t>& tar_ids, std::vector<float>& tar_distance, uint64_t& tar_input_k,
@@ -55,6 +89,12 @@ class XSearchTask : public Task {
     // distance -- value 0 means two vectors equal, ascending reduce, L2/HAMMING/JACCARD/TONIMOTO ...
     // similarity -- infinity value means two vectors equal, descending reduce, IP
     bool ascending_reduce = true;
+
+ private:
+    std::atomic_bool prefetched_{false};
+    // queue wait is charged to the request profile once per task, on the
+    // first Load() call; later CPU2GPU/GPU2CPU loads are not queue time
+    bool queue_wait_recorded_ = false;
 };
 
 }  // namespace scheduler
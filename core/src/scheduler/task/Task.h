@@ -37,6 +37,13 @@ enum class TaskType {
     TestTask,
 };
 
+// scheduling classes, picked for execution in ascending order
+enum class TaskPriority {
+    INTERACTIVE = 0,  // search: a client is blocked on the result
+    NORMAL = 1,       // delete
+    BACKGROUND = 2,   // index build, test
+};
+
 class Task;
 
 using TaskPtr = std::shared_ptr<Task>;
@@ -55,6 +62,22 @@ class Task {
         return type_;
     }
 
+    /*
+     * Scheduling class, derived from the task type: interactive search
+     * outranks delete, which outranks background index builds;
+     */
+    inline TaskPriority
+    Priority() const {
+        switch (type_) {
+            case TaskType::SearchTask:
+                return TaskPriority::INTERACTIVE;
+            case TaskType::DeleteTask:
+                return TaskPriority::NORMAL;
+            default:
+                return TaskPriority::BACKGROUND;
+        }
+    }
+
     /*
      * Transport path;
      */
@@ -78,6 +101,40 @@ class Task {
     virtual void
     Execute() = 0;
 
+    // best-effort hint that this task will be loaded soon, used to overlap disk
+    // I/O with the execution of earlier tasks; must be cheap and thread-safe
+    virtual void
+    Prefetch() {
+    }
+
+    // rough upper bound on the device memory this task occupies while running
+    // on a GPU; 0 means unknown and reserves nothing from GpuMemoryBroker
+    virtual int64_t
+    GpuMemoryEstimate() const {
+        return 0;
+    }
+
+    // bytes copied when this task is loaded onto a resource, 0 when unknown;
+    // used to attribute I/O volume to the resource whose loader does the copy
+    virtual int64_t
+    FileSize() const {
+        return 0;
+    }
+
+    // true when the client that issued this task no longer waits for the
+    // result (deadline exceeded or cancelled); such tasks are dropped by
+    // the pick functions instead of loaded or executed
+    virtual bool
+    Abandoned() const {
+        return false;
+    }
+
+    // bookkeeping after the scheduler dropped an abandoned task: mark the
+    // parent job done for this piece so waiters do not hang
+    virtual void
+    OnAbandoned() {
+    }
+
  public:
     Path task_path_;
     scheduler::JobWPtr job_;
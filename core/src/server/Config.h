@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <functional>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -45,17 +46,41 @@ static const char* CONFIG_SERVER_TIME_ZONE = "time_zone";
 static const char* CONFIG_SERVER_TIME_ZONE_DEFAULT = "UTC+8";
 static const char* CONFIG_SERVER_WEB_PORT = "web_port";
 static const char* CONFIG_SERVER_WEB_PORT_DEFAULT = "19121";
+static const char* CONFIG_SERVER_GRPC_CQ_NUM = "grpc_cq_num";
+static const char* CONFIG_SERVER_GRPC_CQ_NUM_DEFAULT = "0";
+static const char* CONFIG_SERVER_UNIX_SOCKET_PATH = "unix_socket_path";
+static const char* CONFIG_SERVER_UNIX_SOCKET_PATH_DEFAULT = "";
+static const char* CONFIG_SERVER_CLIENT_RATE_LIMIT = "client_rate_limit";
+static const char* CONFIG_SERVER_CLIENT_RATE_LIMIT_DEFAULT = "0";
+static const char* CONFIG_SERVER_TABLE_RATE_LIMIT = "table_rate_limit";
+static const char* CONFIG_SERVER_TABLE_RATE_LIMIT_DEFAULT = "0";
+static const char* CONFIG_SERVER_QUERY_RECORD_FRACTION = "query_record_fraction";
+static const char* CONFIG_SERVER_QUERY_RECORD_FRACTION_DEFAULT = "0.0";
+static const char* CONFIG_SERVER_SLOW_QUERY_THRESHOLD = "slow_query_threshold_ms";
+static const char* CONFIG_SERVER_SLOW_QUERY_THRESHOLD_DEFAULT = "0";
+static const char* CONFIG_SERVER_ROUTER_PEERS = "router_peers";
+static const char* CONFIG_SERVER_ROUTER_PEERS_DEFAULT = "";
+static const char* CONFIG_SERVER_ROUTER_POLICY = "router_policy";
+static const char* CONFIG_SERVER_ROUTER_POLICY_DEFAULT = "mirror";
 
 /* db config */
 static const char* CONFIG_DB = "db_config";
 static const char* CONFIG_DB_BACKEND_URL = "backend_url";
 static const char* CONFIG_DB_BACKEND_URL_DEFAULT = "sqlite://:@:/";
+static const char* CONFIG_DB_META_REPLICA_URLS = "meta_replica_urls";
+static const char* CONFIG_DB_META_REPLICA_URLS_DEFAULT = "";
 static const char* CONFIG_DB_ARCHIVE_DISK_THRESHOLD = "archive_disk_threshold";
 static const char* CONFIG_DB_ARCHIVE_DISK_THRESHOLD_DEFAULT = "0";
 static const char* CONFIG_DB_ARCHIVE_DAYS_THRESHOLD = "archive_days_threshold";
 static const char* CONFIG_DB_ARCHIVE_DAYS_THRESHOLD_DEFAULT = "0";
 static const char* CONFIG_DB_PRELOAD_TABLE = "preload_table";
 static const char* CONFIG_DB_PRELOAD_TABLE_DEFAULT = "";
+static const char* CONFIG_DB_WAL_ENABLE = "wal_enable";
+static const char* CONFIG_DB_WAL_ENABLE_DEFAULT = "false";
+static const char* CONFIG_DB_MERGE_CONCURRENCY = "merge_concurrency";
+static const char* CONFIG_DB_MERGE_CONCURRENCY_DEFAULT = "1";
+static const char* CONFIG_DB_BUILD_INDEX_ON_FLUSH = "build_index_on_flush";
+static const char* CONFIG_DB_BUILD_INDEX_ON_FLUSH_DEFAULT = "false";
 
 /* storage config */
 static const char* CONFIG_STORAGE = "storage_config";
@@ -75,6 +100,16 @@ static const char* CONFIG_STORAGE_S3_SECRET_KEY = "s3_secret_key";
 static const char* CONFIG_STORAGE_S3_SECRET_KEY_DEFAULT = "minioadmin";
 static const char* CONFIG_STORAGE_S3_BUCKET = "s3_bucket";
 static const char* CONFIG_STORAGE_S3_BUCKET_DEFAULT = "milvus-bucket";
+static const char* CONFIG_STORAGE_FILE_DIRECT_IO = "file_direct_io";
+static const char* CONFIG_STORAGE_FILE_DIRECT_IO_DEFAULT = "false";
+static const char* CONFIG_STORAGE_FILE_COMPRESS_ENABLE = "file_compress_enable";
+static const char* CONFIG_STORAGE_FILE_COMPRESS_ENABLE_DEFAULT = "false";
+static const char* CONFIG_STORAGE_HOT_TIER_DAYS = "hot_tier_days";
+static const char* CONFIG_STORAGE_HOT_TIER_DAYS_DEFAULT = "0";
+static const char* CONFIG_STORAGE_SCRUB_MB_PER_SECOND = "scrub_mb_per_second";
+static const char* CONFIG_STORAGE_SCRUB_MB_PER_SECOND_DEFAULT = "0";
+static const char* CONFIG_STORAGE_TRANSFER_PORT = "transfer_port";
+static const char* CONFIG_STORAGE_TRANSFER_PORT_DEFAULT = "0";
 
 /* cache config */
 static const char* CONFIG_CACHE = "cache_config";
@@ -86,6 +121,18 @@ static const char* CONFIG_CACHE_INSERT_BUFFER_SIZE = "insert_buffer_size";
 static const char* CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT = "1";
 static const char* CONFIG_CACHE_CACHE_INSERT_DATA = "cache_insert_data";
 static const char* CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT = "false";
+static const char* CONFIG_CACHE_QUERY_RESULT_CACHE_ENABLE = "query_result_cache_enable";
+static const char* CONFIG_CACHE_QUERY_RESULT_CACHE_ENABLE_DEFAULT = "false";
+static const char* CONFIG_CACHE_EVICTION_POLICY = "eviction_policy";
+static const char* CONFIG_CACHE_EVICTION_POLICY_DEFAULT = "lru";
+static const char* CONFIG_CACHE_DISK_CACHE_PATH = "disk_cache_path";
+static const char* CONFIG_CACHE_DISK_CACHE_PATH_DEFAULT = "";
+static const char* CONFIG_CACHE_DISK_CACHE_CAPACITY = "disk_cache_capacity";
+static const char* CONFIG_CACHE_DISK_CACHE_CAPACITY_DEFAULT = "64";
+static const char* CONFIG_CACHE_WARM_REPLAY_BUDGET = "warm_replay_budget";
+static const char* CONFIG_CACHE_WARM_REPLAY_BUDGET_DEFAULT = "0";
+static const char* CONFIG_CACHE_FAST_RESTART_HANDOFF = "fast_restart_handoff";
+static const char* CONFIG_CACHE_FAST_RESTART_HANDOFF_DEFAULT = "false";
 
 /* metric config */
 static const char* CONFIG_METRIC = "metric_config";
@@ -95,6 +142,8 @@ static const char* CONFIG_METRIC_ADDRESS = "address";
 static const char* CONFIG_METRIC_ADDRESS_DEFAULT = "127.0.0.1";
 static const char* CONFIG_METRIC_PORT = "port";
 static const char* CONFIG_METRIC_PORT_DEFAULT = "9091";
+static const char* CONFIG_METRIC_LABEL_CARDINALITY_LIMIT = "label_cardinality_limit";
+static const char* CONFIG_METRIC_LABEL_CARDINALITY_LIMIT_DEFAULT = "100";
 
 /* engine config */
 static const char* CONFIG_ENGINE = "engine_config";
@@ -104,6 +153,36 @@ static const char* CONFIG_ENGINE_OMP_THREAD_NUM = "omp_thread_num";
 static const char* CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT = "0";
 static const char* CONFIG_ENGINE_GPU_SEARCH_THRESHOLD = "gpu_search_threshold";
 static const char* CONFIG_ENGINE_GPU_SEARCH_THRESHOLD_DEFAULT = "1000";
+static const char* CONFIG_ENGINE_SEARCH_COMBINE_WINDOW = "search_combine_window";
+static const char* CONFIG_ENGINE_SEARCH_COMBINE_WINDOW_DEFAULT = "0";
+static const char* CONFIG_ENGINE_SEARCH_PROBE_STOP_WINDOW = "search_probe_stop_window";
+static const char* CONFIG_ENGINE_SEARCH_PROBE_STOP_WINDOW_DEFAULT = "0";
+static const char* CONFIG_ENGINE_AUTO_TUNE_INTERVAL = "auto_tune_interval";
+static const char* CONFIG_ENGINE_AUTO_TUNE_INTERVAL_DEFAULT = "0";
+static const char* CONFIG_ENGINE_AUTO_TUNE_APPLY = "auto_tune_apply";
+static const char* CONFIG_ENGINE_AUTO_TUNE_APPLY_DEFAULT = "false";
+static const char* CONFIG_ENGINE_VECTOR_DATA_CHECK = "vector_data_check";
+static const char* CONFIG_ENGINE_VECTOR_DATA_CHECK_DEFAULT = "true";
+static const char* CONFIG_ENGINE_INSERT_DEDUP_CHECK = "insert_dedup_check";
+static const char* CONFIG_ENGINE_INSERT_DEDUP_CHECK_DEFAULT = "false";
+static const char* CONFIG_ENGINE_DIM_PADDING = "dim_padding";
+static const char* CONFIG_ENGINE_DIM_PADDING_DEFAULT = "false";
+static const char* CONFIG_ENGINE_SEARCH_TASK_POOL_SIZE = "search_task_pool_size";
+static const char* CONFIG_ENGINE_SEARCH_TASK_POOL_SIZE_DEFAULT = "0";
+static const char* CONFIG_ENGINE_LOAD_TASK_POOL_SIZE = "load_task_pool_size";
+static const char* CONFIG_ENGINE_LOAD_TASK_POOL_SIZE_DEFAULT = "0";
+static const char* CONFIG_ENGINE_INDEX_MMAP_ENABLE = "index_mmap_enable";
+static const char* CONFIG_ENGINE_INDEX_MMAP_ENABLE_DEFAULT = "false";
+static const char* CONFIG_ENGINE_USE_HUGEPAGES = "use_hugepages";
+static const char* CONFIG_ENGINE_USE_HUGEPAGES_DEFAULT = "false";
+static const char* CONFIG_ENGINE_INDEX_BUILD_THREAD_NUM = "index_build_thread_num";
+static const char* CONFIG_ENGINE_INDEX_BUILD_THREAD_NUM_DEFAULT = "0";
+static const char* CONFIG_ENGINE_AUTO_NORMALIZE = "auto_normalize";
+static const char* CONFIG_ENGINE_AUTO_NORMALIZE_DEFAULT = "false";
+static const char* CONFIG_ENGINE_GANG_SCHEDULE = "gang_schedule";
+static const char* CONFIG_ENGINE_GANG_SCHEDULE_DEFAULT = "true";
+static const char* CONFIG_ENGINE_SEARCH_MEM_BUDGET = "search_mem_budget";
+static const char* CONFIG_ENGINE_SEARCH_MEM_BUDGET_DEFAULT = "0";
 
 /* gpu resource config */
 static const char* CONFIG_GPU_RESOURCE = "gpu_resource_config";
@@ -143,6 +222,22 @@ class Config {
     Status
     ProcessConfigCli(std::string& result, const std::string& cmd);
 
+    /* hot reload */
+    using ConfigCallBackF = std::function<Status(const std::string&)>;
+
+    // invoked with the new value whenever parent_key.child_key changes at
+    // runtime; token identifies the subscriber for unregistration
+    Status
+    RegisterCallBack(const std::string& parent_key, const std::string& child_key, const std::string& token,
+                     ConfigCallBackF callback);
+    Status
+    UnregisterCallBack(const std::string& parent_key, const std::string& child_key, const std::string& token);
+
+    // re-read the config file and apply every runtime-settable node whose
+    // value changed; result lists the applied and rejected changes
+    Status
+    HotReload(std::string& result);
+
  private:
     ConfigNode&
     GetConfigRoot();
@@ -158,6 +253,8 @@ class Config {
     GetConfigCli(std::string& value, const std::string& parent_key, const std::string& child_key);
     Status
     SetConfigCli(const std::string& parent_key, const std::string& child_key, const std::string& value);
+    Status
+    SetConfigCliDispatch(const std::string& parent_key, const std::string& child_key, const std::string& value);
 
     ///////////////////////////////////////////////////////////////////////////
     Status
@@ -174,14 +271,38 @@ class Config {
     CheckServerConfigTimeZone(const std::string& value);
     Status
     CheckServerConfigWebPort(const std::string& value);
+    Status
+    CheckServerConfigGrpcCqNum(const std::string& value);
+    Status
+    CheckServerConfigUnixSocketPath(const std::string& value);
+    Status
+    CheckServerConfigClientRateLimit(const std::string& value);
+    Status
+    CheckServerConfigTableRateLimit(const std::string& value);
+    Status
+    CheckServerConfigQueryRecordFraction(const std::string& value);
+    Status
+    CheckServerConfigSlowQueryThreshold(const std::string& value);
+    Status
+    CheckServerConfigRouterPeers(const std::string& value);
+    Status
+    CheckServerConfigRouterPolicy(const std::string& value);
 
     /* db config */
     Status
     CheckDBConfigBackendUrl(const std::string& value);
     Status
+    CheckDBConfigMetaReplicaUrls(const std::string& value);
+    Status
     CheckDBConfigArchiveDiskThreshold(const std::string& value);
     Status
     CheckDBConfigArchiveDaysThreshold(const std::string& value);
+    Status
+    CheckDBConfigWalEnable(const std::string& value);
+    Status
+    CheckDBConfigMergeConcurrency(const std::string& value);
+    Status
+    CheckDBConfigBuildIndexOnFlush(const std::string& value);
 
     /* storage config */
     Status
@@ -200,6 +321,16 @@ class Config {
     CheckStorageConfigS3SecretKey(const std::string& value);
     Status
     CheckStorageConfigS3Bucket(const std::string& value);
+    Status
+    CheckStorageConfigFileDirectIO(const std::string& value);
+    Status
+    CheckStorageConfigFileCompressEnable(const std::string& value);
+    Status
+    CheckStorageConfigHotTierDays(const std::string& value);
+    Status
+    CheckStorageConfigScrubMBPerSecond(const std::string& value);
+    Status
+    CheckStorageConfigTransferPort(const std::string& value);
 
     /* metric config */
     Status
@@ -208,6 +339,8 @@ class Config {
     CheckMetricConfigAddress(const std::string& value);
     Status
     CheckMetricConfigPort(const std::string& value);
+    Status
+    CheckMetricConfigLabelCardinalityLimit(const std::string& value);
 
     /* cache config */
     Status
@@ -218,12 +351,36 @@ class Config {
     CheckCacheConfigInsertBufferSize(const std::string& value);
     Status
     CheckCacheConfigCacheInsertData(const std::string& value);
+    Status
+    CheckCacheConfigQueryResultCacheEnable(const std::string& value);
+    Status
+    CheckCacheConfigEvictionPolicy(const std::string& value);
+    Status
+    CheckCacheConfigDiskCachePath(const std::string& value);
+    Status
+    CheckCacheConfigDiskCacheCapacity(const std::string& value);
+    Status
+    CheckCacheConfigWarmReplayBudget(const std::string& value);
 
     /* engine config */
     Status
     CheckEngineConfigUseBlasThreshold(const std::string& value);
     Status
     CheckEngineConfigOmpThreadNum(const std::string& value);
+    Status
+    CheckEngineConfigSearchCombineWindow(const std::string& value);
+    Status
+    CheckEngineConfigSearchProbeStopWindow(const std::string& value);
+    Status
+    CheckEngineConfigSearchMemBudget(const std::string& value);
+    Status
+    CheckEngineConfigSearchTaskPoolSize(const std::string& value);
+    Status
+    CheckEngineConfigIndexBuildThreadNum(const std::string& value);
+    Status
+    CheckEngineConfigAutoTuneInterval(const std::string& value);
+    Status
+    CheckEngineConfigLoadTaskPoolSize(const std::string& value);
 
 #ifdef MILVUS_GPU_VERSION
     Status
@@ -262,16 +419,40 @@ class Config {
     GetServerConfigTimeZone(std::string& value);
     Status
     GetServerConfigWebPort(std::string& value);
+    Status
+    GetServerConfigGrpcCqNum(int64_t& value);
+    Status
+    GetServerConfigUnixSocketPath(std::string& value);
+    Status
+    GetServerConfigClientRateLimit(int64_t& value);
+    Status
+    GetServerConfigTableRateLimit(int64_t& value);
+    Status
+    GetServerConfigQueryRecordFraction(float& value);
+    Status
+    GetServerConfigSlowQueryThreshold(int64_t& value);
+    Status
+    GetServerConfigRouterPeers(std::string& value);
+    Status
+    GetServerConfigRouterPolicy(std::string& value);
 
     /* db config */
     Status
     GetDBConfigBackendUrl(std::string& value);
     Status
+    GetDBConfigMetaReplicaUrls(std::string& value);
+    Status
     GetDBConfigArchiveDiskThreshold(int64_t& value);
     Status
     GetDBConfigArchiveDaysThreshold(int64_t& value);
     Status
     GetDBConfigPreloadTable(std::string& value);
+    Status
+    GetDBConfigWalEnable(bool& value);
+    Status
+    GetDBConfigMergeConcurrency(int64_t& value);
+    Status
+    GetDBConfigBuildIndexOnFlush(bool& value);
 
     /* storage config */
     Status
@@ -290,6 +471,16 @@ class Config {
     GetStorageConfigS3SecretKey(std::string& value);
     Status
     GetStorageConfigS3Bucket(std::string& value);
+    Status
+    GetStorageConfigFileDirectIO(bool& value);
+    Status
+    GetStorageConfigFileCompressEnable(bool& value);
+    Status
+    GetStorageConfigHotTierDays(int64_t& value);
+    Status
+    GetStorageConfigScrubMBPerSecond(int64_t& value);
+    Status
+    GetStorageConfigTransferPort(int64_t& value);
 
     /* metric config */
     Status
@@ -298,6 +489,8 @@ class Config {
     GetMetricConfigAddress(std::string& value);
     Status
     GetMetricConfigPort(std::string& value);
+    Status
+    GetMetricConfigLabelCardinalityLimit(int64_t& value);
 
     /* cache config */
     Status
@@ -308,12 +501,54 @@ class Config {
     GetCacheConfigInsertBufferSize(int64_t& value);
     Status
     GetCacheConfigCacheInsertData(bool& value);
+    Status
+    GetCacheConfigQueryResultCacheEnable(bool& value);
+    Status
+    GetCacheConfigEvictionPolicy(std::string& value);
+    Status
+    GetCacheConfigDiskCachePath(std::string& value);
+    Status
+    GetCacheConfigDiskCacheCapacity(int64_t& value);
+    Status
+    GetCacheConfigWarmReplayBudget(int64_t& value);
+    Status
+    GetCacheConfigFastRestartHandoff(bool& value);
 
     /* engine config */
     Status
     GetEngineConfigUseBlasThreshold(int64_t& value);
     Status
     GetEngineConfigOmpThreadNum(int64_t& value);
+    Status
+    GetEngineConfigSearchCombineWindow(int64_t& value);
+    Status
+    GetEngineConfigSearchProbeStopWindow(int64_t& value);
+    Status
+    GetEngineConfigAutoTuneInterval(int64_t& value);
+    Status
+    GetEngineConfigAutoTuneApply(bool& value);
+    Status
+    GetEngineConfigVectorDataCheck(bool& value);
+    Status
+    GetEngineConfigInsertDedupCheck(bool& value);
+    Status
+    GetEngineConfigDimPadding(bool& value);
+    Status
+    GetEngineConfigSearchTaskPoolSize(int64_t& value);
+    Status
+    GetEngineConfigLoadTaskPoolSize(int64_t& value);
+    Status
+    GetEngineConfigIndexMmapEnable(bool& value);
+    Status
+    GetEngineConfigUseHugepages(bool& value);
+    Status
+    GetEngineConfigIndexBuildThreadNum(int64_t& value);
+    Status
+    GetEngineConfigAutoNormalize(bool& value);
+    Status
+    GetEngineConfigGangSchedule(bool& value);
+    Status
+    GetEngineConfigSearchMemBudget(int64_t& value);
 
 #ifdef MILVUS_GPU_VERSION
     Status
@@ -348,14 +583,34 @@ class Config {
     SetServerConfigTimeZone(const std::string& value);
     Status
     SetServerConfigWebPort(const std::string& value);
+    Status
+    SetServerConfigGrpcCqNum(const std::string& value);
+    Status
+    SetServerConfigUnixSocketPath(const std::string& value);
+    Status
+    SetServerConfigClientRateLimit(const std::string& value);
+    Status
+    SetServerConfigTableRateLimit(const std::string& value);
+    Status
+    SetServerConfigQueryRecordFraction(const std::string& value);
+    Status
+    SetServerConfigSlowQueryThreshold(const std::string& value);
 
     /* db config */
     Status
     SetDBConfigBackendUrl(const std::string& value);
     Status
+    SetDBConfigMetaReplicaUrls(const std::string& value);
+    Status
     SetDBConfigArchiveDiskThreshold(const std::string& value);
     Status
     SetDBConfigArchiveDaysThreshold(const std::string& value);
+    Status
+    SetDBConfigWalEnable(const std::string& value);
+    Status
+    SetDBConfigMergeConcurrency(const std::string& value);
+    Status
+    SetDBConfigBuildIndexOnFlush(const std::string& value);
 
     /* storage config */
     Status
@@ -374,6 +629,14 @@ class Config {
     SetStorageConfigS3SecretKey(const std::string& value);
     Status
     SetStorageConfigS3Bucket(const std::string& value);
+    Status
+    SetStorageConfigFileDirectIO(const std::string& value);
+    Status
+    SetStorageConfigFileCompressEnable(const std::string& value);
+    Status
+    SetStorageConfigHotTierDays(const std::string& value);
+    Status
+    SetStorageConfigScrubMBPerSecond(const std::string& value);
 
     /* metric config */
     Status
@@ -382,6 +645,8 @@ class Config {
     SetMetricConfigAddress(const std::string& value);
     Status
     SetMetricConfigPort(const std::string& value);
+    Status
+    SetMetricConfigLabelCardinalityLimit(const std::string& value);
 
     /* cache config */
     Status
@@ -392,6 +657,16 @@ class Config {
     SetCacheConfigInsertBufferSize(const std::string& value);
     Status
     SetCacheConfigCacheInsertData(const std::string& value);
+    Status
+    SetCacheConfigQueryResultCacheEnable(const std::string& value);
+    Status
+    SetCacheConfigEvictionPolicy(const std::string& value);
+    Status
+    SetCacheConfigDiskCachePath(const std::string& value);
+    Status
+    SetCacheConfigDiskCacheCapacity(const std::string& value);
+    Status
+    SetCacheConfigWarmReplayBudget(const std::string& value);
 
     /* engine config */
     Status
@@ -417,8 +692,14 @@ class Config {
 #endif
 
  private:
+    Status
+    TriggerCallBack(const std::string& parent_key, const std::string& child_key, const std::string& value);
+
     std::unordered_map<std::string, std::unordered_map<std::string, std::string>> config_map_;
     std::mutex mutex_;
+    std::unordered_map<std::string, std::unordered_map<std::string, ConfigCallBackF>> config_callback_;
+    std::mutex callback_mutex_;
+    std::string config_file_;
 };
 
 }  // namespace server
@@ -0,0 +1,52 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "utils/Status.h"
+
+namespace milvus {
+namespace server {
+
+// Watches the loaded yaml with inotify and hot-reloads the runtime-settable
+// nodes whenever the file is rewritten, so tuning knobs like cache capacity
+// or omp thread count apply without a restart. The containing directory is
+// watched rather than the file itself because editors and k8s configmap
+// updates replace the file instead of writing it in place.
+class ConfigWatcher {
+ public:
+    static ConfigWatcher&
+    GetInstance();
+
+    Status
+    Start(const std::string& config_file);
+
+    void
+    Stop();
+
+ private:
+    ConfigWatcher() = default;
+    ~ConfigWatcher();
+
+    void
+    WatchLoop(const std::string& dir_path, const std::string& file_name);
+
+    std::thread watcher_;
+    std::atomic_bool stop_{false};
+    bool started_ = false;
+};
+
+}  // namespace server
+}  // namespace milvus
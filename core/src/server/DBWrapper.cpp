@@ -16,6 +16,8 @@
 #include <vector>
 
 #include "db/DBFactory.h"
+#include "db/Utils.h"
+#include "scheduler/ThreadGovernor.h"
 #include "server/Config.h"
 #include "server/DBWrapper.h"
 #include "utils/CommonUtil.h"
@@ -38,6 +40,15 @@ DBWrapper::StartService() {
         return s;
     }
 
+    std::string meta_replica_urls;
+    s = config.GetDBConfigMetaReplicaUrls(meta_replica_urls);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    StringHelpFunctions::SplitStringByDelimeter(meta_replica_urls, ",", opt.meta_.replica_uris_);
+
     std::string path;
     s = config.GetStorageConfigPrimaryPath(path);
     if (!s.ok()) {
@@ -56,6 +67,39 @@ DBWrapper::StartService() {
 
     StringHelpFunctions::SplitStringByDelimeter(db_slave_path, ";", opt.meta_.slave_paths_);
 
+    // a secondary path may carry a device-class tag for storage tiering,
+    // e.g. /mnt/nvme0:hot or /mnt/sata0:cold; untagged paths accept any file
+    for (auto& slave_path : opt.meta_.slave_paths_) {
+        std::string::size_type tag_pos = slave_path.rfind(':');
+        if (tag_pos == std::string::npos) {
+            continue;
+        }
+        std::string device_class = slave_path.substr(tag_pos + 1);
+        if (device_class == engine::utils::TIER_DEVICE_CLASS_HOT ||
+            device_class == engine::utils::TIER_DEVICE_CLASS_COLD) {
+            slave_path = slave_path.substr(0, tag_pos);
+            opt.meta_.path_device_class_[slave_path] = device_class;
+        }
+    }
+
+    s = config.GetDBConfigWalEnable(opt.wal_enable_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetDBConfigMergeConcurrency(opt.merge_concurrency_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetDBConfigBuildIndexOnFlush(opt.build_index_on_flush_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
     // cache config
     s = config.GetCacheConfigCacheInsertData(opt.insert_cache_immediately_);
     if (!s.ok()) {
@@ -101,6 +145,9 @@ DBWrapper::StartService() {
         }
     }
 
+    // the compute-token pool hands this width out to concurrent tasks
+    scheduler::ThreadGovernor::GetInstance().SetTotalTokens(omp_thread);
+
     // init faiss global variable
     int64_t use_blas_threshold;
     s = config.GetEngineConfigUseBlasThreshold(use_blas_threshold);
@@ -111,6 +158,20 @@ DBWrapper::StartService() {
 
     faiss::distance_compute_blas_threshold = use_blas_threshold;
 
+    // keep both knobs tunable at runtime through set_config / hot reload
+    config.RegisterCallBack(CONFIG_ENGINE, CONFIG_ENGINE_OMP_THREAD_NUM, "DBWrapper", [](const std::string& value) {
+        int64_t thread_num = std::stoll(value);
+        if (thread_num > 0) {
+            omp_set_num_threads(thread_num);
+            scheduler::ThreadGovernor::GetInstance().SetTotalTokens(thread_num);
+        }
+        return Status::OK();
+    });
+    config.RegisterCallBack(CONFIG_ENGINE, CONFIG_ENGINE_USE_BLAS_THRESHOLD, "DBWrapper", [](const std::string& value) {
+        faiss::distance_compute_blas_threshold = std::stoll(value);
+        return Status::OK();
+    });
+
     // set archive config
     engine::ArchiveConf::CriteriaT criterial;
     int64_t disk, days;
@@ -166,22 +227,32 @@ DBWrapper::StartService() {
 
     db_->Start();
 
-    // preload table
-    std::string preload_tables;
-    s = config.GetDBConfigPreloadTable(preload_tables);
+    // preload table; remembered here, launched via PreloadTablesAsync once
+    // the remaining subsystems (s3 in particular) are up
+    s = config.GetDBConfigPreloadTable(preload_tables_);
     if (!s.ok()) {
         std::cerr << s.ToString() << std::endl;
         return s;
     }
 
-    s = PreloadTables(preload_tables);
-    if (!s.ok()) {
-        std::cerr << "ERROR! Failed to preload tables: " << preload_tables << std::endl;
-        std::cerr << s.ToString() << std::endl;
-        kill(0, SIGUSR1);
+    return Status::OK();
+}
+
+void
+DBWrapper::PreloadTablesAsync() {
+    if (preload_tables_.empty() || db_ == nullptr) {
+        return;
     }
 
-    return Status::OK();
+    preload_thread_ = std::thread([this] {
+        SERVER_LOG_INFO << "Start to preload tables: " << preload_tables_;
+        Status s = PreloadTables(preload_tables_);
+        if (!s.ok()) {
+            SERVER_LOG_ERROR << "Failed to preload tables: " << preload_tables_ << " " << s.ToString();
+        } else {
+            SERVER_LOG_INFO << "Preload tables done";
+        }
+    });
 }
 
 Status
@@ -190,36 +261,65 @@ DBWrapper::StopService() {
         db_->Stop();
     }
 
+    // an in-flight preload sees shutdown errors from the stopped db and
+    // returns promptly
+    if (preload_thread_.joinable()) {
+        preload_thread_.join();
+    }
+
     return Status::OK();
 }
 
+bool
+DBWrapper::IsTableReady(const std::string& table_name) {
+    std::lock_guard<std::mutex> lock(warming_mutex_);
+    return warming_tables_.count(table_name) == 0;
+}
+
 Status
 DBWrapper::PreloadTables(const std::string& preload_tables) {
     if (preload_tables.empty()) {
-        // do nothing
-    } else if (preload_tables == "*") {
-        // load all tables
+        return Status::OK();
+    }
+
+    std::vector<std::string> table_names;
+    if (preload_tables == "*") {
         std::vector<engine::meta::TableSchema> table_schema_array;
         db_->AllTables(table_schema_array);
-
         for (auto& schema : table_schema_array) {
-            auto status = db_->PreloadTable(schema.table_id_);
-            if (!status.ok()) {
-                return status;
-            }
+            table_names.push_back(schema.table_id_);
         }
     } else {
-        std::vector<std::string> table_names;
         StringHelpFunctions::SplitStringByDelimeter(preload_tables, ",", table_names);
-        for (auto& name : table_names) {
-            auto status = db_->PreloadTable(name);
-            if (!status.ok()) {
-                return status;
+    }
+
+    // all preload targets report not-ready before the first load starts, so
+    // the probe never shows a cold table as ready
+    {
+        std::lock_guard<std::mutex> lock(warming_mutex_);
+        warming_tables_.insert(table_names.begin(), table_names.end());
+    }
+
+    // hottest tables first: the ones the warm-state snapshot says queries
+    // actually touch come up (and report ready) before the long tail
+    db_->OrderTablesByWarmth(table_names);
+
+    // a failed table is reported but does not hold back the rest; it stays
+    // queryable through the normal cache-miss path
+    Status first_error;
+    for (auto& name : table_names) {
+        auto status = db_->PreloadTable(name);
+        if (!status.ok()) {
+            SERVER_LOG_ERROR << "Failed to preload table: " << name << " " << status.ToString();
+            if (first_error.ok()) {
+                first_error = status;
             }
         }
+        std::lock_guard<std::mutex> lock(warming_mutex_);
+        warming_tables_.erase(name);
     }
 
-    return Status::OK();
+    return first_error;
 }
 
 }  // namespace server
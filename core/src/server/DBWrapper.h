@@ -11,7 +11,10 @@
 
 #pragma once
 
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
 
 #include "db/DB.h"
 #include "utils/Status.h"
@@ -41,6 +44,23 @@ class DBWrapper {
     Status
     StopService();
 
+    /*
+     * Kick off db_config.preload_table loading on a background thread;
+     * preloading a large deployment takes minutes and queries served before
+     * it finishes simply go through the normal cache-miss path, so there is
+     * no reason to hold the port closed for it;
+     */
+    void
+    PreloadTablesAsync();
+
+    /*
+     * Per-table readiness probe backing GET /tables/{name}/ready: false while
+     * the table's startup preload is still warming it, true otherwise. Lets a
+     * load balancer admit traffic table by table instead of all-or-nothing.
+     */
+    bool
+    IsTableReady(const std::string& table_name);
+
     engine::DBPtr
     EngineDB() {
         return db_;
@@ -52,6 +72,11 @@ class DBWrapper {
 
  private:
     engine::DBPtr db_;
+    std::string preload_tables_;
+    std::thread preload_thread_;
+
+    std::mutex warming_mutex_;
+    std::set<std::string> warming_tables_;
 };
 
 }  // namespace server
@@ -15,14 +15,20 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <future>
+
+#include "cache/CacheHandoff.h"
 #include "metrics/Metrics.h"
 #include "scheduler/SchedInst.h"
 #include "server/Config.h"
+#include "server/ConfigWatcher.h"
 #include "server/DBWrapper.h"
 #include "server/grpc_impl/GrpcServer.h"
+#include "server/grpc_impl/ShardRouter.h"
 #include "server/web_impl/WebServer.h"
 #include "src/version.h"
 #include "storage/s3/S3ClientWrapper.h"
+#include "storage/transfer/IndexTransferService.h"
 #include "tracing/TracerUtil.h"
 #include "utils/Log.h"
 #include "utils/LogUtil.h"
@@ -255,20 +261,68 @@ Server::LoadConfig() {
 
 void
 Server::StartService() {
+    // gpu contexts are created lazily by FaissGpuResourceMgr on the first
+    // gpu-routed task, so these two only record configuration
     engine::KnowhereResource::Initialize();
     scheduler::StartSchedulerService();
+
+    // the db stack (meta backend, directory checks) and the s3 client
+    // (network round trip) are independent; bring them up concurrently so
+    // the port opens as soon as the slower of the two is ready
+    auto s3_start =
+        std::async(std::launch::async, [] { return storage::S3ClientWrapper::GetInstance().StartService(); });
+
+    // re-attach a previous run's cache handoff before the db starts, so
+    // warm-state replay finds the entries already resident
+    std::string primary_path;
+    Config::GetInstance().GetStorageConfigPrimaryPath(primary_path);
+    Status handoff_status = cache::CacheHandoff::GetInstance().RestoreState(primary_path + "/cache_handoff");
+    if (!handoff_status.ok()) {
+        std::cerr << "Cache handoff restore fail: " << handoff_status.message() << std::endl;
+    }
+
     DBWrapper::GetInstance().StartService();
+    s3_start.wait();
+
+    // table preload needs both of the above but not the port; run it behind
+    DBWrapper::GetInstance().PreloadTablesAsync();
+
+    // peer channels must exist before the port opens; with no peers
+    // configured this is a no-op and searches stay node-local
+    Status router_status = grpc::ShardRouter::GetInstance().Init();
+    if (!router_status.ok()) {
+        std::cerr << "Shard router init fail: " << router_status.message() << std::endl;
+    }
+
+    // warm-index serving must be up before peers start their own preloads
+    Status transfer_status = storage::IndexTransferService::GetInstance().Start();
+    if (!transfer_status.ok()) {
+        std::cerr << "Index transfer service start fail: " << transfer_status.message() << std::endl;
+    }
+
     grpc::GrpcServer::GetInstance().Start();
     web::WebServer::GetInstance().Start();
-    storage::S3ClientWrapper::GetInstance().StartService();
+    ConfigWatcher::GetInstance().Start(config_filename_);
 }
 
 void
 Server::StopService() {
+    ConfigWatcher::GetInstance().Stop();
+    storage::IndexTransferService::GetInstance().Stop();
     storage::S3ClientWrapper::GetInstance().StopService();
     web::WebServer::GetInstance().Stop();
     grpc::GrpcServer::GetInstance().Stop();
     DBWrapper::GetInstance().StopService();
+
+    // with the db quiesced the cache is stable; hand its contents to the
+    // next process over shared memory
+    std::string primary_path;
+    Config::GetInstance().GetStorageConfigPrimaryPath(primary_path);
+    Status handoff_status = cache::CacheHandoff::GetInstance().SaveState(primary_path + "/cache_handoff");
+    if (!handoff_status.ok()) {
+        SERVER_LOG_ERROR << "Cache handoff save fail: " << handoff_status.message();
+    }
+
     scheduler::StopSchedulerService();
     engine::KnowhereResource::Finalize();
 }
@@ -14,6 +14,12 @@
 namespace milvus {
 namespace server {
 
+namespace {
+// one query in this many carries the full stage breakdown; the rest skip
+// all profile bookkeeping, which bounds the overhead of always-on profiling
+constexpr int64_t QUERY_PROFILE_SAMPLE_RATE = 64;
+}  // namespace
+
 Context::Context(const std::string& request_id) : request_id_(request_id) {
 }
 
@@ -22,6 +28,11 @@ Context::GetTraceContext() const {
     return trace_context_;
 }
 
+const std::string&
+Context::GetRequestID() const {
+    return request_id_;
+}
+
 void
 Context::SetTraceContext(const std::shared_ptr<tracing::TraceContext>& trace_context) {
     trace_context_ = trace_context;
@@ -30,6 +41,12 @@ std::shared_ptr<Context>
 Context::Child(const std::string& operation_name) const {
     auto new_context = std::make_shared<Context>(request_id_);
     new_context->SetTraceContext(trace_context_->Child(operation_name));
+    new_context->client_tag_ = client_tag_;
+    new_context->deadline_ = deadline_;
+    new_context->cancelled_ = cancelled_;
+    new_context->profile_ = profile_;
+    new_context->attr_filter_ = attr_filter_;
+    new_context->mem_accountant_ = mem_accountant_;
     return new_context;
 }
 
@@ -37,8 +54,85 @@ std::shared_ptr<Context>
 Context::Follower(const std::string& operation_name) const {
     auto new_context = std::make_shared<Context>(request_id_);
     new_context->SetTraceContext(trace_context_->Follower(operation_name));
+    new_context->client_tag_ = client_tag_;
+    new_context->deadline_ = deadline_;
+    new_context->cancelled_ = cancelled_;
+    new_context->profile_ = profile_;
+    new_context->attr_filter_ = attr_filter_;
+    new_context->mem_accountant_ = mem_accountant_;
     return new_context;
 }
 
+void
+Context::SetDeadline(std::chrono::system_clock::time_point deadline) {
+    deadline_ = deadline;
+}
+
+bool
+Context::IsTimeExceeded() const {
+    return std::chrono::system_clock::now() > deadline_;
+}
+
+void
+Context::Cancel() {
+    cancelled_->store(true);
+}
+
+bool
+Context::IsCancelled() const {
+    return cancelled_->load();
+}
+
+void
+Context::SetClientTag(const std::string& client_tag) {
+    client_tag_ = client_tag;
+}
+
+const std::string&
+Context::GetClientTag() const {
+    return client_tag_;
+}
+
+void
+Context::MaybeEnableProfiling() {
+    static std::atomic<int64_t> request_counter{0};
+    if (request_counter.fetch_add(1, std::memory_order_relaxed) % QUERY_PROFILE_SAMPLE_RATE == 0) {
+        profile_ = std::make_shared<QueryProfile>();
+    }
+}
+
+void
+Context::EnableProfiling() {
+    if (profile_ == nullptr) {
+        profile_ = std::make_shared<QueryProfile>();
+    }
+}
+
+const QueryProfilePtr&
+Context::GetProfile() const {
+    return profile_;
+}
+
+void
+Context::SetAttrFilter(const std::shared_ptr<engine::AttributeFilter>& attr_filter) {
+    attr_filter_ = attr_filter;
+}
+
+const std::shared_ptr<engine::AttributeFilter>&
+Context::GetAttrFilter() const {
+    return attr_filter_;
+}
+
+
+void
+Context::SetMemoryAccountant(const MemoryAccountantPtr& accountant) {
+    mem_accountant_ = accountant;
+}
+
+const MemoryAccountantPtr&
+Context::GetMemoryAccountant() const {
+    return mem_accountant_;
+}
+
 }  // namespace server
 }  // namespace milvus
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -18,8 +20,71 @@
 #include "tracing/TraceContext.h"
 
 namespace milvus {
+
+namespace engine {
+struct AttributeFilter;
+}  // namespace engine
+
 namespace server {
 
+// Per-request latency breakdown accumulated as integer nanoseconds by the
+// stages a query passes through. Only sampled requests allocate one, so the
+// unsampled hot path pays a single null check per accumulation site instead
+// of clock reads and string formatting.
+struct QueryProfile {
+    std::atomic<int64_t> queue_wait_ns_{0};
+    std::atomic<int64_t> load_ns_{0};
+    std::atomic<int64_t> search_ns_{0};
+    std::atomic<int64_t> reduce_ns_{0};
+    std::atomic<int64_t> serialize_ns_{0};
+};
+
+using QueryProfilePtr = std::shared_ptr<QueryProfile>;
+
+// Request-scoped memory budget, shared into Child/Follower contexts like the
+// cancellation flag. Result-buffer allocations charge it up front; a charge
+// that would overrun the budget fails, so a pathological nq*topk request dies
+// with a per-request error instead of OOM-killing the node. Only attached
+// when engine_config.search_mem_budget is set.
+class MemoryAccountant {
+ public:
+    explicit MemoryAccountant(int64_t budget) : budget_(budget) {
+    }
+
+    // reserve `bytes` of the budget; false when it would be exceeded
+    bool
+    Charge(int64_t bytes) {
+        int64_t used = used_.load();
+        while (used + bytes <= budget_) {
+            if (used_.compare_exchange_weak(used, used + bytes)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void
+    Refund(int64_t bytes) {
+        used_.fetch_sub(bytes);
+    }
+
+    int64_t
+    Remaining() const {
+        return budget_ - used_.load();
+    }
+
+    int64_t
+    Budget() const {
+        return budget_;
+    }
+
+ private:
+    const int64_t budget_;
+    std::atomic<int64_t> used_{0};
+};
+
+using MemoryAccountantPtr = std::shared_ptr<MemoryAccountant>;
+
 class Context {
  public:
     explicit Context(const std::string& request_id);
@@ -36,9 +101,78 @@ class Context {
     const std::shared_ptr<tracing::TraceContext>&
     GetTraceContext() const;
 
+    // id of the originating client call, carried into Child/Follower contexts
+    // so scheduler log lines can be grepped back to one request
+    const std::string&
+    GetRequestID() const;
+
+    /*
+     * Deadline and cancellation, propagated from the client request into
+     * derived contexts so the scheduler can drop work nobody will read.
+     */
+    void
+    SetDeadline(std::chrono::system_clock::time_point deadline);
+
+    // false while no deadline was set
+    bool
+    IsTimeExceeded() const;
+
+    void
+    Cancel();
+
+    bool
+    IsCancelled() const;
+
+    // identity the client reported in its rpc metadata; empty when untagged
+    void
+    SetClientTag(const std::string& client_tag);
+
+    const std::string&
+    GetClientTag() const;
+
+    // attaches a QueryProfile to roughly one request in
+    // QUERY_PROFILE_SAMPLE_RATE; the profile is shared into Child/Follower
+    // contexts like the cancellation flag
+    void
+    MaybeEnableProfiling();
+
+    // unconditionally attach a QueryProfile, e.g. so the slow-query log can
+    // break down every request instead of one in QUERY_PROFILE_SAMPLE_RATE
+    void
+    EnableProfiling();
+
+    // nullptr for unsampled requests
+    const QueryProfilePtr&
+    GetProfile() const;
+
+    // attribute predicates of a filtered search, shared into Child/Follower
+    // contexts so the per-segment search tasks can push them into the scan
+    void
+    SetAttrFilter(const std::shared_ptr<engine::AttributeFilter>& attr_filter);
+
+    // nullptr for unfiltered requests
+    const std::shared_ptr<engine::AttributeFilter>&
+    GetAttrFilter() const;
+
+    // request-scoped memory budget, shared into Child/Follower contexts
+    void
+    SetMemoryAccountant(const MemoryAccountantPtr& accountant);
+
+    // nullptr when no budget is configured
+    const MemoryAccountantPtr&
+    GetMemoryAccountant() const;
+
  private:
     std::string request_id_;
+    std::string client_tag_;
     std::shared_ptr<tracing::TraceContext> trace_context_;
+
+    std::chrono::system_clock::time_point deadline_ = std::chrono::system_clock::time_point::max();
+    // shared across Child/Follower contexts of one request
+    std::shared_ptr<std::atomic<bool>> cancelled_ = std::make_shared<std::atomic<bool>>(false);
+    QueryProfilePtr profile_;
+    std::shared_ptr<engine::AttributeFilter> attr_filter_;
+    MemoryAccountantPtr mem_accountant_;
 };
 
 }  // namespace server
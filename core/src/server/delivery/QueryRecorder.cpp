@@ -0,0 +1,133 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/QueryRecorder.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace milvus {
+namespace server {
+
+namespace {
+constexpr char MAGIC[4] = {'M', 'Q', 'R', 'L'};
+constexpr uint32_t VERSION = 1;
+
+template <typename T>
+void
+WriteValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+}  // namespace
+
+QueryRecorder&
+QueryRecorder::GetInstance() {
+    static QueryRecorder recorder;
+    return recorder;
+}
+
+QueryRecorder::QueryRecorder() {
+    Config& config = Config::GetInstance();
+    float fraction = 0.0f;
+    config.GetServerConfigQueryRecordFraction(fraction);
+    if (fraction <= 0.0f) {
+        return;
+    }
+
+    sample_interval_ = std::max<int64_t>(1, std::lround(1.0 / fraction));
+
+    std::string primary_path;
+    config.GetStorageConfigPrimaryPath(primary_path);
+    log_path_ = primary_path + "/query_record.bin";
+    SERVER_LOG_INFO << "Query recording enabled: 1 in " << sample_interval_ << " searches logged to " << log_path_;
+}
+
+QueryRecorder::~QueryRecorder() {
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    if (file_.is_open()) {
+        file_.close();
+    }
+}
+
+bool
+QueryRecorder::EnsureOpen() {
+    if (file_.is_open()) {
+        return true;
+    }
+
+    // append so a restart continues an existing log; the header is only
+    // written when the file starts empty
+    file_.open(log_path_, std::ios::binary | std::ios::app);
+    if (!file_.is_open()) {
+        SERVER_LOG_ERROR << "Failed to open query record log: " << log_path_;
+        sample_interval_ = 0;  // don't retry on every sampled search
+        return false;
+    }
+
+    if (file_.tellp() == 0) {
+        file_.write(MAGIC, sizeof(MAGIC));
+        WriteValue(file_, VERSION);
+    }
+    return true;
+}
+
+void
+QueryRecorder::Record(const std::string& table_id, const engine::VectorsData& vectors, int64_t topk, int64_t nprobe) {
+    if (sample_interval_ <= 0) {
+        return;
+    }
+
+    if (request_counter_.fetch_add(1) % static_cast<uint64_t>(sample_interval_) != 0) {
+        return;
+    }
+
+    uint8_t is_binary = vectors.BinaryDataSize() > 0 ? 1 : 0;
+    const char* payload;
+    uint64_t payload_bytes;
+    if (is_binary) {
+        payload = reinterpret_cast<const char*>(vectors.BinaryData());
+        payload_bytes = vectors.BinaryDataSize();
+    } else {
+        payload = reinterpret_cast<const char*>(vectors.FloatData());
+        payload_bytes = vectors.FloatDataSize() * sizeof(float);
+    }
+    if (payload_bytes == 0) {
+        return;
+    }
+
+    auto timestamp_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count());
+
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    if (!EnsureOpen()) {
+        return;
+    }
+
+    WriteValue(file_, timestamp_us);
+    auto table_len = static_cast<uint16_t>(table_id.size());
+    WriteValue(file_, table_len);
+    file_.write(table_id.data(), table_len);
+    WriteValue(file_, topk);
+    WriteValue(file_, nprobe);
+    WriteValue(file_, is_binary);
+    auto nq = static_cast<uint32_t>(vectors.vector_count_);
+    WriteValue(file_, nq);
+    WriteValue(file_, payload_bytes);
+    file_.write(payload, payload_bytes);
+    file_.flush();
+}
+
+}  // namespace server
+}  // namespace milvus
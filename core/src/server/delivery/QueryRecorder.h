@@ -0,0 +1,71 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Types.h"
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace milvus {
+namespace server {
+
+// Samples live SearchRequests into a compact binary log so production traffic
+// can be replayed against a candidate config (tests/milvus_benchmark/replay.py
+// reads the log and re-issues the searches at original or scaled rate). A
+// deterministic 1-in-N counter keeps the recording overhead proportional to
+// server_config.query_record_fraction; 0.0 (the default) disables recording
+// entirely. The log lives next to the data under storage primary_path.
+//
+// File layout (all integers little-endian, native byte order of the server):
+//   header: magic "MQRL", uint32 version (currently 1)
+//   record: uint64 timestamp_us   wall clock of the request, microseconds
+//           uint16 table_len      followed by that many table name bytes
+//           int64  topk
+//           int64  nprobe
+//           uint8  is_binary      1 = binary vectors, 0 = float vectors
+//           uint32 nq             query vector count
+//           uint64 payload_bytes  followed by the raw vector payload
+//                                 (nq * dim floats, or nq * dim / 8 bytes)
+class QueryRecorder {
+ public:
+    static QueryRecorder&
+    GetInstance();
+
+    bool
+    Enabled() const {
+        return sample_interval_ > 0;
+    }
+
+    // append the search to the log if the sampling counter selects it
+    void
+    Record(const std::string& table_id, const engine::VectorsData& vectors, int64_t topk, int64_t nprobe);
+
+ private:
+    QueryRecorder();
+    ~QueryRecorder();
+
+    bool
+    EnsureOpen();
+
+ private:
+    int64_t sample_interval_ = 0;  // record every Nth search; 0 disables
+    std::atomic<uint64_t> request_counter_{0};
+    std::mutex file_mutex_;
+    std::ofstream file_;
+    std::string log_path_;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,142 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/QueryResultCache.h"
+#include "cache/CpuCacheMgr.h"
+#include "db/MetaEventBus.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+
+#include <memory>
+
+namespace milvus {
+namespace server {
+
+namespace {
+// FNV-1a over the query vector bytes. A collision only costs a wasted lookup:
+// the rest of the key still spells out table, version and parameters
+uint64_t
+HashBytes(const void* data, uint64_t size) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint64_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+struct QueryResultObj : public cache::DataObj {
+    int64_t row_num_ = 0;
+    engine::ResultIds ids_;
+    engine::ResultDistances distances_;
+
+    int64_t
+    Size() override {
+        return static_cast<int64_t>(ids_.size() * sizeof(engine::ResultIds::value_type) +
+                                    distances_.size() * sizeof(engine::ResultDistances::value_type));
+    }
+
+    // a dropped entry is recomputed by a full search, not a disk read; bias
+    // the evictor toward keeping results over same-sized raw segments
+    int64_t
+    ReloadCost() override {
+        return Size() * 4;
+    }
+};
+
+}  // namespace
+
+QueryResultCache&
+QueryResultCache::GetInstance() {
+    static QueryResultCache cache;
+    return cache;
+}
+
+QueryResultCache::QueryResultCache() {
+    Config& config = Config::GetInstance();
+    config.GetCacheConfigQueryResultCacheEnable(enabled_);
+    if (enabled_) {
+        meta_event_subscription_ = engine::MetaEventBus::GetInstance().Subscribe(
+            [this](engine::MetaEvent event, const std::string& table_id) {
+                if (event == engine::MetaEvent::FLUSH_COMPLETED) {
+                    BumpVersion(table_id);
+                }
+            });
+        SERVER_LOG_INFO << "Query result cache enabled";
+    }
+}
+
+QueryResultCache::~QueryResultCache() {
+    if (meta_event_subscription_ >= 0) {
+        engine::MetaEventBus::GetInstance().Unsubscribe(meta_event_subscription_);
+    }
+}
+
+std::string
+QueryResultCache::MakeKey(const std::string& table_id, const engine::VectorsData& vectors, int64_t topk,
+                          int64_t nprobe, const std::vector<std::string>& partition_list) {
+    uint64_t hash = 0;
+    if (vectors.FloatDataSize() > 0) {
+        hash = HashBytes(vectors.FloatData(), vectors.FloatDataSize() * sizeof(float));
+    } else if (vectors.BinaryDataSize() > 0) {
+        hash = HashBytes(vectors.BinaryData(), vectors.BinaryDataSize());
+    } else {
+        return "";
+    }
+
+    std::string key = "qrc/" + table_id + "/v" + std::to_string(TableVersion(table_id)) + "/k" +
+                      std::to_string(topk) + "/n" + std::to_string(nprobe) + "/h" + std::to_string(hash);
+    for (auto& partition : partition_list) {
+        key += "/p" + partition;
+    }
+    return key;
+}
+
+bool
+QueryResultCache::Get(const std::string& key, int64_t& row_num, engine::ResultIds& ids,
+                      engine::ResultDistances& distances) {
+    auto obj = cache::CpuCacheMgr::GetInstance()->GetItem(key);
+    auto result = std::static_pointer_cast<QueryResultObj>(obj);
+    if (result == nullptr) {
+        return false;
+    }
+
+    row_num = result->row_num_;
+    ids = result->ids_;
+    distances = result->distances_;
+    return true;
+}
+
+void
+QueryResultCache::Put(const std::string& key, int64_t row_num, const engine::ResultIds& ids,
+                      const engine::ResultDistances& distances) {
+    auto result = std::make_shared<QueryResultObj>();
+    result->row_num_ = row_num;
+    result->ids_ = ids;
+    result->distances_ = distances;
+    cache::CpuCacheMgr::GetInstance()->InsertItem(key, result);
+}
+
+void
+QueryResultCache::BumpVersion(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(version_mutex_);
+    table_versions_[table_id]++;
+}
+
+int64_t
+QueryResultCache::TableVersion(const std::string& table_id) {
+    std::lock_guard<std::mutex> lock(version_mutex_);
+    return table_versions_[table_id];
+}
+
+}  // namespace server
+}  // namespace milvus
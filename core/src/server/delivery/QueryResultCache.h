@@ -0,0 +1,74 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Types.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+// Optional cache of complete query results. Retry storms and pagination
+// refreshes repeat the exact same search within seconds; a hit hands back the
+// stored ids/distances and skips the scheduler round trip and segment scans
+// entirely. The key covers table, query vector bytes, topk, nprobe and the
+// partition set, plus a per-table data version that a completed flush bumps
+// (subscribed on the MetaEventBus), so new data orphans stale entries rather
+// than serving them. Entries live in the CpuCacheMgr: their memory is charged
+// against cpu_cache_capacity and stale or cold results age out through the
+// normal LRU. Disabled unless cache_config.query_result_cache_enable is set.
+class QueryResultCache {
+ public:
+    static QueryResultCache&
+    GetInstance();
+
+    bool
+    Enabled() const {
+        return enabled_;
+    }
+
+    // build the cache key for a search shape; empty string means not cacheable
+    std::string
+    MakeKey(const std::string& table_id, const engine::VectorsData& vectors, int64_t topk, int64_t nprobe,
+            const std::vector<std::string>& partition_list);
+
+    bool
+    Get(const std::string& key, int64_t& row_num, engine::ResultIds& ids, engine::ResultDistances& distances);
+
+    void
+    Put(const std::string& key, int64_t row_num, const engine::ResultIds& ids,
+        const engine::ResultDistances& distances);
+
+    // invalidate every cached result of a table by moving its version forward
+    void
+    BumpVersion(const std::string& table_id);
+
+ private:
+    QueryResultCache();
+    ~QueryResultCache();
+
+    int64_t
+    TableVersion(const std::string& table_id);
+
+ private:
+    bool enabled_ = false;
+    std::mutex version_mutex_;
+    std::map<std::string, int64_t> table_versions_;
+    int64_t meta_event_subscription_ = -1;
+};
+
+}  // namespace server
+}  // namespace milvus
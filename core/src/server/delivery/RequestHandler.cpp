@@ -18,15 +18,22 @@
 #include "server/delivery/request/CreatePartitionRequest.h"
 #include "server/delivery/request/CreateTableRequest.h"
 #include "server/delivery/request/DeleteByDateRequest.h"
+#include "server/delivery/request/DeleteByIDRequest.h"
 #include "server/delivery/request/DescribeIndexRequest.h"
 #include "server/delivery/request/DescribeTableRequest.h"
+#include "server/delivery/request/DescribeTableStatsRequest.h"
 #include "server/delivery/request/DropIndexRequest.h"
 #include "server/delivery/request/DropPartitionRequest.h"
 #include "server/delivery/request/DropTableRequest.h"
+#include "server/delivery/request/ExportTableRequest.h"
+#include "server/delivery/request/GetVectorsByIDRequest.h"
 #include "server/delivery/request/HasTableRequest.h"
 #include "server/delivery/request/InsertRequest.h"
 #include "server/delivery/request/PreloadTableRequest.h"
+#include "server/delivery/request/RangeSearchRequest.h"
+#include "server/delivery/request/SearchPagedRequest.h"
 #include "server/delivery/request/SearchRequest.h"
+#include "server/delivery/request/SearchStreamRequest.h"
 #include "server/delivery/request/ShowPartitionsRequest.h"
 #include "server/delivery/request/ShowTablesRequest.h"
 
@@ -98,6 +105,63 @@ RequestHandler::Search(const std::shared_ptr<Context>& context, const std::strin
     return request_ptr->status();
 }
 
+Status
+RequestHandler::SearchStream(const std::shared_ptr<Context>& context, const std::string& table_name,
+                             const engine::VectorsData& vectors,
+                             const std::vector<std::pair<std::string, std::string>>& range_list, int64_t topk,
+                             int64_t nprobe, const std::vector<std::string>& partition_list,
+                             const std::function<bool(const TopKQueryResult&)>& writer) {
+    BaseRequestPtr request_ptr =
+        SearchStreamRequest::Create(context, table_name, vectors, range_list, topk, nprobe, partition_list, writer);
+    RequestScheduler::ExecRequest(request_ptr);
+
+    return request_ptr->status();
+}
+
+Status
+RequestHandler::SearchPaged(const std::shared_ptr<Context>& context, const std::string& table_name,
+                            const engine::VectorsData& vectors, int64_t topk, int64_t nprobe,
+                            const std::vector<std::string>& partition_list, int64_t page_size, std::string& token,
+                            TopKQueryResult& result) {
+    BaseRequestPtr request_ptr =
+        SearchPagedRequest::Create(context, table_name, vectors, topk, nprobe, partition_list, page_size, token,
+                                   result);
+    RequestScheduler::ExecRequest(request_ptr);
+
+    return request_ptr->status();
+}
+
+Status
+RequestHandler::RangeSearch(const std::shared_ptr<Context>& context, const std::string& table_name,
+                            const engine::VectorsData& vectors, float radius, int64_t topk, int64_t nprobe,
+                            const std::vector<std::string>& partition_list,
+                            const std::function<bool(const TopKQueryResult&)>& writer) {
+    BaseRequestPtr request_ptr =
+        RangeSearchRequest::Create(context, table_name, vectors, radius, topk, nprobe, partition_list, writer);
+    RequestScheduler::ExecRequest(request_ptr);
+
+    return request_ptr->status();
+}
+
+Status
+RequestHandler::ExportTable(
+    const std::shared_ptr<Context>& context, const std::string& table_name,
+    const std::function<bool(int64_t count, int64_t dim, const float* vectors, const int64_t* ids)>& writer) {
+    BaseRequestPtr request_ptr = ExportTableRequest::Create(context, table_name, writer);
+    RequestScheduler::ExecRequest(request_ptr);
+
+    return request_ptr->status();
+}
+
+Status
+RequestHandler::GetVectorsByID(const std::shared_ptr<Context>& context, const std::string& table_name,
+                               const std::vector<int64_t>& id_array, std::vector<engine::VectorsData>& vectors) {
+    BaseRequestPtr request_ptr = GetVectorsByIDRequest::Create(context, table_name, id_array, vectors);
+    RequestScheduler::ExecRequest(request_ptr);
+
+    return request_ptr->status();
+}
+
 Status
 RequestHandler::DescribeTable(const std::shared_ptr<Context>& context, const std::string& table_name,
                               TableSchema& table_schema) {
@@ -115,6 +179,16 @@ RequestHandler::CountTable(const std::shared_ptr<Context>& context, const std::s
     return request_ptr->status();
 }
 
+Status
+RequestHandler::DescribeTableStats(const std::shared_ptr<Context>& context, const std::string& table_name,
+                                   engine::meta::TableStats& total,
+                                   std::vector<std::pair<std::string, engine::meta::TableStats>>& partition_stats) {
+    BaseRequestPtr request_ptr = DescribeTableStatsRequest::Create(context, table_name, total, partition_stats);
+    RequestScheduler::ExecRequest(request_ptr);
+
+    return request_ptr->status();
+}
+
 Status
 RequestHandler::Cmd(const std::shared_ptr<Context>& context, const std::string& cmd, std::string& reply) {
     BaseRequestPtr request_ptr = CmdRequest::Create(context, cmd, reply);
@@ -133,8 +207,20 @@ RequestHandler::DeleteByRange(const std::shared_ptr<Context>& context, const std
 }
 
 Status
-RequestHandler::PreloadTable(const std::shared_ptr<Context>& context, const std::string& table_name) {
-    BaseRequestPtr request_ptr = PreloadTableRequest::Create(context, table_name);
+RequestHandler::DeleteByID(const std::shared_ptr<Context>& context, const std::string& table_name,
+                           const std::vector<int64_t>& id_array) {
+    BaseRequestPtr request_ptr = DeleteByIDRequest::Create(context, table_name, id_array);
+    RequestScheduler::ExecRequest(request_ptr);
+
+    return request_ptr->status();
+}
+
+Status
+RequestHandler::PreloadTable(const std::shared_ptr<Context>& context, const std::string& table_name, bool pin,
+                             int64_t priority, const std::vector<std::string>& partition_tags,
+                             const std::vector<Range>& range_list) {
+    BaseRequestPtr request_ptr = PreloadTableRequest::Create(context, table_name, pin, priority, partition_tags,
+                                                             range_list);
     RequestScheduler::ExecRequest(request_ptr);
 
     return request_ptr->status();
@@ -14,6 +14,7 @@
 #include "server/delivery/request/BaseRequest.h"
 #include "utils/Status.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -53,12 +54,43 @@ class RequestHandler {
            const std::vector<std::string>& partition_list, const std::vector<std::string>& file_id_list,
            TopKQueryResult& result);
 
+    Status
+    SearchStream(const std::shared_ptr<Context>& context, const std::string& table_name,
+                 const engine::VectorsData& vectors, const std::vector<Range>& range_list, int64_t topk, int64_t nprobe,
+                 const std::vector<std::string>& partition_list,
+                 const std::function<bool(const TopKQueryResult&)>& writer);
+
+    Status
+    SearchPaged(const std::shared_ptr<Context>& context, const std::string& table_name,
+                const engine::VectorsData& vectors, int64_t topk, int64_t nprobe,
+                const std::vector<std::string>& partition_list, int64_t page_size, std::string& token,
+                TopKQueryResult& result);
+
+    Status
+    RangeSearch(const std::shared_ptr<Context>& context, const std::string& table_name,
+                const engine::VectorsData& vectors, float radius, int64_t topk, int64_t nprobe,
+                const std::vector<std::string>& partition_list,
+                const std::function<bool(const TopKQueryResult&)>& writer);
+
+    Status
+    ExportTable(const std::shared_ptr<Context>& context, const std::string& table_name,
+                const std::function<bool(int64_t count, int64_t dim, const float* vectors, const int64_t* ids)>& writer);
+
+    Status
+    GetVectorsByID(const std::shared_ptr<Context>& context, const std::string& table_name,
+                   const std::vector<int64_t>& id_array, std::vector<engine::VectorsData>& vectors);
+
     Status
     DescribeTable(const std::shared_ptr<Context>& context, const std::string& table_name, TableSchema& table_schema);
 
     Status
     CountTable(const std::shared_ptr<Context>& context, const std::string& table_name, int64_t& count);
 
+    Status
+    DescribeTableStats(const std::shared_ptr<Context>& context, const std::string& table_name,
+                       engine::meta::TableStats& total,
+                       std::vector<std::pair<std::string, engine::meta::TableStats>>& partition_stats);
+
     Status
     Cmd(const std::shared_ptr<Context>& context, const std::string& cmd, std::string& reply);
 
@@ -66,7 +98,13 @@ class RequestHandler {
     DeleteByRange(const std::shared_ptr<Context>& context, const std::string& table_name, const Range& range);
 
     Status
-    PreloadTable(const std::shared_ptr<Context>& context, const std::string& table_name);
+    DeleteByID(const std::shared_ptr<Context>& context, const std::string& table_name,
+               const std::vector<int64_t>& id_array);
+
+    Status
+    PreloadTable(const std::shared_ptr<Context>& context, const std::string& table_name, bool pin = false,
+                 int64_t priority = 0, const std::vector<std::string>& partition_tags = std::vector<std::string>(),
+                 const std::vector<Range>& range_list = std::vector<Range>());
 
     Status
     DescribeIndex(const std::shared_ptr<Context>& context, const std::string& table_name, IndexParam& param);
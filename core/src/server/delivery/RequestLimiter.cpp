@@ -0,0 +1,108 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/RequestLimiter.h"
+#include "metrics/Metrics.h"
+#include "server/Config.h"
+#include "server/delivery/request/SearchRequest.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace milvus {
+namespace server {
+
+RequestLimiter&
+RequestLimiter::GetInstance() {
+    static RequestLimiter limiter;
+    return limiter;
+}
+
+RequestLimiter::RequestLimiter() {
+    Config& config = Config::GetInstance();
+    Status s = config.GetServerConfigClientRateLimit(client_rate_);
+    if (!s.ok()) {
+        client_rate_ = 0;
+    }
+    s = config.GetServerConfigTableRateLimit(table_rate_);
+    if (!s.ok()) {
+        table_rate_ = 0;
+    }
+
+    if (client_rate_ > 0) {
+        SERVER_LOG_INFO << "RequestLimiter client rate limit = " << client_rate_ << " req/s";
+    }
+    if (table_rate_ > 0) {
+        SERVER_LOG_INFO << "RequestLimiter table rate limit = " << table_rate_ << " req/s";
+    }
+}
+
+bool
+RequestLimiter::TakeToken(TokenBucket& bucket, int64_t rate) {
+    auto now = std::chrono::steady_clock::now();
+    if (bucket.last_refill_ == std::chrono::steady_clock::time_point()) {
+        // new bucket starts full
+        bucket.tokens_ = static_cast<double>(rate);
+    } else {
+        double elapsed = std::chrono::duration<double>(now - bucket.last_refill_).count();
+        bucket.tokens_ = std::min(bucket.tokens_ + elapsed * rate, static_cast<double>(rate));
+    }
+    bucket.last_refill_ = now;
+
+    if (bucket.tokens_ < 1.0) {
+        return false;
+    }
+    bucket.tokens_ -= 1.0;
+    return true;
+}
+
+Status
+RequestLimiter::Admit(const BaseRequestPtr& request) {
+    if (request == nullptr || (client_rate_ <= 0 && table_rate_ <= 0)) {
+        return Status::OK();
+    }
+
+    if (client_rate_ > 0) {
+        std::string client_tag;
+        if (request->GetContext() != nullptr) {
+            client_tag = request->GetContext()->GetClientTag();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!TakeToken(client_buckets_[client_tag], client_rate_)) {
+            Metrics::GetInstance().RequestShedTotalIncrement("client_rate");
+            SERVER_LOG_WARNING << "Shed request from client '" << client_tag << "': client rate limit exceeded";
+            return Status(SERVER_REQUEST_OVERLOAD,
+                          "Request rate limit exceeded for this client. Please retry later.");
+        }
+    }
+
+    if (table_rate_ > 0) {
+        auto search_request = std::dynamic_pointer_cast<SearchRequest>(request);
+        if (search_request != nullptr) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!TakeToken(table_buckets_[search_request->TableName()], table_rate_)) {
+                Metrics::GetInstance().RequestShedTotalIncrement("table_rate");
+                SERVER_LOG_WARNING << "Shed search on table " << search_request->TableName()
+                                   << ": table rate limit exceeded";
+                return Status(SERVER_REQUEST_OVERLOAD,
+                              "Search rate limit exceeded for table " + search_request->TableName() +
+                                  ". Please retry later.");
+            }
+        }
+    }
+
+    return Status::OK();
+}
+
+}  // namespace server
+}  // namespace milvus
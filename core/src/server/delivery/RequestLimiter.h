@@ -0,0 +1,70 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "server/delivery/request/BaseRequest.h"
+#include "utils/Status.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace milvus {
+namespace server {
+
+// Opt-in admission control at the request scheduler. Two independent token
+// buckets, both in requests per second and both disabled at 0 (the default):
+//
+//  - server_config.client_rate_limit caps each client, keyed by the
+//    "client_tag" the client reports in its rpc metadata. Untagged clients
+//    share one bucket; tagging the clients is part of enabling the limit.
+//  - server_config.table_rate_limit caps searches against one table, so a hot
+//    table cannot starve queries on the others. Only requests exposing a
+//    table name at the delivery layer (SearchRequest) are counted.
+//
+// Shed requests fail fast with SERVER_REQUEST_OVERLOAD and are counted in the
+// request_shed_total metric. Buckets hold at most one second of budget, so a
+// burst after an idle period cannot overshoot the configured rate.
+class RequestLimiter {
+ public:
+    static RequestLimiter&
+    GetInstance();
+
+    // Returns a non-ok status when the request must be shed; the caller is
+    // responsible for delivering that status without executing the request.
+    Status
+    Admit(const BaseRequestPtr& request);
+
+ private:
+    RequestLimiter();
+
+    struct TokenBucket {
+        double tokens_ = 0.0;
+        std::chrono::steady_clock::time_point last_refill_;
+    };
+
+    // refill by elapsed time and take one token; false when the bucket is dry
+    bool
+    TakeToken(TokenBucket& bucket, int64_t rate);
+
+ private:
+    int64_t client_rate_ = 0;  // requests per second per client tag, 0 disables
+    int64_t table_rate_ = 0;   // searches per second per table, 0 disables
+
+    std::mutex mutex_;
+    std::map<std::string, TokenBucket> client_buckets_;
+    std::map<std::string, TokenBucket> table_buckets_;
+};
+
+}  // namespace server
+}  // namespace milvus
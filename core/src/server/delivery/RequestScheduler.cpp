@@ -10,15 +10,35 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/RequestScheduler.h"
+#include "metrics/Metrics.h"
+#include "server/delivery/RequestLimiter.h"
+#include "server/delivery/SearchCombiner.h"
 #include "utils/Log.h"
 
 #include <fiu-local.h>
 #include <unistd.h>
+#include <algorithm>
 #include <utility>
 
 namespace milvus {
 namespace server {
 
+namespace {
+// each request group is an independent lane with its own worker pool, so a
+// slow info request (CountTable walking the meta) can no longer stall
+// searches queued behind it. Queries fan out across cores; DDL/DML keeps a
+// single worker because meta mutations and inserts rely on queue order
+int64_t
+GroupWorkerCount(const std::string& group_name) {
+    if (group_name == DQL_REQUEST_GROUP) {
+        return std::max(static_cast<int64_t>(std::thread::hardware_concurrency()), static_cast<int64_t>(1));
+    } else if (group_name == INFO_REQUEST_GROUP) {
+        return 2;
+    }
+    return 1;
+}
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 RequestScheduler::RequestScheduler() : stopped_(false) {
     Start();
@@ -58,11 +78,15 @@ RequestScheduler::Stop() {
     }
 
     SERVER_LOG_INFO << "Scheduler gonna stop...";
+    SearchCombiner::GetInstance().Stop();
     {
         std::lock_guard<std::mutex> lock(queue_mtx_);
         for (auto& iter : request_groups_) {
             if (iter.second != nullptr) {
-                iter.second->Put(nullptr);
+                int64_t workers = std::max(group_worker_count_[iter.first], static_cast<int64_t>(1));
+                for (int64_t i = 0; i < workers; ++i) {
+                    iter.second->Put(nullptr);
+                }
             }
         }
     }
@@ -73,6 +97,7 @@ RequestScheduler::Stop() {
         iter->join();
     }
     request_groups_.clear();
+    group_worker_count_.clear();
     execute_threads_.clear();
     stopped_ = true;
     SERVER_LOG_INFO << "Scheduler stopped";
@@ -84,11 +109,33 @@ RequestScheduler::ExecuteRequest(const BaseRequestPtr& request_ptr) {
         return Status::OK();
     }
 
+    auto admit_status = RequestLimiter::GetInstance().Admit(request_ptr);
+    if (!admit_status.ok()) {
+        // fail fast; Abort unblocks the caller waiting on the request
+        request_ptr->Abort(admit_status);
+        return admit_status;
+    }
+
+    // a request whose client deadline already passed would only waste a worker
+    auto& context = request_ptr->GetContext();
+    if (context != nullptr && (context->IsCancelled() || context->IsTimeExceeded())) {
+        Metrics::GetInstance().RequestShedTotalIncrement("expired");
+        admit_status = Status(SERVER_REQUEST_OVERLOAD, "Request deadline passed before scheduling.");
+        request_ptr->Abort(admit_status);
+        return admit_status;
+    }
+
+    if (SearchCombiner::GetInstance().Combine(request_ptr)) {
+        // absorbed into a combine window; a SearchCombineRequest delivers the result
+        return request_ptr->WaitToFinish();
+    }
+
     auto status = PutToQueue(request_ptr);
     fiu_do_on("RequestScheduler.ExecuteRequest.push_queue_fail", status = Status(SERVER_INVALID_ARGUMENT, ""));
 
     if (!status.ok()) {
         SERVER_LOG_ERROR << "Put request to queue failed with code: " << status.ToString();
+        request_ptr->Abort(status);
         return status;
     }
 
@@ -111,6 +158,15 @@ RequestScheduler::TakeToExecute(RequestQueuePtr request_queue) {
             break;  // stop the thread
         }
 
+        // queued work may have expired while it waited; executing it anyway
+        // delays every request behind it for a result nobody will read
+        auto& context = request->GetContext();
+        if (context != nullptr && (context->IsCancelled() || context->IsTimeExceeded())) {
+            Metrics::GetInstance().RequestShedTotalIncrement("expired");
+            request->Abort(Status(SERVER_REQUEST_OVERLOAD, "Request deadline passed while queued."));
+            continue;
+        }
+
         try {
             fiu_do_on("RequestScheduler.TakeToExecute.throw_std_exception1", throw std::exception());
             auto status = request->Execute();
@@ -131,19 +187,36 @@ RequestScheduler::PutToQueue(const BaseRequestPtr& request_ptr) {
 
     std::string group_name = request_ptr->RequestGroup();
     if (request_groups_.count(group_name) > 0) {
-        request_groups_[group_name]->Put(request_ptr);
+        // queries are shed instead of queued once the backlog is full: they are
+        // idempotent and retryable, and accepting more than the workers can
+        // drain in time just converts overload into a wall of timeouts.
+        // DDL/DML keeps the blocking put so writes are delayed, never dropped
+        if (group_name == DQL_REQUEST_GROUP) {
+            if (!request_groups_[group_name]->TryPut(request_ptr)) {
+                Metrics::GetInstance().RequestShedTotalIncrement("queue_full");
+                SERVER_LOG_WARNING << "Shed request: " << group_name << " queue is full";
+                return Status(SERVER_REQUEST_OVERLOAD, "Server is overloaded. Please retry later.");
+            }
+        } else {
+            request_groups_[group_name]->Put(request_ptr);
+        }
     } else {
         RequestQueuePtr queue = std::make_shared<RequestQueue>();
         queue->Put(request_ptr);
         request_groups_.insert(std::make_pair(group_name, queue));
         fiu_do_on("RequestScheduler.PutToQueue.null_queue", queue = nullptr);
 
-        // start a thread
-        ThreadPtr thread = std::make_shared<std::thread>(&RequestScheduler::TakeToExecute, this, queue);
+        // start the group's worker pool; keep a few requests queued per worker
+        int64_t worker_count = GroupWorkerCount(group_name);
+        queue->SetCapacity(static_cast<size_t>(worker_count * 4));
+        group_worker_count_[group_name] = worker_count;
+        for (int64_t i = 0; i < worker_count; ++i) {
+            ThreadPtr thread = std::make_shared<std::thread>(&RequestScheduler::TakeToExecute, this, queue);
 
-        fiu_do_on("RequestScheduler.PutToQueue.push_null_thread", execute_threads_.push_back(nullptr));
-        execute_threads_.push_back(thread);
-        SERVER_LOG_INFO << "Create new thread for request group: " << group_name;
+            fiu_do_on("RequestScheduler.PutToQueue.push_null_thread", execute_threads_.push_back(nullptr));
+            execute_threads_.push_back(thread);
+        }
+        SERVER_LOG_INFO << "Create " << worker_count << " thread(s) for request group: " << group_name;
     }
 
     return Status::OK();
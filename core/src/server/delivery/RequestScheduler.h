@@ -64,6 +64,9 @@ class RequestScheduler {
 
     std::map<std::string, RequestQueuePtr> request_groups_;
 
+    // workers draining each group's queue; Stop() puts one terminator per worker
+    std::map<std::string, int64_t> group_worker_count_;
+
     std::vector<ThreadPtr> execute_threads_;
 
     bool stopped_;
@@ -0,0 +1,163 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/SearchCombiner.h"
+#include "server/Config.h"
+#include "server/delivery/RequestScheduler.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+// flush a batch early once it reaches this many query vectors
+static constexpr uint64_t COMBINE_MAX_NQ = 256;
+
+SearchCombiner&
+SearchCombiner::GetInstance() {
+    static SearchCombiner combiner;
+    return combiner;
+}
+
+SearchCombiner::SearchCombiner() {
+    Config& config = Config::GetInstance();
+    Status s = config.GetEngineConfigSearchCombineWindow(window_ms_);
+    if (!s.ok()) {
+        window_ms_ = 0;
+    }
+
+    if (window_ms_ > 0) {
+        SERVER_LOG_INFO << "SearchCombiner enabled, window = " << window_ms_ << " ms";
+        flush_thread_ = std::thread(&SearchCombiner::FlushLoop, this);
+    }
+}
+
+SearchCombiner::~SearchCombiner() {
+    Stop();
+}
+
+bool
+SearchCombiner::Combine(const BaseRequestPtr& request) {
+    if (window_ms_ <= 0) {
+        return false;
+    }
+
+    auto search_request = std::dynamic_pointer_cast<SearchRequest>(request);
+    if (!SearchCombineRequest::CanCombine(search_request)) {
+        return false;
+    }
+
+    SearchCombineRequestPtr full_batch = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            return false;
+        }
+
+        std::string key = search_request->TableName() + "/" + std::to_string(search_request->TopK()) + "/" +
+                          std::to_string(search_request->Nprobe());
+
+        auto iter = pending_.find(key);
+        if (iter == pending_.end()) {
+            PendingBatch batch;
+            batch.combine_request_ = std::make_shared<SearchCombineRequest>(search_request->GetContext());
+            batch.deadline_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(window_ms_);
+            iter = pending_.insert(std::make_pair(key, batch)).first;
+            cv_.notify_one();  // re-arm the flush timer
+        }
+
+        auto status = iter->second.combine_request_->AddRequest(search_request);
+        if (!status.ok()) {
+            return false;  // incompatible with the open batch, execute alone
+        }
+
+        if (iter->second.combine_request_->CombinedNq() >= COMBINE_MAX_NQ) {
+            full_batch = iter->second.combine_request_;
+            pending_.erase(iter);
+        }
+    }
+
+    if (full_batch != nullptr) {
+        RequestScheduler::GetInstance().ExecuteRequest(full_batch);
+    }
+    return true;
+}
+
+void
+SearchCombiner::FlushLoop() {
+    while (true) {
+        std::vector<SearchCombineRequestPtr> due_batches;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (pending_.empty()) {
+                cv_.wait(lock, [this] { return stopped_ || !pending_.empty(); });
+            } else {
+                auto next_deadline = pending_.begin()->second.deadline_;
+                for (auto& pair : pending_) {
+                    next_deadline = std::min(next_deadline, pair.second.deadline_);
+                }
+                cv_.wait_until(lock, next_deadline);
+            }
+
+            if (stopped_) {
+                return;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            for (auto iter = pending_.begin(); iter != pending_.end();) {
+                if (iter->second.deadline_ <= now) {
+                    due_batches.push_back(iter->second.combine_request_);
+                    iter = pending_.erase(iter);
+                } else {
+                    ++iter;
+                }
+            }
+        }
+
+        for (auto& batch : due_batches) {
+            SERVER_LOG_DEBUG << "SearchCombiner flush batch: " << batch->RequestCount()
+                             << " requests, nq=" << batch->CombinedNq();
+            RequestScheduler::GetInstance().ExecuteRequest(batch);
+        }
+    }
+}
+
+void
+SearchCombiner::Stop() {
+    std::vector<SearchCombineRequestPtr> remaining;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            return;
+        }
+        stopped_ = true;
+        for (auto& pair : pending_) {
+            remaining.push_back(pair.second.combine_request_);
+        }
+        pending_.clear();
+        cv_.notify_all();
+    }
+
+    if (flush_thread_.joinable()) {
+        flush_thread_.join();
+    }
+
+    // execute leftover batches inline so no caller is left hanging
+    for (auto& batch : remaining) {
+        batch->Execute();
+    }
+}
+
+}  // namespace server
+}  // namespace milvus
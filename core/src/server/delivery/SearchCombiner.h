@@ -0,0 +1,67 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "server/delivery/request/SearchCombineRequest.h"
+#include "utils/Status.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace milvus {
+namespace server {
+
+// Opt-in micro-batching of search requests: compatible searches (same table, topk,
+// nprobe) arriving within engine_config.search_combine_window milliseconds are coalesced
+// into one SearchCombineRequest. Disabled when the window is 0 (the default).
+class SearchCombiner {
+ public:
+    static SearchCombiner&
+    GetInstance();
+
+    // Returns true if the request was absorbed into a combine window; the result will be
+    // delivered by the SearchCombineRequest, so the caller only needs to wait on it.
+    bool
+    Combine(const BaseRequestPtr& request);
+
+    void
+    Stop();
+
+ private:
+    SearchCombiner();
+    ~SearchCombiner();
+
+    void
+    FlushLoop();
+
+ private:
+    struct PendingBatch {
+        SearchCombineRequestPtr combine_request_;
+        std::chrono::steady_clock::time_point deadline_;
+    };
+
+    int64_t window_ms_ = 0;  // 0 disables combining
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map<std::string, PendingBatch> pending_;  // key: table / topk / nprobe
+    std::thread flush_thread_;
+    bool stopped_ = false;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,126 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/SearchCursorMgr.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <utility>
+
+namespace milvus {
+namespace server {
+
+namespace {
+constexpr int64_t MAX_CURSOR_COUNT = 64;
+constexpr int64_t CURSOR_IDLE_SECONDS = 600;
+
+std::string
+GenerateToken() {
+    static std::mt19937_64 gen{std::random_device{}()};
+    std::ostringstream oss;
+    oss << std::hex << gen() << gen();
+    return oss.str();
+}
+}  // namespace
+
+SearchCursorMgr&
+SearchCursorMgr::GetInstance() {
+    static SearchCursorMgr instance;
+    return instance;
+}
+
+std::string
+SearchCursorMgr::Register(int64_t row_num, int64_t topk, engine::ResultIds&& ids,
+                          engine::ResultDistances&& distances) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SweepExpired();
+
+    // evict the least recently used cursor when full; its owner re-runs the query
+    while (static_cast<int64_t>(cursors_.size()) >= MAX_CURSOR_COUNT) {
+        auto oldest = cursors_.begin();
+        for (auto it = cursors_.begin(); it != cursors_.end(); ++it) {
+            if (it->second.last_access_ < oldest->second.last_access_) {
+                oldest = it;
+            }
+        }
+        SERVER_LOG_WARNING << "Evicting search cursor " << oldest->first << " to admit a new one";
+        cursors_.erase(oldest);
+    }
+
+    std::string token = GenerateToken();
+    Cursor& cursor = cursors_[token];
+    cursor.row_num_ = row_num;
+    cursor.topk_ = topk;
+    cursor.offset_ = 0;
+    cursor.ids_ = std::move(ids);
+    cursor.distances_ = std::move(distances);
+    cursor.last_access_ = std::chrono::steady_clock::now();
+    return token;
+}
+
+Status
+SearchCursorMgr::FetchPage(const std::string& token, int64_t page_size, TopKQueryResult& page,
+                           std::string& next_token) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SweepExpired();
+
+    auto it = cursors_.find(token);
+    if (it == cursors_.end()) {
+        return Status(SERVER_INVALID_ARGUMENT, "Unknown or expired search cursor: " + token);
+    }
+
+    Cursor& cursor = it->second;
+    int64_t begin = cursor.offset_;
+    int64_t end = std::min(begin + page_size, cursor.topk_);
+    int64_t slice = end - begin;
+
+    page.row_num_ = cursor.row_num_;
+    page.id_list_.clear();
+    page.distance_list_.clear();
+    page.id_list_.reserve(cursor.row_num_ * slice);
+    page.distance_list_.reserve(cursor.row_num_ * slice);
+    for (int64_t i = 0; i < cursor.row_num_; i++) {
+        auto base = i * cursor.topk_;
+        page.id_list_.insert(page.id_list_.end(), cursor.ids_.begin() + base + begin,
+                             cursor.ids_.begin() + base + end);
+        page.distance_list_.insert(page.distance_list_.end(), cursor.distances_.begin() + base + begin,
+                                   cursor.distances_.begin() + base + end);
+    }
+
+    cursor.offset_ = end;
+    if (cursor.offset_ >= cursor.topk_) {
+        cursors_.erase(it);
+        next_token.clear();
+    } else {
+        cursor.last_access_ = std::chrono::steady_clock::now();
+        next_token = token;
+    }
+    return Status::OK();
+}
+
+void
+SearchCursorMgr::SweepExpired() {
+    auto now = std::chrono::steady_clock::now();
+    for (auto it = cursors_.begin(); it != cursors_.end();) {
+        auto idle = std::chrono::duration_cast<std::chrono::seconds>(now - it->second.last_access_).count();
+        if (idle > CURSOR_IDLE_SECONDS) {
+            SERVER_LOG_DEBUG << "Dropping idle search cursor " << it->first;
+            it = cursors_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+}  // namespace server
+}  // namespace milvus
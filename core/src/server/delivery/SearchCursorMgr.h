@@ -0,0 +1,68 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Types.h"
+#include "server/delivery/request/BaseRequest.h"
+#include "utils/Status.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace milvus {
+namespace server {
+
+// Server-side cursors for paged deep-topk searches: the first SearchPaged call
+// runs the query once at full depth and parks the result here, later calls pull
+// successive per-query slices without re-scanning. Cursors are dropped when
+// exhausted, evicted oldest-first past a fixed count, and expire after an idle
+// timeout so abandoned exports cannot pin result memory.
+class SearchCursorMgr {
+ public:
+    static SearchCursorMgr&
+    GetInstance();
+
+    // Park a full-depth result and return the continuation token for its first page.
+    std::string
+    Register(int64_t row_num, int64_t topk, engine::ResultIds&& ids, engine::ResultDistances&& distances);
+
+    // Copy the cursor's next `page_size` entries per query into `page` and advance.
+    // `next_token` is the token for the following page, or empty when the cursor is
+    // exhausted (it is dropped). Unknown or expired tokens fail with SERVER_INVALID_ARGUMENT.
+    Status
+    FetchPage(const std::string& token, int64_t page_size, TopKQueryResult& page, std::string& next_token);
+
+ private:
+    SearchCursorMgr() = default;
+
+    void
+    SweepExpired();
+
+ private:
+    struct Cursor {
+        int64_t row_num_ = 0;  // nq
+        int64_t topk_ = 0;     // full result depth per query
+        int64_t offset_ = 0;   // per-query depth already delivered
+        engine::ResultIds ids_;
+        engine::ResultDistances distances_;
+        std::chrono::steady_clock::time_point last_access_;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Cursor> cursors_;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,55 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/SlowQueryLog.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+
+#include <utility>
+
+namespace milvus {
+namespace server {
+
+SlowQueryLog&
+SlowQueryLog::GetInstance() {
+    static SlowQueryLog log;
+    return log;
+}
+
+SlowQueryLog::SlowQueryLog() {
+    Config& config = Config::GetInstance();
+    config.GetServerConfigSlowQueryThreshold(threshold_ms_);
+    if (threshold_ms_ > 0) {
+        SERVER_LOG_INFO << "Slow query log enabled: threshold " << threshold_ms_ << " ms";
+    }
+}
+
+void
+SlowQueryLog::Append(milvus::json record) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (records_.size() >= capacity_) {
+        records_.pop_front();
+    }
+    records_.push_back(std::move(record));
+}
+
+milvus::json
+SlowQueryLog::Dump() {
+    milvus::json records_json = milvus::json::array();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& record : records_) {
+        records_json.push_back(record);
+    }
+    return records_json;
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,63 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "utils/Json.h"
+
+#include <deque>
+#include <mutex>
+
+namespace milvus {
+namespace server {
+
+// Slow-request log in the database slow-query tradition: any request whose
+// execution exceeds server_config.slow_query_threshold_ms leaves a structured
+// record (latency, stage breakdown, request parameters) so outliers stay
+// inspectable instead of vanishing into latency averages. Records live in a
+// fixed-size in-memory ring and are served as JSON by the "slow_query_log"
+// admin command, which the web layer exposes at GET /system/slow_query_log.
+// A threshold of 0 (the default) disables the log.
+class SlowQueryLog {
+ public:
+    static SlowQueryLog&
+    GetInstance();
+
+    bool
+    Enabled() const {
+        return threshold_ms_ > 0;
+    }
+
+    int64_t
+    ThresholdMs() const {
+        return threshold_ms_;
+    }
+
+    // push a record, dropping the oldest when the ring is full
+    void
+    Append(milvus::json record);
+
+    // all retained records, oldest first
+    milvus::json
+    Dump();
+
+ private:
+    SlowQueryLog();
+
+ private:
+    int64_t threshold_ms_ = 0;
+    const size_t capacity_ = 128;
+    std::mutex mutex_;
+    std::deque<milvus::json> records_;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -10,9 +10,12 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/request/BaseRequest.h"
+#include "server/delivery/SlowQueryLog.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
 
+#include <chrono>
+
 namespace milvus {
 namespace server {
 
@@ -63,7 +66,44 @@ BaseRequest::~BaseRequest() {
 
 Status
 BaseRequest::Execute() {
+    auto& slow_log = SlowQueryLog::GetInstance();
+    if (slow_log.Enabled() && context_ != nullptr) {
+        // every request gets a stage profile so a slow one can be broken down
+        context_->EnableProfiling();
+    }
+
+    auto start = std::chrono::steady_clock::now();
     status_ = OnExecute();
+
+    if (slow_log.Enabled()) {
+        auto latency_ms =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() /
+            1000.0;
+        if (latency_ms >= slow_log.ThresholdMs()) {
+            milvus::json record;
+            record["timestamp_us"] = std::chrono::duration_cast<std::chrono::microseconds>(
+                                         std::chrono::system_clock::now().time_since_epoch())
+                                         .count();
+            record["request_group"] = request_group_;
+            record["latency_ms"] = latency_ms;
+            record["status_code"] = status_.code();
+            if (context_ != nullptr) {
+                record["client_tag"] = context_->GetClientTag();
+                if (auto& profile = context_->GetProfile()) {
+                    milvus::json stages_json;
+                    stages_json["queue_wait_ms"] = profile->queue_wait_ns_.load() / 1e6;
+                    stages_json["load_ms"] = profile->load_ns_.load() / 1e6;
+                    stages_json["search_ms"] = profile->search_ns_.load() / 1e6;
+                    stages_json["reduce_ms"] = profile->reduce_ns_.load() / 1e6;
+                    stages_json["serialize_ms"] = profile->serialize_ns_.load() / 1e6;
+                    record["stages"] = stages_json;
+                }
+            }
+            SlowQueryDetail(record);
+            slow_log.Append(std::move(record));
+        }
+    }
+
     Done();
     return status_;
 }
@@ -74,6 +114,12 @@ BaseRequest::Done() {
     finish_cond_.notify_all();
 }
 
+void
+BaseRequest::Abort(const Status& status) {
+    status_ = status;
+    Done();
+}
+
 Status
 BaseRequest::SetStatus(ErrorCode error_code, const std::string& error_msg) {
     status_ = Status(error_code, error_msg);
@@ -17,6 +17,7 @@
 #include "grpc/gen-status/status.grpc.pb.h"
 #include "grpc/gen-status/status.pb.h"
 #include "server/context/Context.h"
+#include "utils/Json.h"
 #include "utils/Status.h"
 
 #include <condition_variable>
@@ -120,6 +121,11 @@ class BaseRequest {
     void
     Done();
 
+    // finish without executing, delivering the given status to the waiter;
+    // used when the scheduler refuses the request (e.g. shed by the limiter)
+    void
+    Abort(const Status& status);
+
     Status
     WaitToFinish();
 
@@ -128,6 +134,11 @@ class BaseRequest {
         return request_group_;
     }
 
+    const std::shared_ptr<Context>&
+    GetContext() const {
+        return context_;
+    }
+
     const Status&
     status() const {
         return status_;
@@ -142,6 +153,12 @@ class BaseRequest {
     virtual Status
     OnExecute() = 0;
 
+    // request-specific fields for a slow-query record (table, parameters);
+    // the base record already carries group, latency and stage breakdown
+    virtual void
+    SlowQueryDetail(milvus::json& record) {
+    }
+
     Status
     SetStatus(ErrorCode error_code, const std::string& error_msg);
 
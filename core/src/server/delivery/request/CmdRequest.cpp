@@ -10,9 +10,14 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/request/CmdRequest.h"
+#include "cache/CpuCacheMgr.h"
+#include "cache/GpuCacheMgr.h"
 #include "metrics/SystemInfo.h"
 #include "scheduler/SchedInst.h"
+#include "server/delivery/SlowQueryLog.h"
+#include "utils/Json.h"
 #include "utils/Log.h"
+#include "utils/Profiler.h"
 #include "utils/TimeRecorder.h"
 
 #include <memory>
@@ -55,6 +60,71 @@ CmdRequest::OnExecute() {
     } else if (cmd_.substr(0, 10) == "set_config" || cmd_.substr(0, 10) == "get_config") {
         server::Config& config = server::Config::GetInstance();
         stat = config.ProcessConfigCli(result_, cmd_);
+    } else if (cmd_ == "reload_config") {
+        // re-read the yaml and apply the runtime-settable nodes to live subsystems
+        stat = server::Config::GetInstance().HotReload(result_);
+    } else if (cmd_ == "cache_info") {
+        // contents inspection: per-instance traffic counters plus every
+        // resident key with its size and age, served as JSON so the web
+        // layer exposes it verbatim at GET /system/cache_info
+        auto describe = [](const std::string& name, cache::CacheMgr<cache::DataObjPtr>& mgr) {
+            milvus::json cache_json;
+            cache_json["name"] = name;
+            cache_json["usage_bytes"] = mgr.CacheUsage();
+            cache_json["capacity_bytes"] = mgr.CacheCapacity();
+            cache_json["hit_count"] = mgr.HitCount();
+            cache_json["miss_count"] = mgr.MissCount();
+            cache_json["eviction_count"] = mgr.EvictionCount();
+            cache_json["bytes_in"] = mgr.BytesIn();
+            cache_json["bytes_out"] = mgr.BytesOut();
+            cache_json["items"] = milvus::json::array();
+            for (auto& entry : mgr.SnapshotEntries()) {
+                milvus::json item_json;
+                item_json["key"] = entry.key_;
+                item_json["size_bytes"] = entry.size_;
+                item_json["age_seconds"] = entry.age_seconds_;
+                cache_json["items"].push_back(item_json);
+            }
+            return cache_json;
+        };
+
+        milvus::json caches_json = milvus::json::array();
+        caches_json.push_back(describe("cpu", *cache::CpuCacheMgr::GetInstance()));
+#ifdef MILVUS_GPU_VERSION
+        for (auto gpu_id : cache::GpuCacheMgr::InstanceIds()) {
+            caches_json.push_back(describe("gpu_" + std::to_string(gpu_id), *cache::GpuCacheMgr::GetInstance(gpu_id)));
+        }
+#endif
+        milvus::json reply_json;
+        reply_json["caches"] = caches_json;
+        result_ = reply_json.dump();
+    } else if (cmd_ == "slow_query_log") {
+        // dump the slow-request ring, also served at GET /system/slow_query_log
+        result_ = SlowQueryLog::GetInstance().Dump().dump();
+    } else if (cmd_.substr(0, 11) == "profile_cpu") {
+        // "profile_cpu [seconds]" captures a CPU profile on the live node and
+        // reports the pprof file path; "profile_cpu stop" ends a capture early
+        std::string arg = cmd_.size() > 12 ? cmd_.substr(12) : "";
+        if (arg == "stop") {
+            stat = CpuProfiler::GetInstance().Stop();
+            if (stat.ok()) {
+                result_ = "OK";
+            }
+        } else {
+            int64_t seconds = 10;
+            if (!arg.empty()) {
+                try {
+                    seconds = std::stoll(arg);
+                } catch (std::exception& ex) {
+                    return Status(SERVER_INVALID_ARGUMENT, "Invalid profile duration: " + arg);
+                }
+            }
+            std::string profile_path;
+            stat = CpuProfiler::GetInstance().Start(seconds, profile_path);
+            if (stat.ok()) {
+                result_ = profile_path;
+            }
+        }
     } else {
         result_ = "Unknown command";
     }
@@ -77,6 +77,9 @@ CreateIndexRequest::OnExecute() {
         if (ValidationUtil::IsBinaryMetricType(table_info.metric_type_)) {  // binary vector not allow
             if (adapter_index_type == static_cast<int32_t>(engine::EngineType::FAISS_IDMAP)) {
                 adapter_index_type = static_cast<int32_t>(engine::EngineType::FAISS_BIN_IDMAP);
+            } else if (ValidationUtil::IsStructureMetricType(table_info.metric_type_)) {
+                // containment screening has no meaningful coarse quantizer, flat only
+                return Status(SERVER_INVALID_INDEX_TYPE, "Invalid index type for table metric type");
             } else if (adapter_index_type == static_cast<int32_t>(engine::EngineType::FAISS_IVFFLAT)) {
                 adapter_index_type = static_cast<int32_t>(engine::EngineType::FAISS_BIN_IVFFLAT);
             } else {
@@ -11,6 +11,7 @@
 
 #include "server/delivery/request/DeleteByDateRequest.h"
 #include "server/DBWrapper.h"
+#include "server/delivery/QueryResultCache.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 #include "utils/ValidationUtil.h"
@@ -81,6 +82,9 @@ DeleteByDateRequest::OnExecute() {
         if (!status.ok()) {
             return status;
         }
+
+        // cached results may contain the deleted dates
+        QueryResultCache::GetInstance().BumpVersion(table_name_);
     } catch (std::exception& ex) {
         return Status(SERVER_UNEXPECTED_ERROR, ex.what());
     }
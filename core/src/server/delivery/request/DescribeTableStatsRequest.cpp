@@ -0,0 +1,73 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/request/DescribeTableStatsRequest.h"
+#include "BaseRequest.h"
+#include "server/DBWrapper.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+#include "utils/ValidationUtil.h"
+
+#include <fiu-local.h>
+#include <memory>
+
+namespace milvus {
+namespace server {
+
+DescribeTableStatsRequest::DescribeTableStatsRequest(
+    const std::shared_ptr<Context>& context, const std::string& table_name, engine::meta::TableStats& total,
+    std::vector<std::pair<std::string, engine::meta::TableStats>>& partition_stats)
+    : BaseRequest(context, INFO_REQUEST_GROUP),
+      table_name_(table_name),
+      total_(total),
+      partition_stats_(partition_stats) {
+}
+
+BaseRequestPtr
+DescribeTableStatsRequest::Create(const std::shared_ptr<Context>& context, const std::string& table_name,
+                                  engine::meta::TableStats& total,
+                                  std::vector<std::pair<std::string, engine::meta::TableStats>>& partition_stats) {
+    return std::shared_ptr<BaseRequest>(new DescribeTableStatsRequest(context, table_name, total, partition_stats));
+}
+
+Status
+DescribeTableStatsRequest::OnExecute() {
+    try {
+        std::string hdr = "DescribeTableStatsRequest(table=" + table_name_ + ")";
+        TimeRecorderAuto rc(hdr);
+
+        // step 1: check arguments
+        auto status = ValidationUtil::ValidateTableName(table_name_);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // step 2: collect the maintained aggregates
+        status = DBWrapper::DB()->DescribeTableStats(table_name_, total_, partition_stats_);
+        fiu_do_on("DescribeTableStatsRequest.OnExecute.db_not_found", status = Status(DB_NOT_FOUND, ""));
+        fiu_do_on("DescribeTableStatsRequest.OnExecute.status_error", status = Status(SERVER_UNEXPECTED_ERROR, ""));
+        fiu_do_on("DescribeTableStatsRequest.OnExecute.throw_std_exception", throw std::exception());
+        if (!status.ok()) {
+            if (status.code() == DB_NOT_FOUND) {
+                return Status(SERVER_TABLE_NOT_EXIST, TableNotExistMsg(table_name_));
+            } else {
+                return status;
+            }
+        }
+    } catch (std::exception& ex) {
+        return Status(SERVER_UNEXPECTED_ERROR, ex.what());
+    }
+
+    return Status::OK();
+}
+
+}  // namespace server
+}  // namespace milvus
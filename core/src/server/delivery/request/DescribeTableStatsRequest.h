@@ -0,0 +1,45 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "server/delivery/request/BaseRequest.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+class DescribeTableStatsRequest : public BaseRequest {
+ public:
+    static BaseRequestPtr
+    Create(const std::shared_ptr<Context>& context, const std::string& table_name, engine::meta::TableStats& total,
+           std::vector<std::pair<std::string, engine::meta::TableStats>>& partition_stats);
+
+ protected:
+    DescribeTableStatsRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
+                              engine::meta::TableStats& total,
+                              std::vector<std::pair<std::string, engine::meta::TableStats>>& partition_stats);
+
+    Status
+    OnExecute() override;
+
+ private:
+    const std::string table_name_;
+    engine::meta::TableStats& total_;
+    std::vector<std::pair<std::string, engine::meta::TableStats>>& partition_stats_;
+};
+
+}  // namespace server
+}  // namespace milvus
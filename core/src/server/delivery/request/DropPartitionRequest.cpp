@@ -11,6 +11,7 @@
 
 #include "server/delivery/request/DropPartitionRequest.h"
 #include "server/DBWrapper.h"
+#include "server/delivery/QueryResultCache.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 #include "utils/ValidationUtil.h"
@@ -76,7 +77,12 @@ DropPartitionRequest::OnExecute() {
             }
         }
 
-        return DBWrapper::DB()->DropPartition(partition_name);
+        status = DBWrapper::DB()->DropPartition(partition_name);
+        if (status.ok()) {
+            // untagged searches of the parent table may have cached this partition's rows
+            QueryResultCache::GetInstance().BumpVersion(table_name);
+        }
+        return status;
     } else {
         status = ValidationUtil::ValidateTableName(table_name);
         fiu_do_on("DropPartitionRequest.OnExecute.invalid_table_name",
@@ -91,7 +97,11 @@ DropPartitionRequest::OnExecute() {
         if (!status.ok()) {
             return status;
         }
-        return DBWrapper::DB()->DropPartitionByTag(table_name, partition_tag);
+        status = DBWrapper::DB()->DropPartitionByTag(table_name, partition_tag);
+        if (status.ok()) {
+            QueryResultCache::GetInstance().BumpVersion(table_name);
+        }
+        return status;
     }
 }
 
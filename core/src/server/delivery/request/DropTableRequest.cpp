@@ -11,6 +11,7 @@
 
 #include "server/delivery/request/DropTableRequest.h"
 #include "server/DBWrapper.h"
+#include "server/delivery/QueryResultCache.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 #include "utils/ValidationUtil.h"
@@ -69,6 +70,9 @@ DropTableRequest::OnExecute() {
             return status;
         }
 
+        // a recreated table must not serve results cached from this incarnation
+        QueryResultCache::GetInstance().BumpVersion(table_name_);
+
         rc.ElapseFromBegin("total cost");
     } catch (std::exception& ex) {
         return Status(SERVER_UNEXPECTED_ERROR, ex.what());
@@ -0,0 +1,82 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/request/ExportTableRequest.h"
+#include "server/DBWrapper.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+#include "utils/ValidationUtil.h"
+
+#include <memory>
+
+namespace milvus {
+namespace server {
+
+ExportTableRequest::ExportTableRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
+                                       const ChunkWriter& writer)
+    : BaseRequest(context, DQL_REQUEST_GROUP), table_name_(table_name), writer_(writer) {
+}
+
+BaseRequestPtr
+ExportTableRequest::Create(const std::shared_ptr<Context>& context, const std::string& table_name,
+                           const ChunkWriter& writer) {
+    return std::shared_ptr<BaseRequest>(new ExportTableRequest(context, table_name, writer));
+}
+
+Status
+ExportTableRequest::OnExecute() {
+    try {
+        std::string hdr = "ExportTableRequest(table=" + table_name_ + ")";
+        TimeRecorderAuto rc(hdr);
+
+        // step 1: check table name
+        auto status = ValidationUtil::ValidateTableName(table_name_);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // step 2: check table existence
+        engine::meta::TableSchema table_info;
+        table_info.table_id_ = table_name_;
+        status = DBWrapper::DB()->DescribeTable(table_info);
+        if (!status.ok()) {
+            if (status.code() == DB_NOT_FOUND) {
+                return Status(SERVER_TABLE_NOT_EXIST, TableNotExistMsg(table_name_));
+            } else {
+                return status;
+            }
+        }
+
+        // the raw slab framing carries float32 values only
+        if (ValidationUtil::IsBinaryMetricType(table_info.metric_type_)) {
+            return Status(SERVER_UNSUPPORTED_ERROR, "Table export only supports float vector tables");
+        }
+
+        // step 3: stream the raw files out. The dimension is constant per table,
+        // so it is stamped onto every slab here rather than threaded through the
+        // storage layer
+        int64_t dim = table_info.dimension_;
+        status = DBWrapper::DB()->ExportTable(
+            table_name_, [&](int64_t count, const float* vectors, const int64_t* ids) -> bool {
+                return writer_(count, dim, vectors, ids);
+            });
+        if (!status.ok()) {
+            return status;
+        }
+    } catch (std::exception& ex) {
+        return Status(SERVER_UNEXPECTED_ERROR, ex.what());
+    }
+
+    return Status::OK();
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,48 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "server/delivery/request/BaseRequest.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace milvus {
+namespace server {
+
+// Streams every stored vector of a table (and its partitions) to the writer,
+// one raw slab at a time, straight from the storage layer - no search runs and
+// no index is deserialized. The writer returns false when the client is gone,
+// which cancels the rest of the export.
+class ExportTableRequest : public BaseRequest {
+ public:
+    using ChunkWriter = std::function<bool(int64_t count, int64_t dim, const float* vectors, const int64_t* ids)>;
+
+    static BaseRequestPtr
+    Create(const std::shared_ptr<Context>& context, const std::string& table_name, const ChunkWriter& writer);
+
+ protected:
+    ExportTableRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
+                       const ChunkWriter& writer);
+
+    Status
+    OnExecute() override;
+
+ private:
+    const std::string table_name_;
+
+    ChunkWriter writer_;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,74 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/request/GetVectorsByIDRequest.h"
+#include "BaseRequest.h"
+#include "server/DBWrapper.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+#include "utils/ValidationUtil.h"
+
+#include <fiu-local.h>
+#include <memory>
+
+namespace milvus {
+namespace server {
+
+GetVectorsByIDRequest::GetVectorsByIDRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
+                                             const std::vector<int64_t>& id_array,
+                                             std::vector<engine::VectorsData>& vectors)
+    : BaseRequest(context, INFO_REQUEST_GROUP), table_name_(table_name), id_array_(id_array), vectors_(vectors) {
+}
+
+BaseRequestPtr
+GetVectorsByIDRequest::Create(const std::shared_ptr<Context>& context, const std::string& table_name,
+                              const std::vector<int64_t>& id_array, std::vector<engine::VectorsData>& vectors) {
+    return std::shared_ptr<BaseRequest>(new GetVectorsByIDRequest(context, table_name, id_array, vectors));
+}
+
+Status
+GetVectorsByIDRequest::OnExecute() {
+    try {
+        std::string hdr = "GetVectorsByIDRequest(table=" + table_name_ + ", ids=" + std::to_string(id_array_.size()) +
+                          ")";
+        TimeRecorderAuto rc(hdr);
+
+        // step 1: check arguments
+        auto status = ValidationUtil::ValidateTableName(table_name_);
+        if (!status.ok()) {
+            return status;
+        }
+
+        if (id_array_.empty()) {
+            return Status(SERVER_INVALID_ARGUMENT, "The id array is empty. Make sure you have entered vector ids.");
+        }
+
+        // step 2: fetch the vectors
+        status = DBWrapper::DB()->GetVectorsByID(table_name_, id_array_, vectors_);
+        fiu_do_on("GetVectorsByIDRequest.OnExecute.db_not_found", status = Status(DB_NOT_FOUND, ""));
+        fiu_do_on("GetVectorsByIDRequest.OnExecute.status_error", status = Status(SERVER_UNEXPECTED_ERROR, ""));
+        fiu_do_on("GetVectorsByIDRequest.OnExecute.throw_std_exception", throw std::exception());
+        if (!status.ok()) {
+            if (status.code() == DB_NOT_FOUND) {
+                return Status(SERVER_TABLE_NOT_EXIST, TableNotExistMsg(table_name_));
+            } else {
+                return status;
+            }
+        }
+    } catch (std::exception& ex) {
+        return Status(SERVER_UNEXPECTED_ERROR, ex.what());
+    }
+
+    return Status::OK();
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,43 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "server/delivery/request/BaseRequest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+class GetVectorsByIDRequest : public BaseRequest {
+ public:
+    static BaseRequestPtr
+    Create(const std::shared_ptr<Context>& context, const std::string& table_name,
+           const std::vector<int64_t>& id_array, std::vector<engine::VectorsData>& vectors);
+
+ protected:
+    GetVectorsByIDRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
+                          const std::vector<int64_t>& id_array, std::vector<engine::VectorsData>& vectors);
+
+    Status
+    OnExecute() override;
+
+ private:
+    const std::string table_name_;
+    const std::vector<int64_t> id_array_;
+    std::vector<engine::VectorsData>& vectors_;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/request/InsertRequest.h"
+#include "server/Config.h"
 #include "server/DBWrapper.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
@@ -125,6 +126,19 @@ InsertRequest::OnExecute() {
                 return Status(SERVER_INVALID_VECTOR_DIMENSION,
                               "The vector dimension must be equal to the table dimension.");
             }
+
+            // a NaN or Inf accepted here poisons distances for every later
+            // search of the segment. The scan is one vectorized pass over the
+            // slab; trusted loaders that pre-validate can switch it off
+            bool data_check = true;
+            Config::GetInstance().GetEngineConfigVectorDataCheck(data_check);
+            if (data_check) {
+                status = ValidationUtil::ValidateVectorDataFinite(vectors_data_.float_data_.data(),
+                                                                  vectors_data_.float_data_.size());
+                if (!status.ok()) {
+                    return status;
+                }
+            }
         } else if (!vectors_data_.binary_data_.empty()) {  // insert binary vectors
             if (!ValidationUtil::IsBinaryMetricType(table_info.metric_type_)) {
                 return Status(SERVER_INVALID_ROWRECORD_ARRAY, "Table metric type doesn't support binary vectors.");
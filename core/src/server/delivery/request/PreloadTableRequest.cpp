@@ -21,13 +21,23 @@
 namespace milvus {
 namespace server {
 
-PreloadTableRequest::PreloadTableRequest(const std::shared_ptr<Context>& context, const std::string& table_name)
-    : BaseRequest(context, DQL_REQUEST_GROUP), table_name_(table_name) {
+PreloadTableRequest::PreloadTableRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
+                                         bool pin, int64_t priority, const std::vector<std::string>& partition_tags,
+                                         const std::vector<Range>& range_list)
+    : BaseRequest(context, DQL_REQUEST_GROUP),
+      table_name_(table_name),
+      pin_(pin),
+      priority_(priority),
+      partition_tags_(partition_tags),
+      range_list_(range_list) {
 }
 
 BaseRequestPtr
-PreloadTableRequest::Create(const std::shared_ptr<Context>& context, const std::string& table_name) {
-    return std::shared_ptr<BaseRequest>(new PreloadTableRequest(context, table_name));
+PreloadTableRequest::Create(const std::shared_ptr<Context>& context, const std::string& table_name, bool pin,
+                            int64_t priority, const std::vector<std::string>& partition_tags,
+                            const std::vector<Range>& range_list) {
+    return std::shared_ptr<BaseRequest>(
+        new PreloadTableRequest(context, table_name, pin, priority, partition_tags, range_list));
 }
 
 Status
@@ -42,8 +52,18 @@ PreloadTableRequest::OnExecute() {
             return status;
         }
 
+        if (priority_ < -1 || priority_ > 1) {
+            return Status(SERVER_INVALID_ARGUMENT, "Cache priority must be -1 (low), 0 (normal) or 1 (high).");
+        }
+
+        std::vector<DB_DATE> dates;
+        status = ConvertTimeRangeToDBDates(range_list_, dates);
+        if (!status.ok()) {
+            return status;
+        }
+
         // step 2: check table existence
-        status = DBWrapper::DB()->PreloadTable(table_name_);
+        status = DBWrapper::DB()->PreloadTable(table_name_, pin_, priority_, partition_tags_, dates);
         fiu_do_on("PreloadTableRequest.OnExecute.preload_table_fail",
                   status = Status(milvus::SERVER_UNEXPECTED_ERROR, ""));
         fiu_do_on("PreloadTableRequest.OnExecute.throw_std_exception", throw std::exception());
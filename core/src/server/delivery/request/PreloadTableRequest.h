@@ -15,23 +15,36 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace milvus {
 namespace server {
 
 class PreloadTableRequest : public BaseRequest {
  public:
+    // pin keeps the table in cpu cache until it is dropped; priority is the cache
+    // eviction class: -1 evict first, 0 normal, 1 evict last. partition_tags and
+    // range_list narrow the preload to the partitions and dates queries will
+    // actually touch; both empty means the whole table, like before
     static BaseRequestPtr
-    Create(const std::shared_ptr<Context>& context, const std::string& table_name);
+    Create(const std::shared_ptr<Context>& context, const std::string& table_name, bool pin = false,
+           int64_t priority = 0, const std::vector<std::string>& partition_tags = std::vector<std::string>(),
+           const std::vector<Range>& range_list = std::vector<Range>());
 
  protected:
-    PreloadTableRequest(const std::shared_ptr<Context>& context, const std::string& table_name);
+    PreloadTableRequest(const std::shared_ptr<Context>& context, const std::string& table_name, bool pin,
+                        int64_t priority, const std::vector<std::string>& partition_tags,
+                        const std::vector<Range>& range_list);
 
     Status
     OnExecute() override;
 
  private:
     const std::string table_name_;
+    const bool pin_;
+    const int64_t priority_;
+    const std::vector<std::string> partition_tags_;
+    const std::vector<Range> range_list_;
 };
 
 }  // namespace server
@@ -0,0 +1,163 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/request/SearchCombineRequest.h"
+#include "server/DBWrapper.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+#include "utils/ValidationUtil.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+SearchCombineRequest::SearchCombineRequest(const std::shared_ptr<Context>& context)
+    : BaseRequest(context, DQL_REQUEST_GROUP, /*async=*/true) {
+}
+
+bool
+SearchCombineRequest::CanCombine(const SearchRequestPtr& request) {
+    if (request == nullptr || request->IsAsync()) {
+        return false;
+    }
+
+    // date ranges, partition tags and explicit file id lists change the set of segments
+    // searched, so such requests always execute alone
+    return request->RangeList().empty() && request->PartitionList().empty() && request->FileIdList().empty();
+}
+
+Status
+SearchCombineRequest::AddRequest(const SearchRequestPtr& request) {
+    if (!CanCombine(request)) {
+        return Status(SERVER_INVALID_ARGUMENT, "Request cannot be combined");
+    }
+
+    if (request_list_.empty()) {
+        table_name_ = request->TableName();
+        topk_ = request->TopK();
+        nprobe_ = request->Nprobe();
+    } else if (request->TableName() != table_name_ || request->TopK() != topk_ || request->Nprobe() != nprobe_) {
+        return Status(SERVER_INVALID_ARGUMENT, "Search parameters mismatch the combine key");
+    } else if ((request->VectorsData().FloatDataSize() == 0) !=
+               (request_list_.front()->VectorsData().FloatDataSize() == 0)) {
+        return Status(SERVER_INVALID_ARGUMENT, "Cannot combine float and binary queries");
+    }
+
+    request_list_.push_back(request);
+    combined_nq_ += request->VectorsData().vector_count_;
+    return Status::OK();
+}
+
+void
+SearchCombineRequest::FinishAllRequests(const Status& status) {
+    for (auto& request : request_list_) {
+        request->FinishCombined(status, 0, engine::ResultIds(), engine::ResultDistances());
+    }
+}
+
+Status
+SearchCombineRequest::OnExecute() {
+    if (request_list_.empty()) {
+        return Status::OK();
+    }
+
+    try {
+        std::string hdr = "SearchCombineRequest(table=" + table_name_ + ", nq=" + std::to_string(combined_nq_) +
+                          ", request_count=" + std::to_string(request_list_.size()) + ", k=" + std::to_string(topk_) +
+                          ", nprob=" + std::to_string(nprobe_) + ")";
+        TimeRecorder rc(hdr);
+
+        // step 1: check table existence, once for the whole batch
+        engine::meta::TableSchema table_info;
+        table_info.table_id_ = table_name_;
+        auto status = DBWrapper::DB()->DescribeTable(table_info);
+        if (!status.ok()) {
+            if (status.code() == DB_NOT_FOUND) {
+                status = Status(SERVER_TABLE_NOT_EXIST, TableNotExistMsg(table_name_));
+            }
+            FinishAllRequests(status);
+            return status;
+        }
+
+        status = ValidationUtil::ValidateSearchTopk(topk_, table_info);
+        if (!status.ok()) {
+            FinishAllRequests(status);
+            return status;
+        }
+
+        status = ValidationUtil::ValidateSearchNprobe(nprobe_, table_info);
+        if (!status.ok()) {
+            FinishAllRequests(status);
+            return status;
+        }
+
+        // step 2: gather query vectors of all batched requests
+        engine::VectorsData combined_vectors;
+        combined_vectors.vector_count_ = combined_nq_;
+        for (auto& request : request_list_) {
+            const engine::VectorsData& vectors = request->VectorsData();
+            combined_vectors.float_data_.insert(combined_vectors.float_data_.end(), vectors.FloatData(),
+                                                vectors.FloatData() + vectors.FloatDataSize());
+            combined_vectors.binary_data_.insert(combined_vectors.binary_data_.end(), vectors.BinaryData(),
+                                                 vectors.BinaryData() + vectors.BinaryDataSize());
+        }
+
+        rc.RecordSection("gather query vectors");
+
+        // step 3: one engine query for the whole batch
+        engine::ResultIds result_ids;
+        engine::ResultDistances result_distances;
+        status = DBWrapper::DB()->Query(context_, table_name_, std::vector<std::string>(), (size_t)topk_, nprobe_,
+                                        combined_vectors, std::vector<DB_DATE>(), result_ids, result_distances);
+        rc.RecordSection("search combined vectors from engine");
+
+        if (!status.ok()) {
+            FinishAllRequests(status);
+            return status;
+        }
+
+        if (result_ids.empty()) {
+            // empty table; every caller gets an empty result
+            for (auto& request : request_list_) {
+                request->FinishCombined(Status::OK(), 0, engine::ResultIds(), engine::ResultDistances());
+            }
+            return Status::OK();
+        }
+
+        // step 4: scatter result slices back to the callers
+        size_t stride = result_ids.size() / combined_nq_;
+        size_t offset = 0;
+        for (auto& request : request_list_) {
+            uint64_t nq = request->VectorsData().vector_count_;
+            engine::ResultIds ids(result_ids.begin() + offset * stride,
+                                  result_ids.begin() + (offset + nq) * stride);
+            engine::ResultDistances distances(result_distances.begin() + offset * stride,
+                                              result_distances.begin() + (offset + nq) * stride);
+            request->FinishCombined(Status::OK(), nq, std::move(ids), std::move(distances));
+            offset += nq;
+        }
+
+        rc.RecordSection("scatter results");
+        rc.ElapseFromBegin("totally cost");
+    } catch (std::exception& ex) {
+        Status status = Status(SERVER_UNEXPECTED_ERROR, ex.what());
+        FinishAllRequests(status);
+        return status;
+    }
+
+    return Status::OK();
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,66 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "server/delivery/request/BaseRequest.h"
+#include "server/delivery/request/SearchRequest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+// Executes several compatible SearchRequests as one multi-nq query and scatters
+// the result slices back to the original callers. Created by SearchCombiner.
+class SearchCombineRequest : public BaseRequest {
+ public:
+    explicit SearchCombineRequest(const std::shared_ptr<Context>& context);
+
+    // the first added request defines the combine key (table, topk, nprobe)
+    Status
+    AddRequest(const SearchRequestPtr& request);
+
+    static bool
+    CanCombine(const SearchRequestPtr& request);
+
+    uint64_t
+    CombinedNq() const {
+        return combined_nq_;
+    }
+
+    size_t
+    RequestCount() const {
+        return request_list_.size();
+    }
+
+ protected:
+    Status
+    OnExecute() override;
+
+ private:
+    void
+    FinishAllRequests(const Status& status);
+
+ private:
+    std::string table_name_;
+    int64_t topk_ = 0;
+    int64_t nprobe_ = 0;
+    std::vector<SearchRequestPtr> request_list_;
+    uint64_t combined_nq_ = 0;
+};
+
+using SearchCombineRequestPtr = std::shared_ptr<SearchCombineRequest>;
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,158 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/request/SearchPagedRequest.h"
+#include "server/DBWrapper.h"
+#include "server/delivery/SearchCursorMgr.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+#include "utils/ValidationUtil.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace milvus {
+namespace server {
+
+namespace {
+// paged searches bypass the normal 2048 topk limit; this caps the depth of the
+// full-result snapshot a single cursor may pin in memory
+constexpr int64_t MAX_PAGED_TOPK = 1048576;
+// each page is delivered like an ordinary search result, so it keeps the normal limit
+constexpr int64_t MAX_PAGE_SIZE = 2048;
+}  // namespace
+
+SearchPagedRequest::SearchPagedRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
+                                       const engine::VectorsData& vectors, int64_t topk, int64_t nprobe,
+                                       const std::vector<std::string>& partition_list, int64_t page_size,
+                                       std::string& token, TopKQueryResult& result)
+    : BaseRequest(context, DQL_REQUEST_GROUP),
+      table_name_(table_name),
+      vectors_data_(vectors),
+      topk_(topk),
+      nprobe_(nprobe),
+      partition_list_(partition_list),
+      page_size_(page_size),
+      token_(token),
+      result_(result) {
+}
+
+BaseRequestPtr
+SearchPagedRequest::Create(const std::shared_ptr<Context>& context, const std::string& table_name,
+                           const engine::VectorsData& vectors, int64_t topk, int64_t nprobe,
+                           const std::vector<std::string>& partition_list, int64_t page_size, std::string& token,
+                           TopKQueryResult& result) {
+    return std::shared_ptr<BaseRequest>(
+        new SearchPagedRequest(context, table_name, vectors, topk, nprobe, partition_list, page_size, token, result));
+}
+
+Status
+SearchPagedRequest::OnExecute() {
+    try {
+        if (page_size_ <= 0 || page_size_ > MAX_PAGE_SIZE) {
+            return Status(SERVER_INVALID_TOPK, "Invalid page size: " + std::to_string(page_size_) +
+                                                   ". The page size must be within the range of 1 ~ " +
+                                                   std::to_string(MAX_PAGE_SIZE) + ".");
+        }
+
+        // a non-empty token is a continuation: pull the next page from the parked cursor
+        if (!token_.empty()) {
+            return SearchCursorMgr::GetInstance().FetchPage(token_, page_size_, result_, token_);
+        }
+
+        uint64_t vector_count = vectors_data_.vector_count_;
+        std::string hdr = "SearchPagedRequest(table=" + table_name_ + ", nq=" + std::to_string(vector_count) +
+                          ", k=" + std::to_string(topk_) + ", nprob=" + std::to_string(nprobe_) + ")";
+        TimeRecorder rc(hdr);
+
+        // step 1: check table name and existence
+        auto status = ValidationUtil::ValidateTableName(table_name_);
+        if (!status.ok()) {
+            return status;
+        }
+
+        engine::meta::TableSchema table_info;
+        table_info.table_id_ = table_name_;
+        status = DBWrapper::DB()->DescribeTable(table_info);
+        if (!status.ok()) {
+            if (status.code() == DB_NOT_FOUND) {
+                return Status(SERVER_TABLE_NOT_EXIST, TableNotExistMsg(table_name_));
+            } else {
+                return status;
+            }
+        }
+
+        // step 2: check search parameters; deep topk has its own cap instead of
+        // the 2048 limit enforced by ValidateSearchTopk
+        if (topk_ <= 0 || topk_ > MAX_PAGED_TOPK) {
+            return Status(SERVER_INVALID_TOPK, "Invalid topk: " + std::to_string(topk_) +
+                                                   ". The paged-search topk must be within the range of 1 ~ " +
+                                                   std::to_string(MAX_PAGED_TOPK) + ".");
+        }
+
+        status = ValidationUtil::ValidateSearchNprobe(nprobe_, table_info);
+        if (!status.ok()) {
+            return status;
+        }
+
+        status = ValidationUtil::ValidatePartitionTags(partition_list_);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // step 3: check prepared float data (paged search serves export-style
+        // float queries; binary tables go through the ordinary Search)
+        uint64_t float_data_size = vectors_data_.FloatDataSize();
+        if (float_data_size == 0) {
+            return Status(SERVER_INVALID_ROWRECORD_ARRAY,
+                          "The vector array is empty. Make sure you have entered vector records.");
+        }
+        if (float_data_size % vector_count != 0 || float_data_size / vector_count != table_info.dimension_) {
+            return Status(SERVER_INVALID_VECTOR_DIMENSION,
+                          "The vector dimension must be equal to the table dimension.");
+        }
+
+        rc.RecordSection("check validation");
+
+        // step 4: run the query once at full depth
+        engine::ResultIds result_ids;
+        engine::ResultDistances result_distances;
+        std::vector<DB_DATE> dates;
+        status = DBWrapper::DB()->Query(context_, table_name_, partition_list_, (size_t)topk_, nprobe_, vectors_data_,
+                                        dates, result_ids, result_distances);
+
+        rc.RecordSection("search vectors from engine");
+        if (!status.ok()) {
+            return status;
+        }
+        if (result_ids.empty()) {
+            return Status::OK();  // empty table; no cursor to keep
+        }
+
+        // step 5: park the full result and deliver the first page. The engine may
+        // return fewer than topk entries per query on small tables, so the cursor
+        // depth is taken from the actual result stride.
+        int64_t depth = static_cast<int64_t>(result_ids.size() / vector_count);
+        token_ = SearchCursorMgr::GetInstance().Register(vector_count, depth, std::move(result_ids),
+                                                         std::move(result_distances));
+        status = SearchCursorMgr::GetInstance().FetchPage(token_, page_size_, result_, token_);
+
+        rc.RecordSection("construct result and send");
+        rc.ElapseFromBegin("totally cost");
+        return status;
+    } catch (std::exception& ex) {
+        return Status(SERVER_UNEXPECTED_ERROR, ex.what());
+    }
+}
+
+}  // namespace server
+}  // namespace milvus
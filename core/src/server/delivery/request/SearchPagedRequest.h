@@ -0,0 +1,58 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "server/delivery/request/BaseRequest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+// Paged deep-topk search: an empty `token` runs the query once at full depth
+// (topk may exceed the normal search limit), parks the result in
+// SearchCursorMgr and returns the first page; a non-empty token pulls the next
+// page from the parked cursor without touching the engine. `token` is updated
+// in place with the continuation token for the following page, or cleared when
+// the cursor is exhausted.
+class SearchPagedRequest : public BaseRequest {
+ public:
+    static BaseRequestPtr
+    Create(const std::shared_ptr<Context>& context, const std::string& table_name, const engine::VectorsData& vectors,
+           int64_t topk, int64_t nprobe, const std::vector<std::string>& partition_list, int64_t page_size,
+           std::string& token, TopKQueryResult& result);
+
+ protected:
+    SearchPagedRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
+                       const engine::VectorsData& vectors, int64_t topk, int64_t nprobe,
+                       const std::vector<std::string>& partition_list, int64_t page_size, std::string& token,
+                       TopKQueryResult& result);
+
+    Status
+    OnExecute() override;
+
+ private:
+    const std::string table_name_;
+    const engine::VectorsData& vectors_data_;
+    int64_t topk_;
+    int64_t nprobe_;
+    const std::vector<std::string> partition_list_;
+    int64_t page_size_;
+    std::string& token_;
+
+    TopKQueryResult& result_;
+};
+
+}  // namespace server
+}  // namespace milvus
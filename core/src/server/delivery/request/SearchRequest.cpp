@@ -11,6 +11,8 @@
 
 #include "server/delivery/request/SearchRequest.h"
 #include "server/DBWrapper.h"
+#include "server/delivery/QueryRecorder.h"
+#include "server/delivery/QueryResultCache.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
@@ -49,6 +51,16 @@ SearchRequest::Create(const std::shared_ptr<Context>& context, const std::string
                                                           partition_list, file_id_list, result));
 }
 
+void
+SearchRequest::FinishCombined(const Status& status, int64_t row_num, engine::ResultIds&& ids,
+                              engine::ResultDistances&& distances) {
+    result_.row_num_ = row_num;
+    result_.id_list_ = std::move(ids);
+    result_.distance_list_ = std::move(distances);
+    status_ = status;
+    Done();
+}
+
 Status
 SearchRequest::OnExecute() {
     try {
@@ -91,7 +103,7 @@ SearchRequest::OnExecute() {
             return status;
         }
 
-        if (vectors_data_.float_data_.empty() && vectors_data_.binary_data_.empty()) {
+        if (vectors_data_.FloatDataSize() == 0 && vectors_data_.BinaryDataSize() == 0) {
             return Status(SERVER_INVALID_ROWRECORD_ARRAY,
                           "The vector array is empty. Make sure you have entered vector records.");
         }
@@ -107,25 +119,25 @@ SearchRequest::OnExecute() {
 
         if (ValidationUtil::IsBinaryMetricType(table_info.metric_type_)) {
             // check prepared binary data
-            if (vectors_data_.binary_data_.size() % vector_count != 0) {
+            if (vectors_data_.BinaryDataSize() % vector_count != 0) {
                 return Status(SERVER_INVALID_ROWRECORD_ARRAY,
                               "The vector dimension must be equal to the table dimension.");
             }
 
-            if (vectors_data_.binary_data_.size() * 8 / vector_count != table_info.dimension_) {
+            if (vectors_data_.BinaryDataSize() * 8 / vector_count != table_info.dimension_) {
                 return Status(SERVER_INVALID_VECTOR_DIMENSION,
                               "The vector dimension must be equal to the table dimension.");
             }
         } else {
             // check prepared float data
-            fiu_do_on("SearchRequest.OnExecute.invalod_rowrecord_array",
-                      vector_count = vectors_data_.float_data_.size() + 1);
-            if (vectors_data_.float_data_.size() % vector_count != 0) {
+            uint64_t float_data_size = vectors_data_.FloatDataSize();
+            fiu_do_on("SearchRequest.OnExecute.invalod_rowrecord_array", vector_count = float_data_size + 1);
+            if (float_data_size % vector_count != 0) {
                 return Status(SERVER_INVALID_ROWRECORD_ARRAY,
                               "The vector dimension must be equal to the table dimension.");
             }
             fiu_do_on("SearchRequest.OnExecute.invalid_dim", table_info.dimension_ = -1);
-            if (vectors_data_.float_data_.size() / vector_count != table_info.dimension_) {
+            if (float_data_size / vector_count != table_info.dimension_) {
                 return Status(SERVER_INVALID_VECTOR_DIMENSION,
                               "The vector dimension must be equal to the table dimension.");
             }
@@ -133,6 +145,12 @@ SearchRequest::OnExecute() {
 
         rc.RecordSection("prepare vector data");
 
+        // step 5: sample the validated query into the replay log
+        auto& recorder = QueryRecorder::GetInstance();
+        if (recorder.Enabled()) {
+            recorder.Record(table_name_, vectors_data_, topk_, nprobe_);
+        }
+
         // step 6: search vectors
         engine::ResultIds result_ids;
         engine::ResultDistances result_distances;
@@ -152,8 +170,28 @@ SearchRequest::OnExecute() {
                 return status;
             }
 
-            status = DBWrapper::DB()->Query(context_, table_name_, partition_list_, (size_t)topk_, nprobe_,
-                                            vectors_data_, dates, result_ids, result_distances);
+            // an identical search repeated while the table data is unchanged
+            // can be answered from the result cache without entering the engine
+            bool cache_hit = false;
+            std::string cache_key;
+            auto& result_cache = QueryResultCache::GetInstance();
+            if (result_cache.Enabled() && dates.empty()) {
+                cache_key = result_cache.MakeKey(table_name_, vectors_data_, topk_, nprobe_, partition_list_);
+                int64_t cached_row_num = 0;
+                cache_hit =
+                    !cache_key.empty() && result_cache.Get(cache_key, cached_row_num, result_ids, result_distances);
+            }
+
+            if (cache_hit) {
+                result_cache_hit_ = true;
+                rc.RecordSection("query result cache hit");
+            } else {
+                status = DBWrapper::DB()->Query(context_, table_name_, partition_list_, (size_t)topk_, nprobe_,
+                                                vectors_data_, dates, result_ids, result_distances);
+                if (status.ok() && !cache_key.empty() && !result_ids.empty()) {
+                    result_cache.Put(cache_key, vector_count, result_ids, result_distances);
+                }
+            }
         } else {
             status = DBWrapper::DB()->QueryByFileID(context_, table_name_, file_id_list_, (size_t)topk_, nprobe_,
                                                     vectors_data_, dates, result_ids, result_distances);
@@ -192,5 +230,15 @@ SearchRequest::OnExecute() {
     return Status::OK();
 }
 
+void
+SearchRequest::SlowQueryDetail(milvus::json& record) {
+    record["table"] = table_name_;
+    record["nq"] = vectors_data_.vector_count_;
+    record["topk"] = topk_;
+    record["nprobe"] = nprobe_;
+    record["partitions"] = partition_list_;
+    record["result_cache_hit"] = result_cache_hit_;
+}
+
 }  // namespace server
 }  // namespace milvus
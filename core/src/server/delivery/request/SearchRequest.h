@@ -37,6 +37,50 @@ class SearchRequest : public BaseRequest {
     Status
     OnExecute() override;
 
+    void
+    SlowQueryDetail(milvus::json& record) override;
+
+ public:
+    const std::string&
+    TableName() const {
+        return table_name_;
+    }
+
+    const engine::VectorsData&
+    VectorsData() const {
+        return vectors_data_;
+    }
+
+    int64_t
+    TopK() const {
+        return topk_;
+    }
+
+    int64_t
+    Nprobe() const {
+        return nprobe_;
+    }
+
+    const std::vector<Range>&
+    RangeList() const {
+        return range_list_;
+    }
+
+    const std::vector<std::string>&
+    PartitionList() const {
+        return partition_list_;
+    }
+
+    const std::vector<std::string>&
+    FileIdList() const {
+        return file_id_list_;
+    }
+
+    // called by SearchCombineRequest to deliver this request's slice of a combined query
+    void
+    FinishCombined(const Status& status, int64_t row_num, engine::ResultIds&& ids,
+                   engine::ResultDistances&& distances);
+
  private:
     const std::string table_name_;
     const engine::VectorsData& vectors_data_;
@@ -45,9 +89,12 @@ class SearchRequest : public BaseRequest {
     int64_t nprobe_;
     const std::vector<std::string> partition_list_;
     const std::vector<std::string> file_id_list_;
+    bool result_cache_hit_ = false;
 
     TopKQueryResult& result_;
 };
 
+using SearchRequestPtr = std::shared_ptr<SearchRequest>;
+
 }  // namespace server
 }  // namespace milvus
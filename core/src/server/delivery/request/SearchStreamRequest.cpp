@@ -0,0 +1,169 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/request/SearchStreamRequest.h"
+#include "server/DBWrapper.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+#include "utils/ValidationUtil.h"
+
+#include <memory>
+
+namespace milvus {
+namespace server {
+
+SearchStreamRequest::SearchStreamRequest(const std::shared_ptr<Context>& context, const std::string& table_name,
+                                         const engine::VectorsData& vectors, const std::vector<Range>& range_list,
+                                         int64_t topk, int64_t nprobe, const std::vector<std::string>& partition_list,
+                                         const SnapshotWriter& writer)
+    : BaseRequest(context, DQL_REQUEST_GROUP),
+      table_name_(table_name),
+      vectors_data_(vectors),
+      range_list_(range_list),
+      topk_(topk),
+      nprobe_(nprobe),
+      partition_list_(partition_list),
+      writer_(writer) {
+}
+
+BaseRequestPtr
+SearchStreamRequest::Create(const std::shared_ptr<Context>& context, const std::string& table_name,
+                            const engine::VectorsData& vectors, const std::vector<Range>& range_list, int64_t topk,
+                            int64_t nprobe, const std::vector<std::string>& partition_list,
+                            const SnapshotWriter& writer) {
+    return std::shared_ptr<BaseRequest>(
+        new SearchStreamRequest(context, table_name, vectors, range_list, topk, nprobe, partition_list, writer));
+}
+
+Status
+SearchStreamRequest::OnExecute() {
+    try {
+        uint64_t vector_count = vectors_data_.vector_count_;
+        std::string hdr = "SearchStreamRequest(table=" + table_name_ + ", nq=" + std::to_string(vector_count) +
+                          ", k=" + std::to_string(topk_) + ", nprob=" + std::to_string(nprobe_) + ")";
+
+        TimeRecorder rc(hdr);
+
+        // step 1: check table name
+        auto status = ValidationUtil::ValidateTableName(table_name_);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // step 2: check table existence
+        engine::meta::TableSchema table_info;
+        table_info.table_id_ = table_name_;
+        status = DBWrapper::DB()->DescribeTable(table_info);
+        if (!status.ok()) {
+            if (status.code() == DB_NOT_FOUND) {
+                return Status(SERVER_TABLE_NOT_EXIST, TableNotExistMsg(table_name_));
+            } else {
+                return status;
+            }
+        }
+
+        // step 3: check search parameter
+        status = ValidationUtil::ValidateSearchTopk(topk_, table_info);
+        if (!status.ok()) {
+            return status;
+        }
+
+        status = ValidationUtil::ValidateSearchNprobe(nprobe_, table_info);
+        if (!status.ok()) {
+            return status;
+        }
+
+        status = ValidationUtil::ValidatePartitionTags(partition_list_);
+        if (!status.ok()) {
+            return status;
+        }
+
+        if (vectors_data_.FloatDataSize() == 0 && vectors_data_.BinaryDataSize() == 0) {
+            return Status(SERVER_INVALID_ROWRECORD_ARRAY,
+                          "The vector array is empty. Make sure you have entered vector records.");
+        }
+
+        // step 4: check date range, and convert to db dates
+        std::vector<DB_DATE> dates;
+        status = ConvertTimeRangeToDBDates(range_list_, dates);
+        if (!status.ok()) {
+            return status;
+        }
+
+        // step 5: check vector dimension
+        if (ValidationUtil::IsBinaryMetricType(table_info.metric_type_)) {
+            if (vectors_data_.BinaryDataSize() % vector_count != 0) {
+                return Status(SERVER_INVALID_ROWRECORD_ARRAY,
+                              "The vector dimension must be equal to the table dimension.");
+            }
+
+            if (vectors_data_.BinaryDataSize() * 8 / vector_count != table_info.dimension_) {
+                return Status(SERVER_INVALID_VECTOR_DIMENSION,
+                              "The vector dimension must be equal to the table dimension.");
+            }
+        } else {
+            uint64_t float_data_size = vectors_data_.FloatDataSize();
+            if (float_data_size % vector_count != 0) {
+                return Status(SERVER_INVALID_ROWRECORD_ARRAY,
+                              "The vector dimension must be equal to the table dimension.");
+            }
+
+            if (float_data_size / vector_count != table_info.dimension_) {
+                return Status(SERVER_INVALID_VECTOR_DIMENSION,
+                              "The vector dimension must be equal to the table dimension.");
+            }
+        }
+
+        rc.RecordSection("check validation");
+
+        // step 6: search vectors, writing a snapshot after each index file. The callback
+        // runs on a scheduler thread while this thread is blocked inside QueryStream, so
+        // there is never more than one writer at a time.
+        engine::ResultIds result_ids;
+        engine::ResultDistances result_distances;
+        bool streamed = false;
+        bool client_alive = true;
+
+        engine::SearchStreamCallback stream_callback =
+            [&](uint64_t searched_files, uint64_t total_files, const engine::ResultIds& ids,
+                const engine::ResultDistances& distances) {
+                streamed = true;
+                if (client_alive) {
+                    TopKQueryResult snapshot(vector_count, ids, distances);
+                    client_alive = writer_(snapshot);
+                }
+            };
+
+        status = DBWrapper::DB()->QueryStream(context_, table_name_, partition_list_, (size_t)topk_, nprobe_,
+                                              vectors_data_, dates, stream_callback, result_ids, result_distances);
+
+        rc.RecordSection("stream vectors from engine");
+        if (!status.ok()) {
+            return status;
+        }
+
+        // a table without index files produces no snapshot; send the (empty) final result
+        // so the client always receives at least one message
+        if (!streamed && client_alive) {
+            TopKQueryResult final_result(vector_count, result_ids, result_distances);
+            writer_(final_result);
+        }
+
+        rc.ElapseFromBegin("totally cost");
+    } catch (std::exception& ex) {
+        return Status(SERVER_UNEXPECTED_ERROR, ex.what());
+    }
+
+    return Status::OK();
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -9,13 +9,19 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 #include <fiu-local.h>
+#include <chrono>
+#include <limits>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
+#include "db/engine/ExecutionEngine.h"
+#include "metrics/Metrics.h"
 #include "server/Config.h"
 #include "server/grpc_impl/GrpcRequestHandler.h"
+#include "server/grpc_impl/ShardRouter.h"
 #include "tracing/TextMapCarrier.h"
+#include "tracing/TraceSampler.h"
 #include "tracing/TracerUtil.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
@@ -78,18 +84,19 @@ CopyRowRecords(const google::protobuf::RepeatedPtrField<::milvus::grpc::RowRecor
         binary_data_size += record.binary_data().size();
     }
 
-    std::vector<float> float_array(float_data_size, 0.0f);
-    std::vector<uint8_t> binary_array(binary_data_size, 0);
-    int64_t float_offset = 0, binary_offset = 0;
+    // reserve + insert so the gather is a single touch of the buffer, without the
+    // zero-fill a sized construction would do first
+    std::vector<float> float_array;
+    std::vector<uint8_t> binary_array;
     if (float_data_size > 0) {
+        float_array.reserve(float_data_size);
         for (auto& record : grpc_records) {
-            memcpy(&float_array[float_offset], record.float_data().data(), record.float_data_size() * sizeof(float));
-            float_offset += record.float_data_size();
+            float_array.insert(float_array.end(), record.float_data().begin(), record.float_data().end());
         }
     } else if (binary_data_size > 0) {
+        binary_array.reserve(binary_data_size);
         for (auto& record : grpc_records) {
-            memcpy(&binary_array[binary_offset], record.binary_data().data(), record.binary_data().size());
-            binary_offset += record.binary_data().size();
+            binary_array.insert(binary_array.end(), record.binary_data().begin(), record.binary_data().end());
         }
     }
 
@@ -137,7 +144,16 @@ GrpcRequestHandler::OnPostRecvInitialMetaData(
         std::cerr << span_context_maybe.error().message() << std::endl;
         return;
     }
-    auto span = tracer_->StartSpan(server_rpc_info->method(), {opentracing::ChildOf(span_context_maybe->get())});
+    auto& sampler = tracing::TraceSampler::GetInstance();
+    bool trace_sampled = sampler.SampleHead();
+    std::unique_ptr<opentracing::Span> span;
+    if (trace_sampled) {
+        span = tracer_->StartSpan(server_rpc_info->method(), {opentracing::ChildOf(span_context_maybe->get())});
+    } else {
+        // noop span: downstream Child/Follower call sites stay valid at near-zero
+        // cost; if this rpc turns out slow it is tail-reported on finish
+        span = sampler.NoopTracer()->StartSpan(server_rpc_info->method());
+    }
     auto server_context = server_rpc_info->server_context();
     auto client_metadata = server_context->client_metadata();
     // TODO: request id
@@ -149,8 +165,19 @@ GrpcRequestHandler::OnPostRecvInitialMetaData(
         request_id = std::to_string(random_id()) + std::to_string(random_id());
     }
     auto trace_context = std::make_shared<tracing::TraceContext>(span);
+    trace_context->SetSampled(trace_sampled);
     auto context = std::make_shared<Context>(request_id);
     context->SetTraceContext(trace_context);
+    // client identity for per-client rate limiting; untagged clients share one bucket
+    auto client_tag_kv = client_metadata.find("client_tag");
+    if (client_tag_kv != client_metadata.end()) {
+        context->SetClientTag(std::string(client_tag_kv->second.data(), client_tag_kv->second.length()));
+    }
+    // carry the client's rpc deadline so abandoned work can be dropped
+    auto deadline = server_context->deadline();
+    if (deadline < std::chrono::system_clock::time_point::max()) {
+        context->SetDeadline(deadline);
+    }
     SetContext(server_rpc_info->server_context(), context);
 }
 
@@ -158,7 +185,11 @@ void
 GrpcRequestHandler::OnPreSendMessage(::grpc::experimental::ServerRpcInfo* server_rpc_info,
                                      ::grpc::experimental::InterceptorBatchMethods* interceptor_batch_methods) {
     std::lock_guard<std::mutex> lock(context_map_mutex_);
-    context_map_[server_rpc_info->server_context()]->GetTraceContext()->GetSpan()->Finish();
+    auto& trace_context = context_map_[server_rpc_info->server_context()]->GetTraceContext();
+    trace_context->GetSpan()->Finish();
+    if (!trace_context->sampled()) {
+        tracing::TraceSampler::GetInstance().MaybeReportSlow(server_rpc_info->method(), trace_context->start_time());
+    }
     auto search = context_map_.find(server_rpc_info->server_context());
     if (search != context_map_.end()) {
         context_map_.erase(search);
@@ -221,6 +252,9 @@ GrpcRequestHandler::DropTable(::grpc::ServerContext* context, const ::milvus::gr
     CHECK_NULLPTR_RETURN(request);
 
     Status status = request_handler_.DropTable(context_map_[context], request->table_name());
+    if (status.ok()) {
+        ShardRouter::GetInstance().InvalidateReduceOrder(request->table_name());
+    }
 
     SET_RESPONSE(response, status, context);
     return ::grpc::Status::OK;
@@ -260,14 +294,140 @@ GrpcRequestHandler::Insert(::grpc::ServerContext* context, const ::milvus::grpc:
     return ::grpc::Status::OK;
 }
 
+::grpc::Status
+GrpcRequestHandler::InsertPacked(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* request,
+                                 ::milvus::grpc::VectorIds* response) {
+    CHECK_NULLPTR_RETURN(request);
+
+    // step 1: validate the blob framing with a single bounds check
+    Status status;
+    if (request->row_record_array_size() != 1 || request->row_record_array(0).float_data_size() != 0) {
+        status = Status(SERVER_INVALID_ROWRECORD_ARRAY,
+                        "A packed insert requires exactly one row record carrying the blob in binary_data.");
+        SET_RESPONSE(response->mutable_status(), status, context);
+        return ::grpc::Status::OK;
+    }
+
+    const std::string& blob = request->row_record_array(0).binary_data();
+    int64_t header[2] = {0, 0};  // row_num, dim
+    if (blob.size() >= sizeof(header)) {
+        memcpy(header, blob.data(), sizeof(header));
+    }
+    uint64_t row_num = static_cast<uint64_t>(header[0]);
+    uint64_t dim = static_cast<uint64_t>(header[1]);
+    // guard the full byte count, not just row_num*dim: the extra
+    // *sizeof(float) can wrap mod 2^64 on its own, which would let a crafted
+    // header pass the size comparison and request an absurd allocation below
+    if (header[0] <= 0 || header[1] <= 0 ||
+        row_num > std::numeric_limits<uint64_t>::max() / sizeof(float) / dim ||
+        blob.size() != sizeof(header) + row_num * dim * sizeof(float)) {
+        status = Status(SERVER_INVALID_ROWRECORD_ARRAY,
+                        "The packed blob does not match its row_num/dim header. Expected layout: "
+                        "[int64 row_num][int64 dim][row_num*dim little-endian float32].");
+        SET_RESPONSE(response->mutable_status(), status, context);
+        return ::grpc::Status::OK;
+    }
+
+    // step 2: copy vector data. One bulk memcpy into the owning buffer; the
+    // ingest path moves the slab into the memtable, so a borrowed view of the
+    // protobuf buffer cannot be used here
+    engine::VectorsData vectors;
+    vectors.vector_count_ = row_num;
+    vectors.float_data_.resize(row_num * dim);
+    memcpy(vectors.float_data_.data(), blob.data() + sizeof(header), row_num * dim * sizeof(float));
+    if (request->row_id_array_size() > 0) {
+        vectors.id_array_.resize(request->row_id_array_size());
+        memcpy(vectors.id_array_.data(), request->row_id_array().data(),
+               request->row_id_array_size() * sizeof(int64_t));
+    }
+
+    // step 3: insert vectors
+    status = request_handler_.Insert(context_map_[context], request->table_name(), vectors, request->partition_tag());
+
+    // step 4: return id array
+    response->mutable_vector_id_array()->Resize(static_cast<int>(vectors.id_array_.size()), 0);
+    memcpy(response->mutable_vector_id_array()->mutable_data(), vectors.id_array_.data(),
+           vectors.id_array_.size() * sizeof(int64_t));
+
+    SET_RESPONSE(response->mutable_status(), status, context);
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status
+GrpcRequestHandler::ExportTable(::grpc::ServerContext* context, const ::milvus::grpc::TableName* request,
+                                ::grpc::ServerWriter<::milvus::grpc::InsertParam>* writer) {
+    CHECK_NULLPTR_RETURN(request);
+
+    // stream one InsertParam per raw slab, using the InsertPacked blob framing
+    // so a dump can be fed straight back through InsertPacked. The writer
+    // lambda runs while this thread blocks inside ExportTable, so writes are
+    // never concurrent. A false return cancels the rest of the export.
+    auto chunk_writer = [&](int64_t count, int64_t dim, const float* vectors, const int64_t* ids) -> bool {
+        ::milvus::grpc::InsertParam message;
+        message.set_table_name(request->table_name());
+
+        int64_t header[2] = {count, dim};
+        std::string& blob = *message.add_row_record_array()->mutable_binary_data();
+        blob.resize(sizeof(header) + count * dim * sizeof(float));
+        memcpy(&blob[0], header, sizeof(header));
+        memcpy(&blob[sizeof(header)], vectors, count * dim * sizeof(float));
+
+        message.mutable_row_id_array()->Resize(static_cast<int>(count), 0);
+        memcpy(message.mutable_row_id_array()->mutable_data(), ids, count * sizeof(int64_t));
+
+        return writer->Write(message);
+    };
+
+    Status status = request_handler_.ExportTable(context_map_[context], request->table_name(), chunk_writer);
+
+    // InsertParam has no status field, so a failure surfaces as a gRPC error
+    // instead of the usual in-band trailing status message
+    if (!status.ok()) {
+        return ::grpc::Status(::grpc::StatusCode::INTERNAL, status.message());
+    }
+
+    return ::grpc::Status::OK;
+}
+
+bool
+GrpcRequestHandler::GetReduceOrder(const std::shared_ptr<Context>& context, const std::string& table_name) {
+    auto& router = ShardRouter::GetInstance();
+    bool ascending = true;
+    if (!router.GetReduceOrder(table_name, ascending)) {
+        TableSchema table_schema;
+        auto describe_status = request_handler_.DescribeTable(context, table_name, table_schema);
+        if (describe_status.ok()) {
+            ascending = table_schema.metric_type_ != static_cast<int64_t>(engine::MetricType::IP);
+            router.SetReduceOrder(table_name, ascending);
+        }
+    }
+    return ascending;
+}
+
 ::grpc::Status
 GrpcRequestHandler::Search(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
                            ::milvus::grpc::TopKQueryResult* response) {
     CHECK_NULLPTR_RETURN(request);
 
-    // step 1: copy vector data
+    // step 1: prepare vector data. A single row record is wrapped zero-copy: the
+    // protobuf request outlives the blocking search call, so the engine can read the
+    // protobuf buffer directly. Multi-record queries are gathered with one bulk copy
+    // since their records are not contiguous in memory.
     engine::VectorsData vectors;
-    CopyRowRecords(request->query_record_array(), google::protobuf::RepeatedField<google::protobuf::int64>(), vectors);
+    if (request->query_record_array_size() == 1) {
+        auto& record = request->query_record_array(0);
+        vectors.vector_count_ = 1;
+        if (record.float_data_size() > 0) {
+            vectors.float_view_ = record.float_data().data();
+            vectors.float_view_size_ = record.float_data_size();
+        } else if (!record.binary_data().empty()) {
+            vectors.binary_view_ = reinterpret_cast<const uint8_t*>(record.binary_data().data());
+            vectors.binary_view_size_ = record.binary_data().size();
+        }
+    } else {
+        CopyRowRecords(request->query_record_array(), google::protobuf::RepeatedField<google::protobuf::int64>(),
+                       vectors);
+    }
 
     // deprecated
     std::vector<Range> ranges;
@@ -285,10 +445,32 @@ GrpcRequestHandler::Search(::grpc::ServerContext* context, const ::milvus::grpc:
     std::vector<std::string> file_ids;
     TopKQueryResult result;
     fiu_do_on("GrpcRequestHandler.Search.not_empty_file_ids", file_ids.emplace_back("test_file_id"));
-    Status status = request_handler_.Search(context_map_[context], request->table_name(), vectors, ranges,
-                                            request->topk(), request->nprobe(), partitions, file_ids, result);
+    auto context_ptr = GetContext(context);
+    context_ptr->MaybeEnableProfiling();
+    auto& router = ShardRouter::GetInstance();
+    bool routed = router.Enabled() && file_ids.empty();
+
+    Status status;
+    if (routed && router.GetPolicy() == ShardRouter::Policy::SHARD) {
+        // shard policy: every segment is owned by exactly one replica, so the
+        // sharded fan-out replaces the node-local full search entirely
+        status = router.ShardedSearch(context_ptr, request_handler_, *request, vectors,
+                                      GetReduceOrder(context_ptr, request->table_name()), result);
+    } else {
+        status = request_handler_.Search(context_ptr, request->table_name(), vectors, ranges, request->topk(),
+                                         request->nprobe(), partitions, file_ids, result);
+
+        // step 4: mirror policy fans out to shard peers and folds their topk
+        // into the local one. This replaces the python mishards middleware on
+        // the hot path; with no peers configured the search stays node-local,
+        // exactly as before.
+        if (status.ok() && routed) {
+            status = router.Search(*request, GetReduceOrder(context_ptr, request->table_name()), result);
+        }
+    }
 
-    // step 4: construct and return result
+    // step 5: construct and return result
+    auto serialize_start = std::chrono::steady_clock::now();
     response->set_row_num(result.row_num_);
 
     response->mutable_ids()->Resize(static_cast<int>(result.id_list_.size()), 0);
@@ -300,6 +482,20 @@ GrpcRequestHandler::Search(::grpc::ServerContext* context, const ::milvus::grpc:
 
     SET_RESPONSE(response->mutable_status(), status, context);
 
+    // sampled requests flush their stage breakdown once the response is built;
+    // unsampled requests only paid the null check above
+    if (auto& profile = context_ptr->GetProfile()) {
+        profile->serialize_ns_ +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - serialize_start)
+                .count();
+        auto& metrics = Metrics::GetInstance();
+        metrics.QueryStageLatencySecondsObserve("queue_wait", profile->queue_wait_ns_.load() / 1e9);
+        metrics.QueryStageLatencySecondsObserve("load", profile->load_ns_.load() / 1e9);
+        metrics.QueryStageLatencySecondsObserve("search", profile->search_ns_.load() / 1e9);
+        metrics.QueryStageLatencySecondsObserve("reduce", profile->reduce_ns_.load() / 1e9);
+        metrics.QueryStageLatencySecondsObserve("serialize", profile->serialize_ns_.load() / 1e9);
+    }
+
     return ::grpc::Status::OK;
 }
 
@@ -353,6 +549,293 @@ GrpcRequestHandler::SearchInFiles(::grpc::ServerContext* context, const ::milvus
     return ::grpc::Status::OK;
 }
 
+::grpc::Status
+GrpcRequestHandler::SearchStream(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                                 ::grpc::ServerWriter<::milvus::grpc::TopKQueryResult>* writer) {
+    CHECK_NULLPTR_RETURN(request);
+
+    // step 1: copy vector data. The request outlives the blocking call below, so a single
+    // row record is wrapped zero-copy like in Search()
+    engine::VectorsData vectors;
+    if (request->query_record_array_size() == 1) {
+        auto& record = request->query_record_array(0);
+        vectors.vector_count_ = 1;
+        if (record.float_data_size() > 0) {
+            vectors.float_view_ = record.float_data().data();
+            vectors.float_view_size_ = record.float_data_size();
+        } else if (!record.binary_data().empty()) {
+            vectors.binary_view_ = reinterpret_cast<const uint8_t*>(record.binary_data().data());
+            vectors.binary_view_size_ = record.binary_data().size();
+        }
+    } else {
+        CopyRowRecords(request->query_record_array(), google::protobuf::RepeatedField<google::protobuf::int64>(),
+                       vectors);
+    }
+
+    // deprecated
+    std::vector<Range> ranges;
+    for (auto& range : request->query_range_array()) {
+        ranges.emplace_back(range.start_value(), range.end_value());
+    }
+
+    // step 2: partition tags
+    std::vector<std::string> partitions;
+    for (auto& partition : request->partition_tag_array()) {
+        partitions.emplace_back(partition);
+    }
+
+    // step 3: search vectors, writing one message per partial-result snapshot. The writer
+    // lambda runs on a scheduler thread while this thread blocks inside SearchStream, so
+    // writes are never concurrent. A false return stops further snapshots.
+    auto snapshot_writer = [&](const TopKQueryResult& snapshot) -> bool {
+        ::milvus::grpc::TopKQueryResult message;
+        message.set_row_num(snapshot.row_num_);
+
+        message.mutable_ids()->Resize(static_cast<int>(snapshot.id_list_.size()), 0);
+        memcpy(message.mutable_ids()->mutable_data(), snapshot.id_list_.data(),
+               snapshot.id_list_.size() * sizeof(int64_t));
+
+        message.mutable_distances()->Resize(static_cast<int>(snapshot.distance_list_.size()), 0.0);
+        memcpy(message.mutable_distances()->mutable_data(), snapshot.distance_list_.data(),
+               snapshot.distance_list_.size() * sizeof(float));
+
+        message.mutable_status()->set_error_code(::milvus::grpc::ErrorCode::SUCCESS);
+        return writer->Write(message);
+    };
+
+    Status status = request_handler_.SearchStream(context_map_[context], request->table_name(), vectors, ranges,
+                                                  request->topk(), request->nprobe(), partitions, snapshot_writer);
+
+    // step 4: an error produces one trailing message carrying the status
+    if (!status.ok()) {
+        ::milvus::grpc::TopKQueryResult message;
+        SET_RESPONSE(message.mutable_status(), status, context);
+        writer->Write(message);
+    }
+
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status
+GrpcRequestHandler::RangeSearch(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                                ::grpc::ServerWriter<::milvus::grpc::TopKQueryResult>* writer) {
+    CHECK_NULLPTR_RETURN(request);
+
+    // step 1: the radius rides in query_range_array[0].start_value as a decimal string,
+    // since SearchParam has no dedicated radius field
+    Status status;
+    float radius = 0.0f;
+    if (request->query_range_array_size() == 0) {
+        status = Status(SERVER_INVALID_ARGUMENT,
+                        "Range search requires the radius in query_range_array[0].start_value.");
+    } else {
+        try {
+            radius = std::stof(request->query_range_array(0).start_value());
+        } catch (std::exception& ex) {
+            status = Status(SERVER_INVALID_ARGUMENT, "Invalid radius: " + request->query_range_array(0).start_value());
+        }
+    }
+
+    if (status.ok()) {
+        // step 2: copy vector data and partition tags
+        engine::VectorsData vectors;
+        CopyRowRecords(request->query_record_array(), google::protobuf::RepeatedField<google::protobuf::int64>(),
+                       vectors);
+
+        std::vector<std::string> partitions;
+        for (auto& partition : request->partition_tag_array()) {
+            partitions.emplace_back(partition);
+        }
+
+        // step 3: range search, writing one variable-length message per query vector.
+        // The writer lambda runs while this thread blocks inside RangeSearch, so writes
+        // are never concurrent. A false return stops further messages.
+        auto result_writer = [&](const TopKQueryResult& result) -> bool {
+            ::milvus::grpc::TopKQueryResult message;
+            message.set_row_num(result.row_num_);
+
+            message.mutable_ids()->Resize(static_cast<int>(result.id_list_.size()), 0);
+            memcpy(message.mutable_ids()->mutable_data(), result.id_list_.data(),
+                   result.id_list_.size() * sizeof(int64_t));
+
+            message.mutable_distances()->Resize(static_cast<int>(result.distance_list_.size()), 0.0);
+            memcpy(message.mutable_distances()->mutable_data(), result.distance_list_.data(),
+                   result.distance_list_.size() * sizeof(float));
+
+            message.mutable_status()->set_error_code(::milvus::grpc::ErrorCode::SUCCESS);
+            return writer->Write(message);
+        };
+
+        status = request_handler_.RangeSearch(context_map_[context], request->table_name(), vectors, radius,
+                                              request->topk(), request->nprobe(), partitions, result_writer);
+    }
+
+    // step 4: an error produces one trailing message carrying the status
+    if (!status.ok()) {
+        ::milvus::grpc::TopKQueryResult message;
+        SET_RESPONSE(message.mutable_status(), status, context);
+        writer->Write(message);
+    }
+
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status
+GrpcRequestHandler::SearchPaged(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                                ::milvus::grpc::TopKQueryResult* response) {
+    CHECK_NULLPTR_RETURN(request);
+
+    // step 1: the continuation token rides in query_range_array[0].start_value (empty
+    // opens a new cursor) and the page size in end_value as a decimal string, since
+    // SearchParam has no dedicated fields for them
+    Status status;
+    std::string token;
+    int64_t page_size = 0;
+    if (request->query_range_array_size() == 0) {
+        status = Status(SERVER_INVALID_ARGUMENT,
+                        "Paged search requires the page size in query_range_array[0].end_value.");
+    } else {
+        token = request->query_range_array(0).start_value();
+        try {
+            page_size = std::stoll(request->query_range_array(0).end_value());
+        } catch (std::exception& ex) {
+            status = Status(SERVER_INVALID_ARGUMENT,
+                            "Invalid page size: " + request->query_range_array(0).end_value());
+        }
+    }
+
+    TopKQueryResult result;
+    if (status.ok()) {
+        // step 2: vector data is only needed when opening a new cursor; a single row
+        // record is wrapped zero-copy like in Search() since the request outlives the
+        // blocking call
+        engine::VectorsData vectors;
+        if (request->query_record_array_size() == 1) {
+            auto& record = request->query_record_array(0);
+            vectors.vector_count_ = 1;
+            if (record.float_data_size() > 0) {
+                vectors.float_view_ = record.float_data().data();
+                vectors.float_view_size_ = record.float_data_size();
+            }
+        } else if (request->query_record_array_size() > 1) {
+            CopyRowRecords(request->query_record_array(), google::protobuf::RepeatedField<google::protobuf::int64>(),
+                           vectors);
+        }
+
+        // step 3: partition tags
+        std::vector<std::string> partitions;
+        for (auto& partition : request->partition_tag_array()) {
+            partitions.emplace_back(partition);
+        }
+
+        // step 4: fetch one page; `token` is updated with the next-page token
+        status = request_handler_.SearchPaged(context_map_[context], request->table_name(), vectors, request->topk(),
+                                              request->nprobe(), partitions, page_size, token, result);
+    }
+
+    // step 5: construct and return the page; on success the next-page token is
+    // carried back in status.reason (empty when the cursor is exhausted)
+    response->set_row_num(result.row_num_);
+
+    response->mutable_ids()->Resize(static_cast<int>(result.id_list_.size()), 0);
+    memcpy(response->mutable_ids()->mutable_data(), result.id_list_.data(), result.id_list_.size() * sizeof(int64_t));
+
+    response->mutable_distances()->Resize(static_cast<int>(result.distance_list_.size()), 0.0);
+    memcpy(response->mutable_distances()->mutable_data(), result.distance_list_.data(),
+           result.distance_list_.size() * sizeof(float));
+
+    SET_RESPONSE(response->mutable_status(), status, context);
+    if (status.ok()) {
+        response->mutable_status()->set_reason(token);
+    }
+
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status
+GrpcRequestHandler::SearchPacked(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                                 ::milvus::grpc::RowRecord* response) {
+    CHECK_NULLPTR_RETURN(request);
+
+    // step 1: prepare vector data, same zero-copy wrapping as Search()
+    engine::VectorsData vectors;
+    if (request->query_record_array_size() == 1) {
+        auto& record = request->query_record_array(0);
+        vectors.vector_count_ = 1;
+        if (record.float_data_size() > 0) {
+            vectors.float_view_ = record.float_data().data();
+            vectors.float_view_size_ = record.float_data_size();
+        } else if (!record.binary_data().empty()) {
+            vectors.binary_view_ = reinterpret_cast<const uint8_t*>(record.binary_data().data());
+            vectors.binary_view_size_ = record.binary_data().size();
+        }
+    } else {
+        CopyRowRecords(request->query_record_array(), google::protobuf::RepeatedField<google::protobuf::int64>(),
+                       vectors);
+    }
+
+    // deprecated
+    std::vector<Range> ranges;
+    for (auto& range : request->query_range_array()) {
+        ranges.emplace_back(range.start_value(), range.end_value());
+    }
+
+    // step 2: partition tags
+    std::vector<std::string> partitions;
+    for (auto& partition : request->partition_tag_array()) {
+        partitions.emplace_back(partition);
+    }
+
+    // step 3: search vectors, routed exactly as in Search()
+    std::vector<std::string> file_ids;
+    TopKQueryResult result;
+    auto context_ptr = GetContext(context);
+    context_ptr->MaybeEnableProfiling();
+    auto& router = ShardRouter::GetInstance();
+    bool routed = router.Enabled() && file_ids.empty();
+
+    Status status;
+    if (routed && router.GetPolicy() == ShardRouter::Policy::SHARD) {
+        status = router.ShardedSearch(context_ptr, request_handler_, *request, vectors,
+                                      GetReduceOrder(context_ptr, request->table_name()), result);
+    } else {
+        status = request_handler_.Search(context_ptr, request->table_name(), vectors, ranges, request->topk(),
+                                         request->nprobe(), partitions, file_ids, result);
+        if (status.ok() && routed) {
+            status = router.Search(*request, GetReduceOrder(context_ptr, request->table_name()), result);
+        }
+    }
+
+    // RowRecord has no status field, so failures surface as a gRPC error,
+    // mirroring ExportTable
+    if (!status.ok()) {
+        SERVER_LOG_ERROR << "SearchPacked failed: " << status.message();
+        return ::grpc::Status(::grpc::StatusCode::INTERNAL, status.message());
+    }
+
+    // step 4: pack the result as one blob: [int64 row_num][int64 topk] then
+    // row_num*topk ids and row_num*topk distances, all little-endian. Unlike
+    // the repeated int64 ids of TopKQueryResult, bytes serialize without
+    // per-element varint encoding.
+    int64_t row_num = result.row_num_;
+    int64_t topk = row_num > 0 ? static_cast<int64_t>(result.id_list_.size()) / row_num : 0;
+    size_t ids_bytes = result.id_list_.size() * sizeof(int64_t);
+    size_t distances_bytes = result.distance_list_.size() * sizeof(float);
+
+    std::string& blob = *response->mutable_binary_data();
+    blob.resize(2 * sizeof(int64_t) + ids_bytes + distances_bytes);
+    char* cursor = &blob[0];
+    memcpy(cursor, &row_num, sizeof(int64_t));
+    cursor += sizeof(int64_t);
+    memcpy(cursor, &topk, sizeof(int64_t));
+    cursor += sizeof(int64_t);
+    memcpy(cursor, result.id_list_.data(), ids_bytes);
+    cursor += ids_bytes;
+    memcpy(cursor, result.distance_list_.data(), distances_bytes);
+
+    return ::grpc::Status::OK;
+}
+
 ::grpc::Status
 GrpcRequestHandler::DescribeTable(::grpc::ServerContext* context, const ::milvus::grpc::TableName* request,
                                   ::milvus::grpc::TableSchema* response) {
@@ -195,6 +195,30 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
     Insert(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* request,
            ::milvus::grpc::VectorIds* response) override;
     // *
+    // @brief This method is used to add vectors as one packed blob:
+    // row_record_array[0].binary_data holds [int64 row_num][int64 dim]
+    // followed by row_num*dim little-endian float32 values.
+    //
+    // @param InsertParam, insert parameters.
+    //
+    // @return VectorIds
+    ::grpc::Status
+    InsertPacked(::grpc::ServerContext* context, const ::milvus::grpc::InsertParam* request,
+                 ::milvus::grpc::VectorIds* response) override;
+    // *
+    // @brief This method is used to stream every stored vector of a table back
+    // to the client straight from the raw files. Each message carries one slab
+    // in the InsertPacked packed-blob framing plus the matching row ids, so a
+    // dump can be re-ingested via InsertPacked unchanged. Errors are reported
+    // through the gRPC status since InsertParam carries no status field.
+    //
+    // @param TableName, target table name.
+    //
+    // @return InsertParam stream
+    ::grpc::Status
+    ExportTable(::grpc::ServerContext* context, const ::milvus::grpc::TableName* request,
+                ::grpc::ServerWriter<::milvus::grpc::InsertParam>* writer) override;
+    // *
     // @brief This method is used to query vector in table.
     //
     // @param SearchParam, search parameters.
@@ -214,6 +238,56 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
     SearchInFiles(::grpc::ServerContext* context, const ::milvus::grpc::SearchInFilesParam* request,
                   ::milvus::grpc::TopKQueryResult* response) override;
 
+    // *
+    // @brief This method is used to query vector in table, streaming an
+    // incrementally-merged top-k snapshot each time an index file finishes.
+    //
+    // @param SearchParam, search parameters.
+    //
+    // @return TopKQueryResult stream
+    ::grpc::Status
+    SearchStream(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                 ::grpc::ServerWriter<::milvus::grpc::TopKQueryResult>* writer) override;
+
+    // *
+    // @brief This method is used to query all vectors within a distance radius
+    // of each query vector. The radius is carried as a decimal string in
+    // query_range_array[0].start_value; one message is streamed per query.
+    //
+    // @param SearchParam, search parameters.
+    //
+    // @return TopKQueryResult stream
+    ::grpc::Status
+    RangeSearch(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                ::grpc::ServerWriter<::milvus::grpc::TopKQueryResult>* writer) override;
+
+    // *
+    // @brief This method is used to page through a deep-topk query. The
+    // continuation token is carried in query_range_array[0].start_value (empty
+    // opens a new cursor) with the page size in end_value; the token for the
+    // next page is returned in status.reason.
+    //
+    // @param SearchParam, search parameters.
+    //
+    // @return TopKQueryResult
+    ::grpc::Status
+    SearchPaged(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                ::milvus::grpc::TopKQueryResult* response) override;
+
+    // *
+    // @brief This method runs the same search as Search but packs the result
+    // into RowRecord.binary_data as [int64 row_num][int64 topk] followed by
+    // the ids and distances, so it serializes at memcpy speed instead of
+    // re-encoding every id as a varint. Errors are reported through the gRPC
+    // status since RowRecord carries no status field.
+    //
+    // @param SearchParam, search parameters.
+    //
+    // @return RowRecord
+    ::grpc::Status
+    SearchPacked(::grpc::ServerContext* context, const ::milvus::grpc::SearchParam* request,
+                 ::milvus::grpc::RowRecord* response) override;
+
     // *
     // @brief This method is used to give the server status.
     //
@@ -248,6 +322,12 @@ class GrpcRequestHandler final : public ::milvus::grpc::MilvusService::Service,
     }
 
  private:
+    // reduce order for routed searches: ascending for distance metrics,
+    // descending for IP; resolved via DescribeTable once and cached in the
+    // shard router until the table is dropped
+    bool
+    GetReduceOrder(const std::shared_ptr<Context>& context, const std::string& table_name);
+
     RequestHandler request_handler_;
 
     std::unordered_map<::grpc::ServerContext*, std::shared_ptr<Context>> context_map_;
@@ -19,8 +19,11 @@
 #include <grpcpp/channel.h>
 #include <grpcpp/client_context.h>
 #include <grpcpp/create_channel.h>
+#include <grpcpp/resource_quota.h>
 #include <grpcpp/security/credentials.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <memory>
@@ -93,6 +96,26 @@ GrpcServer::StartService() {
     builder.SetMaxReceiveMessageSize(MESSAGE_SIZE);  // default 4 * 1024 * 1024
     builder.SetMaxSendMessageSize(MESSAGE_SIZE);
 
+    // one completion queue serializes the polling of every connection; spreading
+    // connections across several queues lets concurrent requests enter the
+    // delivery layer in parallel. 0 means one queue per core
+    int64_t cq_num = 0;
+    config.GetServerConfigGrpcCqNum(cq_num);
+    if (cq_num <= 0) {
+        cq_num = std::max(static_cast<int64_t>(std::thread::hardware_concurrency()), static_cast<int64_t>(1));
+    }
+    builder.SetSyncServerOption(::grpc::ServerBuilder::SyncServerOption::NUM_CQS, cq_num);
+    builder.SetSyncServerOption(::grpc::ServerBuilder::SyncServerOption::MIN_POLLERS, 1);
+
+    // the sync API grows one handler thread per in-flight call, and every one
+    // of them blocks until its request leaves the delivery queue. The request
+    // groups already run bounded worker pools, so threads beyond a few per
+    // worker only add stacks and context switches; cap the transport and let
+    // excess calls queue inside gRPC instead
+    ::grpc::ResourceQuota quota("milvus_server");
+    quota.SetMaxThreads(static_cast<int>(cq_num * 4 + 32));
+    builder.SetResourceQuota(quota);
+
     builder.SetCompressionAlgorithmSupportStatus(GRPC_COMPRESS_STREAM_GZIP, true);
     builder.SetDefaultCompressionAlgorithm(GRPC_COMPRESS_STREAM_GZIP);
     builder.SetDefaultCompressionLevel(GRPC_COMPRESS_LEVEL_NONE);
@@ -101,6 +124,17 @@ GrpcServer::StartService() {
     service.RegisterRequestHandler(RequestHandler());
 
     builder.AddListeningPort(server_address, ::grpc::InsecureServerCredentials());
+
+    // co-located clients can skip the TCP stack entirely over a unix domain
+    // socket; empty path (the default) leaves the listener off
+    std::string unix_socket_path;
+    config.GetServerConfigUnixSocketPath(unix_socket_path);
+    if (!unix_socket_path.empty()) {
+        // a socket file left behind by an unclean shutdown would fail the bind
+        ::unlink(unix_socket_path.c_str());
+        builder.AddListeningPort("unix:" + unix_socket_path, ::grpc::InsecureServerCredentials());
+    }
+
     builder.RegisterService(&service);
 
     // Add gRPC interceptor
@@ -0,0 +1,289 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/grpc_impl/ShardRouter.h"
+
+#include <functional>
+#include <future>
+#include <utility>
+
+#include "scheduler/task/SearchTask.h"
+#include "server/Config.h"
+#include "server/DBWrapper.h"
+#include "utils/Log.h"
+#include "utils/StringHelpFunctions.h"
+
+namespace milvus {
+namespace server {
+namespace grpc {
+
+Status
+ShardRouter::Init() {
+    std::string peers_str;
+    Status s = Config::GetInstance().GetServerConfigRouterPeers(peers_str);
+    if (!s.ok()) {
+        return s;
+    }
+
+    std::string policy_str;
+    s = Config::GetInstance().GetServerConfigRouterPolicy(policy_str);
+    if (!s.ok()) {
+        return s;
+    }
+    policy_ = ("shard" == policy_str) ? Policy::SHARD : Policy::MIRROR;
+
+    if (peers_str.empty()) {
+        return Status::OK();
+    }
+
+    std::vector<std::string> addresses;
+    StringHelpFunctions::SplitStringByDelimeter(peers_str, ",", addresses);
+    for (auto& address : addresses) {
+        Peer peer;
+        peer.address = address;
+        peer.stub = ::milvus::grpc::MilvusService::NewStub(
+            ::grpc::CreateChannel(address, ::grpc::InsecureChannelCredentials()));
+        peers_.emplace_back(std::move(peer));
+        SERVER_LOG_INFO << "Shard router peer: " << address;
+    }
+
+    return Status::OK();
+}
+
+Status
+ShardRouter::Search(const ::milvus::grpc::SearchParam& request, bool ascending, TopKQueryResult& result) {
+    size_t nq = request.query_record_array_size();
+    size_t topk = request.topk();
+    if (nq == 0 || topk == 0) {
+        return Status::OK();
+    }
+
+    // fan out first, then block on the replies; the local search already ran
+    // so the peers overlap only with each other, not with local compute
+    std::vector<std::future<std::pair<::grpc::Status, ::milvus::grpc::TopKQueryResult>>> replies;
+    for (auto& peer : peers_) {
+        replies.emplace_back(std::async(std::launch::async, [&peer, &request] {
+            ::grpc::ClientContext client_context;
+            ::milvus::grpc::TopKQueryResult reply;
+            ::grpc::Status grpc_status = peer.stub->Search(&client_context, request, &reply);
+            return std::make_pair(grpc_status, std::move(reply));
+        }));
+    }
+
+    Status status = Status::OK();
+    for (size_t i = 0; i < replies.size(); ++i) {
+        auto reply = replies[i].get();
+        if (!reply.first.ok()) {
+            std::string msg = "Search on peer " + peers_[i].address + " failed: " + reply.first.error_message();
+            SERVER_LOG_ERROR << msg;
+            status = Status(SERVER_UNEXPECTED_ERROR, msg);
+            continue;  // keep draining the futures so none is abandoned mid-flight
+        }
+        if (reply.second.status().error_code() != ::milvus::grpc::ErrorCode::SUCCESS) {
+            std::string msg = "Search on peer " + peers_[i].address + " failed: " + reply.second.status().reason();
+            SERVER_LOG_ERROR << msg;
+            status = Status(SERVER_UNEXPECTED_ERROR, msg);
+            continue;
+        }
+        if (!status.ok() || reply.second.row_num() == 0) {
+            continue;
+        }
+
+        // the peer's per-row stride may be smaller than topk when it holds
+        // fewer vectors than requested, so merge with the stride decoupled
+        size_t src_k = reply.second.ids_size() / reply.second.row_num();
+        engine::ResultIds src_ids(reply.second.ids().begin(), reply.second.ids().end());
+        engine::ResultDistances src_distances(reply.second.distances().begin(), reply.second.distances().end());
+        scheduler::XSearchTask::MergeResultSet(src_ids, src_distances, src_k, src_k, nq, topk, ascending,
+                                               result.id_list_, result.distance_list_);
+    }
+
+    if (!status.ok()) {
+        return status;
+    }
+
+    if (!result.id_list_.empty()) {
+        result.row_num_ = nq;
+    }
+    return Status::OK();
+}
+
+size_t
+ShardRouter::OwnerOf(const std::string& table_id, const std::string& file_id) const {
+    std::hash<std::string> hasher;
+    std::string segment = table_id + "/" + file_id;
+
+    // highest-random-weight hash: ownership only moves for the segments a
+    // departed replica held, never wholesale
+    size_t winner = peers_.size();  // local replica
+    size_t best = hasher(segment + "|local");
+    for (size_t i = 0; i < peers_.size(); ++i) {
+        size_t weight = hasher(segment + "|" + peers_[i].address);
+        if (weight > best) {
+            best = weight;
+            winner = i;
+        }
+    }
+    return winner;
+}
+
+Status
+ShardRouter::ShardedSearch(const std::shared_ptr<Context>& context, RequestHandler& handler,
+                           const ::milvus::grpc::SearchParam& request, const engine::VectorsData& vectors,
+                           bool ascending, TopKQueryResult& result) {
+    size_t nq = request.query_record_array_size();
+    size_t topk = request.topk();
+    if (nq == 0 || topk == 0) {
+        return Status::OK();
+    }
+
+    std::vector<std::string> partitions(request.partition_tag_array().begin(), request.partition_tag_array().end());
+    std::vector<std::pair<std::string, std::vector<std::string>>> table_files;
+    Status status = DBWrapper::DB()->GetSearchFileIds(request.table_name(), partitions, table_files);
+    if (!status.ok()) {
+        return status;
+    }
+
+    // deprecated, but forwarded so sharded and plain search behave alike
+    std::vector<Range> ranges;
+    for (auto& range : request.query_range_array()) {
+        ranges.emplace_back(range.start_value(), range.end_value());
+    }
+
+    // per-replica, per-owning-table segment subsets; slot peers_.size() is local
+    size_t local_slot = peers_.size();
+    std::vector<std::map<std::string, std::vector<std::string>>> assignment(peers_.size() + 1);
+    for (auto& entry : table_files) {
+        for (auto& file_id : entry.second) {
+            assignment[OwnerOf(entry.first, file_id)][entry.first].push_back(file_id);
+        }
+    }
+
+    // remote subsets fly first so they overlap with the local compute
+    struct Flight {
+        size_t slot;
+        std::string table_id;
+        std::vector<std::string> file_ids;
+        std::future<std::pair<::grpc::Status, ::milvus::grpc::TopKQueryResult>> reply;
+    };
+    std::vector<Flight> flights;
+    for (size_t slot = 0; slot < peers_.size(); ++slot) {
+        for (auto& group : assignment[slot]) {
+            auto param = std::make_shared<::milvus::grpc::SearchInFilesParam>();
+            *param->mutable_search_param() = request;
+            param->mutable_search_param()->set_table_name(group.first);
+            param->mutable_search_param()->clear_partition_tag_array();
+            for (auto& file_id : group.second) {
+                param->add_file_id_array(file_id);
+            }
+
+            Flight flight;
+            flight.slot = slot;
+            flight.table_id = group.first;
+            flight.file_ids = group.second;
+            auto* stub = peers_[slot].stub.get();
+            flight.reply = std::async(std::launch::async, [stub, param] {
+                ::grpc::ClientContext client_context;
+                ::milvus::grpc::TopKQueryResult reply;
+                ::grpc::Status grpc_status = stub->SearchInFiles(&client_context, *param, &reply);
+                return std::make_pair(grpc_status, std::move(reply));
+            });
+            flights.emplace_back(std::move(flight));
+        }
+    }
+
+    // local subset runs while the peers work on theirs
+    for (auto& group : assignment[local_slot]) {
+        TopKQueryResult partial;
+        status = handler.Search(context, group.first, vectors, ranges, topk, request.nprobe(),
+                                std::vector<std::string>(), group.second, partial);
+        if (!status.ok()) {
+            return status;
+        }
+        if (partial.row_num_ == 0) {
+            continue;
+        }
+        size_t src_k = partial.id_list_.size() / partial.row_num_;
+        scheduler::XSearchTask::MergeResultSet(partial.id_list_, partial.distance_list_, src_k, src_k, nq, topk,
+                                               ascending, result.id_list_, result.distance_list_);
+    }
+
+    for (auto& flight : flights) {
+        auto reply = flight.reply.get();
+        bool failed = !reply.first.ok();
+        if (!failed && reply.second.status().error_code() != ::milvus::grpc::ErrorCode::SUCCESS) {
+            failed = true;
+        }
+
+        if (failed) {
+            // failover: replicas share the storage, so a lost peer's subset
+            // can be re-run locally within the same query
+            std::string reason =
+                reply.first.ok() ? reply.second.status().reason() : reply.first.error_message();
+            SERVER_LOG_WARNING << "Search on peer " << peers_[flight.slot].address << " failed (" << reason
+                               << "); re-running " << flight.file_ids.size() << " segment(s) locally";
+            TopKQueryResult partial;
+            status = handler.Search(context, flight.table_id, vectors, ranges, topk, request.nprobe(),
+                                    std::vector<std::string>(), flight.file_ids, partial);
+            if (!status.ok()) {
+                return status;
+            }
+            if (partial.row_num_ == 0) {
+                continue;
+            }
+            size_t src_k = partial.id_list_.size() / partial.row_num_;
+            scheduler::XSearchTask::MergeResultSet(partial.id_list_, partial.distance_list_, src_k, src_k, nq, topk,
+                                                   ascending, result.id_list_, result.distance_list_);
+            continue;
+        }
+
+        if (reply.second.row_num() == 0) {
+            continue;
+        }
+        size_t src_k = reply.second.ids_size() / reply.second.row_num();
+        engine::ResultIds src_ids(reply.second.ids().begin(), reply.second.ids().end());
+        engine::ResultDistances src_distances(reply.second.distances().begin(), reply.second.distances().end());
+        scheduler::XSearchTask::MergeResultSet(src_ids, src_distances, src_k, src_k, nq, topk, ascending,
+                                               result.id_list_, result.distance_list_);
+    }
+
+    if (!result.id_list_.empty()) {
+        result.row_num_ = nq;
+    }
+    return Status::OK();
+}
+
+bool
+ShardRouter::GetReduceOrder(const std::string& table_name, bool& ascending) {
+    std::lock_guard<std::mutex> lock(order_mutex_);
+    auto iter = reduce_order_.find(table_name);
+    if (iter == reduce_order_.end()) {
+        return false;
+    }
+    ascending = iter->second;
+    return true;
+}
+
+void
+ShardRouter::SetReduceOrder(const std::string& table_name, bool ascending) {
+    std::lock_guard<std::mutex> lock(order_mutex_);
+    reduce_order_[table_name] = ascending;
+}
+
+void
+ShardRouter::InvalidateReduceOrder(const std::string& table_name) {
+    std::lock_guard<std::mutex> lock(order_mutex_);
+    reduce_order_.erase(table_name);
+}
+
+}  // namespace grpc
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,120 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <grpcpp/grpcpp.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "grpc/gen-milvus/milvus.grpc.pb.h"
+#include "server/delivery/RequestHandler.h"
+#include "server/delivery/request/BaseRequest.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace server {
+namespace grpc {
+
+// Native replacement for the python mishards middleware on the search hot
+// path. When server_config.router_peers lists peer nodes, every incoming
+// Search is also fanned out to them over grpc and the per-node topk lists
+// are folded with the scheduler's cross-segment reduce, so the combined
+// result is identical to a single node holding all the shards.
+//
+// Peers must not list this node (or each other) in their own router_peers,
+// otherwise a query would bounce between nodes forever; the intended
+// topology is one router in front of plain data nodes.
+class ShardRouter {
+ public:
+    // mirror: every replica holds the full dataset; the query runs everywhere
+    // and the replicas' full topk lists are folded.
+    // shard: each segment is owned by exactly one replica (rendezvous hash over
+    // this node plus the peers), so each node caches only ~1/N of the data;
+    // the query fans out by segment assignment and a failed peer's subset is
+    // re-run locally within the same query, since replicas share the storage.
+    enum class Policy { MIRROR, SHARD };
+
+    static ShardRouter&
+    GetInstance() {
+        static ShardRouter router;
+        return router;
+    }
+
+    // Reads server_config.router_peers/router_policy and opens a channel per
+    // peer. An empty peer list leaves the router disabled; Search is then
+    // node-local, exactly as before.
+    Status
+    Init();
+
+    bool
+    Enabled() const {
+        return !peers_.empty();
+    }
+
+    Policy
+    GetPolicy() const {
+        return policy_;
+    }
+
+    // Fans `request` out to every peer and folds each reply into `result`,
+    // which already holds the node-local topk. `ascending` follows the table
+    // metric: distance metrics reduce ascending, IP descending. Any peer
+    // failure fails the whole query; a partial topk would be silently wrong.
+    Status
+    Search(const ::milvus::grpc::SearchParam& request, bool ascending, TopKQueryResult& result);
+
+    // Shard-policy search: lists the segments the query would touch, assigns
+    // each to one replica by rendezvous hash, runs the local subset through
+    // `handler` and the remote subsets via SearchInFiles, then folds the
+    // partial topk lists into `result`. Replaces the node-local full search.
+    // `vectors` is the query data already unpacked from `request` by the grpc
+    // handler, reused here so the records are not copied twice.
+    Status
+    ShardedSearch(const std::shared_ptr<Context>& context, RequestHandler& handler,
+                  const ::milvus::grpc::SearchParam& request, const engine::VectorsData& vectors, bool ascending,
+                  TopKQueryResult& result);
+
+    // Per-table reduce-order cache, filled from DescribeTable on the first
+    // routed query so the meta is not hit on every search.
+    bool
+    GetReduceOrder(const std::string& table_name, bool& ascending);
+    void
+    SetReduceOrder(const std::string& table_name, bool ascending);
+    void
+    InvalidateReduceOrder(const std::string& table_name);
+
+ private:
+    ShardRouter() = default;
+
+    struct Peer {
+        std::string address;
+        std::unique_ptr<::milvus::grpc::MilvusService::Stub> stub;
+    };
+
+    // rendezvous winner for one segment among the peers and this node; an
+    // index of peers_.size() means the local replica owns the segment
+    size_t
+    OwnerOf(const std::string& table_id, const std::string& file_id) const;
+
+    std::vector<Peer> peers_;
+    Policy policy_ = Policy::MIRROR;
+
+    std::mutex order_mutex_;
+    std::map<std::string, bool> reduce_order_;
+};
+
+}  // namespace grpc
+}  // namespace server
+}  // namespace milvus
@@ -39,12 +39,15 @@ static const char* NAME_ENGINE_TYPE_IVFSQ8 = "IVFSQ8";
 static const char* NAME_ENGINE_TYPE_IVFSQ8H = "IVFSQ8H";
 static const char* NAME_ENGINE_TYPE_RNSG = "RNSG";
 static const char* NAME_ENGINE_TYPE_IVFPQ = "IVFPQ";
+static const char* NAME_ENGINE_TYPE_IVFPQFS = "IVFPQFS";
 
 static const char* NAME_METRIC_TYPE_L2 = "L2";
 static const char* NAME_METRIC_TYPE_IP = "IP";
 static const char* NAME_METRIC_TYPE_HAMMING = "HAMMING";
 static const char* NAME_METRIC_TYPE_JACCARD = "JACCARD";
 static const char* NAME_METRIC_TYPE_TANIMOTO = "TANIMOTO";
+static const char* NAME_METRIC_TYPE_SUBSTRUCTURE = "SUBSTRUCTURE";
+static const char* NAME_METRIC_TYPE_SUPERSTRUCTURE = "SUPERSTRUCTURE";
 
 ////////////////////////////////////////////////////
 
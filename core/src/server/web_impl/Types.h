@@ -75,6 +75,7 @@ static const std::unordered_map<engine::EngineType, std::string> IndexMap = {
     {engine::EngineType::FAISS_IVFSQ8H, NAME_ENGINE_TYPE_IVFSQ8H},
     {engine::EngineType::NSG_MIX, NAME_ENGINE_TYPE_RNSG},
     {engine::EngineType::FAISS_PQ, NAME_ENGINE_TYPE_IVFPQ},
+    {engine::EngineType::FAISS_PQ_FS, NAME_ENGINE_TYPE_IVFPQFS},
 };
 
 static const std::unordered_map<std::string, engine::EngineType> IndexNameMap = {
@@ -84,6 +85,7 @@ static const std::unordered_map<std::string, engine::EngineType> IndexNameMap =
     {NAME_ENGINE_TYPE_IVFSQ8H, engine::EngineType::FAISS_IVFSQ8H},
     {NAME_ENGINE_TYPE_RNSG, engine::EngineType::NSG_MIX},
     {NAME_ENGINE_TYPE_IVFPQ, engine::EngineType::FAISS_PQ},
+    {NAME_ENGINE_TYPE_IVFPQFS, engine::EngineType::FAISS_PQ_FS},
 };
 
 static const std::unordered_map<engine::MetricType, std::string> MetricMap = {
@@ -92,6 +94,8 @@ static const std::unordered_map<engine::MetricType, std::string> MetricMap = {
     {engine::MetricType::HAMMING, NAME_METRIC_TYPE_HAMMING},
     {engine::MetricType::JACCARD, NAME_METRIC_TYPE_JACCARD},
     {engine::MetricType::TANIMOTO, NAME_METRIC_TYPE_TANIMOTO},
+    {engine::MetricType::SUBSTRUCTURE, NAME_METRIC_TYPE_SUBSTRUCTURE},
+    {engine::MetricType::SUPERSTRUCTURE, NAME_METRIC_TYPE_SUPERSTRUCTURE},
 };
 
 static const std::unordered_map<std::string, engine::MetricType> MetricNameMap = {
@@ -100,6 +104,8 @@ static const std::unordered_map<std::string, engine::MetricType> MetricNameMap =
     {NAME_METRIC_TYPE_HAMMING, engine::MetricType::HAMMING},
     {NAME_METRIC_TYPE_JACCARD, engine::MetricType::JACCARD},
     {NAME_METRIC_TYPE_TANIMOTO, engine::MetricType::TANIMOTO},
+    {NAME_METRIC_TYPE_SUBSTRUCTURE, engine::MetricType::SUBSTRUCTURE},
+    {NAME_METRIC_TYPE_SUPERSTRUCTURE, engine::MetricType::SUPERSTRUCTURE},
 };
 
 }  // namespace web
@@ -19,6 +19,7 @@
 #include <oatpp/core/macro/codegen.hpp>
 #include <oatpp/core/macro/component.hpp>
 
+#include "scheduler/Digest.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 
@@ -78,6 +79,22 @@ class WebController : public oatpp::web::server::api::ApiController {
         return createDtoResponse(Status::CODE_200, StatusDto::createShared());
     }
 
+    ENDPOINT_INFO(SchedulerDigest) {
+        info->summary = "Scheduler digest";
+        info->description =
+            "Per-resource queue depths, task dwell-time histograms and steal/migration counts, sampled lock-free.";
+    }
+
+    ADD_CORS(SchedulerDigest)
+
+    ENDPOINT("GET", "/scheduler/digest", SchedulerDigest) {
+        TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "GET \'/scheduler/digest\'");
+        auto response = createResponse(Status::CODE_200, milvus::scheduler::Digest().dump().c_str());
+        response->putHeader(Header::CONTENT_TYPE, "application/json");
+        tr.ElapseFromBegin("Total cost ");
+        return response;
+    }
+
     ENDPOINT_INFO(GetDevices) {
         info->summary = "Obtain system devices info";
 
@@ -380,6 +397,100 @@ class WebController : public oatpp::web::server::api::ApiController {
         return response;
     }
 
+    ADD_CORS(TableStatsOptions)
+
+    ENDPOINT("OPTIONS", "/tables/{table_name}/stats", TableStatsOptions) {
+        return createResponse(Status::CODE_204, "No Content");
+    }
+
+    ENDPOINT_INFO(GetTableStats) {
+        info->summary = "Get table statistics";
+
+        info->pathParams.add<String>("table_name");
+
+        info->addResponse<TableStatsDto::ObjectWrapper>(Status::CODE_200, "application/json");
+        info->addResponse<StatusDto::ObjectWrapper>(Status::CODE_400, "application/json");
+        info->addResponse<StatusDto::ObjectWrapper>(Status::CODE_404, "application/json");
+    }
+
+    ADD_CORS(GetTableStats)
+
+    ENDPOINT("GET", "/tables/{table_name}/stats", GetTableStats, PATH(String, table_name)) {
+        TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "GET \'/tables/" + table_name->std_str() + "/stats\'");
+        tr.RecordSection("Received request.");
+
+        WebRequestHandler handler = WebRequestHandler();
+
+        auto stats_dto = TableStatsDto::createShared();
+        auto status_dto = handler.GetTableStats(table_name, stats_dto);
+
+        std::shared_ptr<OutgoingResponse> response;
+        switch (status_dto->code->getValue()) {
+            case StatusCode::SUCCESS:
+                response = createDtoResponse(Status::CODE_200, stats_dto);
+                break;
+            case StatusCode::TABLE_NOT_EXISTS:
+                response = createDtoResponse(Status::CODE_404, status_dto);
+                break;
+            default:
+                response = createDtoResponse(Status::CODE_400, status_dto);
+        }
+
+        tr.ElapseFromBegin("Done. Status: code = " + std::to_string(status_dto->code->getValue())
+                           + ", reason = " + status_dto->message->std_str() + ". Total cost");
+
+        return response;
+    }
+
+    ADD_CORS(TableReadyOptions)
+
+    ENDPOINT("OPTIONS", "/tables/{table_name}/ready", TableReadyOptions) {
+        return createResponse(Status::CODE_204, "No Content");
+    }
+
+    ENDPOINT_INFO(GetTableReady) {
+        info->summary = "Get table warm-up readiness";
+
+        info->pathParams.add<String>("table_name");
+
+        info->addResponse<TableReadyDto::ObjectWrapper>(Status::CODE_200, "application/json");
+        info->addResponse<TableReadyDto::ObjectWrapper>(Status::CODE_503, "application/json");
+        info->addResponse<StatusDto::ObjectWrapper>(Status::CODE_404, "application/json");
+        info->addResponse<StatusDto::ObjectWrapper>(Status::CODE_400, "application/json");
+    }
+
+    ADD_CORS(GetTableReady)
+
+    // readiness probe for load balancers: 200 once the table's startup
+    // preload finished (or none was requested), 503 while it is warming
+    ENDPOINT("GET", "/tables/{table_name}/ready", GetTableReady, PATH(String, table_name)) {
+        TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "GET \'/tables/" + table_name->std_str() + "/ready\'");
+        tr.RecordSection("Received request.");
+
+        WebRequestHandler handler = WebRequestHandler();
+
+        auto ready_dto = TableReadyDto::createShared();
+        auto status_dto = handler.GetTableReady(table_name, ready_dto);
+
+        std::shared_ptr<OutgoingResponse> response;
+        switch (status_dto->code->getValue()) {
+            case StatusCode::SUCCESS:
+                response = createDtoResponse(ready_dto->ready->getValue() ? Status::CODE_200 : Status::CODE_503,
+                                             ready_dto);
+                break;
+            case StatusCode::TABLE_NOT_EXISTS:
+                response = createDtoResponse(Status::CODE_404, status_dto);
+                break;
+            default:
+                response = createDtoResponse(Status::CODE_400, status_dto);
+        }
+
+        tr.ElapseFromBegin("Done. Status: code = " + std::to_string(status_dto->code->getValue())
+                           + ", reason = " + status_dto->message->std_str() + ". Total cost");
+
+        return response;
+    }
+
     ENDPOINT_INFO(DropTable) {
         info->summary = "Drop table";
 
@@ -725,33 +836,71 @@ class WebController : public oatpp::web::server::api::ApiController {
         return response;
     }
 
-    ENDPOINT_INFO(Search) {
-        info->summary = "Search";
+    ENDPOINT_INFO(GetVectors) {
+        info->summary = "Get vectors by id";
 
         info->pathParams.add<String>("table_name");
+        info->queryParams.add<String>("ids");
 
-        info->addConsumes<SearchRequestDto::ObjectWrapper>("application/json");
+        info->addResponse<VectorRecordsDto::ObjectWrapper>(Status::CODE_200, "application/json");
+        info->addResponse<StatusDto::ObjectWrapper>(Status::CODE_400, "application/json");
+        info->addResponse<StatusDto::ObjectWrapper>(Status::CODE_404, "application/json");
+    }
 
-        info->addResponse<TopkResultsDto::ObjectWrapper>(Status::CODE_200, "application/json");
+    ADD_CORS(GetVectors)
+
+    ENDPOINT("GET", "/tables/{table_name}/vectors", GetVectors,
+             PATH(String, table_name), QUERIES(const QueryParams&, query_params)) {
+        TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "GET \'/tables/" + table_name->std_str() + "/vectors\'");
+        tr.RecordSection("Received request.");
+
+        auto records_dto = VectorRecordsDto::createShared();
+        WebRequestHandler handler = WebRequestHandler();
+
+        std::shared_ptr<OutgoingResponse> response;
+        auto status_dto = handler.GetVectors(table_name, query_params, records_dto);
+        switch (status_dto->code->getValue()) {
+            case StatusCode::SUCCESS:
+                response = createDtoResponse(Status::CODE_200, records_dto);
+                break;
+            case StatusCode::TABLE_NOT_EXISTS:
+                response = createDtoResponse(Status::CODE_404, status_dto);
+                break;
+            default:
+                response = createDtoResponse(Status::CODE_400, status_dto);
+        }
+
+        tr.ElapseFromBegin("Done. Status: code = " + std::to_string(status_dto->code->getValue())
+                           + ", reason = " + status_dto->message->std_str() + ". Total cost");
+
+        return response;
+    }
+
+    ENDPOINT_INFO(DeleteVectors) {
+        info->summary = "Delete vectors by id";
+
+        info->pathParams.add<String>("table_name");
+        info->queryParams.add<String>("ids");
+
+        info->addResponse<StatusDto::ObjectWrapper>(Status::CODE_204, "application/json");
         info->addResponse<StatusDto::ObjectWrapper>(Status::CODE_400, "application/json");
         info->addResponse<StatusDto::ObjectWrapper>(Status::CODE_404, "application/json");
     }
 
-    ADD_CORS(Search)
+    ADD_CORS(DeleteVectors)
 
-    ENDPOINT("PUT", "/tables/{table_name}/vectors", Search,
-             PATH(String, table_name), BODY_DTO(SearchRequestDto::ObjectWrapper, body)) {
-        TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "PUT \'/tables/" + table_name->std_str() + "/vectors\'");
+    ENDPOINT("DELETE", "/tables/{table_name}/vectors", DeleteVectors,
+             PATH(String, table_name), QUERIES(const QueryParams&, query_params)) {
+        TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "DELETE \'/tables/" + table_name->std_str() + "/vectors\'");
         tr.RecordSection("Received request.");
 
-        auto results_dto = TopkResultsDto::createShared();
         WebRequestHandler handler = WebRequestHandler();
 
         std::shared_ptr<OutgoingResponse> response;
-        auto status_dto = handler.Search(table_name, body, results_dto);
+        auto status_dto = handler.DeleteVectors(table_name, query_params);
         switch (status_dto->code->getValue()) {
             case StatusCode::SUCCESS:
-                response = createDtoResponse(Status::CODE_200, results_dto);
+                response = createDtoResponse(Status::CODE_204, status_dto);
                 break;
             case StatusCode::TABLE_NOT_EXISTS:
                 response = createDtoResponse(Status::CODE_404, status_dto);
@@ -766,6 +915,66 @@ class WebController : public oatpp::web::server::api::ApiController {
         return response;
     }
 
+    ENDPOINT_INFO(Search) {
+        info->summary = "Search";
+
+        info->pathParams.add<String>("table_name");
+
+        info->addConsumes<SearchRequestDto::ObjectWrapper>("application/json");
+
+        info->addResponse<TopkResultsDto::ObjectWrapper>(Status::CODE_200, "application/json");
+        info->addResponse<StatusDto::ObjectWrapper>(Status::CODE_400, "application/json");
+        info->addResponse<StatusDto::ObjectWrapper>(Status::CODE_404, "application/json");
+    }
+
+    ADD_CORS(Search)
+
+    ENDPOINT("PUT", "/tables/{table_name}/vectors", Search,
+             PATH(String, table_name), BODY_DTO(SearchRequestDto::ObjectWrapper, body),
+             REQUEST(std::shared_ptr<IncomingRequest>, request)) {
+        TimeRecorder tr(std::string(WEB_LOG_PREFIX) + "PUT \'/tables/" + table_name->std_str() + "/vectors\'");
+        tr.RecordSection("Received request.");
+
+        WebRequestHandler handler = WebRequestHandler();
+
+        std::shared_ptr<OutgoingResponse> response;
+        StatusDto::ObjectWrapper status_dto;
+
+        // large result sets dominate this endpoint; a client sending
+        // 'Accept: application/octet-stream' gets the ids and distances as raw
+        // little-endian arrays instead of a JSON tree of per-cell objects
+        auto accept = request->getHeader("Accept");
+        if (accept && accept == "application/octet-stream") {
+            std::string payload;
+            status_dto = handler.SearchBinary(table_name, body, payload);
+            if (StatusCode::SUCCESS == status_dto->code->getValue()) {
+                response = createResponse(Status::CODE_200, String(payload.data(), payload.size(), true));
+                response->putHeader(Header::CONTENT_TYPE, "application/octet-stream");
+            }
+        } else {
+            auto results_dto = TopkResultsDto::createShared();
+            status_dto = handler.Search(table_name, body, results_dto);
+            if (StatusCode::SUCCESS == status_dto->code->getValue()) {
+                response = createDtoResponse(Status::CODE_200, results_dto);
+            }
+        }
+
+        if (nullptr == response) {
+            switch (status_dto->code->getValue()) {
+                case StatusCode::TABLE_NOT_EXISTS:
+                    response = createDtoResponse(Status::CODE_404, status_dto);
+                    break;
+                default:
+                    response = createDtoResponse(Status::CODE_400, status_dto);
+            }
+        }
+
+        tr.ElapseFromBegin("Done. Status: code = " + std::to_string(status_dto->code->getValue())
+                           + ", reason = " + status_dto->message->std_str() + ". Total cost");
+
+        return response;
+    }
+
     ENDPOINT_INFO(SystemMsg) {
         info->summary = "Command";
 
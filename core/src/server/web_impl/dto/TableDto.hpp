@@ -43,6 +43,32 @@ class TableFieldsDto : public oatpp::data::mapping::type::Object {
     DTO_FIELD(Int64, nlist);
 };
 
+class PartitionStatsDto : public OObject {
+    DTO_INIT(PartitionStatsDto, Object)
+
+    DTO_FIELD(String, partition_tag);
+    DTO_FIELD(Int64, count);
+    DTO_FIELD(Int64, size);
+    DTO_FIELD(Int64, file_count);
+};
+
+class TableStatsDto : public OObject {
+    DTO_INIT(TableStatsDto, Object)
+
+    // totals cover the parent table plus every partition
+    DTO_FIELD(Int64, count);
+    DTO_FIELD(Int64, size);
+    DTO_FIELD(Int64, file_count);
+    DTO_FIELD(List<PartitionStatsDto::ObjectWrapper>::ObjectWrapper, partitions);
+};
+
+class TableReadyDto : public OObject {
+    DTO_INIT(TableReadyDto, Object)
+
+    // false while the startup preload is still warming the table
+    DTO_FIELD(Boolean, ready);
+};
+
 class TableListDto : public OObject {
  DTO_INIT(TableListDto, Object)
 
@@ -29,6 +29,11 @@ class SearchRequestDto : public OObject {
     DTO_FIELD(List<String>::ObjectWrapper, file_ids);
     DTO_FIELD(List<List<Float32>::ObjectWrapper>::ObjectWrapper, records);
     DTO_FIELD(List<List<Int64>::ObjectWrapper>::ObjectWrapper, records_bin);
+
+    // attribute predicates, ANDed across columns: filter_values[i] lists the
+    // values accepted for the column named filter_names[i]
+    DTO_FIELD(List<String>::ObjectWrapper, filter_names);
+    DTO_FIELD(List<List<String>::ObjectWrapper>::ObjectWrapper, filter_values);
 };
 
 class InsertRequestDto : public oatpp::data::mapping::type::Object {
@@ -38,6 +43,11 @@ class InsertRequestDto : public oatpp::data::mapping::type::Object {
     DTO_FIELD(List<List<Float32>::ObjectWrapper>::ObjectWrapper, records);
     DTO_FIELD(List<List<Int64>::ObjectWrapper>::ObjectWrapper, records_bin);
     DTO_FIELD(List<Int64>::ObjectWrapper, ids);
+
+    // per-record scalar payloads: attributes[r][i] is the value of the
+    // column named attribute_names[i] for record r
+    DTO_FIELD(List<String>::ObjectWrapper, attribute_names);
+    DTO_FIELD(List<List<String>::ObjectWrapper>::ObjectWrapper, attributes);
 };
 
 class VectorIdsDto : public oatpp::data::mapping::type::Object {
@@ -46,6 +56,14 @@ class VectorIdsDto : public oatpp::data::mapping::type::Object {
     DTO_FIELD(List<String>::ObjectWrapper, ids);
 };
 
+class VectorRecordsDto : public oatpp::data::mapping::type::Object {
+    DTO_INIT(VectorRecordsDto, Object)
+
+    // records[i] answers the i-th requested id; an empty row means the id is
+    // not stored in the table
+    DTO_FIELD(List<List<Float32>::ObjectWrapper>::ObjectWrapper, records);
+};
+
 class ResultDto : public oatpp::data::mapping::type::Object {
     DTO_INIT(ResultDto, Object)
 
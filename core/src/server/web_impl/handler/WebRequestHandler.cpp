@@ -16,6 +16,8 @@
 #include <string>
 #include <vector>
 
+#include "db/Types.h"
+#include "server/DBWrapper.h"
 #include "metrics/SystemInfo.h"
 #include "server/Config.h"
 #include "server/delivery/request/BaseRequest.h"
@@ -427,6 +429,55 @@ WebRequestHandler::GetTable(const OString& table_name, const OQueryParams& query
     ASSIGN_RETURN_STATUS_DTO(status);
 }
 
+StatusDto::ObjectWrapper
+WebRequestHandler::GetTableStats(const OString& table_name, TableStatsDto::ObjectWrapper& stats_dto) {
+    if (nullptr == table_name.get()) {
+        RETURN_STATUS_DTO(PATH_PARAM_LOSS, "Path param \'table_name\' is required!");
+    }
+
+    engine::meta::TableStats total;
+    std::vector<std::pair<std::string, engine::meta::TableStats>> partition_stats;
+    auto status = request_handler_.DescribeTableStats(context_ptr_, table_name->std_str(), total, partition_stats);
+    if (!status.ok()) {
+        ASSIGN_RETURN_STATUS_DTO(status)
+    }
+
+    stats_dto->count = total.row_count_;
+    stats_dto->size = total.data_size_;
+    stats_dto->file_count = total.file_count_;
+    stats_dto->partitions = stats_dto->partitions->createShared();
+    for (auto& pair : partition_stats) {
+        auto partition_dto = PartitionStatsDto::createShared();
+        partition_dto->partition_tag = pair.first.c_str();
+        partition_dto->count = pair.second.row_count_;
+        partition_dto->size = pair.second.data_size_;
+        partition_dto->file_count = pair.second.file_count_;
+        stats_dto->partitions->pushBack(partition_dto);
+    }
+
+    ASSIGN_RETURN_STATUS_DTO(status)
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::GetTableReady(const OString& table_name, TableReadyDto::ObjectWrapper& ready_dto) {
+    if (nullptr == table_name.get()) {
+        RETURN_STATUS_DTO(PATH_PARAM_LOSS, "Path param \'table_name\' is required!");
+    }
+
+    bool has_table = false;
+    auto status = request_handler_.HasTable(context_ptr_, table_name->std_str(), has_table);
+    if (!status.ok()) {
+        ASSIGN_RETURN_STATUS_DTO(status)
+    }
+    if (!has_table) {
+        RETURN_STATUS_DTO(TABLE_NOT_EXISTS, ("Table " + table_name->std_str() + " not found.").c_str());
+    }
+
+    ready_dto->ready = DBWrapper::GetInstance().IsTableReady(table_name->std_str());
+
+    ASSIGN_RETURN_STATUS_DTO(status)
+}
+
 StatusDto::ObjectWrapper
 WebRequestHandler::ShowTables(const OString& offset, const OString& page_size,
                               TableListFieldsDto::ObjectWrapper& response_dto) {
@@ -615,8 +666,7 @@ WebRequestHandler::Insert(const OString& table_name, const InsertRequestDto::Obj
 
     auto metric = engine::MetricType(schema.metric_type_);
     engine::VectorsData vectors;
-    bool bin_flag = engine::MetricType::HAMMING == metric || engine::MetricType::JACCARD == metric ||
-                    engine::MetricType::TANIMOTO == metric;
+    bool bin_flag = ValidationUtil::IsBinaryMetricType(static_cast<int32_t>(metric));
 
     if (!bin_flag) {
         if (nullptr == request->records.get()) {
@@ -645,6 +695,32 @@ WebRequestHandler::Insert(const OString& table_name, const InsertRequestDto::Obj
         request->ids->forEach([&id_array, &i](const OInt64& item) { id_array[i++] = item->getValue(); });
     }
 
+    // step 3: copy per-record scalar attributes
+    if (nullptr != request->attributes.get()) {
+        if (nullptr == request->attribute_names.get()) {
+            RETURN_STATUS_DTO(BODY_FIELD_LOSS, "Field \'attribute_names\' is required to name the attribute columns");
+        }
+        if (request->attributes->count() != vectors.vector_count_) {
+            RETURN_STATUS_DTO(ILLEGAL_ROWRECORD, "Field \'attributes\' must hold one entry per record");
+        }
+        std::vector<std::string> names;
+        request->attribute_names->forEach([&names](const OString& name) { names.emplace_back(name->std_str()); });
+
+        bool malformed = false;
+        request->attributes->forEach([&vectors, &names, &malformed](const OList<OString>::ObjectWrapper& row) {
+            if (static_cast<size_t>(row->count()) != names.size()) {
+                malformed = true;
+                return;
+            }
+            size_t i = 0;
+            row->forEach(
+                [&vectors, &names, &i](const OString& value) { vectors.attributes_[names[i++]].push_back(value->std_str()); });
+        });
+        if (malformed) {
+            RETURN_STATUS_DTO(ILLEGAL_ROWRECORD, "Each \'attributes\' entry must hold one value per attribute name");
+        }
+    }
+
     status = request_handler_.Insert(context_ptr_, table_name->std_str(), vectors, request->tag->std_str());
 
     if (status.ok()) {
@@ -658,8 +734,8 @@ WebRequestHandler::Insert(const OString& table_name, const InsertRequestDto::Obj
 }
 
 StatusDto::ObjectWrapper
-WebRequestHandler::Search(const OString& table_name, const SearchRequestDto::ObjectWrapper& request,
-                          TopkResultsDto::ObjectWrapper& results_dto) {
+WebRequestHandler::SearchVectors(const OString& table_name, const SearchRequestDto::ObjectWrapper& request,
+                                 TopKQueryResult& result) {
     if (nullptr == request->topk.get()) {
         RETURN_STATUS_DTO(BODY_FIELD_LOSS, "Field \'topk\' is required in request body")
     }
@@ -687,8 +763,7 @@ WebRequestHandler::Search(const OString& table_name, const SearchRequestDto::Obj
     }
 
     auto metric = engine::MetricType(schema.metric_type_);
-    bool bin_flag = engine::MetricType::HAMMING == metric || engine::MetricType::JACCARD == metric ||
-                    engine::MetricType::TANIMOTO == metric;
+    bool bin_flag = ValidationUtil::IsBinaryMetricType(static_cast<int32_t>(metric));
     engine::VectorsData vectors;
 
     if (!bin_flag) {
@@ -710,18 +785,120 @@ WebRequestHandler::Search(const OString& table_name, const SearchRequestDto::Obj
     }
 
     std::vector<Range> range_list;
-    TopKQueryResult result;
     auto context_ptr = GenContextPtr("Web Handler");
+
+    // attribute predicates ride the request context down to the per-segment
+    // search tasks, which push them into the engine scan
+    if (nullptr != request->filter_names.get() && nullptr != request->filter_values.get()) {
+        if (request->filter_names->count() != request->filter_values->count()) {
+            RETURN_STATUS_DTO(ILLEGAL_ARGUMENT,
+                              "Fields \'filter_names\' and \'filter_values\' must have the same length");
+        }
+        std::vector<std::string> names;
+        request->filter_names->forEach([&names](const OString& name) { names.emplace_back(name->std_str()); });
+
+        auto filter = std::make_shared<engine::AttributeFilter>();
+        size_t i = 0;
+        request->filter_values->forEach([&filter, &names, &i](const OList<OString>::ObjectWrapper& values) {
+            auto& accepted = filter->conditions_[names[i++]];
+            values->forEach([&accepted](const OString& value) { accepted.insert(value->std_str()); });
+        });
+        if (!filter->Empty()) {
+            context_ptr->SetAttrFilter(filter);
+        }
+    }
+
     status = request_handler_.Search(context_ptr, table_name->std_str(), vectors, range_list, topk_t, nprobe_t,
                                      tag_list, file_id_list, result);
+
+    ASSIGN_RETURN_STATUS_DTO(status)
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::GetVectors(const OString& table_name, const OQueryParams& query_params,
+                              VectorRecordsDto::ObjectWrapper& records_dto) {
+    if (nullptr == table_name.get()) {
+        RETURN_STATUS_DTO(PATH_PARAM_LOSS, "Path param \'table_name\' is required!");
+    }
+
+    auto ids_param = query_params.get("ids");
+    if (nullptr == ids_param.get()) {
+        RETURN_STATUS_DTO(QUERY_PARAM_LOSS, "Query param \'ids\' is required!");
+    }
+
+    std::vector<std::string> id_strs;
+    StringHelpFunctions::SplitStringByDelimeter(ids_param->std_str(), ",", id_strs);
+    std::vector<int64_t> id_array;
+    id_array.reserve(id_strs.size());
+    for (auto& id_str : id_strs) {
+        if (!ValidationUtil::ValidateStringIsNumber(id_str).ok()) {
+            RETURN_STATUS_DTO(ILLEGAL_QUERY_PARAM,
+                              "Query param \'ids\' is illegal, only non-negative integers supported");
+        }
+        id_array.emplace_back(std::stol(id_str));
+    }
+
+    std::vector<engine::VectorsData> vectors;
+    auto status = request_handler_.GetVectorsByID(context_ptr_, table_name->std_str(), id_array, vectors);
     if (!status.ok()) {
         ASSIGN_RETURN_STATUS_DTO(status)
     }
 
+    records_dto->records = records_dto->records->createShared();
+    for (auto& vector : vectors) {
+        auto row_dto = OList<OFloat32>::createShared();
+        if (vector.vector_count_ > 0) {
+            for (auto value : vector.float_data_) {
+                row_dto->pushBack(value);
+            }
+        }
+        records_dto->records->pushBack(row_dto);
+    }
+
+    ASSIGN_RETURN_STATUS_DTO(status)
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::DeleteVectors(const OString& table_name, const OQueryParams& query_params) {
+    if (nullptr == table_name.get()) {
+        RETURN_STATUS_DTO(PATH_PARAM_LOSS, "Path param \'table_name\' is required!");
+    }
+
+    auto ids_param = query_params.get("ids");
+    if (nullptr == ids_param.get()) {
+        RETURN_STATUS_DTO(QUERY_PARAM_LOSS, "Query param \'ids\' is required!");
+    }
+
+    std::vector<std::string> id_strs;
+    StringHelpFunctions::SplitStringByDelimeter(ids_param->std_str(), ",", id_strs);
+    std::vector<int64_t> id_array;
+    id_array.reserve(id_strs.size());
+    for (auto& id_str : id_strs) {
+        if (!ValidationUtil::ValidateStringIsNumber(id_str).ok()) {
+            RETURN_STATUS_DTO(ILLEGAL_QUERY_PARAM,
+                              "Query param \'ids\' is illegal, only non-negative integers supported");
+        }
+        id_array.emplace_back(std::stol(id_str));
+    }
+
+    auto status = request_handler_.DeleteByID(context_ptr_, table_name->std_str(), id_array);
+
+    ASSIGN_RETURN_STATUS_DTO(status)
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::Search(const OString& table_name, const SearchRequestDto::ObjectWrapper& request,
+                          TopkResultsDto::ObjectWrapper& results_dto) {
+    TopKQueryResult result;
+    auto status_dto = SearchVectors(table_name, request, result);
+    if (0 != status_dto->code->getValue()) {
+        return status_dto;
+    }
+
     results_dto->num = result.row_num_;
     results_dto->results = results_dto->results->createShared();
     if (0 == result.row_num_) {
-        ASSIGN_RETURN_STATUS_DTO(status)
+        return status_dto;
     }
 
     auto step = result.id_list_.size() / result.row_num_;
@@ -736,7 +913,32 @@ WebRequestHandler::Search(const OString& table_name, const SearchRequestDto::Obj
         results_dto->results->pushBack(row_result_dto);
     }
 
-    ASSIGN_RETURN_STATUS_DTO(status)
+    return status_dto;
+}
+
+StatusDto::ObjectWrapper
+WebRequestHandler::SearchBinary(const OString& table_name, const SearchRequestDto::ObjectWrapper& request,
+                                std::string& payload) {
+    TopKQueryResult result;
+    auto status_dto = SearchVectors(table_name, request, result);
+    if (0 != status_dto->code->getValue()) {
+        return status_dto;
+    }
+
+    // fixed little-endian layout: two int64 header fields, then the id and
+    // distance arrays appended verbatim. No per-cell objects, no
+    // number-to-string conversion
+    int64_t row_num = result.row_num_;
+    int64_t topk = (row_num > 0) ? static_cast<int64_t>(result.id_list_.size()) / row_num : 0;
+    payload.reserve(2 * sizeof(int64_t) + result.id_list_.size() * sizeof(int64_t) +
+                    result.distance_list_.size() * sizeof(float));
+    payload.append(reinterpret_cast<const char*>(&row_num), sizeof(row_num));
+    payload.append(reinterpret_cast<const char*>(&topk), sizeof(topk));
+    payload.append(reinterpret_cast<const char*>(result.id_list_.data()), result.id_list_.size() * sizeof(int64_t));
+    payload.append(reinterpret_cast<const char*>(result.distance_list_.data()),
+                   result.distance_list_.size() * sizeof(float));
+
+    return status_dto;
 }
 
 StatusDto::ObjectWrapper
@@ -759,7 +961,44 @@ WebRequestHandler::Cmd(const OString& cmd, const OQueryParams& query_params, Com
         std::string target_str = target->std_str();
 
         if ("load" == action_str) {
-            status = request_handler_.PreloadTable(context_ptr_, target_str);
+            bool pin = false;
+            auto pin_param = query_params.get("pin");
+            if (nullptr != pin_param.get()) {
+                pin = ("true" == pin_param->std_str());
+            }
+
+            int64_t priority = 0;
+            auto priority_param = query_params.get("priority");
+            if (nullptr != priority_param.get()) {
+                std::string priority_str = priority_param->std_str();
+                if ("low" == priority_str) {
+                    priority = -1;
+                } else if ("high" == priority_str) {
+                    priority = 1;
+                } else if ("normal" != priority_str) {
+                    RETURN_STATUS_DTO(ILLEGAL_QUERY_PARAM,
+                                      "Query param \'priority\' must be one of \'low\', \'normal\', \'high\'");
+                }
+            }
+
+            std::vector<std::string> partition_tags;
+            auto tags_param = query_params.get("partition_tags");
+            if (nullptr != tags_param.get()) {
+                StringHelpFunctions::SplitStringByDelimeter(tags_param->std_str(), ",", partition_tags);
+            }
+
+            std::vector<Range> range_list;
+            auto start_param = query_params.get("start_date");
+            auto end_param = query_params.get("end_date");
+            if (nullptr != start_param.get() || nullptr != end_param.get()) {
+                if (nullptr == start_param.get() || nullptr == end_param.get()) {
+                    RETURN_STATUS_DTO(QUERY_PARAM_LOSS,
+                                      "Query params \'start_date\' and \'end_date\' must be specified together");
+                }
+                range_list.emplace_back(start_param->std_str(), end_param->std_str());
+            }
+
+            status = request_handler_.PreloadTable(context_ptr_, target_str, pin, priority, partition_tags, range_list);
         } else {
             std::string error_msg = std::string("Unknown action value \'") + action_str + "\'";
             RETURN_STATUS_DTO(ILLEGAL_QUERY_PARAM, error_msg.c_str());
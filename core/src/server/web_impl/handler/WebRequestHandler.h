@@ -80,6 +80,10 @@ class WebRequestHandler {
     Status
     GetTableInfo(const std::string& table_name, TableFieldsDto::ObjectWrapper& table_fields);
 
+    StatusDto::ObjectWrapper
+    SearchVectors(const OString& table_name, const SearchRequestDto::ObjectWrapper& search_request,
+                  TopKQueryResult& result);
+
     Status
     CommandLine(const std::string& cmd, std::string& reply);
 
@@ -112,6 +116,12 @@ class WebRequestHandler {
     StatusDto::ObjectWrapper
     GetTable(const OString& table_name, const OQueryParams& query_params, TableFieldsDto::ObjectWrapper& schema_dto);
 
+    StatusDto::ObjectWrapper
+    GetTableStats(const OString& table_name, TableStatsDto::ObjectWrapper& stats_dto);
+
+    StatusDto::ObjectWrapper
+    GetTableReady(const OString& table_name, TableReadyDto::ObjectWrapper& ready_dto);
+
     StatusDto::ObjectWrapper
     ShowTables(const OString& offset, const OString& page_size, TableListFieldsDto::ObjectWrapper& table_list_dto);
 
@@ -141,10 +151,24 @@ class WebRequestHandler {
     Insert(const OString& table_name, const InsertRequestDto::ObjectWrapper& param,
            VectorIdsDto::ObjectWrapper& ids_dto);
 
+    StatusDto::ObjectWrapper
+    GetVectors(const OString& table_name, const OQueryParams& query_params,
+               VectorRecordsDto::ObjectWrapper& records_dto);
+
+    StatusDto::ObjectWrapper
+    DeleteVectors(const OString& table_name, const OQueryParams& query_params);
+
     StatusDto::ObjectWrapper
     Search(const OString& table_name, const SearchRequestDto::ObjectWrapper& search_request,
            TopkResultsDto::ObjectWrapper& results_dto);
 
+    // binary twin of Search for callers that opt out of JSON: fills payload
+    // with [int64 row_num][int64 topk] followed by the ids as int64 and the
+    // distances as float32, all little-endian and row-major
+    StatusDto::ObjectWrapper
+    SearchBinary(const OString& table_name, const SearchRequestDto::ObjectWrapper& search_request,
+                 std::string& payload);
+
     StatusDto::ObjectWrapper
     Cmd(const OString& cmd, const OQueryParams& query_params, CommandDto::ObjectWrapper& cmd_dto);
 
@@ -0,0 +1,123 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/Codec.h"
+
+#include <zlib.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "utils/Error.h"
+
+namespace milvus {
+namespace storage {
+
+namespace {
+constexpr size_t CODEC_DECOMPRESS_CONCURRENCY = 4;
+
+class ZlibCodec : public Codec {
+ public:
+    CodecType
+    Type() const override {
+        return CodecType::ZLIB;
+    }
+
+    Status
+    Compress(const void* src, size_t src_len, std::vector<uint8_t>& dst) const override {
+        uLongf dst_len = compressBound(src_len);
+        dst.resize(dst_len);
+        // segment compression trades ratio for throughput: flush and cold-load
+        // times matter more than the last few percent of size
+        int ret = compress2(dst.data(), &dst_len, static_cast<const Bytef*>(src), src_len, Z_BEST_SPEED);
+        if (ret != Z_OK) {
+            return Status(SERVER_UNEXPECTED_ERROR, "zlib compress failed: " + std::to_string(ret));
+        }
+        dst.resize(dst_len);
+        return Status::OK();
+    }
+
+    Status
+    Decompress(const void* src, size_t src_len, void* dst, size_t dst_len) const override {
+        uLongf out_len = dst_len;
+        int ret = uncompress(static_cast<Bytef*>(dst), &out_len, static_cast<const Bytef*>(src), src_len);
+        if (ret != Z_OK || out_len != dst_len) {
+            return Status(SERVER_UNEXPECTED_ERROR, "zlib uncompress failed: " + std::to_string(ret));
+        }
+        return Status::OK();
+    }
+};
+}  // namespace
+
+std::shared_ptr<Codec>
+Codec::Get(CodecType type) {
+    switch (type) {
+        case CodecType::ZLIB: {
+            static CodecPtr zlib_codec = std::make_shared<ZlibCodec>();
+            return zlib_codec;
+        }
+        default:
+            return nullptr;
+    }
+}
+
+uint32_t
+ChunkChecksum(const void* data, size_t len) {
+    return static_cast<uint32_t>(crc32(0L, static_cast<const Bytef*>(data), static_cast<uInt>(len)));
+}
+
+Status
+DecompressChunks(const CodecPtr& codec, const std::vector<CodecChunk>& chunks) {
+    std::atomic<size_t> next_chunk(0);
+    std::atomic<bool> failed(false);
+    std::mutex err_mutex;
+    std::string err_msg;
+
+    auto worker = [&]() {
+        size_t i;
+        while (!failed.load() && (i = next_chunk.fetch_add(1)) < chunks.size()) {
+            auto& chunk = chunks[i];
+            Status stat;
+            if (chunk.verify && ChunkChecksum(chunk.src, chunk.src_len) != chunk.checksum) {
+                stat = Status(SERVER_UNEXPECTED_ERROR, "chunk checksum mismatch");
+            } else if (codec != nullptr) {
+                stat = codec->Decompress(chunk.src, chunk.src_len, chunk.dst, chunk.dst_len);
+            } else if (chunk.dst != chunk.src) {
+                memcpy(chunk.dst, chunk.src, chunk.dst_len);
+            }
+            if (!stat.ok()) {
+                failed.store(true);
+                std::lock_guard<std::mutex> lock(err_mutex);
+                err_msg = stat.message();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    size_t worker_count = std::min(CODEC_DECOMPRESS_CONCURRENCY, chunks.size());
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    if (failed.load()) {
+        return Status(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
+}  // namespace storage
+}  // namespace milvus
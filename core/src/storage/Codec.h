@@ -0,0 +1,84 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "utils/Status.h"
+
+namespace milvus {
+namespace storage {
+
+// magic prefix of checksummed segment containers (version byte + codec byte
+// follow); legacy files start with an index type enum whose values never reach
+// this, so the read path can tell the layouts apart from the first four bytes
+constexpr uint32_t SEGMENT_FILE_MAGIC = 0x5347454D;
+constexpr uint8_t SEGMENT_FORMAT_VERSION = 1;
+
+// magic of the interim compressed layout without checksums, still readable
+constexpr uint32_t CODEC_FILE_MAGIC = 0x5A43444D;
+
+// blobs are compressed in independent chunks of this size so the read path
+// can inflate them in parallel
+constexpr size_t CODEC_CHUNK_SIZE = 4 * 1024 * 1024;
+
+enum class CodecType : uint8_t {
+    NONE = 0,
+    ZLIB = 1,
+};
+
+// Pluggable per-chunk compression used by the segment read/write path. Codecs
+// are stateless and may be shared across threads.
+class Codec {
+ public:
+    virtual ~Codec() = default;
+
+    virtual CodecType
+    Type() const = 0;
+
+    // compress one chunk; dst is sized by the callee
+    virtual Status
+    Compress(const void* src, size_t src_len, std::vector<uint8_t>& dst) const = 0;
+
+    // inflate one chunk into a caller buffer of exactly dst_len bytes
+    virtual Status
+    Decompress(const void* src, size_t src_len, void* dst, size_t dst_len) const = 0;
+
+    // nullptr for NONE or an unknown type
+    static std::shared_ptr<Codec>
+    Get(CodecType type);
+};
+
+using CodecPtr = std::shared_ptr<Codec>;
+
+struct CodecChunk {
+    const uint8_t* src;
+    size_t src_len;
+    uint8_t* dst;
+    size_t dst_len;
+    uint32_t checksum;  // over the stored (src) bytes, checked when verify is set
+    bool verify;
+};
+
+// checksum of one stored chunk (crc32)
+uint32_t
+ChunkChecksum(const void* data, size_t len);
+
+// process independent chunks with a bounded pool of workers: verify the
+// checksum where requested, then inflate through `codec`. A null codec means
+// the chunks are stored raw and only need verification (src may alias dst).
+Status
+DecompressChunks(const CodecPtr& codec, const std::vector<CodecChunk>& chunks);
+
+}  // namespace storage
+}  // namespace milvus
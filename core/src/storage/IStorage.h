@@ -33,6 +33,10 @@ class IStorage {
     virtual Status
     GetObjectStr(const std::string& object_name, std::string& content) = 0;
     virtual Status
+    GetObjectSize(const std::string& object_name, size_t& size) = 0;
+    virtual Status
+    GetObjectRange(const std::string& object_name, size_t offset, size_t length, void* buffer) = 0;
+    virtual Status
     ListObjects(std::vector<std::string>& object_list, const std::string& marker = "") = 0;
     virtual Status
     DeleteObject(const std::string& object_name) = 0;
@@ -11,13 +11,16 @@
 
 #pragma once
 
-#include <fstream>
 #include <string>
 #include "storage/IOReader.h"
 
 namespace milvus {
 namespace storage {
 
+// Positioned-read segment reader over a raw fd. Large payloads are split into
+// chunks and pread by a bounded pool of workers, so one loader thread keeps
+// many reads in flight; NVMe drives only reach rated throughput well above
+// queue depth one. Small framing fields stay synchronous.
 class FileIOReader : public IOReader {
  public:
     explicit FileIOReader(const std::string& name);
@@ -32,8 +35,10 @@ class FileIOReader : public IOReader {
     size_t
     length() override;
 
- public:
-    std::fstream fs_;
+ private:
+    int fd_ = -1;
+    size_t pos_ = 0;
+    size_t length_ = 0;
 };
 
 }  // namespace storage
@@ -0,0 +1,35 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/file/FileIOUtil.h"
+#include "utils/Log.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace milvus {
+namespace storage {
+
+void
+DropFilePageCache(const std::string& file_path) {
+    int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;  // already deleted, or an object-store path with no local copy
+    }
+    ::fdatasync(fd);
+    if (::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0) {
+        STORAGE_LOG_DEBUG << "Dropped page cache for " << file_path;
+    }
+    ::close(fd);
+}
+
+}  // namespace storage
+}  // namespace milvus
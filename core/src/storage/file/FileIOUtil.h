@@ -0,0 +1,28 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <string>
+
+namespace milvus {
+namespace storage {
+
+// Drop a file's pages from the OS page cache. Dirty pages are synced first so
+// the advice takes effect. Called after one-shot reads (index build inputs)
+// and writes (serialized build/merge output) whose bytes will not be touched
+// again, so the reclaimed RAM stays available to the CpuCacheMgr. Best effort:
+// a missing file or an unsupported filesystem is not an error.
+void
+DropFilePageCache(const std::string& file_path);
+
+}  // namespace storage
+}  // namespace milvus
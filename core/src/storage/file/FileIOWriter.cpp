@@ -10,24 +10,145 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "storage/file/FileIOWriter.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 
 namespace milvus {
 namespace storage {
 
+namespace {
+constexpr size_t FILE_WRITE_BUFFER = 4 * 1024 * 1024;
+// O_DIRECT requires the buffer address, length and file offset all aligned
+constexpr size_t FILE_DIRECT_IO_ALIGN = 4096;
+
+void
+write_all(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written <= 0) {
+            STORAGE_LOG_ERROR << "Failed to write file: " << strerror(errno);
+            return;
+        }
+        data += written;
+        size -= written;
+    }
+}
+}  // namespace
+
 FileIOWriter::FileIOWriter(const std::string& name) : IOWriter(name) {
-    fs_ = std::fstream(name_, std::ios::out | std::ios::binary);
+    server::Config& config = server::Config::GetInstance();
+    config.GetStorageConfigFileDirectIO(direct_io_);
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    if (direct_io_) {
+        fd_ = ::open(name_.c_str(), flags | O_DIRECT, 0644);
+        if (fd_ < 0) {
+            // not every filesystem supports O_DIRECT (tmpfs does not)
+            direct_io_ = false;
+        }
+    }
+    if (fd_ < 0) {
+        fd_ = ::open(name_.c_str(), flags, 0644);
+    }
+    if (fd_ < 0) {
+        STORAGE_LOG_ERROR << "Failed to create file '" << name_ << "': " << strerror(errno);
+        return;
+    }
+
+    void* buf = nullptr;
+    if (posix_memalign(&buf, FILE_DIRECT_IO_ALIGN, FILE_WRITE_BUFFER) != 0) {
+        ::close(fd_);
+        fd_ = -1;
+        return;
+    }
+    buffer_ = static_cast<char*>(buf);
 }
 
 FileIOWriter::~FileIOWriter() {
-    fs_.close();
+    if (fd_ >= 0) {
+        if (direct_io_) {
+            // pad the tail to the alignment boundary, then cut the file back to
+            // its real length and make the write-once output durable
+            size_t padded = ((buffered_ + FILE_DIRECT_IO_ALIGN - 1) / FILE_DIRECT_IO_ALIGN) * FILE_DIRECT_IO_ALIGN;
+            if (padded > 0) {
+                memset(buffer_ + buffered_, 0, padded - buffered_);
+                write_all(fd_, buffer_, padded);
+            }
+            if (ftruncate(fd_, len_) != 0 || fdatasync(fd_) != 0) {
+                STORAGE_LOG_ERROR << "Failed to finalize file '" << name_ << "': " << strerror(errno);
+            }
+        } else {
+            flush_buffer();
+        }
+        ::close(fd_);
+    }
+    free(buffer_);
 }
 
 void
 FileIOWriter::write(void* ptr, size_t size) {
-    fs_.write(reinterpret_cast<char*>(ptr), size);
+    if (fd_ < 0) {
+        return;
+    }
+    char* src = static_cast<char*>(ptr);
+
+    // without O_DIRECT a payload larger than the buffer needs no staging copy:
+    // gather the buffered bytes and the payload into one vectored write.
+    // O_DIRECT payloads always go through the aligned buffer since the
+    // serializer's pointers carry no alignment guarantee
+    if (!direct_io_ && size >= FILE_WRITE_BUFFER) {
+        struct iovec iov[2];
+        iov[0].iov_base = buffer_;
+        iov[0].iov_len = buffered_;
+        iov[1].iov_base = src;
+        iov[1].iov_len = size;
+        ssize_t written = ::writev(fd_, iov, 2);
+        size_t total = buffered_ + size;
+        if (written >= 0 && static_cast<size_t>(written) < total) {
+            // short vectored write: finish the remainder with plain writes
+            size_t done = written;
+            if (done < buffered_) {
+                write_all(fd_, buffer_ + done, buffered_ - done);
+                done = buffered_;
+            }
+            write_all(fd_, src + (done - buffered_), total - done);
+        } else if (written < 0) {
+            STORAGE_LOG_ERROR << "Failed to write file: " << strerror(errno);
+        }
+        buffered_ = 0;
+        len_ += size;
+        return;
+    }
+
+    size_t remaining = size;
+    while (remaining > 0) {
+        size_t batch = std::min(remaining, FILE_WRITE_BUFFER - buffered_);
+        memcpy(buffer_ + buffered_, src, batch);
+        buffered_ += batch;
+        src += batch;
+        remaining -= batch;
+        if (buffered_ == FILE_WRITE_BUFFER) {
+            flush_buffer();
+        }
+    }
     len_ += size;
 }
 
+void
+FileIOWriter::flush_buffer() {
+    if (buffered_ > 0) {
+        write_all(fd_, buffer_, buffered_);
+        buffered_ = 0;
+    }
+}
+
 size_t
 FileIOWriter::length() {
     return len_;
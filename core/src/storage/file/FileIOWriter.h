@@ -11,13 +11,19 @@
 
 #pragma once
 
-#include <fstream>
 #include <string>
 #include "storage/IOWriter.h"
 
 namespace milvus {
 namespace storage {
 
+// Buffered segment writer over a raw fd. Serializer output is coalesced in a
+// large aligned buffer and flushed with writev so the stdio double-buffering
+// of the old std::fstream path is gone; payloads bigger than the buffer are
+// gathered into the same vectored write instead of being copied. When
+// storage_config.file_direct_io is enabled the file is opened with O_DIRECT
+// and fdatasync'ed on close, so write-once flush/compaction output does not
+// evict the hot read cache.
 class FileIOWriter : public IOWriter {
  public:
     explicit FileIOWriter(const std::string& name);
@@ -29,8 +35,15 @@ class FileIOWriter : public IOWriter {
     size_t
     length() override;
 
- public:
-    std::fstream fs_;
+ private:
+    void
+    flush_buffer();
+
+ private:
+    int fd_ = -1;
+    bool direct_io_ = false;
+    char* buffer_ = nullptr;
+    size_t buffered_ = 0;
 };
 
 }  // namespace storage
@@ -10,6 +10,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <memory>
+#include <mutex>
+#include <string>
 #include <utility>
 
 #include <aws/core/Aws.h>
@@ -18,11 +20,16 @@
 #include <aws/core/utils/Outcome.h>
 #include <aws/core/utils/StringUtils.h>
 #include <aws/s3/S3Client.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/CreateBucketRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
 
 namespace milvus {
 namespace storage {
@@ -52,6 +59,7 @@ class S3ClientMock : public Aws::S3::S3Client {
 
     Aws::S3::Model::PutObjectOutcome
     PutObject(const Aws::S3::Model::PutObjectRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
         Aws::String key = request.GetKey();
         std::shared_ptr<Aws::IOStream> body = request.GetBody();
         aws_map_[key] = body;
@@ -60,15 +68,83 @@ class S3ClientMock : public Aws::S3::S3Client {
         return Aws::S3::Model::PutObjectOutcome(std::move(result));
     }
 
+    Aws::S3::Model::CreateMultipartUploadOutcome
+    CreateMultipartUpload(const Aws::S3::Model::CreateMultipartUploadRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Aws::String upload_id = "mock-upload-" + Aws::String(std::to_string(next_upload_id_++).c_str());
+        parts_map_[upload_id];
+        Aws::S3::Model::CreateMultipartUploadResult result;
+        result.SetUploadId(upload_id);
+        return Aws::S3::Model::CreateMultipartUploadOutcome(std::move(result));
+    }
+
+    Aws::S3::Model::UploadPartOutcome
+    UploadPart(const Aws::S3::Model::UploadPartRequest& request) const override {
+        std::shared_ptr<Aws::IOStream> body = request.GetBody();
+        Aws::String body_str((Aws::IStreamBufIterator(*body)), Aws::IStreamBufIterator());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        try {
+            parts_map_.at(request.GetUploadId())[request.GetPartNumber()] = std::move(body_str);
+        } catch (...) {
+            return Aws::S3::Model::UploadPartOutcome();
+        }
+        Aws::S3::Model::UploadPartResult result;
+        result.SetETag("mock-etag-" + Aws::String(std::to_string(request.GetPartNumber()).c_str()));
+        return Aws::S3::Model::UploadPartOutcome(std::move(result));
+    }
+
+    Aws::S3::Model::CompleteMultipartUploadOutcome
+    CompleteMultipartUpload(const Aws::S3::Model::CompleteMultipartUploadRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        try {
+            auto& parts = parts_map_.at(request.GetUploadId());
+            auto body = Aws::MakeShared<Aws::StringStream>("CompleteMultipartUpload");
+            // Aws::Map is ordered, so iteration concatenates in part-number order
+            for (auto& part : parts) {
+                body->write(part.second.c_str(), part.second.length());
+            }
+            aws_map_[request.GetKey()] = body;
+            parts_map_.erase(request.GetUploadId());
+        } catch (...) {
+            return Aws::S3::Model::CompleteMultipartUploadOutcome();
+        }
+        Aws::S3::Model::CompleteMultipartUploadResult result;
+        return Aws::S3::Model::CompleteMultipartUploadOutcome(std::move(result));
+    }
+
+    Aws::S3::Model::AbortMultipartUploadOutcome
+    AbortMultipartUpload(const Aws::S3::Model::AbortMultipartUploadRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        parts_map_.erase(request.GetUploadId());
+        Aws::NoResult result;
+        return Aws::S3::Model::AbortMultipartUploadOutcome(std::move(result));
+    }
+
     Aws::S3::Model::GetObjectOutcome
     GetObject(const Aws::S3::Model::GetObjectRequest& request) const override {
         auto factory = request.GetResponseStreamFactory();
         Aws::Utils::Stream::ResponseStream resp_stream(factory);
 
+        // ranged reads now arrive from several transfer threads at once and
+        // share the stored body stream
+        std::lock_guard<std::mutex> lock(mutex_);
         try {
             std::shared_ptr<Aws::IOStream> body = aws_map_.at(request.GetKey());
+            body->clear();
+            body->seekg(0, std::ios::beg);
             Aws::String body_str((Aws::IStreamBufIterator(*body)), Aws::IStreamBufIterator());
 
+            // honor ranged reads ("bytes=<first>-<last>") like the real service
+            Aws::String range = request.GetRange();
+            if (!range.empty()) {
+                auto eq = range.find('=');
+                auto dash = range.find('-');
+                size_t first = std::stoull(std::string(range.substr(eq + 1, dash - eq - 1).c_str()));
+                size_t last = std::stoull(std::string(range.substr(dash + 1).c_str()));
+                body_str = body_str.substr(first, last - first + 1);
+            }
+
             resp_stream.GetUnderlyingStream().write(body_str.c_str(), body_str.length());
             resp_stream.GetUnderlyingStream().flush();
             Aws::AmazonWebServiceResult<Aws::Utils::Stream::ResponseStream> awsStream(
@@ -81,6 +157,22 @@ class S3ClientMock : public Aws::S3::S3Client {
         }
     }
 
+    Aws::S3::Model::HeadObjectOutcome
+    HeadObject(const Aws::S3::Model::HeadObjectRequest& request) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        try {
+            std::shared_ptr<Aws::IOStream> body = aws_map_.at(request.GetKey());
+            body->clear();
+            body->seekg(0, std::ios::beg);
+            Aws::String body_str((Aws::IStreamBufIterator(*body)), Aws::IStreamBufIterator());
+            Aws::S3::Model::HeadObjectResult result;
+            result.SetContentLength(static_cast<long long>(body_str.length()));
+            return Aws::S3::Model::HeadObjectOutcome(std::move(result));
+        } catch (...) {
+            return Aws::S3::Model::HeadObjectOutcome();
+        }
+    }
+
     Aws::S3::Model::ListObjectsOutcome
     ListObjects(const Aws::S3::Model::ListObjectsRequest& request) const override {
         /* TODO: add object key list into ListObjectsOutcome */
@@ -98,7 +190,10 @@ class S3ClientMock : public Aws::S3::S3Client {
         return result;
     }
 
+    mutable std::mutex mutex_;
     mutable Aws::Map<Aws::String, std::shared_ptr<Aws::IOStream>> aws_map_;
+    mutable Aws::Map<Aws::String, Aws::Map<int, Aws::String>> parts_map_;
+    mutable uint64_t next_upload_id_ = 0;
 };
 
 }  // namespace storage
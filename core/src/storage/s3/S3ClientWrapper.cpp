@@ -10,17 +10,27 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <aws/core/auth/AWSCredentialsProvider.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/CreateBucketRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/ListObjectsRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
 #include <fiu-local.h>
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "server/Config.h"
 #include "storage/s3/S3ClientMock.h"
@@ -31,6 +41,16 @@
 namespace milvus {
 namespace storage {
 
+namespace {
+// transfers at or above the threshold are split into parts of this size and
+// moved by a bounded pool of workers; a single stream cannot saturate the
+// bucket, multiple part streams can
+constexpr size_t S3_TRANSFER_PART_SIZE = 16 * 1024 * 1024;
+constexpr size_t S3_MULTIPART_THRESHOLD = 2 * S3_TRANSFER_PART_SIZE;
+constexpr size_t S3_TRANSFER_CONCURRENCY = 4;
+constexpr int S3_TRANSFER_MAX_RETRY = 3;
+}  // namespace
+
 Status
 S3ClientWrapper::StartService() {
     server::Config& config = server::Config::GetInstance();
@@ -113,6 +133,111 @@ S3ClientWrapper::DeleteBucket() {
     return Status::OK();
 }
 
+Status
+S3ClientWrapper::MultipartUpload(const std::string& object_name, size_t total_size,
+                                 const std::function<Status(size_t offset, size_t length, Aws::String& body)>&
+                                     read_part) {
+    Aws::S3::Model::CreateMultipartUploadRequest create_request;
+    create_request.WithBucket(s3_bucket_).WithKey(object_name);
+
+    auto create_outcome = client_ptr_->CreateMultipartUpload(create_request);
+
+    fiu_do_on("S3ClientWrapper.MultipartUpload.create.fail",
+              create_outcome = Aws::S3::Model::CreateMultipartUploadOutcome());
+    if (!create_outcome.IsSuccess()) {
+        auto err = create_outcome.GetError();
+        STORAGE_LOG_ERROR << "ERROR: CreateMultipartUpload: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+    Aws::String upload_id = create_outcome.GetResult().GetUploadId();
+
+    size_t part_count = (total_size + S3_TRANSFER_PART_SIZE - 1) / S3_TRANSFER_PART_SIZE;
+    std::vector<Aws::String> etags(part_count);
+    std::atomic<size_t> next_part(0);
+    std::atomic<bool> failed(false);
+    std::mutex err_mutex;
+    std::string err_msg;
+
+    auto worker = [&]() {
+        size_t part;
+        while (!failed.load() && (part = next_part.fetch_add(1)) < part_count) {
+            size_t part_offset = part * S3_TRANSFER_PART_SIZE;
+            size_t part_length = std::min(S3_TRANSFER_PART_SIZE, total_size - part_offset);
+
+            // each part retries alone; completed parts are never re-sent
+            Status stat;
+            for (int attempt = 0; attempt < S3_TRANSFER_MAX_RETRY; ++attempt) {
+                Aws::String body;
+                stat = read_part(part_offset, part_length, body);
+                if (!stat.ok()) {
+                    continue;
+                }
+
+                Aws::S3::Model::UploadPartRequest part_request;
+                part_request.WithBucket(s3_bucket_)
+                    .WithKey(object_name)
+                    .WithUploadId(upload_id)
+                    .WithPartNumber(static_cast<int>(part) + 1);
+                auto stream = Aws::MakeShared<Aws::StringStream>("UploadPart");
+                stream->write(body.c_str(), body.length());
+                part_request.SetBody(stream);
+
+                auto outcome = client_ptr_->UploadPart(part_request);
+                if (outcome.IsSuccess()) {
+                    etags[part] = outcome.GetResult().GetETag();
+                    stat = Status::OK();
+                    break;
+                }
+                stat = Status(SERVER_UNEXPECTED_ERROR, outcome.GetError().GetMessage());
+            }
+            if (!stat.ok()) {
+                failed.store(true);
+                std::lock_guard<std::mutex> lock(err_mutex);
+                err_msg = stat.message();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    size_t worker_count = std::min(S3_TRANSFER_CONCURRENCY, part_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    if (failed.load()) {
+        Aws::S3::Model::AbortMultipartUploadRequest abort_request;
+        abort_request.WithBucket(s3_bucket_).WithKey(object_name).WithUploadId(upload_id);
+        client_ptr_->AbortMultipartUpload(abort_request);
+        STORAGE_LOG_ERROR << "ERROR: MultipartUpload: " << err_msg;
+        return Status(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+
+    Aws::S3::Model::CompletedMultipartUpload completed;
+    for (size_t i = 0; i < part_count; ++i) {
+        completed.AddParts(
+            Aws::S3::Model::CompletedPart().WithPartNumber(static_cast<int>(i) + 1).WithETag(etags[i]));
+    }
+    Aws::S3::Model::CompleteMultipartUploadRequest complete_request;
+    complete_request.WithBucket(s3_bucket_).WithKey(object_name).WithUploadId(upload_id);
+    complete_request.SetMultipartUpload(completed);
+
+    auto complete_outcome = client_ptr_->CompleteMultipartUpload(complete_request);
+
+    fiu_do_on("S3ClientWrapper.MultipartUpload.complete.fail",
+              complete_outcome = Aws::S3::Model::CompleteMultipartUploadOutcome());
+    if (!complete_outcome.IsSuccess()) {
+        auto err = complete_outcome.GetError();
+        STORAGE_LOG_ERROR << "ERROR: CompleteMultipartUpload: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    STORAGE_LOG_DEBUG << "MultipartUpload '" << object_name << "' (" << part_count << " parts) successfully!";
+    return Status::OK();
+}
+
 Status
 S3ClientWrapper::PutObjectFile(const std::string& object_name, const std::string& file_path) {
     struct stat buffer;
@@ -122,6 +247,22 @@ S3ClientWrapper::PutObjectFile(const std::string& object_name, const std::string
         return Status(SERVER_UNEXPECTED_ERROR, str);
     }
 
+    size_t file_size = static_cast<size_t>(buffer.st_size);
+    if (file_size >= S3_MULTIPART_THRESHOLD) {
+        // each worker reads its parts through its own stream
+        auto read_part = [&file_path](size_t offset, size_t length, Aws::String& body) {
+            std::ifstream file(file_path, std::ios::binary);
+            file.seekg(offset);
+            body.resize(length);
+            file.read(&body[0], length);
+            if (static_cast<size_t>(file.gcount()) != length) {
+                return Status(SERVER_UNEXPECTED_ERROR, "Failed to read part of file: " + file_path);
+            }
+            return Status::OK();
+        };
+        return MultipartUpload(object_name, file_size, read_part);
+    }
+
     Aws::S3::Model::PutObjectRequest request;
     request.WithBucket(s3_bucket_).WithKey(object_name);
 
@@ -144,6 +285,14 @@ S3ClientWrapper::PutObjectFile(const std::string& object_name, const std::string
 
 Status
 S3ClientWrapper::PutObjectStr(const std::string& object_name, const std::string& content) {
+    if (content.length() >= S3_MULTIPART_THRESHOLD) {
+        auto read_part = [&content](size_t offset, size_t length, Aws::String& body) {
+            body.assign(content.data() + offset, length);
+            return Status::OK();
+        };
+        return MultipartUpload(object_name, content.length(), read_part);
+    }
+
     Aws::S3::Model::PutObjectRequest request;
     request.WithBucket(s3_bucket_).WithKey(object_name);
 
@@ -210,6 +359,101 @@ S3ClientWrapper::GetObjectStr(const std::string& object_name, std::string& conte
     return Status::OK();
 }
 
+Status
+S3ClientWrapper::GetObjectSize(const std::string& object_name, size_t& size) {
+    Aws::S3::Model::HeadObjectRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name);
+
+    auto outcome = client_ptr_->HeadObject(request);
+
+    fiu_do_on("S3ClientWrapper.GetObjectSize.outcome.fail", outcome = Aws::S3::Model::HeadObjectOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        STORAGE_LOG_ERROR << "ERROR: HeadObject: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    size = static_cast<size_t>(outcome.GetResult().GetContentLength());
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::GetObjectRange(const std::string& object_name, size_t offset, size_t length, void* buffer) {
+    Aws::S3::Model::GetObjectRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name);
+    request.SetRange(("bytes=" + std::to_string(offset) + "-" + std::to_string(offset + length - 1)).c_str());
+
+    auto outcome = client_ptr_->GetObject(request);
+
+    fiu_do_on("S3ClientWrapper.GetObjectRange.outcome.fail", outcome = Aws::S3::Model::GetObjectOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        STORAGE_LOG_ERROR << "ERROR: GetObject: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    // the ranged body streams straight into the caller's buffer, no staging copy
+    auto& retrieved_file = outcome.GetResultWithOwnership().GetBody();
+    retrieved_file.read(static_cast<char*>(buffer), static_cast<std::streamsize>(length));
+    if (static_cast<size_t>(retrieved_file.gcount()) != length) {
+        std::string msg = "Incomplete ranged read from object: " + object_name;
+        STORAGE_LOG_ERROR << "ERROR: GetObjectRange: " << msg;
+        return Status(SERVER_UNEXPECTED_ERROR, msg);
+    }
+
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::GetObjectRangeParallel(const std::string& object_name, size_t offset, size_t length, void* buffer) {
+    if (length < S3_MULTIPART_THRESHOLD) {
+        return GetObjectRange(object_name, offset, length, buffer);
+    }
+
+    size_t part_count = (length + S3_TRANSFER_PART_SIZE - 1) / S3_TRANSFER_PART_SIZE;
+    std::atomic<size_t> next_part(0);
+    std::atomic<bool> failed(false);
+    std::mutex err_mutex;
+    std::string err_msg;
+
+    auto worker = [&]() {
+        size_t part;
+        while (!failed.load() && (part = next_part.fetch_add(1)) < part_count) {
+            size_t part_offset = part * S3_TRANSFER_PART_SIZE;
+            size_t part_length = std::min(S3_TRANSFER_PART_SIZE, length - part_offset);
+            char* part_buffer = static_cast<char*>(buffer) + part_offset;
+
+            // only the failed part is re-fetched, never the whole range
+            Status stat;
+            for (int attempt = 0; attempt < S3_TRANSFER_MAX_RETRY; ++attempt) {
+                stat = GetObjectRange(object_name, offset + part_offset, part_length, part_buffer);
+                if (stat.ok()) {
+                    break;
+                }
+            }
+            if (!stat.ok()) {
+                failed.store(true);
+                std::lock_guard<std::mutex> lock(err_mutex);
+                err_msg = stat.message();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    size_t worker_count = std::min(S3_TRANSFER_CONCURRENCY, part_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    if (failed.load()) {
+        return Status(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 S3ClientWrapper::ListObjects(std::vector<std::string>& object_list, const std::string& marker) {
     Aws::S3::Model::ListObjectsRequest request;
@@ -13,6 +13,7 @@
 
 #include <aws/core/Aws.h>
 #include <aws/s3/S3Client.h>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -47,12 +48,28 @@ class S3ClientWrapper : public IStorage {
     Status
     GetObjectStr(const std::string& object_key, std::string& content) override;
     Status
+    GetObjectSize(const std::string& object_key, size_t& size) override;
+    Status
+    GetObjectRange(const std::string& object_key, size_t offset, size_t length, void* buffer) override;
+    Status
     ListObjects(std::vector<std::string>& object_list, const std::string& marker = "") override;
     Status
     DeleteObject(const std::string& object_key) override;
     Status
     DeleteObjects(const std::string& marker) override;
 
+    // concurrent ranged GETs into `buffer`; only failed parts are retried,
+    // completed ones are never re-fetched. Small ranges degrade to a single GET
+    Status
+    GetObjectRangeParallel(const std::string& object_key, size_t offset, size_t length, void* buffer);
+
+ private:
+    // multipart upload with bounded part concurrency. `read_part` produces the
+    // bytes at [offset, offset + length) and may be called from worker threads
+    Status
+    MultipartUpload(const std::string& object_key, size_t total_size,
+                    const std::function<Status(size_t offset, size_t length, Aws::String& body)>& read_part);
+
  private:
     std::shared_ptr<Aws::S3::S3Client> client_ptr_;
     Aws::SDKOptions options_;
@@ -12,11 +12,20 @@
 #include "storage/s3/S3IOReader.h"
 #include "storage/s3/S3ClientWrapper.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace milvus {
 namespace storage {
 
+namespace {
+// small framing fields are served from a readahead window of this size; reads at
+// least this large bypass the window and stream directly into the destination
+constexpr size_t S3_READAHEAD_CHUNK = 4 * 1024 * 1024;
+}  // namespace
+
 S3IOReader::S3IOReader(const std::string& name) : IOReader(name), pos_(0) {
-    S3ClientWrapper::GetInstance().GetObjectStr(name_, buffer_);
+    S3ClientWrapper::GetInstance().GetObjectSize(name_, length_);
 }
 
 S3IOReader::~S3IOReader() {
@@ -24,7 +33,32 @@ S3IOReader::~S3IOReader() {
 
 void
 S3IOReader::read(void* ptr, size_t size) {
-    memcpy(ptr, buffer_.data() + pos_, size);
+    char* dst = static_cast<char*>(ptr);
+
+    // large payloads land directly in the caller's buffer via ranged GETs,
+    // fetched by several part streams in parallel when big enough
+    if (size >= S3_READAHEAD_CHUNK) {
+        S3ClientWrapper::GetInstance().GetObjectRangeParallel(name_, pos_, size, dst);
+        pos_ += size;
+        return;
+    }
+
+    size_t remaining = size;
+    while (remaining > 0) {
+        if (buffer_.empty() || pos_ < buffer_offset_ || pos_ >= buffer_offset_ + buffer_.size()) {
+            // refill the readahead window at the current cursor
+            size_t chunk = std::min(S3_READAHEAD_CHUNK, length_ - pos_);
+            buffer_.resize(chunk);
+            S3ClientWrapper::GetInstance().GetObjectRange(name_, pos_, chunk, &buffer_[0]);
+            buffer_offset_ = pos_;
+        }
+        size_t available = buffer_offset_ + buffer_.size() - pos_;
+        size_t batch = std::min(available, remaining);
+        memcpy(dst, buffer_.data() + (pos_ - buffer_offset_), batch);
+        dst += batch;
+        pos_ += batch;
+        remaining -= batch;
+    }
 }
 
 void
@@ -34,7 +68,7 @@ S3IOReader::seekg(size_t pos) {
 
 size_t
 S3IOReader::length() {
-    return buffer_.length();
+    return length_;
 }
 
 }  // namespace storage
@@ -17,6 +17,12 @@
 namespace milvus {
 namespace storage {
 
+/*
+ * Lazy ranged reader: instead of downloading the whole object up front, small
+ * reads are served from a readahead window fetched with ranged GETs, and large
+ * reads (index binary payloads) stream straight into the caller's buffer, so
+ * the object is never materialized twice on the host.
+ */
 class S3IOReader : public IOReader {
  public:
     explicit S3IOReader(const std::string& name);
@@ -33,7 +39,9 @@ class S3IOReader : public IOReader {
 
  public:
     std::string buffer_;
+    size_t buffer_offset_ = 0;
     size_t pos_;
+    size_t length_ = 0;
 };
 
 }  // namespace storage
@@ -25,7 +25,10 @@ S3IOWriter::~S3IOWriter() {
 
 void
 S3IOWriter::write(void* ptr, size_t size) {
-    buffer_ += std::string(reinterpret_cast<char*>(ptr), size);
+    // append straight from the caller's buffer; the old std::string temporary
+    // copied every payload an extra time before it even reached the staging
+    // buffer
+    buffer_.append(reinterpret_cast<char*>(ptr), size);
     len_ += size;
 }
 
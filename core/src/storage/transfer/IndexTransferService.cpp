@@ -0,0 +1,339 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/transfer/IndexTransferService.h"
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "cache/DiskCacheMgr.h"
+#include "server/Config.h"
+#include "utils/CommonUtil.h"
+#include "utils/Log.h"
+#include "utils/StringHelpFunctions.h"
+#include "utils/ValidationUtil.h"
+
+namespace milvus {
+namespace storage {
+
+namespace {
+
+constexpr int TRANSFER_TIMEOUT_SEC = 5;
+constexpr size_t TRANSFER_CHUNK_SIZE = 1 << 20;
+
+void
+SetSocketTimeout(int fd) {
+    struct timeval tv;
+    tv.tv_sec = TRANSFER_TIMEOUT_SEC;
+    tv.tv_usec = 0;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+bool
+SendAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+// read until '\n' (consumed, not stored); the request/reply headers are short
+bool
+RecvLine(int fd, std::string& line) {
+    line.clear();
+    char ch;
+    while (line.size() < 4096) {
+        ssize_t got = recv(fd, &ch, 1, 0);
+        if (got <= 0) {
+            return false;
+        }
+        if (ch == '\n') {
+            return true;
+        }
+        line.push_back(ch);
+    }
+    return false;
+}
+
+bool
+PathWithinRoots(const std::string& path, const std::vector<std::string>& roots) {
+    for (auto& root : roots) {
+        if (path.size() >= root.size() && path.compare(0, root.size(), root) == 0 &&
+            (path.size() == root.size() || path[root.size()] == '/')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+Status
+IndexTransferService::Start() {
+    server::Config& config = server::Config::GetInstance();
+    config.GetStorageConfigTransferPort(port_);
+    if (port_ <= 0) {
+        return Status::OK();
+    }
+
+    std::string peers_str;
+    config.GetServerConfigRouterPeers(peers_str);
+    if (!peers_str.empty()) {
+        std::vector<std::string> peers;
+        server::StringHelpFunctions::SplitStringByDelimeter(peers_str, ",", peers);
+        for (auto& peer : peers) {
+            // the grpc port after the colon is replaced by transfer_port,
+            // which is expected to be the same on every node
+            peer_hosts_.push_back(peer.substr(0, peer.rfind(':')));
+        }
+    }
+
+    // the serve side only ever answers requests for files under these
+    // roots; anything else a peer asks for is treated as a miss
+    std::string primary_path;
+    config.GetStorageConfigPrimaryPath(primary_path);
+    std::string secondary_paths;
+    config.GetStorageConfigSecondaryPath(secondary_paths);
+    std::string disk_cache_path;
+    config.GetCacheConfigDiskCachePath(disk_cache_path);
+
+    std::vector<std::string> roots = {primary_path, disk_cache_path};
+    std::vector<std::string> secondary;
+    server::StringHelpFunctions::SplitStringByDelimeter(secondary_paths, ";", secondary);
+    for (auto& path : secondary) {
+        // strip an optional device-class tag (e.g. /mnt/nvme0:hot)
+        std::string::size_type tag_pos = path.rfind(':');
+        if (tag_pos != std::string::npos && path.find('/', tag_pos) == std::string::npos) {
+            path = path.substr(0, tag_pos);
+        }
+        roots.push_back(path);
+    }
+    serve_roots_.clear();
+    for (auto& root : roots) {
+        char resolved[PATH_MAX];
+        if (!root.empty() && realpath(root.c_str(), resolved) != nullptr) {
+            serve_roots_.emplace_back(resolved);
+        }
+    }
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Cannot create transfer socket: " + std::string(strerror(errno)));
+    }
+
+    int reuse = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<uint16_t>(port_));
+    if (bind(listen_fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 || listen(listen_fd_, 16) < 0) {
+        std::string msg = "Cannot listen on transfer port " + std::to_string(port_) + ": " + strerror(errno);
+        close(listen_fd_);
+        listen_fd_ = -1;
+        return Status(SERVER_UNEXPECTED_ERROR, msg);
+    }
+
+    stop_.store(false);
+    accept_thread_ = std::thread(&IndexTransferService::AcceptLoop, this);
+    STORAGE_LOG_INFO << "Index transfer service listening on port " << port_;
+    return Status::OK();
+}
+
+void
+IndexTransferService::Stop() {
+    if (listen_fd_ < 0) {
+        return;
+    }
+    stop_.store(true);
+    shutdown(listen_fd_, SHUT_RDWR);
+    close(listen_fd_);
+    listen_fd_ = -1;
+    if (accept_thread_.joinable()) {
+        accept_thread_.join();
+    }
+    // in-flight transfer threads hold `this`; wait for the last one before
+    // the caller proceeds with teardown
+    std::unique_lock<std::mutex> lock(serve_mutex_);
+    serve_cv_.wait(lock, [this] { return active_serves_.load() == 0; });
+}
+
+void
+IndexTransferService::AcceptLoop() {
+    while (!stop_.load()) {
+        int client_fd = accept(listen_fd_, nullptr, nullptr);
+        if (client_fd < 0) {
+            if (stop_.load()) {
+                break;
+            }
+            continue;
+        }
+        // one thread per transfer; a restart pulls many segments at once and
+        // they should not serialize behind each other. The count is raised
+        // before the thread exists so Stop() can never miss one in flight.
+        active_serves_.fetch_add(1);
+        std::thread([this, client_fd] {
+            ServeConnection(client_fd);
+            std::lock_guard<std::mutex> lock(serve_mutex_);
+            active_serves_.fetch_sub(1);
+            serve_cv_.notify_all();
+        }).detach();
+    }
+}
+
+void
+IndexTransferService::ServeConnection(int client_fd) {
+    SetSocketTimeout(client_fd);
+
+    std::string line;
+    if (!RecvLine(client_fd, line) || line.compare(0, 4, "GET ") != 0) {
+        close(client_fd);
+        return;
+    }
+    std::string location = line.substr(4);
+
+    // serve only what this node already holds; a miss here must not turn
+    // into an S3 download on the peer's behalf
+    std::string local_path;
+    if (!cache::DiskCacheMgr::GetInstance()->Peek(location, local_path)) {
+        // the path came off the wire from an unauthenticated peer:
+        // canonicalize it and refuse anything outside the storage roots,
+        // otherwise any LAN host could read any file this process can open
+        char resolved[PATH_MAX];
+        if (realpath(location.c_str(), resolved) != nullptr && PathWithinRoots(resolved, serve_roots_)) {
+            local_path = resolved;
+        } else {
+            SendAll(client_fd, "MISS\n", 5);
+            close(client_fd);
+            return;
+        }
+    }
+
+    std::ifstream file(local_path, std::ios::binary);
+    int64_t size = server::CommonUtil::GetFileSize(local_path);
+    if (!file.good() || size <= 0) {
+        SendAll(client_fd, "MISS\n", 5);
+        close(client_fd);
+        return;
+    }
+
+    std::string header = "OK " + std::to_string(size) + "\n";
+    if (SendAll(client_fd, header.data(), header.size())) {
+        std::vector<char> buf(TRANSFER_CHUNK_SIZE);
+        while (size > 0 && file.read(buf.data(), std::min<int64_t>(size, buf.size())).gcount() > 0) {
+            auto got = file.gcount();
+            if (!SendAll(client_fd, buf.data(), got)) {
+                break;
+            }
+            size -= got;
+        }
+    }
+    close(client_fd);
+}
+
+Status
+IndexTransferService::FetchFromPeers(const std::string& location, const std::string& dest_path) {
+    if (port_ <= 0 || peer_hosts_.empty()) {
+        return Status(SERVER_UNSUPPORTED_ERROR, "Index transfer is disabled");
+    }
+
+    for (auto& host : peer_hosts_) {
+        auto status = FetchFromPeer(host, location, dest_path);
+        if (status.ok()) {
+            STORAGE_LOG_DEBUG << "Fetched " << location << " from peer " << host;
+            return status;
+        }
+    }
+    return Status(SERVER_UNEXPECTED_ERROR, "No peer holds " + location);
+}
+
+Status
+IndexTransferService::FetchFromPeer(const std::string& host, const std::string& location,
+                                    const std::string& dest_path) {
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    struct addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port_).c_str(), &hints, &result) != 0 || result == nullptr) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Cannot resolve peer " + host);
+    }
+
+    int fd = socket(result->ai_family, result->ai_socktype | SOCK_CLOEXEC, result->ai_protocol);
+    if (fd < 0) {
+        freeaddrinfo(result);
+        return Status(SERVER_UNEXPECTED_ERROR, "Cannot create socket");
+    }
+    SetSocketTimeout(fd);
+
+    int ret = connect(fd, result->ai_addr, result->ai_addrlen);
+    freeaddrinfo(result);
+    if (ret < 0) {
+        close(fd);
+        return Status(SERVER_UNEXPECTED_ERROR, "Cannot connect to peer " + host);
+    }
+
+    std::string request = "GET " + location + "\n";
+    std::string reply;
+    if (!SendAll(fd, request.data(), request.size()) || !RecvLine(fd, reply) || reply.compare(0, 3, "OK ") != 0) {
+        close(fd);
+        return Status(SERVER_UNEXPECTED_ERROR, "Peer " + host + " does not hold " + location);
+    }
+
+    // the reply is untrusted input; a malformed size field must fail the
+    // fetch, not throw through the caller
+    std::string size_str = reply.substr(3);
+    if (!server::ValidationUtil::ValidateStringIsNumber(size_str).ok()) {
+        close(fd);
+        return Status(SERVER_UNEXPECTED_ERROR, "Malformed reply from peer " + host);
+    }
+    int64_t size = std::stoll(size_str);
+    std::ofstream file(dest_path, std::ios::binary | std::ios::trunc);
+    std::vector<char> buf(TRANSFER_CHUNK_SIZE);
+    while (size > 0) {
+        ssize_t got = recv(fd, buf.data(), std::min<int64_t>(size, buf.size()), 0);
+        if (got <= 0) {
+            break;
+        }
+        file.write(buf.data(), got);
+        size -= got;
+    }
+    close(fd);
+
+    if (size != 0 || !file.good()) {
+        file.close();
+        return Status(SERVER_UNEXPECTED_ERROR, "Transfer from peer " + host + " truncated");
+    }
+    return Status::OK();
+}
+
+}  // namespace storage
+}  // namespace milvus
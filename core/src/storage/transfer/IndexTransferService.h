@@ -0,0 +1,83 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/Status.h"
+
+namespace milvus {
+namespace storage {
+
+// Node-to-node transfer of serialized index files, so a restarted or
+// reassigned replica pulls a warm segment from a LAN peer instead of
+// re-downloading it from S3. The protocol is a single request line
+// "GET <location>\n" answered with "OK <size>\n" plus the raw file bytes,
+// or "MISS\n". A node serves only files it already holds (disk cache copy
+// or the location itself on local storage) and never touches S3 on behalf
+// of a peer, so one cold cluster cannot amplify S3 traffic through itself.
+//
+// Listens on storage_config.transfer_port (0 disables the service); the
+// fetch side contacts the hosts from server_config.router_peers on that
+// same port, first hit wins.
+class IndexTransferService {
+ public:
+    static IndexTransferService&
+    GetInstance() {
+        static IndexTransferService service;
+        return service;
+    }
+
+    Status
+    Start();
+    void
+    Stop();
+
+    // Try each peer in turn for a copy of `location`, writing the bytes to
+    // `dest_path`. Fails fast (connect/io timeouts) so the S3 fallback is
+    // delayed by at most a few seconds when no peer holds the file.
+    Status
+    FetchFromPeers(const std::string& location, const std::string& dest_path);
+
+ private:
+    IndexTransferService() = default;
+
+    void
+    AcceptLoop();
+    void
+    ServeConnection(int client_fd);
+
+    Status
+    FetchFromPeer(const std::string& host, const std::string& location, const std::string& dest_path);
+
+    int64_t port_ = 0;
+    int listen_fd_ = -1;
+    std::atomic<bool> stop_{false};
+    std::thread accept_thread_;
+    std::vector<std::string> peer_hosts_;
+
+    // canonicalized storage roots a peer may request files from; anything
+    // else that arrives over the wire is answered with MISS
+    std::vector<std::string> serve_roots_;
+
+    std::atomic<int64_t> active_serves_{0};
+    std::mutex serve_mutex_;
+    std::condition_variable serve_cv_;
+};
+
+}  // namespace storage
+}  // namespace milvus
@@ -13,6 +13,7 @@
 
 #include <opentracing/tracer.h>
 
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -32,9 +33,28 @@ class TraceContext {
     const std::unique_ptr<opentracing::Span>&
     GetSpan() const;
 
+    // false when the head sampler skipped this rpc and the span is a noop;
+    // used on finish to tail-report the rpc if it turned out slow
+    void
+    SetSampled(bool sampled) {
+        sampled_ = sampled;
+    }
+
+    bool
+    sampled() const {
+        return sampled_;
+    }
+
+    std::chrono::system_clock::time_point
+    start_time() const {
+        return start_time_;
+    }
+
  private:
     //    std::unique_ptr<opentracing::SpanContext> span_context_;
     std::unique_ptr<opentracing::Span> span_;
+    bool sampled_ = true;
+    std::chrono::system_clock::time_point start_time_ = std::chrono::system_clock::now();
 };
 
 }  // namespace tracing
@@ -0,0 +1,82 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "tracing/TraceSampler.h"
+
+#include <opentracing/noop.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace milvus {
+namespace tracing {
+
+TraceSampler&
+TraceSampler::GetInstance() {
+    static TraceSampler sampler;
+    return sampler;
+}
+
+TraceSampler::TraceSampler() : noop_tracer_(opentracing::MakeNoopTracer()) {
+}
+
+void
+TraceSampler::Configure(double probability, int64_t slow_threshold_ms) {
+    if (probability >= 1.0) {
+        sample_interval_ = 1;
+    } else if (probability <= 0.0) {
+        sample_interval_ = 0;
+    } else {
+        sample_interval_ = std::max<int64_t>(1, std::lround(1.0 / probability));
+    }
+    slow_threshold_ms_ = slow_threshold_ms;
+}
+
+bool
+TraceSampler::SampleHead() {
+    if (sample_interval_ <= 0) {
+        return false;
+    }
+    if (sample_interval_ == 1) {
+        return true;
+    }
+    return rpc_counter_.fetch_add(1, std::memory_order_relaxed) % static_cast<uint64_t>(sample_interval_) == 0;
+}
+
+const std::shared_ptr<opentracing::Tracer>&
+TraceSampler::NoopTracer() {
+    return noop_tracer_;
+}
+
+void
+TraceSampler::MaybeReportSlow(const std::string& operation_name, std::chrono::system_clock::time_point start_time) {
+    if (slow_threshold_ms_ <= 0) {
+        return;
+    }
+
+    auto now = std::chrono::system_clock::now();
+    auto latency_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time).count();
+    if (latency_ms < slow_threshold_ms_) {
+        return;
+    }
+
+    // one backdated span spanning the whole rpc; the vendor tracer batches
+    // and reports it asynchronously like any other span
+    auto span = opentracing::Tracer::Global()->StartSpan(operation_name, {opentracing::StartTimestamp(start_time)});
+    if (span != nullptr) {
+        span->SetTag("sampling.tail", true);
+        span->SetTag("latency_ms", latency_ms);
+        span->Finish();
+    }
+}
+
+}  // namespace tracing
+}  // namespace milvus
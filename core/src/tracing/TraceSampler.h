@@ -0,0 +1,73 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <opentracing/tracer.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace milvus {
+namespace tracing {
+
+// Sampling policy that keeps tracing affordable at high QPS. Head sampling
+// picks roughly one rpc in 1/probability to trace in full; the rest run on
+// noop spans, so every Child/Follower call site stays valid at near-zero
+// cost. Tail sampling covers the gap: a head-unsampled rpc that exceeds the
+// slow threshold retrospectively emits one backdated span, so latency
+// outliers are never invisible just because the dice ignored them. Batching
+// and async reporting of sampled spans stay with the vendor tracer loaded by
+// TracerUtil; this class only decides which spans exist at all.
+//
+// Configured from the optional "sampling" block of the tracer config file:
+//   "sampling": {"probability": 0.01, "slow_span_threshold_ms": 500}
+// Without that block every rpc is traced, matching the old behavior.
+class TraceSampler {
+ public:
+    static TraceSampler&
+    GetInstance();
+
+    void
+    Configure(double probability, int64_t slow_threshold_ms);
+
+    // head decision for one incoming rpc; deterministic 1-in-N
+    bool
+    SampleHead();
+
+    bool
+    TailEnabled() const {
+        return slow_threshold_ms_ > 0;
+    }
+
+    // shared noop tracer for head-unsampled rpcs
+    const std::shared_ptr<opentracing::Tracer>&
+    NoopTracer();
+
+    // called when a head-unsampled rpc finishes; emits one retrospective span
+    // through the real tracer if the rpc ran longer than the slow threshold
+    void
+    MaybeReportSlow(const std::string& operation_name, std::chrono::system_clock::time_point start_time);
+
+ private:
+    TraceSampler();
+
+ private:
+    int64_t sample_interval_ = 1;  // trace every Nth rpc; 0 disables head sampling entirely
+    int64_t slow_threshold_ms_ = 0;
+    std::atomic<uint64_t> rpc_counter_{0};
+    std::shared_ptr<opentracing::Tracer> noop_tracer_;
+};
+
+}  // namespace tracing
+}  // namespace milvus
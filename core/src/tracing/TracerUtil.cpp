@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "tracing/TracerUtil.h"
+#include "tracing/TraceSampler.h"
 
 #include <opentracing/dynamic_load.h>
 #include <opentracing/tracer.h>
@@ -48,6 +49,14 @@ TracerUtil::LoadConfig(const std::string& config_path) {
     std::string tracer_config_str = tracer_config_json[TRACER_CONFIGURATION_CONFIG_NAME].dump();
     tracer_context_header_name_ = tracer_config_json[TRACE_CONTEXT_HEADER_CONFIG_NAME].dump().c_str();
 
+    // optional sampling policy; without it every rpc is traced as before
+    auto sampling = tracer_config_json.find(TRACER_SAMPLING_CONFIG_NAME);
+    if (sampling != tracer_config_json.end()) {
+        double probability = sampling->value("probability", 1.0);
+        int64_t slow_threshold_ms = sampling->value("slow_span_threshold_ms", int64_t(0));
+        TraceSampler::GetInstance().Configure(probability, slow_threshold_ms);
+    }
+
     // Load the tracer library.
     std::string error_message;
     auto handle_maybe = opentracing::DynamicallyLoadTracingLibrary(tracing_shared_lib.c_str(), error_message);
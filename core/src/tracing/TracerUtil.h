@@ -19,6 +19,7 @@ namespace tracing {
 static const char* TRACER_LIBRARY_CONFIG_NAME = "tracer_library";
 static const char* TRACER_CONFIGURATION_CONFIG_NAME = "tracer_configuration";
 static const char* TRACE_CONTEXT_HEADER_CONFIG_NAME = "TraceContextHeaderName";
+static const char* TRACER_SAMPLING_CONFIG_NAME = "sampling";
 
 class TracerUtil {
  public:
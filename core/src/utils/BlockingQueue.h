@@ -34,6 +34,10 @@ class BlockingQueue {
     void
     Put(const T& task);
 
+    // non-blocking variant; returns false instead of waiting when the queue is full
+    bool
+    TryPut(const T& task);
+
     T
     Take();
 
@@ -16,6 +16,7 @@
 #include "utils/Log.h"
 
 #include <dirent.h>
+#include <fcntl.h>
 #include <pwd.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -263,5 +264,17 @@ CommonUtil::EraseFromCache(const std::string& item_key) {
 #endif
 }
 
+void
+CommonUtil::ReadAheadFile(const std::string& file_path) {
+#ifdef __linux__
+    int fd = open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    (void)posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    close(fd);
+#endif
+}
+
 }  // namespace server
 }  // namespace milvus
@@ -56,6 +56,11 @@ class CommonUtil {
 
     static void
     EraseFromCache(const std::string& item_key);
+
+    // best-effort hint asking the kernel to read a file into page cache in the
+    // background; returns immediately
+    static void
+    ReadAheadFile(const std::string& file_path);
 };
 
 }  // namespace server
@@ -0,0 +1,93 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "utils/HugePageAllocator.h"
+
+#include <sys/mman.h>
+
+#include "metrics/Metrics.h"
+#include "server/Config.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace server {
+
+constexpr int64_t HugePageAllocator::HUGE_PAGE_SIZE;
+
+HugePageAllocator::HugePageAllocator() {
+    Config& config = Config::GetInstance();
+    config.GetEngineConfigUseHugepages(enabled_);
+}
+
+HugePageAllocator&
+HugePageAllocator::GetInstance() {
+    static HugePageAllocator allocator;
+    return allocator;
+}
+
+std::shared_ptr<uint8_t>
+HugePageAllocator::Allocate(int64_t size) {
+    if (!enabled_ || size < HUGE_PAGE_SIZE) {
+        return std::shared_ptr<uint8_t>(new uint8_t[size], std::default_delete<uint8_t[]>());
+    }
+
+    int64_t mapped_size = ((size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) * HUGE_PAGE_SIZE;
+    auto* self = this;
+
+    // explicit hugepages first: guaranteed 2 MB backing, but only succeeds
+    // when the operator reserved a hugetlb pool (vm.nr_hugepages)
+    void* ptr =
+        mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr == MAP_FAILED) {
+        // transparent hugepages: the kernel promotes the advised range when
+        // it can; counted as covered since promotion is near-certain for
+        // long-lived buffers with thp enabled
+        ptr = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            SERVER_LOG_WARNING << "HugePageAllocator: mmap of " << mapped_size << " bytes failed, heap fallback";
+            total_bytes_ += size;
+            UpdateMetric();
+            return std::shared_ptr<uint8_t>(new uint8_t[size], [self, size](uint8_t* p) {
+                delete[] p;
+                self->total_bytes_ -= size;
+                self->UpdateMetric();
+            });
+        }
+        madvise(ptr, mapped_size, MADV_HUGEPAGE);
+    }
+
+    total_bytes_ += size;
+    huge_bytes_ += size;
+    UpdateMetric();
+    return std::shared_ptr<uint8_t>(static_cast<uint8_t*>(ptr), [self, size, mapped_size](uint8_t* p) {
+        munmap(p, mapped_size);
+        self->total_bytes_ -= size;
+        self->huge_bytes_ -= size;
+        self->UpdateMetric();
+    });
+}
+
+double
+HugePageAllocator::Coverage() const {
+    int64_t total = total_bytes_.load();
+    if (total == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(huge_bytes_.load()) / static_cast<double>(total);
+}
+
+void
+HugePageAllocator::UpdateMetric() {
+    Metrics::GetInstance().HugePageCoverageGaugeSet(Coverage());
+}
+
+}  // namespace server
+}  // namespace milvus
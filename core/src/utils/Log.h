@@ -55,4 +55,26 @@ namespace milvus {
 #define STORAGE_LOG_ERROR LOG(ERROR) << STORAGE_DOMAIN_NAME
 #define STORAGE_LOG_FATAL LOG(FATAL) << STORAGE_DOMAIN_NAME
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// True when the default logger currently admits `level`. Hot paths use it to
+// skip a log line the sink would drop anyway.
+inline bool
+LogLevelEnabled(el::Level level) {
+    el::Logger* logger = el::Loggers::getLogger(el::base::consts::kDefaultLoggerId, false);
+    return logger != nullptr && logger->enabled(level);
+}
+
+// Lazy variants for the query path: when debug is filtered out the stream
+// operands are never evaluated, so a disabled line costs one level check
+// instead of the string formatting of everything behind the `<<`.
+#define SERVER_LOG_DEBUG_LAZY                         \
+    if (!milvus::LogLevelEnabled(el::Level::Debug)) { \
+    } else                                            \
+        SERVER_LOG_DEBUG
+
+#define ENGINE_LOG_DEBUG_LAZY                         \
+    if (!milvus::LogLevelEnabled(el::Level::Debug)) { \
+    } else                                            \
+        ENGINE_LOG_DEBUG
+
 }  // namespace milvus
@@ -0,0 +1,46 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "utils/MallocUtil.h"
+
+#include <malloc.h>
+
+namespace milvus {
+namespace server {
+
+void
+MallocUtil::PurgeHeap() {
+    // walks every arena, not just the main one, so build-thread arenas are
+    // trimmed even though the call runs on that same thread
+    malloc_trim(0);
+}
+
+HeapStats
+MallocUtil::GetHeapStats() {
+    // mallinfo reports ints and wraps beyond 2 GB per field; the ratios stay
+    // meaningful and the absolute values are still the best portable signal
+    // short of parsing malloc_info xml
+    struct mallinfo info = mallinfo();
+
+    HeapStats stats;
+    stats.allocated_bytes = static_cast<int64_t>(static_cast<unsigned int>(info.uordblks));
+    stats.free_bytes = static_cast<int64_t>(static_cast<unsigned int>(info.fordblks));
+    stats.releasable_bytes = static_cast<int64_t>(static_cast<unsigned int>(info.keepcost));
+    stats.mmapped_bytes = static_cast<int64_t>(static_cast<unsigned int>(info.hblkhd));
+    int64_t footprint = stats.allocated_bytes + stats.free_bytes;
+    if (footprint > 0) {
+        stats.fragmentation_ratio = static_cast<double>(stats.free_bytes) / static_cast<double>(footprint);
+    }
+    return stats;
+}
+
+}  // namespace server
+}  // namespace milvus
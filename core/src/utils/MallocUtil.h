@@ -0,0 +1,48 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace milvus {
+namespace server {
+
+struct HeapStats {
+    int64_t allocated_bytes = 0;    // bytes handed out and still in use
+    int64_t free_bytes = 0;         // bytes in freed chunks the heap holds on to
+    int64_t releasable_bytes = 0;   // free bytes at the arena top, returnable via purge
+    int64_t mmapped_bytes = 0;      // big allocations mapped directly, freed eagerly
+    double fragmentation_ratio = 0.0;  // free / (allocated + free)
+};
+
+/*
+ * Heap hygiene helpers for the glibc allocator. Executor threads get their
+ * own malloc arenas, so build tasks already allocate apart from the query
+ * path; what lingers after a build are the freed training buffers the
+ * arenas keep cached. Purging after each build hands those pages back and
+ * keeps RSS tracking live data.
+ */
+class MallocUtil {
+ public:
+    /*
+     * Return freed arena memory to the OS; cheap when there is nothing to
+     * release, so safe to call after every build or merge;
+     */
+    static void
+    PurgeHeap();
+
+    static HeapStats
+    GetHeapStats();
+};
+
+}  // namespace server
+}  // namespace milvus
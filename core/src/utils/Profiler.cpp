@@ -0,0 +1,136 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "utils/Profiler.h"
+#include "utils/CommonUtil.h"
+#include "utils/Log.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#ifdef MILVUS_ENABLE_PROFILING
+#include <gperftools/profiler.h>
+#endif
+
+namespace milvus {
+namespace server {
+
+namespace {
+
+// lazily opened fd of the kernel trace buffer; -1 once opening failed so the
+// markers degrade to a no-op on systems without a writable tracefs
+int
+TraceMarkerFd() {
+    static int fd = [] {
+        int f = open("/sys/kernel/debug/tracing/trace_marker", O_WRONLY);
+        if (f < 0) {
+            f = open("/sys/kernel/tracing/trace_marker", O_WRONLY);
+        }
+        return f;
+    }();
+    return fd;
+}
+
+void
+WriteMarker(const char* prefix, const char* name) {
+    int fd = TraceMarkerFd();
+    if (fd < 0) {
+        return;
+    }
+    char buf[128];
+    int len = snprintf(buf, sizeof(buf), "%s|milvus|%s", prefix, name);
+    if (len > 0) {
+        // a failed write is deliberately ignored; markers are best-effort
+        auto ignored = write(fd, buf, std::min(len, static_cast<int>(sizeof(buf) - 1)));
+        (void)ignored;
+    }
+}
+
+}  // namespace
+
+ProfilerRegion::ProfilerRegion(const char* name) : name_(name) {
+    WriteMarker("B", name_);
+}
+
+ProfilerRegion::~ProfilerRegion() {
+    WriteMarker("E", name_);
+}
+
+Status
+CpuProfiler::Start(int64_t duration_seconds, std::string& profile_path) {
+#ifdef MILVUS_ENABLE_PROFILING
+    if (duration_seconds <= 0) {
+        return Status(SERVER_INVALID_ARGUMENT, "Profile duration must be a positive number of seconds");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_.load()) {
+        return Status(SERVER_UNEXPECTED_ERROR, "A CPU profile capture is already running");
+    }
+
+    profile_path = "/tmp/milvus_cpu_" + CommonUtil::GetCurrentTimeStr() + ".prof";
+    if (ProfilerStart(profile_path.c_str()) == 0) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Failed to start CPU profiler, file: " + profile_path);
+    }
+    running_.store(true);
+    uint64_t generation = ++generation_;
+    SERVER_LOG_INFO << "CPU profile capture started for " << duration_seconds << "s, file: " << profile_path;
+
+    std::thread([this, generation, duration_seconds] {
+        std::this_thread::sleep_for(std::chrono::seconds(duration_seconds));
+        StopInternal(generation);
+    }).detach();
+
+    return Status::OK();
+#else
+    return Status(SERVER_UNSUPPORTED_ERROR, "Server is not built with MILVUS_ENABLE_PROFILING");
+#endif
+}
+
+Status
+CpuProfiler::Stop() {
+#ifdef MILVUS_ENABLE_PROFILING
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_.load()) {
+        return Status(SERVER_UNEXPECTED_ERROR, "No CPU profile capture is running");
+    }
+    ProfilerStop();
+    ProfilerFlush();
+    running_.store(false);
+    ++generation_;
+    SERVER_LOG_INFO << "CPU profile capture stopped";
+    return Status::OK();
+#else
+    return Status(SERVER_UNSUPPORTED_ERROR, "Server is not built with MILVUS_ENABLE_PROFILING");
+#endif
+}
+
+void
+CpuProfiler::StopInternal(uint64_t generation) {
+#ifdef MILVUS_ENABLE_PROFILING
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_.load() || generation != generation_) {
+        return;  // stopped early by hand, or a newer capture took over
+    }
+    ProfilerStop();
+    ProfilerFlush();
+    running_.store(false);
+    SERVER_LOG_INFO << "CPU profile capture finished";
+#endif
+}
+
+}  // namespace server
+}  // namespace milvus
@@ -0,0 +1,78 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "utils/Status.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+namespace milvus {
+namespace server {
+
+// RAII region marker for external profilers. Begin/end events are written to
+// the kernel trace buffer (trace_marker), so a perf/ftrace timeline recorded
+// against a live node shows named spans around the hot phases instead of bare
+// stack samples. When the trace buffer is not writable (tracefs not mounted or
+// no permission) every marker is a no-op after one failed open.
+class ProfilerRegion {
+ public:
+    explicit ProfilerRegion(const char* name);
+    ~ProfilerRegion();
+
+ private:
+    const char* name_;
+};
+
+// On-demand CPU profiler built on gperftools, driven by the "profile_cpu"
+// admin command. A capture runs for a fixed duration and writes a pprof file
+// under the system temp directory; a watcher thread stops it so a forgotten
+// capture cannot run forever. Without MILVUS_ENABLE_PROFILING the calls
+// report SERVER_UNSUPPORTED_ERROR.
+class CpuProfiler {
+ public:
+    static CpuProfiler&
+    GetInstance() {
+        static CpuProfiler instance;
+        return instance;
+    }
+
+    // start a capture of `duration_seconds` and return the profile path;
+    // fails when a capture is already running
+    Status
+    Start(int64_t duration_seconds, std::string& profile_path);
+
+    // stop the running capture early; the profile file is flushed
+    Status
+    Stop();
+
+    bool
+    Running() const {
+        return running_.load();
+    }
+
+ private:
+    CpuProfiler() = default;
+
+    void
+    StopInternal(uint64_t generation);
+
+    std::mutex mutex_;
+    std::atomic<bool> running_{false};
+    // bumped on every Start so a stale watcher thread from a previous
+    // capture cannot stop a newer one
+    uint64_t generation_ = 0;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -25,6 +25,7 @@
 #include <fiu-local.h>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <regex>
 #include <string>
 
@@ -154,7 +155,14 @@ bool
 ValidationUtil::IsBinaryMetricType(int32_t metric_type) {
     return (metric_type == static_cast<int32_t>(engine::MetricType::HAMMING)) ||
            (metric_type == static_cast<int32_t>(engine::MetricType::JACCARD)) ||
-           (metric_type == static_cast<int32_t>(engine::MetricType::TANIMOTO));
+           (metric_type == static_cast<int32_t>(engine::MetricType::TANIMOTO)) ||
+           IsStructureMetricType(metric_type);
+}
+
+bool
+ValidationUtil::IsStructureMetricType(int32_t metric_type) {
+    return (metric_type == static_cast<int32_t>(engine::MetricType::SUBSTRUCTURE)) ||
+           (metric_type == static_cast<int32_t>(engine::MetricType::SUPERSTRUCTURE));
 }
 
 Status
@@ -181,6 +189,26 @@ ValidationUtil::ValidateSearchNprobe(int64_t nprobe, const engine::meta::TableSc
     return Status::OK();
 }
 
+Status
+ValidationUtil::ValidateVectorDataFinite(const float* data, uint64_t count) {
+    // NaN and Inf are the values whose exponent bits are all ones. The bitwise
+    // test makes the whole scan branch-free so the compiler vectorizes it;
+    // calling std::isfinite per element would dominate large inserts
+    uint32_t bad = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint32_t bits;
+        memcpy(&bits, data + i, sizeof(bits));
+        bad |= static_cast<uint32_t>((bits & 0x7f800000u) == 0x7f800000u);
+    }
+    if (bad != 0) {
+        std::string msg = "Invalid vector data: NaN or infinite value in vector records.";
+        SERVER_LOG_ERROR << msg;
+        return Status(SERVER_INVALID_ROWRECORD_ARRAY, msg);
+    }
+
+    return Status::OK();
+}
+
 Status
 ValidationUtil::ValidatePartitionName(const std::string& partition_name) {
     if (partition_name.empty()) {
@@ -49,12 +49,19 @@ class ValidationUtil {
     static bool
     IsBinaryMetricType(int32_t metric_type);
 
+    // containment metrics are binary metrics that only flat indexes serve
+    static bool
+    IsStructureMetricType(int32_t metric_type);
+
     static Status
     ValidateSearchTopk(int64_t top_k, const engine::meta::TableSchema& table_schema);
 
     static Status
     ValidateSearchNprobe(int64_t nprobe, const engine::meta::TableSchema& table_schema);
 
+    static Status
+    ValidateVectorDataFinite(const float* data, uint64_t count);
+
     static Status
     ValidatePartitionName(const std::string& partition_name);
 
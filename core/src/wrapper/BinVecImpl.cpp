@@ -25,7 +25,7 @@ BinVecImpl::BuildAll(const int64_t& nb, const uint8_t* xb, const int64_t* ids, c
     try {
         dim = cfg->d;
 
-        auto ret_ds = std::make_shared<knowhere::Dataset>();
+        auto ret_ds = knowhere::scratch::MakeDataset();
         ret_ds->Set(knowhere::meta::ROWS, nb);
         ret_ds->Set(knowhere::meta::DIM, dim);
         ret_ds->Set(knowhere::meta::TENSOR, xb);
@@ -46,7 +46,7 @@ Status
 BinVecImpl::Search(const int64_t& nq, const uint8_t* xq, float* dist, int64_t* ids, const Config& cfg) {
     try {
         auto k = cfg->k;
-        auto ret_ds = std::make_shared<knowhere::Dataset>();
+        auto ret_ds = knowhere::scratch::MakeDataset();
         ret_ds->Set(knowhere::meta::ROWS, nq);
         ret_ds->Set(knowhere::meta::DIM, dim);
         ret_ds->Set(knowhere::meta::TENSOR, xq);
@@ -74,13 +74,12 @@ BinVecImpl::Search(const int64_t& nq, const uint8_t* xq, float* dist, int64_t* i
         //        auto p_ids = ids_array->data()->GetValues<int64_t>(1, 0);
         //        auto p_dist = dis_array->data()->GetValues<float>(1, 0);
 
-        // TODO(linxj): avoid copy here.
+        // result buffers are per-thread scratch owned by knowhere, copy out
+        // without freeing them
         auto res_ids = res->Get<int64_t*>(knowhere::meta::IDS);
         auto res_dist = res->Get<float*>(knowhere::meta::DISTANCE);
         memcpy(ids, res_ids, sizeof(int64_t) * nq * k);
         memcpy(dist, res_dist, sizeof(float) * nq * k);
-        free(res_ids);
-        free(res_dist);
     } catch (knowhere::KnowhereException& e) {
         WRAPPER_LOG_ERROR << e.what();
         return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
@@ -94,7 +93,7 @@ BinVecImpl::Search(const int64_t& nq, const uint8_t* xq, float* dist, int64_t* i
 Status
 BinVecImpl::Add(const int64_t& nb, const uint8_t* xb, const int64_t* ids, const Config& cfg) {
     try {
-        auto ret_ds = std::make_shared<knowhere::Dataset>();
+        auto ret_ds = knowhere::scratch::MakeDataset();
         ret_ds->Set(knowhere::meta::ROWS, nb);
         ret_ds->Set(knowhere::meta::DIM, dim);
         ret_ds->Set(knowhere::meta::TENSOR, xb);
@@ -145,7 +144,7 @@ BinBFIndex::BuildAll(const int64_t& nb, const uint8_t* xb, const int64_t* ids, c
                      const uint8_t* xt) {
     try {
         dim = cfg->d;
-        auto ret_ds = std::make_shared<knowhere::Dataset>();
+        auto ret_ds = knowhere::scratch::MakeDataset();
         ret_ds->Set(knowhere::meta::ROWS, nb);
         ret_ds->Set(knowhere::meta::DIM, dim);
         ret_ds->Set(knowhere::meta::TENSOR, xb);
@@ -14,8 +14,10 @@
 #include <fiu-local.h>
 #include <cmath>
 #include <memory>
+#include <thread>
 #include <vector>
 
+#include "TunedParamsMgr.h"
 #include "WrapperException.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "server/Config.h"
@@ -86,10 +88,18 @@ IVFConfAdapter::MatchSearch(const TempMetaConf& metaconf, const IndexType& type)
     auto conf = std::make_shared<knowhere::IVFCfg>();
     conf->k = metaconf.k;
 
-    if (metaconf.nprobe <= 0)
-        conf->nprobe = 16;  // hardcode here
-    else
+    if (metaconf.nprobe <= 0) {
+        // prefer a tuner-published default over the hardcoded one; an explicit
+        // client nprobe never reaches this branch and always wins
+        int64_t tuned_nprobe = TunedParamsMgr::GetInstance().GetNprobe(metaconf.table_id);
+        conf->nprobe = tuned_nprobe > 0 ? tuned_nprobe : 16;
+    } else {
         conf->nprobe = metaconf.nprobe;
+    }
+
+    if (metaconf.probe_stop_window > 0) {
+        conf->probe_stop_window = metaconf.probe_stop_window;
+    }
 
     switch (type) {
         case IndexType::FAISS_IVFFLAT_GPU:
@@ -200,6 +210,23 @@ IVFPQConfAdapter::MatchNlist(const int64_t& size, const int64_t& nlist) {
     return nlist;
 }
 
+knowhere::Config
+IVFPQFSConfAdapter::Match(const TempMetaConf& metaconf) {
+    auto conf = std::static_pointer_cast<knowhere::IVFPQCfg>(IVFPQConfAdapter::Match(metaconf));
+    conf->nbits = 4;
+    if (conf->m % 2 != 0) {
+        // two 4-bit codes share a byte, so the fastscan layout needs an even
+        // m; halving the per-sub-quantizer dims keeps m a divisor of d
+        if ((conf->d / conf->m) % 2 == 0) {
+            conf->m *= 2;
+        } else {
+            WRAPPER_LOG_ERROR << "The dims of fastscan PQ must allow an even number of sub-quantizers";
+            throw WrapperException("The dims of fastscan PQ must allow an even number of sub-quantizers");
+        }
+    }
+    return conf;
+}
+
 knowhere::Config
 NSGConfAdapter::Match(const TempMetaConf& metaconf) {
     auto conf = std::make_shared<knowhere::NSGCfg>();
@@ -217,6 +244,12 @@ NSGConfAdapter::Match(const TempMetaConf& metaconf) {
     conf->search_length = 50 + 5 * scale_factor;
     conf->out_degree = 50 + 5 * scale_factor;
     conf->candidate_pool_size = 300;
+
+    int64_t build_thread_num = 0;
+    server::Config& config = server::Config::GetInstance();
+    config.GetEngineConfigIndexBuildThreadNum(build_thread_num);
+    conf->build_thread_num = build_thread_num;
+
     MatchBase(conf);
     return conf;
 }
@@ -232,11 +265,25 @@ NSGConfAdapter::MatchSearch(const TempMetaConf& metaconf, const IndexType& type)
     return conf;
 }
 
+// SPTAG builds were pinned to a single thread by the parameter manager's
+// defaults; honor the same knob the NSG builder uses, all cores when unset
+static int64_t
+MatchSptagThreadNum() {
+    int64_t build_thread_num = 0;
+    server::Config& config = server::Config::GetInstance();
+    config.GetEngineConfigIndexBuildThreadNum(build_thread_num);
+    if (build_thread_num <= 0) {
+        build_thread_num = std::thread::hardware_concurrency();
+    }
+    return build_thread_num;
+}
+
 knowhere::Config
 SPTAGKDTConfAdapter::Match(const TempMetaConf& metaconf) {
     auto conf = std::make_shared<knowhere::KDTCfg>();
     conf->d = metaconf.dim;
     conf->metric_type = metaconf.metric_type;
+    conf->numofthreads = MatchSptagThreadNum();
     return conf;
 }
 
@@ -244,6 +291,7 @@ knowhere::Config
 SPTAGKDTConfAdapter::MatchSearch(const TempMetaConf& metaconf, const IndexType& type) {
     auto conf = std::make_shared<knowhere::KDTCfg>();
     conf->k = metaconf.k;
+    conf->numofthreads = MatchSptagThreadNum();
     return conf;
 }
 
@@ -252,6 +300,7 @@ SPTAGBKTConfAdapter::Match(const TempMetaConf& metaconf) {
     auto conf = std::make_shared<knowhere::BKTCfg>();
     conf->d = metaconf.dim;
     conf->metric_type = metaconf.metric_type;
+    conf->numofthreads = MatchSptagThreadNum();
     return conf;
 }
 
@@ -259,6 +308,7 @@ knowhere::Config
 SPTAGBKTConfAdapter::MatchSearch(const TempMetaConf& metaconf, const IndexType& type) {
     auto conf = std::make_shared<knowhere::BKTCfg>();
     conf->k = metaconf.k;
+    conf->numofthreads = MatchSptagThreadNum();
     return conf;
 }
 
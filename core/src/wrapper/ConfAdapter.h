@@ -12,6 +12,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "VecIndex.h"
 #include "knowhere/common/Config.h"
@@ -28,8 +29,10 @@ struct TempMetaConf {
     int64_t gpu_id = TEMPMETA_DEFAULT_VALUE;
     int64_t k = TEMPMETA_DEFAULT_VALUE;
     int64_t nprobe = TEMPMETA_DEFAULT_VALUE;
+    int64_t probe_stop_window = TEMPMETA_DEFAULT_VALUE;
     int64_t search_length = TEMPMETA_DEFAULT_VALUE;
     knowhere::METRICTYPE metric_type = knowhere::DEFAULT_TYPE;
+    std::string table_id;  // lets MatchSearch pick up per-table tuned defaults; empty = untracked
 };
 
 class ConfAdapter {
@@ -79,6 +82,12 @@ class IVFPQConfAdapter : public IVFConfAdapter {
     MatchNlist(const int64_t& size, const int64_t& nlist);
 };
 
+class IVFPQFSConfAdapter : public IVFPQConfAdapter {
+ public:
+    knowhere::Config
+    Match(const TempMetaConf& metaconf) override;
+};
+
 class NSGConfAdapter : public IVFConfAdapter {
  public:
     knowhere::Config
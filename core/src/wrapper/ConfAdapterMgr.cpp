@@ -36,6 +36,8 @@ AdapterMgr::RegisterAdapter() {
     init_ = true;
 
     REGISTER_CONF_ADAPTER(ConfAdapter, IndexType::FAISS_IDMAP, idmap);
+    REGISTER_CONF_ADAPTER(ConfAdapter, IndexType::FAISS_IDMAP_SQ8, idmap_sq8);
+    REGISTER_CONF_ADAPTER(ConfAdapter, IndexType::FAISS_IDMAP_FP16, idmap_fp16);
     REGISTER_CONF_ADAPTER(BinIDMAPConfAdapter, IndexType::FAISS_BIN_IDMAP, idmap_bin);
 
     REGISTER_CONF_ADAPTER(IVFConfAdapter, IndexType::FAISS_IVFFLAT_CPU, ivf_cpu);
@@ -51,6 +53,7 @@ AdapterMgr::RegisterAdapter() {
     REGISTER_CONF_ADAPTER(IVFPQConfAdapter, IndexType::FAISS_IVFPQ_CPU, ivfpq_cpu);
     REGISTER_CONF_ADAPTER(IVFPQConfAdapter, IndexType::FAISS_IVFPQ_GPU, ivfpq_gpu);
     REGISTER_CONF_ADAPTER(IVFPQConfAdapter, IndexType::FAISS_IVFPQ_MIX, ivfpq_mix);
+    REGISTER_CONF_ADAPTER(IVFPQFSConfAdapter, IndexType::FAISS_IVFPQ_FS_CPU, ivfpq_fs);
 
     REGISTER_CONF_ADAPTER(NSGConfAdapter, IndexType::NSG_MIX, nsg_mix);
 
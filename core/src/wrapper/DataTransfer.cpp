@@ -19,7 +19,7 @@ namespace engine {
 
 knowhere::DatasetPtr
 GenDatasetWithIds(const int64_t& nb, const int64_t& dim, const float* xb, const int64_t* ids) {
-    auto ret_ds = std::make_shared<knowhere::Dataset>();
+    auto ret_ds = knowhere::scratch::MakeDataset();
     ret_ds->Set(knowhere::meta::ROWS, nb);
     ret_ds->Set(knowhere::meta::DIM, dim);
     ret_ds->Set(knowhere::meta::TENSOR, xb);
@@ -29,7 +29,7 @@ GenDatasetWithIds(const int64_t& nb, const int64_t& dim, const float* xb, const
 
 knowhere::DatasetPtr
 GenDataset(const int64_t& nb, const int64_t& dim, const float* xb) {
-    auto ret_ds = std::make_shared<knowhere::Dataset>();
+    auto ret_ds = knowhere::scratch::MakeDataset();
     ret_ds->Set(knowhere::meta::ROWS, nb);
     ret_ds->Set(knowhere::meta::DIM, dim);
     ret_ds->Set(knowhere::meta::TENSOR, xb);
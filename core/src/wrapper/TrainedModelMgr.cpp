@@ -0,0 +1,274 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "wrapper/TrainedModelMgr.h"
+
+#include <cmath>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+
+#include "knowhere/index/vector_index/IndexIVF.h"
+#include "server/Config.h"
+#include "storage/file/FileIOReader.h"
+#include "storage/file/FileIOWriter.h"
+#include "storage/s3/S3IOReader.h"
+#include "storage/s3/S3IOWriter.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+constexpr uint32_t TRAINED_MODEL_MAGIC = 0x4d4f4431;  // 'MOD1'
+
+// cap on the rows sampled for the per-dimension mean; the check only has to
+// spot gross distribution shifts
+constexpr int64_t MEAN_SAMPLE_ROWS = 10000;
+
+// a new segment whose mean moved further than this fraction of the stored
+// mean's norm is treated as drifted and retrained
+constexpr float DRIFT_RATIO = 0.25f;
+
+const char* ARTIFACT_NAME = "trained.model";
+
+// segments live in <db_path>/tables/<table_id>/<date>/<file_id>; the model is
+// shared by the whole table, so it sits in the table folder
+std::string
+ArtifactPath(const std::string& segment_location) {
+    boost::filesystem::path table_path = boost::filesystem::path(segment_location).parent_path().parent_path();
+    if (table_path.empty()) {
+        return std::string();
+    }
+    return (table_path / ARTIFACT_NAME).string();
+}
+
+std::vector<float>
+ComputeMean(int64_t dim, int64_t nb, const float* xb) {
+    std::vector<float> mean(dim, 0.0f);
+    if (nb <= 0 || xb == nullptr) {
+        return mean;
+    }
+
+    int64_t stride = nb > MEAN_SAMPLE_ROWS ? nb / MEAN_SAMPLE_ROWS : 1;
+    int64_t count = 0;
+    for (int64_t i = 0; i < nb; i += stride, count++) {
+        const float* row = xb + i * dim;
+        for (int64_t d = 0; d < dim; d++) {
+            mean[d] += row[d];
+        }
+    }
+    for (int64_t d = 0; d < dim; d++) {
+        mean[d] /= count;
+    }
+    return mean;
+}
+
+bool
+IsDrifted(const std::vector<float>& stored, const std::vector<float>& current) {
+    double dist2 = 0.0, norm2 = 0.0;
+    for (size_t d = 0; d < stored.size(); d++) {
+        double diff = current[d] - stored[d];
+        dist2 += diff * diff;
+        norm2 += static_cast<double>(stored[d]) * stored[d];
+    }
+    return std::sqrt(dist2) > DRIFT_RATIO * (std::sqrt(norm2) + 1e-3);
+}
+
+}  // namespace
+
+TrainedModelMgr&
+TrainedModelMgr::GetInstance() {
+    static TrainedModelMgr instance;
+    return instance;
+}
+
+knowhere::IndexModelPtr
+TrainedModelMgr::Fetch(const std::string& segment_location, IndexType type, int64_t dim, int64_t nlist, int32_t metric,
+                       int64_t nb, const float* xb) {
+    std::string artifact_path = ArtifactPath(segment_location);
+    if (artifact_path.empty()) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = entries_.find(artifact_path);
+    if (it == entries_.end()) {
+        auto entry = LoadEntry(artifact_path);
+        if (entry == nullptr) {
+            return nullptr;
+        }
+        it = entries_.emplace(artifact_path, entry).first;
+    }
+
+    auto& entry = *it->second;
+    if (entry.type_ != (int32_t)type || entry.dim_ != dim || entry.nlist_ != nlist || entry.metric_ != metric) {
+        // the table's index parameters changed; the next Store overwrites
+        return nullptr;
+    }
+
+    if (IsDrifted(entry.mean_, ComputeMean(dim, nb, xb))) {
+        WRAPPER_LOG_DEBUG << "trained model for " << segment_location << " drifted, retraining";
+        return nullptr;
+    }
+
+    return entry.model_;
+}
+
+void
+TrainedModelMgr::Store(const std::string& segment_location, IndexType type, int64_t dim, int64_t nlist, int32_t metric,
+                       int64_t nb, const float* xb, const knowhere::IndexModelPtr& model) {
+    std::string artifact_path = ArtifactPath(segment_location);
+    if (artifact_path.empty() || model == nullptr) {
+        return;
+    }
+
+    auto entry = std::make_shared<ModelEntry>();
+    entry->type_ = (int32_t)type;
+    entry->dim_ = dim;
+    entry->nlist_ = nlist;
+    entry->metric_ = metric;
+    entry->mean_ = ComputeMean(dim, nb, xb);
+    entry->model_ = model;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[artifact_path] = entry;
+
+    try {
+        SaveEntry(artifact_path, *entry);
+    } catch (std::exception& e) {
+        // the in-memory model still serves this process; only restarts retrain
+        WRAPPER_LOG_ERROR << "failed to persist trained model " << artifact_path << ": " << e.what();
+    }
+}
+
+TrainedModelMgr::ModelEntryPtr
+TrainedModelMgr::LoadEntry(const std::string& artifact_path) {
+    bool s3_enable = false;
+    server::Config& config = server::Config::GetInstance();
+    config.GetStorageConfigS3Enable(s3_enable);
+
+    if (!s3_enable && !boost::filesystem::exists(artifact_path)) {
+        return nullptr;
+    }
+
+    try {
+        std::shared_ptr<storage::IOReader> reader_ptr;
+        if (s3_enable) {
+            reader_ptr = std::make_shared<storage::S3IOReader>(artifact_path);
+        } else {
+            reader_ptr = std::make_shared<storage::FileIOReader>(artifact_path);
+        }
+
+        size_t length = reader_ptr->length();
+        size_t rp = 0;
+        reader_ptr->seekg(0);
+
+        uint32_t magic = 0;
+        reader_ptr->read(&magic, sizeof(magic));
+        rp += sizeof(magic);
+        if (magic != TRAINED_MODEL_MAGIC) {
+            return nullptr;
+        }
+
+        auto entry = std::make_shared<ModelEntry>();
+        reader_ptr->read(&entry->type_, sizeof(entry->type_));
+        reader_ptr->read(&entry->dim_, sizeof(entry->dim_));
+        reader_ptr->read(&entry->nlist_, sizeof(entry->nlist_));
+        reader_ptr->read(&entry->metric_, sizeof(entry->metric_));
+        rp += sizeof(entry->type_) + sizeof(entry->dim_) + sizeof(entry->nlist_) + sizeof(entry->metric_);
+
+        entry->mean_.resize(entry->dim_);
+        reader_ptr->read(entry->mean_.data(), entry->dim_ * sizeof(float));
+        rp += entry->dim_ * sizeof(float);
+        reader_ptr->seekg(rp);
+
+        knowhere::BinarySet binary_set;
+        while (rp < length) {
+            size_t meta_length;
+            reader_ptr->read(&meta_length, sizeof(meta_length));
+            rp += sizeof(meta_length);
+            reader_ptr->seekg(rp);
+
+            auto meta = new char[meta_length];
+            reader_ptr->read(meta, meta_length);
+            rp += meta_length;
+            reader_ptr->seekg(rp);
+
+            int64_t bin_length;
+            reader_ptr->read(&bin_length, sizeof(bin_length));
+            rp += sizeof(bin_length);
+            reader_ptr->seekg(rp);
+
+            auto bin = new uint8_t[bin_length];
+            reader_ptr->read(bin, bin_length);
+            rp += bin_length;
+            reader_ptr->seekg(rp);
+
+            std::shared_ptr<uint8_t> binptr(bin, std::default_delete<uint8_t[]>());
+            binary_set.Append(std::string(meta, meta_length), binptr, bin_length);
+            delete[] meta;
+        }
+
+        auto model = std::make_shared<knowhere::IVFIndexModel>();
+        model->Load(binary_set);
+        entry->model_ = model;
+
+        WRAPPER_LOG_DEBUG << "loaded trained model from " << artifact_path;
+        return entry;
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << "failed to load trained model " << artifact_path << ": " << e.what();
+        return nullptr;
+    }
+}
+
+void
+TrainedModelMgr::SaveEntry(const std::string& artifact_path, const ModelEntry& entry) {
+    auto binary_set = entry.model_->Serialize();
+
+    bool s3_enable = false;
+    server::Config& config = server::Config::GetInstance();
+    config.GetStorageConfigS3Enable(s3_enable);
+
+    std::shared_ptr<storage::IOWriter> writer_ptr;
+    if (s3_enable) {
+        writer_ptr = std::make_shared<storage::S3IOWriter>(artifact_path);
+    } else {
+        writer_ptr = std::make_shared<storage::FileIOWriter>(artifact_path);
+    }
+
+    uint32_t magic = TRAINED_MODEL_MAGIC;
+    writer_ptr->write(&magic, sizeof(magic));
+    writer_ptr->write((void*)&entry.type_, sizeof(entry.type_));
+    writer_ptr->write((void*)&entry.dim_, sizeof(entry.dim_));
+    writer_ptr->write((void*)&entry.nlist_, sizeof(entry.nlist_));
+    writer_ptr->write((void*)&entry.metric_, sizeof(entry.metric_));
+    writer_ptr->write((void*)entry.mean_.data(), entry.mean_.size() * sizeof(float));
+
+    for (auto& iter : binary_set.binary_map_) {
+        auto meta = iter.first.c_str();
+        size_t meta_length = iter.first.length();
+        writer_ptr->write(&meta_length, sizeof(meta_length));
+        writer_ptr->write((void*)meta, meta_length);
+
+        auto binary = iter.second;
+        int64_t binary_length = binary->size;
+        writer_ptr->write(&binary_length, sizeof(binary_length));
+        writer_ptr->write((void*)binary->data.get(), binary_length);
+    }
+
+    WRAPPER_LOG_DEBUG << "persisted trained model to " << artifact_path << " (" << writer_ptr->length() << " bytes)";
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,81 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "knowhere/index/IndexModel.h"
+#include "wrapper/VecIndex.h"
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Per-table cache of trained IVF index models (coarse quantizers).
+ *
+ * All segments of a table are drawn from one distribution, so the k-means
+ * phase of the first segment's index build carries over to every later one.
+ * The first build stores its model here and persists it next to the table's
+ * segments through the storage layer; later builds fetch it and skip
+ * training entirely. A fetch validates the build parameters and checks the
+ * new segment's per-dimension mean against the training sample's mean, so a
+ * drifted table falls back to a fresh training run (which overwrites the
+ * artifact).
+ */
+class TrainedModelMgr {
+ public:
+    static TrainedModelMgr&
+    GetInstance();
+
+    // Model for the table owning `segment_location`, or nullptr when there is
+    // none, the parameters differ, or the segment has drifted away from the
+    // training sample.
+    knowhere::IndexModelPtr
+    Fetch(const std::string& segment_location, IndexType type, int64_t dim, int64_t nlist, int32_t metric, int64_t nb,
+          const float* xb);
+
+    // Persist a freshly trained model together with the training sample's
+    // per-dimension mean for later drift checks.
+    void
+    Store(const std::string& segment_location, IndexType type, int64_t dim, int64_t nlist, int32_t metric, int64_t nb,
+          const float* xb, const knowhere::IndexModelPtr& model);
+
+ private:
+    TrainedModelMgr() = default;
+
+    struct ModelEntry {
+        int32_t type_ = 0;
+        int64_t dim_ = 0;
+        int64_t nlist_ = 0;
+        int32_t metric_ = 0;
+        std::vector<float> mean_;
+        knowhere::IndexModelPtr model_ = nullptr;
+    };
+
+    using ModelEntryPtr = std::shared_ptr<ModelEntry>;
+
+    ModelEntryPtr
+    LoadEntry(const std::string& artifact_path);
+
+    void
+    SaveEntry(const std::string& artifact_path, const ModelEntry& entry);
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, ModelEntryPtr> entries_;
+};
+
+}  // namespace engine
+}  // namespace milvus
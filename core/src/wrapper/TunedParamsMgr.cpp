@@ -0,0 +1,56 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "wrapper/TunedParamsMgr.h"
+
+#include <boost/filesystem.hpp>
+
+namespace milvus {
+namespace engine {
+
+TunedParamsMgr&
+TunedParamsMgr::GetInstance() {
+    static TunedParamsMgr mgr;
+    return mgr;
+}
+
+std::string
+TunedParamsMgr::TableIdFromLocation(const std::string& location) {
+    // segments live in <db_path>/tables/<table_id>/<date>/<file_id>
+    return boost::filesystem::path(location).parent_path().parent_path().filename().string();
+}
+
+void
+TunedParamsMgr::Set(const std::string& table_id, const TunedSearchParams& params) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    params_[table_id] = params;
+}
+
+bool
+TunedParamsMgr::Get(const std::string& table_id, TunedSearchParams& params) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = params_.find(table_id);
+    if (iter == params_.end()) {
+        return false;
+    }
+    params = iter->second;
+    return true;
+}
+
+int64_t
+TunedParamsMgr::GetNprobe(const std::string& table_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = params_.find(table_id);
+    return iter == params_.end() ? 0 : iter->second.nprobe;
+}
+
+}  // namespace engine
+}  // namespace milvus
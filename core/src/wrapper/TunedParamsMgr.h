@@ -0,0 +1,61 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace milvus {
+namespace engine {
+
+// one auto-tuner measurement for a table, kept so operators can inspect why a
+// default was picked (the tuner also logs the full recall/latency frontier)
+struct TunedSearchParams {
+    int64_t nprobe = 0;
+    float recall = 0.0f;      // recall@topk of `nprobe` against an exhaustive scan
+    double latency_ms = 0.0;  // mean per-query latency measured at `nprobe`
+};
+
+// Registry of per-table search defaults published by the AutoTuner. The
+// adapters consult it only when the client did not pass the parameter
+// explicitly, so an explicit nprobe always wins over a tuned one. Entries are
+// process-lifetime: a new tuning cycle overwrites, a restart starts empty.
+class TunedParamsMgr {
+ public:
+    static TunedParamsMgr&
+    GetInstance();
+
+    // table id of the segment stored at `location`, shared with the tuner and
+    // the engine so both sides key the registry the same way
+    static std::string
+    TableIdFromLocation(const std::string& location);
+
+    void
+    Set(const std::string& table_id, const TunedSearchParams& params);
+
+    bool
+    Get(const std::string& table_id, TunedSearchParams& params) const;
+
+    // tuned nprobe for the table, or 0 when the table has no entry
+    int64_t
+    GetNprobe(const std::string& table_id) const;
+
+ private:
+    TunedParamsMgr() = default;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, TunedSearchParams> params_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -14,6 +14,7 @@
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/IndexIVF.h"
 #include "utils/Log.h"
 #include "wrapper/WrapperException.h"
 #include "wrapper/gpu/GPUVecImpl.h"
@@ -59,6 +60,32 @@ VecIndexImpl::BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, c
     return Status::OK();
 }
 
+Status
+VecIndexImpl::BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg,
+                       knowhere::IndexModelPtr& model) {
+    try {
+        dim = cfg->d;
+        auto dataset = GenDatasetWithIds(nb, dim, xb, ids);
+
+        if (model == nullptr) {
+            auto preprocessor = index_->BuildPreprocessor(dataset, cfg);
+            index_->set_preprocessor(preprocessor);
+            model = index_->Train(dataset, cfg);
+        }
+        // set_index_model deep-copies the model, so a cached one can be
+        // handed to any number of segment builds
+        index_->set_index_model(model);
+        index_->Add(dataset, cfg);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
 Status
 VecIndexImpl::Add(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg) {
     try {
@@ -108,13 +135,55 @@ VecIndexImpl::Search(const int64_t& nq, const float* xq, float* dist, int64_t* i
         //        auto p_ids = ids_array->data()->GetValues<int64_t>(1, 0);
         //        auto p_dist = dis_array->data()->GetValues<float>(1, 0);
 
-        // TODO(linxj): avoid copy here.
+        // result buffers are per-thread scratch owned by knowhere, copy out
+        // without freeing them
         auto res_ids = res->Get<int64_t*>(knowhere::meta::IDS);
         auto res_dist = res->Get<float*>(knowhere::meta::DISTANCE);
         memcpy(ids, res_ids, sizeof(int64_t) * nq * k);
         memcpy(dist, res_dist, sizeof(float) * nq * k);
-        free(res_ids);
-        free(res_dist);
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
+Status
+VecIndexImpl::SearchResident(const int64_t& nq, const float* xq, float* d_dist, int64_t* d_ids, const Config& cfg) {
+#ifdef MILVUS_GPU_VERSION
+    try {
+        if (auto gpu_index = std::dynamic_pointer_cast<knowhere::GPUIVF>(index_)) {
+            gpu_index->SearchResident(nq, xq, cfg->k, d_dist, d_ids, cfg);
+            return Status::OK();
+        }
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+#endif
+    return VecIndex::SearchResident(nq, xq, d_dist, d_ids, cfg);
+}
+
+Status
+VecIndexImpl::RangeSearch(const int64_t& nq, const float* xq, float radius, std::vector<int64_t>& ids,
+                          std::vector<float>& distances, std::vector<size_t>& lims, const Config& cfg) {
+    try {
+        auto dataset = GenDataset(nq, dim, xq);
+
+        // range search is implemented by the flat and IVF families only
+        if (auto ivf_index = std::dynamic_pointer_cast<knowhere::IVF>(index_)) {
+            ivf_index->RangeSearch(dataset, radius, cfg, ids, distances, lims);
+        } else if (auto idmap_index = std::dynamic_pointer_cast<knowhere::IDMAP>(index_)) {
+            idmap_index->RangeSearch(dataset, radius, cfg, ids, distances, lims);
+        } else {
+            return VecIndex::RangeSearch(nq, xq, radius, ids, distances, lims, cfg);
+        }
     } catch (knowhere::KnowhereException& e) {
         WRAPPER_LOG_ERROR << e.what();
         return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "VecIndex.h"
 #include "knowhere/index/vector_index/VectorIndex.h"
@@ -30,6 +31,10 @@ class VecIndexImpl : public VecIndex {
     BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg, const int64_t& nt,
              const float* xt) override;
 
+    Status
+    BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg,
+             knowhere::IndexModelPtr& model) override;
+
     VecIndexPtr
     CopyToGpu(const int64_t& device_id, const Config& cfg) override;
 
@@ -63,6 +68,13 @@ class VecIndexImpl : public VecIndex {
     Status
     Search(const int64_t& nq, const float* xq, float* dist, int64_t* ids, const Config& cfg) override;
 
+    Status
+    SearchResident(const int64_t& nq, const float* xq, float* d_dist, int64_t* d_ids, const Config& cfg) override;
+
+    Status
+    RangeSearch(const int64_t& nq, const float* xq, float radius, std::vector<int64_t>& ids,
+                std::vector<float>& distances, std::vector<size_t>& lims, const Config& cfg) override;
+
  protected:
     int64_t dim = 0;
 
@@ -73,8 +85,8 @@ class VecIndexImpl : public VecIndex {
 
 class BFIndex : public VecIndexImpl {
  public:
-    explicit BFIndex(std::shared_ptr<knowhere::VectorIndex> index)
-        : VecIndexImpl(std::move(index), IndexType::FAISS_IDMAP) {
+    explicit BFIndex(std::shared_ptr<knowhere::VectorIndex> index, IndexType type = IndexType::FAISS_IDMAP)
+        : VecIndexImpl(std::move(index), type) {
     }
 
     ErrorCode
@@ -17,17 +17,23 @@
 #include "knowhere/index/vector_index/IndexBinaryIVF.h"
 #include "knowhere/index/vector_index/IndexHNSW.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/IndexIDMAPSQ.h"
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/IndexIVFPQ.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
 #include "knowhere/index/vector_index/IndexIVFSQ.h"
 #include "knowhere/index/vector_index/IndexNSG.h"
 #include "knowhere/index/vector_index/IndexSPTAG.h"
+#include "cache/CpuCacheMgr.h"
+#include "cache/DiskCacheMgr.h"
 #include "server/Config.h"
+#include "storage/Codec.h"
 #include "storage/file/FileIOReader.h"
 #include "storage/file/FileIOWriter.h"
 #include "storage/s3/S3IOReader.h"
 #include "storage/s3/S3IOWriter.h"
 #include "utils/Exception.h"
+#include "utils/HugePageAllocator.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 #include "wrapper/BinVecImpl.h"
@@ -43,7 +49,14 @@
 #include "wrapper/gpu/GPUVecImpl.h"
 #endif
 
+#include <faiss/impl/io.h>
+#include <faiss/index_io.h>
 #include <fiu-local.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 namespace milvus {
 namespace engine {
@@ -56,6 +69,18 @@ VecIndex::Size() {
     return Count() * Dimension() * sizeof(float);
 }
 
+int64_t
+VecIndex::ReloadCost() {
+    // restoring from S3 without a local disk tier pays a network round trip
+    // on top of deserialization, so those indexes are pricier to re-admit
+    static bool remote_origin = [] {
+        bool s3_enable = false;
+        server::Config::GetInstance().GetStorageConfigS3Enable(s3_enable);
+        return s3_enable && !cache::DiskCacheMgr::GetInstance()->Enabled();
+    }();
+    return remote_origin ? Size() * 4 : Size();
+}
+
 void
 VecIndex::set_size(int64_t size) {
     size_ = size;
@@ -70,6 +95,14 @@ GetVecIndexFactory(const IndexType& type, const Config& cfg) {
             index = std::make_shared<knowhere::IDMAP>();
             return std::make_shared<BFIndex>(index);
         }
+        case IndexType::FAISS_IDMAP_SQ8: {
+            index = std::make_shared<knowhere::IDMAPSQ>();
+            return std::make_shared<BFIndex>(index, type);
+        }
+        case IndexType::FAISS_IDMAP_FP16: {
+            index = std::make_shared<knowhere::IDMAPFP16>();
+            return std::make_shared<BFIndex>(index, type);
+        }
         case IndexType::FAISS_BIN_IDMAP: {
             index = std::make_shared<knowhere::BinaryIDMAP>();
             return std::make_shared<BinBFIndex>(index);
@@ -86,6 +119,10 @@ GetVecIndexFactory(const IndexType& type, const Config& cfg) {
             index = std::make_shared<knowhere::IVFPQ>();
             break;
         }
+        case IndexType::FAISS_IVFPQ_FS_CPU: {
+            index = std::make_shared<knowhere::IVFPQFastScan>();
+            break;
+        }
         case IndexType::SPTAG_KDT_RNT_CPU: {
             index = std::make_shared<knowhere::CPUSPTAGRNG>("KDT");
             break;
@@ -179,7 +216,16 @@ read_index(const std::string& location) {
 
     std::shared_ptr<storage::IOReader> reader_ptr;
     if (s3_enable) {
-        reader_ptr = std::make_shared<storage::S3IOReader>(location);
+        // spillover tier: prefer a local copy of the object, downloading it
+        // into the disk cache on a miss, so repeated cold loads of the same
+        // segment skip the S3 round trip
+        std::string local_path;
+        auto disk_cache = cache::DiskCacheMgr::GetInstance();
+        if (disk_cache->Enabled() && disk_cache->FetchOrDownload(location, local_path).ok()) {
+            reader_ptr = std::make_shared<storage::FileIOReader>(local_path);
+        } else {
+            reader_ptr = std::make_shared<storage::S3IOReader>(location);
+        }
     } else {
         reader_ptr = std::make_shared<storage::FileIOReader>(location);
     }
@@ -194,11 +240,49 @@ read_index(const std::string& location) {
     size_t rp = 0;
     reader_ptr->seekg(0);
 
-    auto current_type = IndexType::INVALID;
-    reader_ptr->read(&current_type, sizeof(current_type));
-    rp += sizeof(current_type);
+    // checksummed containers are prefixed with magic + version + codec bytes,
+    // the interim compressed layout with magic + codec; legacy files start
+    // with the index type directly
+    static_assert(sizeof(IndexType) == sizeof(uint32_t), "index type header width");
+    uint32_t head = 0;
+    reader_ptr->read(&head, sizeof(head));
+    rp += sizeof(head);
     reader_ptr->seekg(rp);
 
+    bool envelope = false;
+    storage::CodecPtr codec = nullptr;
+    auto current_type = IndexType::INVALID;
+    if (head == storage::SEGMENT_FILE_MAGIC || head == storage::CODEC_FILE_MAGIC) {
+        envelope = (head == storage::SEGMENT_FILE_MAGIC);
+        if (envelope) {
+            uint8_t format_version = 0;
+            reader_ptr->read(&format_version, sizeof(format_version));
+            rp += sizeof(format_version);
+            if (format_version > storage::SEGMENT_FORMAT_VERSION) {
+                STORAGE_LOG_ERROR << "read_index(" << location << ") unsupported format version "
+                                  << static_cast<int>(format_version);
+                return nullptr;
+            }
+        }
+
+        uint8_t codec_type = 0;
+        reader_ptr->read(&codec_type, sizeof(codec_type));
+        rp += sizeof(codec_type);
+        reader_ptr->seekg(rp);
+
+        codec = storage::Codec::Get(static_cast<storage::CodecType>(codec_type));
+        if (codec == nullptr && static_cast<storage::CodecType>(codec_type) != storage::CodecType::NONE) {
+            STORAGE_LOG_ERROR << "read_index(" << location << ") unknown codec " << static_cast<int>(codec_type);
+            return nullptr;
+        }
+
+        reader_ptr->read(&current_type, sizeof(current_type));
+        rp += sizeof(current_type);
+        reader_ptr->seekg(rp);
+    } else {
+        current_type = static_cast<IndexType>(head);
+    }
+
     while (rp < length) {
         size_t meta_length;
         reader_ptr->read(&meta_length, sizeof(meta_length));
@@ -215,13 +299,85 @@ read_index(const std::string& location) {
         rp += sizeof(bin_length);
         reader_ptr->seekg(rp);
 
-        auto bin = new uint8_t[bin_length];
-        reader_ptr->read(bin, bin_length);
-        rp += bin_length;
-        reader_ptr->seekg(rp);
+        // hugepage-backed when enabled: these blocks hold the index payload
+        // and stay resident for mmap-less binary indexes
+        auto binptr = server::HugePageAllocator::GetInstance().Allocate(bin_length);
+        auto bin = binptr.get();
+        if (!envelope && codec == nullptr) {
+            reader_ptr->read(bin, bin_length);
+            rp += bin_length;
+            reader_ptr->seekg(rp);
+        } else if (codec == nullptr) {
+            // checksum table up front, payload contiguous behind it; the blob
+            // lands straight in its destination and is verified in place
+            uint32_t chunk_count = 0;
+            reader_ptr->read(&chunk_count, sizeof(chunk_count));
+            rp += sizeof(chunk_count);
+            reader_ptr->seekg(rp);
+
+            std::vector<storage::CodecChunk> chunks(chunk_count);
+            size_t raw_offset = 0;
+            for (uint32_t i = 0; i < chunk_count; ++i) {
+                uint32_t raw_len = 0;
+                uint32_t checksum = 0;
+                reader_ptr->read(&raw_len, sizeof(raw_len));
+                reader_ptr->read(&checksum, sizeof(checksum));
+                rp += sizeof(raw_len) + sizeof(checksum);
+                reader_ptr->seekg(rp);
+
+                chunks[i] = {bin + raw_offset, raw_len, bin + raw_offset, raw_len, checksum, true};
+                raw_offset += raw_len;
+            }
+
+            reader_ptr->read(bin, bin_length);
+            rp += bin_length;
+            reader_ptr->seekg(rp);
+
+            auto stat = storage::DecompressChunks(nullptr, chunks);
+            if (raw_offset != bin_length || !stat.ok()) {
+                delete[] meta;
+                throw Exception(SERVER_UNEXPECTED_ERROR, "Corrupted segment file: " + location);
+            }
+        } else {
+            // pull in all compressed chunk frames, then verify and inflate
+            // them in parallel
+            uint32_t chunk_count = 0;
+            reader_ptr->read(&chunk_count, sizeof(chunk_count));
+            rp += sizeof(chunk_count);
+            reader_ptr->seekg(rp);
+
+            std::vector<std::vector<uint8_t>> compressed(chunk_count);
+            std::vector<storage::CodecChunk> chunks(chunk_count);
+            size_t raw_offset = 0;
+            for (uint32_t i = 0; i < chunk_count; ++i) {
+                uint32_t raw_len = 0;
+                uint32_t comp_len = 0;
+                uint32_t checksum = 0;
+                reader_ptr->read(&raw_len, sizeof(raw_len));
+                reader_ptr->read(&comp_len, sizeof(comp_len));
+                rp += sizeof(raw_len) + sizeof(comp_len);
+                if (envelope) {
+                    reader_ptr->read(&checksum, sizeof(checksum));
+                    rp += sizeof(checksum);
+                }
+                reader_ptr->seekg(rp);
+
+                compressed[i].resize(comp_len);
+                reader_ptr->read(compressed[i].data(), comp_len);
+                rp += comp_len;
+                reader_ptr->seekg(rp);
+
+                chunks[i] = {compressed[i].data(), comp_len, bin + raw_offset, raw_len, checksum, envelope};
+                raw_offset += raw_len;
+            }
+
+            auto stat = storage::DecompressChunks(codec, chunks);
+            if (raw_offset != bin_length || !stat.ok()) {
+                delete[] meta;
+                throw Exception(SERVER_UNEXPECTED_ERROR, "Corrupted segment file: " + location);
+            }
+        }
 
-        auto binptr = std::make_shared<uint8_t>();
-        binptr.reset(bin);
         load_data_list.Append(std::string(meta, meta_length), binptr, bin_length);
         delete[] meta;
     }
@@ -233,6 +389,609 @@ read_index(const std::string& location) {
     return LoadVecIndex(current_type, load_data_list, length);
 }
 
+VecIndexPtr
+read_index_mmap(const std::string& location) {
+    std::string local_location = location;
+
+    bool s3_enable = false;
+    server::Config& config = server::Config::GetInstance();
+    config.GetStorageConfigS3Enable(s3_enable);
+    if (s3_enable) {
+        // only local files can be mapped; a disk cache copy qualifies
+        auto disk_cache = cache::DiskCacheMgr::GetInstance();
+        if (!disk_cache->Enabled() || !disk_cache->FetchOrDownload(location, local_location).ok()) {
+            return nullptr;
+        }
+    }
+
+    try {
+        storage::FileIOReader reader(local_location);
+        size_t length = reader.length();
+        if (length <= 0) {
+            return nullptr;
+        }
+
+        size_t rp = 0;
+        reader.seekg(0);
+
+        // mapped loads understand the checksummed container as long as the
+        // payload is stored uncompressed; validation is left to the heap path
+        uint32_t head = 0;
+        reader.read(&head, sizeof(head));
+        rp += sizeof(head);
+        reader.seekg(rp);
+
+        bool envelope = false;
+        auto current_type = IndexType::INVALID;
+        if (head == storage::SEGMENT_FILE_MAGIC) {
+            envelope = true;
+
+            uint8_t format_version = 0;
+            uint8_t codec_type = 0;
+            reader.read(&format_version, sizeof(format_version));
+            reader.read(&codec_type, sizeof(codec_type));
+            rp += sizeof(format_version) + sizeof(codec_type);
+            reader.seekg(rp);
+            if (format_version > storage::SEGMENT_FORMAT_VERSION ||
+                static_cast<storage::CodecType>(codec_type) != storage::CodecType::NONE) {
+                return nullptr;
+            }
+
+            reader.read(&current_type, sizeof(current_type));
+            rp += sizeof(current_type);
+            reader.seekg(rp);
+        } else if (head == storage::CODEC_FILE_MAGIC) {
+            // compressed payloads cannot be mapped
+            return nullptr;
+        } else {
+            current_type = static_cast<IndexType>(head);
+        }
+
+        if (current_type != IndexType::FAISS_IVFFLAT_CPU && current_type != IndexType::FAISS_IVFSQ8_CPU) {
+            // only the cpu IVF flavours store a plain faiss blob that faiss can map
+            return nullptr;
+        }
+
+        // walk the segment framing to find the absolute offset of the faiss blob
+        size_t data_offset = 0;
+        size_t data_length = 0;
+        while (rp < length) {
+            size_t meta_length;
+            reader.read(&meta_length, sizeof(meta_length));
+            rp += sizeof(meta_length);
+            reader.seekg(rp);
+
+            auto meta = new char[meta_length];
+            reader.read(meta, meta_length);
+            rp += meta_length;
+            reader.seekg(rp);
+
+            size_t bin_length;
+            reader.read(&bin_length, sizeof(bin_length));
+            rp += sizeof(bin_length);
+            reader.seekg(rp);
+
+            if (envelope) {
+                // skip the checksum table; the payload is contiguous behind it
+                uint32_t chunk_count = 0;
+                reader.read(&chunk_count, sizeof(chunk_count));
+                rp += sizeof(chunk_count) + chunk_count * 2 * sizeof(uint32_t);
+                reader.seekg(rp);
+            }
+
+            if (std::string(meta, meta_length) == "IVF") {
+                data_offset = rp;
+                data_length = bin_length;
+            }
+            delete[] meta;
+
+            rp += bin_length;
+            reader.seekg(rp);
+        }
+
+        if (data_offset == 0 || data_length == 0) {
+            return nullptr;
+        }
+
+        // faiss resolves mmap offsets against the absolute file position, so the
+        // blob can be mapped straight out of the segment file
+        faiss::FileIOReader faiss_reader(local_location.c_str());
+        fseek(faiss_reader.f, data_offset, SEEK_SET);
+        auto raw_index = std::shared_ptr<faiss::Index>(faiss::read_index(&faiss_reader, faiss::IO_FLAG_MMAP));
+
+        std::shared_ptr<knowhere::VectorIndex> index;
+        if (current_type == IndexType::FAISS_IVFFLAT_CPU) {
+            index = std::make_shared<knowhere::IVF>(raw_index);
+        } else {
+            index = std::make_shared<knowhere::IVFSQ>(raw_index);
+        }
+        auto impl = std::make_shared<VecIndexImpl>(index, current_type);
+        impl->set_size(length);
+        return impl;
+    } catch (std::exception& e) {
+        // sealed readonly layouts and other on-disk formats cannot be mapped
+        STORAGE_LOG_WARNING << "read_index_mmap(" << location << ") not mappable, fallback to heap load: " << e.what();
+        return nullptr;
+    }
+}
+
+namespace {
+
+// fixed IDMap+Flat slab offsets inside a raw float segment file
+struct RawSlabLayout {
+    int32_t dim = 0;
+    int64_t ntotal = 0;
+    size_t vec_offset = 0;
+    size_t id_offset = 0;
+};
+
+// Walk the segment framing and the faiss IDMap+Flat serialization to find the
+// vector and id slabs. Any compressed, non-IDMAP or malformed layout fails
+// here, before a caller hands out a single row.
+Status
+locate_raw_slabs(storage::FileIOReader& reader, const std::string& location, RawSlabLayout& layout) {
+    Status not_streamable(DB_ERROR, "Segment file layout cannot be streamed: " + location);
+
+    size_t length = reader.length();
+    if (length <= sizeof(uint32_t)) {
+        return not_streamable;
+    }
+
+    size_t rp = 0;
+    reader.seekg(0);
+
+    // positional reads understand the checksummed container as long as the
+    // payload is stored uncompressed; validation is left to the scrubber
+    uint32_t head = 0;
+    reader.read(&head, sizeof(head));
+    rp += sizeof(head);
+    reader.seekg(rp);
+
+    bool envelope = false;
+    auto current_type = IndexType::INVALID;
+    if (head == storage::SEGMENT_FILE_MAGIC) {
+        envelope = true;
+
+        uint8_t format_version = 0;
+        uint8_t codec_type = 0;
+        reader.read(&format_version, sizeof(format_version));
+        reader.read(&codec_type, sizeof(codec_type));
+        rp += sizeof(format_version) + sizeof(codec_type);
+        reader.seekg(rp);
+        if (format_version > storage::SEGMENT_FORMAT_VERSION ||
+            static_cast<storage::CodecType>(codec_type) != storage::CodecType::NONE) {
+            return not_streamable;
+        }
+
+        reader.read(&current_type, sizeof(current_type));
+        rp += sizeof(current_type);
+        reader.seekg(rp);
+    } else if (head == storage::CODEC_FILE_MAGIC) {
+        // compressed payloads cannot be read at computed offsets
+        return not_streamable;
+    } else {
+        current_type = static_cast<IndexType>(head);
+    }
+
+    if (current_type != IndexType::FAISS_IDMAP) {
+        // only the float brute-force files store the fixed IDMap+Flat blob
+        return not_streamable;
+    }
+
+    // walk the segment framing to find the absolute offset of the faiss blob
+    size_t data_offset = 0;
+    size_t data_length = 0;
+    while (rp < length) {
+        size_t meta_length;
+        reader.read(&meta_length, sizeof(meta_length));
+        rp += sizeof(meta_length);
+        reader.seekg(rp);
+
+        auto meta = new char[meta_length];
+        reader.read(meta, meta_length);
+        rp += meta_length;
+        reader.seekg(rp);
+
+        size_t bin_length;
+        reader.read(&bin_length, sizeof(bin_length));
+        rp += sizeof(bin_length);
+        reader.seekg(rp);
+
+        if (envelope) {
+            // skip the checksum table; the payload is contiguous behind it
+            uint32_t chunk_count = 0;
+            reader.read(&chunk_count, sizeof(chunk_count));
+            rp += sizeof(chunk_count) + chunk_count * 2 * sizeof(uint32_t);
+            reader.seekg(rp);
+        }
+
+        if (std::string(meta, meta_length) == "IVF") {
+            data_offset = rp;
+            data_length = bin_length;
+        }
+        delete[] meta;
+
+        rp += bin_length;
+        reader.seekg(rp);
+    }
+
+    if (data_offset == 0 || data_length == 0 || data_offset + data_length > length) {
+        return not_streamable;
+    }
+
+    auto read_at = [&](size_t offset, void* dst, size_t len) {
+        reader.seekg(offset);
+        reader.read(dst, len);
+    };
+
+    // the IDMap+Flat serialization is fixed-shape: fourcc + header for the
+    // id map, fourcc + header for the flat index, the vector slab, then
+    // the id slab; parse just enough of it to locate the two slabs
+    size_t blob_end = data_offset + data_length;
+    size_t bp = data_offset;
+    uint32_t h = 0;
+    read_at(bp, &h, sizeof(h));
+    bp += sizeof(h);
+    if (h != faiss::fourcc("IxMp")) {
+        return not_streamable;
+    }
+
+    int32_t dim = 0;
+    int64_t ntotal = 0;
+    auto skip_header = [&](int32_t& d, int64_t& n) -> bool {
+        read_at(bp, &d, sizeof(d));
+        bp += sizeof(d);
+        read_at(bp, &n, sizeof(n));
+        bp += sizeof(n);
+        bp += 2 * sizeof(int64_t);  // the two reserved fields
+        bp += sizeof(uint8_t);      // is_trained
+        int32_t metric_type = 0;
+        read_at(bp, &metric_type, sizeof(metric_type));
+        bp += sizeof(metric_type);
+        // metrics beyond ip and l2 append an extra argument to the header
+        return metric_type == 0 || metric_type == 1;
+    };
+    if (!skip_header(dim, ntotal)) {
+        return not_streamable;
+    }
+
+    read_at(bp, &h, sizeof(h));
+    bp += sizeof(h);
+    if (h != faiss::fourcc("IxF2") && h != faiss::fourcc("IxFI")) {
+        return not_streamable;
+    }
+    int32_t flat_dim = 0;
+    int64_t flat_ntotal = 0;
+    if (!skip_header(flat_dim, flat_ntotal)) {
+        return not_streamable;
+    }
+
+    size_t xb_size = 0;
+    read_at(bp, &xb_size, sizeof(xb_size));
+    bp += sizeof(xb_size);
+    size_t vec_offset = bp;
+    size_t id_count_offset = vec_offset + xb_size * sizeof(float);
+
+    if (dim <= 0 || ntotal <= 0 || flat_dim != dim || flat_ntotal != ntotal ||
+        xb_size != static_cast<size_t>(ntotal) * dim || id_count_offset + sizeof(size_t) > blob_end) {
+        return not_streamable;
+    }
+
+    size_t id_size = 0;
+    read_at(id_count_offset, &id_size, sizeof(id_size));
+    size_t id_offset = id_count_offset + sizeof(id_size);
+    if (id_size != static_cast<size_t>(ntotal) || id_offset + id_size * sizeof(int64_t) > blob_end) {
+        return not_streamable;
+    }
+
+    layout.dim = dim;
+    layout.ntotal = ntotal;
+    layout.vec_offset = vec_offset;
+    layout.id_offset = id_offset;
+    return Status::OK();
+}
+
+}  // namespace
+
+Status
+read_raw_windows(const std::string& location, size_t window_bytes, const RawWindowConsumer& consume) {
+    Status not_streamable(DB_ERROR, "Segment file layout cannot be streamed: " + location);
+    fiu_return_on("read_raw_windows_unsupported", not_streamable);
+
+    std::string local_location = location;
+
+    bool s3_enable = false;
+    server::Config& config = server::Config::GetInstance();
+    config.GetStorageConfigS3Enable(s3_enable);
+    if (s3_enable) {
+        // only local files can be read in windows; a disk cache copy qualifies
+        auto disk_cache = cache::DiskCacheMgr::GetInstance();
+        if (!disk_cache->Enabled() || !disk_cache->FetchOrDownload(location, local_location).ok()) {
+            return not_streamable;
+        }
+    }
+
+    try {
+        storage::FileIOReader reader(local_location);
+        RawSlabLayout layout;
+        auto status = locate_raw_slabs(reader, location, layout);
+        if (!status.ok()) {
+            return status;
+        }
+
+        auto read_at = [&](size_t offset, void* dst, size_t len) {
+            reader.seekg(offset);
+            reader.read(dst, len);
+        };
+
+        // everything below hands rows to the consumer; from here on failures
+        // are final and must not be retried through another load path
+        TimeRecorder recorder("read_raw_windows");
+        size_t row_bytes = layout.dim * sizeof(float) + sizeof(int64_t);
+        int64_t window_rows = std::max(static_cast<int64_t>(window_bytes / row_bytes), static_cast<int64_t>(1));
+        std::vector<float> vectors(static_cast<size_t>(window_rows) * layout.dim);
+        std::vector<int64_t> ids(window_rows);
+        for (int64_t begin = 0; begin < layout.ntotal; begin += window_rows) {
+            int64_t rows = std::min(window_rows, layout.ntotal - begin);
+            read_at(layout.vec_offset + static_cast<size_t>(begin) * layout.dim * sizeof(float), vectors.data(),
+                    static_cast<size_t>(rows) * layout.dim * sizeof(float));
+            read_at(layout.id_offset + static_cast<size_t>(begin) * sizeof(int64_t), ids.data(),
+                    rows * sizeof(int64_t));
+            status = consume(rows, vectors.data(), ids.data());
+            if (!status.ok()) {
+                return status;
+            }
+        }
+
+        double span = recorder.RecordSection("End");
+        double rate = reader.length() * 1000000.0 / span / 1024 / 1024;
+        STORAGE_LOG_DEBUG << "read_raw_windows(" << location << ") rate " << rate << "MB/s";
+        return Status::OK();
+    } catch (std::exception& e) {
+        return Status(DB_ERROR, e.what());
+    }
+}
+
+Status
+read_raw_ids(const std::string& location, std::vector<int64_t>& ids) {
+    std::string local_location = location;
+
+    bool s3_enable = false;
+    server::Config& config = server::Config::GetInstance();
+    config.GetStorageConfigS3Enable(s3_enable);
+    if (s3_enable) {
+        // only local files can be read at computed offsets
+        auto disk_cache = cache::DiskCacheMgr::GetInstance();
+        if (!disk_cache->Enabled() || !disk_cache->FetchOrDownload(location, local_location).ok()) {
+            return Status(DB_ERROR, "Segment file layout cannot be streamed: " + location);
+        }
+    }
+
+    try {
+        storage::FileIOReader reader(local_location);
+        RawSlabLayout layout;
+        auto status = locate_raw_slabs(reader, location, layout);
+        if (!status.ok()) {
+            return status;
+        }
+
+        ids.resize(layout.ntotal);
+        reader.seekg(layout.id_offset);
+        reader.read(ids.data(), static_cast<size_t>(layout.ntotal) * sizeof(int64_t));
+        return Status::OK();
+    } catch (std::exception& e) {
+        return Status(DB_ERROR, e.what());
+    }
+}
+
+Status
+fetch_raw_rows(const std::string& location, const std::vector<int64_t>& rows, int64_t& dim,
+               std::vector<float>& vectors) {
+    // a segment the data cache already holds is served from memory - the same
+    // copy search scans - without touching the disk layout at all
+    auto cached = std::dynamic_pointer_cast<BFIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(location));
+    if (cached != nullptr) {
+        const float* raw = cached->GetRawVectors();
+        if (raw != nullptr) {
+            dim = cached->Dimension();
+            int64_t count = cached->Count();
+            vectors.resize(rows.size() * static_cast<size_t>(dim));
+            for (size_t i = 0; i < rows.size(); i++) {
+                if (rows[i] < 0 || rows[i] >= count) {
+                    return Status(DB_ERROR, "Row offset out of range in segment " + location);
+                }
+                memcpy(vectors.data() + i * dim, raw + rows[i] * dim, static_cast<size_t>(dim) * sizeof(float));
+            }
+            return Status::OK();
+        }
+    }
+
+    std::string local_location = location;
+
+    bool s3_enable = false;
+    server::Config& config = server::Config::GetInstance();
+    config.GetStorageConfigS3Enable(s3_enable);
+    if (s3_enable) {
+        auto disk_cache = cache::DiskCacheMgr::GetInstance();
+        if (!disk_cache->Enabled() || !disk_cache->FetchOrDownload(location, local_location).ok()) {
+            return Status(DB_ERROR, "Segment file layout cannot be streamed: " + location);
+        }
+    }
+
+    try {
+        storage::FileIOReader reader(local_location);
+        RawSlabLayout layout;
+        auto status = locate_raw_slabs(reader, location, layout);
+        if (!status.ok()) {
+            return status;
+        }
+
+        dim = layout.dim;
+        vectors.resize(rows.size() * static_cast<size_t>(dim));
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (rows[i] < 0 || rows[i] >= layout.ntotal) {
+                return Status(DB_ERROR, "Row offset out of range in segment " + location);
+            }
+            reader.seekg(layout.vec_offset + static_cast<size_t>(rows[i]) * dim * sizeof(float));
+            reader.read(vectors.data() + i * dim, static_cast<size_t>(dim) * sizeof(float));
+        }
+        return Status::OK();
+    } catch (std::exception& e) {
+        return Status(DB_ERROR, e.what());
+    }
+}
+
+Status
+VerifySegmentFile(const std::string& location, int64_t mb_per_second) {
+    storage::FileIOReader reader(location);
+    size_t length = reader.length();
+    if (length == 0) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Cannot open segment file: " + location);
+    }
+
+    Status corrupted(SERVER_UNEXPECTED_ERROR, "Corrupted segment file: " + location);
+
+    // scrub runs beneath foreground I/O: sleep whenever the verified byte
+    // count gets ahead of the configured budget
+    size_t charged = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto throttle = [&](size_t bytes) {
+        if (mb_per_second <= 0) {
+            return;
+        }
+        charged += bytes;
+        double budget = static_cast<double>(mb_per_second) * 1024 * 1024;
+        std::chrono::duration<double> expected(charged / budget);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed < expected) {
+            std::this_thread::sleep_for(expected - elapsed);
+        }
+    };
+
+    size_t rp = 0;
+    uint32_t head = 0;
+    if (length < sizeof(head)) {
+        return corrupted;
+    }
+    reader.read(&head, sizeof(head));
+    rp += sizeof(head);
+
+    if (head != storage::SEGMENT_FILE_MAGIC) {
+        // legacy layouts carry no checksums, so there is nothing to verify
+        STORAGE_LOG_DEBUG << "VerifySegmentFile(" << location << ") has no checksums, skipped";
+        return Status::OK();
+    }
+
+    uint8_t format_version = 0;
+    uint8_t codec_type = 0;
+    IndexType index_type = IndexType::INVALID;
+    if (length - rp < sizeof(format_version) + sizeof(codec_type) + sizeof(index_type)) {
+        return corrupted;
+    }
+    reader.read(&format_version, sizeof(format_version));
+    reader.read(&codec_type, sizeof(codec_type));
+    reader.read(&index_type, sizeof(index_type));
+    rp += sizeof(format_version) + sizeof(codec_type) + sizeof(index_type);
+
+    if (format_version > storage::SEGMENT_FORMAT_VERSION) {
+        // written by a newer release; its layout is not ours to judge
+        return Status::OK();
+    }
+    bool compressed = static_cast<storage::CodecType>(codec_type) != storage::CodecType::NONE;
+    if (compressed && storage::Codec::Get(static_cast<storage::CodecType>(codec_type)) == nullptr) {
+        STORAGE_LOG_DEBUG << "VerifySegmentFile(" << location << ") unknown codec, skipped";
+        return Status::OK();
+    }
+
+    // a scrubber meets corrupt files as a matter of course, so every length
+    // field is bounds-checked before it is trusted
+    std::vector<uint8_t> chunk_buf;
+    while (rp < length) {
+        size_t meta_length = 0;
+        size_t bin_length = 0;
+        uint32_t chunk_count = 0;
+        if (length - rp < sizeof(meta_length)) {
+            return corrupted;
+        }
+        reader.read(&meta_length, sizeof(meta_length));
+        rp += sizeof(meta_length);
+        if (length - rp < meta_length) {
+            return corrupted;
+        }
+        rp += meta_length;  // the meta key is covered by no checksum; skip it
+        reader.seekg(rp);
+        if (length - rp < sizeof(bin_length) + sizeof(chunk_count)) {
+            return corrupted;
+        }
+        reader.read(&bin_length, sizeof(bin_length));
+        reader.read(&chunk_count, sizeof(chunk_count));
+        rp += sizeof(bin_length) + sizeof(chunk_count);
+
+        size_t raw_total = 0;
+        if (!compressed) {
+            // checksum table up front, payload contiguous behind it
+            std::vector<uint32_t> raw_lens(chunk_count);
+            std::vector<uint32_t> checksums(chunk_count);
+            for (uint32_t i = 0; i < chunk_count; ++i) {
+                if (length - rp < sizeof(uint32_t) * 2) {
+                    return corrupted;
+                }
+                reader.read(&raw_lens[i], sizeof(uint32_t));
+                reader.read(&checksums[i], sizeof(uint32_t));
+                rp += sizeof(uint32_t) * 2;
+            }
+            for (uint32_t i = 0; i < chunk_count; ++i) {
+                if (length - rp < raw_lens[i]) {
+                    return corrupted;
+                }
+                chunk_buf.resize(raw_lens[i]);
+                reader.read(chunk_buf.data(), raw_lens[i]);
+                rp += raw_lens[i];
+                raw_total += raw_lens[i];
+                if (storage::ChunkChecksum(chunk_buf.data(), raw_lens[i]) != checksums[i]) {
+                    return Status(SERVER_UNEXPECTED_ERROR, "Checksum mismatch in segment file: " + location);
+                }
+                throttle(raw_lens[i]);
+            }
+        } else {
+            // compressed frames; the checksum covers the stored bytes, so no
+            // chunk needs to be inflated to be verified
+            for (uint32_t i = 0; i < chunk_count; ++i) {
+                uint32_t raw_len = 0;
+                uint32_t comp_len = 0;
+                uint32_t checksum = 0;
+                if (length - rp < sizeof(uint32_t) * 3) {
+                    return corrupted;
+                }
+                reader.read(&raw_len, sizeof(raw_len));
+                reader.read(&comp_len, sizeof(comp_len));
+                reader.read(&checksum, sizeof(checksum));
+                rp += sizeof(uint32_t) * 3;
+                if (length - rp < comp_len) {
+                    return corrupted;
+                }
+                chunk_buf.resize(comp_len);
+                reader.read(chunk_buf.data(), comp_len);
+                rp += comp_len;
+                raw_total += raw_len;
+                if (storage::ChunkChecksum(chunk_buf.data(), comp_len) != checksum) {
+                    return Status(SERVER_UNEXPECTED_ERROR, "Checksum mismatch in segment file: " + location);
+                }
+                throttle(comp_len);
+            }
+        }
+        if (raw_total != bin_length) {
+            return corrupted;
+        }
+    }
+
+    return Status::OK();
+}
+
+// name of the self-describing section written first into every segment
+// file; the leading underscore keeps it clear of index payload keys
+static const char* SEGMENT_HEADER_KEY = "_segment_header";
+
 Status
 write_index(VecIndexPtr index, const std::string& location) {
     try {
@@ -250,6 +1009,15 @@ write_index(VecIndexPtr index, const std::string& location) {
         server::Config& config = server::Config::GetInstance();
         config.GetStorageConfigS3Enable(s3_enable);
 
+        // raw-vector segments are highly compressible; quantized and graph
+        // index payloads are not worth the cycles
+        storage::CodecPtr codec = nullptr;
+        bool compress_enable = false;
+        config.GetStorageConfigFileCompressEnable(compress_enable);
+        if (compress_enable && (index_type == IndexType::FAISS_IDMAP || index_type == IndexType::FAISS_BIN_IDMAP)) {
+            codec = storage::Codec::Get(storage::CodecType::ZLIB);
+        }
+
         std::shared_ptr<storage::IOWriter> writer_ptr;
         if (s3_enable) {
             writer_ptr = std::make_shared<storage::S3IOWriter>(location);
@@ -259,18 +1027,65 @@ write_index(VecIndexPtr index, const std::string& location) {
 
         recorder.RecordSection("Start");
 
+        // every segment is wrapped in the checksummed container so a truncated
+        // or corrupted download fails validation instead of crashing the faiss
+        // deserializer
+        uint32_t magic = storage::SEGMENT_FILE_MAGIC;
+        uint8_t version = storage::SEGMENT_FORMAT_VERSION;
+        auto codec_type = static_cast<uint8_t>(codec != nullptr ? codec->Type() : storage::CodecType::NONE);
+        writer_ptr->write(&magic, sizeof(magic));
+        writer_ptr->write(&version, sizeof(version));
+        writer_ptr->write(&codec_type, sizeof(codec_type));
         writer_ptr->write(&index_type, sizeof(IndexType));
 
-        for (auto& iter : binaryset.binary_map_) {
-            auto meta = iter.first.c_str();
-            size_t meta_length = iter.first.length();
+        auto write_section = [&](const std::string& name, const uint8_t* data, int64_t binary_length) {
+            size_t meta_length = name.length();
             writer_ptr->write(&meta_length, sizeof(meta_length));
-            writer_ptr->write((void*)meta, meta_length);
-
-            auto binary = iter.second;
-            int64_t binary_length = binary->size;
+            writer_ptr->write((void*)name.c_str(), meta_length);
             writer_ptr->write(&binary_length, sizeof(binary_length));
-            writer_ptr->write((void*)binary->data.get(), binary_length);
+
+            auto chunk_count =
+                static_cast<uint32_t>((binary_length + storage::CODEC_CHUNK_SIZE - 1) / storage::CODEC_CHUNK_SIZE);
+            writer_ptr->write(&chunk_count, sizeof(chunk_count));
+
+            if (codec == nullptr) {
+                // checksum table up front, payload contiguous behind it so the
+                // mmap path can still map the blob straight out of the file
+                for (int64_t offset = 0; offset < binary_length; offset += storage::CODEC_CHUNK_SIZE) {
+                    auto raw_len = static_cast<uint32_t>(
+                        std::min(static_cast<int64_t>(storage::CODEC_CHUNK_SIZE), binary_length - offset));
+                    uint32_t checksum = storage::ChunkChecksum(data + offset, raw_len);
+                    writer_ptr->write(&raw_len, sizeof(raw_len));
+                    writer_ptr->write(&checksum, sizeof(checksum));
+                }
+                writer_ptr->write((void*)data, binary_length);
+            } else {
+                // compress chunk by chunk so only one chunk is staged at a time
+                std::vector<uint8_t> compressed;
+                for (int64_t offset = 0; offset < binary_length; offset += storage::CODEC_CHUNK_SIZE) {
+                    auto raw_len = static_cast<uint32_t>(
+                        std::min(static_cast<int64_t>(storage::CODEC_CHUNK_SIZE), binary_length - offset));
+                    auto stat = codec->Compress(data + offset, raw_len, compressed);
+                    if (!stat.ok()) {
+                        throw Exception(SERVER_UNEXPECTED_ERROR, stat.message());
+                    }
+                    auto comp_len = static_cast<uint32_t>(compressed.size());
+                    uint32_t checksum = storage::ChunkChecksum(compressed.data(), comp_len);
+                    writer_ptr->write(&raw_len, sizeof(raw_len));
+                    writer_ptr->write(&comp_len, sizeof(comp_len));
+                    writer_ptr->write(&checksum, sizeof(checksum));
+                    writer_ptr->write(compressed.data(), comp_len);
+                }
+            }
+        };
+
+        // the header section goes first so a header-only reader is done after
+        // one small section, whatever bulk payload follows
+        int64_t header_payload[2] = {index->Count(), index->Dimension()};
+        write_section(SEGMENT_HEADER_KEY, reinterpret_cast<const uint8_t*>(header_payload), sizeof(header_payload));
+
+        for (auto& iter : binaryset.binary_map_) {
+            write_section(iter.first, iter.second->data.get(), iter.second->size);
         }
 
         double span = recorder.RecordSection("End");
@@ -292,6 +1107,151 @@ write_index(VecIndexPtr index, const std::string& location) {
     return Status::OK();
 }
 
+Status
+read_index_header(const std::string& location, SegmentHeaderInfo& header) {
+    try {
+        bool s3_enable = false;
+        server::Config& config = server::Config::GetInstance();
+        config.GetStorageConfigS3Enable(s3_enable);
+
+        std::shared_ptr<storage::IOReader> reader_ptr;
+        if (s3_enable) {
+            reader_ptr = std::make_shared<storage::S3IOReader>(location);
+        } else {
+            reader_ptr = std::make_shared<storage::FileIOReader>(location);
+        }
+
+        size_t length = reader_ptr->length();
+        if (length <= 0) {
+            return Status(SERVER_UNEXPECTED_ERROR, "Invalid index file: " + location);
+        }
+
+        size_t rp = 0;
+        reader_ptr->seekg(0);
+
+        uint32_t head = 0;
+        reader_ptr->read(&head, sizeof(head));
+        rp += sizeof(head);
+        reader_ptr->seekg(rp);
+
+        bool envelope = false;
+        storage::CodecPtr codec = nullptr;
+        if (head == storage::SEGMENT_FILE_MAGIC || head == storage::CODEC_FILE_MAGIC) {
+            envelope = (head == storage::SEGMENT_FILE_MAGIC);
+            if (envelope) {
+                uint8_t format_version = 0;
+                reader_ptr->read(&format_version, sizeof(format_version));
+                rp += sizeof(format_version);
+                if (format_version > storage::SEGMENT_FORMAT_VERSION) {
+                    return Status(SERVER_UNEXPECTED_ERROR, "Unsupported format version: " + location);
+                }
+            }
+
+            uint8_t codec_type = 0;
+            reader_ptr->read(&codec_type, sizeof(codec_type));
+            rp += sizeof(codec_type);
+            reader_ptr->seekg(rp);
+            codec = storage::Codec::Get(static_cast<storage::CodecType>(codec_type));
+            if (codec == nullptr && static_cast<storage::CodecType>(codec_type) != storage::CodecType::NONE) {
+                return Status(SERVER_UNEXPECTED_ERROR, "Unknown codec: " + location);
+            }
+
+            reader_ptr->read(&header.index_type, sizeof(header.index_type));
+            rp += sizeof(header.index_type);
+            reader_ptr->seekg(rp);
+        } else {
+            // pre-container file: the index type is the first word and the
+            // counts are only available through a full load
+            header.index_type = static_cast<IndexType>(head);
+            return Status::OK();
+        }
+
+        size_t meta_length = 0;
+        reader_ptr->read(&meta_length, sizeof(meta_length));
+        rp += sizeof(meta_length);
+        reader_ptr->seekg(rp);
+
+        std::string name(meta_length, '\0');
+        reader_ptr->read(&name[0], meta_length);
+        rp += meta_length;
+        reader_ptr->seekg(rp);
+        if (name != SEGMENT_HEADER_KEY) {
+            // written before the header section existed; type is still known
+            return Status::OK();
+        }
+
+        int64_t bin_length = 0;
+        reader_ptr->read(&bin_length, sizeof(bin_length));
+        rp += sizeof(bin_length);
+        reader_ptr->seekg(rp);
+
+        uint32_t chunk_count = 0;
+        reader_ptr->read(&chunk_count, sizeof(chunk_count));
+        rp += sizeof(chunk_count);
+        reader_ptr->seekg(rp);
+
+        std::vector<uint8_t> payload(bin_length);
+        std::vector<storage::CodecChunk> chunks(chunk_count);
+        if (codec == nullptr) {
+            size_t raw_offset = 0;
+            for (uint32_t i = 0; i < chunk_count; ++i) {
+                uint32_t raw_len = 0;
+                uint32_t checksum = 0;
+                reader_ptr->read(&raw_len, sizeof(raw_len));
+                reader_ptr->read(&checksum, sizeof(checksum));
+                rp += sizeof(raw_len) + sizeof(checksum);
+                reader_ptr->seekg(rp);
+                chunks[i] = {payload.data() + raw_offset, raw_len, payload.data() + raw_offset, raw_len, checksum,
+                             true};
+                raw_offset += raw_len;
+            }
+            reader_ptr->read(payload.data(), bin_length);
+            auto stat = storage::DecompressChunks(nullptr, chunks);
+            if (raw_offset != static_cast<size_t>(bin_length) || !stat.ok()) {
+                return Status(SERVER_UNEXPECTED_ERROR, "Corrupted segment file: " + location);
+            }
+        } else {
+            std::vector<std::vector<uint8_t>> compressed(chunk_count);
+            size_t raw_offset = 0;
+            for (uint32_t i = 0; i < chunk_count; ++i) {
+                uint32_t raw_len = 0;
+                uint32_t comp_len = 0;
+                uint32_t checksum = 0;
+                reader_ptr->read(&raw_len, sizeof(raw_len));
+                reader_ptr->read(&comp_len, sizeof(comp_len));
+                rp += sizeof(raw_len) + sizeof(comp_len);
+                if (envelope) {
+                    reader_ptr->read(&checksum, sizeof(checksum));
+                    rp += sizeof(checksum);
+                }
+                reader_ptr->seekg(rp);
+
+                compressed[i].resize(comp_len);
+                reader_ptr->read(compressed[i].data(), comp_len);
+                rp += comp_len;
+                reader_ptr->seekg(rp);
+
+                chunks[i] = {compressed[i].data(), comp_len, payload.data() + raw_offset, raw_len, checksum, envelope};
+                raw_offset += raw_len;
+            }
+            auto stat = storage::DecompressChunks(codec, chunks);
+            if (raw_offset != static_cast<size_t>(bin_length) || !stat.ok()) {
+                return Status(SERVER_UNEXPECTED_ERROR, "Corrupted segment file: " + location);
+            }
+        }
+
+        if (bin_length >= static_cast<int64_t>(2 * sizeof(int64_t))) {
+            memcpy(&header.row_count, payload.data(), sizeof(int64_t));
+            memcpy(&header.dimension, payload.data() + sizeof(int64_t), sizeof(int64_t));
+        }
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+
+    return Status::OK();
+}
+
 IndexType
 ConvertToCpuIndexType(const IndexType& type) {
     // TODO(linxj): add IDMAP
@@ -11,13 +11,16 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cache/DataObj.h"
 #include "knowhere/common/BinarySet.h"
 #include "knowhere/common/Config.h"
+#include "knowhere/index/IndexModel.h"
 #include "knowhere/index/vector_index/Quantizer.h"
 #include "utils/Log.h"
 #include "utils/Status.h"
@@ -45,6 +48,9 @@ enum class IndexType {
     FAISS_IVFPQ_MIX,
     SPTAG_BKT_RNT_CPU,
     HNSW,
+    FAISS_IDMAP_SQ8,
+    FAISS_IDMAP_FP16,
+    FAISS_IVFPQ_FS_CPU,
     FAISS_BIN_IDMAP = 100,
     FAISS_BIN_IVFLAT_CPU = 101,
 };
@@ -66,6 +72,16 @@ class VecIndex : public cache::DataObj {
         return Status::OK();
     }
 
+    // Build with trained-model reuse: a non-null `model` skips the training
+    // phase (the model is deep-copied into the index), otherwise trains as
+    // usual and returns the fresh model through `model` so the caller can
+    // cache it for the table's later segment builds.
+    virtual Status
+    BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg,
+             knowhere::IndexModelPtr& model) {
+        return Status(KNOWHERE_ERROR, "build from model not supported by this index type");
+    }
+
     virtual Status
     Add(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg = Config()) = 0;
 
@@ -84,6 +100,23 @@ class VecIndex : public cache::DataObj {
         return Status::OK();
     }
 
+    // Search writing the topk into caller-provided device-resident buffers so
+    // the per-segment results never cross PCIe. Only GPU-resident IVF indexes
+    // support this; everything else falls back to the host Search above.
+    virtual Status
+    SearchResident(const int64_t& nq, const float* xq, float* d_dist, int64_t* d_ids, const Config& cfg = Config()) {
+        return Status(KNOWHERE_ERROR, "SearchResident not supported by this index type");
+    }
+
+    // All neighbors within `radius` of each query vector; matches for query i are
+    // ids[lims[i]:lims[i+1]]. Only IDMAP and IVF based indexes support this.
+    virtual Status
+    RangeSearch(const int64_t& nq, const float* xq, float radius, std::vector<int64_t>& ids,
+                std::vector<float>& distances, std::vector<size_t>& lims, const Config& cfg = Config()) {
+        ENGINE_LOG_ERROR << "RangeSearch not supported by this index type";
+        return Status(KNOWHERE_ERROR, "RangeSearch not supported by this index type");
+    }
+
     virtual VecIndexPtr
     CopyToGpu(const int64_t& device_id, const Config& cfg = Config()) = 0;
 
@@ -109,6 +142,9 @@ class VecIndex : public cache::DataObj {
     int64_t
     Size() override;
 
+    int64_t
+    ReloadCost() override;
+
     void
     set_size(int64_t size);
 
@@ -153,12 +189,62 @@ class VecIndex : public cache::DataObj {
 extern Status
 write_index(VecIndexPtr index, const std::string& location);
 
+// compact self-describing section written at the front of every segment
+// file, so planning questions ("how many rows, what shape, which index")
+// are answered from a few hundred bytes instead of a full deserialize.
+// row_count/dimension stay -1 for files written before the header existed.
+struct SegmentHeaderInfo {
+    int64_t row_count = -1;
+    int64_t dimension = -1;
+    IndexType index_type = IndexType::INVALID;
+};
+
+extern Status
+read_index_header(const std::string& location, SegmentHeaderInfo& header);
+
 extern VecIndexPtr
 read_index(const std::string& location);
 
 VecIndexPtr
 read_index(const std::string& location, knowhere::BinarySet& index_binary);
 
+// map a local index file instead of deserializing it into heap memory, so
+// segments are paged in on demand; returns nullptr when the location or index
+// type cannot be mapped and the caller should fall back to read_index
+extern VecIndexPtr
+read_index_mmap(const std::string& location);
+
+// stream the raw vectors and ids of a float IDMAP (brute-force) segment file
+// in fixed-size windows through `consume`, so a merge can append a source file
+// with O(window) memory instead of deserializing it whole. Only local,
+// uncompressed files carry the fixed layout this walks; any other file fails
+// before the first window is delivered, so the caller may fall back to
+// read_index. Once a window has been consumed a failure is final - retrying
+// through another load path would append the same rows twice.
+using RawWindowConsumer = std::function<Status(int64_t count, const float* vectors, const int64_t* ids)>;
+
+extern Status
+read_raw_windows(const std::string& location, size_t window_bytes, const RawWindowConsumer& consume);
+
+// ids of a raw float IDMAP segment in row order, read straight from the id
+// slab without deserializing the index; fails for any layout
+// read_raw_windows cannot stream
+extern Status
+read_raw_ids(const std::string& location, std::vector<int64_t>& ids);
+
+// Positional batched fetch of rows from a raw float IDMAP segment. Rows come
+// from the data cache's in-memory copy when the segment is resident (the same
+// copy search scans) and from seeks into the on-disk vector slab otherwise.
+extern Status
+fetch_raw_rows(const std::string& location, const std::vector<int64_t>& rows, int64_t& dim,
+               std::vector<float>& vectors);
+
+// verify the per-chunk checksums of a local segment file without loading it,
+// throttled to mb_per_second (<= 0 means unthrottled). Files in a layout that
+// predates checksums carry nothing to verify and pass vacuously.
+extern Status
+VerifySegmentFile(const std::string& location, int64_t mb_per_second);
+
 extern VecIndexPtr
 GetVecIndexFactory(const IndexType& type, const Config& cfg = Config());
 
@@ -14,13 +14,19 @@
 #include "knowhere/index/vector_index/IndexGPUIDMAP.h"
 #include "knowhere/index/vector_index/IndexGPUIVF.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/IndexIVFSQHybrid.h"
 #include "knowhere/index/vector_index/helpers/Cloner.h"
+#include "server/Config.h"
 #include "src/wrapper/DataTransfer.h"
 #include "utils/Log.h"
 #include "wrapper/VecImpl.h"
 
 #include <fiu-local.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
 /*
  * no parameter check in this layer.
  * only responible for index combination
@@ -29,6 +35,12 @@
 namespace milvus {
 namespace engine {
 
+namespace {
+// per-device slice below which the clone and copy-back transfers of a second
+// device cost more than the encode they save
+constexpr int64_t MIN_SHARD_ROWS = 1 << 20;
+}  // namespace
+
 // TODO(linxj): add lock here.
 Status
 IVFMixIndex::BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg, const int64_t& nt,
@@ -43,15 +55,34 @@ IVFMixIndex::BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, co
         index_->set_preprocessor(preprocessor);
         auto model = index_->Train(dataset, cfg);
         index_->set_index_model(model);
-        index_->Add(dataset, cfg);
 
-        if (auto device_index = std::dynamic_pointer_cast<knowhere::GPUIndex>(index_)) {
-            auto host_index = device_index->CopyGpuToCpu(Config());
-            index_ = host_index;
-            type = ConvertToCpuIndexType(type);
+        if (EncodeOnHost()) {
+            // the expensive phase of an IVF build is the k-means training
+            // above; Add only encodes against the trained quantizer and is
+            // memory-bound, so copy the still-empty trained index back to the
+            // host first and encode CPU-side, freeing the GPU for the next
+            // training instead of holding it through the long add phase
+            if (auto device_index = std::dynamic_pointer_cast<knowhere::GPUIndex>(index_)) {
+                index_ = device_index->CopyGpuToCpu(Config());
+                type = ConvertToCpuIndexType(type);
+            } else {
+                WRAPPER_LOG_ERROR << "Build IVFMIXIndex Failed";
+                return Status(KNOWHERE_ERROR, "Build IVFMIXIndex Failed");
+            }
+            if (!ShardedEncode(nb, xb, ids, cfg)) {
+                index_->Add(dataset, cfg);
+            }
         } else {
-            WRAPPER_LOG_ERROR << "Build IVFMIXIndex Failed";
-            return Status(KNOWHERE_ERROR, "Build IVFMIXIndex Failed");
+            index_->Add(dataset, cfg);
+
+            if (auto device_index = std::dynamic_pointer_cast<knowhere::GPUIndex>(index_)) {
+                auto host_index = device_index->CopyGpuToCpu(Config());
+                index_ = host_index;
+                type = ConvertToCpuIndexType(type);
+            } else {
+                WRAPPER_LOG_ERROR << "Build IVFMIXIndex Failed";
+                return Status(KNOWHERE_ERROR, "Build IVFMIXIndex Failed");
+            }
         }
     } catch (knowhere::KnowhereException& e) {
         WRAPPER_LOG_ERROR << e.what();
@@ -63,6 +94,116 @@ IVFMixIndex::BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, co
     return Status::OK();
 }
 
+Status
+IVFMixIndex::BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg,
+                      knowhere::IndexModelPtr& model) {
+    try {
+        dim = cfg->d;
+        auto dataset = GenDatasetWithIds(nb, dim, xb, ids);
+
+        if (model == nullptr) {
+            auto preprocessor = index_->BuildPreprocessor(dataset, cfg);
+            index_->set_preprocessor(preprocessor);
+            model = index_->Train(dataset, cfg);
+        }
+        // the model always holds a host-side index; set_index_model copies it
+        // to the build device, so a cached one serves any number of builds
+        index_->set_index_model(model);
+
+        if (EncodeOnHost()) {
+            // see the comment in the overload above: encoding is memory-bound,
+            // so release the device right after training
+            if (auto device_index = std::dynamic_pointer_cast<knowhere::GPUIndex>(index_)) {
+                index_ = device_index->CopyGpuToCpu(Config());
+                type = ConvertToCpuIndexType(type);
+            } else {
+                WRAPPER_LOG_ERROR << "Build IVFMIXIndex Failed";
+                return Status(KNOWHERE_ERROR, "Build IVFMIXIndex Failed");
+            }
+            if (!ShardedEncode(nb, xb, ids, cfg)) {
+                index_->Add(dataset, cfg);
+            }
+        } else {
+            index_->Add(dataset, cfg);
+
+            if (auto device_index = std::dynamic_pointer_cast<knowhere::GPUIndex>(index_)) {
+                auto host_index = device_index->CopyGpuToCpu(Config());
+                index_ = host_index;
+                type = ConvertToCpuIndexType(type);
+            } else {
+                WRAPPER_LOG_ERROR << "Build IVFMIXIndex Failed";
+                return Status(KNOWHERE_ERROR, "Build IVFMIXIndex Failed");
+            }
+        }
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
+bool
+IVFMixIndex::ShardedEncode(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg) {
+    std::vector<int64_t> devices;
+    auto& config = server::Config::GetInstance();
+    if (!config.GetGpuResourceConfigBuildIndexResources(devices).ok()) {
+        return false;
+    }
+    if (devices.size() < 2 || nb < MIN_SHARD_ROWS * static_cast<int64_t>(devices.size())) {
+        return false;
+    }
+    auto target = std::dynamic_pointer_cast<knowhere::IVF>(index_);
+    if (target == nullptr) {
+        return false;
+    }
+
+    const int64_t shard_rows = (nb + static_cast<int64_t>(devices.size()) - 1) / static_cast<int64_t>(devices.size());
+    std::vector<knowhere::VectorIndexPtr> shards(devices.size());
+    std::vector<std::string> errors(devices.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < devices.size(); ++i) {
+        workers.emplace_back([&, i] {
+            const int64_t begin = static_cast<int64_t>(i) * shard_rows;
+            const int64_t rows = std::min(shard_rows, nb - begin);
+            if (rows <= 0) {
+                return;
+            }
+            try {
+                auto slice = GenDatasetWithIds(rows, dim, xb + begin * dim, ids + begin);
+                auto device_index = knowhere::cloner::CopyCpuToGpu(index_, devices[i], Config());
+                device_index->Add(slice, cfg);
+                shards[i] = knowhere::cloner::CopyGpuToCpu(device_index, Config());
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (size_t i = 0; i < devices.size(); ++i) {
+        if (!errors[i].empty()) {
+            WRAPPER_LOG_WARNING << "Sharded encode on gpu" << devices[i] << " failed: " << errors[i]
+                                << ", falling back to single-device add";
+            return false;
+        }
+    }
+
+    // merges run serially on the host; index_ was still empty, so the result
+    // is exactly the one-device build, assembled from per-device shards
+    for (auto& shard : shards) {
+        if (shard != nullptr) {
+            target->Merge(shard);
+        }
+    }
+    WRAPPER_LOG_DEBUG << "Sharded encode of " << nb << " rows across " << devices.size() << " build devices";
+    return true;
+}
+
 Status
 IVFMixIndex::Load(const knowhere::BinarySet& index_binary) {
     index_->Load(index_binary);
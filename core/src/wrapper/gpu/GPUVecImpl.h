@@ -31,8 +31,31 @@ class IVFMixIndex : public VecIndexImpl {
     BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg, const int64_t& nt,
              const float* xt) override;
 
+    Status
+    BuildAll(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg,
+             knowhere::IndexModelPtr& model) override;
+
     Status
     Load(const knowhere::BinarySet& index_binary) override;
+
+ protected:
+    // whether the add phase runs on the copied-back host index instead of the
+    // build device. Training dominates an IVF build; encoding is memory-bound,
+    // so moving it off the device frees the GPU for the next training task.
+    virtual bool
+    EncodeOnHost() const {
+        return true;
+    }
+
+    // Partition the add phase of a large segment across every device in
+    // gpu_resource_config.build_index_resources: each device encodes its slice
+    // against a clone of the trained-but-empty index, and the host-side shards
+    // are merged back into index_. Returns false (leaving index_ untouched)
+    // when fewer than two devices are configured, the segment is too small to
+    // amortize the extra transfers, or any shard fails; the caller then runs
+    // the plain single-index add.
+    bool
+    ShardedEncode(const int64_t& nb, const float* xb, const int64_t* ids, const Config& cfg);
 };
 
 class IVFHybridIndex : public IVFMixIndex {
@@ -55,6 +78,14 @@ class IVFHybridIndex : public IVFMixIndex {
 
     VecIndexPtr
     LoadData(const knowhere::QuantizerPtr& q, const Config& conf) override;
+
+ protected:
+    // the hybrid index keeps its quantizer on the device, so the combined
+    // train-and-add path stays as is
+    bool
+    EncodeOnHost() const override {
+        return false;
+    }
 };
 
 }  // namespace engine
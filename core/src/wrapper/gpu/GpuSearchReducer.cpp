@@ -0,0 +1,169 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "wrapper/gpu/GpuSearchReducer.h"
+
+#include <cuda_runtime.h>
+#include <faiss/gpu/MergeTopK.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <limits>
+
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+
+// matches the slot cap of the host-side tree reduction; overflowing tasks
+// fall back to the host merge
+static constexpr uint64_t REDUCER_MAX_SLOTS = 64;
+
+GpuSearchReducer::GpuSearchReducer(int64_t device_id, uint64_t nq, uint64_t topk, bool ascending)
+    : device_id_(device_id), nq_(nq), topk_(topk), ascending_(ascending) {
+}
+
+GpuSearchReducer::~GpuSearchReducer() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FreeSlab();
+}
+
+bool
+GpuSearchReducer::AllocateSlab() {
+    if (cudaSetDevice(device_id_) != cudaSuccess) {
+        return false;
+    }
+
+    size_t slot_size = nq_ * topk_;
+    if (cudaMalloc(&d_distances_, REDUCER_MAX_SLOTS * slot_size * sizeof(float)) != cudaSuccess) {
+        d_distances_ = nullptr;
+        return false;
+    }
+    if (cudaMalloc(&d_labels_, REDUCER_MAX_SLOTS * slot_size * sizeof(int64_t)) != cudaSuccess) {
+        cudaFree(d_distances_);
+        d_distances_ = nullptr;
+        d_labels_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void
+GpuSearchReducer::FreeSlab() {
+    if (d_distances_ != nullptr) {
+        cudaFree(d_distances_);
+        d_distances_ = nullptr;
+    }
+    if (d_labels_ != nullptr) {
+        cudaFree(d_labels_);
+        d_labels_ = nullptr;
+    }
+}
+
+int64_t
+GpuSearchReducer::AcquireSlot(float** d_distances, int64_t** d_labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (alloc_failed_ || slot_count_ >= REDUCER_MAX_SLOTS) {
+        return -1;
+    }
+
+    if (d_distances_ == nullptr && !AllocateSlab()) {
+        WRAPPER_LOG_ERROR << "GpuSearchReducer: device slab allocation failed on gpu" << device_id_
+                          << ", falling back to host merge";
+        alloc_failed_ = true;
+        return -1;
+    }
+
+    int64_t slot = slot_count_++;
+    *d_distances = d_distances_ + slot * nq_ * topk_;
+    *d_labels = d_labels_ + slot * nq_ * topk_;
+    return slot;
+}
+
+void
+GpuSearchReducer::AbortSlot(int64_t slot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (slot < 0 || static_cast<uint64_t>(slot) >= slot_count_ || d_distances_ == nullptr) {
+        return;
+    }
+
+    const float worst = ascending_ ? std::numeric_limits<float>::max() : -std::numeric_limits<float>::max();
+    std::vector<float> pad_distances(nq_ * topk_, worst);
+    std::vector<int64_t> pad_labels(nq_ * topk_, -1);
+
+    cudaSetDevice(device_id_);
+    cudaMemcpy(d_distances_ + slot * nq_ * topk_, pad_distances.data(), pad_distances.size() * sizeof(float),
+               cudaMemcpyHostToDevice);
+    cudaMemcpy(d_labels_ + slot * nq_ * topk_, pad_labels.data(), pad_labels.size() * sizeof(int64_t),
+               cudaMemcpyHostToDevice);
+}
+
+bool
+GpuSearchReducer::HasResults() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slot_count_ > 0;
+}
+
+Status
+GpuSearchReducer::Reduce(std::vector<int64_t>& ids, std::vector<float>& distances) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (slot_count_ == 0 || d_distances_ == nullptr) {
+        FreeSlab();
+        return Status(KNOWHERE_ERROR, "GpuSearchReducer: nothing deposited");
+    }
+
+    float* d_out_distances = nullptr;
+    int64_t* d_out_labels = nullptr;
+
+    Status status = Status::OK();
+    try {
+        cudaSetDevice(device_id_);
+        size_t out_size = nq_ * topk_;
+        if (cudaMalloc(&d_out_distances, out_size * sizeof(float)) != cudaSuccess ||
+            cudaMalloc(&d_out_labels, out_size * sizeof(int64_t)) != cudaSuccess) {
+            throw std::runtime_error("GpuSearchReducer: output allocation failed");
+        }
+
+        // the legacy default stream synchronizes with the blocking streams the
+        // per-segment searches ran on, so the slots are complete by the time
+        // the selection kernel reads them
+        faiss::gpu::runMergeTopK(d_distances_, d_labels_, slot_count_, nq_, topk_, !ascending_, d_out_distances,
+                                 d_out_labels, 0);
+
+        ids.resize(out_size);
+        distances.resize(out_size);
+        if (cudaMemcpy(distances.data(), d_out_distances, out_size * sizeof(float), cudaMemcpyDeviceToHost) !=
+                cudaSuccess ||
+            cudaMemcpy(ids.data(), d_out_labels, out_size * sizeof(int64_t), cudaMemcpyDeviceToHost) != cudaSuccess) {
+            throw std::runtime_error("GpuSearchReducer: copying the final topk to host failed");
+        }
+    } catch (faiss::FaissException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        status = Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        status = Status(KNOWHERE_ERROR, e.what());
+    }
+
+    if (d_out_distances != nullptr) {
+        cudaFree(d_out_distances);
+    }
+    if (d_out_labels != nullptr) {
+        cudaFree(d_out_labels);
+    }
+    FreeSlab();
+    slot_count_ = 0;
+    return status;
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,84 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "utils/Status.h"
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Device-side reduction of one search job's per-segment topk results.
+ *
+ * A SearchJob creates one reducer per GPU its tasks land on. Each task
+ * acquires a [nq, topk] slot inside a single device slab and searches
+ * straight into it, so segment results never cross PCIe; Reduce() runs the
+ * fused k-selection over all slots on the device and copies only the final
+ * topk back to the host.
+ */
+class GpuSearchReducer {
+ public:
+    GpuSearchReducer(int64_t device_id, uint64_t nq, uint64_t topk, bool ascending);
+    ~GpuSearchReducer();
+
+    // Hand out the next free slot as raw device pointers. Returns -1 when the
+    // slab is full or device allocation failed; the caller then falls back to
+    // the host merge path.
+    int64_t
+    AcquireSlot(float** d_distances, int64_t** d_labels);
+
+    // A slot whose search failed holds garbage; overwrite it with the padding
+    // the reduction treats as "no hit".
+    void
+    AbortSlot(int64_t slot);
+
+    // Fused k-selection across every acquired slot; only the final topk
+    // crosses PCIe. Frees the device slab, so call it once.
+    Status
+    Reduce(std::vector<int64_t>& ids, std::vector<float>& distances);
+
+    bool
+    HasResults() const;
+
+    int64_t
+    device_id() const {
+        return device_id_;
+    }
+
+ private:
+    // under mutex_
+    bool
+    AllocateSlab();
+
+    void
+    FreeSlab();
+
+    int64_t device_id_;
+    uint64_t nq_;
+    uint64_t topk_;
+    bool ascending_;
+
+    mutable std::mutex mutex_;
+    uint64_t slot_count_ = 0;
+    bool alloc_failed_ = false;
+    float* d_distances_ = nullptr;
+    int64_t* d_labels_ = nullptr;
+};
+
+using GpuSearchReducerPtr = std::shared_ptr<GpuSearchReducer>;
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,158 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+// Microbenchmarks for the hot paths the unit tests only cover for correctness:
+// topk result merging, the task table pick loops and the cache under
+// contention. Run `milvus_bench --benchmark_format=json` before and after a
+// change and feed both files to scripts/compare_bench.py.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cache/Cache.h"
+#include "cache/DataObj.h"
+#include "scheduler/TaskTable.h"
+#include "scheduler/task/SearchTask.h"
+#include "scheduler/task/TestTask.h"
+#include "server/context/Context.h"
+
+namespace {
+
+class BenchDataObj : public milvus::cache::DataObj {
+ public:
+    explicit BenchDataObj(int64_t size) : size_(size) {
+    }
+
+    int64_t
+    Size() override {
+        return size_;
+    }
+
+ private:
+    int64_t size_;
+};
+
+}  // namespace
+
+static void
+BM_MergeTopkToResultSet(benchmark::State& state) {
+    auto nq = static_cast<size_t>(state.range(0));
+    auto topk = static_cast<size_t>(state.range(1));
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> jitter(0.0f, 1.0f);
+    milvus::scheduler::ResultIds src_ids(nq * topk);
+    milvus::scheduler::ResultDistances src_distances(nq * topk);
+    for (size_t i = 0; i < nq; ++i) {
+        for (size_t k = 0; k < topk; ++k) {
+            // each row ascending, as produced by a single segment search
+            src_ids[i * topk + k] = static_cast<int64_t>(i * topk + k);
+            src_distances[i * topk + k] = static_cast<float>(k) + jitter(gen);
+        }
+    }
+
+    for (auto _ : state) {
+        milvus::scheduler::ResultIds tar_ids;
+        milvus::scheduler::ResultDistances tar_distances;
+        // first call fills the empty target, second one exercises the merge
+        milvus::scheduler::XSearchTask::MergeTopkToResultSet(src_ids, src_distances, topk, nq, topk, true, tar_ids,
+                                                             tar_distances);
+        milvus::scheduler::XSearchTask::MergeTopkToResultSet(src_ids, src_distances, topk, nq, topk, true, tar_ids,
+                                                             tar_distances);
+        benchmark::DoNotOptimize(tar_ids.data());
+        benchmark::DoNotOptimize(tar_distances.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(nq * topk) * 2);
+}
+BENCHMARK(BM_MergeTopkToResultSet)
+    ->Args({1, 64})
+    ->Args({16, 64})
+    ->Args({16, 1024})
+    ->Args({256, 64})
+    ->Args({256, 1024});
+
+static void
+BM_TaskTablePickLoops(benchmark::State& state) {
+    auto task_count = static_cast<uint64_t>(state.range(0));
+
+    std::vector<milvus::scheduler::TaskPtr> tasks;
+    tasks.reserve(task_count);
+    milvus::scheduler::TableFileSchemaPtr dummy_file = nullptr;
+    auto context = std::make_shared<milvus::server::Context>("bench_request_id");
+    for (uint64_t i = 0; i < task_count; ++i) {
+        tasks.emplace_back(std::make_shared<milvus::scheduler::TestTask>(context, dummy_file, nullptr));
+    }
+
+    for (auto _ : state) {
+        milvus::scheduler::TaskTable table;
+        for (auto& task : tasks) {
+            table.Put(task);
+        }
+
+        // drive every task through the same pick loops the resource threads
+        // run; PickToLoad bails out while more than two items sit loaded, so
+        // load and execute have to interleave
+        uint64_t executed = 0;
+        while (executed < task_count) {
+            auto to_load = table.PickToLoad(2);
+            for (auto index : to_load) {
+                table.at(index)->Load();
+                table.at(index)->Loaded();
+            }
+            auto to_execute = table.PickToExecute(4);
+            for (auto index : to_execute) {
+                table.at(index)->Execute();
+                table.at(index)->Executed();
+            }
+            executed += to_execute.size();
+            if (to_load.empty() && to_execute.empty()) {
+                break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(task_count));
+}
+BENCHMARK(BM_TaskTablePickLoops)->Arg(16)->Arg(256)->Arg(1024);
+
+static void
+BM_CacheInsertGet(benchmark::State& state) {
+    static std::shared_ptr<milvus::cache::Cache<milvus::cache::DataObjPtr>> cache;
+    if (state.thread_index == 0) {
+        cache = std::make_shared<milvus::cache::Cache<milvus::cache::DataObjPtr>>(1LL << 30, 1 << 16);
+    }
+
+    constexpr int64_t key_space = 1024;
+    constexpr int64_t gets_per_insert = 8;
+    milvus::cache::DataObjPtr item = std::make_shared<BenchDataObj>(1 << 20);
+
+    int64_t i = 0;
+    for (auto _ : state) {
+        auto key = "bench_item_" + std::to_string((state.thread_index * 31 + i) % key_space);
+        if (i % gets_per_insert == 0) {
+            cache->insert(key, item);
+        } else {
+            benchmark::DoNotOptimize(cache->get(key));
+        }
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index == 0) {
+        cache.reset();
+    }
+}
+BENCHMARK(BM_CacheInsertGet)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -14,8 +14,10 @@
 #include <fiu-local.h>
 
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <random>
 #include <thread>
+#include <utility>
 
 #include "cache/CpuCacheMgr.h"
 #include "db/Constants.h"
@@ -471,6 +473,22 @@ TEST_F(DBTest, PRELOADTABLE_TEST) {
     stat = db_->PreloadTable(TABLE_NAME);
     ASSERT_TRUE(stat.ok());
 
+    // the sharded router lists searchable segments through the same scoping
+    std::vector<std::pair<std::string, std::vector<std::string>>> table_files;
+    stat = db_->GetSearchFileIds(TABLE_NAME, std::vector<std::string>(), table_files);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_FALSE(table_files.empty());
+    ASSERT_EQ(table_files[0].first, TABLE_NAME);
+    ASSERT_FALSE(table_files[0].second.empty());
+
+    // scoped preload: only the tagged partition is considered, so an empty
+    // partition loads nothing into cache
+    prev_cache_usage = milvus::cache::CpuCacheMgr::GetInstance()->CacheUsage();
+    stat = db_->PreloadTable(TABLE_NAME, false, 0, {"0"});
+    ASSERT_TRUE(stat.ok());
+    cur_cache_usage = milvus::cache::CpuCacheMgr::GetInstance()->CacheUsage();
+    ASSERT_EQ(prev_cache_usage, cur_cache_usage);
+
     FIU_ENABLE_FIU("DBImpl.PreloadTable.null_engine");
     stat = db_->PreloadTable(TABLE_NAME);
     ASSERT_FALSE(stat.ok());
@@ -485,6 +503,54 @@ TEST_F(DBTest, PRELOADTABLE_TEST) {
     stat = db_->PreloadTable(TABLE_NAME);
     ASSERT_FALSE(stat.ok());
     fiu_disable("DBImpl.PreloadTable.engine_throw_exception");
+
+    // without a warm-state snapshot the recovery order is left untouched
+    std::vector<std::string> order = {"zzz", TABLE_NAME, "aaa"};
+    stat = db_->OrderTablesByWarmth(order);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(order[0], "zzz");
+    ASSERT_EQ(order[2], "aaa");
+}
+
+TEST_F(DBTest, EXPORT_TABLE_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t nb = 10000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    stat = db_->InsertVectors(TABLE_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+
+    std::this_thread::sleep_for(std::chrono::seconds(3));  // wait until the rows are flushed to a raw file
+
+    uint64_t exported_rows = 0;
+    std::vector<int64_t> exported_ids;
+    stat = db_->ExportTable(TABLE_NAME, [&](int64_t count, const float* vectors, const int64_t* ids) {
+        exported_rows += count;
+        exported_ids.insert(exported_ids.end(), ids, ids + count);
+        return true;
+    });
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(exported_rows, nb);
+
+    std::sort(exported_ids.begin(), exported_ids.end());
+    std::vector<int64_t> inserted_ids(xb.id_array_.begin(), xb.id_array_.end());
+    std::sort(inserted_ids.begin(), inserted_ids.end());
+    ASSERT_EQ(exported_ids, inserted_ids);
+
+    // cancelling after the first slab stops the export without an error
+    int64_t chunks = 0;
+    stat = db_->ExportTable(TABLE_NAME, [&](int64_t count, const float* vectors, const int64_t* ids) {
+        ++chunks;
+        return false;
+    });
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(chunks, 1);
+
+    stat = db_->ExportTable("export_table_not_exist", [](int64_t, const float*, const int64_t*) { return true; });
+    ASSERT_FALSE(stat.ok());
 }
 
 TEST_F(DBTest, SHUTDOWN_TEST) {
@@ -20,8 +20,12 @@
 #include <fiu-local.h>
 #include <src/db/DBFactory.h>
 
+#include "db/AttrSidecar.h"
 #include "db/Constants.h"
 #include "db/engine/EngineFactory.h"
+#include "db/insert/IngestQueue.h"
+#include "db/insert/VectorNormalizer.h"
+#include "db/insert/WalManager.h"
 #include "db/insert/MemTable.h"
 #include "db/insert/MemTableFile.h"
 #include "db/insert/VectorSource.h"
@@ -173,6 +177,61 @@ TEST_F(MemManagerTest, MEM_TABLE_FILE_TEST) {
     }
 }
 
+TEST_F(MemManagerTest, ATTR_SIDECAR_TEST) {
+    std::string location = "/tmp/milvus_attr_sidecar_test";
+    boost::filesystem::remove(location + ".attr");
+
+    milvus::engine::IDNumbers ids = {1, 2, 3, 4};
+    milvus::engine::AttributeColumns columns;
+    columns["category"] = {"shoes", "hats", "shoes", "hats"};
+    columns["region"] = {"eu", "eu", "us"};  // short column, padded on write
+
+    auto status = milvus::engine::AttrSidecar::Write(location, ids, columns);
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_TRUE(milvus::engine::AttrSidecar::Exists(location));
+
+    milvus::engine::IDNumbers read_ids;
+    milvus::engine::AttributeColumns read_columns;
+    status = milvus::engine::AttrSidecar::Read(location, read_ids, read_columns);
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_EQ(read_ids, ids);
+    ASSERT_EQ(read_columns["category"][2], "shoes");
+    ASSERT_EQ(read_columns["region"][3], "");
+
+    // AND across columns, OR within a column's accepted values
+    milvus::engine::AttributeFilter filter;
+    filter.conditions_["category"] = {"shoes"};
+    filter.conditions_["region"] = {"eu", "us"};
+    std::vector<milvus::engine::IDNumber> matches;
+    bool unfiltered = true;
+    status = milvus::engine::AttrSidecar::Match(location, filter, matches, unfiltered);
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_FALSE(unfiltered);
+    ASSERT_EQ(matches, (std::vector<milvus::engine::IDNumber>{1, 3}));
+
+    // a column the segment never saw matches nothing
+    filter.conditions_["missing"] = {"x"};
+    status = milvus::engine::AttrSidecar::Match(location, filter, matches, unfiltered);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(matches.empty());
+
+    // a segment without a sidecar must be searched unfiltered
+    status = milvus::engine::AttrSidecar::Match("/tmp/milvus_attr_sidecar_absent", filter, matches, unfiltered);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(unfiltered);
+
+    // merge-style append back-fills columns the other side never saw
+    milvus::engine::AttributeColumns src;
+    src["color"] = {"red", "blue"};
+    milvus::engine::AttrSidecar::AppendColumns(read_columns, read_ids.size(), src, 0, 2);
+    ASSERT_EQ(read_columns["color"].size(), read_ids.size() + 2);
+    ASSERT_EQ(read_columns["color"][read_ids.size()], "red");
+    ASSERT_EQ(read_columns["color"][0], "");
+
+    milvus::engine::AttrSidecar::Evict(location);
+    boost::filesystem::remove(location + ".attr");
+}
+
 TEST_F(MemManagerTest, MEM_TABLE_TEST) {
     auto options = GetOptions();
 
@@ -250,6 +309,135 @@ TEST_F(MemManagerTest, MEM_TABLE_TEST) {
     fiu_disable("SqliteMetaImpl.UpdateTableFile.throw_exception");
 }
 
+TEST_F(MemManagerTest, INGEST_QUEUE_TEST) {
+    milvus::engine::IngestQueue queue;
+    ASSERT_EQ(queue.StagedMem(), 0);
+    ASSERT_TRUE(queue.DrainAll().empty());
+
+    // concurrent producers deposit chunks tagged with their thread id
+    constexpr int thread_count = 4;
+    constexpr int chunks_per_thread = 50;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; t++) {
+        threads.emplace_back([&queue, t] {
+            for (int i = 0; i < chunks_per_thread; i++) {
+                milvus::engine::VectorsData chunk;
+                chunk.vector_count_ = 1;
+                chunk.float_data_.resize(TABLE_DIM);
+                chunk.id_array_ = {t * chunks_per_thread + i};
+                queue.Push(std::move(chunk));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(queue.StagedMem(), thread_count * chunks_per_thread * (TABLE_DIM * sizeof(float) + sizeof(int64_t)));
+
+    auto chunks = queue.DrainAll();
+    ASSERT_EQ(chunks.size(), thread_count * chunks_per_thread);
+    ASSERT_EQ(queue.StagedMem(), 0);
+
+    // per-producer order is preserved even though producers interleave
+    std::vector<int64_t> last_id(thread_count, -1);
+    for (auto& chunk : chunks) {
+        ASSERT_EQ(chunk.id_array_.size(), 1);
+        int64_t id = chunk.id_array_[0];
+        int producer = id / chunks_per_thread;
+        ASSERT_GT(id, last_id[producer]);
+        last_id[producer] = id;
+    }
+}
+
+TEST_F(MemManagerTest, VECTOR_NORMALIZER_TEST) {
+    constexpr int64_t count = 10;
+    milvus::engine::VectorsData vectors;
+    BuildVectors(count, vectors);
+    auto original = vectors.float_data_;
+
+    // the fifth vector is all zero and must not be touched
+    for (int64_t j = 0; j < TABLE_DIM; j++) {
+        vectors.float_data_[5 * TABLE_DIM + j] = 0.0f;
+    }
+
+    milvus::engine::normalizer::NormalizeVectors(vectors.float_data_.data(), count, TABLE_DIM);
+
+    for (int64_t i = 0; i < count; i++) {
+        double norm = 0.0;
+        for (int64_t j = 0; j < TABLE_DIM; j++) {
+            norm += vectors.float_data_[i * TABLE_DIM + j] * vectors.float_data_[i * TABLE_DIM + j];
+        }
+        if (i == 5) {
+            ASSERT_EQ(norm, 0.0);
+        } else {
+            ASSERT_NEAR(std::sqrt(norm), 1.0, 1e-5);
+        }
+    }
+
+    // direction is preserved, only the length changes
+    double scale = 0.0;
+    for (int64_t j = 0; j < TABLE_DIM; j++) {
+        scale += original[j] * original[j];
+    }
+    scale = std::sqrt(scale);
+    for (int64_t j = 0; j < TABLE_DIM; j++) {
+        ASSERT_NEAR(vectors.float_data_[j] * scale, original[j], 1e-4 * scale);
+    }
+}
+
+TEST_F(MemManagerTest, WAL_TEST) {
+    std::string wal_path = "/tmp/milvus_wal_test";
+    boost::filesystem::remove_all(wal_path);
+
+    constexpr int chunk_count = 10;
+    {
+        milvus::engine::WalManager wal(wal_path);
+        ASSERT_TRUE(wal.Open().ok());
+        for (int i = 0; i < chunk_count; i++) {
+            milvus::engine::VectorsData chunk;
+            chunk.vector_count_ = 2;
+            chunk.float_data_.resize(2 * TABLE_DIM, 0.1f * i);
+            chunk.id_array_ = {2 * i, 2 * i + 1};
+            ASSERT_TRUE(wal.Append(GetTableName(), chunk).ok());
+        }
+        ASSERT_EQ(wal.CurrentLsn(), chunk_count);
+    }
+
+    // a new instance over the same directory sees all appended records
+    {
+        milvus::engine::WalManager wal(wal_path);
+        ASSERT_TRUE(wal.Open().ok());
+        int64_t replayed = 0;
+        auto status = wal.Replay([&](const std::string& table_id, milvus::engine::VectorsData& vectors) {
+            EXPECT_EQ(table_id, GetTableName());
+            EXPECT_EQ(vectors.vector_count_, 2);
+            EXPECT_EQ(vectors.id_array_, (milvus::engine::IDNumbers{2 * replayed, 2 * replayed + 1}));
+            replayed++;
+            return milvus::Status::OK();
+        });
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(replayed, chunk_count);
+        ASSERT_EQ(wal.CurrentLsn(), chunk_count);
+
+        // a flush covering every record empties the log
+        ASSERT_TRUE(wal.Truncate(wal.CurrentLsn()).ok());
+    }
+
+    {
+        milvus::engine::WalManager wal(wal_path);
+        ASSERT_TRUE(wal.Open().ok());
+        int64_t replayed = 0;
+        ASSERT_TRUE(wal.Replay([&](const std::string&, milvus::engine::VectorsData&) {
+                           replayed++;
+                           return milvus::Status::OK();
+                       }).ok());
+        ASSERT_EQ(replayed, 0);
+    }
+
+    boost::filesystem::remove_all(wal_path);
+}
+
 TEST_F(MemManagerTest2, SERIAL_INSERT_SEARCH_TEST) {
     milvus::engine::meta::TableSchema table_info = BuildTableSchema();
     auto stat = db_->CreateTable(table_info);
@@ -403,6 +591,99 @@ TEST_F(MemManagerTest2, CONCURRENT_INSERT_SEARCH_TEST) {
     search.join();
 }
 
+TEST_F(MemManagerTest2, GET_VECTORS_BY_ID_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nb = 10000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+
+    for (int64_t i = 0; i < nb; i++) {
+        xb.id_array_.push_back(i);
+    }
+
+    stat = db_->InsertVectors(GetTableName(), "", xb);
+    ASSERT_TRUE(stat.ok());
+
+    std::this_thread::sleep_for(std::chrono::seconds(3));  // ensure raw data write to disk
+
+    milvus::engine::IDNumbers fetch_ids = {0, nb / 2, nb - 1, nb + 12345};  // last id was never inserted
+    std::vector<milvus::engine::VectorsData> fetched;
+    stat = db_->GetVectorsByID(GetTableName(), fetch_ids, fetched);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(fetched.size(), fetch_ids.size());
+
+    for (size_t i = 0; i < 3; i++) {
+        ASSERT_EQ(fetched[i].vector_count_, 1);
+        ASSERT_EQ(fetched[i].float_data_.size(), TABLE_DIM);
+        for (int64_t j = 0; j < TABLE_DIM; j++) {
+            ASSERT_FLOAT_EQ(fetched[i].float_data_[j], xb.float_data_[fetch_ids[i] * TABLE_DIM + j]);
+        }
+    }
+    ASSERT_EQ(fetched[3].vector_count_, 0);
+
+    // unknown table
+    stat = db_->GetVectorsByID("table_not_exist", fetch_ids, fetched);
+    ASSERT_FALSE(stat.ok());
+}
+
+TEST_F(MemManagerTest2, DELETE_BY_ID_TEST) {
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nb = 10000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+
+    for (int64_t i = 0; i < nb; i++) {
+        xb.id_array_.push_back(i);
+    }
+
+    stat = db_->InsertVectors(GetTableName(), "", xb);
+    ASSERT_TRUE(stat.ok());
+
+    std::this_thread::sleep_for(std::chrono::seconds(3));  // ensure raw data write to disk
+
+    int64_t victim = nb / 2;
+    milvus::engine::IDNumbers delete_ids = {victim};
+    stat = db_->DeleteByID(GetTableName(), delete_ids);
+    ASSERT_TRUE(stat.ok());
+
+    // the deleted id is gone from fetch, its neighbors stay
+    milvus::engine::IDNumbers fetch_ids = {victim, victim + 1};
+    std::vector<milvus::engine::VectorsData> fetched;
+    stat = db_->GetVectorsByID(GetTableName(), fetch_ids, fetched);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(fetched[0].vector_count_, 0);
+    ASSERT_EQ(fetched[1].vector_count_, 1);
+
+    // searching the deleted vector must not surface its id
+    milvus::engine::VectorsData search;
+    search.vector_count_ = 1;
+    for (int64_t j = 0; j < TABLE_DIM; j++) {
+        search.float_data_.push_back(xb.float_data_[victim * TABLE_DIM + j]);
+    }
+    std::vector<std::string> tags;
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->Query(dummy_context_, GetTableName(), tags, 10, 10, search, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    for (auto id : result_ids) {
+        ASSERT_NE(id, victim);
+    }
+
+    // deleting an unknown id is a no-op
+    delete_ids = {nb + 12345};
+    stat = db_->DeleteByID(GetTableName(), delete_ids);
+    ASSERT_TRUE(stat.ok());
+
+    stat = db_->DeleteByID("table_not_exist", delete_ids);
+    ASSERT_FALSE(stat.ok());
+}
+
 TEST_F(MemManagerTest2, VECTOR_IDS_TEST) {
     milvus::engine::meta::TableSchema table_info = BuildTableSchema();
     auto stat = db_->CreateTable(table_info);
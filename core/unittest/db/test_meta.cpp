@@ -12,6 +12,7 @@
 #include "db/Constants.h"
 #include "db/Utils.h"
 #include "db/meta/MetaConsts.h"
+#include "db/meta/CachedMetaImpl.h"
 #include "db/meta/SqliteMetaImpl.h"
 #include "db/utils.h"
 
@@ -309,6 +310,30 @@ TEST_F(MetaTest, FALID_TEST) {
         status = impl_->FilesToMerge(table.table_id_, dated_files);
         ASSERT_EQ(dated_files[file.date_].size(), 0);
     }
+    {
+        // merge candidates come back smallest first
+        std::vector<size_t> sizes = {300, 100, 200};
+        for (auto size : sizes) {
+            milvus::engine::meta::TableFileSchema file;
+            file.table_id_ = table_id;
+            file.file_type_ = milvus::engine::meta::TableFileSchema::RAW;
+            status = impl_->CreateTableFile(file);
+            ASSERT_TRUE(status.ok());
+            file.file_size_ = size;
+            file.row_count_ = 1;
+            status = impl_->UpdateTableFile(file);
+            ASSERT_TRUE(status.ok());
+        }
+
+        milvus::engine::meta::DatePartionedTableFilesSchema dated_files;
+        status = impl_->FilesToMerge(table.table_id_, dated_files);
+        ASSERT_TRUE(status.ok());
+        for (auto& kv : dated_files) {
+            for (size_t i = 1; i < kv.second.size(); ++i) {
+                ASSERT_LE(kv.second[i - 1].file_size_, kv.second[i].file_size_);
+            }
+        }
+    }
     {
         milvus::engine::meta::TableFileSchema file;
         file.table_id_ = table_id;
@@ -751,3 +776,209 @@ TEST_F(MetaTest, INDEX_TEST) {
     status = impl_->UpdateTableFilesToIndex(table_id);
     ASSERT_TRUE(status.ok());
 }
+
+TEST_F(MetaTest, ROLLING_INDEX_UPGRADE_TEST) {
+    auto table_id = "rolling_index_upgrade_test";
+
+    milvus::engine::meta::TableSchema table;
+    table.table_id_ = table_id;
+    auto status = impl_->CreateTable(table);
+    ASSERT_TRUE(status.ok());
+
+    // one raw backup and the index file built from it
+    milvus::engine::meta::TableFileSchema backup_file;
+    backup_file.table_id_ = table_id;
+    status = impl_->CreateTableFile(backup_file);
+    ASSERT_TRUE(status.ok());
+    backup_file.file_type_ = milvus::engine::meta::TableFileSchema::BACKUP;
+    status = impl_->UpdateTableFile(backup_file);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::TableFileSchema old_index_file;
+    old_index_file.table_id_ = table_id;
+    old_index_file.source_file_id_ = backup_file.file_id_;
+    status = impl_->CreateTableFile(old_index_file);
+    ASSERT_TRUE(status.ok());
+    old_index_file.file_type_ = milvus::engine::meta::TableFileSchema::INDEX;
+    status = impl_->UpdateTableFile(old_index_file);
+    ASSERT_TRUE(status.ok());
+
+    // rolling update queues the backup for rebuild without touching the index
+    milvus::engine::TableIndex index;
+    index.engine_type_ = 2;
+    status = impl_->UpdateTableIndexRolling(table_id, index);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::TableFilesSchema files;
+    std::vector<int> file_types = {milvus::engine::meta::TableFileSchema::TO_UPGRADE};
+    status = impl_->FilesByType(table_id, file_types, files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(files.size(), 1UL);
+    ASSERT_EQ(files[0].file_id_, backup_file.file_id_);
+
+    file_types = {milvus::engine::meta::TableFileSchema::INDEX};
+    files.clear();
+    status = impl_->FilesByType(table_id, file_types, files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(files.size(), 1UL);
+    ASSERT_EQ(files[0].source_file_id_, backup_file.file_id_);
+
+    // the queued backup is picked up by the index pass
+    milvus::engine::meta::TableFilesSchema to_index_files;
+    status = impl_->FilesToIndex(to_index_files);
+    ASSERT_TRUE(status.ok());
+    bool upgrade_queued = false;
+    for (auto& file : to_index_files) {
+        if (file.file_id_ == backup_file.file_id_) {
+            upgrade_queued = true;
+        }
+    }
+    ASSERT_TRUE(upgrade_queued);
+
+    // cutover: the replacement retires the old index of the same source
+    milvus::engine::meta::TableFileSchema new_index_file;
+    new_index_file.table_id_ = table_id;
+    new_index_file.source_file_id_ = backup_file.file_id_;
+    status = impl_->CreateTableFile(new_index_file);
+    ASSERT_TRUE(status.ok());
+    new_index_file.file_type_ = milvus::engine::meta::TableFileSchema::INDEX;
+    status = impl_->UpdateTableFile(new_index_file);
+    ASSERT_TRUE(status.ok());
+
+    status = impl_->RetireSupersededIndexFile(new_index_file);
+    ASSERT_TRUE(status.ok());
+
+    files.clear();
+    status = impl_->FilesByType(table_id, file_types, files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(files.size(), 1UL);
+    ASSERT_EQ(files[0].file_id_, new_index_file.file_id_);
+
+    // an index file without a source link cannot be retired
+    milvus::engine::meta::TableFileSchema unlinked_file;
+    unlinked_file.table_id_ = table_id;
+    status = impl_->CreateTableFile(unlinked_file);
+    ASSERT_TRUE(status.ok());
+    unlinked_file.file_type_ = milvus::engine::meta::TableFileSchema::INDEX;
+    status = impl_->RetireSupersededIndexFile(unlinked_file);
+    ASSERT_FALSE(status.ok());
+}
+
+TEST_F(MetaTest, TABLE_STATS_TEST) {
+    auto cached = std::make_shared<milvus::engine::meta::CachedMetaImpl>(impl_);
+
+    auto table_id = "table_stats_test";
+    milvus::engine::meta::TableSchema table;
+    table.table_id_ = table_id;
+    auto status = cached->CreateTable(table);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::TableFileSchema table_file;
+    table_file.table_id_ = table_id;
+
+    // two stored files and one NEW file that must not be counted
+    for (auto i = 0; i < 2; ++i) {
+        status = cached->CreateTableFile(table_file);
+        ASSERT_TRUE(status.ok());
+        table_file.file_type_ = milvus::engine::meta::TableFileSchema::RAW;
+        table_file.row_count_ = 100;
+        table_file.file_size_ = 1000;
+        status = cached->UpdateTableFile(table_file);
+        ASSERT_TRUE(status.ok());
+    }
+    status = cached->CreateTableFile(table_file);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::TableStats stats;
+    status = cached->GetTableStats(table_id, stats);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(stats.row_count_, 200UL);
+    ASSERT_EQ(stats.data_size_, 2000UL);
+    ASSERT_EQ(stats.file_count_, 2UL);
+
+    // Count is served from the same aggregates
+    uint64_t row_count = 0;
+    status = cached->Count(table_id, row_count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(row_count, 200UL);
+
+    status = cached->Count("table_not_exist", row_count);
+    ASSERT_FALSE(status.ok());
+
+    // a file write-through invalidates the cached entry
+    table_file.file_type_ = milvus::engine::meta::TableFileSchema::RAW;
+    table_file.row_count_ = 50;
+    table_file.file_size_ = 500;
+    status = cached->UpdateTableFile(table_file);
+    ASSERT_TRUE(status.ok());
+
+    status = cached->GetTableStats(table_id, stats);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(stats.row_count_, 250UL);
+    ASSERT_EQ(stats.file_count_, 3UL);
+
+    status = cached->DropTable(table_id);
+    ASSERT_TRUE(status.ok());
+}
+
+TEST_F(MetaTest, CACHED_META_TEST) {
+    auto cached = std::make_shared<milvus::engine::meta::CachedMetaImpl>(impl_);
+
+    auto table_id = "cached_meta_test";
+    milvus::engine::meta::TableSchema table;
+    table.table_id_ = table_id;
+    auto status = cached->CreateTable(table);
+    ASSERT_TRUE(status.ok());
+
+    // reads come from the snapshot and match what the backend stored
+    bool has_table = false;
+    status = cached->HasTable(table_id, has_table);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(has_table);
+
+    milvus::engine::meta::TableSchema described;
+    described.table_id_ = table_id;
+    status = cached->DescribeTable(described);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(described.id_, table.id_);
+    ASSERT_EQ(described.dimension_, table.dimension_);
+
+    described.table_id_ = "not_found";
+    status = cached->DescribeTable(described);
+    ASSERT_FALSE(status.ok());
+
+    // a mutation through the decorator refreshes the snapshot
+    milvus::engine::TableIndex index;
+    index.metric_type_ = 2;
+    index.nlist_ = 1234;
+    index.engine_type_ = 3;
+    status = cached->UpdateTableIndex(table_id, index);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::TableIndex index_out;
+    status = cached->DescribeTableIndex(table_id, index_out);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(index_out.nlist_, index.nlist_);
+    ASSERT_EQ(index_out.engine_type_, index.engine_type_);
+
+    // partition lookups are snapshot-served as well
+    status = cached->CreatePartition(table_id, "", "tag_0");
+    ASSERT_TRUE(status.ok());
+
+    std::string partition_name;
+    status = cached->GetPartitionName(table_id, " tag_0 ", partition_name);
+    ASSERT_TRUE(status.ok());
+    ASSERT_FALSE(partition_name.empty());
+
+    std::vector<milvus::engine::meta::TableSchema> partitions;
+    status = cached->ShowPartitions(table_id, partitions);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(partitions.size(), 1UL);
+    ASSERT_EQ(partitions[0].table_id_, partition_name);
+
+    status = cached->DropTable(table_id);
+    ASSERT_TRUE(status.ok());
+    status = cached->HasTable(table_id, has_table);
+    ASSERT_TRUE(status.ok());
+    ASSERT_FALSE(has_table);
+}
@@ -9,17 +9,25 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include "db/IDGenerator.h"
 #include "db/IndexFailedChecker.h"
 #include "db/OngoingFileChecker.h"
+#include "db/IdIndex.h"
+#include "db/SearchFilesCache.h"
+#include "db/FileSchemaIntern.h"
+#include "db/SegmentSizeTuner.h"
 #include "db/Options.h"
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
 #include "db/meta/SqliteMetaImpl.h"
+#include "server/Config.h"
 #include "utils/Exception.h"
 #include "utils/Status.h"
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <fstream>
 #include <thread>
 #include <vector>
 #include <fiu-local.h>
@@ -156,6 +164,93 @@ TEST(DBMiscTest, UTILS_TEST) {
     ASSERT_TRUE(status.ok());
 }
 
+TEST(DBMiscTest, TIERING_TEST) {
+    milvus::engine::DBMetaOptions options;
+    options.path_ = "/tmp/milvus_tier_test/main";
+    options.slave_paths_.push_back("/tmp/milvus_tier_test/nvme");
+    options.slave_paths_.push_back("/tmp/milvus_tier_test/sata");
+    options.path_device_class_["/tmp/milvus_tier_test/nvme"] = milvus::engine::utils::TIER_DEVICE_CLASS_HOT;
+    options.path_device_class_["/tmp/milvus_tier_test/sata"] = milvus::engine::utils::TIER_DEVICE_CLASS_COLD;
+
+    milvus::server::Config& config = milvus::server::Config::GetInstance();
+    ASSERT_TRUE(config.SetStorageConfigHotTierDays("30").ok());
+    ASSERT_FALSE(config.SetStorageConfigHotTierDays("pagoda").ok());
+
+    ASSERT_TRUE(milvus::engine::utils::IsPartitionHot(milvus::engine::utils::GetDate(), 30));
+    ASSERT_FALSE(milvus::engine::utils::IsPartitionHot(milvus::engine::utils::GetDateWithDelta(-60), 30));
+    // disabled tiering treats everything as hot
+    ASSERT_TRUE(milvus::engine::utils::IsPartitionHot(milvus::engine::utils::GetDateWithDelta(-60), 0));
+
+    const std::string TABLE_NAME = "tier_tbl";
+    auto status = milvus::engine::utils::CreateTablePath(options, TABLE_NAME);
+    ASSERT_TRUE(status.ok());
+
+    // a fresh partition never lands on the cold-tagged path
+    milvus::engine::meta::TableFileSchema hot_file;
+    hot_file.table_id_ = TABLE_NAME;
+    hot_file.file_id_ = "hot_file";
+    hot_file.file_type_ = milvus::engine::meta::TableFileSchema::NEW_INDEX;
+    hot_file.date_ = milvus::engine::utils::GetDate();
+    for (size_t i = 0; i < 4; ++i) {  // exercise the index-file round robin
+        status = milvus::engine::utils::CreateTableFilePath(options, hot_file);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(hot_file.location_.find("/sata/"), std::string::npos);
+    }
+
+    // an aged partition never lands on the hot-tagged path
+    milvus::engine::meta::TableFileSchema cold_file;
+    cold_file.id_ = 7;
+    cold_file.table_id_ = TABLE_NAME;
+    cold_file.file_id_ = "cold_file";
+    cold_file.file_type_ = milvus::engine::meta::TableFileSchema::NEW_INDEX;
+    cold_file.date_ = milvus::engine::utils::GetDateWithDelta(-60);
+    for (size_t i = 0; i < 4; ++i) {
+        status = milvus::engine::utils::CreateTableFilePath(options, cold_file);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(cold_file.location_.find("/nvme/"), std::string::npos);
+    }
+
+    // plant a cold-partition file on the hot path, as if the partition aged
+    milvus::engine::meta::TableFileSchema stray;
+    stray.table_id_ = TABLE_NAME;
+    stray.file_id_ = "stray_file";
+    stray.date_ = milvus::engine::utils::GetDateWithDelta(-60);
+    std::string hot_parent =
+        "/tmp/milvus_tier_test/nvme/tables/" + TABLE_NAME + "/" + std::to_string(stray.date_);
+    boost::filesystem::create_directories(hot_parent);
+    {
+        std::ofstream outfile(hot_parent + "/" + stray.file_id_);
+        outfile << "tier";
+    }
+
+    bool migrated = false;
+    status = milvus::engine::utils::MigrateTableFileToCold(options, stray, migrated);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(migrated);
+    ASSERT_FALSE(boost::filesystem::exists(hot_parent + "/" + stray.file_id_));
+    ASSERT_EQ(stray.location_.find("/nvme/"), std::string::npos);
+    ASSERT_TRUE(boost::filesystem::exists(stray.location_));
+
+    // the path probe finds the migrated copy, content intact
+    milvus::engine::meta::TableFileSchema probe = stray;
+    probe.location_.clear();
+    status = milvus::engine::utils::GetTableFilePath(options, probe);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(probe.location_, stray.location_);
+    std::ifstream infile(probe.location_);
+    std::string content;
+    infile >> content;
+    ASSERT_EQ(content, "tier");
+
+    // already on an acceptable tier: a second pass is a no-op
+    status = milvus::engine::utils::MigrateTableFileToCold(options, stray, migrated);
+    ASSERT_TRUE(status.ok());
+    ASSERT_FALSE(migrated);
+
+    ASSERT_TRUE(config.SetStorageConfigHotTierDays("0").ok());
+    boost::filesystem::remove_all("/tmp/milvus_tier_test");
+}
+
 TEST(DBMiscTest, CHECKER_TEST) {
     {
         milvus::engine::IndexFailedChecker checker;
@@ -212,4 +307,224 @@ TEST(DBMiscTest, CHECKER_TEST) {
         checker.UnmarkOngoingFile(schema);
         ASSERT_FALSE(checker.IsIgnored(schema));
     }
+
+    {
+        // the drain callback fires when the last reference to a file the
+        // cleanup pass already deferred goes away
+        milvus::engine::OngoingFileChecker checker;
+        std::string drained_table;
+        checker.SetDrainCallback([&](const std::string& table_id) { drained_table = table_id; });
+
+        milvus::engine::meta::TableFileSchema schema;
+        schema.table_id_ = "ccc";
+        schema.file_id_ = "5002";
+        checker.MarkOngoingFile(schema);
+
+        checker.UnmarkOngoingFile(schema);
+        ASSERT_TRUE(drained_table.empty());  // cleanup never deferred this file
+
+        checker.MarkOngoingFile(schema);
+        ASSERT_TRUE(checker.IsIgnored(schema));  // the deferral
+        checker.UnmarkOngoingFile(schema);
+        ASSERT_EQ(drained_table, "ccc");
+    }
+}
+
+TEST(DBMiscTest, ID_INDEX_TEST) {
+    auto& id_index = milvus::engine::IdIndex::GetInstance();
+
+    milvus::engine::IDNumbers ids;
+    for (int64_t i = 0; i < 1000; i++) {
+        ids.push_back(i);
+    }
+    id_index.RegisterSegment("idx_table", "/tmp/idx_segment_1", ids);
+
+    // registered ids hit, absent ids (almost always) miss
+    ASSERT_TRUE(id_index.TableMayContain("idx_table", 500));
+    int64_t false_positives = 0;
+    for (int64_t i = 100000; i < 101000; i++) {
+        if (id_index.TableMayContain("idx_table", i)) {
+            false_positives++;
+        }
+    }
+    ASSERT_LT(false_positives, 100);
+    ASSERT_FALSE(id_index.TableMayContain("idx_other_table", 500));
+
+    // tombstones record the mark time per id
+    ASSERT_FALSE(id_index.HasTombstones("idx_table"));
+    ASSERT_EQ(id_index.SupersededTime("idx_table", 500), 0);
+    id_index.MarkSuperseded("idx_table", 500, 12345);
+    ASSERT_TRUE(id_index.HasTombstones("idx_table"));
+    ASSERT_EQ(id_index.SupersededTime("idx_table", 500), 12345);
+    ASSERT_EQ(id_index.SupersededTime("idx_table", 501), 0);
+
+    id_index.UnregisterTable("idx_table");
+    ASSERT_FALSE(id_index.TableMayContain("idx_table", 500));
+    ASSERT_FALSE(id_index.HasTombstones("idx_table"));
+
+    // pending ids are exact while unflushed and drain once their segment
+    // filter is registered
+    milvus::engine::IDNumbers pending_ids = {10, 11, 12};
+    id_index.AddPending("idx_table", pending_ids);
+    ASSERT_TRUE(id_index.PendingContains("idx_table", 11));
+    ASSERT_FALSE(id_index.PendingContains("idx_table", 13));
+    ASSERT_FALSE(id_index.PendingContains("idx_other_table", 11));
+
+    id_index.RegisterSegment("idx_table", "/tmp/idx_segment_2", pending_ids);
+    ASSERT_FALSE(id_index.PendingContains("idx_table", 11));
+    ASSERT_TRUE(id_index.TableMayContain("idx_table", 11));
+    id_index.UnregisterTable("idx_table");
+}
+
+TEST(DBMiscTest, DIM_PADDING_TEST) {
+    // knob defaults to off: the physical stride equals the logical dimension
+    ASSERT_EQ(milvus::engine::PhysicalDimension(300, milvus::engine::MetricType::L2), 300);
+    // binary metrics never pad regardless of the knob
+    ASSERT_EQ(milvus::engine::PhysicalDimension(300, milvus::engine::MetricType::HAMMING), 300);
+
+    // widening restride: each row lands at the padded offset, tail is zero
+    std::vector<float> rows = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    std::vector<float> padded;
+    milvus::engine::RestrideRows(2, 3, 4, rows.data(), padded);
+    ASSERT_EQ(padded.size(), 8UL);
+    ASSERT_FLOAT_EQ(padded[2], 3.0f);
+    ASSERT_FLOAT_EQ(padded[3], 0.0f);
+    ASSERT_FLOAT_EQ(padded[4], 4.0f);
+    ASSERT_FLOAT_EQ(padded[7], 0.0f);
+
+    // narrowing restride (export/fetch path) drops the alignment zeros again
+    std::vector<float> compact;
+    milvus::engine::RestrideRows(2, 4, 3, padded.data(), compact);
+    ASSERT_EQ(compact.size(), 6UL);
+    for (size_t i = 0; i < rows.size(); i++) {
+        ASSERT_FLOAT_EQ(compact[i], rows[i]);
+    }
+}
+
+TEST(DBMiscTest, SEARCH_FILES_CACHE_TEST) {
+    milvus::engine::SearchFilesCache cache;
+
+    milvus::engine::meta::DatesT dates = {20191101};
+    std::string key = milvus::engine::SearchFilesCache::MakeKey("table_1", {"tag_a", " tag_b "}, dates);
+    // tag order and surrounding blanks do not change the key
+    ASSERT_EQ(key, milvus::engine::SearchFilesCache::MakeKey("table_1", {"tag_b", "tag_a"}, dates));
+
+    milvus::engine::meta::TableFilesSchema files;
+    ASSERT_FALSE(cache.Get(key, files));
+
+    milvus::engine::meta::TableFileSchema schema;
+    schema.table_id_ = "partition_1";
+    schema.file_id_ = "1";
+    files.push_back(schema);
+    cache.Put(key, {"table_1", "partition_1"}, files);
+
+    milvus::engine::meta::TableFilesSchema cached;
+    ASSERT_TRUE(cache.Get(key, cached));
+    ASSERT_EQ(cached.size(), 1UL);
+
+    // invalidating an uninvolved table leaves the entry alone
+    cache.Invalidate("table_2");
+    ASSERT_TRUE(cache.Get(key, cached));
+
+    // invalidating any table the list was assembled from drops it
+    cache.Invalidate("partition_1");
+    ASSERT_FALSE(cache.Get(key, cached));
+
+    cache.Put(key, {"table_1"}, files);
+    cache.InvalidateAll();
+    ASSERT_FALSE(cache.Get(key, cached));
+}
+
+TEST(DBMiscTest, FILE_SCHEMA_INTERN_TEST) {
+    milvus::engine::meta::TableFileSchema file;
+    file.id_ = 1;
+    file.table_id_ = "intern_table";
+    file.file_id_ = "intern_file";
+    file.location_ = "/tmp/milvus_test/intern_file";
+    file.updated_time_ = 100;
+
+    auto& intern = milvus::engine::FileSchemaIntern::GetInstance();
+    auto first = intern.Intern(file);
+    ASSERT_EQ(first->location_, file.location_);
+
+    /* the same unchanged row maps to the same descriptor */
+    auto second = intern.Intern(file);
+    ASSERT_EQ(first.get(), second.get());
+
+    /* a state change produces a fresh descriptor */
+    file.updated_time_ = 200;
+    file.file_type_ = milvus::engine::meta::TableFileSchema::TO_DELETE;
+    auto third = intern.Intern(file);
+    ASSERT_NE(first.get(), third.get());
+    ASSERT_EQ(third->file_type_, milvus::engine::meta::TableFileSchema::TO_DELETE);
+
+    /* the refreshed descriptor is the cached one from now on */
+    auto fourth = intern.Intern(file);
+    ASSERT_EQ(third.get(), fourth.get());
+}
+
+TEST(DBMiscTest, SEGMENT_SIZE_TUNER_TEST) {
+    auto& tuner = milvus::engine::SegmentSizeTuner::GetInstance();
+    constexpr int64_t configured = 1024 * 1024 * 1024;  // 1 GB
+
+    // an idle table has no workload evidence and keeps the configured size
+    ASSERT_EQ(tuner.TargetSize("size_tuner_idle_table", configured), configured);
+
+    // a read-only workload pushes the target up toward the 4x cap
+    for (int i = 0; i < 200; ++i) {
+        tuner.RecordQuery("size_tuner_read_table");
+    }
+    ASSERT_GT(tuner.TargetSize("size_tuner_read_table", configured), configured);
+    ASSERT_LE(tuner.TargetSize("size_tuner_read_table", configured), configured * 4);
+
+    // a write-only workload pulls it down toward the 1/4 floor
+    for (int i = 0; i < 200; ++i) {
+        tuner.RecordInsert("size_tuner_write_table");
+    }
+    ASSERT_LT(tuner.TargetSize("size_tuner_write_table", configured), configured);
+    ASSERT_GE(tuner.TargetSize("size_tuner_write_table", configured), configured / 4);
+
+    // slow observed builds cap the target below what the read traffic asks for
+    for (int i = 0; i < 200; ++i) {
+        tuner.RecordQuery("size_tuner_slow_build_table");
+    }
+    tuner.RecordBuild("size_tuner_slow_build_table", 100.0 * 1024 * 1024, 3600.0);
+    auto capped = tuner.TargetSize("size_tuner_slow_build_table", configured);
+    ASSERT_LT(capped, tuner.TargetSize("size_tuner_read_table", configured));
+    ASSERT_GE(capped, configured / 4);
+}
+
+TEST(DBMiscTest, SHARDED_ID_GENERATOR_TEST) {
+    constexpr int64_t thread_count = 8;
+    constexpr int64_t ids_per_thread = 100000;
+
+    // concurrent threads must never see the same id, including bulk grants
+    // larger than one lease and single-id draws mixed together
+    std::vector<std::vector<milvus::engine::IDNumber>> per_thread_ids(thread_count);
+    std::vector<std::thread> threads;
+    for (int64_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&per_thread_ids, i] {
+            milvus::engine::ShardedIDGenerator generator;
+            auto& ids = per_thread_ids[i];
+            ids.reserve(ids_per_thread);
+
+            milvus::engine::IDNumbers bulk;
+            generator.GetNextIDNumbers(ids_per_thread / 2, bulk);
+            ids.insert(ids.end(), bulk.begin(), bulk.end());
+            for (int64_t k = ids_per_thread / 2; k < ids_per_thread; ++k) {
+                ids.push_back(generator.GetNextIDNumber());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<milvus::engine::IDNumber> all_ids;
+    for (auto& ids : per_thread_ids) {
+        ASSERT_EQ(ids.size(), ids_per_thread);
+        all_ids.insert(all_ids.end(), ids.begin(), ids.end());
+    }
+    std::sort(all_ids.begin(), all_ids.end());
+    ASSERT_TRUE(std::adjacent_find(all_ids.begin(), all_ids.end()) == all_ids.end());
 }
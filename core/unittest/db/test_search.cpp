@@ -160,6 +160,11 @@ TEST(DBSearchTest, MERGE_RESULT_SET_TEST) {
     /* test4, id1/dist1 small topk, id2/dist2 small topk */
     MergeTopkToResultSetTest(TOP_K / 2, TOP_K / 3, NQ, TOP_K, true);
     MergeTopkToResultSetTest(TOP_K / 2, TOP_K / 3, NQ, TOP_K, false);
+
+    /* test5, nq * topk large enough to trigger the parallel reduce path */
+    size_t NQ_LARGE = 1000;
+    MergeTopkToResultSetTest(TOP_K, TOP_K, NQ_LARGE, TOP_K, true);
+    MergeTopkToResultSetTest(TOP_K, TOP_K, NQ_LARGE, TOP_K, false);
 }
 
 //void MergeTopkArrayTest(size_t topk_1, size_t topk_2, size_t nq, size_t topk, bool ascending) {
@@ -141,11 +141,11 @@ TEST_F(MetricTest, METRIC_TEST) {
 
 TEST_F(MetricTest, COLLECTOR_METRICS_TEST) {
     auto status = milvus::Status::OK();
-    milvus::server::CollectInsertMetrics insert_metrics0(0, status);
+    milvus::server::CollectInsertMetrics insert_metrics0(0, "table_test", status);
     status = milvus::Status(milvus::DB_ERROR, "error");
-    milvus::server::CollectInsertMetrics insert_metrics1(0, status);
+    milvus::server::CollectInsertMetrics insert_metrics1(0, "table_test", status);
 
-    milvus::server::CollectQueryMetrics query_metrics(10);
+    milvus::server::CollectQueryMetrics query_metrics(10, "table_test");
 
     milvus::server::CollectMergeFilesMetrics merge_metrics();
 
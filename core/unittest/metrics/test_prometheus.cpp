@@ -69,9 +69,20 @@ TEST(PrometheusTest, PROMETHEUS_TEST) {
     fiu_disable("SystemInfo.GPUMemoryTotal.mock");
     fiu_disable("SystemInfo.GPUMemoryUsed.mock");
     instance.GPUMemoryUsageGaugeSet();
+    instance.GPUUtilizationGaugeSet();
+    instance.ResourceExecutorCpuSecondsGaugeSet("cpu", 1.0);
+    instance.ResourceLoaderIOBytesGaugeSet("cpu", 1024.0);
     instance.AddVectorsPerSecondGaugeSet(1, 1, 1);
     instance.QueryIndexTypePerSecondSet("IVF", 1.0);
     instance.QueryIndexTypePerSecondSet("IDMap", 1.0);
+    instance.QueryPerTableTotalIncrement("table_test");
+    instance.QueryPerTableDurationObserve("table_test", 1.0);
+    instance.InsertPerTableTotalIncrement("table_test", 10);
+    instance.SearchComputeTotalIncrement("IVFFLAT", "cpu");
+    instance.CacheHitTotalIncrement("lru", "cpu");
+    instance.CacheMissTotalIncrement("lru", "cpu");
+    instance.CacheEvictionTotalIncrement("cpu");
+    instance.CacheIOBytesTotalIncrement("cpu", "in", 1024);
     instance.ConnectionGaugeIncrement();
     instance.ConnectionGaugeDecrement();
     instance.KeepingAliveCounterIncrement();
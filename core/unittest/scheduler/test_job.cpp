@@ -11,6 +11,9 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <thread>
+
 #include "scheduler/job/Job.h"
 #include "scheduler/job/BuildIndexJob.h"
 #include "scheduler/job/DeleteJob.h"
@@ -41,5 +44,78 @@ TEST(JobTest, TestJob) {
     search_ptr->AddIndexFile(nullptr);
 }
 
+TEST(JobTest, TestSearchJobTreeReduce) {
+    engine::VectorsData vectors;
+    vectors.vector_count_ = 2;
+    uint64_t topk = 4;
+    auto search_ptr = std::make_shared<SearchJob>(nullptr, topk, 1, vectors);
+
+    auto file1 = std::make_shared<engine::meta::TableFileSchema>();
+    file1->id_ = 1;
+    auto file2 = std::make_shared<engine::meta::TableFileSchema>();
+    file2->id_ = 2;
+    ASSERT_TRUE(search_ptr->AddIndexFile(file1));
+    ASSERT_TRUE(search_ptr->AddIndexFile(file2));
+
+    ResultIds ids1 = {1, 3, 5, 7, 11, 13, 15, 17};
+    ResultDistances dist1 = {1.0, 3.0, 5.0, 7.0, 1.0, 3.0, 5.0, 7.0};
+    ResultIds ids2 = {2, 4, 6, 8, 12, 14, 16, 18};
+    ResultDistances dist2 = {2.0, 4.0, 6.0, 8.0, 2.0, 4.0, 6.0, 8.0};
+    ASSERT_TRUE(search_ptr->DepositResult(std::move(ids1), std::move(dist1), topk, true));
+    ASSERT_TRUE(search_ptr->DepositResult(std::move(ids2), std::move(dist2), topk, true));
+    search_ptr->SearchDone(1);
+    search_ptr->SearchDone(2);
+    search_ptr->WaitResult();
+
+    ResultDistances expect_distances = {1.0, 2.0, 3.0, 4.0, 1.0, 2.0, 3.0, 4.0};
+    ASSERT_EQ(search_ptr->GetResultDistances(), expect_distances);
+    ASSERT_EQ(search_ptr->GetResultIds().size(), 2 * topk);
+}
+
+TEST(JobTest, TestSearchJobSpeculation) {
+    engine::VectorsData vectors;
+    vectors.vector_count_ = 1;
+    auto search_ptr = std::make_shared<SearchJob>(nullptr, 1, 1, vectors);
+
+    for (size_t i = 1; i <= 10; ++i) {
+        auto file = std::make_shared<engine::meta::TableFileSchema>();
+        file->id_ = i;
+        ASSERT_TRUE(search_ptr->AddIndexFile(file));
+    }
+
+    // not yet 90% complete: no straggler is reported however long a task runs
+    search_ptr->TaskStarted(1);
+    std::vector<TableFileSchemaPtr> stragglers;
+    search_ptr->PickStragglers(stragglers);
+    ASSERT_TRUE(stragglers.empty());
+
+    for (size_t i = 1; i <= 9; ++i) {
+        search_ptr->TaskStarted(i);
+        ASSERT_TRUE(search_ptr->ClaimResult(i));
+        search_ptr->SearchDone(i);
+    }
+
+    // the last file keeps running past the P95 of the nine completed tasks
+    search_ptr->TaskStarted(10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    search_ptr->PickStragglers(stragglers);
+    ASSERT_EQ(stragglers.size(), 1);
+    ASSERT_EQ(stragglers[0]->id_, 10);
+
+    // each file is cloned at most once
+    stragglers.clear();
+    search_ptr->PickStragglers(stragglers);
+    ASSERT_TRUE(stragglers.empty());
+
+    // first finisher wins the claim, the twin loses and a done file cannot be reclaimed
+    ASSERT_TRUE(search_ptr->IsSpeculated(10));
+    ASSERT_TRUE(search_ptr->ClaimResult(10));
+    ASSERT_FALSE(search_ptr->ClaimResult(10));
+    search_ptr->SearchDone(10);
+    search_ptr->SearchDone(10);  // the losing twin's call is a no-op
+    ASSERT_FALSE(search_ptr->ClaimResult(10));
+    search_ptr->WaitResult();
+}
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -0,0 +1,164 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "scheduler/task/SearchTask.h"
+
+namespace milvus {
+namespace scheduler {
+
+namespace {
+
+// one sorted topk block, the shape a segment deposits into the merge
+void
+GenerateSortedBlock(size_t nq, size_t k, bool ascending, std::mt19937& gen, ResultIds& ids,
+                    ResultDistances& distances) {
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    ids.resize(nq * k);
+    distances.resize(nq * k);
+    for (size_t i = 0; i < nq; i++) {
+        for (size_t j = 0; j < k; j++) {
+            ids[i * k + j] = static_cast<int64_t>(gen() % 1000000);
+            distances[i * k + j] = dist(gen);
+        }
+        auto begin = distances.begin() + i * k;
+        if (ascending) {
+            std::sort(begin, begin + k);
+        } else {
+            std::sort(begin, begin + k, std::greater<float>());
+        }
+    }
+}
+
+// straightforward per-query reference: concatenate, stable-sort on distance, cut to topk
+void
+ReferenceMerge(const ResultIds& src_ids, const ResultDistances& src_distances, size_t src_k, size_t nq, size_t topk,
+               bool ascending, ResultIds& tar_ids, ResultDistances& tar_distances) {
+    size_t tar_k = tar_ids.size() / nq;
+    size_t out_k = std::min(topk, src_k + tar_k);
+    ResultIds out_ids(nq * out_k);
+    ResultDistances out_distances(nq * out_k);
+    for (size_t i = 0; i < nq; i++) {
+        std::vector<std::pair<float, int64_t>> pool;
+        // tar entries first so stable_sort keeps ties in tar-before-src order,
+        // matching the kernel's tie-breaking rule
+        for (size_t j = 0; j < tar_k; j++) {
+            pool.emplace_back(tar_distances[i * tar_k + j], tar_ids[i * tar_k + j]);
+        }
+        for (size_t j = 0; j < src_k; j++) {
+            pool.emplace_back(src_distances[i * src_k + j], src_ids[i * src_k + j]);
+        }
+        std::stable_sort(pool.begin(), pool.end(), [&](const auto& a, const auto& b) {
+            return ascending ? a.first < b.first : a.first > b.first;
+        });
+        for (size_t j = 0; j < out_k; j++) {
+            out_ids[i * out_k + j] = pool[j].second;
+            out_distances[i * out_k + j] = pool[j].first;
+        }
+    }
+    tar_ids.swap(out_ids);
+    tar_distances.swap(out_distances);
+}
+
+void
+CheckAgainstReference(size_t nq, size_t topk, size_t segments, bool ascending, uint32_t seed) {
+    std::mt19937 gen(seed);
+    ResultIds merged_ids, ref_ids;
+    ResultDistances merged_distances, ref_distances;
+
+    for (size_t s = 0; s < segments; s++) {
+        ResultIds src_ids;
+        ResultDistances src_distances;
+        GenerateSortedBlock(nq, topk, ascending, gen, src_ids, src_distances);
+
+        XSearchTask::MergeResultSet(src_ids, src_distances, topk, topk, nq, topk, ascending, merged_ids,
+                                    merged_distances);
+        ReferenceMerge(src_ids, src_distances, topk, nq, topk, ascending, ref_ids, ref_distances);
+    }
+
+    ASSERT_EQ(merged_ids.size(), ref_ids.size());
+    ASSERT_EQ(merged_distances.size(), ref_distances.size());
+    for (size_t i = 0; i < merged_distances.size(); i++) {
+        // ids can legitimately differ on equal distances; the distances must not
+        ASSERT_FLOAT_EQ(merged_distances[i], ref_distances[i]) << "nq=" << nq << " topk=" << topk << " pos=" << i;
+    }
+}
+
+}  // namespace
+
+TEST(MergeKernelTest, SMALL_K_CLASSES) {
+    // cover every (direction, k-class) specialization plus the generic fallback
+    for (bool ascending : {true, false}) {
+        for (size_t topk : {1, 10, 16, 17, 64, 65, 100, 1024}) {
+            CheckAgainstReference(7, topk, 3, ascending, 42 + static_cast<uint32_t>(topk));
+        }
+        // beyond the largest class: run-based path
+        CheckAgainstReference(3, 1025, 2, ascending, 4242);
+    }
+}
+
+TEST(MergeKernelTest, UNEVEN_INPUTS) {
+    // src shallower than topk, e.g. a small tail segment
+    std::mt19937 gen(7);
+    for (bool ascending : {true, false}) {
+        ResultIds merged_ids, ref_ids;
+        ResultDistances merged_distances, ref_distances;
+        const size_t nq = 5, topk = 64;
+        for (size_t src_k : {1, 7, 32, 64}) {
+            ResultIds src_ids;
+            ResultDistances src_distances;
+            GenerateSortedBlock(nq, src_k, ascending, gen, src_ids, src_distances);
+            XSearchTask::MergeResultSet(src_ids, src_distances, src_k, src_k, nq, topk, ascending, merged_ids,
+                                        merged_distances);
+            ReferenceMerge(src_ids, src_distances, src_k, nq, topk, ascending, ref_ids, ref_distances);
+        }
+        ASSERT_EQ(merged_distances.size(), ref_distances.size());
+        for (size_t i = 0; i < merged_distances.size(); i++) {
+            ASSERT_FLOAT_EQ(merged_distances[i], ref_distances[i]);
+        }
+    }
+}
+
+TEST(MergeKernelTest, MICRO_BENCHMARK) {
+    // not a pass/fail gate: reports merge throughput per k-class so kernel
+    // regressions show up in the test log
+    std::mt19937 gen(1234);
+    const size_t nq = 64;
+    const size_t rounds = 50;
+    for (size_t topk : {16, 64, 1024, 2048}) {
+        ResultIds src_ids;
+        ResultDistances src_distances;
+        GenerateSortedBlock(nq, topk, true, gen, src_ids, src_distances);
+
+        auto start = std::chrono::steady_clock::now();
+        ResultIds merged_ids;
+        ResultDistances merged_distances;
+        for (size_t r = 0; r < rounds; r++) {
+            XSearchTask::MergeResultSet(src_ids, src_distances, topk, topk, nq, topk, true, merged_ids,
+                                        merged_distances);
+        }
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "merge topk=" << topk << ": " << us.count() / rounds << " us per merge (nq=" << nq << ")"
+                  << std::endl;
+        ASSERT_EQ(merged_ids.size(), nq * topk);
+    }
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -71,6 +71,11 @@ TEST_F(ResourceBaseTest, DUMP) {
     std::cout << *enable_executor_ << *disable_executor_;
 }
 
+TEST_F(ResourceBaseTest, UTILIZATION) {
+    ASSERT_GE(enable_executor_->ExecutorCpuSeconds(), 0.0);
+    ASSERT_EQ(enable_executor_->LoaderIOBytes(), 0);
+}
+
 /************ ResourceAdvanceTest ************/
 
 class ResourceAdvanceTest : public testing::Test {
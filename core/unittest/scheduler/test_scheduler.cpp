@@ -13,6 +13,11 @@
 #include <fiu-local.h>
 #include <fiu-control.h>
 
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "scheduler/EventRing.h"
 #include "src/scheduler/SchedInst.h"
 #include "cache/DataObj.h"
 #include "cache/GpuCacheMgr.h"
@@ -262,5 +267,44 @@ TEST(SchedulerService, service) {
     fiu_disable("load_simple_config_mock");
 }
 
+TEST(EventRingTest, multi_producer_drain) {
+    constexpr uint64_t PRODUCERS = 4;
+    constexpr uint64_t EVENTS_PER_PRODUCER = 1000;
+    EventRing<std::shared_ptr<uint64_t>> ring(64);  // small ring: producers must wait for drains
+
+    std::vector<std::thread> producers;
+    for (uint64_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (uint64_t i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+                ring.put(std::make_shared<uint64_t>(p * EVENTS_PER_PRODUCER + i));
+            }
+        });
+    }
+
+    std::vector<std::shared_ptr<uint64_t>> batch;
+    uint64_t received = 0;
+    std::vector<uint64_t> last_seen(PRODUCERS, 0);  // per-producer FIFO check
+    while (received < PRODUCERS * EVENTS_PER_PRODUCER) {
+        if (ring.TakeBatch(batch) == 0) {
+            ring.WaitNonEmpty();
+            continue;
+        }
+        for (auto& event : batch) {
+            ASSERT_NE(event, nullptr);
+            uint64_t p = *event / EVENTS_PER_PRODUCER;
+            uint64_t seq = *event % EVENTS_PER_PRODUCER;
+            ASSERT_GE(seq, last_seen[p]);
+            last_seen[p] = seq;
+        }
+        received += batch.size();
+        batch.clear();
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    ASSERT_EQ(received, PRODUCERS * EVENTS_PER_PRODUCER);
+}
+
 }  // namespace scheduler
 }  // namespace milvus
@@ -234,6 +234,25 @@ TEST_F(TaskTableBaseTest, PICK_TO_LOAD_LIMIT) {
     ASSERT_EQ(indexes[2] % empty_table_.capacity(), 4);
 }
 
+TEST_F(TaskTableBaseTest, PICK_TO_LOAD_MAX_LOADED) {
+    const size_t NUM_TASKS = 10;
+    for (size_t i = 0; i < NUM_TASKS; ++i) {
+        empty_table_.Put(task1_);
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        empty_table_[i]->state = milvus::scheduler::TaskTableItemState::LOADED;
+    }
+
+    // three tasks already sit loaded: the default look-ahead of two refuses to
+    // pick, a deeper pipeline keeps loading
+    auto indexes = empty_table_.PickToLoad(1);
+    ASSERT_TRUE(indexes.empty());
+
+    indexes = empty_table_.PickToLoad(1, 4);
+    ASSERT_EQ(indexes.size(), 1);
+    ASSERT_EQ(indexes[0] % empty_table_.capacity(), 3);
+}
+
 TEST_F(TaskTableBaseTest, PICK_TO_LOAD_CACHE) {
     const size_t NUM_TASKS = 10;
     for (size_t i = 0; i < NUM_TASKS; ++i) {
@@ -0,0 +1,86 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+#include <omp.h>
+
+#include "scheduler/ThreadGovernor.h"
+
+namespace milvus {
+namespace scheduler {
+
+TEST(ThreadGovernorTest, FAIR_SHARE) {
+    auto& governor = ThreadGovernor::GetInstance();
+    governor.SetTotalTokens(8);
+
+    // a lone task gets the whole pool
+    auto w1 = governor.Acquire();
+    ASSERT_EQ(w1, 8);
+
+    // later tasks are clamped to the unclaimed tokens, never below one
+    auto w2 = governor.Acquire();
+    ASSERT_EQ(w2, 1);
+    auto w3 = governor.Acquire();
+    ASSERT_EQ(w3, 1);
+
+    governor.Release(w1);
+    governor.Release(w2);
+    governor.Release(w3);
+
+    // with the pool drained back to empty a new task gets full width again
+    auto w4 = governor.Acquire();
+    ASSERT_EQ(w4, 8);
+    governor.Release(w4);
+}
+
+TEST(ThreadGovernorTest, CUSTOM_POLICY) {
+    auto& governor = ThreadGovernor::GetInstance();
+    governor.SetTotalTokens(8);
+
+    // a fixed-width policy, still clamped by the pool
+    governor.SetPolicy("fixed_4", [](int64_t total_tokens, int64_t active_tasks) { return int64_t(4); });
+    auto w1 = governor.Acquire();
+    ASSERT_EQ(w1, 4);
+    auto w2 = governor.Acquire();
+    ASSERT_EQ(w2, 4);
+    auto w3 = governor.Acquire();
+    ASSERT_EQ(w3, 1);
+    governor.Release(w1);
+    governor.Release(w2);
+    governor.Release(w3);
+
+    // a null policy is rejected, the previous one stays active
+    governor.SetPolicy("null", nullptr);
+    auto w4 = governor.Acquire();
+    ASSERT_EQ(w4, 4);
+    governor.Release(w4);
+
+    // restore the default for other tests sharing the singleton
+    governor.SetPolicy("fair_share",
+                       [](int64_t total_tokens, int64_t active_tasks) { return total_tokens / active_tasks; });
+}
+
+TEST(ThreadGovernorTest, WIDTH_GUARD) {
+    auto& governor = ThreadGovernor::GetInstance();
+    governor.SetTotalTokens(4);
+
+    int64_t saved = omp_get_max_threads();
+    {
+        ComputeWidthGuard guard;
+        ASSERT_EQ(guard.width(), 4);
+        ASSERT_EQ(omp_get_max_threads(), 4);
+    }
+    // the guard restores the executor thread's previous width
+    ASSERT_EQ(omp_get_max_threads(), saved);
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,327 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "scheduler_sim/SchedulerSim.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "scheduler/Digest.h"
+#include "scheduler/JobMgr.h"
+#include "scheduler/ResourceMgr.h"
+#include "scheduler/Scheduler.h"
+#include "scheduler/resource/Resource.h"
+#include "scheduler/task/SearchTask.h"
+#include "scheduler/tasklabel/SpecResLabel.h"
+#include "server/context/Context.h"
+#include "utils/Error.h"
+
+namespace milvus {
+namespace scheduler {
+
+namespace {
+
+// monotonic per-lane virtual time; Advance serializes the lane and returns
+// the completion time of the charged interval
+class VirtualClock {
+ public:
+    uint64_t
+    Advance(const std::string& lane, uint64_t ready_us, uint64_t duration_us) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& now = lanes_[lane];
+        now = std::max(now, ready_us) + duration_us;
+        return now;
+    }
+
+ private:
+    std::mutex mutex_;
+    std::map<std::string, uint64_t> lanes_;
+};
+
+using VirtualClockPtr = std::shared_ptr<VirtualClock>;
+
+// countdown of tasks still to execute
+struct SimLatch {
+    explicit SimLatch(uint64_t count) : remaining(count) {
+    }
+
+    void
+    Done() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (remaining > 0) {
+                --remaining;
+            }
+        }
+        cv.notify_one();
+    }
+
+    void
+    Wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return remaining == 0; });
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint64_t remaining;
+};
+
+using SimLatchPtr = std::shared_ptr<SimLatch>;
+
+// derives XSearchTask (like TestTask) so the executor's search-task
+// bookkeeping casts stay valid; the null file schema skips the engine
+// acquisition in the base constructor
+class SimTask : public XSearchTask {
+ public:
+    SimTask(const std::shared_ptr<server::Context>& context, const TraceEvent& event, TaskLabelPtr label)
+        : XSearchTask(context, nullptr, std::move(label)), event_(event) {
+    }
+
+    // the sim resources charge the recorded durations; the task itself is idle
+    void
+    Load(LoadType type, uint8_t device_id) override {
+    }
+
+    void
+    Execute() override {
+    }
+
+    void
+    Prefetch() override {
+    }
+
+ public:
+    TraceEvent event_;
+    uint64_t ready_us_ = 0;
+    uint64_t finish_us_ = 0;
+};
+
+using SimTaskPtr = std::shared_ptr<SimTask>;
+
+class SimDiskResource : public Resource {
+ public:
+    explicit SimDiskResource(const std::string& name) : Resource(name, ResourceType::DISK, 0, false) {
+    }
+
+ protected:
+    void
+    LoadFile(TaskPtr task) override {
+    }
+
+    void
+    Process(TaskPtr task) override {
+    }
+};
+
+class SimComputeResource : public Resource {
+ public:
+    SimComputeResource(const std::string& name, uint64_t device_id, VirtualClockPtr clock, SimLatchPtr latch)
+        : Resource(name, ResourceType::CPU, device_id, true), clock_(std::move(clock)), latch_(std::move(latch)) {
+    }
+
+ protected:
+    // loader and executor charge separate lanes, mirroring the real
+    // resource's load/execute pipelining
+    void
+    LoadFile(TaskPtr task) override {
+        auto sim = std::static_pointer_cast<SimTask>(task);
+        sim->ready_us_ = clock_->Advance(name() + ".loader", sim->event_.arrival_us, sim->event_.load_us);
+    }
+
+    void
+    Process(TaskPtr task) override {
+        auto sim = std::static_pointer_cast<SimTask>(task);
+        sim->finish_us_ = clock_->Advance(name() + ".executor", sim->ready_us_, sim->event_.execute_us);
+        latch_->Done();
+    }
+
+ private:
+    VirtualClockPtr clock_;
+    SimLatchPtr latch_;
+};
+
+uint64_t
+percentile(const std::vector<uint64_t>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    auto rank = static_cast<size_t>(fraction * (sorted.size() - 1));
+    return sorted[rank];
+}
+
+}  // namespace
+
+json
+DumpTrace(const TaskTrace& trace) {
+    json ret = json::array();
+    for (auto& event : trace) {
+        ret.push_back(json{
+            {"arrival_us", event.arrival_us},
+            {"load_us", event.load_us},
+            {"execute_us", event.execute_us},
+        });
+    }
+    return ret;
+}
+
+Status
+LoadTrace(const json& record, TaskTrace& trace) {
+    trace.clear();
+
+    const json* items = &record;
+    if (record.is_object()) {
+        if (!record.contains("items")) {
+            return Status(SERVER_INVALID_ARGUMENT, "trace record has no items array");
+        }
+        items = &record.at("items");
+    }
+    if (!items->is_array()) {
+        return Status(SERVER_INVALID_ARGUMENT, "trace record is not an array");
+    }
+
+    for (auto& item : *items) {
+        TraceEvent event;
+        if (item.contains("timestamp")) {
+            // production TaskTable::Dump() item, timestamps in milliseconds
+            auto& ts = item.at("timestamp");
+            uint64_t start = ts.value("start", uint64_t(0));
+            uint64_t load = ts.value("load", uint64_t(0));
+            uint64_t loaded = ts.value("loaded", uint64_t(0));
+            uint64_t execute = ts.value("execute", uint64_t(0));
+            uint64_t executed = ts.value("executed", uint64_t(0));
+            if (start == 0 || load < start || loaded < load || execute < loaded || executed < execute) {
+                continue;  // never executed, or caught mid-transition
+            }
+            event.arrival_us = start * 1000;
+            event.load_us = (loaded - load) * 1000;
+            event.execute_us = (executed - execute) * 1000;
+        } else {
+            event.arrival_us = item.value("arrival_us", uint64_t(0));
+            event.load_us = item.value("load_us", uint64_t(0));
+            event.execute_us = item.value("execute_us", uint64_t(0));
+        }
+        trace.push_back(event);
+    }
+
+    if (trace.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, "trace record contains no executed tasks");
+    }
+
+    // rebase arrivals so the earliest task arrives at virtual time zero
+    uint64_t base = trace.front().arrival_us;
+    for (auto& event : trace) {
+        base = std::min(base, event.arrival_us);
+    }
+    for (auto& event : trace) {
+        event.arrival_us -= base;
+    }
+    return Status::OK();
+}
+
+std::ostream&
+operator<<(std::ostream& out, const SimReport& report) {
+    out << "policy=" << report.policy << " tasks=" << report.task_count << " makespan_us=" << report.makespan_us
+        << " latency_us{mean=" << report.latency_mean_us << " p50=" << report.latency_p50_us
+        << " p95=" << report.latency_p95_us << " p99=" << report.latency_p99_us << "} steals=" << report.steal_count
+        << " migrations=" << report.migration_count;
+    return out;
+}
+
+SimReport
+Replay(const TaskTrace& trace, const SimPolicy& policy) {
+    SimReport report;
+    report.policy = policy.name;
+    report.task_count = trace.size();
+    if (trace.empty()) {
+        return report;
+    }
+
+    auto clock = std::make_shared<VirtualClock>();
+    auto latch = std::make_shared<SimLatch>(trace.size());
+
+    auto res_mgr = std::make_shared<ResourceMgr>();
+    auto disk = res_mgr->Add(std::make_shared<SimDiskResource>("disk"));
+    std::vector<ResourceWPtr> computes;
+    uint64_t compute_num = std::max(policy.compute_num, uint64_t(1));
+    for (uint64_t i = 0; i < compute_num; ++i) {
+        computes.push_back(res_mgr->Add(std::make_shared<SimComputeResource>("cpu" + std::to_string(i), i, clock, latch)));
+    }
+
+    // topology mirrors one node: disk feeds every compute resource and the
+    // computes are fully meshed so stealing can run between any pair
+    auto io = Connection("IO", 500.0);
+    auto mem = Connection("MEM", 800.0);
+    for (uint64_t i = 0; i < compute_num; ++i) {
+        res_mgr->Connect("disk", "cpu" + std::to_string(i), io);
+        for (uint64_t j = i + 1; j < compute_num; ++j) {
+            res_mgr->Connect("cpu" + std::to_string(i), "cpu" + std::to_string(j), mem);
+        }
+    }
+
+    auto scheduler = std::make_shared<Scheduler>(res_mgr);
+    res_mgr->Start();
+    scheduler->Start();
+
+    uint64_t steals_before = SchedCounters::steals.load();
+    uint64_t migrations_before = SchedCounters::migrations.load();
+
+    TaskTrace ordered = trace;
+    std::sort(ordered.begin(), ordered.end(),
+              [](const TraceEvent& a, const TraceEvent& b) { return a.arrival_us < b.arrival_us; });
+
+    auto context = std::make_shared<server::Context>("scheduler_sim");
+    std::vector<SimTaskPtr> tasks;
+    tasks.reserve(ordered.size());
+    auto disk_res = disk.lock();
+    for (uint64_t i = 0; i < ordered.size(); ++i) {
+        auto& dest = computes[policy.placement == SimPlacement::PINNED ? 0 : i % computes.size()];
+        auto task = std::make_shared<SimTask>(context, ordered[i], std::make_shared<SpecResLabel>(dest));
+        JobMgr::calculate_path(res_mgr, task);
+        tasks.push_back(task);
+        disk_res->task_table().Put(task, nullptr);
+    }
+
+    latch->Wait();
+    scheduler->Stop();
+    res_mgr->Stop();
+
+    report.steal_count = SchedCounters::steals.load() - steals_before;
+    report.migration_count = SchedCounters::migrations.load() - migrations_before;
+
+    uint64_t first_arrival = tasks.front()->event_.arrival_us;
+    uint64_t last_finish = 0;
+    uint64_t latency_sum = 0;
+    std::vector<uint64_t> latencies;
+    latencies.reserve(tasks.size());
+    for (auto& task : tasks) {
+        first_arrival = std::min(first_arrival, task->event_.arrival_us);
+        last_finish = std::max(last_finish, task->finish_us_);
+        uint64_t latency = task->finish_us_ - task->event_.arrival_us;
+        latencies.push_back(latency);
+        latency_sum += latency;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    report.makespan_us = last_finish - first_arrival;
+    report.latency_mean_us = latency_sum / latencies.size();
+    report.latency_p50_us = percentile(latencies, 0.50);
+    report.latency_p95_us = percentile(latencies, 0.95);
+    report.latency_p99_us = percentile(latencies, 0.99);
+    return report;
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -0,0 +1,85 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "utils/Json.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Offline policy evaluation: replay a recorded task trace through the real
+ * Scheduler / ResourceMgr / TaskTable machinery against virtual-clock
+ * resources. Loads and executions charge their recorded durations to
+ * per-resource virtual lanes instead of sleeping, so a production hour
+ * replays in seconds, and scheduling changes can be compared on makespan
+ * and latency distribution before they reach a canary.
+ */
+
+// one recorded task: its arrival plus the durations of its two pipeline
+// stages, all in microseconds of virtual time
+struct TraceEvent {
+    uint64_t arrival_us = 0;
+    uint64_t load_us = 0;
+    uint64_t execute_us = 0;
+};
+
+using TaskTrace = std::vector<TraceEvent>;
+
+json
+DumpTrace(const TaskTrace& trace);
+
+// accepts the flat array written by DumpTrace, or a production
+// TaskTable::Dump() (its `items` carry timestamps in milliseconds); items
+// that never reached the executed state are skipped
+Status
+LoadTrace(const json& record, TaskTrace& trace);
+
+// how replayed tasks are pathed to the compute resources at dispatch
+enum class SimPlacement {
+    ROUND_ROBIN,  // spread over all compute resources
+    PINNED,       // everything to the first one; the rest can only steal
+};
+
+struct SimPolicy {
+    std::string name = "round_robin";
+    uint64_t compute_num = 2;
+    SimPlacement placement = SimPlacement::ROUND_ROBIN;
+};
+
+struct SimReport {
+    std::string policy;
+    uint64_t task_count = 0;
+    uint64_t makespan_us = 0;
+    uint64_t latency_mean_us = 0;
+    uint64_t latency_p50_us = 0;
+    uint64_t latency_p95_us = 0;
+    uint64_t latency_p99_us = 0;
+    uint64_t steal_count = 0;
+    uint64_t migration_count = 0;
+};
+
+std::ostream&
+operator<<(std::ostream& out, const SimReport& report);
+
+// run the trace through a fresh ResourceMgr/Scheduler pair built from the
+// policy; blocks until every task has executed
+SimReport
+Replay(const TaskTrace& trace, const SimPolicy& policy);
+
+}  // namespace scheduler
+}  // namespace milvus
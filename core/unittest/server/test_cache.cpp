@@ -12,9 +12,12 @@
 #include <gtest/gtest.h>
 #include <fiu-control.h>
 #include <fiu-local.h>
+#include <cstdio>
+#include <fstream>
 #include "utils/Error.h"
 #include "wrapper/VecIndex.h"
 
+#include "cache/CacheHandoff.h"
 #include "cache/CpuCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
 
@@ -187,6 +190,46 @@ TEST(CacheTest, CPU_CACHE_TEST) {
 //    delete cpu_cache_mgr;
 }
 
+TEST(CacheTest, PIN_PRIORITY_TEST) {
+    auto cpu_mgr = milvus::cache::CpuCacheMgr::GetInstance();
+    cpu_mgr->ClearCache();
+
+    const int64_t gbyte = 1024 * 1024 * 1024;
+    cpu_mgr->SetCapacity(4 * gbyte);
+
+    auto make_item = []() {
+        // each index is roughly 1G
+        milvus::engine::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 1000000);
+        return std::static_pointer_cast<milvus::cache::DataObj>(mock_index);
+    };
+
+    cpu_mgr->InsertItem("index_pinned", make_item());
+    cpu_mgr->SetItemAttr("index_pinned", true, milvus::cache::CachePriority::HIGH);
+
+    cpu_mgr->InsertItem("index_low", make_item());
+    cpu_mgr->SetItemAttr("index_low", false, milvus::cache::CachePriority::LOW);
+
+    cpu_mgr->InsertItem("index_normal", make_item());
+    cpu_mgr->InsertItem("index_extra_0", make_item());
+
+    // the fifth insert exceeds capacity; the low priority item goes first and the
+    // pinned item survives even though it is the least recently used
+    cpu_mgr->InsertItem("index_extra_1", make_item());
+
+    ASSERT_TRUE(cpu_mgr->ItemExists("index_pinned"));
+    ASSERT_FALSE(cpu_mgr->ItemExists("index_low"));
+    ASSERT_FALSE(cpu_mgr->ItemExists("index_normal"));
+    ASSERT_TRUE(cpu_mgr->ItemExists("index_extra_0"));
+    ASSERT_TRUE(cpu_mgr->ItemExists("index_extra_1"));
+
+    // setting attributes on a missing key is a no-op
+    cpu_mgr->SetItemAttr("index_missing", true, milvus::cache::CachePriority::HIGH);
+    ASSERT_FALSE(cpu_mgr->ItemExists("index_missing"));
+
+    cpu_mgr->ClearCache();
+    ASSERT_EQ(cpu_mgr->ItemCount(), 0);
+}
+
 #ifdef MILVUS_GPU_VERSION
 TEST(CacheTest, GPU_CACHE_TEST) {
     auto gpu_mgr = milvus::cache::GpuCacheMgr::GetInstance(0);
@@ -270,3 +313,180 @@ TEST(CacheTest, PARTIAL_LRU_TEST) {
 
     ASSERT_ANY_THROW(lru.get(-1));
 }
+
+TEST(CacheTest, PARTIAL_LRU_2_TEST) {
+    constexpr int MAX_SIZE = 4;
+    milvus::cache::LRU<int, int> lru(MAX_SIZE);
+    lru.set_policy(milvus::cache::EvictionPolicy::LRU_2);
+
+    lru.put(0, 0);
+    lru.put(1, 0);
+    lru.get(0);  // second access promotes 0 to the protected segment
+
+    // a scan of one-touch entries fills and overflows the probation segment
+    for (int i = 2; i < 2 + MAX_SIZE; ++i) {
+        lru.put(i, 0);
+    }
+
+    // the twice-accessed entry survives the scan, the one-touch ones rotate out
+    ASSERT_TRUE(lru.exists(0));
+    ASSERT_FALSE(lru.exists(1));
+    ASSERT_EQ(lru.size(), MAX_SIZE);
+
+    // probation entries are better eviction candidates than protected ones
+    auto candidates = lru.eviction_candidates();
+    ASSERT_EQ(candidates.size(), MAX_SIZE);
+    ASSERT_EQ(candidates.back().first, 0);
+}
+
+TEST(CacheTest, IN_USE_PROTECTION_TEST) {
+    auto cpu_mgr = milvus::cache::CpuCacheMgr::GetInstance();
+    cpu_mgr->ClearCache();
+
+    const int64_t gbyte = 1024 * 1024 * 1024;
+    cpu_mgr->SetCapacity(3 * gbyte);
+
+    auto make_item = []() {
+        // each index is roughly 1G
+        milvus::engine::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 1000000);
+        return std::static_pointer_cast<milvus::cache::DataObj>(mock_index);
+    };
+
+    cpu_mgr->InsertItem("index_held", make_item());
+    auto held = cpu_mgr->GetIndex("index_held");
+
+    // the held item is the least recently used when capacity is exceeded, but
+    // the outstanding reference keeps it cached; younger idle items go instead
+    cpu_mgr->InsertItem("index_idle_0", make_item());
+    cpu_mgr->InsertItem("index_idle_1", make_item());
+    cpu_mgr->InsertItem("index_trigger", make_item());
+
+    ASSERT_TRUE(cpu_mgr->ItemExists("index_held"));
+    ASSERT_TRUE(cpu_mgr->ItemExists("index_trigger"));
+    ASSERT_FALSE(cpu_mgr->ItemExists("index_idle_0"));
+
+    held = nullptr;
+    cpu_mgr->ClearCache();
+    ASSERT_EQ(cpu_mgr->ItemCount(), 0);
+}
+
+TEST(CacheTest, SNAPSHOT_KEYS_TEST) {
+    auto cpu_mgr = milvus::cache::CpuCacheMgr::GetInstance();
+    cpu_mgr->ClearCache();
+
+    const int dim = 64;
+    for (int i = 0; i < 10; i++) {
+        milvus::cache::DataObjPtr data_obj = std::make_shared<MockVecIndex>(dim, 2);
+        cpu_mgr->InsertItem("snapshot_" + std::to_string(i), data_obj);
+    }
+
+    // the snapshot covers exactly the cached keys
+    auto keys = cpu_mgr->SnapshotKeys();
+    ASSERT_EQ(keys.size(), cpu_mgr->ItemCount());
+    for (auto& key : keys) {
+        ASSERT_TRUE(cpu_mgr->ItemExists(key));
+    }
+
+    cpu_mgr->ClearCache();
+    ASSERT_TRUE(cpu_mgr->SnapshotKeys().empty());
+}
+
+TEST(CacheTest, STATS_AND_ENTRIES_TEST) {
+    auto cpu_mgr = milvus::cache::CpuCacheMgr::GetInstance();
+    cpu_mgr->ClearCache();
+
+    const int dim = 64;
+    int64_t hits_before = cpu_mgr->HitCount();
+    int64_t misses_before = cpu_mgr->MissCount();
+    int64_t bytes_in_before = cpu_mgr->BytesIn();
+
+    milvus::cache::DataObjPtr data_obj = std::make_shared<MockVecIndex>(dim, 2);
+    cpu_mgr->InsertItem("stats_item", data_obj);
+    ASSERT_EQ(cpu_mgr->BytesIn(), bytes_in_before + data_obj->Size());
+
+    ASSERT_NE(cpu_mgr->GetIndex("stats_item"), nullptr);
+    ASSERT_EQ(cpu_mgr->GetIndex("stats_missing"), nullptr);
+    ASSERT_EQ(cpu_mgr->HitCount(), hits_before + 1);
+    ASSERT_EQ(cpu_mgr->MissCount(), misses_before + 1);
+
+    // the entry snapshot reports the resident key with its size
+    auto entries = cpu_mgr->SnapshotEntries();
+    ASSERT_EQ(entries.size(), 1);
+    ASSERT_EQ(entries[0].key_, "stats_item");
+    ASSERT_EQ(entries[0].size_, data_obj->Size());
+    ASSERT_GE(entries[0].age_seconds_, 0);
+
+    int64_t bytes_out_before = cpu_mgr->BytesOut();
+    cpu_mgr->EraseItem("stats_item");
+    ASSERT_EQ(cpu_mgr->BytesOut(), bytes_out_before + data_obj->Size());
+
+    cpu_mgr->ClearCache();
+}
+
+TEST(CacheTest, COLD_ADMISSION_TEST) {
+    auto cpu_mgr = milvus::cache::CpuCacheMgr::GetInstance();
+    cpu_mgr->ClearCache();
+
+    const int64_t gbyte = 1024 * 1024 * 1024;
+    cpu_mgr->SetCapacity(3 * gbyte);
+
+    auto make_item = []() {
+        // each index is roughly 1G
+        milvus::engine::VecIndexPtr mock_index = std::make_shared<MockVecIndex>(256, 1000000);
+        return std::static_pointer_cast<milvus::cache::DataObj>(mock_index);
+    };
+
+    // direct insertions carry no demand history and are always admitted
+    cpu_mgr->InsertItem("adm_resident_0", make_item());
+    cpu_mgr->InsertItem("adm_resident_1", make_item());
+    cpu_mgr->InsertItem("adm_resident_2", make_item());
+
+    // a single lookup miss followed by an insert is the backfill pattern:
+    // under cache pressure the segment is classified cold and bypassed
+    ASSERT_EQ(cpu_mgr->GetIndex("adm_scanned"), nullptr);
+    cpu_mgr->InsertItem("adm_scanned", make_item());
+    ASSERT_FALSE(cpu_mgr->ItemExists("adm_scanned"));
+    ASSERT_TRUE(cpu_mgr->ItemExists("adm_resident_0"));
+
+    // a second lookup re-classifies it hot; now it displaces a resident item
+    ASSERT_EQ(cpu_mgr->GetIndex("adm_scanned"), nullptr);
+    cpu_mgr->InsertItem("adm_scanned", make_item());
+    ASSERT_TRUE(cpu_mgr->ItemExists("adm_scanned"));
+
+    cpu_mgr->ClearCache();
+    ASSERT_EQ(cpu_mgr->ItemCount(), 0);
+}
+
+TEST(CacheTest, FAST_RESTART_HANDOFF_TEST) {
+    const std::string manifest_path = "/tmp/milvus_cache_handoff_test_manifest";
+    std::remove(manifest_path.c_str());
+
+    auto& handoff = milvus::cache::CacheHandoff::GetInstance();
+
+    // no manifest from a previous run is not an error
+    ASSERT_TRUE(handoff.RestoreState(manifest_path).ok());
+
+    // a corrupt manifest is rejected but still consumed
+    {
+        std::ofstream outfile(manifest_path);
+        outfile << "not a manifest";
+    }
+    ASSERT_FALSE(handoff.RestoreState(manifest_path).ok());
+    ASSERT_FALSE(std::ifstream(manifest_path).good());
+
+    // a well-formed manifest is consumed exactly once, even when every
+    // entry is dropped (unknown source file, missing segment)
+    {
+        std::ofstream outfile(manifest_path);
+        outfile << "{\"version\":1,\"entries\":[{\"key\":\"/tmp/milvus_cache_handoff_test_missing\","
+                   "\"shm\":\"/milvus.handoff.test\",\"segment_bytes\":16,\"index_type\":0,"
+                   "\"index_size\":0,\"file_size\":0,\"file_mtime\":0}]}";
+    }
+    ASSERT_TRUE(handoff.RestoreState(manifest_path).ok());
+    ASSERT_FALSE(std::ifstream(manifest_path).good());
+    ASSERT_TRUE(handoff.RestoreState(manifest_path).ok());
+
+    // with the knob at its default the save path is a no-op
+    ASSERT_TRUE(handoff.SaveState(manifest_path).ok());
+    ASSERT_FALSE(std::ifstream(manifest_path).good());
+}
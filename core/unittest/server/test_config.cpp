@@ -155,6 +155,36 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetServerConfigWebPort(str_val).ok());
     ASSERT_TRUE(str_val == web_port);
 
+    int64_t grpc_cq_num = 4;
+    ASSERT_TRUE(config.SetServerConfigGrpcCqNum(std::to_string(grpc_cq_num)).ok());
+    ASSERT_TRUE(config.GetServerConfigGrpcCqNum(int64_val).ok());
+    ASSERT_TRUE(int64_val == grpc_cq_num);
+
+    std::string unix_socket_path = "/tmp/milvus.sock";
+    ASSERT_TRUE(config.SetServerConfigUnixSocketPath(unix_socket_path).ok());
+    ASSERT_TRUE(config.GetServerConfigUnixSocketPath(str_val).ok());
+    ASSERT_TRUE(str_val == unix_socket_path);
+
+    int64_t client_rate_limit = 100;
+    ASSERT_TRUE(config.SetServerConfigClientRateLimit(std::to_string(client_rate_limit)).ok());
+    ASSERT_TRUE(config.GetServerConfigClientRateLimit(int64_val).ok());
+    ASSERT_TRUE(int64_val == client_rate_limit);
+
+    int64_t table_rate_limit = 50;
+    ASSERT_TRUE(config.SetServerConfigTableRateLimit(std::to_string(table_rate_limit)).ok());
+    ASSERT_TRUE(config.GetServerConfigTableRateLimit(int64_val).ok());
+    ASSERT_TRUE(int64_val == table_rate_limit);
+
+    float query_record_fraction = 0.01;
+    ASSERT_TRUE(config.SetServerConfigQueryRecordFraction("0.01").ok());
+    ASSERT_TRUE(config.GetServerConfigQueryRecordFraction(float_val).ok());
+    ASSERT_TRUE(float_val == query_record_fraction);
+
+    int64_t slow_query_threshold = 500;
+    ASSERT_TRUE(config.SetServerConfigSlowQueryThreshold(std::to_string(slow_query_threshold)).ok());
+    ASSERT_TRUE(config.GetServerConfigSlowQueryThreshold(int64_val).ok());
+    ASSERT_TRUE(int64_val == slow_query_threshold);
+
     std::string server_mode = "cluster_readonly";
     ASSERT_TRUE(config.SetServerConfigDeployMode(server_mode).ok());
     ASSERT_TRUE(config.GetServerConfigDeployMode(str_val).ok());
@@ -181,6 +211,16 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetDBConfigArchiveDaysThreshold(int64_val).ok());
     ASSERT_TRUE(int64_val == db_archive_days_threshold);
 
+    int64_t db_merge_concurrency = 4;
+    ASSERT_TRUE(config.SetDBConfigMergeConcurrency(std::to_string(db_merge_concurrency)).ok());
+    ASSERT_TRUE(config.GetDBConfigMergeConcurrency(int64_val).ok());
+    ASSERT_TRUE(int64_val == db_merge_concurrency);
+
+    bool db_build_index_on_flush = true;
+    ASSERT_TRUE(config.SetDBConfigBuildIndexOnFlush(std::to_string(db_build_index_on_flush)).ok());
+    ASSERT_TRUE(config.GetDBConfigBuildIndexOnFlush(bool_val).ok());
+    ASSERT_TRUE(bool_val == db_build_index_on_flush);
+
     /* storage config */
     std::string storage_primary_path = "/home/zilliz";
     ASSERT_TRUE(config.SetStorageConfigPrimaryPath(storage_primary_path).ok());
@@ -238,6 +278,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetMetricConfigPort(str_val).ok());
     ASSERT_TRUE(str_val == metric_port);
 
+    int64_t metric_label_limit = 50;
+    ASSERT_TRUE(config.SetMetricConfigLabelCardinalityLimit(std::to_string(metric_label_limit)).ok());
+    ASSERT_TRUE(config.GetMetricConfigLabelCardinalityLimit(int64_val).ok());
+    ASSERT_TRUE(int64_val == metric_label_limit);
+
     /* cache config */
     int64_t cache_cpu_cache_capacity = 1;
     ASSERT_TRUE(config.SetCacheConfigCpuCacheCapacity(std::to_string(cache_cpu_cache_capacity)).ok());
@@ -512,6 +557,15 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
     ASSERT_FALSE(config.SetServerConfigWebPort("99999").ok());
     ASSERT_FALSE(config.SetServerConfigWebPort("-1").ok());
 
+    ASSERT_FALSE(config.SetServerConfigGrpcCqNum("pagoda").ok());
+    ASSERT_FALSE(config.SetServerConfigUnixSocketPath("milvus.sock").ok());
+    ASSERT_FALSE(config.SetServerConfigClientRateLimit("fast").ok());
+    ASSERT_FALSE(config.SetServerConfigTableRateLimit("-5").ok());
+    ASSERT_FALSE(config.SetServerConfigQueryRecordFraction("all").ok());
+    ASSERT_FALSE(config.SetServerConfigQueryRecordFraction("1.5").ok());
+    ASSERT_FALSE(config.SetServerConfigQueryRecordFraction("-0.1").ok());
+    ASSERT_FALSE(config.SetServerConfigSlowQueryThreshold("slow").ok());
+
     ASSERT_FALSE(config.SetServerConfigDeployMode("cluster").ok());
 
     ASSERT_FALSE(config.SetServerConfigTimeZone("GM").ok());
@@ -527,6 +581,10 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetDBConfigArchiveDaysThreshold("0x10").ok());
 
+    ASSERT_FALSE(config.SetDBConfigMergeConcurrency("many").ok());
+
+    ASSERT_FALSE(config.SetDBConfigBuildIndexOnFlush("maybe").ok());
+
     /* storage config */
     ASSERT_FALSE(config.SetStorageConfigPrimaryPath("").ok());
 
@@ -552,6 +610,9 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetMetricConfigPort("0xff").ok());
 
+    ASSERT_FALSE(config.SetMetricConfigLabelCardinalityLimit("a").ok());
+    ASSERT_FALSE(config.SetMetricConfigLabelCardinalityLimit("0").ok());
+
     /* cache config */
     ASSERT_FALSE(config.SetCacheConfigCpuCacheCapacity("a").ok());
     ASSERT_FALSE(config.SetCacheConfigCpuCacheCapacity("0").ok());
@@ -999,3 +1060,41 @@ TEST_F(ConfigTest, SERVER_CONFIG_OTHER_CONFIGS_FAIL_TEST) {
     ASSERT_FALSE(s.ok());
 #endif
 }
+
+TEST_F(ConfigTest, SERVER_CONFIG_CALLBACK_TEST) {
+    milvus::server::Config& config = milvus::server::Config::GetInstance();
+    milvus::Status s;
+    std::string dummy;
+
+    std::string observed_value;
+    s = config.RegisterCallBack(ms::CONFIG_CACHE, ms::CONFIG_CACHE_CPU_CACHE_CAPACITY, "config_test",
+                                [&observed_value](const std::string& value) {
+                                    observed_value = value;
+                                    return milvus::Status::OK();
+                                });
+    ASSERT_TRUE(s.ok());
+
+    /* a null callback is rejected */
+    s = config.RegisterCallBack(ms::CONFIG_CACHE, ms::CONFIG_CACHE_CPU_CACHE_CAPACITY, "config_test", nullptr);
+    ASSERT_FALSE(s.ok());
+
+    /* a successful set_config fires the callback with the new value */
+    s = config.ProcessConfigCli(dummy, gen_set_command(ms::CONFIG_CACHE, ms::CONFIG_CACHE_CPU_CACHE_CAPACITY, "2"));
+    ASSERT_TRUE(s.ok());
+    ASSERT_EQ(observed_value, "2");
+
+    /* a rejected set_config leaves the callback untouched */
+    s = config.ProcessConfigCli(dummy, gen_set_command(ms::CONFIG_CACHE, ms::CONFIG_CACHE_CPU_CACHE_CAPACITY, "-1"));
+    ASSERT_FALSE(s.ok());
+    ASSERT_EQ(observed_value, "2");
+
+    /* after unregistering, the callback no longer fires */
+    s = config.UnregisterCallBack(ms::CONFIG_CACHE, ms::CONFIG_CACHE_CPU_CACHE_CAPACITY, "config_test");
+    ASSERT_TRUE(s.ok());
+    s = config.ProcessConfigCli(dummy, gen_set_command(ms::CONFIG_CACHE, ms::CONFIG_CACHE_CPU_CACHE_CAPACITY, "4"));
+    ASSERT_TRUE(s.ok());
+    ASSERT_EQ(observed_value, "2");
+
+    s = config.ResetDefaultConfig();
+    ASSERT_TRUE(s.ok());
+}
@@ -10,9 +10,12 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/engine/ExecutionEngine.h"
+#include "server/context/Context.h"
+#include "server/delivery/SlowQueryLog.h"
 #include "utils/BlockingQueue.h"
 #include "utils/CommonUtil.h"
 #include "utils/Error.h"
+#include "utils/Log.h"
 #include "utils/LogUtil.h"
 #include "utils/SignalUtil.h"
 #include "utils/StringHelpFunctions.h"
@@ -24,6 +27,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <boost/filesystem.hpp>
+#include <limits>
 #include <thread>
 #include <src/utils/Exception.h>
 
@@ -243,6 +247,14 @@ TEST(UtilTest, BLOCKINGQUEUE_TEST) {
     }
 
     ASSERT_EQ(bq.Size(), 0);
+
+    for (size_t i = 1; i <= count; i++) {
+        ASSERT_TRUE(bq.TryPut("No." + std::to_string(i)));
+    }
+    ASSERT_FALSE(bq.TryPut("overflow"));
+    str = bq.Take();
+    ASSERT_EQ(str, "No.1");
+    ASSERT_TRUE(bq.TryPut("overflow"));
 }
 
 TEST(UtilTest, LOG_TEST) {
@@ -256,6 +268,31 @@ TEST(UtilTest, LOG_TEST) {
     ASSERT_EQ(fname, "log_config.conf");
 }
 
+TEST(UtilTest, LAZY_LOG_TEST) {
+    el::Logger* logger = el::Loggers::getLogger("default");
+    el::Configurations saved = *logger->configurations();
+
+    // with debug filtered out the lazy macros must not evaluate their operands
+    el::Configurations off;
+    off.set(el::Level::Debug, el::ConfigurationType::Enabled, "false");
+    el::Loggers::reconfigureLogger(logger, off);
+    ASSERT_FALSE(milvus::LogLevelEnabled(el::Level::Debug));
+
+    int evaluated = 0;
+    auto operand = [&evaluated]() {
+        ++evaluated;
+        return "formatted";
+    };
+    ENGINE_LOG_DEBUG_LAZY << operand();
+    ASSERT_EQ(evaluated, 0);
+
+    el::Loggers::reconfigureLogger(logger, saved);
+    if (milvus::LogLevelEnabled(el::Level::Debug)) {
+        SERVER_LOG_DEBUG_LAZY << operand();
+        ASSERT_EQ(evaluated, 1);
+    }
+}
+
 TEST(UtilTest, TIMERECORDER_TEST) {
     for (int64_t log_level = 0; log_level <= 6; log_level++) {
         if (log_level == 5) {
@@ -271,6 +308,20 @@ TEST(UtilTest, TIMERECOREDRAUTO_TEST) {
     rc.RecordSection("end");
 }
 
+TEST(UtilTest, SLOW_QUERY_LOG_TEST) {
+    auto& slow_log = milvus::server::SlowQueryLog::GetInstance();
+    for (int64_t i = 0; i < 200; i++) {
+        milvus::json record;
+        record["latency_ms"] = i;
+        slow_log.Append(record);
+    }
+
+    // the ring keeps only the newest records
+    auto records = slow_log.Dump();
+    ASSERT_EQ(records.size(), 128);
+    ASSERT_EQ(records.back()["latency_ms"], 199);
+}
+
 TEST(UtilTest, STATUS_TEST) {
     auto status = milvus::Status::OK();
     std::string str = status.ToString();
@@ -319,6 +370,33 @@ TEST(UtilTest, STATUS_TEST) {
     ASSERT_EQ(status_move.ToString(), status_ref.ToString());
 }
 
+TEST(UtilTest, MEMORY_ACCOUNTANT_TEST) {
+    milvus::server::MemoryAccountant accountant(1000);
+    ASSERT_EQ(accountant.Budget(), 1000);
+    ASSERT_EQ(accountant.Remaining(), 1000);
+
+    ASSERT_TRUE(accountant.Charge(600));
+    ASSERT_EQ(accountant.Remaining(), 400);
+
+    /* over budget fails and leaves usage untouched */
+    ASSERT_FALSE(accountant.Charge(500));
+    ASSERT_EQ(accountant.Remaining(), 400);
+
+    ASSERT_TRUE(accountant.Charge(400));
+    ASSERT_EQ(accountant.Remaining(), 0);
+    ASSERT_FALSE(accountant.Charge(1));
+
+    accountant.Refund(600);
+    ASSERT_TRUE(accountant.Charge(600));
+
+    /* the accountant rides on the request context, shared by reference */
+    auto context = std::make_shared<milvus::server::Context>("req_id");
+    ASSERT_EQ(context->GetMemoryAccountant(), nullptr);
+    context->SetMemoryAccountant(std::make_shared<milvus::server::MemoryAccountant>(100));
+    ASSERT_TRUE(context->GetMemoryAccountant()->Charge(80));
+    ASSERT_EQ(context->GetMemoryAccountant()->Remaining(), 20);
+}
+
 TEST(ValidationUtilTest, VALIDATE_TABLENAME_TEST) {
     std::string table_name = "Normal123_";
     auto status = milvus::server::ValidationUtil::ValidateTableName(table_name);
@@ -413,6 +491,22 @@ TEST(ValidationUtilTest, VALIDATE_NPROBE_TEST) {
     ASSERT_NE(milvus::server::ValidationUtil::ValidateSearchNprobe(101, schema).code(), milvus::SERVER_SUCCESS);
 }
 
+TEST(ValidationUtilTest, VALIDATE_VECTOR_DATA_TEST) {
+    std::vector<float> data(1000, 0.5f);
+    ASSERT_EQ(milvus::server::ValidationUtil::ValidateVectorDataFinite(data.data(), data.size()).code(),
+              milvus::SERVER_SUCCESS);
+
+    data[999] = std::numeric_limits<float>::quiet_NaN();
+    ASSERT_NE(milvus::server::ValidationUtil::ValidateVectorDataFinite(data.data(), data.size()).code(),
+              milvus::SERVER_SUCCESS);
+
+    data[999] = -std::numeric_limits<float>::infinity();
+    ASSERT_NE(milvus::server::ValidationUtil::ValidateVectorDataFinite(data.data(), data.size()).code(),
+              milvus::SERVER_SUCCESS);
+
+    ASSERT_EQ(milvus::server::ValidationUtil::ValidateVectorDataFinite(data.data(), 0).code(), milvus::SERVER_SUCCESS);
+}
+
 TEST(ValidationUtilTest, VALIDATE_PARTITION_TAGS) {
     std::vector<std::string> partition_tags = {"abc"};
     ASSERT_EQ(milvus::server::ValidationUtil::ValidatePartitionTags(partition_tags).code(), milvus::SERVER_SUCCESS);
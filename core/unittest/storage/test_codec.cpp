@@ -0,0 +1,117 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "storage/Codec.h"
+#include "storage/utils.h"
+
+TEST_F(StorageTest, CODEC_FACTORY_TEST) {
+    ASSERT_EQ(milvus::storage::Codec::Get(milvus::storage::CodecType::NONE), nullptr);
+    ASSERT_EQ(milvus::storage::Codec::Get(static_cast<milvus::storage::CodecType>(0xff)), nullptr);
+
+    auto codec = milvus::storage::Codec::Get(milvus::storage::CodecType::ZLIB);
+    ASSERT_NE(codec, nullptr);
+    ASSERT_EQ(codec->Type(), milvus::storage::CodecType::ZLIB);
+}
+
+TEST_F(StorageTest, CODEC_ROUNDTRIP_TEST) {
+    auto codec = milvus::storage::Codec::Get(milvus::storage::CodecType::ZLIB);
+    ASSERT_NE(codec, nullptr);
+
+    // embedding-like floats: compressible but not trivial
+    std::mt19937 gen(42);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> raw(3 * 1024 * 1024);
+    for (auto& value : raw) {
+        value = dist(gen);
+    }
+    size_t raw_bytes = raw.size() * sizeof(float);
+
+    std::vector<uint8_t> compressed;
+    ASSERT_TRUE(codec->Compress(raw.data(), raw_bytes, compressed).ok());
+
+    std::vector<float> restored(raw.size());
+    ASSERT_TRUE(codec->Decompress(compressed.data(), compressed.size(), restored.data(), raw_bytes).ok());
+    ASSERT_EQ(memcmp(raw.data(), restored.data(), raw_bytes), 0);
+
+    // truncated input must fail, not produce silent garbage
+    ASSERT_FALSE(
+        codec->Decompress(compressed.data(), compressed.size() / 2, restored.data(), raw_bytes).ok());
+}
+
+TEST_F(StorageTest, CODEC_PARALLEL_CHUNKS_TEST) {
+    auto codec = milvus::storage::Codec::Get(milvus::storage::CodecType::ZLIB);
+    ASSERT_NE(codec, nullptr);
+
+    // more chunks than decompress workers, uneven tail chunk
+    const size_t chunk_size = 256 * 1024;
+    const size_t total = 10 * chunk_size + 12345;
+
+    std::vector<uint8_t> raw(total);
+    for (size_t i = 0; i < total; ++i) {
+        raw[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+
+    std::vector<std::vector<uint8_t>> compressed;
+    for (size_t offset = 0; offset < total; offset += chunk_size) {
+        size_t len = std::min(chunk_size, total - offset);
+        compressed.emplace_back();
+        ASSERT_TRUE(codec->Compress(raw.data() + offset, len, compressed.back()).ok());
+    }
+
+    std::vector<uint8_t> restored(total);
+    std::vector<milvus::storage::CodecChunk> chunks;
+    size_t offset = 0;
+    for (auto& comp : compressed) {
+        size_t len = std::min(chunk_size, total - offset);
+        uint32_t checksum = milvus::storage::ChunkChecksum(comp.data(), comp.size());
+        chunks.push_back({comp.data(), comp.size(), restored.data() + offset, len, checksum, true});
+        offset += len;
+    }
+
+    ASSERT_TRUE(milvus::storage::DecompressChunks(codec, chunks).ok());
+    ASSERT_EQ(raw, restored);
+
+    // a corrupt chunk fails the whole batch
+    std::vector<uint8_t> bogus(64, 0xab);
+    chunks[3] = {bogus.data(), bogus.size(), restored.data(), 64, milvus::storage::ChunkChecksum(bogus.data(), 64),
+                 true};
+    ASSERT_FALSE(milvus::storage::DecompressChunks(codec, chunks).ok());
+
+    // a checksum mismatch is caught before the bytes reach the decompressor
+    chunks[3] = {compressed[3].data(), compressed[3].size(), restored.data(), std::min(chunk_size, total), 0xdeadbeef,
+                 true};
+    ASSERT_FALSE(milvus::storage::DecompressChunks(codec, chunks).ok());
+}
+
+TEST_F(StorageTest, CODEC_VERIFY_RAW_CHUNKS_TEST) {
+    // a null codec verifies raw stored chunks in place
+    std::vector<uint8_t> raw(1024 * 1024);
+    for (size_t i = 0; i < raw.size(); ++i) {
+        raw[i] = static_cast<uint8_t>(i * 17 + 3);
+    }
+
+    std::vector<milvus::storage::CodecChunk> chunks;
+    const size_t chunk_size = 256 * 1024;
+    for (size_t offset = 0; offset < raw.size(); offset += chunk_size) {
+        uint32_t checksum = milvus::storage::ChunkChecksum(raw.data() + offset, chunk_size);
+        chunks.push_back({raw.data() + offset, chunk_size, raw.data() + offset, chunk_size, checksum, true});
+    }
+    ASSERT_TRUE(milvus::storage::DecompressChunks(nullptr, chunks).ok());
+
+    // flip one byte: the damaged chunk is reported
+    raw[chunk_size + 5] ^= 0xff;
+    ASSERT_FALSE(milvus::storage::DecompressChunks(nullptr, chunks).ok());
+}
@@ -196,3 +196,57 @@ TEST_F(StorageTest, S3_FAIL_TEST) {
 
     storage_inst.StopService();
 }
+
+TEST_F(StorageTest, S3_MULTIPART_TEST) {
+    fiu_init(0);
+
+    const std::string objname = "/tmp/test_multipart_obj";
+    // larger than the multipart threshold and not a multiple of the part size,
+    // so the upload splits into several full parts plus a short tail
+    const size_t content_size = 40 * 1024 * 1024 + 12345;
+
+    std::string content(content_size, '\0');
+    for (size_t i = 0; i < content_size; ++i) {
+        content[i] = static_cast<char>(i * 13 + 5);
+    }
+
+    auto& storage_inst = milvus::storage::S3ClientWrapper::GetInstance();
+    fiu_enable("S3ClientWrapper.StartService.mock_enable", 1, NULL, 0);
+    ASSERT_TRUE(storage_inst.StartService().ok());
+
+    ///////////////////////////////////////////////////////////////////////////
+    /* a large PutObjectStr() takes the parallel multipart path */
+    {
+        ASSERT_TRUE(storage_inst.PutObjectStr(objname, content).ok());
+
+        std::string content_out;
+        ASSERT_TRUE(storage_inst.GetObjectStr(objname, content_out).ok());
+        ASSERT_TRUE(content_out == content);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /* a large reader payload takes the parallel ranged-GET path */
+    {
+        milvus::storage::S3IOReader reader(objname);
+        ASSERT_EQ(reader.length(), content_size);
+
+        std::string content_out(content_size, '\0');
+        reader.read(&content_out[0], content_size);
+        ASSERT_TRUE(content_out == content);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /* a failed CreateMultipartUpload surfaces as an error */
+    {
+        fiu_enable("S3ClientWrapper.MultipartUpload.create.fail", 1, NULL, 0);
+        ASSERT_FALSE(storage_inst.PutObjectStr(objname, content).ok());
+        fiu_disable("S3ClientWrapper.MultipartUpload.create.fail");
+
+        fiu_enable("S3ClientWrapper.MultipartUpload.complete.fail", 1, NULL, 0);
+        ASSERT_FALSE(storage_inst.PutObjectStr(objname, content).ok());
+        fiu_disable("S3ClientWrapper.MultipartUpload.complete.fail");
+    }
+
+    ASSERT_TRUE(storage_inst.DeleteObject(objname).ok());
+    storage_inst.StopService();
+}
@@ -18,13 +18,18 @@
 
 #endif
 
+#include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "wrapper/DataTransfer.h"
 #include "wrapper/VecIndex.h"
 #include "wrapper/utils.h"
 
 #include <fiu-control.h>
 #include <fiu-local.h>
 #include <gtest/gtest.h>
+#include <fstream>
+#include <numeric>
+#include <random>
 
 INITIALIZE_EASYLOGGINGPP
 
@@ -220,10 +225,34 @@ TEST_P(KnowhereWrapperTest, SERIALIZE_TEST) {
         EXPECT_EQ(new_index->Dimension(), index_->Dimension());
         EXPECT_EQ(new_index->Count(), index_->Count());
 
+        // the header section answers the same questions without a load
+        milvus::engine::SegmentHeaderInfo header;
+        ASSERT_TRUE(milvus::engine::read_index_header(file_location, header).ok());
+        EXPECT_EQ(header.index_type, index_->GetType());
+        EXPECT_EQ(header.row_count, index_->Count());
+        EXPECT_EQ(header.dimension, index_->Dimension());
+
         std::vector<int64_t> res_ids(elems);
         std::vector<float> res_dis(elems);
         new_index->Search(nq, xq.data(), res_dis.data(), res_ids.data(), searchconf);
         AssertResult(res_ids, res_dis);
+
+        // the scrubber verifies the same container without loading it
+        ASSERT_TRUE(milvus::engine::VerifySegmentFile(file_location, 0).ok());
+        ASSERT_TRUE(milvus::engine::VerifySegmentFile(file_location, 100).ok());
+        ASSERT_FALSE(milvus::engine::VerifySegmentFile("/tmp/knowhere_missing", 0).ok());
+
+        // flip one payload byte: verification must fail where a load would
+        {
+            std::fstream corrupter(file_location, std::ios::in | std::ios::out | std::ios::binary);
+            corrupter.seekp(-1, std::ios::end);
+            char last = 0;
+            corrupter.seekg(-1, std::ios::end);
+            corrupter.get(last);
+            corrupter.seekp(-1, std::ios::end);
+            corrupter.put(static_cast<char>(last ^ 0xff));
+        }
+        ASSERT_FALSE(milvus::engine::VerifySegmentFile(file_location, 0).ok());
     }
 
     {
@@ -248,6 +277,38 @@ TEST_P(KnowhereWrapperTest, SERIALIZE_TEST) {
 
 #include "wrapper/ConfAdapter.h"
 
+TEST(IvfMergeTest, MERGE_SHARD_TEST) {
+    // per-device encode shards of one build reassemble into the full index
+    const int64_t nb = 4000;
+    const int64_t dim = 32;
+    const int64_t half = nb / 2;
+    std::vector<float> data(nb * dim);
+    std::vector<int64_t> ids(nb);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (auto& v : data) {
+        v = dist(gen);
+    }
+    std::iota(ids.begin(), ids.end(), 0);
+
+    auto cfg = std::make_shared<knowhere::IVFCfg>(dim, 10, 0, 16, 4, knowhere::METRICTYPE::L2);
+
+    auto target = std::make_shared<knowhere::IVF>();
+    auto model = target->Train(milvus::engine::GenDatasetWithIds(nb, dim, data.data(), ids.data()), cfg);
+    target->set_index_model(model);
+    target->Add(milvus::engine::GenDatasetWithIds(half, dim, data.data(), ids.data()), cfg);
+    ASSERT_EQ(target->Count(), half);
+
+    auto shard = std::make_shared<knowhere::IVF>();
+    shard->set_index_model(model);
+    shard->Add(milvus::engine::GenDatasetWithIds(half, dim, data.data() + half * dim, ids.data() + half), cfg);
+
+    target->Merge(shard);
+    ASSERT_EQ(target->Count(), nb);
+
+    ASSERT_ANY_THROW(target->Merge(nullptr));
+}
+
 TEST(whatever, test_config) {
     milvus::engine::TempMetaConf conf;
     conf.nprobe = 16;
@@ -310,6 +371,41 @@ TEST(whatever, test_config) {
     }
 }
 
+#include "wrapper/TunedParamsMgr.h"
+
+TEST(TunedParamsMgrTest, tuned_nprobe_default) {
+    auto& mgr = milvus::engine::TunedParamsMgr::GetInstance();
+    ASSERT_EQ(mgr.GetNprobe("tuned_table"), 0);
+
+    milvus::engine::TunedSearchParams params;
+    params.nprobe = 32;
+    params.recall = 0.97f;
+    mgr.Set("tuned_table", params);
+
+    milvus::engine::TempMetaConf conf;
+    conf.k = 10;
+    conf.nprobe = -1;  // not set by the client: the tuned default applies
+    conf.table_id = "tuned_table";
+    milvus::engine::IVFConfAdapter adapter;
+    auto ivf_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(
+        adapter.MatchSearch(conf, milvus::engine::IndexType::FAISS_IVFFLAT_CPU));
+    ASSERT_EQ(ivf_conf->nprobe, 32);
+
+    conf.nprobe = 4;  // an explicit nprobe wins over the tuned one
+    ivf_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(
+        adapter.MatchSearch(conf, milvus::engine::IndexType::FAISS_IVFFLAT_CPU));
+    ASSERT_EQ(ivf_conf->nprobe, 4);
+
+    conf.nprobe = -1;
+    conf.table_id = "other_table";  // an untracked table keeps the hardcoded default
+    ivf_conf = std::dynamic_pointer_cast<knowhere::IVFCfg>(
+        adapter.MatchSearch(conf, milvus::engine::IndexType::FAISS_IVFFLAT_CPU));
+    ASSERT_EQ(ivf_conf->nprobe, 16);
+
+    ASSERT_EQ(milvus::engine::TunedParamsMgr::TableIdFromLocation("/db/tables/tuned_table/20200101/12345"),
+              "tuned_table");
+}
+
 #include "wrapper/VecImpl.h"
 
 TEST(BFIndex, test_bf_index_fail) {
@@ -0,0 +1,153 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <getopt.h>
+#include <libgen.h>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "src/LoadRunner.h"
+
+void
+print_help(const std::string& app_name);
+
+namespace {
+
+// "1:64:1,16:128:1" -> one MixEntry per comma group, fields nq:topk:weight
+bool
+parse_mix(const std::string& spec, std::vector<MixEntry>& mix) {
+    std::stringstream groups(spec);
+    std::string group;
+    while (std::getline(groups, group, ',')) {
+        MixEntry entry;
+        if (sscanf(group.c_str(), "%ld:%ld:%ld", &entry.nq, &entry.topk, &entry.weight) != 3 || entry.nq <= 0 ||
+            entry.topk <= 0 || entry.weight <= 0) {
+            return false;
+        }
+        mix.push_back(entry);
+    }
+    return !mix.empty();
+}
+
+bool
+parse_qps_steps(const std::string& spec, std::vector<int64_t>& steps) {
+    std::stringstream groups(spec);
+    std::string group;
+    while (std::getline(groups, group, ',')) {
+        int64_t qps = atol(group.c_str());
+        if (qps <= 0) {
+            return false;
+        }
+        steps.push_back(qps);
+    }
+    return !steps.empty();
+}
+
+}  // namespace
+
+int
+main(int argc, char* argv[]) {
+    std::string app_name = basename(argv[0]);
+    static struct option long_options[] = {{"server", optional_argument, nullptr, 's'},
+                                           {"port", optional_argument, nullptr, 'p'},
+                                           {"table", required_argument, nullptr, 't'},
+                                           {"qps", required_argument, nullptr, 'q'},
+                                           {"duration", optional_argument, nullptr, 'd'},
+                                           {"connections", optional_argument, nullptr, 'c'},
+                                           {"mix", optional_argument, nullptr, 'm'},
+                                           {"nprobe", optional_argument, nullptr, 'n'},
+                                           {"csv", optional_argument, nullptr, 'o'},
+                                           {"help", no_argument, nullptr, 'h'},
+                                           {nullptr, 0, nullptr, 0}};
+
+    LoadOptions options;
+    std::string qps_spec, mix_spec = "1:64:1";
+
+    int option_index = 0;
+    int value;
+    while ((value = getopt_long(argc, argv, "s:p:t:q:d:c:m:n:o:h", long_options, &option_index)) != -1) {
+        switch (value) {
+            case 's':
+                options.address = optarg;
+                break;
+            case 'p':
+                options.port = optarg;
+                break;
+            case 't':
+                options.table_name = optarg;
+                break;
+            case 'q':
+                qps_spec = optarg;
+                break;
+            case 'd':
+                options.duration_sec = atol(optarg);
+                break;
+            case 'c':
+                options.connections = atol(optarg);
+                break;
+            case 'm':
+                mix_spec = optarg;
+                break;
+            case 'n':
+                options.nprobe = atol(optarg);
+                break;
+            case 'o':
+                options.csv_path = optarg;
+                break;
+            case 'h':
+            default:
+                print_help(app_name);
+                return EXIT_SUCCESS;
+        }
+    }
+
+    if (options.table_name.empty() || qps_spec.empty()) {
+        printf("--table and --qps are required\n");
+        print_help(app_name);
+        return EXIT_FAILURE;
+    }
+    if (!parse_qps_steps(qps_spec, options.qps_steps)) {
+        printf("Invalid qps list: %s\n", qps_spec.c_str());
+        return EXIT_FAILURE;
+    }
+    if (!parse_mix(mix_spec, options.mix)) {
+        printf("Invalid mix spec: %s\n", mix_spec.c_str());
+        return EXIT_FAILURE;
+    }
+    if (options.duration_sec <= 0 || options.connections <= 0) {
+        printf("--duration and --connections must be positive\n");
+        return EXIT_FAILURE;
+    }
+
+    LoadRunner runner(options);
+    return runner.Run() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void
+print_help(const std::string& app_name) {
+    printf("\n Usage: %s [OPTIONS]\n\n", app_name.c_str());
+    printf("  Drives an already populated table with an open-loop search load and\n");
+    printf("  reports a throughput-vs-latency saturation curve.\n\n");
+    printf("  Options:\n");
+    printf("   -s --server       Server address, default 127.0.0.1\n");
+    printf("   -p --port         Server port, default 19530\n");
+    printf("   -t --table        Target table name (required)\n");
+    printf("   -q --qps          Comma-separated target QPS steps, e.g. 500,1000,2000 (required)\n");
+    printf("   -d --duration     Seconds per QPS step, default 30\n");
+    printf("   -c --connections  Number of client connections/worker threads, default 8\n");
+    printf("   -m --mix          Query mix as nq:topk:weight[,nq:topk:weight...], default 1:64:1\n");
+    printf("   -n --nprobe       nprobe for every search, default 16\n");
+    printf("   -o --csv          Write the curve as CSV to this file instead of stdout\n");
+    printf("   -h --help         Print help information\n");
+    printf("\n");
+}
@@ -0,0 +1,251 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "src/LoadRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "MilvusApi.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// log-bucketed latency histogram, 8 sub-buckets per octave of microseconds
+// (about 9% relative error), lock-free so every worker records directly
+constexpr int64_t BUCKETS_PER_OCTAVE = 8;
+constexpr int64_t HISTOGRAM_BUCKETS = 27 * BUCKETS_PER_OCTAVE;
+
+class LatencyHistogram {
+ public:
+    LatencyHistogram() : counts_(HISTOGRAM_BUCKETS) {
+    }
+
+    void
+    Record(int64_t latency_us) {
+        int64_t bucket = 0;
+        if (latency_us > 0) {
+            bucket = static_cast<int64_t>(std::log2(static_cast<double>(latency_us)) * BUCKETS_PER_OCTAVE);
+            bucket = std::min(bucket, HISTOGRAM_BUCKETS - 1);
+        }
+        counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+        int64_t max = max_us_.load(std::memory_order_relaxed);
+        while (latency_us > max && !max_us_.compare_exchange_weak(max, latency_us)) {
+        }
+        total_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int64_t
+    Percentile(double fraction) const {
+        int64_t total = total_.load();
+        if (total == 0) {
+            return 0;
+        }
+        auto rank = static_cast<int64_t>(fraction * static_cast<double>(total));
+        int64_t seen = 0;
+        for (int64_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+            seen += counts_[i].load();
+            if (seen > rank) {
+                return static_cast<int64_t>(std::pow(2.0, static_cast<double>(i) / BUCKETS_PER_OCTAVE));
+            }
+        }
+        return max_us_.load();
+    }
+
+    int64_t
+    Total() const {
+        return total_.load();
+    }
+
+    int64_t
+    Max() const {
+        return max_us_.load();
+    }
+
+ private:
+    std::vector<std::atomic<int64_t>> counts_;
+    std::atomic<int64_t> total_{0};
+    std::atomic<int64_t> max_us_{0};
+};
+
+// distinct random query sets reused round-robin per mix entry, so repeated
+// requests do not collapse into a single server-side cached result
+constexpr int64_t QUERY_POOL_SIZE = 16;
+
+std::vector<std::vector<milvus::RowRecord>>
+BuildQueryPool(int64_t nq, int64_t dimension, uint64_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<std::vector<milvus::RowRecord>> pool(QUERY_POOL_SIZE);
+    for (auto& query_set : pool) {
+        query_set.resize(nq);
+        for (auto& record : query_set) {
+            record.float_data.resize(dimension);
+            for (auto& value : record.float_data) {
+                value = dist(gen);
+            }
+        }
+    }
+    return pool;
+}
+
+}  // namespace
+
+LoadRunner::LoadRunner(const LoadOptions& options) : options_(options) {
+}
+
+bool
+LoadRunner::Run() {
+    auto conn = milvus::Connection::Create();
+    milvus::ConnectParam param = {options_.address, options_.port};
+    auto status = conn->Connect(param);
+    if (!status.ok()) {
+        printf("Connect to %s:%s failed: %s\n", options_.address.c_str(), options_.port.c_str(),
+               status.message().c_str());
+        return false;
+    }
+
+    milvus::TableSchema schema;
+    status = conn->DescribeTable(options_.table_name, schema);
+    if (!status.ok()) {
+        printf("Describe table %s failed: %s\n", options_.table_name.c_str(), status.message().c_str());
+        return false;
+    }
+    dimension_ = schema.dimension;
+    milvus::Connection::Destroy(conn);
+
+    printf("table=%s dimension=%ld connections=%ld duration=%lds/step\n", options_.table_name.c_str(), dimension_,
+           options_.connections, options_.duration_sec);
+
+    std::vector<StepResult> results;
+    for (auto qps : options_.qps_steps) {
+        auto result = RunStep(qps);
+        printf("qps=%ld achieved=%.1f requests=%ld errors=%ld p50=%ldus p99=%ldus max=%ldus\n", result.target_qps,
+               result.achieved_qps, result.requests, result.errors, result.p50_us, result.p99_us, result.max_us);
+        results.push_back(result);
+    }
+
+    WriteCsv(results);
+    return true;
+}
+
+StepResult
+LoadRunner::RunStep(int64_t target_qps) {
+    // weighted round-robin lookup from request ticket to mix entry
+    std::vector<size_t> mix_lookup;
+    for (size_t i = 0; i < options_.mix.size(); ++i) {
+        for (int64_t w = 0; w < options_.mix[i].weight; ++w) {
+            mix_lookup.push_back(i);
+        }
+    }
+
+    std::vector<std::vector<std::vector<milvus::RowRecord>>> query_pools;
+    for (size_t i = 0; i < options_.mix.size(); ++i) {
+        query_pools.push_back(BuildQueryPool(options_.mix[i].nq, dimension_, 42 + i));
+    }
+
+    const int64_t total_requests = target_qps * options_.duration_sec;
+    const int64_t interval_ns = 1000000000 / target_qps;
+
+    LatencyHistogram histogram;
+    std::atomic<int64_t> next_ticket{0};
+    std::atomic<int64_t> errors{0};
+
+    // requests are released on a fixed schedule regardless of how fast the
+    // server answers (open loop); latency is measured from the scheduled
+    // release, so queueing delay of a saturated server is not hidden
+    auto start = Clock::now() + std::chrono::milliseconds(200);
+
+    std::vector<std::thread> workers;
+    for (int64_t c = 0; c < options_.connections; ++c) {
+        workers.emplace_back([&]() {
+            auto conn = milvus::Connection::Create();
+            milvus::ConnectParam param = {options_.address, options_.port};
+            if (!conn->Connect(param).ok()) {
+                errors.fetch_add(1);
+                return;
+            }
+
+            while (true) {
+                int64_t ticket = next_ticket.fetch_add(1, std::memory_order_relaxed);
+                if (ticket >= total_requests) {
+                    break;
+                }
+                auto due = start + std::chrono::nanoseconds(ticket * interval_ns);
+                std::this_thread::sleep_until(due);
+
+                auto& entry = options_.mix[mix_lookup[ticket % mix_lookup.size()]];
+                auto& queries = query_pools[mix_lookup[ticket % mix_lookup.size()]][ticket % QUERY_POOL_SIZE];
+
+                milvus::TopKQueryResult result;
+                auto status = conn->Search(options_.table_name, std::vector<std::string>(), queries,
+                                           std::vector<milvus::Range>(), entry.topk, options_.nprobe, result);
+                auto latency_us =
+                    std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - due).count();
+                if (status.ok()) {
+                    histogram.Record(latency_us);
+                } else {
+                    errors.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            milvus::Connection::Destroy(conn);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto elapsed_sec = std::chrono::duration_cast<std::chrono::duration<double>>(Clock::now() - start).count();
+
+    StepResult result;
+    result.target_qps = target_qps;
+    result.requests = histogram.Total();
+    result.errors = errors.load();
+    result.achieved_qps = elapsed_sec > 0 ? static_cast<double>(result.requests) / elapsed_sec : 0.0;
+    result.p50_us = histogram.Percentile(0.50);
+    result.p90_us = histogram.Percentile(0.90);
+    result.p99_us = histogram.Percentile(0.99);
+    result.p999_us = histogram.Percentile(0.999);
+    result.max_us = histogram.Max();
+    return result;
+}
+
+void
+LoadRunner::WriteCsv(const std::vector<StepResult>& results) {
+    std::ofstream file;
+    if (!options_.csv_path.empty()) {
+        file.open(options_.csv_path, std::ios::trunc);
+        if (!file.is_open()) {
+            printf("Failed to open csv file %s\n", options_.csv_path.c_str());
+            return;
+        }
+    }
+    std::ostream& out = options_.csv_path.empty() ? std::cout : file;
+
+    out << "target_qps,achieved_qps,requests,errors,p50_us,p90_us,p99_us,p999_us,max_us\n";
+    for (auto& result : results) {
+        out << result.target_qps << "," << result.achieved_qps << "," << result.requests << "," << result.errors << ","
+            << result.p50_us << "," << result.p90_us << "," << result.p99_us << "," << result.p999_us << ","
+            << result.max_us << "\n";
+    }
+    if (!options_.csv_path.empty()) {
+        printf("Saturation curve written to %s\n", options_.csv_path.c_str());
+    }
+}
@@ -0,0 +1,68 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// one entry of the query mix: nq vectors per request, searched with topk,
+// issued with the given relative weight
+struct MixEntry {
+    int64_t nq = 1;
+    int64_t topk = 64;
+    int64_t weight = 1;
+};
+
+struct LoadOptions {
+    std::string address = "127.0.0.1";
+    std::string port = "19530";
+    std::string table_name;
+    std::vector<MixEntry> mix;
+    std::vector<int64_t> qps_steps;
+    int64_t duration_sec = 30;
+    int64_t connections = 8;
+    int64_t nprobe = 16;
+    std::string csv_path;
+};
+
+// aggregated result of one qps step
+struct StepResult {
+    int64_t target_qps = 0;
+    double achieved_qps = 0.0;
+    int64_t requests = 0;
+    int64_t errors = 0;
+    int64_t p50_us = 0;
+    int64_t p90_us = 0;
+    int64_t p99_us = 0;
+    int64_t p999_us = 0;
+    int64_t max_us = 0;
+};
+
+class LoadRunner {
+ public:
+    explicit LoadRunner(const LoadOptions& options);
+
+    // runs every qps step against the target table and returns false when
+    // the server is unreachable or the table does not exist
+    bool
+    Run();
+
+ private:
+    StepResult
+    RunStep(int64_t target_qps);
+
+    void
+    WriteCsv(const std::vector<StepResult>& results);
+
+    LoadOptions options_;
+    int64_t dimension_ = 0;
+};
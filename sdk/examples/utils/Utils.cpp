@@ -75,6 +75,8 @@ Utils::MetricTypeName(const milvus::MetricType& metric_type) {
         case milvus::MetricType::HAMMING:return "Hamming distance";
         case milvus::MetricType::JACCARD:return "Jaccard distance";
         case milvus::MetricType::TANIMOTO:return "Tanimoto distance";
+        case milvus::MetricType::SUBSTRUCTURE:return "Substructure containment";
+        case milvus::MetricType::SUPERSTRUCTURE:return "Superstructure containment";
         default:return "Unknown metric type";
     }
 }
@@ -0,0 +1,159 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "grpc/AsyncClientProxy.h"
+#include "grpc/ClientProxy.h"
+
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+
+Status
+AsyncClientProxy::Connect(const ConnectParam& param, int64_t channel_count) {
+    if (channel_count <= 0) {
+        return Status(StatusCode::InvalidAgument, "channel count must be positive");
+    }
+
+    std::string uri = param.ip_address + ":" + param.port;
+    for (int64_t i = 0; i < channel_count; ++i) {
+        // a per-channel argument defeats grpc's channel reuse, so every
+        // channel gets its own tcp connection instead of sharing one
+        ::grpc::ChannelArguments arguments;
+        arguments.SetInt("milvus.sdk.channel_id", static_cast<int>(i));
+        auto channel = ::grpc::CreateCustomChannel(uri, ::grpc::InsecureChannelCredentials(), arguments);
+        if (channel == nullptr) {
+            channels_.clear();
+            connected_ = false;
+            return Status(StatusCode::NotConnected, "connect failed!");
+        }
+        channels_.push_back(channel);
+    }
+
+    client_ptr_ = std::make_shared<AsyncGrpcClient>(channels_);
+    connected_ = true;
+    return Status::OK();
+}
+
+Status
+AsyncClientProxy::Disconnect() {
+    if (client_ptr_ == nullptr) {
+        return Status::OK();
+    }
+    Status status = client_ptr_->Disconnect();
+    connected_ = false;
+    channels_.clear();
+    return status;
+}
+
+std::future<InsertResult>
+AsyncClientProxy::Insert(const std::string& table_name, const std::string& partition_tag,
+                         const std::vector<RowRecord>& record_array) {
+    auto promise = std::make_shared<std::promise<InsertResult>>();
+    auto future = promise->get_future();
+    Insert(table_name, partition_tag, record_array,
+           [promise](InsertResult& result) { promise->set_value(std::move(result)); });
+    return future;
+}
+
+void
+AsyncClientProxy::Insert(const std::string& table_name, const std::string& partition_tag,
+                         const std::vector<RowRecord>& record_array, InsertCallback callback) {
+    if (client_ptr_ == nullptr || !connected_) {
+        InsertResult result;
+        result.status = Status(StatusCode::NotConnected, "not connected to the server");
+        callback(result);
+        return;
+    }
+
+    ::milvus::grpc::InsertParam insert_param;
+    insert_param.set_table_name(table_name);
+    insert_param.set_partition_tag(partition_tag);
+    for (auto& record : record_array) {
+        ::milvus::grpc::RowRecord* grpc_record = insert_param.add_row_record_array();
+        CopyRowRecord(grpc_record, record);
+    }
+
+    client_ptr_->Insert(insert_param, [callback](const Status& status, ::milvus::grpc::VectorIds& vector_ids) {
+        InsertResult result;
+        result.status = status;
+        result.id_array.insert(result.id_array.end(), vector_ids.vector_id_array().begin(),
+                               vector_ids.vector_id_array().end());
+        callback(result);
+    });
+}
+
+std::future<SearchResult>
+AsyncClientProxy::Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                         const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
+                         int64_t topk, int64_t nprobe) {
+    auto promise = std::make_shared<std::promise<SearchResult>>();
+    auto future = promise->get_future();
+    Search(table_name, partition_tags, query_record_array, query_range_array, topk, nprobe,
+           [promise](SearchResult& result) { promise->set_value(std::move(result)); });
+    return future;
+}
+
+void
+AsyncClientProxy::Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                         const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
+                         int64_t topk, int64_t nprobe, SearchCallback callback) {
+    if (client_ptr_ == nullptr || !connected_) {
+        SearchResult search_result;
+        search_result.status = Status(StatusCode::NotConnected, "not connected to the server");
+        callback(search_result);
+        return;
+    }
+
+    ::milvus::grpc::SearchParam search_param;
+    search_param.set_table_name(table_name);
+    search_param.set_topk(topk);
+    search_param.set_nprobe(nprobe);
+    for (auto& tag : partition_tags) {
+        search_param.add_partition_tag_array(tag);
+    }
+    for (auto& record : query_record_array) {
+        ::milvus::grpc::RowRecord* row_record = search_param.add_query_record_array();
+        CopyRowRecord(row_record, record);
+    }
+    for (auto& range : query_range_array) {
+        ::milvus::grpc::Range* grpc_range = search_param.add_query_range_array();
+        grpc_range->set_start_value(range.start_value);
+        grpc_range->set_end_value(range.end_value);
+    }
+
+    client_ptr_->Search(search_param, [callback](const Status& status, ::milvus::grpc::TopKQueryResult& result) {
+        SearchResult search_result;
+        search_result.status = status;
+        if (result.row_num() > 0) {
+            int64_t nq = result.row_num();
+            int64_t topk = result.ids().size() / nq;
+            search_result.topk_query_result.reserve(nq);
+            for (int64_t i = 0; i < nq; i++) {
+                milvus::QueryResult one_result;
+                one_result.ids.resize(topk);
+                one_result.distances.resize(topk);
+                memcpy(one_result.ids.data(), result.ids().data() + topk * i, topk * sizeof(int64_t));
+                memcpy(one_result.distances.data(), result.distances().data() + topk * i, topk * sizeof(float));
+                search_result.topk_query_result.emplace_back(one_result);
+            }
+        }
+        callback(search_result);
+    });
+}
+
+}  // namespace milvus
@@ -0,0 +1,56 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "AsyncGrpcClient.h"
+#include "MilvusAsyncApi.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace milvus {
+
+class AsyncClientProxy : public AsyncConnection {
+ public:
+    // Implementations of the AsyncConnection interface
+    Status
+    Connect(const ConnectParam& param, int64_t channel_count) override;
+
+    Status
+    Disconnect() override;
+
+    std::future<InsertResult>
+    Insert(const std::string& table_name, const std::string& partition_tag,
+           const std::vector<RowRecord>& record_array) override;
+
+    void
+    Insert(const std::string& table_name, const std::string& partition_tag, const std::vector<RowRecord>& record_array,
+           InsertCallback callback) override;
+
+    std::future<SearchResult>
+    Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+           const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array, int64_t topk,
+           int64_t nprobe) override;
+
+    void
+    Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+           const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array, int64_t topk,
+           int64_t nprobe, SearchCallback callback) override;
+
+ private:
+    std::vector<std::shared_ptr<::grpc::Channel>> channels_;
+    std::shared_ptr<AsyncGrpcClient> client_ptr_;
+    bool connected_ = false;
+};
+
+}  // namespace milvus
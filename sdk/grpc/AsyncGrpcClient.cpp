@@ -0,0 +1,119 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "grpc/AsyncGrpcClient.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+
+namespace {
+
+Status
+ConvertStatus(bool ok, const ::grpc::Status& grpc_status, const ::milvus::grpc::Status& server_status) {
+    if (!ok) {
+        return Status(StatusCode::RPCFailed, "completion queue shut down");
+    }
+    if (!grpc_status.ok()) {
+        return Status(StatusCode::RPCFailed, grpc_status.error_message());
+    }
+    if (server_status.error_code() != grpc::SUCCESS) {
+        return Status(StatusCode::ServerFailed, server_status.reason());
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
+struct AsyncGrpcClient::InsertCall : AsyncGrpcClient::AsyncCall {
+    ::milvus::grpc::VectorIds response;
+    std::unique_ptr<::grpc::ClientAsyncResponseReader<::milvus::grpc::VectorIds>> reader;
+    InsertDoneFunc done;
+
+    void
+    Finish(bool ok) override {
+        done(ConvertStatus(ok, grpc_status, response.status()), response);
+    }
+};
+
+struct AsyncGrpcClient::SearchCall : AsyncGrpcClient::AsyncCall {
+    ::milvus::grpc::TopKQueryResult response;
+    std::unique_ptr<::grpc::ClientAsyncResponseReader<::milvus::grpc::TopKQueryResult>> reader;
+    SearchDoneFunc done;
+
+    void
+    Finish(bool ok) override {
+        done(ConvertStatus(ok, grpc_status, response.status()), response);
+    }
+};
+
+AsyncGrpcClient::AsyncGrpcClient(const std::vector<std::shared_ptr<::grpc::Channel>>& channels) {
+    for (auto& channel : channels) {
+        stubs_.emplace_back(grpc::MilvusService::NewStub(channel));
+    }
+    poller_ = std::thread(&AsyncGrpcClient::PollLoop, this);
+}
+
+AsyncGrpcClient::~AsyncGrpcClient() {
+    Disconnect();
+}
+
+grpc::MilvusService::Stub&
+AsyncGrpcClient::NextStub() {
+    return *stubs_[next_stub_.fetch_add(1, std::memory_order_relaxed) % stubs_.size()];
+}
+
+void
+AsyncGrpcClient::Insert(const ::milvus::grpc::InsertParam& insert_param, InsertDoneFunc done) {
+    auto call = new InsertCall();  // owned by the completion queue until finished
+    call->done = std::move(done);
+    call->reader = NextStub().PrepareAsyncInsert(&call->context, insert_param, &completion_queue_);
+    call->reader->StartCall();
+    call->reader->Finish(&call->response, &call->grpc_status, call);
+}
+
+void
+AsyncGrpcClient::Search(const ::milvus::grpc::SearchParam& search_param, SearchDoneFunc done) {
+    auto call = new SearchCall();  // owned by the completion queue until finished
+    call->done = std::move(done);
+    call->reader = NextStub().PrepareAsyncSearch(&call->context, search_param, &completion_queue_);
+    call->reader->StartCall();
+    call->reader->Finish(&call->response, &call->grpc_status, call);
+}
+
+void
+AsyncGrpcClient::PollLoop() {
+    void* tag = nullptr;
+    bool ok = false;
+    while (completion_queue_.Next(&tag, &ok)) {
+        std::unique_ptr<AsyncCall> call(static_cast<AsyncCall*>(tag));
+        call->Finish(ok);
+    }
+}
+
+Status
+AsyncGrpcClient::Disconnect() {
+    if (!shut_down_) {
+        shut_down_ = true;
+        // Next() keeps returning queued completions after Shutdown and only
+        // fails once the queue is fully drained, so joining the poller waits
+        // for every outstanding rpc
+        completion_queue_.Shutdown();
+    }
+    if (poller_.joinable()) {
+        poller_.join();
+    }
+    return Status::OK();
+}
+
+}  // namespace milvus
@@ -0,0 +1,81 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "include/MilvusApi.h"
+#include "grpc-gen/gen-milvus/milvus.grpc.pb.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/completion_queue.h>
+
+namespace milvus {
+
+// Async counterpart of GrpcClient: requests are started on one of the given
+// channels (round-robin) and completed by a single poller thread draining the
+// shared completion queue, so any number of rpcs can be in flight without a
+// thread per call.
+class AsyncGrpcClient {
+ public:
+    explicit AsyncGrpcClient(const std::vector<std::shared_ptr<::grpc::Channel>>& channels);
+
+    virtual ~AsyncGrpcClient();
+
+    using InsertDoneFunc = std::function<void(const Status&, ::milvus::grpc::VectorIds&)>;
+    using SearchDoneFunc = std::function<void(const Status&, ::milvus::grpc::TopKQueryResult&)>;
+
+    void
+    Insert(const ::milvus::grpc::InsertParam& insert_param, InsertDoneFunc done);
+
+    void
+    Search(const ::milvus::grpc::SearchParam& search_param, SearchDoneFunc done);
+
+    // drains the completion queue; every pending callback runs before return
+    Status
+    Disconnect();
+
+ private:
+    void
+    PollLoop();
+
+    grpc::MilvusService::Stub&
+    NextStub();
+
+    struct AsyncCall {
+        virtual ~AsyncCall() = default;
+
+        virtual void
+        Finish(bool ok) = 0;
+
+        ::grpc::ClientContext context;
+        ::grpc::Status grpc_status;
+    };
+
+    struct InsertCall;
+    struct SearchCall;
+
+    std::vector<std::unique_ptr<grpc::MilvusService::Stub>> stubs_;
+    std::atomic<uint64_t> next_stub_{0};
+    ::grpc::CompletionQueue completion_queue_;
+    std::thread poller_;
+    bool shut_down_ = false;
+};
+
+}  // namespace milvus
@@ -271,6 +271,61 @@ ClientProxy::Search(const std::string& table_name, const std::vector<std::string
     }
 }
 
+Status
+ClientProxy::Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                    const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
+                    int64_t topk, int64_t nprobe, TopKQueryResultBuffer& result_buffer) {
+    try {
+        // step 1: convert vectors data
+        ::milvus::grpc::SearchParam search_param;
+        search_param.set_table_name(table_name);
+        search_param.set_topk(topk);
+        search_param.set_nprobe(nprobe);
+        for (auto& tag : partition_tags) {
+            search_param.add_partition_tag_array(tag);
+        }
+        for (auto& record : query_record_array) {
+            ::milvus::grpc::RowRecord* row_record = search_param.add_query_record_array();
+            CopyRowRecord(row_record, record);
+        }
+
+        // step 2: convert range array
+        for (auto& range : query_range_array) {
+            ::milvus::grpc::Range* grpc_range = search_param.add_query_range_array();
+            grpc_range->set_start_value(range.start_value);
+            grpc_range->set_end_value(range.end_value);
+        }
+
+        // step 3: search vectors
+        ::milvus::grpc::TopKQueryResult result;
+        Status status = client_ptr_->Search(result, search_param);
+        result_buffer.row_num = 0;
+        result_buffer.topk = 0;
+        if (result.row_num() == 0) {
+            return status;
+        }
+
+        // step 4: the response already holds the row-major layout the buffer
+        // expects, so the whole result moves with two flat copies and no
+        // allocation
+        int64_t nq = result.row_num();
+        int64_t result_topk = result.ids().size() / nq;
+        int64_t needed = nq * result_topk;
+        if (result_buffer.ids == nullptr || result_buffer.distances == nullptr || result_buffer.capacity < needed) {
+            return Status(StatusCode::InvalidAgument,
+                          "result buffer too small, need " + std::to_string(needed) + " entries");
+        }
+        memcpy(result_buffer.ids, result.ids().data(), needed * sizeof(int64_t));
+        memcpy(result_buffer.distances, result.distances().data(), needed * sizeof(float));
+        result_buffer.row_num = nq;
+        result_buffer.topk = result_topk;
+
+        return status;
+    } catch (std::exception& ex) {
+        return Status(StatusCode::UnknownError, "fail to search vectors: " + std::string(ex.what()));
+    }
+}
+
 Status
 ClientProxy::DescribeTable(const std::string& table_name, TableSchema& table_schema) {
     try {
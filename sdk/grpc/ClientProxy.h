@@ -20,6 +20,10 @@
 
 namespace milvus {
 
+// shared by the sync and async proxies
+void
+CopyRowRecord(::milvus::grpc::RowRecord* target, const RowRecord& src);
+
 class ClientProxy : public Connection {
  public:
     // Implementations of the Connection interface
@@ -56,6 +60,11 @@ class ClientProxy : public Connection {
            const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array, int64_t topk,
            int64_t nprobe, TopKQueryResult& topk_query_result) override;
 
+    Status
+    Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+           const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array, int64_t topk,
+           int64_t nprobe, TopKQueryResultBuffer& result_buffer) override;
+
     Status
     DescribeTable(const std::string& table_name, TableSchema& table_schema) override;
 
@@ -38,11 +38,13 @@ enum class IndexType {
 };
 
 enum class MetricType {
-    L2 = 1,         // Euclidean Distance
-    IP = 2,         // Cosine Similarity
-    HAMMING = 3,    // Hamming Distance
-    JACCARD = 4,    // Jaccard Distance
-    TANIMOTO = 5,   // Tanimoto Distance
+    L2 = 1,              // Euclidean Distance
+    IP = 2,              // Cosine Similarity
+    HAMMING = 3,         // Hamming Distance
+    JACCARD = 4,         // Jaccard Distance
+    TANIMOTO = 5,        // Tanimoto Distance
+    SUBSTRUCTURE = 6,    // Substructure Containment
+    SUPERSTRUCTURE = 7,  // Superstructure Containment
 };
 
 /**
@@ -89,6 +91,21 @@ struct QueryResult {
 };
 using TopKQueryResult = std::vector<QueryResult>;  ///< Topk query result
 
+/**
+ * @brief Caller-owned result buffer
+ *
+ * Results are written row-major (query i, rank k at i * topk + k) straight
+ * from the rpc response, without per-call allocation. The caller keeps
+ * ownership and may reuse the same buffer across calls.
+ */
+struct TopKQueryResultBuffer {
+    int64_t* ids = nullptr;     ///< Id slots, at least capacity entries
+    float* distances = nullptr; ///< Distance slots, at least capacity entries
+    int64_t capacity = 0;       ///< Number of id/distance slots provided
+    int64_t row_num = 0;        ///< Filled by the call: number of result rows
+    int64_t topk = 0;           ///< Filled by the call: entries per row
+};
+
 /**
  * @brief index parameters
  */
@@ -276,6 +293,30 @@ class Connection {
            const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array, int64_t topk,
            int64_t nprobe, TopKQueryResult& topk_query_result) = 0;
 
+    /**
+     * @brief Search vector into a caller-owned buffer
+     *
+     * Same as Search, but ids and distances land directly in the
+     * pre-allocated buffer instead of freshly allocated vectors, saving one
+     * copy and all allocation on the hot path. Fails with InvalidAgument and
+     * an untouched buffer when capacity is smaller than row_num * topk of the
+     * response; the message carries the required size.
+     *
+     * @param table_name, target table's name.
+     * @param partition_tags, target partitions, keep empty if no partition.
+     * @param query_record_array, all vector are going to be queried.
+     * @param query_range_array, [deprecated] time ranges, if not specified, will search in whole table
+     * @param topk, how many similarity vectors will be searched.
+     * @param nprobe, the number of centroids choose to search.
+     * @param result_buffer, caller-owned id/distance storage, filled on success.
+     *
+     * @return Indicate if query is successful.
+     */
+    virtual Status
+    Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+           const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array, int64_t topk,
+           int64_t nprobe, TopKQueryResultBuffer& result_buffer) = 0;
+
     /**
      * @brief Show table description
      *
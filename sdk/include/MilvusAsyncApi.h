@@ -0,0 +1,178 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "MilvusApi.h"
+#include "Status.h"
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** \brief Milvus SDK namespace
+ */
+namespace milvus {
+
+/**
+ * @brief Result of an asynchronous insert
+ */
+struct InsertResult {
+    Status status;                  ///< Call status
+    std::vector<int64_t> id_array;  ///< Ids of the inserted vectors
+};
+
+/**
+ * @brief Result of an asynchronous search
+ */
+struct SearchResult {
+    Status status;                        ///< Call status
+    TopKQueryResult topk_query_result;    ///< Topk result per query vector
+};
+
+using InsertCallback = std::function<void(InsertResult&)>;
+using SearchCallback = std::function<void(SearchResult&)>;
+
+/**
+ * @brief Asynchronous SDK entry
+ *
+ * Issues insert/search without blocking the calling thread. Any number of
+ * requests may be in flight at once; they are pipelined over a configurable
+ * number of grpc channels and completed by a single internal poller thread,
+ * so the client no longer needs one thread per outstanding request.
+ */
+class AsyncConnection {
+ public:
+    /**
+     * @brief Create an async connection instance and return its shared pointer
+     */
+    static std::shared_ptr<AsyncConnection>
+    Create();
+
+    /**
+     * @brief Destroy the async connection instance
+     */
+    static Status
+    Destroy(std::shared_ptr<AsyncConnection>& connection_ptr);
+
+    /**
+     * @brief Connect server, opening channel_count independent channels that
+     *        requests are distributed over round-robin
+     */
+    virtual Status
+    Connect(const ConnectParam& param, int64_t channel_count) = 0;
+
+    /**
+     * @brief Disconnect; blocks until every in-flight request has completed
+     */
+    virtual Status
+    Disconnect() = 0;
+
+    /**
+     * @brief Insert vectors asynchronously, ids are assigned by the server
+     */
+    virtual std::future<InsertResult>
+    Insert(const std::string& table_name, const std::string& partition_tag,
+           const std::vector<RowRecord>& record_array) = 0;
+
+    /**
+     * @brief Insert vectors asynchronously; the callback runs on the internal
+     *        poller thread and must not block
+     */
+    virtual void
+    Insert(const std::string& table_name, const std::string& partition_tag,
+           const std::vector<RowRecord>& record_array, InsertCallback callback) = 0;
+
+    /**
+     * @brief Search vectors asynchronously
+     */
+    virtual std::future<SearchResult>
+    Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+           const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array, int64_t topk,
+           int64_t nprobe) = 0;
+
+    /**
+     * @brief Search vectors asynchronously; the callback runs on the internal
+     *        poller thread and must not block
+     */
+    virtual void
+    Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+           const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array, int64_t topk,
+           int64_t nprobe, SearchCallback callback) = 0;
+
+    virtual ~AsyncConnection() = default;
+};
+
+/**
+ * @brief Client-side insert aggregator
+ *
+ * Collects single records into batches of batch_size and ships each full
+ * batch asynchronously, keeping at most max_pending_batches in flight so a
+ * slow server applies backpressure instead of exhausting client memory.
+ * Not thread-safe; use one instance per producing thread.
+ */
+class BatchInserter {
+ public:
+    BatchInserter(std::shared_ptr<AsyncConnection> connection, const std::string& table_name,
+                  const std::string& partition_tag, int64_t batch_size = 1024, int64_t max_pending_batches = 4);
+
+    /**
+     * @brief Flushes remaining records, ignoring errors; call Flush() first
+     *        when the result matters
+     */
+    ~BatchInserter();
+
+    void
+    Add(const RowRecord& record);
+
+    void
+    Add(const std::vector<RowRecord>& record_array);
+
+    /**
+     * @brief Ship the partial batch and wait for every in-flight batch
+     *
+     * @return first error seen since construction, sticky across calls
+     */
+    Status
+    Flush();
+
+    /**
+     * @brief Server-assigned ids of all completed batches, in insert order
+     */
+    const std::vector<int64_t>&
+    IdArray() const {
+        return id_array_;
+    }
+
+ private:
+    void
+    Dispatch();
+
+    void
+    Reap();
+
+    std::shared_ptr<AsyncConnection> connection_;
+    std::string table_name_;
+    std::string partition_tag_;
+    int64_t batch_size_ = 1024;
+    int64_t max_pending_batches_ = 4;
+
+    std::vector<RowRecord> pending_;
+    std::deque<std::future<InsertResult>> in_flight_;
+    std::vector<int64_t> id_array_;
+    Status first_error_ = Status::OK();
+};
+
+}  // namespace milvus
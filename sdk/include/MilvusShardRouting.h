@@ -0,0 +1,121 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "MilvusApi.h"
+#include "Status.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** \brief Milvus SDK namespace
+ */
+namespace milvus {
+
+/**
+ * @brief Versioned table-to-node mapping of a sharded deployment
+ *
+ * A higher version replaces a lower one; equal or lower versions are ignored
+ * so concurrent refreshes cannot roll the table backwards.
+ */
+struct RoutingTable {
+    int64_t version = 0;
+    std::map<std::string, ConnectParam> table_nodes;  ///< table name -> data node serving it
+};
+
+/**
+ * @brief Supplies the current routing table
+ *
+ * The wire protocol has no topology rpc, so the deployment decides where the
+ * table comes from (config map, service discovery, an admin endpoint of the
+ * sharding proxy). Called from inside the router; must be thread-safe.
+ */
+using RoutingFetchFunc = std::function<Status(RoutingTable&)>;
+
+/**
+ * @brief Partition-aware request router for sharded deployments
+ *
+ * Sends a query straight to the data node that owns the table, skipping the
+ * sharding proxy hop. The routing table is fetched through the supplied
+ * callback and cached; direct connections are kept open per node. Tables
+ * without a route, fetch failures and rpc failures on a direct connection all
+ * fall back to the proxy, the latter also marking the cache stale so the next
+ * call refreshes it. Thread-safe.
+ */
+class ShardRouter {
+ public:
+    ShardRouter(const ConnectParam& proxy_param, RoutingFetchFunc fetch_func, int64_t refresh_interval_sec = 60);
+
+    /**
+     * @brief Connect the proxy and load the initial routing table
+     */
+    Status
+    Connect();
+
+    Status
+    Disconnect();
+
+    /**
+     * @brief Search, routed to the owning data node when one is known
+     */
+    Status
+    Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+           const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array, int64_t topk,
+           int64_t nprobe, TopKQueryResult& topk_query_result);
+
+    /**
+     * @brief Insert, routed to the owning data node when one is known
+     */
+    Status
+    Insert(const std::string& table_name, const std::string& partition_tag, const std::vector<RowRecord>& record_array,
+           std::vector<int64_t>& id_array);
+
+    /**
+     * @brief Connection the given table would be routed to; the proxy
+     *        connection when no route is known
+     */
+    std::shared_ptr<Connection>
+    Route(const std::string& table_name);
+
+    /**
+     * @brief Force a routing table refresh on the next request
+     */
+    void
+    MarkStale();
+
+    int64_t
+    RoutingVersion() const;
+
+ private:
+    void
+    RefreshIfNeeded();
+
+    std::shared_ptr<Connection>
+    NodeConnection(const ConnectParam& param);
+
+    ConnectParam proxy_param_;
+    RoutingFetchFunc fetch_func_;
+    int64_t refresh_interval_sec_ = 60;
+
+    mutable std::mutex mutex_;
+    RoutingTable routing_;
+    std::map<std::string, std::shared_ptr<Connection>> node_connections_;  ///< "ip:port" -> connection
+    std::shared_ptr<Connection> proxy_connection_;
+    int64_t last_refresh_sec_ = 0;
+    bool stale_ = true;
+};
+
+}  // namespace milvus
@@ -0,0 +1,71 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "interface/AsyncConnectionImpl.h"
+
+namespace milvus {
+
+std::shared_ptr<AsyncConnection>
+AsyncConnection::Create() {
+    return std::shared_ptr<AsyncConnection>(new AsyncConnectionImpl());
+}
+
+Status
+AsyncConnection::Destroy(std::shared_ptr<milvus::AsyncConnection>& connection_ptr) {
+    if (connection_ptr != nullptr) {
+        return connection_ptr->Disconnect();
+    }
+    return Status::OK();
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+AsyncConnectionImpl::AsyncConnectionImpl() {
+    client_proxy_ = std::make_shared<AsyncClientProxy>();
+}
+
+Status
+AsyncConnectionImpl::Connect(const ConnectParam& param, int64_t channel_count) {
+    return client_proxy_->Connect(param, channel_count);
+}
+
+Status
+AsyncConnectionImpl::Disconnect() {
+    return client_proxy_->Disconnect();
+}
+
+std::future<InsertResult>
+AsyncConnectionImpl::Insert(const std::string& table_name, const std::string& partition_tag,
+                            const std::vector<RowRecord>& record_array) {
+    return client_proxy_->Insert(table_name, partition_tag, record_array);
+}
+
+void
+AsyncConnectionImpl::Insert(const std::string& table_name, const std::string& partition_tag,
+                            const std::vector<RowRecord>& record_array, InsertCallback callback) {
+    client_proxy_->Insert(table_name, partition_tag, record_array, callback);
+}
+
+std::future<SearchResult>
+AsyncConnectionImpl::Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                            const std::vector<RowRecord>& query_record_array,
+                            const std::vector<Range>& query_range_array, int64_t topk, int64_t nprobe) {
+    return client_proxy_->Search(table_name, partition_tags, query_record_array, query_range_array, topk, nprobe);
+}
+
+void
+AsyncConnectionImpl::Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                            const std::vector<RowRecord>& query_record_array,
+                            const std::vector<Range>& query_range_array, int64_t topk, int64_t nprobe,
+                            SearchCallback callback) {
+    client_proxy_->Search(table_name, partition_tags, query_record_array, query_range_array, topk, nprobe, callback);
+}
+
+}  // namespace milvus
@@ -0,0 +1,86 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "MilvusAsyncApi.h"
+
+#include <utility>
+
+namespace milvus {
+
+BatchInserter::BatchInserter(std::shared_ptr<AsyncConnection> connection, const std::string& table_name,
+                             const std::string& partition_tag, int64_t batch_size, int64_t max_pending_batches)
+    : connection_(std::move(connection)),
+      table_name_(table_name),
+      partition_tag_(partition_tag),
+      batch_size_(batch_size > 0 ? batch_size : 1),
+      max_pending_batches_(max_pending_batches > 0 ? max_pending_batches : 1) {
+    pending_.reserve(batch_size_);
+}
+
+BatchInserter::~BatchInserter() {
+    Flush();
+}
+
+void
+BatchInserter::Add(const RowRecord& record) {
+    pending_.push_back(record);
+    if (static_cast<int64_t>(pending_.size()) >= batch_size_) {
+        Dispatch();
+    }
+}
+
+void
+BatchInserter::Add(const std::vector<RowRecord>& record_array) {
+    for (auto& record : record_array) {
+        Add(record);
+    }
+}
+
+void
+BatchInserter::Dispatch() {
+    // bound the number of outstanding batches; waiting on the oldest one
+    // turns a slow server into backpressure on the producer
+    while (static_cast<int64_t>(in_flight_.size()) >= max_pending_batches_) {
+        Reap();
+    }
+
+    std::vector<RowRecord> batch;
+    batch.reserve(batch_size_);
+    batch.swap(pending_);
+    in_flight_.push_back(connection_->Insert(table_name_, partition_tag_, batch));
+}
+
+void
+BatchInserter::Reap() {
+    if (in_flight_.empty()) {
+        return;
+    }
+    InsertResult result = in_flight_.front().get();
+    in_flight_.pop_front();
+    if (result.status.ok()) {
+        id_array_.insert(id_array_.end(), result.id_array.begin(), result.id_array.end());
+    } else if (first_error_.ok()) {
+        first_error_ = result.status;
+    }
+}
+
+Status
+BatchInserter::Flush() {
+    if (!pending_.empty()) {
+        Dispatch();
+    }
+    while (!in_flight_.empty()) {
+        Reap();
+    }
+    return first_error_;
+}
+
+}  // namespace milvus
@@ -90,6 +90,14 @@ ConnectionImpl::Search(const std::string& table_name, const std::vector<std::str
                                  topk_query_result);
 }
 
+Status
+ConnectionImpl::Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                       const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
+                       int64_t topk, int64_t nprobe, TopKQueryResultBuffer& result_buffer) {
+    return client_proxy_->Search(table_name, partition_tags, query_record_array, query_range_array, topk, nprobe,
+                                 result_buffer);
+}
+
 Status
 ConnectionImpl::DescribeTable(const std::string& table_name, TableSchema& table_schema) {
     return client_proxy_->DescribeTable(table_name, table_schema);
@@ -0,0 +1,204 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "MilvusShardRouting.h"
+
+#include <chrono>
+#include <set>
+#include <utility>
+
+namespace milvus {
+
+namespace {
+
+int64_t
+NowSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// a failure of this kind on a direct connection means the node is gone or no
+// longer owns the table, not that the request itself was bad
+bool
+IsRoutingFailure(const Status& status) {
+    return status.code() == StatusCode::RPCFailed || status.code() == StatusCode::NotConnected;
+}
+
+}  // namespace
+
+ShardRouter::ShardRouter(const ConnectParam& proxy_param, RoutingFetchFunc fetch_func, int64_t refresh_interval_sec)
+    : proxy_param_(proxy_param),
+      fetch_func_(std::move(fetch_func)),
+      refresh_interval_sec_(refresh_interval_sec > 0 ? refresh_interval_sec : 60) {
+}
+
+Status
+ShardRouter::Connect() {
+    proxy_connection_ = Connection::Create();
+    Status status = proxy_connection_->Connect(proxy_param_);
+    if (!status.ok()) {
+        proxy_connection_ = nullptr;
+        return status;
+    }
+    RefreshIfNeeded();
+    return Status::OK();
+}
+
+Status
+ShardRouter::Disconnect() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& pair : node_connections_) {
+        Connection::Destroy(pair.second);
+    }
+    node_connections_.clear();
+    if (proxy_connection_ != nullptr) {
+        return Connection::Destroy(proxy_connection_);
+    }
+    return Status::OK();
+}
+
+void
+ShardRouter::MarkStale() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stale_ = true;
+}
+
+int64_t
+ShardRouter::RoutingVersion() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return routing_.version;
+}
+
+void
+ShardRouter::RefreshIfNeeded() {
+    RoutingTable candidate;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stale_ && NowSeconds() - last_refresh_sec_ < refresh_interval_sec_) {
+            return;
+        }
+    }
+
+    // fetch outside the lock; requests keep routing on the old table meanwhile
+    Status status = fetch_func_ == nullptr ? Status(StatusCode::NotSupported, "no fetch function")
+                                           : fetch_func_(candidate);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_refresh_sec_ = NowSeconds();
+    stale_ = false;
+    if (!status.ok() || candidate.version <= routing_.version) {
+        return;
+    }
+    routing_ = candidate;
+
+    // drop pooled connections to nodes the new table no longer references
+    std::set<std::string> referenced;
+    for (auto& pair : routing_.table_nodes) {
+        referenced.insert(pair.second.ip_address + ":" + pair.second.port);
+    }
+    for (auto it = node_connections_.begin(); it != node_connections_.end();) {
+        if (referenced.find(it->first) == referenced.end()) {
+            Connection::Destroy(it->second);
+            it = node_connections_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::shared_ptr<Connection>
+ShardRouter::NodeConnection(const ConnectParam& param) {
+    std::string endpoint = param.ip_address + ":" + param.port;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = node_connections_.find(endpoint);
+        if (it != node_connections_.end()) {
+            return it->second;
+        }
+    }
+
+    auto connection = Connection::Create();
+    if (!connection->Connect(param).ok()) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = node_connections_.find(endpoint);
+    if (it != node_connections_.end()) {
+        // another thread connected first; keep the pooled one
+        Connection::Destroy(connection);
+        return it->second;
+    }
+    node_connections_[endpoint] = connection;
+    return connection;
+}
+
+std::shared_ptr<Connection>
+ShardRouter::Route(const std::string& table_name) {
+    RefreshIfNeeded();
+
+    ConnectParam node_param;
+    bool routed = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = routing_.table_nodes.find(table_name);
+        if (it != routing_.table_nodes.end()) {
+            node_param = it->second;
+            routed = true;
+        }
+    }
+
+    if (routed) {
+        auto connection = NodeConnection(node_param);
+        if (connection != nullptr) {
+            return connection;
+        }
+    }
+    return proxy_connection_;
+}
+
+Status
+ShardRouter::Search(const std::string& table_name, const std::vector<std::string>& partition_tags,
+                    const std::vector<RowRecord>& query_record_array, const std::vector<Range>& query_range_array,
+                    int64_t topk, int64_t nprobe, TopKQueryResult& topk_query_result) {
+    if (proxy_connection_ == nullptr) {
+        return Status(StatusCode::NotConnected, "not connected");
+    }
+
+    auto connection = Route(table_name);
+    Status status = connection->Search(table_name, partition_tags, query_record_array, query_range_array, topk, nprobe,
+                                       topk_query_result);
+    if (connection != proxy_connection_ && IsRoutingFailure(status)) {
+        // stale route: retire it and let the proxy resolve this request
+        MarkStale();
+        status = proxy_connection_->Search(table_name, partition_tags, query_record_array, query_range_array, topk,
+                                           nprobe, topk_query_result);
+    }
+    return status;
+}
+
+Status
+ShardRouter::Insert(const std::string& table_name, const std::string& partition_tag,
+                    const std::vector<RowRecord>& record_array, std::vector<int64_t>& id_array) {
+    if (proxy_connection_ == nullptr) {
+        return Status(StatusCode::NotConnected, "not connected");
+    }
+
+    auto connection = Route(table_name);
+    Status status = connection->Insert(table_name, partition_tag, record_array, id_array);
+    if (connection != proxy_connection_ && IsRoutingFailure(status)) {
+        MarkStale();
+        status = proxy_connection_->Insert(table_name, partition_tag, record_array, id_array);
+    }
+    return status;
+}
+
+}  // namespace milvus
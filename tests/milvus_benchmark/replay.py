@@ -0,0 +1,119 @@
+"""Replay a query_record.bin sampled by the server against a candidate config.
+
+The server writes the log when server_config.query_record_fraction > 0
+(see core/src/server/delivery/QueryRecorder.h for the binary layout).
+Searches are re-issued in recorded order, preserving the original gaps
+between them scaled by --speedup; --max-qps instead paces at a fixed rate.
+"""
+
+import sys
+import time
+import struct
+import argparse
+import logging
+
+from milvus import Milvus
+
+logging.basicConfig(format='%(asctime)s,%(msecs)d %(levelname)-8s [%(filename)s:%(lineno)d] %(message)s',
+    datefmt='%Y-%m-%d:%H:%M:%S',
+    level=logging.INFO)
+logger = logging.getLogger("milvus_benchmark.replay")
+
+MAGIC = b"MQRL"
+SUPPORTED_VERSION = 1
+
+
+def read_exact(f, size):
+    data = f.read(size)
+    if len(data) != size:
+        raise EOFError()
+    return data
+
+
+def parse_records(path):
+    """Yield (timestamp_us, table_name, topk, nprobe, queries) per record."""
+    with open(path, "rb") as f:
+        if read_exact(f, 4) != MAGIC:
+            raise ValueError("%s is not a query record log" % path)
+        version = struct.unpack("<I", read_exact(f, 4))[0]
+        if version != SUPPORTED_VERSION:
+            raise ValueError("Unsupported log version: %d" % version)
+        while True:
+            try:
+                timestamp_us = struct.unpack("<Q", read_exact(f, 8))[0]
+            except EOFError:
+                return
+            table_len = struct.unpack("<H", read_exact(f, 2))[0]
+            table_name = read_exact(f, table_len).decode()
+            topk, nprobe = struct.unpack("<qq", read_exact(f, 16))
+            is_binary = struct.unpack("<B", read_exact(f, 1))[0]
+            nq = struct.unpack("<I", read_exact(f, 4))[0]
+            payload_bytes = struct.unpack("<Q", read_exact(f, 8))[0]
+            payload = read_exact(f, payload_bytes)
+            if is_binary:
+                row_size = payload_bytes // nq
+                queries = [payload[i * row_size:(i + 1) * row_size] for i in range(nq)]
+            else:
+                dim = payload_bytes // (nq * 4)
+                values = struct.unpack("<%df" % (payload_bytes // 4), payload)
+                queries = [list(values[i * dim:(i + 1) * dim]) for i in range(nq)]
+            yield timestamp_us, table_name, topk, nprobe, queries
+
+
+def replay(args):
+    milvus = Milvus()
+    milvus.connect(host=args.host, port=args.port)
+
+    total = 0
+    failed = 0
+    latencies = []
+    first_record_us = None
+    start = time.time()
+    for timestamp_us, table_name, topk, nprobe, queries in parse_records(args.log):
+        if first_record_us is None:
+            first_record_us = timestamp_us
+        if args.max_qps > 0:
+            due = start + total / args.max_qps
+        else:
+            due = start + (timestamp_us - first_record_us) / 1e6 / args.speedup
+        delay = due - time.time()
+        if delay > 0:
+            time.sleep(delay)
+
+        query_start = time.time()
+        status, _ = milvus.search_vectors(table_name, topk, nprobe, queries)
+        latencies.append(time.time() - query_start)
+        total += 1
+        if not status.OK():
+            failed += 1
+            logger.warning("Search %d against %s failed: %s" % (total, table_name, status.message))
+        if args.limit and total >= args.limit:
+            break
+
+    elapsed = time.time() - start
+    if not total:
+        logger.info("Log contains no records")
+        return 0
+    latencies.sort()
+    logger.info("Replayed %d searches (%d failed) in %.2fs, %.1f qps" % (total, failed, elapsed, total / elapsed))
+    logger.info("Latency avg %.4fs, p50 %.4fs, p99 %.4fs" % (
+        sum(latencies) / total, latencies[total // 2], latencies[int(total * 0.99)]))
+    return 1 if failed else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Replay recorded Milvus search traffic")
+    parser.add_argument("log", help="path to query_record.bin")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", default=19530, type=int)
+    parser.add_argument("--speedup", default=1.0, type=float,
+                        help="scale factor on the recorded request rate (2.0 replays twice as fast)")
+    parser.add_argument("--max-qps", default=0, type=float,
+                        help="ignore recorded timing and pace at this fixed rate; 0 keeps recorded timing")
+    parser.add_argument("--limit", default=0, type=int, help="stop after this many searches; 0 replays the whole log")
+    args = parser.parse_args()
+    sys.exit(replay(args))
+
+
+if __name__ == "__main__":
+    main()